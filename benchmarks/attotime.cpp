@@ -0,0 +1,60 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+
+static void BM_attotime_add(benchmark::State& state) {
+	attotime accum = attotime::zero;
+	attotime step = attotime::from_nsec(16683);
+	while (state.KeepRunning()) {
+		accum += step;
+		if (accum.seconds() > 60)
+			accum = attotime::zero;
+	}
+	(void)accum;
+}
+// Register the function as a benchmark
+BENCHMARK(BM_attotime_add);
+
+static void BM_attotime_mul(benchmark::State& state) {
+	attotime base = attotime::from_hz(60);
+	uint32_t factor = 1;
+	while (state.KeepRunning()) {
+		(void)(base * factor);
+		factor = (factor & 1023) + 1;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_attotime_mul);
+
+static void BM_attotime_compare(benchmark::State& state) {
+	attotime a = attotime::from_hz(60);
+	attotime b = attotime::from_hz(59);
+	while (state.KeepRunning()) {
+		(void)(a < b);
+		a += attotime::from_nsec(1);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_attotime_compare);
+
+static void BM_attotime_as_ticks(benchmark::State& state) {
+	attotime base = attotime::from_msec(16);
+	uint32_t frequency = 3579545;
+	while (state.KeepRunning()) {
+		(void)base.as_ticks(frequency);
+		frequency++;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_attotime_as_ticks);
+
+static void BM_attotime_from_ticks(benchmark::State& state) {
+	uint64_t ticks = 0x123456;
+	while (state.KeepRunning()) {
+		(void)attotime::from_ticks(ticks, 3579545);
+		ticks++;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_attotime_from_ticks);
@@ -0,0 +1,65 @@
+#include "benchmark/benchmark_api.h"
+#include <cassert>
+#include "osdcomm.h"
+#include "delegate.h"
+
+namespace {
+
+class target
+{
+public:
+	virtual ~target() { }
+	int member(int value) { return value + m_state; }
+	virtual int virtual_member(int value) { return value + m_state; }
+	static int static_func(int value) { return value + 1; }
+
+private:
+	int m_state = 1;
+};
+
+} // anonymous namespace
+
+static void BM_delegate_member(benchmark::State& state) {
+	target t;
+	delegate<int (int)> d(&target::member, &t);
+	int value = 0;
+	while (state.KeepRunning()) {
+		value = d(value);
+	}
+	(void)value;
+}
+// Register the function as a benchmark
+BENCHMARK(BM_delegate_member);
+
+static void BM_delegate_static(benchmark::State& state) {
+	delegate<int (int)> d(&target::static_func);
+	int value = 0;
+	while (state.KeepRunning()) {
+		value = d(value);
+	}
+	(void)value;
+}
+// Register the function as a benchmark
+BENCHMARK(BM_delegate_static);
+
+static void BM_delegate_virtual_baseline(benchmark::State& state) {
+	target t;
+	target *pt = &t;
+	int value = 0;
+	while (state.KeepRunning()) {
+		value = pt->virtual_member(value);
+	}
+	(void)value;
+}
+// Register the function as a benchmark
+BENCHMARK(BM_delegate_virtual_baseline);
+
+static void BM_delegate_bind(benchmark::State& state) {
+	target t;
+	while (state.KeepRunning()) {
+		delegate<int (int)> d(&target::member, &t);
+		(void)d;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_delegate_bind);
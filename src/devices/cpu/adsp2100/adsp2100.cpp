@@ -422,6 +422,17 @@ void adsp21xx_device::device_start()
 	m_data = &space(AS_DATA);
 	m_io = has_space(AS_IO) ? &space(AS_IO) : nullptr;
 
+	// start with the opcode cache empty, and install a tap so that any
+	// write to program memory -- from the core itself, IDMA, or a hosting
+	// CPU downloading a new program -- invalidates the affected entry
+	flush_op_cache();
+	m_program->install_write_tap(0x0000, 0x3fff, "op_cache",
+			[this](offs_t offset, uint32_t &data, uint32_t mem_mask)
+			{
+				m_op_cache[offset & 0x3fff] = OP_CACHE_INVALID;
+			});
+	machine().save().register_postload(save_prepost_delegate(FUNC(adsp21xx_device::flush_op_cache), this));
+
 	// "core"
 	save_item(NAME(m_core.ax0.u));
 	save_item(NAME(m_core.ax1.u));
@@ -1094,6 +1105,19 @@ void adsp21xx_device::create_tables()
 }
 
 
+//-------------------------------------------------
+//  flush_op_cache - empty the fetched-opcode
+//  cache; needed after a state load, since the
+//  restored program memory may not match what the
+//  cache was filled from
+//-------------------------------------------------
+
+void adsp21xx_device::flush_op_cache()
+{
+	memset(m_op_cache, 0xff, sizeof(m_op_cache));
+}
+
+
 
 /***************************************************************************
     CORE EXECUTION LOOP
@@ -1176,8 +1200,11 @@ void adsp21xx_device::execute_run()
 		m_pcbucket[m_pc & 0x3fff]++;
 #endif
 
-		// instruction fetch
-		uint32_t op = opcode_read();
+		// instruction fetch, through the opcode cache; misses are filled
+		// from memory and stay valid until the word is written
+		uint32_t op = m_op_cache[m_pc & 0x3fff];
+		if (op == OP_CACHE_INVALID)
+			op = m_op_cache[m_pc & 0x3fff] = opcode_read();
 
 		// advance to the next instruction
 		if (m_pc != m_loop)
@@ -247,6 +247,7 @@ protected:
 
 	// helpers
 	void create_tables();
+	void flush_op_cache();
 	inline void update_mstat();
 	inline uint32_t pc_stack_top();
 	inline void set_pc_stack_top(uint32_t top);
@@ -457,6 +458,11 @@ protected:
 	uint16_t              m_mask_table[0x4000];
 	uint16_t              m_reverse_table[0x4000];
 
+	// fetched-opcode cache; opcodes are 24 bits wide, so a value with the
+	// top bits set marks an empty slot
+	static const uint32_t OP_CACHE_INVALID = 0xffffffff;
+	uint32_t              m_op_cache[0x4000];
+
 	devcb_read32            m_sport_rx_cb;    // callback for serial receive
 	devcb_write32           m_sport_tx_cb;    // callback for serial transmit
 	devcb_write_line        m_timer_fired_cb;          // callback for timer fired
@@ -352,6 +352,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, uint32_
 			// when we hit a HASH opcode, register the current pointer for the mode/PC
 			case OP_HASH:
 				m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), (drccodeptr)dst);
+				m_drcuml.note_translation(inst.param(0).immediate(), inst.param(1).immediate());
 				break;
 
 			// when we hit a LABEL opcode, register the current pointer for the label
@@ -1926,6 +1927,10 @@ int drcbe_c::execute(code_handle &entry)
 				FSPARAM0 = FSPARAM1 * FSPARAM2;
 				break;
 
+			case MAKE_OPCODE_SHORT(OP_FMADD, 4, 0):     // FSMADD  dst,src1,src2,src3
+				FSPARAM0 = fmaf(FSPARAM1, FSPARAM2, FSPARAM3);
+				break;
+
 			case MAKE_OPCODE_SHORT(OP_FDIV, 4, 0):      // FSDIV   dst,src1,src2
 				FSPARAM0 = FSPARAM1 / FSPARAM2;
 				break;
@@ -2073,6 +2078,10 @@ int drcbe_c::execute(code_handle &entry)
 				FDPARAM0 = FDPARAM1 * FDPARAM2;
 				break;
 
+			case MAKE_OPCODE_SHORT(OP_FMADD, 8, 0):     // FDMADD  dst,src1,src2,src3
+				FDPARAM0 = fma(FDPARAM1, FDPARAM2, FDPARAM3);
+				break;
+
 			case MAKE_OPCODE_SHORT(OP_FDIV, 8, 0):      // FDDIV   dst,src1,src2
 				FDPARAM0 = FDPARAM1 / FDPARAM2;
 				break;
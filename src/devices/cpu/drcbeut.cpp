@@ -55,6 +55,9 @@ drc_hash_table::drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbit
 
 bool drc_hash_table::reset()
 {
+	// any chained code is about to be discarded along with the cache
+	m_chains.clear();
+
 	// allocate an empty l2 hash table
 	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
 	if (m_emptyl2 == nullptr)
@@ -184,10 +187,31 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 	// set the new entry
 	uint32_t l2 = (pc >> m_l2shift) & m_l2mask;
 	m_base[mode][l1][l2] = code;
+
+	// repatch any direct chain sites that target this mode/PC
+	if (!m_chains.empty() && !m_chain_patcher.isnull())
+	{
+		auto const range = m_chains.equal_range((uint64_t(mode) << 32) | pc);
+		for (auto it = range.first; it != range.second; ++it)
+			m_chain_patcher(it->second, (code != nullptr) ? code : m_nocodeptr);
+	}
 	return true;
 }
 
 
+//-------------------------------------------------
+//  register_chain_site - note a direct jump to
+//  the code for the given mode/pc so it can be
+//  repatched when that code moves
+//-------------------------------------------------
+
+void drc_hash_table::register_chain_site(drccodeptr site, uint32_t mode, uint32_t pc)
+{
+	assert(!m_chain_patcher.isnull());
+	m_chains.emplace((uint64_t(mode) << 32) | pc, site);
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -15,6 +15,8 @@
 
 #include "drcuml.h"
 
+#include <unordered_map>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -22,6 +24,8 @@
 
 // ======================> drc_hash_table
 
+typedef delegate<void (drccodeptr, drccodeptr)> drc_hash_chain_delegate;
+
 // common hash table management
 class drc_hash_table
 {
@@ -52,6 +56,12 @@ public:
 	drccodeptr get_codeptr(uint32_t mode, uint32_t pc) { assert(mode < m_modes); return m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask]; }
 	bool code_exists(uint32_t mode, uint32_t pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
 
+	// direct chaining; back-ends register fixed-target dispatch sites
+	// and are called back to repatch them whenever the code pointer for
+	// that mode/PC changes
+	void set_chain_patcher(drc_hash_chain_delegate patcher) { m_chain_patcher = patcher; }
+	void register_chain_site(drccodeptr site, uint32_t mode, uint32_t pc);
+
 private:
 	// internal state
 	drc_cache &     m_cache;                // cache where allocations come from
@@ -69,6 +79,9 @@ private:
 	drccodeptr ***  m_base;                 // pointer to the l1 table for each mode
 	drccodeptr **   m_emptyl1;              // pointer to empty l1 hash table
 	drccodeptr *    m_emptyl2;              // pointer to empty l2 hash table
+
+	drc_hash_chain_delegate m_chain_patcher;  // back-end callback to rewrite a chain site
+	std::unordered_multimap<uint64_t, drccodeptr> m_chains;  // registered chain sites, keyed by mode/PC
 };
 
 
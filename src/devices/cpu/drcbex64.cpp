@@ -296,6 +296,14 @@ static uint8_t float_register_map[REG_F_COUNT] =
 #endif
 };
 
+// second floating point scratch register for three-source operations;
+// must be volatile and absent from float_register_map for the ABI in use
+#ifdef X64_WINDOWS_ABI
+static const uint8_t REG_FSCRATCH2 = REG_XMM1;
+#else
+static const uint8_t REG_FSCRATCH2 = REG_XMM8;
+#endif
+
 // condition mapping table
 static const uint8_t condition_map[uml::COND_MAX - uml::COND_Z] =
 {
@@ -415,6 +423,7 @@ const drcbe_x64::opcode_table_entry drcbe_x64::s_opcode_table_source[] =
 	{ uml::OP_FSUB,    &drcbe_x64::op_fsub },       // FSUB    dst,src1,src2
 	{ uml::OP_FCMP,    &drcbe_x64::op_fcmp },       // FCMP    src1,src2
 	{ uml::OP_FMUL,    &drcbe_x64::op_fmul },       // FMUL    dst,src1,src2
+	{ uml::OP_FMADD,   &drcbe_x64::op_fmadd },      // FMADD   dst,src1,src2,src3
 	{ uml::OP_FDIV,    &drcbe_x64::op_fdiv },       // FDIV    dst,src1,src2
 	{ uml::OP_FNEG,    &drcbe_x64::op_fneg },       // FNEG    dst,src1
 	{ uml::OP_FABS,    &drcbe_x64::op_fabs },       // FABS    dst,src1
@@ -622,6 +631,7 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 		m_labels(cache),
 		m_log(nullptr),
 		m_sse41(false),
+		m_fma3(false),
 		m_absmask32((uint32_t *)cache.alloc_near(16*2 + 15)),
 		m_absmask64(nullptr),
 		m_rbpvalue(cache.near() + 0x80),
@@ -632,6 +642,9 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 		m_fixup_exception(&drcbe_x64::fixup_exception, this),
 		m_near(*(near_state *)cache.alloc_near(sizeof(m_near)))
 {
+	// register to repatch direct chain sites when hash cells change
+	m_hash.set_chain_patcher(drc_hash_chain_delegate(&drcbe_x64::patch_chain, this));
+
 	// build up necessary arrays
 	static const uint32_t sse_control[4] =
 	{
@@ -734,8 +747,10 @@ void drcbe_x64::reset()
 	emit_pop_r64(dst, REG_RBX);                                                         // pop   rbx
 	emit_ret(dst);                                                                      // ret
 
-	// call it to determine if we have SSE4.1 support
-	m_sse41 = (((*cpuid_ecx_stub)() & 0x80000) != 0);
+	// call it to determine if we have SSE4.1 and FMA3 support
+	uint32_t const features = (*cpuid_ecx_stub)();
+	m_sse41 = (features & 0x80000) != 0;
+	m_fma3 = (features & 0x1000) != 0;
 
 	// generate an entry point
 	m_entry = (x86_entry_point_func)dst;
@@ -2609,6 +2624,19 @@ void drcbe_x64::fixup_label(void *parameter, drccodeptr labelcodeptr)
 }
 
 
+//-------------------------------------------------
+//  patch_chain - rewrite a direct chain site to
+//  call newly translated code for its target
+//-------------------------------------------------
+
+void drcbe_x64::patch_chain(drccodeptr site, drccodeptr target)
+{
+	// the site holds a 5-byte call; re-emitting in place updates the rel32
+	x86code *dst = (x86code *)site;
+	emit_call(dst, (x86code *)target);
+}
+
+
 //-------------------------------------------------
 //  fixup_exception - callback to perform cleanup
 //  and jump to an exception handler
@@ -2716,6 +2744,7 @@ void drcbe_x64::op_hash(x86code *&dst, const instruction &inst)
 
 	// register the current pointer for the mode/PC
 	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), dst);
+	m_drcuml.note_translation(inst.param(0).immediate(), inst.param(1).immediate());
 }
 
 
@@ -2867,13 +2896,14 @@ void drcbe_x64::op_hashjmp(x86code *&dst, const instruction &inst)
 	// fixed mode cases
 	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
 	{
-		// a straight immediate jump is direct, though we need the PC in EAX in case of failure
+		// a straight immediate jump chains directly to the target (or the nocode
+		// stub); the site is registered so that set_codeptr repatches it whenever
+		// the target is (re)translated
 		if (pcp.is_immediate())
 		{
-			uint32_t l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
-			uint32_t l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
-			emit_call_m64(dst, MABS(&m_hash.base()[modep.immediate()][l1val][l2val]));
-																						// call  hash[modep][l1val][l2val]
+			drccodeptr target = m_hash.get_codeptr(modep.immediate(), pcp.immediate());
+			m_hash.register_chain_site((drccodeptr)dst, modep.immediate(), pcp.immediate());
+			emit_call(dst, (target != nullptr) ? (x86code *)target : m_nocode);         // call  <target|nocode>
 		}
 
 		// a fixed mode but variable PC
@@ -6549,6 +6579,91 @@ void drcbe_x64::op_fmul(x86code *&dst, const instruction &inst)
 }
 
 
+//-------------------------------------------------
+//  op_fmadd - process a FMADD opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_fmadd(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+	be_parameter src3p(*this, inst.param(3), PTYPE_MF);
+	normalize_commutative(src1p, src2p);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_XMM0, src2p, src3p);
+
+	// 32-bit form
+	if (inst.size() == 4)
+	{
+		emit_movss_r128_p32(dst, dstreg, src1p);                                        // movss dstreg,src1p
+		if (m_fma3)
+		{
+			// fused form with a single rounding of the result
+			int src2reg = src2p.is_float_register() ? src2p.freg() : REG_FSCRATCH2;
+			if (!src2p.is_float_register())
+				emit_movss_r128_m32(dst, src2reg, MABS(src2p.memory()));                // movss src2reg,[src2p]
+			if (src3p.is_memory())
+				emit_vfmadd213ss_r128_r128_m32(dst, dstreg, src2reg, MABS(src3p.memory()));
+																						// vfmadd213ss dstreg,src2reg,[src3p]
+			else
+				emit_vfmadd213ss_r128_r128_r128(dst, dstreg, src2reg, src3p.freg());    // vfmadd213ss dstreg,src2reg,src3p
+		}
+		else
+		{
+			// no host FMA: separate multiply and add, rounding twice
+			if (src2p.is_memory())
+				emit_mulss_r128_m32(dst, dstreg, MABS(src2p.memory()));                 // mulss dstreg,[src2p]
+			else if (src2p.is_float_register())
+				emit_mulss_r128_r128(dst, dstreg, src2p.freg());                        // mulss dstreg,src2p
+			if (src3p.is_memory())
+				emit_addss_r128_m32(dst, dstreg, MABS(src3p.memory()));                 // addss dstreg,[src3p]
+			else if (src3p.is_float_register())
+				emit_addss_r128_r128(dst, dstreg, src3p.freg());                        // addss dstreg,src3p
+		}
+		emit_movss_p32_r128(dst, dstp, dstreg);                                         // movss dstp,dstreg
+	}
+
+	// 64-bit form
+	else if (inst.size() == 8)
+	{
+		emit_movsd_r128_p64(dst, dstreg, src1p);                                        // movsd dstreg,src1p
+		if (m_fma3)
+		{
+			// fused form with a single rounding of the result
+			int src2reg = src2p.is_float_register() ? src2p.freg() : REG_FSCRATCH2;
+			if (!src2p.is_float_register())
+				emit_movsd_r128_m64(dst, src2reg, MABS(src2p.memory()));                // movsd src2reg,[src2p]
+			if (src3p.is_memory())
+				emit_vfmadd213sd_r128_r128_m64(dst, dstreg, src2reg, MABS(src3p.memory()));
+																						// vfmadd213sd dstreg,src2reg,[src3p]
+			else
+				emit_vfmadd213sd_r128_r128_r128(dst, dstreg, src2reg, src3p.freg());    // vfmadd213sd dstreg,src2reg,src3p
+		}
+		else
+		{
+			// no host FMA: separate multiply and add, rounding twice
+			if (src2p.is_memory())
+				emit_mulsd_r128_m64(dst, dstreg, MABS(src2p.memory()));                 // mulsd dstreg,[src2p]
+			else if (src2p.is_float_register())
+				emit_mulsd_r128_r128(dst, dstreg, src2p.freg());                        // mulsd dstreg,src2p
+			if (src3p.is_memory())
+				emit_addsd_r128_m64(dst, dstreg, MABS(src3p.memory()));                 // addsd dstreg,[src3p]
+			else if (src3p.is_float_register())
+				emit_addsd_r128_r128(dst, dstreg, src3p.freg());                        // addsd dstreg,src3p
+		}
+		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd dstp,dstreg
+	}
+}
+
+
 //-------------------------------------------------
 //  op_fdiv - process a FDIV opcode
 //-------------------------------------------------
@@ -123,6 +123,7 @@ private:
 
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	void fixup_exception(drccodeptr *codeptr, void *param1, void *param2);
+	void patch_chain(drccodeptr site, drccodeptr target);
 
 	static void debug_log_hashjmp(offs_t pc, int mode);
 	static void debug_log_hashjmp_fail();
@@ -202,6 +203,7 @@ private:
 	void op_fsub(x86code *&dst, const uml::instruction &inst);
 	void op_fcmp(x86code *&dst, const uml::instruction &inst);
 	void op_fmul(x86code *&dst, const uml::instruction &inst);
+	void op_fmadd(x86code *&dst, const uml::instruction &inst);
 	void op_fdiv(x86code *&dst, const uml::instruction &inst);
 	void op_fneg(x86code *&dst, const uml::instruction &inst);
 	void op_fabs(x86code *&dst, const uml::instruction &inst);
@@ -299,6 +301,7 @@ private:
 	drc_label_list          m_labels;               // label list
 	x86log_context *        m_log;                  // logging
 	bool                    m_sse41;                // do we have SSE4.1 support?
+	bool                    m_fma3;                 // do we have FMA3 support?
 
 	uint32_t *                m_absmask32;            // absolute value mask (32-bit)
 	uint64_t *                m_absmask64;            // absolute value mask (32-bit)
@@ -277,6 +277,7 @@ const drcbe_x86::opcode_table_entry drcbe_x86::s_opcode_table_source[] =
 	{ uml::OP_FSUB,    &drcbe_x86::op_fsub },       // FSUB    dst,src1,src2
 	{ uml::OP_FCMP,    &drcbe_x86::op_fcmp },       // FCMP    src1,src2
 	{ uml::OP_FMUL,    &drcbe_x86::op_fmul },       // FMUL    dst,src1,src2
+	{ uml::OP_FMADD,   &drcbe_x86::op_fmadd },      // FMADD   dst,src1,src2,src3
 	{ uml::OP_FDIV,    &drcbe_x86::op_fdiv },       // FDIV    dst,src1,src2
 	{ uml::OP_FNEG,    &drcbe_x86::op_fneg },       // FNEG    dst,src1
 	{ uml::OP_FABS,    &drcbe_x86::op_fabs },       // FABS    dst,src1
@@ -2921,6 +2922,7 @@ void drcbe_x86::op_hash(x86code *&dst, const instruction &inst)
 
 	// register the current pointer for the mode/PC
 	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), dst);
+	m_drcuml.note_translation(inst.param(0).immediate(), inst.param(1).immediate());
 	reset_last_upper_lower_reg();
 }
 
@@ -6373,6 +6375,36 @@ void drcbe_x86::op_fmul(x86code *&dst, const instruction &inst)
 }
 
 
+//-------------------------------------------------
+//  op_fmadd - process a FMADD opcode; the
+//  product stays on the x87 stack, avoiding an
+//  intermediate store and reload
+//-------------------------------------------------
+
+void drcbe_x86::op_fmadd(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+	be_parameter src3p(*this, inst.param(3), PTYPE_MF);
+	normalize_commutative(src1p, src2p);
+
+	// general case
+	emit_fld_p(dst, inst.size(), src1p);                                                // fld   src1p
+	emit_fld_p(dst, inst.size(), src2p);                                                // fld   src2p
+	emit_fmulp(dst);                                                                    // fmulp
+	emit_fld_p(dst, inst.size(), src3p);                                                // fld   src3p
+	emit_faddp(dst);                                                                    // faddp
+	emit_fstp_p(dst, inst.size(), dstp);                                                // fstp  dstp
+}
+
+
 //-------------------------------------------------
 //  op_fdiv - process a FDIV opcode
 //-------------------------------------------------
@@ -204,6 +204,7 @@ private:
 	void op_fsub(x86code *&dst, const uml::instruction &inst);
 	void op_fcmp(x86code *&dst, const uml::instruction &inst);
 	void op_fmul(x86code *&dst, const uml::instruction &inst);
+	void op_fmadd(x86code *&dst, const uml::instruction &inst);
 	void op_fdiv(x86code *&dst, const uml::instruction &inst);
 	void op_fneg(x86code *&dst, const uml::instruction &inst);
 	void op_fabs(x86code *&dst, const uml::instruction &inst);
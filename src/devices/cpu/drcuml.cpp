@@ -50,6 +50,10 @@
 #define VALIDATE_BACKEND        (0)
 #define LOG_SIMPLIFICATIONS     (0)
 
+// warm cache file format
+static constexpr u32 WARM_CACHE_MAGIC = 0x44524357;     // 'DRCW'
+static constexpr u32 WARM_CACHE_VERSION = 1;
+
 
 
 //**************************************************************************
@@ -146,6 +150,10 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_blocklist()
 	, m_handlelist()
 	, m_symlist()
+	, m_warmenable(device.machine().options().drc_warm_cache())
+	, m_warmfile(util::string_format("drcwarm_%s_%s.bin", device.machine().system().name, device.shortname()))
+	, m_warmlist()
+	, m_warmset()
 {
 }
 
@@ -156,6 +164,7 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 
 drcuml_state::~drcuml_state()
 {
+	save_warm_cache();
 }
 
 
@@ -289,6 +298,79 @@ void drcuml_state::log_vprintf(util::format_argument_pack<std::ostream> const &a
 }
 
 
+//-------------------------------------------------
+//  note_translation - remember that code was
+//  generated for the given mode/pc, so it can be
+//  retranslated early next run
+//-------------------------------------------------
+
+void drcuml_state::note_translation(u32 mode, u32 pc)
+{
+	if (!m_warmenable)
+		return;
+	u64 const key = (u64(mode) << 32) | pc;
+	if (m_warmset.insert(key).second)
+		m_warmlist.push_back(key);
+}
+
+
+//-------------------------------------------------
+//  load_warm_cache - replay last session's
+//  translations through the given compile
+//  callback; only mode/pc pairs are persisted,
+//  never generated code, so a stale file costs
+//  time but cannot inject bad code
+//-------------------------------------------------
+
+void drcuml_state::load_warm_cache(std::function<void (u32 mode, offs_t pc)> const &compile)
+{
+	if (!m_warmenable)
+		return;
+
+	std::ifstream file(m_warmfile.c_str(), std::ios::binary);
+	if (!file)
+		return;
+
+	// validate the header
+	u32 header[3];
+	file.read(reinterpret_cast<char *>(header), sizeof(header));
+	if (!file || header[0] != WARM_CACHE_MAGIC || header[1] != WARM_CACHE_VERSION)
+		return;
+
+	// cap the entry count to something sane in case the file is damaged
+	u32 const count = std::min<u32>(header[2], 1000000);
+	for (u32 index = 0; index < count; index++)
+	{
+		u64 key;
+		file.read(reinterpret_cast<char *>(&key), sizeof(key));
+		if (!file)
+			break;
+		if (!m_beintf->hash_exists(u32(key >> 32), u32(key)))
+			compile(u32(key >> 32), offs_t(key));
+	}
+}
+
+
+//-------------------------------------------------
+//  save_warm_cache - write out the mode/pc pairs
+//  translated this session
+//-------------------------------------------------
+
+void drcuml_state::save_warm_cache()
+{
+	if (!m_warmenable || m_warmlist.empty())
+		return;
+
+	std::ofstream file(m_warmfile.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+		return;
+
+	u32 const header[3] = { WARM_CACHE_MAGIC, WARM_CACHE_VERSION, u32(m_warmlist.size()) };
+	file.write(reinterpret_cast<char const *>(header), sizeof(header));
+	file.write(reinterpret_cast<char const *>(&m_warmlist[0]), m_warmlist.size() * sizeof(m_warmlist[0]));
+}
+
+
 
 //**************************************************************************
 //  DRCUML BLOCK
@@ -393,6 +475,28 @@ void drcuml_block::optimize()
 {
 	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
 
+	// per-register tracking for the propagation pass; an entry is only
+	// valid between the defining MOV and the next barrier/redefinition
+	struct reg_state
+	{
+		u8      valid = 0;      // do we know anything about this register?
+		u8      is_copy = 0;    // is it a copy of another register?
+		u8      size = 0;       // size of the defining MOV
+		u8      copyreg = 0;    // source register index if a copy
+		u64     value = 0;      // constant value if not a copy
+	};
+	reg_state regmap[uml::REG_I_COUNT];
+
+	auto const invalidate_reg = [&regmap] (int regnum)
+	{
+		regmap[regnum].valid = 0;
+
+		// copies sourced from this register die with it
+		for (reg_state &state : regmap)
+			if (state.valid && state.is_copy && state.copyreg == regnum)
+				state.valid = 0;
+	};
+
 	// iterate over instructions
 	for (int instnum = 0; instnum < m_nextinst; instnum++)
 	{
@@ -425,8 +529,74 @@ void drcuml_block::optimize()
 				if (inst.param(pnum).is_mapvar())
 					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
 
+		// propagate known constants and copies into input parameters;
+		// substituting sources is safe regardless of condition or flags
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (!param.is_int_register() || inst.param_is_output(pnum))
+				continue;
+			reg_state const &state(regmap[param.ireg() - uml::REG_I0]);
+			if (!state.valid || state.size < inst.size())
+				continue;
+			if (state.is_copy)
+				inst.substitute_param(pnum, uml::parameter::make_ireg(uml::REG_I0 + state.copyreg));
+			else if (inst.param_allows_immediate(pnum))
+				inst.substitute_param(pnum, state.value);
+		}
+
 		// now that flags are correct, simplify the instruction
 		inst.simplify();
+
+		// finally update the tracking; control flow in or out of the
+		// block, calls and state restores invalidate everything
+		switch (inst.opcode())
+		{
+			case uml::OP_HANDLE:
+			case uml::OP_HASH:
+			case uml::OP_LABEL:
+			case uml::OP_DEBUG:
+			case uml::OP_EXIT:
+			case uml::OP_HASHJMP:
+			case uml::OP_JMP:
+			case uml::OP_EXH:
+			case uml::OP_CALLH:
+			case uml::OP_RET:
+			case uml::OP_CALLC:
+			case uml::OP_RESTORE:
+				for (reg_state &state : regmap)
+					state.valid = 0;
+				break;
+
+			default:
+				// any written register loses its known value, even on a
+				// conditional instruction
+				for (int pnum = 0; pnum < inst.numparams(); pnum++)
+					if (inst.param(pnum).is_int_register() && inst.param_is_output(pnum))
+						invalidate_reg(inst.param(pnum).ireg() - uml::REG_I0);
+
+				// an unconditional MOV to a register defines a constant or
+				// a copy we can propagate forward
+				if (inst.opcode() == uml::OP_MOV && inst.condition() == uml::COND_ALWAYS && inst.param(0).is_int_register())
+				{
+					reg_state &state(regmap[inst.param(0).ireg() - uml::REG_I0]);
+					if (inst.param(1).is_immediate())
+					{
+						state.valid = 1;
+						state.is_copy = 0;
+						state.size = inst.size();
+						state.value = (inst.size() == 4) ? u32(inst.param(1).immediate()) : inst.param(1).immediate();
+					}
+					else if (inst.param(1).is_int_register())
+					{
+						state.valid = 1;
+						state.is_copy = 1;
+						state.size = inst.size();
+						state.copyreg = inst.param(1).ireg() - uml::REG_I0;
+					}
+				}
+				break;
+		}
 	}
 }
 
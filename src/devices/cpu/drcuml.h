@@ -15,9 +15,11 @@
 #include "drccache.h"
 #include "uml.h"
 
+#include <functional>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 
@@ -196,6 +198,12 @@ public:
 	void log_flush() { if (logging()) m_umllog->flush(); }
 	bool logging_native() const { return m_beintf->logging(); }
 
+	// warm cache; translated mode/pc pairs remembered across runs so a
+	// core can retranslate last session's hot blocks at startup
+	void note_translation(u32 mode, u32 pc);
+	void load_warm_cache(std::function<void (u32 mode, offs_t pc)> const &compile);
+	void save_warm_cache();
+
 private:
 	// symbol class
 	class symbol
@@ -228,6 +236,11 @@ private:
 	std::list<drcuml_block>                 m_blocklist;        // list of active blocks
 	std::list<uml::code_handle>             m_handlelist;       // list of active handles
 	std::list<symbol>                       m_symlist;          // list of symbols
+
+	bool                                    m_warmenable;       // is the warm cache enabled?
+	std::string                             m_warmfile;         // warm cache file name
+	std::vector<u64>                        m_warmlist;         // translated mode/pc pairs, in first-seen order
+	std::unordered_set<u64>                 m_warmset;          // the same pairs, for cheap dedupe
 };
 
 
@@ -151,6 +151,7 @@
 #define UML_FSSUB(block, dst, src1, src2)                   do { using namespace uml; block.append().fssub(dst, src1, src2); } while (0)
 #define UML_FSCMP(block, src1, src2)                        do { using namespace uml; block.append().fscmp(src1, src2); } while (0)
 #define UML_FSMUL(block, dst, src1, src2)                   do { using namespace uml; block.append().fsmul(dst, src1, src2); } while (0)
+#define UML_FSMADD(block, dst, src1, src2, src3)            do { using namespace uml; block.append().fsmadd(dst, src1, src2, src3); } while (0)
 #define UML_FSDIV(block, dst, src1, src2)                   do { using namespace uml; block.append().fsdiv(dst, src1, src2); } while (0)
 #define UML_FSNEG(block, dst, src1)                         do { using namespace uml; block.append().fsneg(dst, src1); } while (0)
 #define UML_FSABS(block, dst, src1)                         do { using namespace uml; block.append().fsabs(dst, src1); } while (0)
@@ -176,6 +177,7 @@
 #define UML_FDSUB(block, dst, src1, src2)                   do { using namespace uml; block.append().fdsub(dst, src1, src2); } while (0)
 #define UML_FDCMP(block, src1, src2)                        do { using namespace uml; block.append().fdcmp(src1, src2); } while (0)
 #define UML_FDMUL(block, dst, src1, src2)                   do { using namespace uml; block.append().fdmul(dst, src1, src2); } while (0)
+#define UML_FDMADD(block, dst, src1, src2, src3)            do { using namespace uml; block.append().fdmadd(dst, src1, src2, src3); } while (0)
 #define UML_FDDIV(block, dst, src1, src2)                   do { using namespace uml; block.append().fddiv(dst, src1, src2); } while (0)
 #define UML_FDNEG(block, dst, src1)                         do { using namespace uml; block.append().fdneg(dst, src1); } while (0)
 #define UML_FDABS(block, dst, src1)                         do { using namespace uml; block.append().fdabs(dst, src1); } while (0)
@@ -1347,7 +1347,10 @@ void i386_device::i386_task_switch(uint16_t selector, uint8_t nested)
 	}
 	m_cr[3] = READ32(tss+0x1c);  // CR3 (PDBR)
 	if(oldcr3 != m_cr[3])
+	{
 		vtlb_flush_dynamic();
+		invalidate_fetch_cache();
+	}
 
 	/* Set the busy bit in the new task's descriptor */
 	if(selector & 0x0004)
@@ -3217,6 +3220,9 @@ void i386_device::i386_common_init()
 	assert((sizeof(XMM_REG)/sizeof(double)) == 2);
 
 	build_cycle_table();
+	invalidate_fetch_cache();
+	m_fetch_ppage = 0;
+	m_fetch_cpl = 0;
 
 	for( i=0; i < 256; i++ ) {
 		int c=0;
@@ -3956,6 +3962,7 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic();
+	invalidate_fetch_cache();
 }
 
 void i386_device::execute_run()
@@ -287,6 +287,17 @@ protected:
 	address_space *m_io;
 	uint32_t m_a20_mask;
 
+	// one-entry instruction fetch translation cache, maps the current code
+	// page's linear address to its physical page for the privilege level it
+	// was translated at; follows TLB semantics, so it must be invalidated
+	// wherever the vtlb is flushed
+	uint32_t m_fetch_vpage;
+	uint32_t m_fetch_ppage;
+	uint8_t m_fetch_cpl;
+
+	// sentinel is never page-aligned so it can't match a fetch address
+	void invalidate_fetch_cache() { m_fetch_vpage = 1; }
+
 	int m_cpuid_max_input_value_eax; // Highest CPUID standard function available
 	uint32_t m_cpuid_id0, m_cpuid_id1, m_cpuid_id2;
 	uint32_t m_cpu_version;
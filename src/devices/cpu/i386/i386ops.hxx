@@ -697,11 +697,13 @@ void i386_device::i386_mov_cr_r32()        // Opcode 0x0f 22
 		case 0:
 			data &= 0xfffeffff; // wp not supported on 386
 			CYCLES(CYCLES_MOV_REG_CR0);
+			invalidate_fetch_cache();
 			break;
 		case 2: CYCLES(CYCLES_MOV_REG_CR2); break;
 		case 3:
 			CYCLES(CYCLES_MOV_REG_CR3);
 			vtlb_flush_dynamic();
+			invalidate_fetch_cache();
 			break;
 		case 4: CYCLES(1); break; // TODO
 		default:
@@ -525,6 +525,7 @@ bool i386_device::translate_address(int pl, int type, uint32_t *address, uint32_
 void i386_device::CHANGE_PC(uint32_t pc)
 {
 	m_pc = i386_translate(CS, pc, -1 );
+	invalidate_fetch_cache();
 }
 
 void i386_device::NEAR_BRANCH(int32_t offs)
@@ -539,8 +540,16 @@ uint8_t i386_device::FETCH()
 	uint8_t value;
 	uint32_t address = m_pc, error;
 
-	if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
-		PF_THROW(error);
+	if((address & 0xfffff000) == m_fetch_vpage && m_CPL == m_fetch_cpl)
+		address = m_fetch_ppage | (address & 0xfff);
+	else
+	{
+		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+			PF_THROW(error);
+		m_fetch_vpage = m_pc & 0xfffff000;
+		m_fetch_ppage = address & 0xfffff000;
+		m_fetch_cpl = m_CPL;
+	}
 
 	value = m_pr8(address & m_a20_mask);
 #ifdef DEBUG_MISSING_OPCODE
@@ -560,8 +569,16 @@ uint16_t i386_device::FETCH16()
 		value = (FETCH() << 0);
 		value |= (FETCH() << 8);
 	} else {
-		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
-			PF_THROW(error);
+		if((address & 0xfffff000) == m_fetch_vpage && m_CPL == m_fetch_cpl)
+			address = m_fetch_ppage | (address & 0xfff);
+		else
+		{
+			if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+				PF_THROW(error);
+			m_fetch_vpage = m_pc & 0xfffff000;
+			m_fetch_ppage = address & 0xfffff000;
+			m_fetch_cpl = m_CPL;
+		}
 		address &= m_a20_mask;
 		value = m_pr16(address);
 		m_eip += 2;
@@ -580,8 +597,16 @@ uint32_t i386_device::FETCH32()
 		value |= (FETCH() << 16);
 		value |= (FETCH() << 24);
 	} else {
-		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
-			PF_THROW(error);
+		if((address & 0xfffff000) == m_fetch_vpage && m_CPL == m_fetch_cpl)
+			address = m_fetch_ppage | (address & 0xfff);
+		else
+		{
+			if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+				PF_THROW(error);
+			m_fetch_vpage = m_pc & 0xfffff000;
+			m_fetch_ppage = address & 0xfffff000;
+			m_fetch_cpl = m_CPL;
+		}
 
 		address &= m_a20_mask;
 		value = m_pr32(address);
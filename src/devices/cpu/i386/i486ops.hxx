@@ -325,6 +325,7 @@ void i386_device::i486_group0F01_16()      // Opcode 0x0f 01
 				ea = GetEA(modrm,-1);
 				CYCLES(25); // TODO: add to cycles.h
 				vtlb_flush_address(ea);
+				invalidate_fetch_cache();
 				break;
 			}
 		default:
@@ -443,6 +444,7 @@ void i386_device::i486_group0F01_32()      // Opcode 0x0f 01
 				ea = GetEA(modrm,-1);
 				CYCLES(25); // TODO: add to cycles.h
 				vtlb_flush_address(ea);
+				invalidate_fetch_cache();
 				break;
 			}
 		default:
@@ -513,11 +515,13 @@ void i386_device::i486_mov_cr_r32()        // Opcode 0x0f 22
 			CYCLES(CYCLES_MOV_REG_CR0);
 			if((oldcr ^ m_cr[cr]) & 0x80010000)
 				vtlb_flush_dynamic();
+			invalidate_fetch_cache();
 			break;
 		case 2: CYCLES(CYCLES_MOV_REG_CR2); break;
 		case 3:
 			CYCLES(CYCLES_MOV_REG_CR3);
 			vtlb_flush_dynamic();
+			invalidate_fetch_cache();
 			break;
 		case 4: CYCLES(1); break; // TODO
 		default:
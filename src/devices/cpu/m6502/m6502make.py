@@ -77,6 +77,13 @@ FULL_MEMORY="""\
 \ticount--;
 """
 
+# first access of an instruction needs no icount check, the exec loops
+# only dispatch a full handler when icount > 0
+FULL_MEMORY_FIRST="""\
+%(ins)s
+\ticount--;
+"""
+
 FULL_NONE="""\
 %(ins)s
 """
@@ -126,6 +133,7 @@ def save_opcodes(f, device, opcodes):
 
         emit(f, FULL_PROLOG % d)
         substate = 1
+        first_access = True
         for ins in instructions:
             d["substate"] = str(substate)
             d["ins"] =  ins
@@ -133,9 +141,14 @@ def save_opcodes(f, device, opcodes):
             if line_type == "EAT":
                 emit(f, FULL_EAT_ALL % d)
                 substate += 1
+                first_access = False
             elif line_type == "MEMORY":
-                emit(f, FULL_MEMORY % d)
+                if first_access:
+                    emit(f, FULL_MEMORY_FIRST % d)
+                else:
+                    emit(f, FULL_MEMORY % d)
                 substate += 1
+                first_access = False
             else:
                 emit(f, FULL_NONE %d)
         emit(f, FULL_EPILOG % d)
@@ -165,6 +165,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_drcfe(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
+	, m_drc_warmed(0)
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
@@ -5033,6 +5034,13 @@ void mips3_device::execute_run()
 			code_flush_cache();
 		m_cache_dirty = false;
 
+		/* on the first run, retranslate anything remembered from last session */
+		if (!m_drc_warmed)
+		{
+			m_drc_warmed = true;
+			m_drcuml->load_warm_cache([this] (uint32_t mode, offs_t pc) { code_compile_block(mode, pc); });
+		}
+
 		/* execute */
 		do
 		{
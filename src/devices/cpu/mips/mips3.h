@@ -467,6 +467,7 @@ protected:
 
 												/* internal stuff */
 	uint8_t         m_cache_dirty;              /* true if we need to flush the cache */
+	uint8_t         m_drc_warmed;               /* true once the warm cache has been replayed */
 
 												/* tables */
 	uint8_t         m_fpmode[4];                /* FPU mode table */
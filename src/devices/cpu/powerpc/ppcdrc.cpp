@@ -3533,8 +3533,7 @@ bool ppc_device::generate_instruction_3b(drcuml_block &block, compiler_state *co
 		case 0x1d:  /* FMADDSx */
 			if (!(m_drcoptions & PPCDRC_ACCURATE_SINGLES))
 				return generate_instruction_3f(block, compiler, desc);
-			UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-			UML_FDADD(block, F0, F0, F64(G_RB(op)));                                // fdadd   f0,f0,rb
+			UML_FDMADD(block, F0, F64(G_RA(op)), F64(G_REGC(op)), F64(G_RB(op)));       // fdmadd  f0,ra,rc,rb
 			UML_FDRNDS(block, F64(G_RD(op)), F0);                                       // fdrnds  rd,f0
 			generate_fp_flags(block, desc, true);
 			return true;
@@ -3542,8 +3541,8 @@ bool ppc_device::generate_instruction_3b(drcuml_block &block, compiler_state *co
 		case 0x1c:  /* FMSUBSx */
 			if (!(m_drcoptions & PPCDRC_ACCURATE_SINGLES))
 				return generate_instruction_3f(block, compiler, desc);
-			UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-			UML_FDSUB(block, F0, F0, F64(G_RB(op)));                                // fdsub   f0,f0,rb
+			UML_FDNEG(block, F0, F64(G_RB(op)));                                        // fdneg   f0,rb
+			UML_FDMADD(block, F0, F64(G_RA(op)), F64(G_REGC(op)), F0);                  // fdmadd  f0,ra,rc,f0
 			UML_FDRNDS(block, F64(G_RD(op)), F0);                                       // fdrnds  rd,f0
 			generate_fp_flags(block, desc, true);
 			return true;
@@ -3551,8 +3550,7 @@ bool ppc_device::generate_instruction_3b(drcuml_block &block, compiler_state *co
 		case 0x1f:  /* FNMADDSx */
 			if (!(m_drcoptions & PPCDRC_ACCURATE_SINGLES))
 				return generate_instruction_3f(block, compiler, desc);
-			UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-			UML_FDADD(block, F0, F0, F64(G_RB(op)));                                // fdadd   f0,f0,rb
+			UML_FDMADD(block, F0, F64(G_RA(op)), F64(G_REGC(op)), F64(G_RB(op)));       // fdmadd  f0,ra,rc,rb
 			UML_FDNEG(block, F0, F0);                                               // fdneg   f0,f0
 			UML_FDRNDS(block, F64(G_RD(op)), F0);                                       // fdrnds  rd,f0
 			generate_fp_flags(block, desc, true);
@@ -3561,8 +3559,8 @@ bool ppc_device::generate_instruction_3b(drcuml_block &block, compiler_state *co
 		case 0x1e:  /* FNMSUBSx */
 			if (!(m_drcoptions & PPCDRC_ACCURATE_SINGLES))
 				return generate_instruction_3f(block, compiler, desc);
-			UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-			UML_FDSUB(block, F0, F64(G_RB(op)), F0);                                // fdsub   f0,rb,f0
+			UML_FDNEG(block, F0, F64(G_RA(op)));                                        // fdneg   f0,ra
+			UML_FDMADD(block, F0, F0, F64(G_REGC(op)), F64(G_RB(op)));                  // fdmadd  f0,f0,rc,rb
 			UML_FDRNDS(block, F64(G_RD(op)), F0);                                       // fdrnds  rd,f0
 			generate_fp_flags(block, desc, true);
 			return true;
@@ -3631,27 +3629,26 @@ bool ppc_device::generate_instruction_3f(drcuml_block &block, compiler_state *co
 				return true;
 
 			case 0x1d:  /* FMADDx */
-				UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-				UML_FDADD(block, F64(G_RD(op)), F0, F64(G_RB(op)));                         // fdadd   rd,f0,rb
+				UML_FDMADD(block, F64(G_RD(op)), F64(G_RA(op)), F64(G_REGC(op)), F64(G_RB(op)));
+																							// fdmadd  rd,ra,rc,rb
 				generate_fp_flags(block, desc, true);
 				return true;
 
 			case 0x1f:  /* FNMADDx */
-				UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-				UML_FDADD(block, F0, F0, F64(G_RB(op)));                                    // fdadd   f0,f0,rb
+				UML_FDMADD(block, F0, F64(G_RA(op)), F64(G_REGC(op)), F64(G_RB(op)));       // fdmadd  f0,ra,rc,rb
 				UML_FDNEG(block, F64(G_RD(op)), F0);                                        // fdneg   rd,f0
 				generate_fp_flags(block, desc, true);
 				return true;
 
 			case 0x1c:  /* FMSUBx */
-				UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-				UML_FDSUB(block, F64(G_RD(op)), F0, F64(G_RB(op)));                         // fdsub   rd,f0,rb
+				UML_FDNEG(block, F0, F64(G_RB(op)));                                        // fdneg   f0,rb
+				UML_FDMADD(block, F64(G_RD(op)), F64(G_RA(op)), F64(G_REGC(op)), F0);       // fdmadd  rd,ra,rc,f0
 				generate_fp_flags(block, desc, true);
 				return true;
 
 			case 0x1e:  /* FNMSUBx */
-				UML_FDMUL(block, F0, F64(G_RA(op)), F64(G_REGC(op)));                       // fdmul   f0,ra,rc
-				UML_FDSUB(block, F64(G_RD(op)), F64(G_RB(op)), F0);                         // fdsub   rd,rb,f0
+				UML_FDNEG(block, F0, F64(G_RA(op)));                                        // fdneg   f0,ra
+				UML_FDMADD(block, F64(G_RD(op)), F0, F64(G_REGC(op)), F64(G_RB(op)));       // fdmadd  rd,f0,rc,rb
 				generate_fp_flags(block, desc, true);
 				return true;
 		}
@@ -90,12 +90,14 @@ void sh_common_execution::drc_start()
 {
 	/* DRC helpers */
 	memset(m_pcflushes, 0, sizeof(m_pcflushes));
+	memset(m_idleskips, 0, sizeof(m_idleskips));
 
 	m_fastram_select = 0;
 	memset(m_fastram, 0, sizeof(m_fastram));
 
-	/* reset per-driver pcflushes */
+	/* reset per-driver pcflushes and idle-loop annotations */
 	m_pcfsel = 0;
+	m_idlesel = 0;
 
 	/* initialize the UML generator */
 	uint32_t flags = 0;
@@ -152,6 +154,8 @@ void sh_common_execution::drc_start()
 	save_item(NAME(m_pcfsel));
 	//save_item(NAME(m_maxpcfsel));
 	save_item(NAME(m_pcflushes));
+	save_item(NAME(m_idlesel));
+	save_item(NAME(m_idleskips));
 }
 
 /*  code                 cycles  t-bit
@@ -2001,6 +2005,7 @@ void cfunc_DIV1(void *param) { ((sh_common_execution *)param)->func_DIV1(); }
 void cfunc_ADDV(void *param) { ((sh_common_execution *)param)->func_ADDV(); }
 void cfunc_SUBV(void *param) { ((sh_common_execution *)param)->func_SUBV(); }
 void cfunc_printf_probe(void *param) { ((sh_common_execution *)param)->func_printf_probe(); }
+void cfunc_idleskip(void *param) { ((sh_common_execution *)param)->func_idleskip(); }
 
 /*-------------------------------------------------
     sh2drc_add_fastram - add a new fastram
@@ -2331,6 +2336,56 @@ void sh_common_execution::execute_run_drc()
 }
 
 
+/*-------------------------------------------------
+    idle_loop_detected - check whether a sequence
+    is an idle poll loop whose iterations can
+    yield the timeslice
+-------------------------------------------------*/
+
+bool sh_common_execution::idle_loop_detected(const opcode_desc *seqhead, const opcode_desc *seqlast) const
+{
+	/* per-driver annotations cover the loops we cannot prove */
+	for (int skipsel = 0; skipsel < m_idlesel; skipsel++)
+		if (seqhead->pc == m_idleskips[skipsel])
+			return true;
+
+	/* automatic detection is opt-in via SH2DRC_IDLE_LOOPS */
+	if (!(m_drcoptions & SH2DRC_IDLE_LOOPS))
+		return false;
+
+	/* look for a short conditional loop back to the head of the sequence whose
+	   body polls memory but writes nothing and has no other side effects */
+	if (!(seqlast->flags & OPFLAG_IS_CONDITIONAL_BRANCH) || seqlast->targetpc != seqhead->pc)
+		return false;
+
+	int numinst = 0;
+	bool polls = false;
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		const opcode_desc *deldesc;
+
+		if (curdesc->flags & (OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_CAN_CHANGE_MODES | OPFLAG_IS_UNCONDITIONAL_BRANCH))
+			return false;
+		if (curdesc->flags & OPFLAG_READS_MEMORY)
+			polls = true;
+		numinst++;
+
+		/* the delay slot must be equally side-effect free */
+		for (deldesc = curdesc->delay.first(); deldesc != nullptr; deldesc = deldesc->next())
+		{
+			if (deldesc->flags & (OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_CAN_CHANGE_MODES))
+				return false;
+			if (deldesc->flags & OPFLAG_READS_MEMORY)
+				polls = true;
+			numinst++;
+		}
+	}
+
+	/* insist on an actual memory poll so cycle-counted delay loops keep their timing */
+	return polls && numinst <= 4;
+}
+
+
 /*-------------------------------------------------
     code_compile_block - compile a block of the
     given mode at the specified pc
@@ -2406,6 +2461,10 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 				}
 
+				/* idle poll loops yield the rest of the timeslice on each entry */
+				if (idle_loop_detected(seqhead, seqlast))
+					UML_CALLC(block, cfunc_idleskip, this);                                 // callc   cfunc_idleskip
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 				{
@@ -2640,6 +2699,14 @@ void sh_common_execution::generate_delay_slot(drcuml_block &block, compiler_stat
 	compiler.labelnum = compiler_temp.labelnum;
 }
 
+void sh_common_execution::func_idleskip()
+{
+	// the head of an idle poll loop was entered: give the rest of the
+	// timeslice back to the scheduler; the loop (and its poll) is re-run
+	// once per timeslice until the condition changes
+	spin();
+}
+
 void sh_common_execution::func_unimplemented()
 {
 	// set up an invalid opcode exception
@@ -4296,3 +4363,18 @@ void sh_common_execution::sh2drc_add_pcflush(offs_t address)
 	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
 		m_pcflushes[m_pcfsel++] = address;
 }
+
+
+/*-------------------------------------------------
+    sh2drc_add_idleskip - annotate the head of an
+    idle poll loop that the detector cannot prove
+    so it yields the timeslice when entered
+-------------------------------------------------*/
+
+void sh_common_execution::sh2drc_add_idleskip(offs_t address)
+{
+	if (!allow_drc()) return;
+
+	if (m_idlesel < ARRAY_LENGTH(m_idleskips))
+		m_idleskips[m_idlesel++] = address;
+}
@@ -34,9 +34,10 @@
 #define SH2DRC_STRICT_VERIFY    0x0001          /* verify all instructions */
 #define SH2DRC_FLUSH_PC         0x0002          /* flush the PC value before each memory access */
 #define SH2DRC_STRICT_PCREL     0x0004          /* do actual loads on MOVLI/MOVWI instead of collapsing to immediates */
+#define SH2DRC_IDLE_LOOPS       0x0008          /* auto-detect idle poll loops and yield the timeslice */
 
 #define SH2DRC_COMPATIBLE_OPTIONS   (SH2DRC_STRICT_VERIFY | SH2DRC_FLUSH_PC | SH2DRC_STRICT_PCREL)
-#define SH2DRC_FASTEST_OPTIONS  (0)
+#define SH2DRC_FASTEST_OPTIONS  (SH2DRC_IDLE_LOOPS)
 
 #define SH2_MAX_FASTRAM       4
 
@@ -376,6 +377,9 @@ public:
 	int m_pcfsel;                 // last pcflush entry set
 	uint32_t m_pcflushes[16];           // pcflush entries
 
+	int m_idlesel;                // last idle-skip entry set
+	uint32_t m_idleskips[16];           // annotated idle-loop head addresses
+
 	virtual void init_drc_frontend() = 0;
 
 	void drc_start();
@@ -439,6 +443,7 @@ public:
 
 	void func_printf_probe();
 	void func_unimplemented();
+	void func_idleskip();
 	void func_MAC_W();
 	void func_MAC_L();
 	void func_DIV1();
@@ -451,6 +456,7 @@ public:
 
 	void sh2drc_set_options(uint32_t options);
 	void sh2drc_add_pcflush(offs_t address);
+	void sh2drc_add_idleskip(offs_t address);
 
 	virtual void static_generate_entry_point() = 0;
 	virtual void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle *&handleptr) = 0;
@@ -465,6 +471,7 @@ public:
 	void log_opcode_desc(const opcode_desc *desclist, int indent);
 	void log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op);
 	void generate_delay_slot(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t ovrpc);
+	bool idle_loop_detected(const opcode_desc *seqhead, const opcode_desc *seqlast) const;
 	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t ovrpc);
 	void static_generate_nocode_handler();
@@ -1019,6 +1019,10 @@ void adsp21062_device::execute_run()
 	{
 		if (m_core->idle && m_core->irq_pending == 0)
 		{
+			// nothing observable can happen until an interrupt arrives, so
+			// suspend instead of burning a timeslice per quantum; every
+			// site that raises irq_pending also signals the trigger
+			spin_until_interrupt();
 			m_core->icount = 0;
 			debugger_instruction_hook(m_core->daddr);
 		}
@@ -154,6 +154,7 @@ void adsp21062_device::dma_op(int channel)
 		if (m_core->imask & (1 << (channel+10)))
 		{
 			m_core->irq_pending |= 1 << (channel+10);
+			signal_interrupt_trigger();
 		}
 	}
 
@@ -236,6 +237,7 @@ TIMER_CALLBACK_MEMBER(adsp21062_device::sharc_dma_callback)
 	if (m_core->imask & (1 << (channel+10)))
 	{
 		m_core->irq_pending |= 1 << (channel+10);
+		signal_interrupt_trigger();
 	}
 
 	dma_op(channel);
@@ -1033,79 +1033,121 @@ void FUNCTION_NAME(tms340x0_device::pixblt)(int src_is_linear, int dst_is_linear
 			uint8_t dstbit = daddr & 15;
 			uint32_t srcword, dstword = 0;
 
-			/* fetch the initial source word */
-			srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
-			readwrites++;
-
-			/* fetch the initial dest word */
-			if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY || (daddr & 0x0f) != 0)
+			/* fast path: when a non-transparent replace op finds source and
+			   dest bit-aligned, whole words can move without per-pixel work */
+			if (!PIXEL_OP_REQUIRES_SOURCE && !TRANSPARENCY && srcbit == dstbit)
 			{
-				dstword = (this->*word_read)(*m_program, dstwordaddr << 4);
-				readwrites++;
-			}
+				int bitcount = dx * BITS_PER_PIXEL;
 
-			/* loop over pixels */
-			for (x = 0; x < dx; x++)
+				/* leading partial word */
+				if (dstbit != 0)
+				{
+					int bits = 16 - dstbit;
+					if (bits > bitcount)
+						bits = bitcount;
+					uint16_t mask = ((1 << bits) - 1) << dstbit;
+					srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
+					dstword = (this->*word_read)(*m_program, dstwordaddr << 4);
+					(this->*word_write)(*m_program, dstwordaddr++ << 4, (dstword & ~mask) | (srcword & mask));
+					readwrites += 3;
+					bitcount -= bits;
+				}
+
+				/* full words straight across */
+				while (bitcount >= 16)
+				{
+					srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
+					(this->*word_write)(*m_program, dstwordaddr++ << 4, srcword);
+					readwrites += 2;
+					bitcount -= 16;
+				}
+
+				/* trailing partial word */
+				if (bitcount > 0)
+				{
+					uint16_t mask = (1 << bitcount) - 1;
+					srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
+					dstword = (this->*word_read)(*m_program, dstwordaddr << 4);
+					(this->*word_write)(*m_program, dstwordaddr++ << 4, (dstword & ~mask) | (srcword & mask));
+					readwrites += 3;
+				}
+			}
+			else
 			{
-				uint32_t dstmask;
-				uint32_t pixel;
+				/* fetch the initial source word */
+				srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
+				readwrites++;
 
-				/* fetch more words if necessary */
-				if (srcbit + BITS_PER_PIXEL > 16)
+				/* fetch the initial dest word */
+				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY || (daddr & 0x0f) != 0)
 				{
-					srcword |= (this->*word_read)(*m_program, srcwordaddr++ << 4) << 16;
+					dstword = (this->*word_read)(*m_program, dstwordaddr << 4);
 					readwrites++;
 				}
 
-				/* extract pixel from source */
-				pixel = (srcword >> srcbit) & PIXEL_MASK;
-				srcbit += BITS_PER_PIXEL;
-				if (srcbit > 16)
+				/* loop over pixels */
+				for (x = 0; x < dx; x++)
 				{
-					srcbit -= 16;
-					srcword >>= 16;
-				}
+					uint32_t dstmask;
+					uint32_t pixel;
 
-				/* fetch additional destination word if necessary */
-				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					if (dstbit + BITS_PER_PIXEL > 16)
+					/* fetch more words if necessary */
+					if (srcbit + BITS_PER_PIXEL > 16)
 					{
-						dstword |= (this->*word_read)(*m_program, (dstwordaddr + 1) << 4) << 16;
+						srcword |= (this->*word_read)(*m_program, srcwordaddr++ << 4) << 16;
 						readwrites++;
 					}
 
-				/* apply pixel operations */
-				pixel <<= dstbit;
-				dstmask = PIXEL_MASK << dstbit;
-				PIXEL_OP(dstword, dstmask, pixel);
-				if (!TRANSPARENCY || pixel != 0)
-					dstword = (dstword & ~dstmask) | pixel;
+					/* extract pixel from source */
+					pixel = (srcword >> srcbit) & PIXEL_MASK;
+					srcbit += BITS_PER_PIXEL;
+					if (srcbit > 16)
+					{
+						srcbit -= 16;
+						srcword >>= 16;
+					}
 
-				/* flush destination words */
-				dstbit += BITS_PER_PIXEL;
-				if (dstbit > 16)
-				{
-					(this->*word_write)(*m_program, dstwordaddr++ << 4, dstword);
-					readwrites++;
-					dstbit -= 16;
-					dstword >>= 16;
+					/* fetch additional destination word if necessary */
+					if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
+						if (dstbit + BITS_PER_PIXEL > 16)
+						{
+							dstword |= (this->*word_read)(*m_program, (dstwordaddr + 1) << 4) << 16;
+							readwrites++;
+						}
+
+					/* apply pixel operations */
+					pixel <<= dstbit;
+					dstmask = PIXEL_MASK << dstbit;
+					PIXEL_OP(dstword, dstmask, pixel);
+					if (!TRANSPARENCY || pixel != 0)
+						dstword = (dstword & ~dstmask) | pixel;
+
+					/* flush destination words */
+					dstbit += BITS_PER_PIXEL;
+					if (dstbit > 16)
+					{
+						(this->*word_write)(*m_program, dstwordaddr++ << 4, dstword);
+						readwrites++;
+						dstbit -= 16;
+						dstword >>= 16;
+					}
 				}
-			}
 
-			/* flush any remaining words */
-			if (dstbit > 0)
-			{
-				/* if we're right-partial, read and mask the remaining bits */
-				if (dstbit != 16)
+				/* flush any remaining words */
+				if (dstbit > 0)
 				{
-					uint16_t origdst = (this->*word_read)(*m_program, dstwordaddr << 4);
-					uint16_t mask = 0xffff << dstbit;
-					dstword = (dstword & ~mask) | (origdst & mask);
+					/* if we're right-partial, read and mask the remaining bits */
+					if (dstbit != 16)
+					{
+						uint16_t origdst = (this->*word_read)(*m_program, dstwordaddr << 4);
+						uint16_t mask = 0xffff << dstbit;
+						dstword = (dstword & ~mask) | (origdst & mask);
+						readwrites++;
+					}
+
+					(this->*word_write)(*m_program, dstwordaddr++ << 4, dstword);
 					readwrites++;
 				}
-
-				(this->*word_write)(*m_program, dstwordaddr++ << 4, dstword);
-				readwrites++;
 			}
 
 
@@ -1899,8 +1941,15 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 				(this->*word_write)(*m_program, dwordaddr++ << 4, dstword);
 			}
 
-			/* loop over full words */
-			for (words = 0; words < full_words; words++)
+			/* loop over full words; a non-transparent replace writes the fill
+			   color unmodified, so skip the per-pixel work for that case */
+			if (!PIXEL_OP_REQUIRES_SOURCE && !TRANSPARENCY)
+			{
+				dstword = COLOR1();
+				for (words = 0; words < full_words; words++)
+					(this->*word_write)(*m_program, dwordaddr++ << 4, dstword);
+			}
+			else for (words = 0; words < full_words; words++)
 			{
 				/* fetch the destination word (if necessary) */
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
@@ -41,9 +41,11 @@ std::unique_ptr<util::disasm_interface> tms57002_device::create_disassembler()
 WRITE_LINE_MEMBER(tms57002_device::pload_w)
 {
 	uint8_t olds = sti;
-	if(state)
+	if(state) {
 		sti &= ~IN_PLOAD;
-	else
+		// the core may have been parked while the load was in progress
+		signal_interrupt_trigger();
+	} else
 		sti |= IN_PLOAD;
 	if(olds ^ sti) {
 		if (sti & IN_PLOAD) {
@@ -202,6 +204,9 @@ void tms57002_device::update_empty()
 
 WRITE_LINE_MEMBER(tms57002_device::sync_w)
 {
+	// wake the core if execute_run parked it waiting for the next sample
+	signal_interrupt_trigger();
+
 	if(sti & (IN_PLOAD /*| IN_CLOAD*/))
 		return;
 
@@ -846,8 +851,12 @@ void tms57002_device::execute_run()
 		}
 	}
 
-	if(icount > 0)
+	if(icount > 0) {
+		// idle or waiting on a program load; the sample program only
+		// restarts at sync, so sleep until sync_w signals the trigger
+		spin_until_interrupt();
 		icount = 0;
+	}
 }
 
 void tms57002_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
@@ -207,6 +207,7 @@ opcode_info const instruction::s_opcode_info_table[OP_MAX] =
 	OPINFO3(FSUB,    "f#sub",    4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY), PINFO(IN, OP, FANY))
 	OPINFO2(FCMP,    "f#cmp",    4|8, false, NONE, UZC,  ALL,  PINFO(IN, OP, FANY), PINFO(IN, OP, FANY))
 	OPINFO3(FMUL,    "f#mul",    4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY), PINFO(IN, OP, FANY))
+	OPINFO4(FMADD,   "f#madd",   4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY), PINFO(IN, OP, FANY), PINFO(IN, OP, FANY))
 	OPINFO3(FDIV,    "f#div",    4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY), PINFO(IN, OP, FANY))
 	OPINFO2(FNEG,    "f#neg",    4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
 	OPINFO2(FABS,    "f#abs",    4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
@@ -737,6 +738,30 @@ void uml::instruction::simplify()
 }
 
 
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int index) const
+{
+	assert(index < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[index].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows_immediate - return true if the
+//  given parameter may be an immediate
+//-------------------------------------------------
+
+bool uml::instruction::param_allows_immediate(int index) const
+{
+	assert(index < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[index].typemask & PTYPES_IMM) != 0;
+}
+
+
 //-------------------------------------------------
 //  validate - verify that the instruction created
 //  meets all requirements
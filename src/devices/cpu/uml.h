@@ -212,6 +212,7 @@ namespace uml
 		OP_FSUB,                    // FSUB    dst,src1,src2
 		OP_FCMP,                    // FCMP    src1,src2
 		OP_FMUL,                    // FMUL    dst,src1,src2
+		OP_FMADD,                   // FMADD   dst,src1,src2,src3
 		OP_FDIV,                    // FDIV    dst,src1,src2
 		OP_FNEG,                    // FNEG    dst,src1
 		OP_FABS,                    // FABS    dst,src1
@@ -413,6 +414,11 @@ namespace uml
 		u8 modified_flags() const;
 		void simplify();
 
+		// parameter introspection for optimization passes
+		bool param_is_output(int index) const;
+		bool param_allows_immediate(int index) const;
+		void substitute_param(int index, parameter const &param) { assert(index < m_numparams); m_param[index] = param; }
+
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
 		void hash(u32 mode, u32 pc) { configure(OP_HASH, 4, mode, pc); }
@@ -538,6 +544,7 @@ namespace uml
 		void fssub(parameter dst, parameter src1, parameter src2) { configure(OP_FSUB, 4, dst, src1, src2); }
 		void fscmp(parameter src1, parameter src2) { configure(OP_FCMP, 4, src1, src2); }
 		void fsmul(parameter dst, parameter src1, parameter src2) { configure(OP_FMUL, 4, dst, src1, src2); }
+		void fsmadd(parameter dst, parameter src1, parameter src2, parameter src3) { configure(OP_FMADD, 4, dst, src1, src2, src3); }
 		void fsdiv(parameter dst, parameter src1, parameter src2) { configure(OP_FDIV, 4, dst, src1, src2); }
 		void fsneg(parameter dst, parameter src1) { configure(OP_FNEG, 4, dst, src1); }
 		void fsabs(parameter dst, parameter src1) { configure(OP_FABS, 4, dst, src1); }
@@ -562,6 +569,7 @@ namespace uml
 		void fdsub(parameter dst, parameter src1, parameter src2) { configure(OP_FSUB, 8, dst, src1, src2); }
 		void fdcmp(parameter src1, parameter src2) { configure(OP_FCMP, 8, src1, src2); }
 		void fdmul(parameter dst, parameter src1, parameter src2) { configure(OP_FMUL, 8, dst, src1, src2); }
+		void fdmadd(parameter dst, parameter src1, parameter src2, parameter src3) { configure(OP_FMADD, 8, dst, src1, src2, src3); }
 		void fddiv(parameter dst, parameter src1, parameter src2) { configure(OP_FDIV, 8, dst, src1, src2); }
 		void fdneg(parameter dst, parameter src1) { configure(OP_FNEG, 8, dst, src1); }
 		void fdabs(parameter dst, parameter src1) { configure(OP_FABS, 8, dst, src1); }
@@ -3190,6 +3190,77 @@ inline void emit_cvttpd2dq_r128_m128(x86code *&emitptr, uint8_t dreg, x86_memref
 inline void emit_roundpd_r128_r128_imm(x86code *&emitptr, uint8_t dreg, uint8_t sreg, uint8_t imm)        { emit_op_modrm_reg(emitptr, OP_ROUNDPD_Vdq_Wdq_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
 inline void emit_roundpd_r128_m128_imm(x86code *&emitptr, uint8_t dreg, x86_memref memref, uint8_t imm) { emit_op_modrm_mem(emitptr, OP_ROUNDPD_Vdq_Wdq_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
 
+
+
+//**************************************************************************
+//  FMA3 EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_vex_0f38_modrm_reg - emit a VEX-encoded
+//  opcode from the 0F38 map with a register
+//  modrm byte and a second source register in
+//  the VEX.vvvv field
+//-------------------------------------------------
+
+inline void emit_vex_0f38_modrm_reg(x86code *&emitptr, uint8_t op, uint8_t pp, uint8_t w, uint8_t vreg, uint8_t reg, uint8_t rm)
+{
+	assert(reg < REG_MAX);
+	assert(vreg < REG_MAX);
+	assert(rm < REG_MAX);
+
+	emit_byte(emitptr, 0xc4);
+	emit_byte(emitptr, 0x02 | (((reg & 8) ^ 8) << 4) | 0x40 | (((rm & 8) ^ 8) << 2));
+	emit_byte(emitptr, (w << 7) | ((~vreg & 15) << 3) | pp);
+	emit_byte(emitptr, op);
+	emit_byte(emitptr, make_modrm(3, reg, rm));
+}
+
+
+//-------------------------------------------------
+//  emit_vex_0f38_modrm_mem - emit a VEX-encoded
+//  opcode from the 0F38 map with a base+disp
+//  memory operand; indexed forms are not needed
+//  by any caller so far
+//-------------------------------------------------
+
+inline void emit_vex_0f38_modrm_mem(x86code *&emitptr, uint8_t op, uint8_t pp, uint8_t w, uint8_t vreg, uint8_t reg, x86_memref memref)
+{
+	assert(reg < REG_MAX);
+	assert(vreg < REG_MAX);
+	assert(memref.m_index == REG_NONE);
+	assert(memref.m_base != REG_NONE && (memref.m_base & 7) != REG_ESP);
+
+	emit_byte(emitptr, 0xc4);
+	emit_byte(emitptr, 0x02 | (((reg & 8) ^ 8) << 4) | 0x40 | (((memref.m_base & 8) ^ 8) << 2));
+	emit_byte(emitptr, (w << 7) | ((~vreg & 15) << 3) | pp);
+	emit_byte(emitptr, op);
+
+	// mode 0 for no offset
+	if (memref.m_disp == 0 && (memref.m_base & 7) != REG_EBP)
+		emit_byte(emitptr, make_modrm(0, reg, memref.m_base));
+
+	// mode 1 for 1-byte offset
+	else if ((int8_t)memref.m_disp == memref.m_disp)
+	{
+		emit_byte(emitptr, make_modrm(1, reg, memref.m_base));
+		emit_byte(emitptr, (int8_t)memref.m_disp);
+	}
+
+	// mode 2 for 4-byte offset
+	else
+	{
+		emit_byte(emitptr, make_modrm(2, reg, memref.m_base));
+		emit_dword(emitptr, memref.m_disp);
+	}
+}
+
+// dreg = vreg * dreg + src3
+inline void emit_vfmadd213ss_r128_r128_r128(x86code *&emitptr, uint8_t dreg, uint8_t vreg, uint8_t sreg) { emit_vex_0f38_modrm_reg(emitptr, 0xa9, 1, 0, vreg, dreg, sreg); }
+inline void emit_vfmadd213ss_r128_r128_m32(x86code *&emitptr, uint8_t dreg, uint8_t vreg, x86_memref memref) { emit_vex_0f38_modrm_mem(emitptr, 0xa9, 1, 0, vreg, dreg, memref); }
+inline void emit_vfmadd213sd_r128_r128_r128(x86code *&emitptr, uint8_t dreg, uint8_t vreg, uint8_t sreg) { emit_vex_0f38_modrm_reg(emitptr, 0xa9, 1, 1, vreg, dreg, sreg); }
+inline void emit_vfmadd213sd_r128_r128_m64(x86code *&emitptr, uint8_t dreg, uint8_t vreg, x86_memref memref) { emit_vex_0f38_modrm_mem(emitptr, 0xa9, 1, 1, vreg, dreg, memref); }
+
 }
 
 #undef X86EMIT_SIZE
@@ -322,6 +322,119 @@ static const uint8_t cc_ex[0x100] = {
  ***************************************************************/
 #define CC(prefix,opcode) do { m_icount -= m_cc_##prefix[opcode]; } while (0)
 
+#if defined(Z80_THREADED_DISPATCH) && defined(__GNUC__)
+
+/* computed-goto dispatch: every EXEC expansion carries its own jump table
+   and per-opcode dispatch target, so each decode level presents the branch
+   predictor with a distinct indirect jump and the compiler can lay the
+   inlined handler bodies out contiguously; relies on a GNU extension, so
+   the portable switch dispatch below remains the default */
+#define EXEC(prefix,opcode) do { \
+	static const void *const s_dispatch[0x100] = { \
+		&&x_00, &&x_01, &&x_02, &&x_03, &&x_04, &&x_05, &&x_06, &&x_07, \
+		&&x_08, &&x_09, &&x_0a, &&x_0b, &&x_0c, &&x_0d, &&x_0e, &&x_0f, \
+		&&x_10, &&x_11, &&x_12, &&x_13, &&x_14, &&x_15, &&x_16, &&x_17, \
+		&&x_18, &&x_19, &&x_1a, &&x_1b, &&x_1c, &&x_1d, &&x_1e, &&x_1f, \
+		&&x_20, &&x_21, &&x_22, &&x_23, &&x_24, &&x_25, &&x_26, &&x_27, \
+		&&x_28, &&x_29, &&x_2a, &&x_2b, &&x_2c, &&x_2d, &&x_2e, &&x_2f, \
+		&&x_30, &&x_31, &&x_32, &&x_33, &&x_34, &&x_35, &&x_36, &&x_37, \
+		&&x_38, &&x_39, &&x_3a, &&x_3b, &&x_3c, &&x_3d, &&x_3e, &&x_3f, \
+		&&x_40, &&x_41, &&x_42, &&x_43, &&x_44, &&x_45, &&x_46, &&x_47, \
+		&&x_48, &&x_49, &&x_4a, &&x_4b, &&x_4c, &&x_4d, &&x_4e, &&x_4f, \
+		&&x_50, &&x_51, &&x_52, &&x_53, &&x_54, &&x_55, &&x_56, &&x_57, \
+		&&x_58, &&x_59, &&x_5a, &&x_5b, &&x_5c, &&x_5d, &&x_5e, &&x_5f, \
+		&&x_60, &&x_61, &&x_62, &&x_63, &&x_64, &&x_65, &&x_66, &&x_67, \
+		&&x_68, &&x_69, &&x_6a, &&x_6b, &&x_6c, &&x_6d, &&x_6e, &&x_6f, \
+		&&x_70, &&x_71, &&x_72, &&x_73, &&x_74, &&x_75, &&x_76, &&x_77, \
+		&&x_78, &&x_79, &&x_7a, &&x_7b, &&x_7c, &&x_7d, &&x_7e, &&x_7f, \
+		&&x_80, &&x_81, &&x_82, &&x_83, &&x_84, &&x_85, &&x_86, &&x_87, \
+		&&x_88, &&x_89, &&x_8a, &&x_8b, &&x_8c, &&x_8d, &&x_8e, &&x_8f, \
+		&&x_90, &&x_91, &&x_92, &&x_93, &&x_94, &&x_95, &&x_96, &&x_97, \
+		&&x_98, &&x_99, &&x_9a, &&x_9b, &&x_9c, &&x_9d, &&x_9e, &&x_9f, \
+		&&x_a0, &&x_a1, &&x_a2, &&x_a3, &&x_a4, &&x_a5, &&x_a6, &&x_a7, \
+		&&x_a8, &&x_a9, &&x_aa, &&x_ab, &&x_ac, &&x_ad, &&x_ae, &&x_af, \
+		&&x_b0, &&x_b1, &&x_b2, &&x_b3, &&x_b4, &&x_b5, &&x_b6, &&x_b7, \
+		&&x_b8, &&x_b9, &&x_ba, &&x_bb, &&x_bc, &&x_bd, &&x_be, &&x_bf, \
+		&&x_c0, &&x_c1, &&x_c2, &&x_c3, &&x_c4, &&x_c5, &&x_c6, &&x_c7, \
+		&&x_c8, &&x_c9, &&x_ca, &&x_cb, &&x_cc, &&x_cd, &&x_ce, &&x_cf, \
+		&&x_d0, &&x_d1, &&x_d2, &&x_d3, &&x_d4, &&x_d5, &&x_d6, &&x_d7, \
+		&&x_d8, &&x_d9, &&x_da, &&x_db, &&x_dc, &&x_dd, &&x_de, &&x_df, \
+		&&x_e0, &&x_e1, &&x_e2, &&x_e3, &&x_e4, &&x_e5, &&x_e6, &&x_e7, \
+		&&x_e8, &&x_e9, &&x_ea, &&x_eb, &&x_ec, &&x_ed, &&x_ee, &&x_ef, \
+		&&x_f0, &&x_f1, &&x_f2, &&x_f3, &&x_f4, &&x_f5, &&x_f6, &&x_f7, \
+		&&x_f8, &&x_f9, &&x_fa, &&x_fb, &&x_fc, &&x_fd, &&x_fe, &&x_ff, \
+	}; \
+	unsigned op = opcode; \
+	CC(prefix,op); \
+	goto *s_dispatch[op]; \
+	x_00: prefix##_##00(); break; x_01: prefix##_##01(); break; x_02: prefix##_##02(); break; x_03: prefix##_##03(); break; \
+	x_04: prefix##_##04(); break; x_05: prefix##_##05(); break; x_06: prefix##_##06(); break; x_07: prefix##_##07(); break; \
+	x_08: prefix##_##08(); break; x_09: prefix##_##09(); break; x_0a: prefix##_##0a(); break; x_0b: prefix##_##0b(); break; \
+	x_0c: prefix##_##0c(); break; x_0d: prefix##_##0d(); break; x_0e: prefix##_##0e(); break; x_0f: prefix##_##0f(); break; \
+	x_10: prefix##_##10(); break; x_11: prefix##_##11(); break; x_12: prefix##_##12(); break; x_13: prefix##_##13(); break; \
+	x_14: prefix##_##14(); break; x_15: prefix##_##15(); break; x_16: prefix##_##16(); break; x_17: prefix##_##17(); break; \
+	x_18: prefix##_##18(); break; x_19: prefix##_##19(); break; x_1a: prefix##_##1a(); break; x_1b: prefix##_##1b(); break; \
+	x_1c: prefix##_##1c(); break; x_1d: prefix##_##1d(); break; x_1e: prefix##_##1e(); break; x_1f: prefix##_##1f(); break; \
+	x_20: prefix##_##20(); break; x_21: prefix##_##21(); break; x_22: prefix##_##22(); break; x_23: prefix##_##23(); break; \
+	x_24: prefix##_##24(); break; x_25: prefix##_##25(); break; x_26: prefix##_##26(); break; x_27: prefix##_##27(); break; \
+	x_28: prefix##_##28(); break; x_29: prefix##_##29(); break; x_2a: prefix##_##2a(); break; x_2b: prefix##_##2b(); break; \
+	x_2c: prefix##_##2c(); break; x_2d: prefix##_##2d(); break; x_2e: prefix##_##2e(); break; x_2f: prefix##_##2f(); break; \
+	x_30: prefix##_##30(); break; x_31: prefix##_##31(); break; x_32: prefix##_##32(); break; x_33: prefix##_##33(); break; \
+	x_34: prefix##_##34(); break; x_35: prefix##_##35(); break; x_36: prefix##_##36(); break; x_37: prefix##_##37(); break; \
+	x_38: prefix##_##38(); break; x_39: prefix##_##39(); break; x_3a: prefix##_##3a(); break; x_3b: prefix##_##3b(); break; \
+	x_3c: prefix##_##3c(); break; x_3d: prefix##_##3d(); break; x_3e: prefix##_##3e(); break; x_3f: prefix##_##3f(); break; \
+	x_40: prefix##_##40(); break; x_41: prefix##_##41(); break; x_42: prefix##_##42(); break; x_43: prefix##_##43(); break; \
+	x_44: prefix##_##44(); break; x_45: prefix##_##45(); break; x_46: prefix##_##46(); break; x_47: prefix##_##47(); break; \
+	x_48: prefix##_##48(); break; x_49: prefix##_##49(); break; x_4a: prefix##_##4a(); break; x_4b: prefix##_##4b(); break; \
+	x_4c: prefix##_##4c(); break; x_4d: prefix##_##4d(); break; x_4e: prefix##_##4e(); break; x_4f: prefix##_##4f(); break; \
+	x_50: prefix##_##50(); break; x_51: prefix##_##51(); break; x_52: prefix##_##52(); break; x_53: prefix##_##53(); break; \
+	x_54: prefix##_##54(); break; x_55: prefix##_##55(); break; x_56: prefix##_##56(); break; x_57: prefix##_##57(); break; \
+	x_58: prefix##_##58(); break; x_59: prefix##_##59(); break; x_5a: prefix##_##5a(); break; x_5b: prefix##_##5b(); break; \
+	x_5c: prefix##_##5c(); break; x_5d: prefix##_##5d(); break; x_5e: prefix##_##5e(); break; x_5f: prefix##_##5f(); break; \
+	x_60: prefix##_##60(); break; x_61: prefix##_##61(); break; x_62: prefix##_##62(); break; x_63: prefix##_##63(); break; \
+	x_64: prefix##_##64(); break; x_65: prefix##_##65(); break; x_66: prefix##_##66(); break; x_67: prefix##_##67(); break; \
+	x_68: prefix##_##68(); break; x_69: prefix##_##69(); break; x_6a: prefix##_##6a(); break; x_6b: prefix##_##6b(); break; \
+	x_6c: prefix##_##6c(); break; x_6d: prefix##_##6d(); break; x_6e: prefix##_##6e(); break; x_6f: prefix##_##6f(); break; \
+	x_70: prefix##_##70(); break; x_71: prefix##_##71(); break; x_72: prefix##_##72(); break; x_73: prefix##_##73(); break; \
+	x_74: prefix##_##74(); break; x_75: prefix##_##75(); break; x_76: prefix##_##76(); break; x_77: prefix##_##77(); break; \
+	x_78: prefix##_##78(); break; x_79: prefix##_##79(); break; x_7a: prefix##_##7a(); break; x_7b: prefix##_##7b(); break; \
+	x_7c: prefix##_##7c(); break; x_7d: prefix##_##7d(); break; x_7e: prefix##_##7e(); break; x_7f: prefix##_##7f(); break; \
+	x_80: prefix##_##80(); break; x_81: prefix##_##81(); break; x_82: prefix##_##82(); break; x_83: prefix##_##83(); break; \
+	x_84: prefix##_##84(); break; x_85: prefix##_##85(); break; x_86: prefix##_##86(); break; x_87: prefix##_##87(); break; \
+	x_88: prefix##_##88(); break; x_89: prefix##_##89(); break; x_8a: prefix##_##8a(); break; x_8b: prefix##_##8b(); break; \
+	x_8c: prefix##_##8c(); break; x_8d: prefix##_##8d(); break; x_8e: prefix##_##8e(); break; x_8f: prefix##_##8f(); break; \
+	x_90: prefix##_##90(); break; x_91: prefix##_##91(); break; x_92: prefix##_##92(); break; x_93: prefix##_##93(); break; \
+	x_94: prefix##_##94(); break; x_95: prefix##_##95(); break; x_96: prefix##_##96(); break; x_97: prefix##_##97(); break; \
+	x_98: prefix##_##98(); break; x_99: prefix##_##99(); break; x_9a: prefix##_##9a(); break; x_9b: prefix##_##9b(); break; \
+	x_9c: prefix##_##9c(); break; x_9d: prefix##_##9d(); break; x_9e: prefix##_##9e(); break; x_9f: prefix##_##9f(); break; \
+	x_a0: prefix##_##a0(); break; x_a1: prefix##_##a1(); break; x_a2: prefix##_##a2(); break; x_a3: prefix##_##a3(); break; \
+	x_a4: prefix##_##a4(); break; x_a5: prefix##_##a5(); break; x_a6: prefix##_##a6(); break; x_a7: prefix##_##a7(); break; \
+	x_a8: prefix##_##a8(); break; x_a9: prefix##_##a9(); break; x_aa: prefix##_##aa(); break; x_ab: prefix##_##ab(); break; \
+	x_ac: prefix##_##ac(); break; x_ad: prefix##_##ad(); break; x_ae: prefix##_##ae(); break; x_af: prefix##_##af(); break; \
+	x_b0: prefix##_##b0(); break; x_b1: prefix##_##b1(); break; x_b2: prefix##_##b2(); break; x_b3: prefix##_##b3(); break; \
+	x_b4: prefix##_##b4(); break; x_b5: prefix##_##b5(); break; x_b6: prefix##_##b6(); break; x_b7: prefix##_##b7(); break; \
+	x_b8: prefix##_##b8(); break; x_b9: prefix##_##b9(); break; x_ba: prefix##_##ba(); break; x_bb: prefix##_##bb(); break; \
+	x_bc: prefix##_##bc(); break; x_bd: prefix##_##bd(); break; x_be: prefix##_##be(); break; x_bf: prefix##_##bf(); break; \
+	x_c0: prefix##_##c0(); break; x_c1: prefix##_##c1(); break; x_c2: prefix##_##c2(); break; x_c3: prefix##_##c3(); break; \
+	x_c4: prefix##_##c4(); break; x_c5: prefix##_##c5(); break; x_c6: prefix##_##c6(); break; x_c7: prefix##_##c7(); break; \
+	x_c8: prefix##_##c8(); break; x_c9: prefix##_##c9(); break; x_ca: prefix##_##ca(); break; x_cb: prefix##_##cb(); break; \
+	x_cc: prefix##_##cc(); break; x_cd: prefix##_##cd(); break; x_ce: prefix##_##ce(); break; x_cf: prefix##_##cf(); break; \
+	x_d0: prefix##_##d0(); break; x_d1: prefix##_##d1(); break; x_d2: prefix##_##d2(); break; x_d3: prefix##_##d3(); break; \
+	x_d4: prefix##_##d4(); break; x_d5: prefix##_##d5(); break; x_d6: prefix##_##d6(); break; x_d7: prefix##_##d7(); break; \
+	x_d8: prefix##_##d8(); break; x_d9: prefix##_##d9(); break; x_da: prefix##_##da(); break; x_db: prefix##_##db(); break; \
+	x_dc: prefix##_##dc(); break; x_dd: prefix##_##dd(); break; x_de: prefix##_##de(); break; x_df: prefix##_##df(); break; \
+	x_e0: prefix##_##e0(); break; x_e1: prefix##_##e1(); break; x_e2: prefix##_##e2(); break; x_e3: prefix##_##e3(); break; \
+	x_e4: prefix##_##e4(); break; x_e5: prefix##_##e5(); break; x_e6: prefix##_##e6(); break; x_e7: prefix##_##e7(); break; \
+	x_e8: prefix##_##e8(); break; x_e9: prefix##_##e9(); break; x_ea: prefix##_##ea(); break; x_eb: prefix##_##eb(); break; \
+	x_ec: prefix##_##ec(); break; x_ed: prefix##_##ed(); break; x_ee: prefix##_##ee(); break; x_ef: prefix##_##ef(); break; \
+	x_f0: prefix##_##f0(); break; x_f1: prefix##_##f1(); break; x_f2: prefix##_##f2(); break; x_f3: prefix##_##f3(); break; \
+	x_f4: prefix##_##f4(); break; x_f5: prefix##_##f5(); break; x_f6: prefix##_##f6(); break; x_f7: prefix##_##f7(); break; \
+	x_f8: prefix##_##f8(); break; x_f9: prefix##_##f9(); break; x_fa: prefix##_##fa(); break; x_fb: prefix##_##fb(); break; \
+	x_fc: prefix##_##fc(); break; x_fd: prefix##_##fd(); break; x_fe: prefix##_##fe(); break; x_ff: prefix##_##ff(); break; \
+} while (0)
+
+#else
+
 #define EXEC(prefix,opcode) do { \
 	unsigned op = opcode; \
 	CC(prefix,op); \
@@ -394,6 +507,8 @@ static const uint8_t cc_ex[0x100] = {
 	} \
 } while (0)
 
+#endif
+
 /***************************************************************
  * Enter halt state; write 1 to callback on first execution
  ***************************************************************/
@@ -15,7 +15,15 @@ address_map_bank_device::address_map_bank_device( const machine_config &mconfig,
 		m_stride(1),
 		m_program(nullptr),
 		m_offset(0),
-		m_shift(0)
+		m_shift(0),
+		m_cache8le(nullptr),
+		m_cache8be(nullptr),
+		m_cache16le(nullptr),
+		m_cache16be(nullptr),
+		m_cache32le(nullptr),
+		m_cache32be(nullptr),
+		m_cache64le(nullptr),
+		m_cache64be(nullptr)
 {
 }
 
@@ -48,42 +56,66 @@ void address_map_bank_device::amap64(address_map &map)
 
 WRITE8_MEMBER(address_map_bank_device::write8)
 {
-	m_program->write_byte(m_offset + offset, data);
+	const offs_t addr = m_offset + offset;
+	if (m_cache8le) m_cache8le->write_byte(addr, data);
+	else if (m_cache8be) m_cache8be->write_byte(addr, data);
+	else m_program->write_byte(addr, data);
 }
 
 WRITE16_MEMBER(address_map_bank_device::write16)
 {
-	m_program->write_word(m_offset + (offset << (m_shift+1)), data, mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+1));
+	if (m_cache16le) m_cache16le->write_word(addr, data, mem_mask);
+	else if (m_cache16be) m_cache16be->write_word(addr, data, mem_mask);
+	else m_program->write_word(addr, data, mem_mask);
 }
 
 WRITE32_MEMBER(address_map_bank_device::write32)
 {
-	m_program->write_dword(m_offset + (offset << (m_shift+2)), data, mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+2));
+	if (m_cache32le) m_cache32le->write_dword(addr, data, mem_mask);
+	else if (m_cache32be) m_cache32be->write_dword(addr, data, mem_mask);
+	else m_program->write_dword(addr, data, mem_mask);
 }
 
 WRITE64_MEMBER(address_map_bank_device::write64)
 {
-	m_program->write_qword(m_offset + (offset << (m_shift+3)), data, mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+3));
+	if (m_cache64le) m_cache64le->write_qword(addr, data, mem_mask);
+	else if (m_cache64be) m_cache64be->write_qword(addr, data, mem_mask);
+	else m_program->write_qword(addr, data, mem_mask);
 }
 
 READ8_MEMBER(address_map_bank_device::read8)
 {
-	return m_program->read_byte(m_offset + offset);
+	const offs_t addr = m_offset + offset;
+	if (m_cache8le) return m_cache8le->read_byte(addr);
+	if (m_cache8be) return m_cache8be->read_byte(addr);
+	return m_program->read_byte(addr);
 }
 
 READ16_MEMBER(address_map_bank_device::read16)
 {
-	return m_program->read_word(m_offset + (offset << (m_shift+1)), mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+1));
+	if (m_cache16le) return m_cache16le->read_word(addr, mem_mask);
+	if (m_cache16be) return m_cache16be->read_word(addr, mem_mask);
+	return m_program->read_word(addr, mem_mask);
 }
 
 READ32_MEMBER(address_map_bank_device::read32)
 {
-	return m_program->read_dword(m_offset + (offset << (m_shift+2)), mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+2));
+	if (m_cache32le) return m_cache32le->read_dword(addr, mem_mask);
+	if (m_cache32be) return m_cache32be->read_dword(addr, mem_mask);
+	return m_program->read_dword(addr, mem_mask);
 }
 
 READ64_MEMBER(address_map_bank_device::read64)
 {
-	return m_program->read_qword(m_offset + (offset << (m_shift+3)), mem_mask);
+	const offs_t addr = m_offset + (offset << (m_shift+3));
+	if (m_cache64le) return m_cache64le->read_qword(addr, mem_mask);
+	if (m_cache64be) return m_cache64be->read_qword(addr, mem_mask);
+	return m_program->read_qword(addr, mem_mask);
 }
 
 void address_map_bank_device::device_config_complete()
@@ -95,6 +127,32 @@ void address_map_bank_device::device_start()
 {
 	m_program = &space(AS_PROGRAM);
 
+	// for the common zero-shift configurations, grab a cache handle so
+	// steady-state accesses skip the banked space's full dispatch
+	if (m_shift == 0)
+	{
+		bool le = m_program->endianness() == ENDIANNESS_LITTLE;
+		switch (m_data_width)
+		{
+			case 8:
+				if (le) m_cache8le = m_program->cache<0, 0, ENDIANNESS_LITTLE>();
+				else m_cache8be = m_program->cache<0, 0, ENDIANNESS_BIG>();
+				break;
+			case 16:
+				if (le) m_cache16le = m_program->cache<1, 0, ENDIANNESS_LITTLE>();
+				else m_cache16be = m_program->cache<1, 0, ENDIANNESS_BIG>();
+				break;
+			case 32:
+				if (le) m_cache32le = m_program->cache<2, 0, ENDIANNESS_LITTLE>();
+				else m_cache32be = m_program->cache<2, 0, ENDIANNESS_BIG>();
+				break;
+			case 64:
+				if (le) m_cache64le = m_program->cache<3, 0, ENDIANNESS_LITTLE>();
+				else m_cache64be = m_program->cache<3, 0, ENDIANNESS_BIG>();
+				break;
+		}
+	}
+
 	save_item(NAME(m_offset));
 }
 
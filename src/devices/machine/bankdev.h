@@ -71,6 +71,20 @@ private:
 	address_space *m_program;
 	offs_t m_offset;
 	int m_shift;
+
+	// cache handles onto the banked space for the common zero-shift
+	// configurations; going through one collapses the inner space's full
+	// dispatch to a range check in the steady state, and the cache's
+	// change notifier keeps it coherent across remappings.  only the
+	// handle matching the configured width and endianness is non-null
+	memory_access_cache<0, 0, ENDIANNESS_LITTLE> *m_cache8le;
+	memory_access_cache<0, 0, ENDIANNESS_BIG> *m_cache8be;
+	memory_access_cache<1, 0, ENDIANNESS_LITTLE> *m_cache16le;
+	memory_access_cache<1, 0, ENDIANNESS_BIG> *m_cache16be;
+	memory_access_cache<2, 0, ENDIANNESS_LITTLE> *m_cache32le;
+	memory_access_cache<2, 0, ENDIANNESS_BIG> *m_cache32be;
+	memory_access_cache<3, 0, ENDIANNESS_LITTLE> *m_cache64le;
+	memory_access_cache<3, 0, ENDIANNESS_BIG> *m_cache64be;
 };
 
 
@@ -61,6 +61,10 @@ void watchdog_timer_device::device_start()
 	m_counter = 0;
 	m_timer = timer_alloc();
 
+	// the timeout only needs to be approximate, so let the scheduler
+	// coalesce it with other millisecond-scale timers
+	m_timer->set_tolerance(attotime::from_msec(1));
+
 	if (m_vblank_count != 0)
 	{
 		// fetch the screen
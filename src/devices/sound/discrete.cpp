@@ -95,13 +95,14 @@ struct output_buffer
 {
 	double                      *node_buf;
 	const double                *source;
-	volatile double             *ptr;
+	volatile double             *ptr;               /* published write position, read by consuming tasks */
+	double                      *ptr_w;             /* private write cursor, published once per block */
 	int                         node_num;
 };
 
 struct input_buffer
 {
-	volatile const double       *ptr;               /* pointer into linked_outbuf.nodebuf */
+	const double                *ptr;               /* pointer into linked_outbuf.nodebuf, only touched by the owning task */
 	output_buffer *             linked_outbuf;      /* what output are we connected to ? */
 	double                      buffer;             /* input[] will point here */
 };
@@ -112,7 +113,7 @@ class discrete_task
 public:
 	virtual ~discrete_task(void) { }
 
-	inline void step_nodes(void);
+	inline void step_nodes(int samples);
 	inline bool lock_threadid(int32_t threadid)
 	{
 		int expected = -1;
@@ -181,39 +182,49 @@ private:
  *
  *************************************/
 
-inline void discrete_task::step_nodes(void)
+inline void discrete_task::step_nodes(int samples)
 {
-	for_each(input_buffer *, sn, &source_list)
+	/* run the whole block through the private cursors; the volatile output
+	 * positions are published once at the end, so consuming tasks see data
+	 * in block-sized chunks and the loop pays no volatile traffic per sample */
+	while (samples-- > 0)
 	{
-		sn->buffer = *sn->ptr++;
-	}
-
-	if (EXPECTED(!m_device.profiling()))
-	{
-		for_each(discrete_step_interface **, entry, &step_list)
+		for_each(input_buffer *, sn, &source_list)
 		{
-			/* Now step the node */
-			(*entry)->step();
+			sn->buffer = *sn->ptr++;
 		}
-	}
-	else
-	{
-		osd_ticks_t last = get_profile_ticks();
 
-		for_each(discrete_step_interface **, entry, &step_list)
+		if (EXPECTED(!m_device.profiling()))
+		{
+			for_each(discrete_step_interface **, entry, &step_list)
+			{
+				/* Now step the node */
+				(*entry)->step();
+			}
+		}
+		else
 		{
-			discrete_step_interface *node = *entry;
+			osd_ticks_t last = get_profile_ticks();
 
-			node->run_time -= last;
-			node->step();
-			last = get_profile_ticks();
-			node->run_time += last;
+			for_each(discrete_step_interface **, entry, &step_list)
+			{
+				discrete_step_interface *node = *entry;
+
+				node->run_time -= last;
+				node->step();
+				last = get_profile_ticks();
+				node->run_time += last;
+			}
 		}
+
+		/* buffer the outputs */
+		for_each(output_buffer *, outbuf, &m_buffers)
+			*(outbuf->ptr_w++) = *outbuf->source;
 	}
 
-	/* buffer the outputs */
+	/* publish the new write positions */
 	for_each(output_buffer *, outbuf, &m_buffers)
-		*(outbuf->ptr++) = *outbuf->source;
+		outbuf->ptr = outbuf->ptr_w;
 }
 
 void *discrete_task::task_callback(void *param, int threadid)
@@ -253,12 +264,8 @@ bool discrete_task::process(void)
 
 	m_samples -= samples;
 	assert_always(m_samples >=0, "task_callback: task_samples got negative");
-	while (samples > 0)
-	{
-		/* step */
-		step_nodes();
-		samples--;
-	}
+	if (samples > 0)
+		step_nodes(samples);
 	if (m_samples == 0)
 	{
 		/* return and keep the task locked so it is not picked up by other worker threads */
@@ -272,7 +279,10 @@ void discrete_task::prepare_for_queue(int samples)
 	m_samples = samples;
 	/* set up task buffers */
 	for_each(output_buffer *, ob, &m_buffers)
+	{
 		ob->ptr = ob->node_buf;
+		ob->ptr_w = ob->node_buf;
+	}
 
 	/* initialize sources */
 	for_each(input_buffer *, sn, &source_list)
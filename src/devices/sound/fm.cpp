@@ -1357,6 +1357,31 @@ static inline void update_phase_lfo_channel(FM_OPN *OPN, FM_CH *CH)
 	}
 }
 
+/* advance a channel's phase generators without rendering; used for channels
+   whose rendering is skipped */
+static inline void chan_phase_adv(FM_OPN *OPN, FM_CH *CH, int chnum)
+{
+	if(CH->pms)
+	{
+		/* add support for 3 slot mode */
+		if ((OPN->ST.mode & 0xC0) && (chnum == 2))
+		{
+				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT1], CH->pms, OPN->SL3.block_fnum[1]);
+				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT2], CH->pms, OPN->SL3.block_fnum[2]);
+				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT3], CH->pms, OPN->SL3.block_fnum[0]);
+				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT4], CH->pms, CH->block_fnum);
+		}
+		else update_phase_lfo_channel(OPN, CH);
+	}
+	else    /* no LFO phase modulation */
+	{
+		CH->SLOT[SLOT1].phase += CH->SLOT[SLOT1].Incr;
+		CH->SLOT[SLOT2].phase += CH->SLOT[SLOT2].Incr;
+		CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
+		CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
+	}
+}
+
 static inline void chan_calc(FM_OPN *OPN, FM_CH *CH, int chnum)
 {
 	unsigned int eg_out;
@@ -1411,25 +1436,30 @@ static inline void chan_calc(FM_OPN *OPN, FM_CH *CH, int chnum)
 	CH->mem_value = OPN->mem;
 
 	/* update phase counters AFTER output calculations */
-	if(CH->pms)
-	{
-		/* add support for 3 slot mode */
-		if ((OPN->ST.mode & 0xC0) && (chnum == 2))
-		{
-				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT1], CH->pms, OPN->SL3.block_fnum[1]);
-				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT2], CH->pms, OPN->SL3.block_fnum[2]);
-				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT3], CH->pms, OPN->SL3.block_fnum[0]);
-				update_phase_lfo_slot(OPN, &CH->SLOT[SLOT4], CH->pms, CH->block_fnum);
-		}
-		else update_phase_lfo_channel(OPN, CH);
-	}
-	else    /* no LFO phase modulation */
-	{
-		CH->SLOT[SLOT1].phase += CH->SLOT[SLOT1].Incr;
-		CH->SLOT[SLOT2].phase += CH->SLOT[SLOT2].Incr;
-		CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
-		CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
-	}
+	chan_phase_adv(OPN, CH, chnum);
+}
+
+/* a channel whose four slots all sit in the OFF state at full attenuation,
+   with no feedback or delayed-sample residue left, contributes nothing
+   through chan_calc: every envelope fails the ENV_QUIET test, so no op_calc
+   call is made and out_fm stays zero.  The phase generators still have to
+   advance, but the rendering half can be skipped exactly.  The test runs
+   per call, so a CSM key-on is picked up on the very next sample. */
+static inline int chan_silent(const FM_CH *CH)
+{
+	return CH->SLOT[SLOT1].state == EG_OFF && CH->SLOT[SLOT1].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT2].state == EG_OFF && CH->SLOT[SLOT2].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT3].state == EG_OFF && CH->SLOT[SLOT3].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT4].state == EG_OFF && CH->SLOT[SLOT4].vol_out >= ENV_QUIET &&
+			CH->op1_out[0] == 0 && CH->op1_out[1] == 0 && CH->mem_value == 0;
+}
+
+static inline void chan_calc_or_skip(FM_OPN *OPN, FM_CH *CH, int chnum)
+{
+	if (chan_silent(CH))
+		chan_phase_adv(OPN, CH, chnum);
+	else
+		chan_calc(OPN, CH, chnum);
 }
 
 /* update phase increment and envelope generator */
@@ -2167,9 +2197,9 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
+		chan_calc_or_skip(OPN, cch[0], 0 );
+		chan_calc_or_skip(OPN, cch[1], 1 );
+		chan_calc_or_skip(OPN, cch[2], 2 );
 
 		/* buffering */
 		{
@@ -2805,12 +2835,12 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 		out_fm[5] = 0;
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		chan_calc_or_skip(OPN, cch[0], 0 );
+		chan_calc_or_skip(OPN, cch[1], 1 );
+		chan_calc_or_skip(OPN, cch[2], 2 );
+		chan_calc_or_skip(OPN, cch[3], 3 );
+		chan_calc_or_skip(OPN, cch[4], 4 );
+		chan_calc_or_skip(OPN, cch[5], 5 );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3368,10 +3398,10 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 1 ); /*remapped to 1*/
-		chan_calc(OPN, cch[1], 2 ); /*remapped to 2*/
-		chan_calc(OPN, cch[2], 4 ); /*remapped to 4*/
-		chan_calc(OPN, cch[3], 5 ); /*remapped to 5*/
+		chan_calc_or_skip(OPN, cch[0], 1 ); /*remapped to 1*/
+		chan_calc_or_skip(OPN, cch[1], 2 ); /*remapped to 2*/
+		chan_calc_or_skip(OPN, cch[2], 4 ); /*remapped to 4*/
+		chan_calc_or_skip(OPN, cch[3], 5 ); /*remapped to 5*/
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3502,12 +3532,12 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		chan_calc_or_skip(OPN, cch[0], 0 );
+		chan_calc_or_skip(OPN, cch[1], 1 );
+		chan_calc_or_skip(OPN, cch[2], 2 );
+		chan_calc_or_skip(OPN, cch[3], 3 );
+		chan_calc_or_skip(OPN, cch[4], 4 );
+		chan_calc_or_skip(OPN, cch[5], 5 );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
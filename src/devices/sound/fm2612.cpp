@@ -1600,6 +1600,45 @@ static inline signed int op_calc1(uint32_t phase, unsigned int env, signed int p
 	return tl_tab[p];
 }
 
+/* advance a channel's phase generators without rendering; used for channels
+   whose rendering is skipped for a whole block */
+static inline void chan_phase_adv(ym2612_state *F2612, fm2612_FM_OPN *OPN, fm2612_FM_CH *CH)
+{
+	if(CH->pms)
+	{
+	/* add support for 3 slot mode */
+	if ((OPN->ST.mode & 0xC0) && (CH == &F2612->CH[2]))
+	{
+		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT1], CH->pms, OPN->SL3.block_fnum[1]);
+		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT2], CH->pms, OPN->SL3.block_fnum[2]);
+		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT3], CH->pms, OPN->SL3.block_fnum[0]);
+		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT4], CH->pms, CH->block_fnum);
+	}
+	else update_phase_lfo_channel(OPN, CH);
+	}
+	else  /* no LFO phase modulation */
+	{
+	CH->SLOT[SLOT1].phase += CH->SLOT[SLOT1].Incr;
+	CH->SLOT[SLOT2].phase += CH->SLOT[SLOT2].Incr;
+	CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
+	CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
+	}
+}
+
+/* a channel whose four slots all sit in the OFF state at full attenuation,
+   with no feedback or delayed-sample residue left, contributes nothing
+   through chan_calc: every envelope fails the ENV_QUIET test, so no op_calc
+   call is made and out_fm stays zero.  The phase generators still have to
+   advance, but the rendering half can be skipped exactly. */
+static inline int chan_silent(const fm2612_FM_CH *CH)
+{
+	return CH->SLOT[SLOT1].state == EG_OFF && CH->SLOT[SLOT1].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT2].state == EG_OFF && CH->SLOT[SLOT2].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT3].state == EG_OFF && CH->SLOT[SLOT3].vol_out >= ENV_QUIET &&
+			CH->SLOT[SLOT4].state == EG_OFF && CH->SLOT[SLOT4].vol_out >= ENV_QUIET &&
+			CH->op1_out[0] == 0 && CH->op1_out[1] == 0 && CH->mem_value == 0;
+}
+
 static inline void chan_calc(ym2612_state *F2612, fm2612_FM_OPN *OPN, fm2612_FM_CH *CH)
 {
 	uint32_t AM = OPN->LFO_AM >> CH->ams;
@@ -1652,25 +1691,7 @@ static inline void chan_calc(ym2612_state *F2612, fm2612_FM_OPN *OPN, fm2612_FM_
 	CH->mem_value = OPN->mem;
 
 	/* update phase counters AFTER output calculations */
-	if(CH->pms)
-	{
-	/* add support for 3 slot mode */
-	if ((OPN->ST.mode & 0xC0) && (CH == &F2612->CH[2]))
-	{
-		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT1], CH->pms, OPN->SL3.block_fnum[1]);
-		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT2], CH->pms, OPN->SL3.block_fnum[2]);
-		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT3], CH->pms, OPN->SL3.block_fnum[0]);
-		update_phase_lfo_slot(OPN, &CH->SLOT[SLOT4], CH->pms, CH->block_fnum);
-	}
-	else update_phase_lfo_channel(OPN, CH);
-	}
-	else  /* no LFO phase modulation */
-	{
-	CH->SLOT[SLOT1].phase += CH->SLOT[SLOT1].Incr;
-	CH->SLOT[SLOT2].phase += CH->SLOT[SLOT2].Incr;
-	CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
-	CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
-	}
+	chan_phase_adv(F2612, OPN, CH);
 }
 
 static void FMCloseTable( void )
@@ -2218,9 +2239,25 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[4] );
 	refresh_fc_eg_chan( OPN, cch[5] );
 
-	/* buffering */
-	for(i=0; i < length ; i++)
+	/* buffering; done in blocks so the silent-channel test below runs once
+	   per block instead of once per sample.  A channel silent at the start
+	   of a block stays silent throughout: it can only come back through a
+	   register write (which syncs the stream first) or through CSM key-on,
+	   for which channel 2 is kept conservatively active. */
+	for(i=0; i < length ; )
 	{
+		int blockend = i + ((length - i > 64) ? 64 : (length - i));
+		unsigned int active = 0;
+		int c;
+
+		for (c = 0; c < 6; c++)
+			if (!chan_silent(cch[c]))
+				active |= 1 << c;
+		if ((OPN->ST.mode & 0x80) || OPN->SL3.key_csm)
+			active |= 1 << 2;
+
+		for(; i < blockend ; i++)
+		{
 		/* clear outputs */
 		out_fm[0] = 0;
 		out_fm[1] = 0;
@@ -2237,16 +2274,20 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 		update_ssg_eg_channel(&cch[4]->SLOT[SLOT1]);
 		update_ssg_eg_channel(&cch[5]->SLOT[SLOT1]);
 
-		/* calculate FM */
-		chan_calc(F2612, OPN, cch[0]);
-		chan_calc(F2612, OPN, cch[1]);
-		chan_calc(F2612, OPN, cch[2]);
-		chan_calc(F2612, OPN, cch[3]);
-		chan_calc(F2612, OPN, cch[4]);
+		/* calculate FM, advancing phase only on skipped channels */
+		for (c = 0; c < 5; c++)
+		{
+			if (active & (1 << c))
+				chan_calc(F2612, OPN, cch[c]);
+			else
+				chan_phase_adv(F2612, OPN, cch[c]);
+		}
 		if( F2612->dacen )
 			*cch[5]->connect4 += F2612->dacout;
-		else
+		else if (active & (1 << 5))
 			chan_calc(F2612, OPN, cch[5]);
+		else
+			chan_phase_adv(F2612, OPN, cch[5]);
 
 		/* advance LFO */
 		advance_lfo(OPN);
@@ -2318,6 +2359,7 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 		FM_KEYOFF_CSM(cch[2],SLOT3);
 		FM_KEYOFF_CSM(cch[2],SLOT4);
 		OPN->SL3.key_csm = 0;
+		}
 	}
 
 	/* timer B control */
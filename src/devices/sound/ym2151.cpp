@@ -1793,6 +1793,30 @@ WRITE_LINE_MEMBER(ym2151_device::reset_w)
 }
 
 
+/*  Channels whose four operators are all in the OFF state with no feedback
+*   or delayed-sample residue left cannot contribute to the output: every
+*   envelope in chan_calc sits at maximum attenuation, so no op_calc call is
+*   made and chanout stays zero (this covers the channel 7 noise output too,
+*   whose level is derived from C2's envelope).  Phase and envelope stepping
+*   live in advance() and advance_eg(), so skipping chan_calc for such
+*   channels is exact, not an approximation.
+*/
+unsigned int ym2151_device::active_channels() const
+{
+	unsigned int mask = 0;
+
+	for (unsigned int ch=0; ch<8; ch++)
+	{
+		const YM2151Operator *op = &oper[ch*4];
+		if ((op[0].state | op[1].state | op[2].state | op[3].state) != 0 ||
+			op[0].fb_out_prev != 0 || op[0].fb_out_curr != 0 || op[0].mem_value != 0)
+			mask |= 1 << ch;
+	}
+
+	return mask;
+}
+
+
 //-------------------------------------------------
 //  sound_stream_update - handle a stream update
 //-------------------------------------------------
@@ -1805,36 +1829,51 @@ void ym2151_device::sound_stream_update(sound_stream &stream, stream_sample_t **
 		return;
 	}
 
-	for (int i=0; i<samples; i++)
+	/* generate in blocks; a channel that is silent at the start of a block
+	*  stays silent for its whole duration, since it can only come alive
+	*  through a register write (which syncs the stream first) or through
+	*  CSM (which forces the conservative all-active mask below), so the
+	*  skip test runs once per block instead of once per sample */
+	for (int sampbase = 0; sampbase < samples; )
 	{
-		advance_eg();
+		int block = std::min(samples - sampbase, 64);
+		unsigned int active = csm_req ? 0xff : active_channels();
 
-		for(int ch=0; ch<8; ch++)
-			chanout[ch] = 0;
-
-		for(int ch=0; ch<7; ch++)
-			chan_calc(ch);
-		chan7_calc();
+		for (int i=sampbase; i<sampbase+block; i++)
+		{
+			advance_eg();
+
+			for(int ch=0; ch<8; ch++)
+				chanout[ch] = 0;
+
+			for(int ch=0; ch<7; ch++)
+				if (active & (1 << ch))
+					chan_calc(ch);
+			if (active & 0x80)
+				chan7_calc();
+
+			int outl = 0;
+			int outr = 0;
+			for(int ch=0; ch<8; ch++) {
+				outl += chanout[ch] & pan[2*ch];
+				outr += chanout[ch] & pan[2*ch+1];
+			}
 
-		int outl = 0;
-		int outr = 0;
-		for(int ch=0; ch<8; ch++) {
-			outl += chanout[ch] & pan[2*ch];
-			outr += chanout[ch] & pan[2*ch+1];
+			if (outl > 32767)
+				outl = 32767;
+			else if (outl < -32768)
+				outl = -32768;
+			if (outr > 32767)
+				outr = 32767;
+			else if (outr < -32768)
+				outr = -32768;
+			outputs[0][i] = outl;
+			outputs[1][i] = outr;
+
+			advance();
 		}
 
-		if (outl > 32767)
-			outl = 32767;
-		else if (outl < -32768)
-			outl = -32768;
-		if (outr > 32767)
-			outr = 32767;
-		else if (outr < -32768)
-			outr = -32768;
-		outputs[0][i] = outl;
-		outputs[1][i] = outr;
-
-		advance();
+		sampbase += block;
 	}
 }
 
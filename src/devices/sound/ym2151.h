@@ -270,6 +270,7 @@ private:
 	void write_reg(int r, int v);
 	void chan_calc(unsigned int chan);
 	void chan7_calc();
+	unsigned int active_channels() const;
 	int op_calc(YM2151Operator * OP, unsigned int env, signed int pm);
 	int op_calc1(YM2151Operator * OP, unsigned int env, signed int pm);
 	void refresh_EG(YM2151Operator * op);
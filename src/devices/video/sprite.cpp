@@ -155,3 +155,87 @@ sparse_dirty_rect *sparse_dirty_bitmap::first_dirty_rect(const rectangle &clipre
 	m_rect_list_bounds = cliprect;
 	return m_rect_list.first();
 }
+
+
+//-------------------------------------------------
+//  sprite_batch -- constructor
+//-------------------------------------------------
+
+sprite_batch::sprite_batch()
+{
+	// avoid reallocation for typical sprite counts
+	m_entries.reserve(256);
+	m_order.reserve(256);
+}
+
+
+//-------------------------------------------------
+//  add -- enqueue a single sprite
+//-------------------------------------------------
+
+void sprite_batch::add(gfx_element &gfx, uint32_t code, uint32_t color, int flipx, int flipy, int32_t destx, int32_t desty, uint32_t trans_pen, uint32_t priority)
+{
+	sprite_entry entry;
+	entry.gfx = &gfx;
+	entry.code = code;
+	entry.color = color;
+	entry.flipx = flipx;
+	entry.flipy = flipy;
+	entry.destx = destx;
+	entry.desty = desty;
+	entry.trans_pen = trans_pen;
+	entry.priority = priority;
+	m_entries.push_back(entry);
+}
+
+
+//-------------------------------------------------
+//  draw_common -- sort and draw the queued
+//  sprites, then empty the queue
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void sprite_batch::draw_common(_BitmapClass &dest, const rectangle &cliprect)
+{
+	// sort indices rather than the entries themselves to keep the sort cheap;
+	// priority is the primary key so layering is preserved, gfx element is
+	// secondary so consecutive blits share decoded data, and the sort is
+	// stable so sprites at the same priority keep their submission order
+	m_order.resize(m_entries.size());
+	for (uint32_t index = 0; index < m_order.size(); index++)
+		m_order[index] = index;
+	std::stable_sort(m_order.begin(), m_order.end(),
+		[this] (uint32_t a, uint32_t b)
+		{
+			const sprite_entry &entrya = m_entries[a];
+			const sprite_entry &entryb = m_entries[b];
+			if (entrya.priority != entryb.priority)
+				return entrya.priority < entryb.priority;
+			return entrya.gfx < entryb.gfx;
+		});
+
+	// blit in sorted order
+	for (uint32_t index : m_order)
+	{
+		const sprite_entry &entry = m_entries[index];
+		entry.gfx->transpen(dest, cliprect, entry.code, entry.color, entry.flipx, entry.flipy, entry.destx, entry.desty, entry.trans_pen);
+	}
+
+	// ready for the next frame
+	m_entries.clear();
+}
+
+
+//-------------------------------------------------
+//  draw -- bitmap-specific front ends
+//-------------------------------------------------
+
+void sprite_batch::draw(bitmap_ind16 &dest, const rectangle &cliprect)
+{
+	draw_common(dest, cliprect);
+}
+
+void sprite_batch::draw(bitmap_rgb32 &dest, const rectangle &cliprect)
+{
+	draw_common(dest, cliprect);
+}
@@ -176,6 +176,15 @@ bits(7:4) and bit(24)), X, and Y:
 // otherwise timer interrupts won't match nodrc debug mode.
 #define EAT_CYCLES          (1)
 
+// the quad rasterizer uses SSE2 intrinsics directly; mirror the conditions
+// rgbutil.h uses to select the SSE implementation of rgbaint_t
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define VOODOO_QUAD_RASTER  (1)
+#include <emmintrin.h>
+#else
+#define VOODOO_QUAD_RASTER  (0)
+#endif
+
 
 struct voodoo_device::poly_extra_data
 {
@@ -370,15 +379,47 @@ int voodoo_device::voodoo_update(bitmap_rgb32 &bitmap, const rectangle &cliprect
 	if (machine().input().code_pressed(KEYCODE_L))
 		drawbuf = fbi.backbuf;
 
-	/* copy from the current front buffer */
-	for (y = cliprect.min_y; y <= cliprect.max_y; y++)
-		if (y >= fbi.yoffs)
+	/* bump the contents generation on any change */
+	if (changed)
+		fbi.blit_gen++;
+
+	/* the screen alternates between a small set of bitmaps, so remember which
+	   contents generation each one holds; if the destination already has the
+	   current front buffer we can skip the pen conversion entirely */
+	void *const dstbase = bitmap.raw_pixptr(0);
+	fbi_state::blit_memo *memo = nullptr;
+	for (auto &candidate : fbi.blitmemo)
+		if (candidate.dest == dstbase)
+			memo = &candidate;
+	bool const uptodate = (memo != nullptr) && (drawbuf == fbi.frontbuf)
+			&& (memo->gen == fbi.blit_gen) && (memo->clip == cliprect)
+			&& (memo->offs == fbi.rgboffs[drawbuf])
+			&& (memo->xoffs == fbi.xoffs) && (memo->yoffs == fbi.yoffs);
+	if (!uptodate)
+	{
+		/* copy from the current front buffer */
+		for (y = cliprect.min_y; y <= cliprect.max_y; y++)
+			if (y >= fbi.yoffs)
+			{
+				uint16_t *src = (uint16_t *)(fbi.ram + fbi.rgboffs[drawbuf]) + (y - fbi.yoffs) * fbi.rowpixels - fbi.xoffs;
+				uint32_t *dst = &bitmap.pix32(y);
+				for (x = cliprect.min_x; x <= cliprect.max_x; x++)
+					dst[x] = fbi.pen[src[x]];
+			}
+
+		/* remember what the bitmap now holds, replacing the older entry */
+		if (memo == nullptr)
 		{
-			uint16_t *src = (uint16_t *)(fbi.ram + fbi.rgboffs[drawbuf]) + (y - fbi.yoffs) * fbi.rowpixels - fbi.xoffs;
-			uint32_t *dst = &bitmap.pix32(y);
-			for (x = cliprect.min_x; x <= cliprect.max_x; x++)
-				dst[x] = fbi.pen[src[x]];
+			memo = &fbi.blitmemo[fbi.blitmemo_next];
+			fbi.blitmemo_next ^= 1;
+			memo->dest = dstbase;
 		}
+		memo->gen = (drawbuf == fbi.frontbuf) ? fbi.blit_gen : 0;
+		memo->clip = cliprect;
+		memo->offs = fbi.rgboffs[drawbuf];
+		memo->xoffs = fbi.xoffs;
+		memo->yoffs = fbi.yoffs;
+	}
 
 	/* update stats display */
 	statskey = (machine().input().code_pressed(KEYCODE_BACKSLASH) != 0);
@@ -394,6 +435,8 @@ int voodoo_device::voodoo_update(bitmap_rgb32 &bitmap, const rectangle &cliprect
 	stats.render_override = machine().input().code_pressed(KEYCODE_ENTER);
 	if (DEBUG_DEPTH && stats.render_override)
 	{
+		if (memo != nullptr)
+			memo->gen = 0;
 		for (y = cliprect.min_y; y <= cliprect.max_y; y++)
 		{
 			uint16_t *src = (uint16_t *)(fbi.ram + fbi.auxoffs) + (y - fbi.yoffs) * fbi.rowpixels - fbi.xoffs;
@@ -459,6 +502,15 @@ void voodoo_device::init_fbi(voodoo_device* vd,fbi_state *f, void *memory, int f
 
 	/* init the pens */
 	f->clut_dirty = true;
+
+	/* invalidate the blit memoization */
+	for (auto &memo : f->blitmemo)
+	{
+		memo.dest = nullptr;
+		memo.gen = 0;
+	}
+	f->blitmemo_next = 0;
+	f->blit_gen = 1;
 	if (vd->vd_type <= TYPE_VOODOO_2)
 	{
 		for (pen = 0; pen < 32; pen++)
@@ -592,6 +644,7 @@ void voodoo_device::tmu_state::init(uint8_t vdt, tmu_shared_state &share, voodoo
 void voodoo_device::voodoo_postload()
 {
 	fbi.clut_dirty = true;
+	fbi.blit_gen++;
 	for (int index = 0; index < ARRAY_LENGTH(tmu); index++)
 	{
 		tmu[index].regdirty = true;
@@ -5817,8 +5870,12 @@ voodoo_device::raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, in
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* generate a new one using the generic entry, preferring the 4-wide */
+	/* renderer for the untextured pass-through color path */
+	if (texcount == 0 && raster_quad_eligible(curinfo.eff_color_path, curinfo.eff_fbz_mode, curinfo.eff_alpha_mode, curinfo.eff_fog_mode))
+		curinfo.callback = raster_iterargb_quad;
+	else
+		curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
 	curinfo.is_generic = true;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -6034,3 +6091,236 @@ RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg
 
 RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
 			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+
+/*-------------------------------------------------
+    raster_quad_eligible - determine whether the
+    current (normalized) mode words reduce the
+    pixel pipeline to "clamped iterated ARGB plus
+    depth test", which the 4-wide rasterizer can
+    handle
+-------------------------------------------------*/
+
+bool voodoo_device::raster_quad_eligible(uint32_t fbzcp, uint32_t fbzmode, uint32_t alphamode, uint32_t fogmode)
+{
+#if VOODOO_QUAD_RASTER
+	/* color combine must pass the iterated color through untouched: both */
+	/* RGB and alpha select the iterated values, nothing is zeroed or */
+	/* subtracted, the blend factor is zero (which becomes a multiply by */
+	/* 256 after the reverse and +1 adjustments), nothing is added, and */
+	/* the output is not inverted */
+	if (FBZCP_CC_RGBSELECT(fbzcp) != 0 || FBZCP_CC_ASELECT(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_ZERO_OTHER(fbzcp) != 0 || FBZCP_CCA_ZERO_OTHER(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_SUB_CLOCAL(fbzcp) != 0 || FBZCP_CCA_SUB_CLOCAL(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_MSELECT(fbzcp) != 0 || FBZCP_CCA_MSELECT(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_REVERSE_BLEND(fbzcp) != 0 || FBZCP_CCA_REVERSE_BLEND(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_ADD_ACLOCAL(fbzcp) != 0 || FBZCP_CCA_ADD_ACLOCAL(fbzcp) != 0)
+		return false;
+	if (FBZCP_CC_INVERT_OUTPUT(fbzcp) != 0 || FBZCP_CCA_INVERT_OUTPUT(fbzcp) != 0)
+		return false;
+
+	/* require the simple clamp behavior so the vector clamp matches */
+	if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+		return false;
+
+	/* no per-pixel tests or depth adjustments we do not replicate; depth */
+	/* must come from iterated Z so that depthval = clamp(iterz >> 12) */
+	if (FBZMODE_ENABLE_CHROMAKEY(fbzmode) || FBZMODE_ENABLE_STIPPLE(fbzmode) || FBZMODE_ENABLE_ALPHA_MASK(fbzmode))
+		return false;
+	if (FBZMODE_WBUFFER_SELECT(fbzmode) || FBZMODE_ENABLE_DEPTH_BIAS(fbzmode) || FBZMODE_DEPTH_SOURCE_COMPARE(fbzmode))
+		return false;
+	if (FBZMODE_ENABLE_ALPHA_PLANES(fbzmode))
+		return false;
+
+	/* alpha test/blend and fog stay on the scalar path */
+	if (ALPHAMODE_ALPHATEST(alphamode) || ALPHAMODE_ALPHABLEND(alphamode))
+		return false;
+	if (FOGMODE_ENABLE_FOG(fogmode))
+		return false;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+#if VOODOO_QUAD_RASTER
+
+/*-------------------------------------------------
+    quad_clamp - clamp four signed 32-bit lanes
+    to the range [0, maxval]
+-------------------------------------------------*/
+
+static inline __m128i quad_clamp(__m128i val, __m128i maxval)
+{
+	__m128i over;
+
+	/* negative lanes clamp to zero */
+	val = _mm_andnot_si128(_mm_srai_epi32(val, 31), val);
+
+	/* lanes above the maximum clamp to it */
+	over = _mm_cmpgt_epi32(val, maxval);
+	return _mm_or_si128(_mm_and_si128(over, maxval), _mm_andnot_si128(over, val));
+}
+
+#endif
+
+
+/*-------------------------------------------------
+    raster_iterargb_quad - rasterizer for the
+    pure iterated-color path, processing four
+    pixels per iteration
+-------------------------------------------------*/
+
+void voodoo_device::raster_iterargb_quad(void *destbase, int32_t y, const poly_extent *extent, const void *extradata, int threadid)
+{
+#if VOODOO_QUAD_RASTER
+	const poly_extra_data *extra = (const poly_extra_data *)extradata;
+	voodoo_device *vd = extra->device;
+	stats_block *stats = &vd->thread_stats[threadid];
+	uint32_t fbzmode = vd->reg[fbzMode].u;
+	DECLARE_DITHER_POINTERS_NO_DITHER_VAR;
+	int32_t startx = extent->startx;
+	int32_t stopx = extent->stopx;
+	uint16_t *depth;
+	uint16_t *dest;
+	int32_t dx, dy;
+	int32_t scry;
+	int32_t x;
+
+	/* determine the screen Y */
+	scry = y;
+	if (FBZMODE_Y_ORIGIN(fbzmode))
+		scry = (vd->fbi.yorigin - y);
+
+	/* compute dithering */
+	COMPUTE_DITHER_POINTERS_NO_DITHER_VAR(fbzmode, y);
+
+	/* apply clipping */
+	if (FBZMODE_ENABLE_CLIPPING(fbzmode))
+	{
+		int32_t tempclip;
+
+		/* Y clipping buys us the whole scanline */
+		if (scry < ((vd->reg[clipLowYHighY].u >> 16) & 0x3ff) ||
+			scry >= (vd->reg[clipLowYHighY].u & 0x3ff))
+		{
+			stats->pixels_in += stopx - startx;
+			stats->clip_fail += stopx - startx;
+			return;
+		}
+
+		/* X clipping */
+		tempclip = vd->reg[clipLeftRight].u & 0x3ff;
+		/* Check for start outsize of clipping boundary */
+		if (startx >= tempclip)
+		{
+			stats->pixels_in += stopx - startx;
+			vd->stats.total_clipped += stopx - startx;
+			return;
+		}
+		if (stopx > tempclip)
+		{
+			stats->pixels_in += stopx - tempclip;
+			vd->stats.total_clipped += stopx - tempclip;
+			stopx = tempclip;
+		}
+		tempclip = (vd->reg[clipLeftRight].u >> 16) & 0x3ff;
+		if (startx < tempclip)
+		{
+			stats->pixels_in += tempclip - startx;
+			vd->stats.total_clipped += tempclip - startx;
+			startx = tempclip;
+		}
+	}
+
+	/* get pointers to the target buffer and depth buffer */
+	dest = (uint16_t *)destbase + scry * vd->fbi.rowpixels;
+	depth = (vd->fbi.auxoffs != ~0) ? ((uint16_t *)(vd->fbi.ram + vd->fbi.auxoffs) + scry * vd->fbi.rowpixels) : nullptr;
+
+	/* compute the starting parameters */
+	dx = startx - (extra->ax >> 4);
+	dy = y - (extra->ay >> 4);
+	int32_t iterr = extra->startr + dy * extra->drdy + dx * extra->drdx;
+	int32_t iterg = extra->startg + dy * extra->dgdy + dx * extra->dgdx;
+	int32_t iterb = extra->startb + dy * extra->dbdy + dx * extra->dbdx;
+	int32_t iterz = extra->startz + dy * extra->dzdy + dx * extra->dzdx;
+	extra->info->hits++;
+
+	/* lane i of each vector iterates the value for pixel x+i */
+	__m128i iterr4 = _mm_setr_epi32(iterr, iterr + extra->drdx, iterr + 2 * extra->drdx, iterr + 3 * extra->drdx);
+	__m128i iterg4 = _mm_setr_epi32(iterg, iterg + extra->dgdx, iterg + 2 * extra->dgdx, iterg + 3 * extra->dgdx);
+	__m128i iterb4 = _mm_setr_epi32(iterb, iterb + extra->dbdx, iterb + 2 * extra->dbdx, iterb + 3 * extra->dbdx);
+	__m128i iterz4 = _mm_setr_epi32(iterz, iterz + extra->dzdx, iterz + 2 * extra->dzdx, iterz + 3 * extra->dzdx);
+	__m128i drdx4 = _mm_set1_epi32(4 * extra->drdx);
+	__m128i dgdx4 = _mm_set1_epi32(4 * extra->dgdx);
+	__m128i dbdx4 = _mm_set1_epi32(4 * extra->dbdx);
+	__m128i dzdx4 = _mm_set1_epi32(4 * extra->dzdx);
+	__m128i max255 = _mm_set1_epi32(0xff);
+	__m128i max16 = _mm_set1_epi32(0xffff);
+
+	/* loop in X, four pixels at a time */
+	for (x = startx; x < stopx; x += 4)
+	{
+		int32_t rq[4], gq[4], bq[4], dq[4];
+		int count = stopx - x;
+		int pix;
+
+		if (count > 4)
+			count = 4;
+
+		/* shift down and clamp all four lanes at once; this is the */
+		/* RGBZW_CLAMP == 1 case of CLAMPED_ARGB and CLAMPED_Z */
+		_mm_storeu_si128((__m128i *)rq, quad_clamp(_mm_srai_epi32(iterr4, 12), max255));
+		_mm_storeu_si128((__m128i *)gq, quad_clamp(_mm_srai_epi32(iterg4, 12), max255));
+		_mm_storeu_si128((__m128i *)bq, quad_clamp(_mm_srai_epi32(iterb4, 12), max255));
+		_mm_storeu_si128((__m128i *)dq, quad_clamp(_mm_srai_epi32(iterz4, 12), max16));
+
+		/* depth test, dithering and the framebuffer write stay scalar */
+		for (pix = 0; pix < count; pix++)
+		{
+			int32_t xx = x + pix;
+			int32_t r = rq[pix];
+			int32_t g = gq[pix];
+			int32_t b = bq[pix];
+
+			stats->pixels_in++;
+
+			/* depth testing */
+			if (FBZMODE_ENABLE_DEPTHBUF(fbzmode))
+				if (!depthTest((uint16_t)vd->reg[zaColor].u, stats, depth[xx], fbzmode, dq[pix]))
+					continue;
+
+			/* write to framebuffer */
+			if (FBZMODE_RGB_BUFFER_MASK(fbzmode))
+			{
+				/* apply dithering */
+				APPLY_DITHER(fbzmode, xx, dither_lookup, r, g, b);
+				dest[xx] = (r << 11) | (g << 5) | b;
+			}
+
+			/* write to aux buffer */
+			if (FBZMODE_AUX_BUFFER_MASK(fbzmode))
+				depth[xx] = dq[pix];
+
+			/* track pixel writes to the frame buffer regardless of mask */
+			stats->pixels_out++;
+		}
+
+		/* advance all lanes by four pixels */
+		iterr4 = _mm_add_epi32(iterr4, drdx4);
+		iterg4 = _mm_add_epi32(iterg4, dgdx4);
+		iterb4 = _mm_add_epi32(iterb4, dbdx4);
+		iterz4 = _mm_add_epi32(iterz4, dzdx4);
+	}
+#else
+	/* without SSE2 this renderer is never selected; fall back just in case */
+	raster_generic_0tmu(destbase, y, extent, extradata, threadid);
+#endif
+}
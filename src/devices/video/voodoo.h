@@ -1750,6 +1750,20 @@ protected:
 		rgb_t               clut[512];              // clut gamma data */
 		uint8_t             clut_dirty;             // do we need to recompute? */
 		rgb_t               rgb565[65536];          // RGB 5-6-5 lookup table */
+
+		/* memoization of the front-buffer pen conversion in voodoo_update();
+		   host-side only, not part of the saved state */
+		struct blit_memo
+		{
+			void *          dest;                   // destination bitmap storage
+			uint32_t        gen;                    // contents generation held (0 = invalid)
+			rectangle       clip;                   // cliprect of that conversion
+			uint32_t        offs;                   // front buffer offset converted
+			uint32_t        xoffs, yoffs;           // porch offsets at conversion time
+		};
+		blit_memo           blitmemo[2];            // one per screen bitmap
+		uint8_t             blitmemo_next;          // replacement index
+		uint32_t            blit_gen;               // current front-buffer contents generation
 	};
 
 
@@ -1861,6 +1875,8 @@ protected:
 	static void raster_generic_0tmu(void *dest, int32_t scanline, const poly_extent *extent, const void *extradata, int threadid);
 	static void raster_generic_1tmu(void *dest, int32_t scanline, const poly_extent *extent, const void *extradata, int threadid);
 	static void raster_generic_2tmu(void *dest, int32_t scanline, const poly_extent *extent, const void *extradata, int threadid);
+	static bool raster_quad_eligible(uint32_t fbzcp, uint32_t fbzmode, uint32_t alphamode, uint32_t fogmode);
+	static void raster_iterargb_quad(void *dest, int32_t scanline, const poly_extent *extent, const void *extradata, int threadid);
 
 #define RASTERIZER_HEADER(name) \
 	static void raster_##name(void *destbase, int32_t y, const poly_extent *extent, const void *extradata, int threadid);
@@ -139,8 +139,14 @@ public:
 	static constexpr attotime from_nsec(s64 nsec) { return attotime(nsec / 1000000000, (nsec % 1000000000) * (ATTOSECONDS_PER_SECOND / 1000000000)); }
 	/** Create an attotime from at the given frequency @frequency */
 	static attotime from_hz(double frequency) { assert(frequency > 0); double d = 1 / frequency; return attotime(floor(d), modf(d, &d) * ATTOSECONDS_PER_SECOND); }
-	static attotime from_hz(u32 frequency) { return from_hz(double(frequency)); }
-	static attotime from_hz(int frequency) { return from_hz(double(frequency)); }
+	/** Integral frequencies are exact and fold at compile time */
+	static constexpr attotime from_hz(u32 frequency)
+	{
+		return (frequency > 1) ? attotime(0, HZ_TO_ATTOSECONDS(frequency)) :
+				(frequency == 1) ? attotime(1, 0) :
+				attotime(ATTOTIME_MAX_SECONDS, 0);
+	}
+	static constexpr attotime from_hz(int frequency) { return from_hz(u32((frequency > 0) ? frequency : 0)); }
 	static attotime from_hz(const XTAL &xtal) { return from_hz(xtal.dvalue()); }
 
 	s64 to_msec() const { return attoseconds_t(m_seconds)*1000 + (m_attoseconds/ (ATTOSECONDS_PER_SECOND / 1000)); }
@@ -166,95 +172,52 @@ public:
 //  INLINE FUNCTIONS
 //**************************************************************************
 
-/** handle addition between two attotimes */
-inline attotime operator+(const attotime &left, const attotime &right)
+/** handle addition between two attotimes; branch-free so the scheduler's
+    inner loops compile down to straight-line adds and conditional moves */
+inline constexpr attotime operator+(const attotime &left, const attotime &right)
 {
-	attotime result;
-
-	// if one of the items is never, return never
-	if (left.m_seconds >= ATTOTIME_MAX_SECONDS || right.m_seconds >= ATTOTIME_MAX_SECONDS)
-		return attotime::never;
-
 	// add the seconds and attoseconds
-	result.m_attoseconds = left.m_attoseconds + right.m_attoseconds;
-	result.m_seconds = left.m_seconds + right.m_seconds;
-
-	// normalize and return
-	if (result.m_attoseconds >= ATTOSECONDS_PER_SECOND)
-	{
-		result.m_attoseconds -= ATTOSECONDS_PER_SECOND;
-		result.m_seconds++;
-	}
-
-	// overflow
-	if (result.m_seconds >= ATTOTIME_MAX_SECONDS)
-		return attotime::never;
-	return result;
+	attoseconds_t attos = left.m_attoseconds + right.m_attoseconds;
+	seconds_t secs = left.m_seconds + right.m_seconds;
+
+	// normalize; the carry mask is all-ones exactly when we rolled past one second
+	const attoseconds_t carry = attoseconds_t(attos >= ATTOSECONDS_PER_SECOND);
+	attos -= ATTOSECONDS_PER_SECOND & -carry;
+	secs += seconds_t(carry);
+
+	// saturate to never on overflow or if either input was never
+	return (left.m_seconds >= ATTOTIME_MAX_SECONDS || right.m_seconds >= ATTOTIME_MAX_SECONDS || secs >= ATTOTIME_MAX_SECONDS)
+			? attotime(ATTOTIME_MAX_SECONDS, 0)
+			: attotime(secs, attos);
 }
 
 inline attotime &attotime::operator+=(const attotime &right)
 {
-	// if one of the items is never, return never
-	if (this->m_seconds >= ATTOTIME_MAX_SECONDS || right.m_seconds >= ATTOTIME_MAX_SECONDS)
-		return *this = never;
-
-	// add the seconds and attoseconds
-	m_attoseconds += right.m_attoseconds;
-	m_seconds += right.m_seconds;
-
-	// normalize and return
-	if (this->m_attoseconds >= ATTOSECONDS_PER_SECOND)
-	{
-		this->m_attoseconds -= ATTOSECONDS_PER_SECOND;
-		this->m_seconds++;
-	}
-
-	// overflow
-	if (this->m_seconds >= ATTOTIME_MAX_SECONDS)
-		return *this = never;
-	return *this;
+	return *this = *this + right;
 }
 
 
 /** handle subtraction between two attotimes */
-inline attotime operator-(const attotime &left, const attotime &right)
+inline constexpr attotime operator-(const attotime &left, const attotime &right)
 {
-	attotime result;
-
-	// if time1 is never, return never
-	if (left.m_seconds >= ATTOTIME_MAX_SECONDS)
-		return attotime::never;
-
-	// add the seconds and attoseconds
-	result.m_attoseconds = left.m_attoseconds - right.m_attoseconds;
-	result.m_seconds = left.m_seconds - right.m_seconds;
-
-	// normalize and return
-	if (result.m_attoseconds < 0)
-	{
-		result.m_attoseconds += ATTOSECONDS_PER_SECOND;
-		result.m_seconds--;
-	}
-	return result;
+	// subtract the seconds and attoseconds
+	attoseconds_t attos = left.m_attoseconds - right.m_attoseconds;
+	seconds_t secs = left.m_seconds - right.m_seconds;
+
+	// normalize; the borrow mask is all-ones exactly when we went below zero
+	const attoseconds_t borrow = attoseconds_t(attos < 0);
+	attos += ATTOSECONDS_PER_SECOND & -borrow;
+	secs -= seconds_t(borrow);
+
+	// never stays never
+	return (left.m_seconds >= ATTOTIME_MAX_SECONDS)
+			? attotime(ATTOTIME_MAX_SECONDS, 0)
+			: attotime(secs, attos);
 }
 
 inline attotime &attotime::operator-=(const attotime &right)
 {
-	// if time1 is never, return never
-	if (this->m_seconds >= ATTOTIME_MAX_SECONDS)
-		return *this = never;
-
-	// add the seconds and attoseconds
-	m_attoseconds -= right.m_attoseconds;
-	m_seconds -= right.m_seconds;
-
-	// normalize and return
-	if (this->m_attoseconds < 0)
-	{
-		this->m_attoseconds += ATTOSECONDS_PER_SECOND;
-		this->m_seconds--;
-	}
-	return *this;
+	return *this = *this - right;
 }
 
 
@@ -227,9 +227,12 @@ void render_crosshair::create_bitmap()
 
 void render_crosshair::animate(u16 auto_time)
 {
+	// crosshairs that are not in use have no position to track
+	if (!m_used)
+		return;
+
 	// read all the port values
-	if (m_used)
-		m_machine.ioport().crosshair_position(m_player, m_x, m_y);
+	m_machine.ioport().crosshair_position(m_player, m_x, m_y);
 
 	// auto visibility
 	if (m_mode == CROSSHAIR_VISIBILITY_AUTO)
@@ -313,9 +316,9 @@ crosshair_manager::crosshair_manager(running_machine &machine)
 	if (m_usage)
 		machine.configuration().config_register("crosshairs", config_load_delegate(&crosshair_manager::config_load, this), config_save_delegate(&crosshair_manager::config_save, this));
 
-	/* register the animation callback */
+	/* register the animation callback, but only if anybody needs it */
 	screen_device *first_screen = screen_device_iterator(machine.root_device()).first();
-	if (first_screen != nullptr)
+	if (m_usage && first_screen != nullptr)
 		first_screen->register_vblank_callback(vblank_state_delegate(&crosshair_manager::animate, this));
 }
 
@@ -367,6 +370,10 @@ void crosshair_manager::render(screen_device &screen)
 {
 	int player;
 
+	/* nothing to do for the common case of no crosshairs at all */
+	if (!m_usage)
+		return;
+
 	for (player = 0; player < MAX_PLAYERS; player++)
 	{
 		render_crosshair &crosshair = *m_crosshair[player];
@@ -40,6 +40,7 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 	, m_breakcpu(nullptr)
 	, m_symtable(nullptr)
 	, m_vblank_occurred(false)
+	, m_memory_write_count(0)
 	, m_execution_state(exec_state::STOPPED)
 	, m_stop_when_not_device(nullptr)
 	, m_bpindex(1)
@@ -430,6 +431,7 @@ void debugger_cpu::write_byte(address_space &space, offs_t address, u8 data, boo
 	space.write_byte(address, data);
 
 	m_memory_modified = true;
+	m_memory_write_count++;
 }
 
 
@@ -456,6 +458,7 @@ void debugger_cpu::write_word(address_space &space, offs_t address, u16 data, bo
 	space.write_word_unaligned(address, data);
 
 	m_memory_modified = true;
+	m_memory_write_count++;
 }
 
 
@@ -482,6 +485,7 @@ void debugger_cpu::write_dword(address_space &space, offs_t address, u32 data, b
 	space.write_dword_unaligned(address, data);
 
 	m_memory_modified = true;
+	m_memory_write_count++;
 }
 
 
@@ -508,6 +512,7 @@ void debugger_cpu::write_qword(address_space &space, offs_t address, u64 data, b
 	space.write_qword_unaligned(address, data);
 
 	m_memory_modified = true;
+	m_memory_write_count++;
 }
 
 
@@ -620,7 +625,34 @@ device_t* debugger_cpu::expression_get_device(const char *tag)
 	// convert to lowercase then lookup the name (tags are enforced to be all lower case)
 	std::string fullname(tag);
 	strmakelower(fullname);
-	return m_machine.root_device().subdevice(fullname.c_str());
+
+	// memoize the walk; cheat scripts hit this every frame for every named
+	// reference, and the answer cannot change while the machine runs
+	auto cached = m_expression_device_cache.find(fullname);
+	if (cached != m_expression_device_cache.end())
+		return cached->second;
+
+	device_t *device = m_machine.root_device().subdevice(fullname.c_str());
+	m_expression_device_cache.emplace(std::move(fullname), device);
+	return device;
+}
+
+
+/*-------------------------------------------------
+    expression_get_region - return a memory
+    region based on a tag search, memoized for
+    repeated lookups
+-------------------------------------------------*/
+
+memory_region *debugger_cpu::expression_get_region(const char *tag)
+{
+	auto cached = m_expression_region_cache.find(tag);
+	if (cached != m_expression_region_cache.end())
+		return cached->second;
+
+	memory_region *region = m_machine.root_device().memregion(tag);
+	m_expression_region_cache.emplace(tag, region);
+	return region;
 }
 
 
@@ -789,7 +821,7 @@ u64 debugger_cpu::expression_read_program_direct(address_space &space, int opcod
 
 u64 debugger_cpu::expression_read_memory_region(const char *rgntag, offs_t address, int size)
 {
-	memory_region *region = m_machine.root_device().memregion(rgntag);
+	memory_region *region = expression_get_region(rgntag);
 	u64 result = ~u64(0) >> (64 - 8*size);
 
 	/* make sure we get a valid base before proceeding */
@@ -971,6 +1003,7 @@ void debugger_cpu::expression_write_program_direct(address_space &space, int opc
 			else
 				base[BYTE8_XOR_BE(address) & lowmask] = data;
 			m_memory_modified = true;
+			m_memory_write_count++;
 		}
 	}
 }
@@ -983,7 +1016,7 @@ void debugger_cpu::expression_write_program_direct(address_space &space, int opc
 
 void debugger_cpu::expression_write_memory_region(const char *rgntag, offs_t address, int size, u64 data)
 {
-	memory_region *region = m_machine.root_device().memregion(rgntag);
+	memory_region *region = expression_get_region(rgntag);
 
 	/* make sure we get a valid base before proceeding */
 	if (region != nullptr)
@@ -1029,6 +1062,7 @@ void debugger_cpu::expression_write_memory_region(const char *rgntag, offs_t add
 				base[BYTE8_XOR_BE(address) & lowmask] = data;
 			}
 			m_memory_modified = true;
+			m_memory_write_count++;
 		}
 	}
 }
@@ -2743,6 +2777,10 @@ device_debug::watchpoint::watchpoint(device_debug* debugInterface,
 	  m_condition(&symbols, (condition != nullptr) ? condition : "1"),
 	  m_action((action != nullptr) ? action : "")
 {
+	// the default condition of "1" folds to a constant; don't evaluate it on every access
+	u64 condvalue;
+	m_condition_always_true = m_condition.is_constant(condvalue) && (condvalue != 0);
+
 	std::fill(std::begin(m_start_address), std::end(m_start_address), 0);
 	std::fill(std::begin(m_end_address), std::end(m_end_address), 0);
 	std::fill(std::begin(m_masks), std::end(m_masks), 0);
@@ -2975,7 +3013,7 @@ void device_debug::watchpoint::triggered(read_or_write type, offs_t address, u64
 	debug.cpu().set_within_instruction(true);
 
 	// must satisfy the condition
-	if (!m_condition.is_empty())
+	if (!m_condition.is_empty() && !m_condition_always_true)
 	{
 		try
 		{
@@ -3084,8 +3122,13 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 	, m_nextdex(0)
 	, m_trace_over(trace_over)
 	, m_trace_over_target(~0)
+	, m_writing(false)
+	, m_done(false)
 {
 	memset(m_history, 0, sizeof(m_history));
+
+	// writes happen on a background thread so tracing never stalls execution
+	m_writer = std::thread(&tracer::write_loop, this);
 }
 
 
@@ -3095,6 +3138,15 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 
 device_debug::tracer::~tracer()
 {
+	// drain anything still buffered and stop the writer
+	flush();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_done = true;
+	}
+	m_wake.notify_one();
+	m_writer.join();
+
 	// make sure we close the file if we can
 	fclose(&m_file);
 }
@@ -3132,7 +3184,7 @@ void device_debug::tracer::update(offs_t pc)
 
 		// if we just finished looping, indicate as much
 		if (m_loops != 0)
-			fprintf(&m_file, "\n   (loops for %d instructions)\n\n", m_loops);
+			print(string_format("\n   (loops for %d instructions)\n\n", m_loops));
 		m_loops = 0;
 	}
 
@@ -3147,7 +3199,7 @@ void device_debug::tracer::update(offs_t pc)
 	buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
 
 	// output the result
-	fprintf(&m_file, "%s: %s\n", buffer.pc_to_string(pc).c_str(), instruction.c_str());
+	print(string_format("%s: %s\n", buffer.pc_to_string(pc), instruction));
 
 	// do we need to step the trace over this instruction?
 	if (m_trace_over && (dasmresult & util::disasm_interface::SUPPORTED) != 0 && (dasmresult & util::disasm_interface::STEP_OVER) != 0)
@@ -3165,7 +3217,6 @@ void device_debug::tracer::update(offs_t pc)
 	// log this PC
 	m_nextdex = (m_nextdex + 1) % TRACE_LOOPS;
 	m_history[m_nextdex] = pc;
-	fflush(&m_file);
 }
 
 
@@ -3175,9 +3226,10 @@ void device_debug::tracer::update(offs_t pc)
 
 void device_debug::tracer::vprintf(const char *format, va_list va)
 {
-	// pass through to the file
-	vfprintf(&m_file, format, va);
-	fflush(&m_file);
+	// buffer it up like everything else
+	std::string text;
+	strcatvprintf(text, format, va);
+	print(std::move(text));
 }
 
 
@@ -3188,7 +3240,63 @@ void device_debug::tracer::vprintf(const char *format, va_list va)
 
 void device_debug::tracer::flush()
 {
-	fflush(&m_file);
+	// hand everything we have to the writer and wait for it to drain
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_pending.append(m_buffer);
+	m_buffer.clear();
+	m_wake.notify_one();
+	m_idle.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+
+//-------------------------------------------------
+//  print - append text to the trace buffer,
+//  handing it to the writer when enough has
+//  accumulated
+//-------------------------------------------------
+
+void device_debug::tracer::print(std::string &&text)
+{
+	// only the execution thread touches m_buffer, so no lock until handoff
+	m_buffer.append(text);
+	if (m_buffer.size() >= BUFFER_FLUSH_SIZE)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.append(m_buffer);
+		m_buffer.clear();
+		m_wake.notify_one();
+	}
+}
+
+
+//-------------------------------------------------
+//  write_loop - background thread that writes
+//  buffered trace text to the file
+//-------------------------------------------------
+
+void device_debug::tracer::write_loop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_done || !m_pending.empty())
+	{
+		// wait for work
+		if (m_pending.empty())
+		{
+			m_wake.wait(lock);
+			continue;
+		}
+
+		// claim the pending text and write it without holding the lock
+		std::string chunk;
+		chunk.swap(m_pending);
+		m_writing = true;
+		lock.unlock();
+		fwrite(chunk.data(), 1, chunk.size(), &m_file);
+		fflush(&m_file);
+		lock.lock();
+		m_writing = false;
+		m_idle.notify_all();
+	}
 }
 
 
@@ -15,7 +15,11 @@
 
 #include "express.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <unordered_map>
 
 
 //**************************************************************************
@@ -126,6 +130,7 @@ public:
 		offs_t               m_address;                  // start address
 		offs_t               m_length;                   // length of watch area
 		parsed_expression    m_condition;                // condition
+		bool                 m_condition_always_true;    // condition folded to a nonzero constant
 		std::string          m_action;                   // action
 		int                  m_notifier;                 // address map change notifier id
 
@@ -351,6 +356,10 @@ private:
 
 	private:
 		static const int TRACE_LOOPS = 64;
+		static const size_t BUFFER_FLUSH_SIZE = 65536;
+
+		void print(std::string &&text);
+		void write_loop();
 
 		device_debug &      m_debug;                    // reference to our owner
 		FILE &              m_file;                     // tracing file for this CPU
@@ -364,6 +373,17 @@ private:
 		offs_t              m_trace_over_target;        // target for tracing over
 														//    (0 = not tracing over,
 														//    ~0 = not currently tracing over)
+
+		// trace output is buffered and written by a background thread so the
+		// execution thread never blocks on the file
+		std::string         m_buffer;                   // text accumulated by the execution thread
+		std::string         m_pending;                  // text handed off for writing
+		std::mutex          m_mutex;                    // protects m_pending and the flags below
+		std::condition_variable m_wake;                 // signalled when there is work for the writer
+		std::condition_variable m_idle;                 // signalled when the writer has drained
+		std::thread         m_writer;                   // the background writer thread
+		bool                m_writing;                  // the writer is in the middle of an fwrite
+		bool                m_done;                     // set at destruction to stop the writer
 	};
 	std::unique_ptr<tracer>                m_trace;                    // tracer state
 
@@ -551,6 +571,7 @@ public:
 	// getters
 	bool within_instruction_hook() const { return m_within_instruction_hook; }
 	bool memory_modified() const { return m_memory_modified; }
+	u32 memory_write_count() const { return m_memory_write_count; }
 	exec_state execution_state() const { return m_execution_state; }
 	device_t *live_cpu() { return m_livecpu; }
 	u32 get_breakpoint_index() { return m_bpindex++; }
@@ -588,6 +609,7 @@ private:
 	void expression_write_memory_region(const char *rgntag, offs_t address, int size, u64 data);
 	expression_error::error_code expression_validate(void *param, const char *name, expression_space space);
 	device_t* expression_get_device(const char *tag);
+	memory_region *expression_get_region(const char *tag);
 
 	/* variable getters/setters */
 	u64 get_cpunum(symbol_table &table);
@@ -609,6 +631,7 @@ private:
 	bool        m_within_instruction_hook;
 	bool        m_vblank_occurred;
 	bool        m_memory_modified;
+	u32         m_memory_write_count;       // bumped on every debugger-initiated write
 
 	exec_state  m_execution_state;
 	device_t *  m_stop_when_not_device; // stop execution when the device ceases to be this
@@ -624,6 +647,12 @@ private:
 	osd_ticks_t m_last_periodic_update_time;
 
 	bool        m_comments_loaded;
+
+	// memoized lookups for named expression references; the device tree is
+	// fixed while the machine runs, so a tag binds to the same device or
+	// region for the lifetime of this object (misses are cached too)
+	std::unordered_map<std::string, device_t *>         m_expression_device_cache;
+	std::unordered_map<std::string, memory_region *>    m_expression_region_cache;
 };
 
 #endif // MAME_EMU_DEBUG_DEBUGCPU_H
@@ -48,7 +48,9 @@ debug_view_disasm::debug_view_disasm(running_machine &machine, debug_view_osd_up
 		m_backwards_steps(3),
 		m_dasm_width(DEFAULT_DASM_WIDTH),
 		m_previous_pc(1),
-		m_expression(machine)
+		m_expression(machine),
+		m_last_signature(0),
+		m_last_signature_valid(false)
 {
 	// fail if no available sources
 	enumerate_sources();
@@ -375,9 +377,44 @@ void debug_view_disasm::complete_information(const debug_view_disasm_source &sou
 void debug_view_disasm::view_update()
 {
 	const debug_view_disasm_source &source = downcast<const debug_view_disasm_source &>(*m_source);
-	debug_disasm_buffer buffer(*source.device());
 	offs_t pc = source.device()->state().pcbase() & source.m_space.logaddrmask();
 
+	// while execution is stopped every input of the view is tracked, so if
+	// nothing changed since the last update the contents are still valid
+	if(machine().debugger().cpu().is_stopped() && !m_expression.dirty())
+	{
+		u64 signature = 0xcbf29ce484222325U;
+		auto fold = [&signature] (u64 value)
+		{
+			for(int b = 0; b < 64; b += 8)
+			{
+				signature ^= (value >> b) & 0xff;
+				signature *= 0x100000001b3U;
+			}
+		};
+		fold(pc);
+		fold(m_expression.last_value());
+		fold(uintptr_t(m_source));
+		fold(u64(u32(m_topleft.x)) | (u64(u32(m_topleft.y)) << 32));
+		fold(u64(u32(m_visible.x)) | (u64(u32(m_visible.y)) << 32));
+		fold(m_cursor_visible ? (u64(u32(m_cursor.x)) | (u64(u32(m_cursor.y)) << 32)) : ~u64(0));
+		fold(u64(m_right_column) | (u64(m_dasm_width) << 8) | (u64(m_backwards_steps) << 24));
+		fold(source.device()->execute().total_cycles());
+		fold(machine().debugger().cpu().memory_write_count());
+		fold(source.device()->debug()->comment_change_count());
+		for(device_debug::breakpoint *bp = source.device()->debug()->breakpoint_first(); bp != nullptr; bp = bp->next())
+			fold(u64(bp->address()) | (bp->enabled() ? u64(1) << 63 : 0));
+
+		if(m_last_signature_valid && m_last_signature == signature)
+			return;
+		m_last_signature = signature;
+		m_last_signature_valid = true;
+	}
+	else
+		m_last_signature_valid = false;
+
+	debug_disasm_buffer buffer(*source.device());
+
 	generate_dasm(buffer, pc);
 
 	complete_information(source, buffer, pc);
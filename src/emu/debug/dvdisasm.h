@@ -127,6 +127,8 @@ private:
 	offs_t                 m_previous_pc;          // previous pc, to detect whether it changed
 	debug_view_expression  m_expression;           // expression-related information
 	std::vector<dasm_line> m_dasm;                 // disassembled instructions
+	u64                    m_last_signature;       // hash of the inputs of the last update
+	bool                   m_last_signature_valid; // whether the signature can be trusted
 
 	// constants
 	static constexpr int DEFAULT_DASM_LINES = 1000;
@@ -259,6 +259,19 @@ void debug_view_memory::view_update()
 	// get positional data
 	const memory_view_pos &posdata = s_memory_pos_table[m_data_format];
 
+	// rows are cached for the integer formats; a resize resets the cache
+	bool const use_cache = (m_data_format <= 8);
+	if (m_row_cache.size() != size_t(m_visible.y))
+	{
+		m_row_cache.clear();
+		m_row_cache.resize(m_visible.y);
+	}
+	if (use_cache)
+	{
+		m_row_data.resize(m_chunks_per_row);
+		m_row_mapped.resize(m_chunks_per_row);
+	}
+
 	// loop over visible rows
 	for (u32 row = 0; row < m_visible.y; row++)
 	{
@@ -267,6 +280,44 @@ void debug_view_memory::view_update()
 		debug_view_char *destrow = destmin - m_topleft.x;
 		u32 effrow = m_topleft.y + row;
 
+		offs_t addrbyte = m_byte_offset + effrow * m_bytes_per_row;
+		offs_t rowaddress = (source.m_space != nullptr) ? source.m_space->byte_to_address(addrbyte) : addrbyte;
+
+		// read the row's data up front and hash everything that shapes its
+		// text; an unchanged signature means the viewdata is still valid
+		if (use_cache)
+		{
+			u64 signature = 0xcbf29ce484222325U;
+			auto fold = [&signature] (u64 value)
+			{
+				for (int b = 0; b < 64; b += 8)
+				{
+					signature ^= (value >> b) & 0xff;
+					signature *= 0x100000001b3U;
+				}
+			};
+			if (effrow < m_total.y)
+				for (u32 chunknum = 0; chunknum < m_chunks_per_row; chunknum++)
+				{
+					u64 chunkdata = 0;
+					m_row_mapped[chunknum] = read(m_bytes_per_chunk, rowaddress + chunknum * m_steps_per_chunk, chunkdata) ? 1 : 0;
+					m_row_data[chunknum] = chunkdata;
+					fold(chunkdata);
+					fold(m_row_mapped[chunknum]);
+				}
+			fold(effrow);
+			fold(rowaddress);
+			fold(u64(s32(m_topleft.x)) | (u64(m_visible.x) << 32));
+			fold(u64(m_bytes_per_chunk) | (u64(m_chunks_per_row) << 8) | (m_reverse_view ? u64(1) << 40 : 0) | (m_ascii_view ? u64(1) << 41 : 0));
+			fold((m_cursor_visible && effrow == m_cursor.y) ? u64(m_cursor.x) : ~u64(0));
+
+			row_cache &cache = m_row_cache[row];
+			if (cache.m_valid && cache.m_signature == signature)
+				continue;
+			cache.m_signature = signature;
+			cache.m_valid = true;
+		}
+
 		// reset the line of data; section 1 is normal, others are ancillary, cursor is selected
 		debug_view_char *dest = destmin;
 		for (int ch = 0; ch < m_visible.x; ch++, dest++)
@@ -285,8 +336,7 @@ void debug_view_memory::view_update()
 		// if this visible row is valid, add it to the buffer
 		if (effrow < m_total.y)
 		{
-			offs_t addrbyte = m_byte_offset + effrow * m_bytes_per_row;
-			offs_t address = (source.m_space != nullptr) ? source.m_space->byte_to_address(addrbyte) : addrbyte;
+			offs_t address = rowaddress;
 			char addrtext[20];
 
 			// generate the address
@@ -304,8 +354,8 @@ void debug_view_memory::view_update()
 				int spacing = posdata.m_spacing;
 
 				if (m_data_format <= 8) {
-					u64 chunkdata;
-					bool ismapped = read(m_bytes_per_chunk, address + chunknum * m_steps_per_chunk, chunkdata);
+					u64 chunkdata = m_row_data[chunknum];
+					bool ismapped = bool(m_row_mapped[chunknum]);
 					dest = destrow + m_section[1].m_pos + 1 + chunkindex * spacing;
 					for (int ch = 0; ch < posdata.m_spacing; ch++, dest++)
 						if (dest >= destmin && dest < destmax)
@@ -539,6 +589,9 @@ void debug_view_memory::recompute()
 {
 	const debug_view_memory_source &source = downcast<const debug_view_memory_source &>(*m_source);
 
+	// the layout is changing, so no cached row can be trusted
+	m_row_cache.clear();
+
 	// get the current cursor position
 	cursor_pos pos = get_cursor_pos(m_cursor);
 
@@ -126,6 +126,18 @@ private:
 	};
 	section             m_section[3];           // (derived) 3 sections to manage
 
+	// per-row render cache; a row whose signature is unchanged since the last
+	// update keeps its text in m_viewdata without being re-formatted
+	struct row_cache
+	{
+		row_cache() : m_signature(0), m_valid(false) { }
+		u64             m_signature;            /* hash of everything that produced the row */
+		bool            m_valid;                /* the signature is meaningful */
+	};
+	std::vector<row_cache> m_row_cache;         // one entry per visible row
+	std::vector<u64>    m_row_data;             // scratch chunk values for the current row
+	std::vector<u8>     m_row_mapped;           // scratch mapped flags for the current row
+
 	struct memory_view_pos
 	{
 		u8           m_spacing;              /* spacing between each entry */
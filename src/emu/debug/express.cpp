@@ -367,6 +367,8 @@ u64 function_symbol_entry::execute(int numparams, const u64 *paramlist)
 symbol_table::symbol_table(void *globalref, symbol_table *parent)
 	: m_parent(parent),
 		m_globalref(globalref),
+		m_generation(0),
+		m_deepcache_generation(0xffffffff),
 		m_memory_param(nullptr),
 		m_memory_valid(nullptr),
 		m_memory_read(nullptr),
@@ -396,6 +398,7 @@ void symbol_table::add(const char *name, read_write rw, u64 *ptr)
 {
 	m_symlist.erase(name);
 	m_symlist.emplace(name, std::make_unique<integer_symbol_entry>(*this, name, rw, ptr));
+	m_generation++;
 }
 
 
@@ -407,6 +410,7 @@ void symbol_table::add(const char *name, u64 value)
 {
 	m_symlist.erase(name);
 	m_symlist.emplace(name, std::make_unique<integer_symbol_entry>(*this, name, value));
+	m_generation++;
 }
 
 
@@ -418,6 +422,7 @@ void symbol_table::add(const char *name, getter_func getter, setter_func setter,
 {
 	m_symlist.erase(name);
 	m_symlist.emplace(name, std::make_unique<integer_symbol_entry>(*this, name, getter, setter, format_string));
+	m_generation++;
 }
 
 
@@ -429,6 +434,7 @@ void symbol_table::add(const char *name, int minparams, int maxparams, execute_f
 {
 	m_symlist.erase(name);
 	m_symlist.emplace(name, std::make_unique<function_symbol_entry>(*this, name, minparams, maxparams, execute));
+	m_generation++;
 }
 
 
@@ -439,14 +445,26 @@ void symbol_table::add(const char *name, int minparams, int maxparams, execute_f
 
 symbol_entry *symbol_table::find_deep(const char *symbol)
 {
-	// walk up the table hierarchy to find the owner
+	// the flattened index merges every scope on the parent chain into one
+	// hash table; generations only ever increment, so a changed sum means
+	// some table on the chain was mutated and the index must be rebuilt
+	u32 chain_generation = 0;
 	for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+		chain_generation += symtable->m_generation;
+
+	if (chain_generation != m_deepcache_generation)
 	{
-		symbol_entry *entry = symtable->find(symbol);
-		if (entry != nullptr)
-			return entry;
+		m_deepcache.clear();
+
+		// the nearest scope wins, so merge from the innermost table outward
+		for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+			for (auto &entry : symtable->m_symlist)
+				m_deepcache.emplace(entry.first, entry.second.get());
+		m_deepcache_generation = chain_generation;
 	}
-	return nullptr;
+
+	auto search = m_deepcache.find(symbol);
+	return (search != m_deepcache.end()) ? search->second : nullptr;
 }
 
 
@@ -567,6 +585,9 @@ void parsed_expression::parse(const char *expression)
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// collapse constant subexpressions so they aren't re-evaluated every execution
+	fold_constants();
 }
 
 
@@ -579,7 +600,11 @@ void parsed_expression::copy(const parsed_expression &src)
 	m_symtable = src.m_symtable;
 	m_original_string.assign(src.m_original_string);
 	if (!m_original_string.empty())
+	{
 		parse_string_into_tokens();
+		infix_to_postfix();
+		fold_constants();
+	}
 }
 
 
@@ -1322,6 +1347,128 @@ void parsed_expression::infix_to_postfix()
 }
 
 
+//-------------------------------------------------
+//  fold_constants - reduce constant subexpressions
+//  in the postfix sequence to single number tokens
+//  and bind constant addresses to memory tokens,
+//  so repeated executions don't redo the work
+//-------------------------------------------------
+
+void parsed_expression::fold_constants()
+{
+	// each pass folds one reducible operator; repeat until nothing is left to do
+	bool folded = true;
+	while (folded)
+	{
+		folded = false;
+
+		// in postfix order, an operator's operands are exactly the tokens
+		// immediately preceding it, so foldable patterns are easy to spot
+		parse_token *prev2 = nullptr;
+		parse_token *prev1 = nullptr;
+		for (parse_token *token = m_tokenlist.first(); token != nullptr; prev2 = prev1, prev1 = token, token = token->next())
+		{
+			// only operators can be folded
+			if (!token->is_operator())
+				continue;
+
+			// switch off the operator
+			switch (token->optype())
+			{
+				// unary operators with a constant operand
+				case TVL_COMPLEMENT:
+				case TVL_NOT:
+				case TVL_UPLUS:
+				case TVL_UMINUS:
+					if (prev1 != nullptr && prev1->is_number())
+					{
+						u64 const operand = prev1->value();
+						switch (token->optype())
+						{
+							case TVL_COMPLEMENT:    prev1->configure_number(!operand);  break;
+							case TVL_NOT:           prev1->configure_number(~operand);  break;
+							case TVL_UPLUS:         prev1->configure_number(operand);   break;
+							case TVL_UMINUS:        prev1->configure_number(-operand);  break;
+						}
+						m_tokenlist.remove(*token);
+						folded = true;
+					}
+					break;
+
+				// a memory dereference of a constant address becomes a memory token
+				case TVL_MEMORYAT:
+					if (prev1 != nullptr && prev1->is_number())
+					{
+						prev1->configure_memory(prev1->value(), *token);
+						m_tokenlist.remove(*token);
+						folded = true;
+					}
+					break;
+
+				// side-effect-free binary operators with two constant operands
+				case TVL_MULTIPLY:
+				case TVL_DIVIDE:
+				case TVL_MODULO:
+				case TVL_ADD:
+				case TVL_SUBTRACT:
+				case TVL_LSHIFT:
+				case TVL_RSHIFT:
+				case TVL_LESS:
+				case TVL_LESSOREQUAL:
+				case TVL_GREATER:
+				case TVL_GREATEROREQUAL:
+				case TVL_EQUAL:
+				case TVL_NOTEQUAL:
+				case TVL_BAND:
+				case TVL_BXOR:
+				case TVL_BOR:
+				case TVL_LAND:
+				case TVL_LOR:
+					if (prev2 != nullptr && prev2->is_number() && prev1->is_number())
+					{
+						u64 const lhs = prev2->value();
+						u64 const rhs = prev1->value();
+
+						// division by zero is reported at execution time; never fold it away
+						if ((token->optype() == TVL_DIVIDE || token->optype() == TVL_MODULO) && rhs == 0)
+							break;
+
+						switch (token->optype())
+						{
+							case TVL_MULTIPLY:          prev2->configure_number(lhs * rhs);     break;
+							case TVL_DIVIDE:            prev2->configure_number(lhs / rhs);     break;
+							case TVL_MODULO:            prev2->configure_number(lhs % rhs);     break;
+							case TVL_ADD:               prev2->configure_number(lhs + rhs);     break;
+							case TVL_SUBTRACT:          prev2->configure_number(lhs - rhs);     break;
+							case TVL_LSHIFT:            prev2->configure_number(lhs << rhs);    break;
+							case TVL_RSHIFT:            prev2->configure_number(lhs >> rhs);    break;
+							case TVL_LESS:              prev2->configure_number(lhs < rhs);     break;
+							case TVL_LESSOREQUAL:       prev2->configure_number(lhs <= rhs);    break;
+							case TVL_GREATER:           prev2->configure_number(lhs > rhs);     break;
+							case TVL_GREATEROREQUAL:    prev2->configure_number(lhs >= rhs);    break;
+							case TVL_EQUAL:             prev2->configure_number(lhs == rhs);    break;
+							case TVL_NOTEQUAL:          prev2->configure_number(lhs != rhs);    break;
+							case TVL_BAND:              prev2->configure_number(lhs & rhs);     break;
+							case TVL_BXOR:              prev2->configure_number(lhs ^ rhs);     break;
+							case TVL_BOR:               prev2->configure_number(lhs | rhs);     break;
+							case TVL_LAND:              prev2->configure_number(lhs && rhs);    break;
+							case TVL_LOR:               prev2->configure_number(lhs || rhs);    break;
+						}
+						m_tokenlist.remove(*prev1);
+						m_tokenlist.remove(*token);
+						folded = true;
+					}
+					break;
+			}
+
+			// the list changed under us; restart the scan
+			if (folded)
+				break;
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  push_token - push a token onto the stack
 //-------------------------------------------------
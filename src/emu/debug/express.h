@@ -15,9 +15,9 @@
 
 #include "emucore.h"
 
-#include <deque>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -200,6 +200,9 @@ private:
 	symbol_table *          m_parent;           // pointer to the parent symbol table
 	void *                  m_globalref;        // global reference parameter
 	std::unordered_map<std::string,std::unique_ptr<symbol_entry>> m_symlist;        // list of symbols
+	u32                     m_generation;       // bumped on every mutation of this table
+	mutable std::unordered_map<std::string,symbol_entry *> m_deepcache;  // flattened index over the whole parent chain
+	mutable u32             m_deepcache_generation; // chain generation the flattened index was built for
 	void *                  m_memory_param;     // callback parameter for memory
 	valid_func              m_memory_valid;     // validation callback
 	read_func               m_memory_read;      // read callback
@@ -223,6 +226,7 @@ public:
 
 	// getters
 	bool is_empty() const { return (m_tokenlist.count() == 0); }
+	bool is_constant(u64 &value) const { if (m_tokenlist.count() != 1 || !m_tokenlist.first()->is_number()) return false; value = m_tokenlist.first()->value(); return true; }
 	const char *original_string() const { return m_original_string.c_str(); }
 	symbol_table *symbols() const { return m_symtable; }
 
@@ -363,6 +367,7 @@ private:
 	void parse_memory_operator(parse_token &token, const char *string, bool disable_se);
 	void normalize_operator(parse_token *prevtoken, parse_token &thistoken);
 	void infix_to_postfix();
+	void fold_constants();
 
 	// execution helpers
 	void push_token(parse_token &token);
@@ -380,7 +385,7 @@ private:
 	std::string         m_original_string;              // original string (prior to parsing)
 	simple_list<parse_token> m_tokenlist;               // token list
 	simple_list<expression_string> m_stringlist;        // string list
-	std::deque<parse_token> m_token_stack;              // token stack (used during execution)
+	std::vector<parse_token> m_token_stack;             // token stack (used during execution)
 };
 
 #endif // MAME_EMU_DEBUG_EXPRESS_H
@@ -497,7 +497,7 @@ private:
 		virtual func_t create() override
 		{
 			func_t result;
-			m_builder.build([&result] (auto &&f) { result = [cb = std::move(f)] (address_space &space, offs_t offset, typename T::input_mask_t mem_mask) { return cb(space, offset, mem_mask); }; });
+			m_builder.build([&result] (auto &&f) { result = devcb_read::fuse_built<typename T::input_mask_t>(std::move(f)); });
 			return std::move(result);
 		}
 
@@ -505,6 +505,20 @@ private:
 		T m_builder;
 	};
 
+	// fusion: when the built callable already has a compatible shape
+	// (e.g. a bare bound delegate), store it in the std::function as-is
+	// instead of behind an adaptor lambda
+	template <typename M, typename F>
+	static std::enable_if_t<std::is_constructible<func_t, F>::value, func_t> fuse_built(F &&f)
+	{
+		return func_t(std::move(f));
+	}
+	template <typename M, typename F>
+	static std::enable_if_t<!std::is_constructible<func_t, F>::value, func_t> fuse_built(F &&f)
+	{
+		return [cb = std::move(f)] (address_space &space, offs_t offset, M mem_mask) { return cb(space, offset, mem_mask); };
+	}
+
 	class log_creator : public creator
 	{
 	public:
@@ -749,9 +763,7 @@ private:
 			assert(this->m_consumed);
 			this->built();
 			m_delegate.bind_relative_to(m_devbase);
-			chain(
-					[cb = std::move(this->m_delegate), exor = this->exor(), mask = this->mask()] (address_space &space, offs_t offset, input_mask_t mem_mask)
-					{ return (devcb_read::invoke_read<Result>(cb, space, offset, mem_mask & mask) ^ exor) & mask; });
+			build(std::forward<T>(chain), std::is_constructible<func_t, Delegate>());
 		}
 
 	private:
@@ -759,6 +771,26 @@ private:
 		delegate_builder &operator=(delegate_builder const &) = delete;
 		delegate_builder &operator=(delegate_builder &&that) = delete;
 
+		// fusion: a delegate whose signature matches the callback
+		// natively and that has no exor/mask in play is handed over
+		// as-is, so the resolved callback is the bound delegate itself
+		template <typename T>
+		void build(T &&chain, std::true_type)
+		{
+			if (!this->exor() && this->mask() == (DefaultMask & delegate_traits<Delegate>::default_mask))
+				chain(std::move(this->m_delegate));
+			else
+				build(std::forward<T>(chain), std::false_type());
+		}
+
+		template <typename T>
+		void build(T &&chain, std::false_type)
+		{
+			chain(
+					[cb = std::move(this->m_delegate), exor = this->exor(), mask = this->mask()] (address_space &space, offs_t offset, input_mask_t mem_mask)
+					{ return (devcb_read::invoke_read<Result>(cb, space, offset, mem_mask & mask) ^ exor) & mask; });
+		}
+
 		device_t &m_devbase;
 		Delegate m_delegate;
 	};
@@ -1104,13 +1136,27 @@ private:
 
 		virtual func_t create() override
 		{
-			return [cb = m_builder.build()] (address_space &space, offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { cb(space, offset, data, mem_mask); };
+			return devcb_write::fuse_built(m_builder.build());
 		}
 
 	private:
 		T m_builder;
 	};
 
+	// fusion: when the built callable already has a compatible shape,
+	// store it in the std::function as-is instead of behind an adaptor
+	// lambda
+	template <typename F>
+	static std::enable_if_t<std::is_constructible<func_t, F>::value, func_t> fuse_built(F &&f)
+	{
+		return func_t(std::move(f));
+	}
+	template <typename F>
+	static std::enable_if_t<!std::is_constructible<func_t, F>::value, func_t> fuse_built(F &&f)
+	{
+		return [cb = std::move(f)] (address_space &space, offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { cb(space, offset, data, mem_mask); };
+	}
+
 	class nop_creator : public creator
 	{
 	public:
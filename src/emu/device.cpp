@@ -866,6 +866,13 @@ device_t *device_t::subdevice_slow(const char *tag) const
 	// if we got a match, add to the fast map
 	if (curdevice != nullptr)
 		m_subdevices.m_tagmap.insert(std::make_pair(tag, curdevice));
+
+	// a slow lookup after start means some handler is walking the device
+	// tree at runtime; resolved finders make this free, so flag it (the
+	// result lands in the fast map, so this fires once per tag)
+	if (has_running_machine() && started())
+		logerror("Warning: slow subdevice lookup of '%s' after start; use a device_finder or cache the result\n", tag);
+
 	return curdevice;
 }
 
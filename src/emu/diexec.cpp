@@ -45,10 +45,12 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute")
 	, m_scheduler(nullptr)
+	, m_debugger_active(false)
 	, m_disabled(false)
 	, m_vblank_interrupt_screen(nullptr)
 	, m_timed_interrupt_period(attotime::zero)
 	, m_nextexec(nullptr)
+	, m_parallel_safe(false)
 	, m_timedint_timer(nullptr)
 	, m_profiler(PROFILER_IDLE)
 	, m_icountptr(nullptr)
@@ -58,9 +60,11 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_nextsuspend(0)
 	, m_eatcycles(0)
 	, m_nexteatcycles(0)
+	, m_run_state(RUN_NORMAL)
 	, m_trigger(0)
 	, m_inttrigger(0)
 	, m_totalcycles(0)
+	, m_host_ticks(0)
 	, m_divisor(0)
 	, m_divshift(0)
 	, m_cycles_per_second(0)
@@ -370,6 +374,10 @@ void device_execute_interface::interface_pre_start()
 {
 	m_scheduler = &device().machine().scheduler();
 
+	// latch whether the debugger is active; the flag is set in the
+	// running_machine constructor and never changes during a run
+	m_debugger_active = (device().machine().debug_flags & DEBUG_FLAG_ENABLED) != 0;
+
 	// bind delegates
 	m_vblank_interrupt.bind_relative_to(*device().owner());
 	m_timed_interrupt.bind_relative_to(*device().owner());
@@ -378,6 +386,7 @@ void device_execute_interface::interface_pre_start()
 	// fill in the initial states
 	int const index = device_iterator(device().machine().root_device()).indexof(*this);
 	m_suspend = SUSPEND_REASON_RESET;
+	update_run_state();
 	m_profiler = profile_type(index + PROFILER_DEVICE_FIRST);
 	m_inttrigger = index + TRIGGER_INT;
 
@@ -420,8 +429,9 @@ void device_execute_interface::interface_post_start()
 
 void device_execute_interface::interface_pre_reset()
 {
-	// reset the total number of cycles
+	// reset the total number of cycles and host-time accounting
 	m_totalcycles = 0;
+	m_host_ticks = 0;
 
 	// enable all devices (except for disabled and unclocked devices)
 	if (disabled())
@@ -522,7 +532,7 @@ int device_execute_interface::standard_irq_callback(int irqline)
 		vector = m_driver_irq(device(), irqline);
 
 	// notify the debugger
-	if (device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+	if (m_debugger_active)
 		device().debug()->interrupt_hook(irqline);
 
 	return vector;
@@ -702,6 +712,19 @@ void device_execute_interface::device_input::set_state_synced(int state, int vec
 if (TEMPLOG) printf("setline(%s,%d,%d,%d)\n", m_execute->device().tag(), m_linenum, state, (vector == USE_STORED_VECTOR) ? 0 : vector);
 	assert(state == ASSERT_LINE || state == HOLD_LINE || state == CLEAR_LINE);
 
+	// raising a line from a worker thread mutates the target device's event
+	// queue and the timer heap; hand the whole operation to the main thread
+	device_scheduler &scheduler = m_execute->scheduler();
+	if (UNEXPECTED(scheduler.executing_on_worker()))
+	{
+		scheduler.defer_from_worker([this, state, vector] { set_state_synced(state, vector); });
+		return;
+	}
+
+	// a device raising a line on another device is cross-CPU traffic
+	if (scheduler.currently_executing() != nullptr && scheduler.currently_executing() != m_execute)
+		scheduler.note_cross_device_communication();
+
 	// if we're full of events, flush the queue and log a message
 	int event_index = m_qindex++;
 	if (event_index >= ARRAY_LENGTH(m_queue))
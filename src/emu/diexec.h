@@ -223,6 +223,7 @@ public:
 	// time and cycle accounting
 	attotime local_time() const;
 	u64 total_cycles() const;
+	u64 host_ticks() const { return m_host_ticks; }
 
 	// required operation overrides
 	void run() { execute_run(); }
@@ -262,16 +263,18 @@ protected:
 	IRQ_CALLBACK_MEMBER(standard_irq_callback_member);
 	int standard_irq_callback(int irqline);
 
-	// debugger hooks
-	bool debugger_enabled() const { return bool(device().machine().debug_flags & DEBUG_FLAG_ENABLED); }
+	// debugger hooks; m_debugger_active caches DEBUG_FLAG_ENABLED (constant for
+	// the life of the machine) so the common no-debugger case tests a single
+	// member already in cache instead of chasing through the machine
+	bool debugger_enabled() const { return m_debugger_active; }
 	void debugger_instruction_hook(offs_t curpc)
 	{
-		if (device().machine().debug_flags & DEBUG_FLAG_CALL_HOOK)
+		if (m_debugger_active && (device().machine().debug_flags & DEBUG_FLAG_CALL_HOOK))
 			device().debug()->instruction_hook(curpc);
 	}
 	void debugger_exception_hook(int exception)
 	{
-		if (device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+		if (m_debugger_active)
 			device().debug()->exception_hook(exception);
 	}
 
@@ -304,20 +307,29 @@ private:
 		TIMER_CALLBACK_MEMBER(empty_event_queue);
 	};
 
+	// run states, collapsing the suspend/eat-cycles tests into a single
+	// word the scheduler can test with one load per timeslice; updated on
+	// the slow path whenever the underlying state changes
+	static constexpr u32 RUN_NORMAL = 0;                // not suspended
+	static constexpr u32 RUN_EATING = 1;                // suspended, but local time still advances
+	static constexpr u32 RUN_SKIP = 2;                  // suspended, nothing to do
+	void update_run_state() { m_run_state.store((m_suspend == 0) ? RUN_NORMAL : (m_eatcycles ? RUN_EATING : RUN_SKIP), std::memory_order_relaxed); }
+
 	// internal debugger hooks
 	void debugger_start_cpu_hook(const attotime &endtime)
 	{
-		if (device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+		if (m_debugger_active)
 			device().debug()->start_hook(endtime);
 	}
 	void debugger_stop_cpu_hook()
 	{
-		if (device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+		if (m_debugger_active)
 			device().debug()->stop_hook();
 	}
 
 	// scheduler
 	device_scheduler *      m_scheduler;                // pointer to the machine scheduler
+	bool                    m_debugger_active;          // the debugger is enabled for this run
 
 	// configuration
 	bool                    m_disabled;                 // disabled from executing?
@@ -328,6 +340,7 @@ private:
 
 	// execution lists
 	device_execute_interface *m_nextexec;               // pointer to the next device to execute, in order
+	bool                    m_parallel_safe;            // proven safe to run on a scheduler worker thread
 
 	// input states and IRQ callbacks
 	device_irq_acknowledge_delegate m_driver_irq;       // driver-specific IRQ callback
@@ -345,6 +358,7 @@ private:
 	u32                     m_nextsuspend;              // pending suspend reason mask
 	u8                      m_eatcycles;                // true if we eat cycles while suspended
 	u8                      m_nexteatcycles;            // pending value
+	std::atomic<u32>        m_run_state;                // compacted run state for the scheduler fast path
 	s32                     m_trigger;                  // pending trigger to release a trigger suspension
 	s32                     m_inttrigger;               // interrupt trigger index
 
@@ -353,6 +367,7 @@ protected: // FIXME: MIPS3 accesses m_totalcycles directly from execute_burn - d
 	u64                     m_totalcycles;              // total device cycles executed
 private:
 	attotime                m_localtime;                // local time, relative to the timer system's global time
+	u64                     m_host_ticks;               // host profile ticks spent inside run()
 	s32                     m_divisor;                  // 32-bit attoseconds_per_cycle divisor
 	u8                      m_divshift;                 // right shift amount to fit the divisor into 32 bits
 	u32                     m_cycles_per_second;        // cycles per second, adjusted for multipliers
@@ -21,7 +21,9 @@
 //-------------------------------------------------
 
 device_nvram_interface::device_nvram_interface(const machine_config &mconfig, device_t &device)
-	: device_interface(device, "nvram")
+	: device_interface(device, "nvram"),
+		m_nvram_hash(0),
+		m_nvram_hash_valid(false)
 {
 }
 
@@ -38,11 +38,22 @@ public:
 	void nvram_load(emu_file &file) { nvram_read(file); }
 	void nvram_save(emu_file &file) { nvram_write(file); }
 
+	// dirty tracking; the hash covers the serialized content as of the
+	// last load or save, letting unchanged devices skip their write
+	bool nvram_hash_valid() const { return m_nvram_hash_valid; }
+	util::crc32_t nvram_hash() const { return m_nvram_hash; }
+	void set_nvram_hash(util::crc32_t hash) { m_nvram_hash = hash; m_nvram_hash_valid = true; }
+
 protected:
 	// derived class overrides
 	virtual void nvram_default() = 0;
 	virtual void nvram_read(emu_file &file) = 0;
 	virtual void nvram_write(emu_file &file) = 0;
+
+private:
+	// internal state
+	util::crc32_t   m_nvram_hash;       // hash of the content last loaded or saved
+	bool            m_nvram_hash_valid; // true once a hash has been recorded
 };
 
 // iterator
@@ -9,7 +9,11 @@ device_rom_interface::device_rom_interface(const machine_config &mconfig, device
 	m_rom_tag(device.basetag()),
 	m_rom_config("rom", endian, datawidth, addrwidth),
 	m_bank(nullptr),
-	m_cur_bank(-1)
+	m_cur_bank(-1),
+	m_flat_base(nullptr),
+	m_flat_rom(nullptr),
+	m_flat_mask(0),
+	m_flat_span(0)
 {
 }
 
@@ -41,14 +45,19 @@ void device_rom_interface::set_rom_bank(int bank)
 	if (m_cur_bank != bank) {
 		m_cur_bank = bank;
 		m_bank->set_entry(bank);
+		if(m_flat_rom)
+			m_flat_base = m_flat_rom + bank * m_flat_span;
 		rom_bank_updated();
 	}
 }
 
 void device_rom_interface::interface_post_load()
 {
-	if(m_bank)
+	if(m_bank) {
 		m_bank->set_entry(m_cur_bank);
+		if(m_flat_rom)
+			m_flat_base = m_flat_rom + m_cur_bank * m_flat_span;
+	}
 }
 
 void device_rom_interface::set_rom(const void *base, u32 size)
@@ -59,12 +68,24 @@ void device_rom_interface::set_rom(const void *base, u32 size)
 	if(m_bank_count < 1)
 		m_bank_count = 1;
 
+	// when the whole space is backed by the rom (possibly banked or
+	// mirrored), per-sample reads can use a direct pointer; anything else
+	// goes through the cache dispatch
+	bool flat = m_rom_config.data_width() == 8 && m_rom_config.addr_shift() == 0 && mend != 0xffffffff;
+
 	if(rend >= mend) {
 		space().install_read_bank(0, mend, device().tag());
 		m_bank = device().machine().memory().banks().find(device().tag())->second.get();
 		m_bank->configure_entries(0, m_bank_count, const_cast<void *>(base), mend+1);
 		m_cur_bank = 0;
 
+		if(flat) {
+			m_flat_rom = reinterpret_cast<const u8 *>(base);
+			m_flat_span = mend + 1;
+			m_flat_mask = mend;
+			m_flat_base = m_flat_rom;
+		}
+
 	} else {
 		// Round up to the nearest power-of-two-minus-one
 		u32 rmask = rend;
@@ -78,6 +99,11 @@ void device_rom_interface::set_rom(const void *base, u32 size)
 		// Mirror over the high bits.  mend and rmask are both
 		// powers-of-two-minus-one, so the xor works
 		space().install_rom(0, rend, mend ^ rmask, const_cast<void *>(base));
+
+		if(flat && rmask == rend) {
+			m_flat_base = reinterpret_cast<const u8 *>(base);
+			m_flat_mask = rmask;
+		}
 	}
 }
 
@@ -28,7 +28,9 @@ public:
 
 	void set_device_rom_tag(const char *tag) { m_rom_tag = tag; }
 
-	inline u8 read_byte(offs_t byteaddress) { return m_r8(byteaddress); }
+	// the flat pointer is populated by set_rom for plain 8-bit roms so that
+	// per-sample fetches in the wavetable cores bypass the dispatch entirely
+	inline u8 read_byte(offs_t byteaddress) { if(m_flat_base) return m_flat_base[byteaddress & m_flat_mask]; return m_r8(byteaddress); }
 	inline u16 read_word(offs_t byteaddress) { return m_r16(byteaddress); }
 	inline u32 read_dword(offs_t byteaddress) { return m_r32(byteaddress); }
 	inline u64 read_qword(offs_t byteaddress) { return m_r64(byteaddress); }
@@ -55,6 +57,11 @@ private:
 	memory_bank *m_bank;
 	int m_cur_bank, m_bank_count;
 
+	const u8 *m_flat_base;  // direct pointer into the current bank, or nullptr when dispatch is required
+	const u8 *m_flat_rom;   // direct pointer to the start of the rom, or nullptr
+	offs_t m_flat_mask;     // mirror mask applied before indexing
+	u32 m_flat_span;        // size of one bank in bytes
+
 	virtual void interface_pre_start() override;
 	virtual void interface_post_load() override;
 };
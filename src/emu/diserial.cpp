@@ -216,8 +216,9 @@ WRITE_LINE_MEMBER(device_serial_interface::rx_w)
 	{
 		//device().logerror("Receiver is synchronized\n");
 		if(m_rcv_clock && !(m_rcv_rate.is_never()))
-			// make start delay just a bit longer to make sure we are called after the sender
-			m_rcv_clock->adjust(((m_rcv_rate*3)/2), 0, m_rcv_rate);
+			// make start delay just a bit longer to make sure we are called after the sender;
+			// the timer ticks once per bit with both clock phases synthesized on delivery
+			m_rcv_clock->adjust(((m_rcv_rate*5)/2), 0, m_rcv_rate*2);
 		else if(m_start_bit_hack_for_external_clocks)
 			m_rcv_bit_count_received--;
 	}
@@ -369,8 +370,9 @@ void device_serial_interface::transmit_register_setup(u8 data_byte)
 	int i;
 	unsigned char transmit_data;
 
+	// one timer tick per bit; both clock phases are synthesized on delivery
 	if(m_tra_clock && !m_tra_rate.is_never())
-		m_tra_clock->adjust(m_tra_rate, 0, m_tra_rate);
+		m_tra_clock->adjust(m_tra_rate, 0, m_tra_rate*2);
 
 	m_tra_bit_count_transmitted = 0;
 	m_tra_bit_count = 0;
@@ -129,8 +129,12 @@ protected:
 	const char *stop_bits_tostring(stop_bits_t stop_bits);
 
 private:
-	TIMER_CALLBACK_MEMBER(rcv_clock) { rx_clock_w(!m_rcv_clock_state); }
-	TIMER_CALLBACK_MEMBER(tra_clock) { tx_clock_w(!m_tra_clock_state); }
+	// internal timers fire once per bit and synthesize both clock phases
+	// at the active edge; only the active edge does any work, so this
+	// halves the scheduler traffic without moving a single transition.
+	// external clocks still arrive edge by edge through {rx,tx}_clock_w.
+	TIMER_CALLBACK_MEMBER(rcv_clock) { rx_clock_w(1); rx_clock_w(0); }
+	TIMER_CALLBACK_MEMBER(tra_clock) { tx_clock_w(0); tx_clock_w(1); }
 
 	u8 m_serial_parity_table[256];
 
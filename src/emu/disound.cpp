@@ -403,6 +403,14 @@ void device_mixer_interface::interface_pre_start()
 		}
 	}
 
+	// group inputs by the output they feed so the update handler can pick
+	// a mix kernel specialized for each output's input count
+	m_mix_inputs.clear();
+	m_mix_inputs.resize(m_outputs);
+	for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
+		if (m_outputmap[inp] < m_outputs)
+			m_mix_inputs[m_outputmap[inp]].push_back(inp);
+
 	// allocate the mixer stream
 	m_mixer_stream = stream_alloc(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate());
 }
@@ -430,18 +438,58 @@ void device_mixer_interface::interface_post_load()
 //  mixer_update - mix all inputs to one output
 //-------------------------------------------------
 
+namespace {
+
+// mix kernel specialized on the input count; the fixed trip count lets the
+// compiler unroll and vectorize the sum, and the direct store replaces the
+// clear-then-accumulate of the generic path
+template <int Inputs>
+void mix_inputs(stream_sample_t *out, stream_sample_t const *const *in, int samples)
+{
+	for (int pos = 0; pos < samples; pos++)
+	{
+		stream_sample_t sum = in[0][pos];
+		for (int i = 1; i < Inputs; i++)
+			sum += in[i][pos];
+		out[pos] = sum;
+	}
+}
+
+} // anonymous namespace
+
 void device_mixer_interface::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
 {
-	// clear output buffers
+	// mix each output from its own input set, grouped at stream-graph
+	// build time; the dominant configurations get specialized kernels
 	for (int output = 0; output < m_outputs; output++)
-		memset(outputs[output], 0, samples * sizeof(outputs[0][0]));
-
-	// loop over samples
-	const u8 *outmap = &m_outputmap[0];
-	for (int pos = 0; pos < samples; pos++)
 	{
-		// for each input, add it to the appropriate output
-		for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
-			outputs[outmap[inp]][pos] += inputs[inp][pos];
+		auto const &plan = m_mix_inputs[output];
+		stream_sample_t *const out = outputs[output];
+		int const count = plan.size();
+
+		if (count >= 1 && count <= 4)
+		{
+			stream_sample_t const *in[4];
+			for (int i = 0; i < count; i++)
+				in[i] = inputs[plan[i]];
+			switch (count)
+			{
+			case 1: mix_inputs<1>(out, in, samples); break;
+			case 2: mix_inputs<2>(out, in, samples); break;
+			case 3: mix_inputs<3>(out, in, samples); break;
+			case 4: mix_inputs<4>(out, in, samples); break;
+			}
+		}
+		else
+		{
+			// generic path for empty or unusually wide outputs
+			memset(out, 0, samples * sizeof(*out));
+			for (int i = 0; i < count; i++)
+			{
+				stream_sample_t const *const in = inputs[plan[i]];
+				for (int pos = 0; pos < samples; pos++)
+					out[pos] += in[pos];
+			}
+		}
 	}
 }
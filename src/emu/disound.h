@@ -135,6 +135,7 @@ protected:
 	// internal state
 	u8                  m_outputs;              // number of outputs
 	std::vector<u8>     m_outputmap;            // map of inputs to outputs
+	std::vector<std::vector<u16>> m_mix_inputs; // inputs feeding each output, grouped at stream-graph build time
 	sound_stream *      m_mixer_stream;         // mixing stream
 };
 
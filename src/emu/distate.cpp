@@ -551,6 +551,100 @@ void device_state_interface::set_state_string(int index, const char *string)
 }
 
 
+//-------------------------------------------------
+//  state_export_bulk - fill one u64 slot per
+//  non-divider entry, copying straight from the
+//  backing storage where there is one
+//-------------------------------------------------
+
+void device_state_interface::state_export_bulk(u64 *buffer)
+{
+	for (auto &item : m_bulk_list)
+	{
+		// call the exporter before we do anything
+		if (item.entry->needs_export())
+			state_export(*item.entry);
+
+		u64 value;
+		if (item.base != nullptr)
+		{
+			// direct entries copy from their storage; for floating-point
+			// entries this transfers the raw bit pattern
+			switch (item.size)
+			{
+				default:
+				case 1: value = *reinterpret_cast<u8 *>(item.base); break;
+				case 2: value = *reinterpret_cast<u16 *>(item.base); break;
+				case 4: value = *reinterpret_cast<u32 *>(item.base); break;
+				case 8: value = *reinterpret_cast<u64 *>(item.base); break;
+			}
+			if (!item.entry->is_float())
+				value &= item.mask;
+		}
+		else if (item.entry->is_float())
+		{
+			double dvalue = item.entry->dvalue();
+			memcpy(&value, &dvalue, sizeof(value));
+		}
+		else
+			value = item.entry->value();
+		*buffer++ = value;
+	}
+}
+
+
+//-------------------------------------------------
+//  state_import_bulk - write back one u64 slot
+//  per non-divider entry; the layout must match
+//  what state_export_bulk produces
+//-------------------------------------------------
+
+void device_state_interface::state_import_bulk(const u64 *buffer)
+{
+	for (auto &item : m_bulk_list)
+	{
+		u64 value = *buffer++;
+
+		// read-only entries keep their slot but are never written back
+		if (!item.entry->writeable())
+			continue;
+
+		if (item.entry->is_float())
+		{
+			if (item.base != nullptr && item.size == 8)
+				*reinterpret_cast<u64 *>(item.base) = value;
+			else
+			{
+				double dvalue;
+				memcpy(&dvalue, &value, sizeof(dvalue));
+				item.entry->set_dvalue(dvalue);
+			}
+		}
+		else if (item.base != nullptr)
+		{
+			// mirror set_value: apply the mask, then sign-extend on request
+			value &= item.mask;
+			if ((item.entry->m_flags & device_state_entry::DSF_IMPORT_SEXT) != 0 && value > (item.mask >> 1))
+				value |= ~item.mask;
+			switch (item.size)
+			{
+				default:
+				case 1: *reinterpret_cast<u8 *>(item.base) = u8(value); break;
+				case 2: *reinterpret_cast<u16 *>(item.base) = u16(value); break;
+				case 4: *reinterpret_cast<u32 *>(item.base) = u32(value); break;
+				case 8: *reinterpret_cast<u64 *>(item.base) = value; break;
+			}
+		}
+		else
+			item.entry->set_value(value);
+
+		// call the importer to finish up
+		if (item.entry->needs_import())
+			state_import(*item.entry);
+	}
+}
+
+
 //-------------------------------------------------
 //  state_add - add a new piece of indexed state
 //-------------------------------------------------
@@ -623,6 +717,11 @@ void device_state_interface::interface_post_start()
 	// make sure we got something during startup
 	if (m_state_list.size() == 0)
 		throw emu_fatalerror("No state registered for device '%s' that supports it!", m_device.tag());
+
+	// build the layout table for bulk binary access
+	for (auto &entry : m_state_list)
+		if (!entry->divider())
+			m_bulk_list.push_back(bulk_state_entry{ entry.get(), entry->dataptr(), entry->m_datamask, entry->m_datasize });
 }
 
 
@@ -250,6 +250,15 @@ public:
 	void set_state_string(int index, const char *string);
 	void set_pc(offs_t pc) { set_state_int(STATE_GENPC, pc); }
 
+	// bulk binary state access; one u64 slot per non-divider entry in
+	// registration order, so a full register-file capture avoids the
+	// per-entry lookup and string formatting machinery.  floating-point
+	// entries transfer their raw bit pattern
+	u32 state_bulk_count() const { return u32(m_bulk_list.size()); }
+	const device_state_entry &state_bulk_entry(u32 slot) const { return *m_bulk_list[slot].entry; }
+	void state_export_bulk(u64 *buffer);
+	void state_import_bulk(const u64 *buffer);
+
 	// deliberately ambiguous functions; if you have the state interface
 	// just use it directly
 	device_state_interface &state() { return *this; }
@@ -300,10 +309,20 @@ protected:
 	static constexpr int FAST_STATE_MIN = -4;                           // range for fast state
 	static constexpr int FAST_STATE_MAX = 256;                          // lookups
 
+	// layout record for bulk binary access, built at post-start
+	struct bulk_state_entry
+	{
+		device_state_entry *entry;          // underlying state entry
+		void *              base;           // direct backing storage, or nullptr for pseudo-registers
+		u64                 mask;           // data mask
+		u8                  size;           // size of the backing storage in bytes
+	};
+
 	// state
 	std::vector<std::unique_ptr<device_state_entry>>       m_state_list;           // head of state list
 	device_state_entry *                    m_fast_state[FAST_STATE_MAX + 1 - FAST_STATE_MIN];
 																	// fast access to common entries
+	std::vector<bulk_state_entry>           m_bulk_list;            // layout for bulk access
 };
 
 // iterator
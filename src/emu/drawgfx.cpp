@@ -365,7 +365,7 @@ void gfx_element::opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY);
+	DRAWGFX_CORE_REBASE16(drawgfx_simd_row_rebase_opaque16(destptr, srcptr, rowpixels, color), PIXEL_OP_REBASE_OPAQUE);
 }
 
 void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -408,7 +408,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_REBASE16(drawgfx_simd_row_rebase_transpen16(destptr, srcptr, rowpixels, color, trans_pen), PIXEL_OP_REBASE_TRANSPEN);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -457,7 +457,7 @@ void gfx_element::transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_REBASE16(drawgfx_simd_row_rebase_transpen16(destptr, srcptr, rowpixels, color, trans_pen), PIXEL_OP_REBASE_TRANSPEN);
 }
 
 void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -63,6 +63,92 @@ extern bitmap_ind8 drawgfx_dummy_priority_bitmap;
 #define PRIORITY_ADVANCE(t,p,i) do { if (PRIORITY_VALID(t)) (p) += (i); } while (0)
 
 
+/***************************************************************************
+    SIMD ROW HELPERS
+***************************************************************************/
+
+/* vectorize the hot 8bpp source -> 16bpp indexed destination rows on
+   platforms where SIMD support can be assumed */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define DRAWGFX_SIMD_ROWS (1)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DRAWGFX_SIMD_ROWS (1)
+#else
+#define DRAWGFX_SIMD_ROWS (0)
+#endif
+
+#if DRAWGFX_SIMD_ROWS
+
+/*-------------------------------------------------
+    drawgfx_simd_row_rebase_opaque16 - add
+    'color' to an un-flipped row of 8-bit pens
+    and store to a 16bpp indexed bitmap
+-------------------------------------------------*/
+
+static inline void drawgfx_simd_row_rebase_opaque16(u16 *destptr, const u8 *srcptr, u32 count, u32 color)
+{
+#if defined(__SSE2__) || defined(_MSC_VER)
+	const __m128i color16 = _mm_set1_epi16(u16(color));
+	const __m128i zero = _mm_setzero_si128();
+	for ( ; count >= 8; count -= 8, srcptr += 8, destptr += 8)
+	{
+		__m128i src16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(srcptr)), zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destptr), _mm_add_epi16(src16, color16));
+	}
+#else
+	const uint16x8_t color16 = vdupq_n_u16(u16(color));
+	for ( ; count >= 8; count -= 8, srcptr += 8, destptr += 8)
+		vst1q_u16(destptr, vaddq_u16(vmovl_u8(vld1_u8(srcptr)), color16));
+#endif
+	for ( ; count != 0; count--)
+		*destptr++ = color + *srcptr++;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_simd_row_rebase_transpen16 - same,
+    but leave destination pixels whose source
+    pen matches 'trans_pen' untouched
+-------------------------------------------------*/
+
+static inline void drawgfx_simd_row_rebase_transpen16(u16 *destptr, const u8 *srcptr, u32 count, u32 color, u32 trans_pen)
+{
+	// pens out of range can never match; draw opaque
+	if (trans_pen > 0xff)
+		return drawgfx_simd_row_rebase_opaque16(destptr, srcptr, count, color);
+
+#if defined(__SSE2__) || defined(_MSC_VER)
+	const __m128i color16 = _mm_set1_epi16(u16(color));
+	const __m128i trans16 = _mm_set1_epi16(u16(trans_pen));
+	const __m128i zero = _mm_setzero_si128();
+	for ( ; count >= 8; count -= 8, srcptr += 8, destptr += 8)
+	{
+		__m128i src16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(srcptr)), zero);
+		__m128i mask = _mm_cmpeq_epi16(src16, trans16);
+		__m128i result = _mm_add_epi16(src16, color16);
+		__m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destptr));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destptr), _mm_or_si128(_mm_and_si128(mask, dst), _mm_andnot_si128(mask, result)));
+	}
+#else
+	const uint16x8_t color16 = vdupq_n_u16(u16(color));
+	const uint16x8_t trans16 = vdupq_n_u16(u16(trans_pen));
+	for ( ; count >= 8; count -= 8, srcptr += 8, destptr += 8)
+	{
+		uint16x8_t src16 = vmovl_u8(vld1_u8(srcptr));
+		uint16x8_t mask = vceqq_u16(src16, trans16);
+		vst1q_u16(destptr, vbslq_u16(mask, vld1q_u16(destptr), vaddq_u16(src16, color16)));
+	}
+#endif
+	for ( ; count != 0; count--, srcptr++, destptr++)
+		if (*srcptr != trans_pen)
+			*destptr = color + *srcptr;
+}
+
+#endif // DRAWGFX_SIMD_ROWS
+
+
 /***************************************************************************
     PIXEL OPERATIONS
 ***************************************************************************/
@@ -548,6 +634,114 @@ do {
 
 
 
+/***************************************************************************
+    SIMD REBASE DRAWGFX CORE
+***************************************************************************/
+
+/*
+    Same contract as DRAWGFX_CORE with a u16 pixel type and no priority,
+    but blits each un-flipped row through a SIMD helper. ROW_CALL is an
+    expression invoking one of the drawgfx_simd_row_* helpers; within it,
+    'destptr', 'srcptr' and 'rowpixels' name the destination row, source
+    row and pixel count. X-flipped rendering (gathering bytes backwards)
+    falls back to the generic scalar core using PIXEL_OP.
+*/
+
+#if DRAWGFX_SIMD_ROWS
+
+#define DRAWGFX_CORE_REBASE16(ROW_CALL, PIXEL_OP)                                   \
+do {                                                                                \
+	if (flipx)                                                                      \
+	{                                                                               \
+		DRAWGFX_CORE(u16, PIXEL_OP, NO_PRIORITY);                                   \
+	}                                                                               \
+	else                                                                            \
+	{                                                                               \
+		g_profiler.start(PROFILER_DRAWGFX);                                         \
+		do {                                                                        \
+			const u8 *srcdata;                                                      \
+			s32 destendx, destendy;                                                 \
+			s32 srcx, srcy;                                                         \
+			s32 cury;                                                               \
+			s32 dy;                                                                 \
+																					\
+			assert(dest.valid());                                                   \
+			assert(dest.cliprect().contains(cliprect));                             \
+			assert(code < elements());                                              \
+																					\
+			/* ignore empty/invalid cliprects */                                    \
+			if (cliprect.empty())                                                   \
+				break;                                                              \
+																					\
+			/* compute final pixel in X and exit if we are entirely clipped */      \
+			destendx = destx + width() - 1;                                         \
+			if (destx > cliprect.right() || destendx < cliprect.left())             \
+				break;                                                              \
+																					\
+			/* apply left clip */                                                   \
+			srcx = 0;                                                               \
+			if (destx < cliprect.left())                                            \
+			{                                                                       \
+				srcx = cliprect.left() - destx;                                     \
+				destx = cliprect.left();                                            \
+			}                                                                       \
+																					\
+			/* apply right clip */                                                  \
+			if (destendx > cliprect.right())                                        \
+				destendx = cliprect.right();                                        \
+																					\
+			/* compute final pixel in Y and exit if we are entirely clipped */      \
+			destendy = desty + height() - 1;                                        \
+			if (desty > cliprect.bottom() || destendy < cliprect.top())             \
+				break;                                                              \
+																					\
+			/* apply top clip */                                                    \
+			srcy = 0;                                                               \
+			if (desty < cliprect.top())                                             \
+			{                                                                       \
+				srcy = cliprect.top() - desty;                                      \
+				desty = cliprect.top();                                             \
+			}                                                                       \
+																					\
+			/* apply bottom clip */                                                 \
+			if (destendy > cliprect.bottom())                                       \
+				destendy = cliprect.bottom();                                       \
+																					\
+			/* apply Y flipping */                                                  \
+			dy = rowbytes();                                                        \
+			if (flipy)                                                              \
+			{                                                                       \
+				srcy = height() - 1 - srcy;                                         \
+				dy = -dy;                                                           \
+			}                                                                       \
+																					\
+			/* fetch the source data */                                             \
+			srcdata = get_data(code);                                               \
+			srcdata += srcy * rowbytes() + srcx;                                    \
+																					\
+			/* iterate over pixels in Y, one whole row at a time */                 \
+			u32 rowpixels = destendx + 1 - destx;                                   \
+			for (cury = desty; cury <= destendy; cury++)                            \
+			{                                                                       \
+				u16 *destptr = &dest.pixt<u16>(cury, destx);                        \
+				const u8 *srcptr = srcdata;                                         \
+				srcdata += dy;                                                      \
+				ROW_CALL;                                                           \
+			}                                                                       \
+		} while (0);                                                                \
+		g_profiler.stop();                                                          \
+	}                                                                               \
+} while (0)
+
+#else
+
+#define DRAWGFX_CORE_REBASE16(ROW_CALL, PIXEL_OP)                                   \
+	DRAWGFX_CORE(u16, PIXEL_OP, NO_PRIORITY)
+
+#endif // DRAWGFX_SIMD_ROWS
+
+
+
 /***************************************************************************
     BASIC DRAWGFXZOOM CORE
 ***************************************************************************/
@@ -14,6 +14,8 @@
 
 #include <ctype.h>
 
+#include <unordered_map>
+
 
 
 //**************************************************************************
@@ -39,12 +41,29 @@ int driver_list::find(const char *name)
 	if (!name)
 		return -1;
 
-	// binary search to find it
-	game_driver const *const *const begin = s_drivers_sorted;
-	game_driver const *const *const end = begin + s_driver_count;
-	auto const cmp = [] (game_driver const *driver, char const *name) { return core_stricmp(driver->name, name) < 0; };
-	game_driver const *const *const result = std::lower_bound(begin, end, name, cmp);
-	return ((result == end) || core_stricmp((*result)->name, name)) ? -1 : std::distance(begin, result);
+	// the name index is built once on first lookup; driver names are
+	// lowercase by convention but lookups are case-insensitive, so keys are
+	// normalized to lowercase
+	static const std::unordered_map<std::string, int> s_name_index([] ()
+			{
+				std::unordered_map<std::string, int> index;
+				index.reserve(s_driver_count);
+				for (std::size_t drivernum = 0; drivernum < s_driver_count; drivernum++)
+				{
+					std::string key(s_drivers_sorted[drivernum]->name);
+					for (char &ch : key)
+						ch = tolower(u8(ch));
+					index.emplace(std::move(key), int(drivernum));
+				}
+				return index;
+			} ());
+
+	// hash lookup on the normalized name
+	std::string key(name);
+	for (char &ch : key)
+		ch = tolower(u8(ch));
+	auto const iter = s_name_index.find(key);
+	return (iter != s_name_index.end()) ? iter->second : -1;
 }
 
 
@@ -177,6 +196,15 @@ std::size_t driver_enumerator::filter(const char *filterstring)
 	// reset the count
 	exclude_all();
 
+	// a filter with no wildcards is an exact name and can use the index
+	if (filterstring != nullptr && strpbrk(filterstring, "*?") == nullptr)
+	{
+		int const found = find(filterstring);
+		if (found >= 0)
+			include(found);
+		return m_filtered_count;
+	}
+
 	// match name against each driver in the list
 	for (std::size_t index = 0; index < s_driver_count; index++)
 		if (matches(filterstring, s_drivers_sorted[index]->name))
@@ -196,10 +224,10 @@ std::size_t driver_enumerator::filter(const game_driver &driver)
 	// reset the count
 	exclude_all();
 
-	// match name against each driver in the list
-	for (std::size_t index = 0; index < s_driver_count; index++)
-		if (s_drivers_sorted[index] == &driver)
-			include(index);
+	// driver names are unique, so the index finds the one possible slot
+	int const found = find(driver);
+	if ((found >= 0) && (s_drivers_sorted[found] == &driver))
+		include(found);
 
 	return m_filtered_count;
 }
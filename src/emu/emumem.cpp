@@ -932,6 +932,29 @@ memory_bank *memory_manager::find(address_space &space, offs_t addrstart, offs_t
 	return nullptr;
 }
 
+//-------------------------------------------------
+//  track_dirty - install a write tap over a range
+//  that flags the corresponding 4K pages of a
+//  region, so syncers can skip clean pages
+//-------------------------------------------------
+
+memory_passthrough_handler *memory_manager::track_dirty(address_space &space, offs_t addrstart, offs_t addrend, memory_region &region, offs_t regionbase)
+{
+	region.enable_dirty_tracking();
+
+	std::string name = std::string("dirty:") + region.name();
+	const offs_t bytes = space.data_width() / 8;
+	auto mark = [&space, &region, regionbase, addrstart, bytes](offs_t offset) { region.mark_dirty(regionbase + space.address_to_byte(offset - addrstart), bytes); };
+	switch (space.data_width())
+	{
+	case 8:  return space.install_write_tap(addrstart, addrend, name, [mark](offs_t offset, u8  &data, u8  mem_mask) { mark(offset); });
+	case 16: return space.install_write_tap(addrstart, addrend, name, [mark](offs_t offset, u16 &data, u16 mem_mask) { mark(offset); });
+	case 32: return space.install_write_tap(addrstart, addrend, name, [mark](offs_t offset, u32 &data, u32 mem_mask) { mark(offset); });
+	case 64: return space.install_write_tap(addrstart, addrend, name, [mark](offs_t offset, u64 &data, u64 mem_mask) { mark(offset); });
+	default: fatalerror("Unsupported data width %d in track_dirty\n", space.data_width());
+	}
+}
+
 memory_bank *memory_manager::allocate(address_space &space, offs_t addrstart, offs_t addrend, const char *tag)
 {
 	auto bank = std::make_unique<memory_bank>(space, m_banklist.size(), addrstart, addrend, tag);
@@ -1025,6 +1048,7 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_logaddrchars((m_config.logaddr_width() + 3) / 4),
 		m_notifier_id(0),
 		m_in_notification(0),
+		m_runtime_modified(false),
 		m_manager(manager)
 {
 }
@@ -1042,6 +1066,25 @@ address_space::~address_space()
 	m_nop_w->unref();
 }
 
+//-------------------------------------------------
+//  note_runtime_modification - record that a
+//  handler changed after the static maps were
+//  populated; such installations are invisible
+//  to the parallel scheduling analysis
+//-------------------------------------------------
+
+void address_space::note_runtime_modification()
+{
+	// changes during initial population come from the static maps, which
+	// the analysis does see
+	if (!m_manager.m_initialized)
+		return;
+
+	m_runtime_modified = true;
+	m_device.machine().scheduler().invalidate_parallel_groups();
+}
+
+
 //-------------------------------------------------
 //  adjust_addresses - adjust addresses for a
 //  given address space in a standard fashion
@@ -2612,25 +2655,30 @@ template<int Width, int AddrShift, int Endian> memory_access_cache<Width, AddrSh
 																												  handler_entry_write<Width, AddrShift, Endian> *root_write)
 	: m_space(space),
 	  m_addrmask(space.addrmask()),
-	  m_addrstart_r(1),
-	  m_addrend_r(0),
-	  m_addrstart_w(1),
-	  m_addrend_w(0),
-	  m_cache_r(nullptr),
-	  m_cache_w(nullptr),
 	  m_root_read(root_read),
 	  m_root_write(root_write)
 {
+	for(int way = 0; way != WAYS; way++) {
+		m_addrstart_r[way] = 1;
+		m_addrend_r[way] = 0;
+		m_cache_r[way] = nullptr;
+		m_addrstart_w[way] = 1;
+		m_addrend_w[way] = 0;
+		m_cache_w[way] = nullptr;
+	}
+
 	m_notifier_id = space.add_change_notifier([this](read_or_write mode) {
-												  if(u32(mode) & u32(read_or_write::READ)) {
-													  m_addrend_r = 0;
-													  m_addrstart_r = 1;
-													  m_cache_r = nullptr;
-												  }
-												  if(u32(mode) & u32(read_or_write::WRITE)) {
-													  m_addrend_w = 0;
-													  m_addrstart_w = 1;
-													  m_cache_w = nullptr;
+												  for(int way = 0; way != WAYS; way++) {
+													  if(u32(mode) & u32(read_or_write::READ)) {
+														  m_addrend_r[way] = 0;
+														  m_addrstart_r[way] = 1;
+														  m_cache_r[way] = nullptr;
+													  }
+													  if(u32(mode) & u32(read_or_write::WRITE)) {
+														  m_addrend_w[way] = 0;
+														  m_addrstart_w[way] = 1;
+														  m_cache_w[way] = nullptr;
+													  }
 												  }
 											  });
 }
@@ -2901,9 +2949,54 @@ memory_region::memory_region(running_machine &machine, const char *name, u32 len
 	: m_machine(machine),
 		m_name(name),
 		m_buffer(length),
+		m_base(length > 0 ? &m_buffer[0] : nullptr),
+		m_length(length),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
 {
 	assert(width == 1 || width == 2 || width == 4 || width == 8);
 }
+
+
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+	if (m_releaser)
+		m_releaser();
+}
+
+
+//-------------------------------------------------
+//  adopt_storage - switch the backing store to
+//  externally allocated memory of the same
+//  length, freeing our own buffer
+//-------------------------------------------------
+
+void memory_region::adopt_storage(u8 *base, std::function<void ()> &&releaser)
+{
+	assert(base != nullptr);
+	assert(!m_releaser);
+
+	m_base = base;
+	m_releaser = std::move(releaser);
+
+	// our own buffer is dead weight now
+	std::vector<u8>().swap(m_buffer);
+}
+
+
+//-------------------------------------------------
+//  enable_dirty_tracking - allocate the per-page
+//  dirty map; pages start out dirty so the first
+//  scan after enabling sees everything
+//-------------------------------------------------
+
+void memory_region::enable_dirty_tracking()
+{
+	if (m_dirtymap.empty())
+		m_dirtymap.resize((m_buffer.size() + DIRTY_PAGE_SIZE - 1) >> DIRTY_PAGE_SHIFT, 1);
+}
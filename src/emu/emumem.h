@@ -19,6 +19,10 @@
 
 #include <type_traits>
 
+#if defined(__SSE2__) || (defined(_MSC_VER) && defined(_M_AMD64))
+#include <emmintrin.h>
+#endif
+
 using s8 = std::int8_t;
 using u8 = std::uint8_t;
 using s16 = std::int16_t;
@@ -539,9 +543,11 @@ template<> struct handler_entry_size<3> { using uX = u64; };
 
 constexpr int handler_entry_dispatch_lowbits(int highbits, int width, int ashift)
 {
+	// spaces of 16 bits or less get a single flat dispatch level; the table
+	// costs a few hundred KB per space but every access becomes one load
 	return (highbits > 48) ? 48 :
 		(highbits > 32) ? 32 :
-		(highbits > 14) ? 14 :
+		(highbits > 16) ? 14 :
 		width + ashift;
 }
 
@@ -1060,24 +1066,24 @@ public:
 	// getters
 	address_space &space() const { return m_space; }
 
-	// see if an address is within bounds, update it if not
-	void check_address_r(offs_t address) {
-		if(address >= m_addrstart_r && address <= m_addrend_r)
-			return;
-		m_root_read->lookup(address, m_addrstart_r, m_addrend_r, m_cache_r);
+	// see if an address is within the most-recently-used cached range;
+	// fall back to the other ways and then to a full lookup
+	handler_entry_read<Width, AddrShift, Endian> *check_address_r(offs_t address) {
+		if(address >= m_addrstart_r[0] && address <= m_addrend_r[0])
+			return m_cache_r[0];
+		return check_address_r_slow(address);
 	}
 
-	void check_address_w(offs_t address) {
-		if(address >= m_addrstart_w && address <= m_addrend_w)
-			return;
-		m_root_write->lookup(address, m_addrstart_w, m_addrend_w, m_cache_w);
+	handler_entry_write<Width, AddrShift, Endian> *check_address_w(offs_t address) {
+		if(address >= m_addrstart_w[0] && address <= m_addrend_w[0])
+			return m_cache_w[0];
+		return check_address_w_slow(address);
 	}
 
 	// accessor methods
 
 	void *read_ptr(offs_t address) {
-		check_address_r(address);
-		return m_cache_r->get_ptr(address);
+		return check_address_r(address)->get_ptr(address);
 	}
 
 	u8 read_byte(offs_t address) { address &= m_addrmask; return Width == 0 ? read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 0, true>([this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }, address, 0xff); }
@@ -1109,21 +1115,27 @@ public:
 	void write_qword_unaligned(offs_t address, u64 data, u64 mask) { address &= m_addrmask; memory_write_generic<Width, AddrShift, Endian, 3, false>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, data, mask); }
 
 private:
+	// number of cached ranges per direction; way 0 is most recently used
+	static constexpr int WAYS = 4;
+
 	address_space &             m_space;
 
 	int                         m_notifier_id;             // id to remove the notifier on destruction
 
 	offs_t                      m_addrmask;                // address mask
-	offs_t                      m_addrstart_r;             // minimum valid address for reading
-	offs_t                      m_addrend_r;               // maximum valid address for reading
-	offs_t                      m_addrstart_w;             // minimum valid address for writing
-	offs_t                      m_addrend_w;               // maximum valid address for writing
-	handler_entry_read<Width, AddrShift, Endian> *m_cache_r;   // read cache
-	handler_entry_write<Width, AddrShift, Endian> *m_cache_w;  // write cache
+	offs_t                      m_addrstart_r[WAYS];       // minimum valid addresses for reading
+	offs_t                      m_addrend_r[WAYS];         // maximum valid addresses for reading
+	offs_t                      m_addrstart_w[WAYS];       // minimum valid addresses for writing
+	offs_t                      m_addrend_w[WAYS];         // maximum valid addresses for writing
+	handler_entry_read<Width, AddrShift, Endian> *m_cache_r[WAYS];   // read caches
+	handler_entry_write<Width, AddrShift, Endian> *m_cache_w[WAYS];  // write caches
 
 	handler_entry_read <Width, AddrShift, Endian> *m_root_read;  // decode tree roots
 	handler_entry_write<Width, AddrShift, Endian> *m_root_write;
 
+	handler_entry_read <Width, AddrShift, Endian> *check_address_r_slow(offs_t address);
+	handler_entry_write<Width, AddrShift, Endian> *check_address_w_slow(offs_t address);
+
 	NativeType read_native(offs_t address, NativeType mask = ~NativeType(0));
 	void write_native(offs_t address, NativeType data, NativeType mask = ~NativeType(0));
 };
@@ -1206,6 +1218,7 @@ public:
 	const char *name() const { return m_name; }
 	int spacenum() const { return m_spacenum; }
 	address_map *map() const { return m_map.get(); }
+	bool runtime_modified() const { return m_runtime_modified; }
 
 	template<int Width, int AddrShift, int Endian> memory_access_cache<Width, AddrShift, Endian> *cache() {
 		if(AddrShift != m_config.addr_shift())
@@ -1223,6 +1236,8 @@ public:
 	void remove_change_notifier(int id);
 
 	void invalidate_caches(read_or_write mode) {
+		if(!m_runtime_modified)
+			note_runtime_modification();
 		if(u32(mode) & ~m_in_notification) {
 			u32 old = m_in_notification;
 			m_in_notification |= u32(mode);
@@ -1554,6 +1569,7 @@ protected:
 	void check_optimize_all(const char *function, int width, offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, offs_t addrselect, u64 unitmask, int cswidth, offs_t &nstart, offs_t &nend, offs_t &nmask, offs_t &nmirror, u64 &nunitmask, int &ncswidth);
 	void check_optimize_mirror(const char *function, offs_t addrstart, offs_t addrend, offs_t addrmirror, offs_t &nstart, offs_t &nend, offs_t &nmask, offs_t &nmirror);
 	void check_address(const char *function, offs_t addrstart, offs_t addrend);
+	void note_runtime_modification();
 
 	// private state
 	const address_space_config &m_config;       // configuration of this space
@@ -1579,6 +1595,7 @@ protected:
 	std::vector<notifier_t> m_notifiers;        // notifier list for address map change
 	int                     m_notifier_id;      // next notifier id
 	u32                     m_in_notification;  // notification(s) currently being done
+	bool                    m_runtime_modified; // handlers changed after initial map population?
 	memory_manager &        m_manager;          // reference to the owning manager
 };
 
@@ -1743,12 +1760,13 @@ class memory_region
 public:
 	// construction/destruction
 	memory_region(running_machine &machine, const char *name, u32 length, u8 width, endianness_t endian);
+	~memory_region();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	u8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	u8 *end() { return base() + m_buffer.size(); }
-	u32 bytes() const { return m_buffer.size(); }
+	u8 *base() { return m_base; }
+	u8 *end() { return m_base + m_length; }
+	u32 bytes() const { return m_length; }
 	const char *name() const { return m_name.c_str(); }
 
 	// flag expansion
@@ -1756,17 +1774,44 @@ public:
 	u8 bitwidth() const { return m_bitwidth; }
 	u8 bytewidth() const { return m_bytewidth; }
 
+	// adopt externally allocated storage (e.g. a shared mapping created
+	// by the ROM loader) as the backing store, releasing our own buffer;
+	// the releaser runs at destruction
+	void adopt_storage(u8 *base, std::function<void ()> &&releaser);
+
 	// data access
-	u8 &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	u8 &as_u8(offs_t offset = 0) { return m_base[offset]; }
 	u16 &as_u16(offs_t offset = 0) { return reinterpret_cast<u16 *>(base())[offset]; }
 	u32 &as_u32(offs_t offset = 0) { return reinterpret_cast<u32 *>(base())[offset]; }
 	u64 &as_u64(offs_t offset = 0) { return reinterpret_cast<u64 *>(base())[offset]; }
 
+	// dirty tracking, 4K pages; costs nothing until enabled, so
+	// consumers like the netsync block hasher opt in per region
+	static constexpr offs_t DIRTY_PAGE_SHIFT = 12;
+	static constexpr offs_t DIRTY_PAGE_SIZE = 1 << DIRTY_PAGE_SHIFT;
+
+	void enable_dirty_tracking();
+	bool dirty_tracking_enabled() const { return !m_dirtymap.empty(); }
+	u32 dirty_page_count() const { return u32(m_dirtymap.size()); }
+	bool page_dirty(u32 page) const { return m_dirtymap[page] != 0; }
+	void mark_dirty(offs_t offset, offs_t length = 1)
+	{
+		if (!m_dirtymap.empty())
+			for (offs_t page = offset >> DIRTY_PAGE_SHIFT, last = (offset + length - 1) >> DIRTY_PAGE_SHIFT; page <= last && page < m_dirtymap.size(); page++)
+				m_dirtymap[page] = 1;
+	}
+	void mark_all_dirty() { std::fill(m_dirtymap.begin(), m_dirtymap.end(), 1); }
+	void clear_dirty() { std::fill(m_dirtymap.begin(), m_dirtymap.end(), 0); }
+
 private:
 	// internal data
 	running_machine &       m_machine;
 	std::string             m_name;
 	std::vector<u8>         m_buffer;
+	u8 *                    m_base;         // backing store (our buffer, or adopted storage)
+	u32                     m_length;       // length of the backing store
+	std::function<void ()>  m_releaser;     // cleanup for adopted storage
+	std::vector<u8>         m_dirtymap;     // one flag per 4K page, empty while tracking is off
 	endianness_t            m_endianness;
 	u8                      m_bitwidth;
 	u8                      m_bytewidth;
@@ -1798,6 +1843,11 @@ public:
 	void region_free(const char *name);
 	memory_region *region_containing(const void *memory, offs_t bytes) const;
 
+	// dirty tracking; installs a write tap over [addrstart, addrend] that
+	// flags the corresponding 4K pages of the region, regionbase being the
+	// region byte offset mapped at addrstart
+	memory_passthrough_handler *track_dirty(address_space &space, offs_t addrstart, offs_t addrend, memory_region &region, offs_t regionbase = 0);
+
 	memory_bank *find(const char *tag) const;
 	memory_bank *find(address_space &space, offs_t addrstart, offs_t addrend) const;
 	memory_bank *allocate(address_space &space, offs_t addrstart, offs_t addrend, const char *tag = nullptr);
@@ -1917,14 +1967,94 @@ private:
 
 template<int Width, int AddrShift, int Endian> typename emu::detail::handler_entry_size<Width>::uX memory_access_cache<Width, AddrShift, Endian>::read_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX mask)
 {
-	check_address_r(address);
-	return m_cache_r->read(address, mask);
+	return check_address_r(address)->read(address, mask);
 }
 
 template<int Width, int AddrShift, int Endian> void memory_access_cache<Width, AddrShift, Endian>::write_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX data, typename emu::detail::handler_entry_size<Width>::uX mask)
 {
-	check_address_w(address);
-	m_cache_w->write(address, data, mask);
+	check_address_w(address)->write(address, data, mask);
+}
+
+template<int Width, int AddrShift, int Endian> handler_entry_read<Width, AddrShift, Endian> *memory_access_cache<Width, AddrShift, Endian>::check_address_r_slow(offs_t address)
+{
+	int way = -1;
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && defined(_M_AMD64))
+	// compare against all four ways at once; xor with the sign bit turns the
+	// unsigned range checks into signed ones
+	const __m128i bias = _mm_set1_epi32(0x80000000u);
+	const __m128i addr = _mm_xor_si128(_mm_set1_epi32(address), bias);
+	const __m128i start = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(m_addrstart_r)), bias);
+	const __m128i end = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(m_addrend_r)), bias);
+	const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(addr, start), _mm_cmpgt_epi32(addr, end));
+	int hits = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & ((1 << WAYS) - 1);
+	if(hits != 0)
+		for(way = 0; !(hits & (1 << way)); way++) { }
+#else
+	for(int scan = 1; scan != WAYS; scan++)
+		if(address >= m_addrstart_r[scan] && address <= m_addrend_r[scan]) {
+			way = scan;
+			break;
+		}
+#endif
+
+	if(way < 0) {
+		// miss everywhere; evict the least recently used way
+		way = WAYS - 1;
+		m_root_read->lookup(address, m_addrstart_r[way], m_addrend_r[way], m_cache_r[way]);
+	}
+
+	// rotate the hit way to the front
+	const offs_t hitstart = m_addrstart_r[way], hitend = m_addrend_r[way];
+	handler_entry_read<Width, AddrShift, Endian> *const hitcache = m_cache_r[way];
+	for(; way != 0; way--) {
+		m_addrstart_r[way] = m_addrstart_r[way - 1];
+		m_addrend_r[way] = m_addrend_r[way - 1];
+		m_cache_r[way] = m_cache_r[way - 1];
+	}
+	m_addrstart_r[0] = hitstart;
+	m_addrend_r[0] = hitend;
+	m_cache_r[0] = hitcache;
+	return hitcache;
+}
+
+template<int Width, int AddrShift, int Endian> handler_entry_write<Width, AddrShift, Endian> *memory_access_cache<Width, AddrShift, Endian>::check_address_w_slow(offs_t address)
+{
+	int way = -1;
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && defined(_M_AMD64))
+	const __m128i bias = _mm_set1_epi32(0x80000000u);
+	const __m128i addr = _mm_xor_si128(_mm_set1_epi32(address), bias);
+	const __m128i start = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(m_addrstart_w)), bias);
+	const __m128i end = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(m_addrend_w)), bias);
+	const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(addr, start), _mm_cmpgt_epi32(addr, end));
+	int hits = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & ((1 << WAYS) - 1);
+	if(hits != 0)
+		for(way = 0; !(hits & (1 << way)); way++) { }
+#else
+	for(int scan = 1; scan != WAYS; scan++)
+		if(address >= m_addrstart_w[scan] && address <= m_addrend_w[scan]) {
+			way = scan;
+			break;
+		}
+#endif
+
+	if(way < 0) {
+		way = WAYS - 1;
+		m_root_write->lookup(address, m_addrstart_w[way], m_addrend_w[way], m_cache_w[way]);
+	}
+
+	const offs_t hitstart = m_addrstart_w[way], hitend = m_addrend_w[way];
+	handler_entry_write<Width, AddrShift, Endian> *const hitcache = m_cache_w[way];
+	for(; way != 0; way--) {
+		m_addrstart_w[way] = m_addrstart_w[way - 1];
+		m_addrend_w[way] = m_addrend_w[way - 1];
+		m_cache_w[way] = m_cache_w[way - 1];
+	}
+	m_addrstart_w[0] = hitstart;
+	m_addrend_w[0] = hitend;
+	m_cache_w[0] = hitcache;
+	return hitcache;
 }
 
 void memory_passthrough_handler::remove()
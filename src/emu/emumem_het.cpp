@@ -2,6 +2,8 @@
 // copyright-holders:Olivier Galibert
 
 #include "emu.h"
+#include "emumem_hea.h"
+#include "emumem_hem.h"
 #include "emumem_hep.h"
 #include "emumem_het.h"
 
@@ -19,6 +21,10 @@ template<int Width, int AddrShift, int Endian> std::string handler_entry_read_ta
 
 template<int Width, int AddrShift, int Endian> handler_entry_read_tap<Width, AddrShift, Endian> *handler_entry_read_tap<Width, AddrShift, Endian>::instantiate(handler_entry_read<Width, AddrShift, Endian> *next) const
 {
+	// when the tap sits directly on memory, use the thunk with the
+	// non-virtual fall-through
+	if(dynamic_cast<handler_entry_read_memory<Width, AddrShift, Endian> *>(next))
+		return new handler_entry_read_tap_memory<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_name, m_tap);
 	return new handler_entry_read_tap<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_name, m_tap);
 }
 
@@ -37,10 +43,29 @@ template<int Width, int AddrShift, int Endian> std::string handler_entry_write_t
 
 template<int Width, int AddrShift, int Endian> handler_entry_write_tap<Width, AddrShift, Endian> *handler_entry_write_tap<Width, AddrShift, Endian>::instantiate(handler_entry_write<Width, AddrShift, Endian> *next) const
 {
+	// when the tap sits directly on memory, use the thunk with the
+	// non-virtual fall-through
+	if(dynamic_cast<handler_entry_write_memory<Width, AddrShift, Endian> *>(next))
+		return new handler_entry_write_tap_memory<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_name, m_tap);
 	return new handler_entry_write_tap<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_name, m_tap);
 }
 
 
+template<int Width, int AddrShift, int Endian> typename emu::detail::handler_entry_size<Width>::uX handler_entry_read_tap_memory<Width, AddrShift, Endian>::read(offs_t offset, uX mem_mask)
+{
+	uX data = static_cast<handler_entry_read_memory<Width, AddrShift, Endian> *>(inh::m_next)->handler_entry_read_memory<Width, AddrShift, Endian>::read(offset, mem_mask);
+	inh::m_tap(offset, data, mem_mask);
+	return data;
+}
+
+
+template<int Width, int AddrShift, int Endian> void handler_entry_write_tap_memory<Width, AddrShift, Endian>::write(offs_t offset, uX data, uX mem_mask)
+{
+	inh::m_tap(offset, data, mem_mask);
+	static_cast<handler_entry_write_memory<Width, AddrShift, Endian> *>(inh::m_next)->handler_entry_write_memory<Width, AddrShift, Endian>::write(offset, data, mem_mask);
+}
+
+
 
 template class handler_entry_read_tap<0,  0, ENDIANNESS_LITTLE>;
 template class handler_entry_read_tap<0,  0, ENDIANNESS_BIG>;
@@ -87,3 +112,49 @@ template class handler_entry_write_tap<3, -2, ENDIANNESS_LITTLE>;
 template class handler_entry_write_tap<3, -2, ENDIANNESS_BIG>;
 template class handler_entry_write_tap<3, -3, ENDIANNESS_LITTLE>;
 template class handler_entry_write_tap<3, -3, ENDIANNESS_BIG>;
+
+template class handler_entry_read_tap_memory<0,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<0,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<1,  3, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<1,  3, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<1,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<1,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<1, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<1, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<2,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<2,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<2, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<2, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<2, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<2, -2, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<3,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<3,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<3, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<3, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<3, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<3, -2, ENDIANNESS_BIG>;
+template class handler_entry_read_tap_memory<3, -3, ENDIANNESS_LITTLE>;
+template class handler_entry_read_tap_memory<3, -3, ENDIANNESS_BIG>;
+
+template class handler_entry_write_tap_memory<0,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<0,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<1,  3, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<1,  3, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<1,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<1,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<1, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<1, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<2,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<2,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<2, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<2, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<2, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<2, -2, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<3,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<3,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<3, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<3, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<3, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<3, -2, ENDIANNESS_BIG>;
+template class handler_entry_write_tap_memory<3, -3, ENDIANNESS_LITTLE>;
+template class handler_entry_write_tap_memory<3, -3, ENDIANNESS_BIG>;
@@ -48,3 +48,34 @@ protected:
 
 	handler_entry_write_tap(address_space *space, memory_passthrough_handler &mph, handler_entry_write<Width, AddrShift, Endian> *next, std::string name, std::function<void (offs_t offset, uX &data, uX mem_mask)> tap) : handler_entry_write_passthrough<Width, AddrShift, Endian>(space, mph, next), m_name(name), m_tap(tap) {}
 };
+
+
+// handler_entry_read_tap_memory/handler_entry_write_tap_memory
+
+// specialized thunks instantiated when the tapped subhandler is plain
+// memory; the fall-through access is a qualified, non-virtual call, so a
+// tap over RAM costs one indirect call instead of two
+
+template<int Width, int AddrShift, int Endian> class handler_entry_read_tap_memory : public handler_entry_read_tap<Width, AddrShift, Endian>
+{
+public:
+	using uX = typename emu::detail::handler_entry_size<Width>::uX;
+	using inh = handler_entry_read_tap<Width, AddrShift, Endian>;
+
+	handler_entry_read_tap_memory(address_space *space, memory_passthrough_handler &mph, handler_entry_read<Width, AddrShift, Endian> *next, std::string name, std::function<void (offs_t offset, uX &data, uX mem_mask)> tap) : inh(space, mph, next, name, tap) {}
+	~handler_entry_read_tap_memory() = default;
+
+	uX read(offs_t offset, uX mem_mask) override;
+};
+
+template<int Width, int AddrShift, int Endian> class handler_entry_write_tap_memory : public handler_entry_write_tap<Width, AddrShift, Endian>
+{
+public:
+	using uX = typename emu::detail::handler_entry_size<Width>::uX;
+	using inh = handler_entry_write_tap<Width, AddrShift, Endian>;
+
+	handler_entry_write_tap_memory(address_space *space, memory_passthrough_handler &mph, handler_entry_write<Width, AddrShift, Endian> *next, std::string name, std::function<void (offs_t offset, uX &data, uX mem_mask)> tap) : inh(space, mph, next, name, tap) {}
+	~handler_entry_write_tap_memory() = default;
+
+	void write(offs_t offset, uX data, uX mem_mask) override;
+};
@@ -67,6 +67,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",         OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
+	{ OPTION_REPLAY_RECORD,                              nullptr,     OPTION_STRING,     "record a compact replay event log with seekable checkpoints" },
+	{ OPTION_REPLAY_INTERVAL,                            "60",        OPTION_INTEGER,    "seconds of machine time between replay checkpoints" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         OPTION_BOOLEAN,    "close the program at the end of playback" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
@@ -84,10 +86,25 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOFRAMESKIP ";afs",                       "0",         OPTION_BOOLEAN,    "enable automatic frameskip selection" },
 	{ OPTION_FRAMESKIP ";fs(0-10)",                      "0",         OPTION_INTEGER,    "set frameskip to fixed value, 0-10 (autoframeskip must be disabled)" },
 	{ OPTION_SECONDS_TO_RUN ";str",                      "0",         OPTION_INTEGER,    "number of emulated seconds to run before automatically exiting" },
+	{ OPTION_FRAMES_TO_RUN ";ftr",                       "0",         OPTION_INTEGER,    "number of emulated frames to run before automatically exiting" },
+	{ OPTION_BENCH_JSON,                                 nullptr,     OPTION_STRING,     "write benchmark statistics (frame times, per-device cycle shares) to the given JSON file on exit" },
+	{ OPTION_BENCH_SUITE,                                nullptr,     OPTION_STRING,     "run every driver listed in the given file for frames_to_run frames each" },
+	{ OPTION_BENCH_REPORT,                               nullptr,     OPTION_STRING,     "append one CSV row of benchmark results per run to the given file, ranked at suite end" },
+	{ OPTION_WARMUP ";wu",                               "0",         OPTION_BOOLEAN,    "pre-decode all tilemaps before the first frame so measurements start warm (combine with drc_warm_cache)" },
+	{ OPTION_GOVERNOR ";gov",                            "0",         OPTION_BOOLEAN,    "shed visual fidelity in ranked stages (frameskip, scheduler quantum, artwork) to hold target speed" },
+	{ OPTION_ALLOC_REPORT,                               "0",         OPTION_BOOLEAN,    "track global_alloc usage per subsystem tag and report allocation rates on exit" },
+	{ OPTION_FRAME_PACING ";fp",                         "0",         OPTION_BOOLEAN,    "record frame pacing telemetry, show jitter percentiles in the speed overlay and release frames against the measured presentation cost" },
+	{ OPTION_LATENCY_PROBE ";latprobe",                  "0",         OPTION_BOOLEAN,    "flip a corner marker on input edges and log input-to-present latency" },
 	{ OPTION_THROTTLE,                                   "1",         OPTION_BOOLEAN,    "enable throttling to keep game running in sync with real time" },
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_PARALLEL_SCHEDULE ";psched",                "0",         OPTION_BOOLEAN,    "experimental: execute provably-independent CPUs on worker threads within a timeslice" },
+	{ OPTION_PARALLEL_SOUND ";psound",                   "0",         OPTION_BOOLEAN,    "experimental: update independent sound streams on worker threads" },
+	{ OPTION_ASYNC_SOUND_OUTPUT ";asound",               "0",         OPTION_BOOLEAN,    "experimental: submit mixed audio to the OSD from a dedicated thread" },
+	{ OPTION_POLYPHASE_RESAMPLE ";polyres",              "0",         OPTION_BOOLEAN,    "resample undersampled stream inputs through a precomputed polyphase sinc kernel" },
+	{ OPTION_ADAPTIVE_QUANTUM ";aq",                     "0",         OPTION_BOOLEAN,    "widen the scheduling quantum while CPUs are not communicating" },
+	{ OPTION_SHARE_REGIONS,                              "0",         OPTION_BOOLEAN,    "back identical ROM regions with named shared memory so concurrent instances of the same set load once and share pages" },
 
 	// render options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -195,6 +212,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_WARM_CACHE,                             "0",         OPTION_BOOLEAN,    "remember translated DRC blocks across runs and retranslate them at startup" },
 	{ OPTION_BIOS,                                       nullptr,     OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
@@ -205,6 +223,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_MOUSE,                                   "1",         OPTION_BOOLEAN,    "display ui mouse cursor" },
 	{ OPTION_LANGUAGE ";lang",                           "English",   OPTION_STRING,     "display language" },
 	{ OPTION_NVRAM_SAVE ";nvwrite",                      "1",         OPTION_BOOLEAN,    "save NVRAM on exit" },
+	{ OPTION_NVRAM_FLUSH_PERIOD ";nvflush",              "0",         OPTION_INTEGER,    "seconds between periodic flushes of changed NVRAM (0 = save only on exit)" },
+	{ OPTION_ROMDATA_CACHE ";romcache",                  "0",         OPTION_INTEGER,    "MB of ROM data kept in memory across sessions for warm restarts (0 = disabled)" },
 
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "SCRIPTING OPTIONS" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     OPTION_STRING,     "command to execute after machine boot" },
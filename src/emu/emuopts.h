@@ -56,6 +56,8 @@
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
+#define OPTION_REPLAY_RECORD        "replay_record"
+#define OPTION_REPLAY_INTERVAL      "replay_interval"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
@@ -71,10 +73,25 @@
 #define OPTION_AUTOFRAMESKIP        "autoframeskip"
 #define OPTION_FRAMESKIP            "frameskip"
 #define OPTION_SECONDS_TO_RUN       "seconds_to_run"
+#define OPTION_FRAMES_TO_RUN        "frames_to_run"
+#define OPTION_BENCH_JSON           "bench_json"
+#define OPTION_BENCH_SUITE          "bench_suite"
+#define OPTION_BENCH_REPORT         "bench_report"
+#define OPTION_WARMUP               "warmup"
+#define OPTION_GOVERNOR             "governor"
+#define OPTION_ALLOC_REPORT         "alloc_report"
+#define OPTION_FRAME_PACING         "frame_pacing"
+#define OPTION_LATENCY_PROBE        "latency_probe"
 #define OPTION_THROTTLE             "throttle"
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_PARALLEL_SCHEDULE    "parallel_schedule"
+#define OPTION_PARALLEL_SOUND       "parallel_sound"
+#define OPTION_ASYNC_SOUND_OUTPUT   "async_sound_output"
+#define OPTION_POLYPHASE_RESAMPLE   "polyphase_resample"
+#define OPTION_ADAPTIVE_QUANTUM     "adaptive_quantum"
+#define OPTION_SHARE_REGIONS        "share_regions"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -164,6 +181,7 @@
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_WARM_CACHE       "drc_warm_cache"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -171,6 +189,8 @@
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
 #define OPTION_NVRAM_SAVE           "nvram_save"
+#define OPTION_NVRAM_FLUSH_PERIOD   "nvram_flush_period"
+#define OPTION_ROMDATA_CACHE        "romdata_cache"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -349,6 +369,8 @@ public:
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
+	const char *replay_record() const { return value(OPTION_REPLAY_RECORD); }
+	int replay_interval() const { return int_value(OPTION_REPLAY_INTERVAL); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
@@ -364,10 +386,25 @@ public:
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
 	int frameskip() const { return int_value(OPTION_FRAMESKIP); }
 	int seconds_to_run() const { return int_value(OPTION_SECONDS_TO_RUN); }
+	int frames_to_run() const { return int_value(OPTION_FRAMES_TO_RUN); }
+	bool frame_pacing() const { return bool_value(OPTION_FRAME_PACING); }
+	bool latency_probe() const { return bool_value(OPTION_LATENCY_PROBE); }
+	const char *bench_json() const { return value(OPTION_BENCH_JSON); }
+	const char *bench_suite() const { return value(OPTION_BENCH_SUITE); }
+	const char *bench_report() const { return value(OPTION_BENCH_REPORT); }
+	bool warmup() const { return bool_value(OPTION_WARMUP); }
+	bool governor() const { return bool_value(OPTION_GOVERNOR); }
+	bool alloc_report() const { return bool_value(OPTION_ALLOC_REPORT); }
 	bool throttle() const { return bool_value(OPTION_THROTTLE); }
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool parallel_schedule() const { return bool_value(OPTION_PARALLEL_SCHEDULE); }
+	bool parallel_sound() const { return bool_value(OPTION_PARALLEL_SOUND); }
+	bool async_sound_output() const { return bool_value(OPTION_ASYNC_SOUND_OUTPUT); }
+	bool polyphase_resample() const { return bool_value(OPTION_POLYPHASE_RESAMPLE); }
+	bool adaptive_quantum() const { return bool_value(OPTION_ADAPTIVE_QUANTUM); }
+	bool share_regions() const { return bool_value(OPTION_SHARE_REGIONS); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -455,6 +492,7 @@ public:
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_warm_cache() const { return bool_value(OPTION_DRC_WARM_CACHE); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -462,6 +500,8 @@ public:
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
 	bool nvram_save() const { return bool_value(OPTION_NVRAM_SAVE); }
+	int nvram_flush_period() const { return int_value(OPTION_NVRAM_FLUSH_PERIOD); }
+	int romdata_cache() const { return int_value(OPTION_ROMDATA_CACHE); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
@@ -380,6 +380,22 @@ osd_file::error emu_file::open_ram(const void *data, u32 length)
 }
 
 
+//-------------------------------------------------
+//  open_ram_dynamic - open a growable "file"
+//  in RAM that supports writing
+//-------------------------------------------------
+
+osd_file::error emu_file::open_ram_dynamic()
+{
+	// set a fake filename and CRC
+	m_filename = "RAM";
+	m_crc = 0;
+
+	// use the core_file's built-in RAM support
+	return util::core_file::open_ram_dynamic(m_openflags, m_file);
+}
+
+
 //-------------------------------------------------
 //  close - close a file and free all data; also
 //  remove the file if requested
@@ -115,6 +115,7 @@ public:
 	osd_file::error open(const std::string &name1, const std::string &name2, const std::string &name3, const std::string &name4, u32 crc);
 	osd_file::error open_next();
 	osd_file::error open_ram(const void *data, u32 length);
+	osd_file::error open_ram_dynamic();
 	void close();
 
 	// control
@@ -1544,6 +1544,12 @@ ioport_value ioport_port::read()
 {
 	assert_always(manager().safe_to_read(), "Input ports cannot be read at init time!");
 
+	// ports with no dynamic or analog fields are fully determined by the
+	// digital state computed at frame update time, so repeated polls
+	// reduce to a load and xor
+	if (m_live->simple)
+		return m_live->digital ^ m_live->defvalue;
+
 	// start with the digital state
 	ioport_value result = m_live->digital;
 
@@ -1706,7 +1712,8 @@ void ioport_port::update_defvalue(bool flush_defaults)
 ioport_port_live::ioport_port_live(ioport_port &port)
 	: defvalue(0),
 		digital(0),
-		outputvalue(0)
+		outputvalue(0),
+		simple(false)
 {
 	// iterate over fields
 	for (ioport_field &field : port.fields())
@@ -1727,6 +1734,9 @@ ioport_port_live::ioport_port_live(ioport_port &port)
 		// let the field initialize its live state
 		field.init_live_state(analog);
 	}
+
+	// no dynamic reads and no analogs means reads can skip the list walks
+	simple = (readlist.first() == nullptr) && (analoglist.first() == nullptr);
 }
 
 
@@ -1744,6 +1754,7 @@ ioport_manager::ioport_manager(running_machine &machine)
 		m_safe_to_read(false),
 		m_last_frame_time(attotime::zero),
 		m_last_delta_nsec(0),
+		m_last_digital_hash(0),
 		m_record_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
 		m_playback_file(machine.options().input_directory(), OPEN_FLAG_READ),
 		m_playback_accumulated_speed(0),
@@ -1751,6 +1762,10 @@ ioport_manager::ioport_manager(running_machine &machine)
 		m_timecode_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
 		m_timecode_count(0),
 		m_timecode_last_time(attotime::zero),
+		m_replay_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
+		m_replay_index_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
+		m_replay_frame(0),
+		m_replay_frame_written(false),
 		m_autofire_toggle(false),
 		m_autofire_delay(3)                 // 1 seems too fast for a bunch of games
 {
@@ -1941,6 +1956,7 @@ time_t ioport_manager::initialize()
 	// open playback and record files if specified
 	time_t basetime = playback_init();
 	record_init();
+	replay_record_init();
 	timecode_init();
 	return basetime;
 }
@@ -2023,6 +2039,7 @@ void ioport_manager::exit()
 	// close any playback or recording files
 	playback_end();
 	record_end();
+	replay_record_end();
 	timecode_end();
 }
 
@@ -2220,6 +2237,7 @@ g_profiler.start(PROFILER_INPUT);
 	attotime curtime = machine().machine_time();
 	playback_frame(curtime);
 	record_frame(curtime);
+	replay_record_frame(curtime);
 
 	// track the duration of the previous frame
 	m_last_delta_nsec = (curtime - m_last_frame_time).as_attoseconds() / ATTOSECONDS_PER_NANOSECOND;
@@ -2250,6 +2268,21 @@ g_profiler.start(PROFILER_INPUT);
     }
   }
 
+	// feed the video manager's latency probe on any digital edge; the probe
+	// only records host timestamps and draws a UI marker, so it has no
+	// effect on emulated state or determinism
+	if (machine().video().latency_probe_enabled())
+	{
+		ioport_value digital_hash = 0;
+		for (auto &port : m_portlist)
+			digital_hash = (digital_hash * 31) ^ port.second->read();
+		if (digital_hash != m_last_digital_hash)
+		{
+			m_last_digital_hash = digital_hash;
+			machine().video().latency_input_edge();
+		}
+	}
+
 	inputState.add_players(netCommon->getPlayer());
 
   attotime curMachineTime = machine().machine_time();
@@ -2257,8 +2290,11 @@ g_profiler.start(PROFILER_INPUT);
 
   if(netCommon) {
     bool rollback = netCommon->isRollback();
-    // Calculate the time that the new inputs will take effect
-    int delayFromPing=100;
+    // Calculate the time that the new inputs will take effect.  The floor
+    // is one frame so a LAN session isn't stuck paying WAN-sized delays;
+    // getLargestPing tracks per-peer jitter percentiles and only moves
+    // when the network actually changes.
+    int delayFromPing=17;
     delayFromPing = max(delayFromPing,min(600,netCommon->getLargestPing(curMachineTime.seconds())/2));
     attoseconds_t attosecondsToLead = 0;
     if (!rollback) {
@@ -2311,6 +2347,7 @@ g_profiler.start(PROFILER_INPUT);
 
     // handle record
     record_port(*port);
+    replay_record_port(*port, portIndex);
 
 		// call device line write handlers
 		ioport_value newvalue = port->read();
@@ -2416,8 +2453,12 @@ std::vector<nsm::InputState> ioport_manager::fetch_remote_inputs(attotime curMac
   framesSinceDelayCheck++;
   attotime checkInputTime = curMachineTime;
   if (rollback) {
-    // Only make sure we have inputs from at least a second ago
-    checkInputTime -= attotime(1,0);
+    // Only block on inputs older than the rollback window.  The window
+    // scales with the measured ping (twice the round trip, clamped) so a
+    // LAN game stalls on a ~quarter second instead of a full second; the
+    // snapshot ring in the main loop still holds a second of history.
+    int windowMs = min(999, max(250, netCommon->getLargestPing(curMachineTime.seconds())*2));
+    checkInputTime -= attotime(0, windowMs*ATTOSECONDS_PER_MILLISECOND);
   }
   pollForPeerCatchup(checkInputTime);
 	int64_t checkInputTimeMs = checkInputTime.to_msec();
@@ -2429,8 +2470,20 @@ std::vector<nsm::InputState> ioport_manager::fetch_remote_inputs(attotime curMac
 			// Peer hasn't started yet
 			continue;
 		}
-		auto optionalIs = it.second.get(checkInputTimeMs, 0);
+		int64_t fetchTimeMs = checkInputTimeMs;
+		if (rollback) {
+			// Predict by holding the most recent input we have actually seen
+			// from this peer (staying just inside the last span it covers); a
+			// misprediction triggers a rollback when the real input arrives.
+			fetchTimeMs = min(curMachineTime.to_msec(), it.second.getCurrentTime() - 1);
+		}
+		auto optionalIs = it.second.get(fetchTimeMs, 0);
 		if (!optionalIs) {
+			if (rollback) {
+				// Nothing from this peer at the predicted time yet; treat it
+				// as neutral until an input shows up.
+				continue;
+			}
 			cout << "Tried to get an input state but one didn't exist\n";
 			::exit(1);
 		}
@@ -3397,6 +3450,196 @@ void ioport_manager::record_port(ioport_port &port)
 }
 
 
+//-------------------------------------------------
+//  replay_write - write raw bytes to the replay
+//  log, ending the recording if the disk is full
+//-------------------------------------------------
+
+// Replay event log records; the log is a frame marker followed by the
+// events that happened on that frame.  Frames without events cost nothing.
+static const u8 REPLAY_EVENT_FRAME = 0;        // u64 frame, s32 seconds, s64 attoseconds
+static const u8 REPLAY_EVENT_PORT = 1;         // u32 port index, u32 size, port state
+static const u8 REPLAY_EVENT_CHECKPOINT = 2;   // u32 size, flat save state
+
+void ioport_manager::replay_write(const void *data, u32 size)
+{
+	if (!m_replay_file.is_open())
+		return;
+
+	if (m_replay_file.write(data, size) != size)
+		replay_record_end("Out of space");
+}
+
+
+//-------------------------------------------------
+//  replay_record_init - open the replay event
+//  log and its checkpoint index
+//-------------------------------------------------
+
+void ioport_manager::replay_record_init()
+{
+	// if no file, nothing to do
+	const char *filename = machine().options().replay_record();
+	if (filename[0] == 0)
+		return;
+
+	// open the log; no compression so index offsets stay seekable
+	osd_file::error filerr = m_replay_file.open(filename);
+	assert_always(filerr == osd_file::error::NONE, "Failed to open file for replay recording");
+
+	std::string indexname;
+	indexname.append(filename).append(".idx");
+	filerr = m_replay_index_file.open(indexname.c_str());
+	assert_always(filerr == osd_file::error::NONE, "Failed to open replay index file");
+
+	// header: magic, version, system name
+	static const u8 magic[8] = { 'M', 'A', 'M', 'E', 'R', 'P', 'L', 'Y' };
+	replay_write(magic, sizeof(magic));
+	u32 version = 1;
+	replay_write(&version, sizeof(version));
+	char sysname[16] = { 0 };
+	strncpy(sysname, machine().system().name, sizeof(sysname) - 1);
+	replay_write(sysname, sizeof(sysname));
+
+	m_replay_frame = 0;
+	m_replay_frame_written = false;
+	m_replay_next_checkpoint = machine().time();
+}
+
+
+//-------------------------------------------------
+//  replay_record_end - end replay recording
+//-------------------------------------------------
+
+void ioport_manager::replay_record_end(const char *message)
+{
+	// only applies if we have a live file
+	if (m_replay_file.is_open())
+	{
+		m_replay_file.close();
+		m_replay_index_file.close();
+		m_replay_last_state.clear();
+
+		// pop a message
+		if (message != nullptr)
+			machine().popmessage("Replay Recording Ended\nReason: %s", message);
+	}
+}
+
+
+//-------------------------------------------------
+//  replay_record_frame - start of frame callback
+//  for replay recording
+//-------------------------------------------------
+
+void ioport_manager::replay_record_frame(const attotime &curtime)
+{
+	if (!m_replay_file.is_open())
+		return;
+
+	// the frame marker is written lazily when the first event lands, so
+	// quiet frames take no space at all
+	m_replay_frame++;
+	m_replay_frame_written = false;
+	m_replay_frame_time = curtime;
+
+	// periodic self-contained checkpoint; the index records where it
+	// lives so a seek is one load plus a short event replay
+	if (curtime >= m_replay_next_checkpoint)
+	{
+		// the frame marker must precede the checkpoint record
+		replay_write(&REPLAY_EVENT_FRAME, sizeof(u8));
+		replay_write(&m_replay_frame, sizeof(m_replay_frame));
+		s32 seconds = curtime.seconds();
+		s64 attoseconds = curtime.attoseconds();
+		replay_write(&seconds, sizeof(seconds));
+		replay_write(&attoseconds, sizeof(attoseconds));
+		m_replay_frame_written = true;
+
+		u64 offset = m_replay_file.tell();
+
+		size_t size = machine().save().binary_size();
+		std::vector<u8> state(size);
+		if (machine().save().save_binary(&state[0], size) == STATERR_NONE)
+		{
+			replay_write(&REPLAY_EVENT_CHECKPOINT, sizeof(u8));
+			u32 size32 = u32(size);
+			replay_write(&size32, sizeof(size32));
+			replay_write(&state[0], size32);
+
+			// index record: frame, log offset, machine time
+			if (m_replay_index_file.is_open())
+			{
+				m_replay_index_file.write(&m_replay_frame, sizeof(m_replay_frame));
+				m_replay_index_file.write(&offset, sizeof(offset));
+				m_replay_index_file.write(&seconds, sizeof(seconds));
+				m_replay_index_file.write(&attoseconds, sizeof(attoseconds));
+			}
+		}
+
+		int interval = machine().options().replay_interval();
+		m_replay_next_checkpoint = curtime + attotime(interval < 1 ? 1 : interval, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  replay_record_port - emit a port event when
+//  its state differs from the last one recorded
+//-------------------------------------------------
+
+void ioport_manager::replay_record_port(ioport_port &port, int portIndex)
+{
+	if (!m_replay_file.is_open())
+		return;
+
+	// build the port state tuple: the same values INP records per frame
+	std::vector<u8> &scratch = m_replay_scratch;
+	scratch.clear();
+	auto append = [&scratch] (const void *data, size_t size)
+	{
+		const u8 *bytes = reinterpret_cast<const u8 *>(data);
+		scratch.insert(scratch.end(), bytes, bytes + size);
+	};
+	append(&port.live().defvalue, sizeof(port.live().defvalue));
+	append(&port.live().digital, sizeof(port.live().digital));
+	for (analog_field &analog : port.live().analoglist)
+	{
+		append(&analog.m_accum, sizeof(analog.m_accum));
+		append(&analog.m_previous, sizeof(analog.m_previous));
+		append(&analog.m_sensitivity, sizeof(analog.m_sensitivity));
+		u8 reverse = analog.m_reverse ? 1 : 0;
+		append(&reverse, sizeof(reverse));
+	}
+
+	// only a change produces an event
+	if (portIndex < int(m_replay_last_state.size()) && m_replay_last_state[portIndex] == scratch)
+		return;
+	if (portIndex >= int(m_replay_last_state.size()))
+		m_replay_last_state.resize(portIndex + 1);
+	m_replay_last_state[portIndex] = scratch;
+
+	// lazily emit the frame marker for the first event this frame
+	if (!m_replay_frame_written)
+	{
+		replay_write(&REPLAY_EVENT_FRAME, sizeof(u8));
+		replay_write(&m_replay_frame, sizeof(m_replay_frame));
+		s32 seconds = m_replay_frame_time.seconds();
+		s64 attoseconds = m_replay_frame_time.attoseconds();
+		replay_write(&seconds, sizeof(seconds));
+		replay_write(&attoseconds, sizeof(attoseconds));
+		m_replay_frame_written = true;
+	}
+
+	replay_write(&REPLAY_EVENT_PORT, sizeof(u8));
+	u32 index32 = u32(portIndex);
+	replay_write(&index32, sizeof(index32));
+	u32 size32 = u32(scratch.size());
+	replay_write(&size32, sizeof(size32));
+	replay_write(&scratch[0], size32);
+}
+
+
 
 //**************************************************************************
 //  I/O PORT CONFIGURER
@@ -1371,6 +1371,7 @@ struct ioport_port_live
 	ioport_value            defvalue;           // combined default value across the port
 	ioport_value            digital;            // current value from all digital inputs
 	ioport_value            outputvalue;        // current value for outputs
+	bool                    simple;             // no dynamic or analog fields, so reads need no list walk
 };
 
 
@@ -1460,6 +1461,12 @@ private:
 	void record_frame(const attotime &curtime);
 	void record_port(ioport_port &port);
 
+	void replay_write(const void *data, u32 size);
+	void replay_record_init();
+	void replay_record_end(const char *message = nullptr);
+	void replay_record_frame(const attotime &curtime);
+	void replay_record_port(ioport_port &port, int portIndex);
+
 	template<typename _Type> void timecode_write(_Type value);
 	void timecode_init();
 	void timecode_end(const char *message = nullptr);
@@ -1480,6 +1487,7 @@ private:
 	// frame time tracking
 	attotime                m_last_frame_time;      // time of the last frame callback
 	attoseconds_t           m_last_delta_nsec;      // nanoseconds that passed since the previous callback
+	ioport_value            m_last_digital_hash;    // hash of the digital inputs as of the last frame
 
 	// playback/record information
 	emu_file                m_record_file;          // recording file (nullptr if not recording)
@@ -1490,6 +1498,16 @@ private:
 	int                     m_timecode_count;
 	attotime                m_timecode_last_time;
 
+	// compact replay event log: port deltas plus periodic checkpoints
+	emu_file                m_replay_file;          // replay event log (closed if not recording)
+	emu_file                m_replay_index_file;    // checkpoint index for seeking
+	u64                     m_replay_frame;         // current frame number
+	bool                    m_replay_frame_written; // frame marker emitted for this frame?
+	attotime                m_replay_frame_time;    // machine time of the current frame
+	attotime                m_replay_next_checkpoint; // checkpoint due at/after this time
+	std::vector<std::vector<u8> > m_replay_last_state; // last emitted state per port
+	std::vector<u8>         m_replay_scratch;       // current port state being built
+
 	// autofire
 	bool                    m_autofire_toggle;      // autofire toggle
 	int                     m_autofire_delay;       // autofire delay
@@ -122,6 +122,7 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_hard_reset_pending(false),
 		m_exit_pending(false),
 		m_soft_reset_timer(nullptr),
+		m_nvram_flush_timer(nullptr),
 		m_rand_seed(0x9d14abd7),
 		m_ui_active(_config.options().ui_active()),
 		m_basename(_config.gamedrv().name),
@@ -135,7 +136,14 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_ioport(*this),
 		m_parameters(*this),
 		m_scheduler(*this),
-		m_dummy_space(_config, "dummy_space", &root_device(), 0)
+		m_dummy_space(_config, "dummy_space", &root_device(), 0),
+		m_rollback_next_snapshot(attotime::zero),
+		m_rollback_snapshot_ticks(0),
+		m_rollback_resim_ticks(0),
+		m_rollback_snapshot_count(0),
+		m_rollback_count(0),
+		m_rollback_missed_count(0),
+		m_rollback_delta_bytes(0)
 {
 	memset(&m_base_time, 0, sizeof(m_base_time));
 
@@ -290,9 +298,19 @@ void running_machine::start()
 	if (savegame[0] != 0)
 		schedule_load(savegame);
 
-	// if we're in autosave mode, schedule a load
+	// if we're in autosave mode, schedule a load and start the rolling
+	// background autosave that keeps the file fresh from then on
 	else if (options().autosave() && (m_system.flags & MACHINE_SUPPORTS_SAVE) != 0)
+	{
 		schedule_load("auto");
+		m_save.autosave()->start();
+	}
+
+	// decode all tilemaps up front when warm starts are requested, so the
+	// first measured frames are not dominated by decode cost; DRC cores
+	// replay their own warm caches when they first execute
+	if (options().warmup())
+		m_tilemap->pretouch_all();
 
 	manager().update_machine();
 }
@@ -335,6 +353,20 @@ void running_machine::processNetworkBuffer(PeerInputData *inputData,int peerID)
 						cout << "unexpected time " << currentTime << " " << inputTime << " " << peerID << "\n";
 						exit(1);
 			}
+			if (netCommon->isRollback() && peerID != netCommon->getSelfPeerID() &&
+			    inputTime <= m_machine_time.to_msec()) {
+				// We already ran this span holding the peer's previous input; if
+				// the real input differs, every frame since then is suspect and
+				// must be re-simulated.
+				auto predicted = onePlayerInputData.get(currentTime - 1, 0);
+				if (!predicted || predicted->SerializeAsString() != inputData->inputstate().SerializeAsString()) {
+					attotime divergeTime = attotime(currentTime / 1000, (currentTime % 1000) * ATTOSECONDS_PER_MILLISECOND);
+					if (!doRollback || divergeTime < rollbackTime) {
+						rollbackTime = divergeTime;
+					}
+					doRollback = true;
+				}
+			}
 			onePlayerInputData.put(currentTime, inputTime, {{0, inputData->inputstate()}});
     }
     else if(inputData->inputtype() == PeerInputData::CHAT)
@@ -405,9 +437,18 @@ int running_machine::run(bool quiet)
 			add_logerror_callback(std::bind(&running_machine::logfile_callback, this, _1));
 		}
 
+		// enable allocation tracking before anything interesting allocates
+		if (options().alloc_report())
+			memtrack::enabled() = true;
+
 		// then finish setting up our local machine
 		start();
 
+		// ROM and software loading is finished with the archive cache; drop
+		// any decoded 7z solid blocks it is still holding (they can run to
+		// hundreds of megabytes) while keeping the parsed indexes
+		util::archive_file::cache_trim();
+
 		// load the configuration settings
 		m_configuration->load_settings();
 
@@ -472,9 +513,23 @@ int running_machine::run(bool quiet)
 		// devices with timers.
 		m_save.allow_registration(false);
 
+    // Now that the save set is final, derive the netplay sync blocks
+    // from it; every peer runs the same driver so the lists line up.
+    m_save.create_network_blocks();
+
 		// load the NVRAM
 		nvram_load();
 
+		// if periodic NVRAM flushing is enabled, stagger the first flush so a
+		// fleet of instances started together does not hit the disk in lockstep
+		int const flush_period = options().nvram_flush_period();
+		if (flush_period > 0 && options().nvram_save())
+		{
+			m_nvram_flush_timer = m_scheduler.timer_alloc(timer_expired_delegate(FUNC(running_machine::nvram_flush), this));
+			attotime const period(flush_period, 0);
+			m_nvram_flush_timer->adjust(period + attotime(osd_ticks() % flush_period, 0), 0, period);
+		}
+
 		// set the time on RTCs (this may overwrite parts of NVRAM)
 		set_rtc_datetime(system_time(m_base_time));
 
@@ -506,8 +561,6 @@ int running_machine::run(bool quiet)
 
     emulationStartTime = std::chrono::system_clock::now();
 
-    u64 trackFrameNumber=0;
-
     attotime largestEmulationTime(0,0);
 
 		// run the CPUs until a reset or exit
@@ -552,6 +605,7 @@ int running_machine::run(bool quiet)
         tenthSecondPassed = secondPassed || ((machineTimeBefore.attoseconds()/(ATTOSECONDS_PER_SECOND/10ULL)) != (machineTimeAfter.attoseconds()/(ATTOSECONDS_PER_SECOND/10ULL)));
 
         if (netCommon) {
+          memtrack::tag_scope alloc_scope(memtrack::TAG_NET);
           // Process any remaining packets.
           if(!netCommon->update(this)) {
             cout << "NETWORK FAILED\n";
@@ -681,32 +735,92 @@ int running_machine::run(bool quiet)
 			if (timePassed && m_saveload_schedule != saveload_schedule::NONE) {
 				handle_saveload();
       } else if (timePassed && netCommon && netCommon->isRollback()) {
-				/*
-				We need to implement rollback without frame counts
-        if (trackFrameNumber>0 && m_scheduler.can_save() && trackFrameNumber != inputFrameNumber) {
-          isRollback = true;
-          immediate_save("test");
-          cout << "SAVING AT TIME " << m_machine_time << endl;
-          isRollback = false;
-          trackFrameNumber=0;
-        }
-        if(m_machine_time.seconds()>0 && m_scheduler.can_save() && tenthSecondPassed) {
-          cout << "Tenth second passed: " << m_machine_time << endl;
-          if (secondPassed) {
-            cout << "Second passed" << endl;
-          }
-          trackFrameNumber = inputFrameNumber;
-        }
+        // GGPO-style rollback: snapshot the machine into reusable delta
+        // states at roughly frame rate, and when a remote input lands in
+        // a span we already ran with a predicted input, reload the newest
+        // snapshot at or before that input and re-simulate.
         if(m_machine_time.seconds()>0 && m_scheduler.can_save()) {
+          // Deltas diff against a one-time base capture; items that never
+          // change after startup cost nothing per frame
+          if (!m_save.has_incremental_base()) {
+            isRollback = true;
+            m_save.capture_incremental_base();
+            isRollback = false;
+          }
           if (doRollback) {
             doRollback = false;
+            // Find the newest snapshot at or before the offending input
+            int stateIndex = -1;
+            for (int a = 0; a < int(m_rollback_states.size()); a++) {
+              if (m_rollback_states[a]->m_valid && m_rollback_states[a]->m_time <= rollbackTime) {
+                stateIndex = a;
+              }
+            }
+            if (stateIndex == -1) {
+              // The input predates our snapshot window; the periodic
+              // server sync will repair any divergence.
+              m_rollback_missed_count++;
+              cout << "NO SNAPSHOT OLD ENOUGH FOR ROLLBACK TO " << rollbackTime.seconds() << "." << rollbackTime.attoseconds() << endl;
+            } else {
+              osd_ticks_t startTicks = osd_ticks();
+              attotime resimAmount = m_machine_time - m_rollback_states[stateIndex]->m_time;
+              isRollback = true;
+              save_error loaderr = m_rollback_states[stateIndex]->load();
+              isRollback = false;
+              if (loaderr != STATERR_NONE) {
+                cout << "ROLLBACK LOAD FAILED (" << int(loaderr) << ")" << endl;
+              } else {
+                m_machine_time = m_rollback_states[stateIndex]->m_time;
+                m_rollback_next_snapshot = m_machine_time;
+                // Snapshots after the one we loaded describe frames that
+                // are about to be re-simulated
+                m_rollback_states.erase(m_rollback_states.begin() + stateIndex + 1, m_rollback_states.end());
+                // Walk the realtime target back so the re-simulated
+                // frames run unthrottled until we are caught up
+                m_video->rollback(resimAmount);
+                catchingUp = true;
+                m_rollback_count++;
+              }
+              m_rollback_resim_ticks += osd_ticks() - startTicks;
+            }
+          } else if (m_machine_time >= m_rollback_next_snapshot) {
+            // Take a frame snapshot, recycling states that fell out of
+            // the one-second rollback window
+            osd_ticks_t startTicks = osd_ticks();
+            std::unique_ptr<delta_state> snapshot;
+            if (!m_rollback_states.empty() && m_rollback_states.front()->m_time < m_machine_time - attotime(1,0)) {
+              snapshot = std::move(m_rollback_states.front());
+              m_rollback_states.erase(m_rollback_states.begin());
+            } else {
+              snapshot.reset(new delta_state(m_save));
+            }
             isRollback = true;
-            immediate_load("test");
+            save_error saveerr = snapshot->save();
             isRollback = false;
-            catchingUp = true;
+            if (saveerr == STATERR_NONE) {
+              snapshot->m_time = m_machine_time;
+              m_rollback_delta_bytes += snapshot->size();
+              m_rollback_states.push_back(std::move(snapshot));
+            }
+            m_rollback_next_snapshot = m_machine_time + attotime::from_hz(60);
+            m_rollback_snapshot_ticks += osd_ticks() - startTicks;
+            m_rollback_snapshot_count++;
           }
         }
-				*/
+
+        // Frame budget report, once an emulated second
+        if (secondPassed && m_rollback_snapshot_count > 0) {
+          osd_ticks_t tps = osd_ticks_per_second();
+          cout << "ROLLBACK BUDGET: " << (m_rollback_snapshot_ticks * 1000000 / tps / m_rollback_snapshot_count)
+               << "us/snapshot over " << m_rollback_snapshot_count << " snapshots ("
+               << (m_rollback_delta_bytes / m_rollback_snapshot_count / 1024) << "KB/delta), "
+               << m_rollback_count << " rollbacks (" << (m_rollback_resim_ticks * 1000 / tps) << "ms reload), "
+               << m_rollback_missed_count << " outside window, "
+               << m_rollback_states.size() << " states held" << endl;
+          m_rollback_snapshot_ticks = m_rollback_resim_ticks = 0;
+          m_rollback_delta_bytes = 0;
+          m_rollback_snapshot_count = m_rollback_count = m_rollback_missed_count = 0;
+        }
       }
 
 			g_profiler.stop();
@@ -764,6 +878,23 @@ int running_machine::run(bool quiet)
 	call_notifiers(MACHINE_NOTIFY_EXIT);
 	util::archive_file::cache_clear();
 
+	// report tracked allocation activity per subsystem tag
+	if (options().alloc_report())
+	{
+		memtrack::enabled() = false;
+		double seconds = time().as_double();
+		for (int tag = 0; tag < memtrack::TAG_COUNT; tag++)
+		{
+			memtrack::tag_stats &s = memtrack::stats(tag);
+			unsigned long long count = s.count.load();
+			if (count != 0)
+				osd_printf_info("alloc[%s]: %llu allocations, %llu bytes, %.1f allocs per emulated second
+",
+						memtrack::tag_name(tag), count, (unsigned long long)s.bytes.load(),
+						(seconds > 0.0) ? double(count) / seconds : 0.0);
+		}
+	}
+
 	// close the logfile
 	m_logfile.reset();
 	return error;
@@ -1277,14 +1408,31 @@ void running_machine::handle_saveload()
 			u32 const openflags = (m_saveload_schedule == saveload_schedule::LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 
 			// open the file
-			emu_file file(m_saveload_searchpath, openflags);
-			auto const filerr = file.open(m_saveload_pending_file);
+			auto file = std::make_shared<emu_file>(m_saveload_searchpath, openflags);
+			auto const filerr = file->open(m_saveload_pending_file);
 			if (filerr == osd_file::error::NONE)
 			{
 				const char *const opnamed = (m_saveload_schedule == saveload_schedule::LOAD) ? "loaded" : "saved";
 
-				// read/write the save state
-				save_error saverr = (m_saveload_schedule == saveload_schedule::LOAD) ? m_save.read_file(file) : m_save.write_file(file);
+				// read/write the save state; saves only serialize here, with
+				// the compression and file write queued to the background
+				// writer so the emulation doesn't stall
+				save_error saverr;
+				if (m_saveload_schedule == saveload_schedule::LOAD)
+					saverr = m_save.read_file(*file);
+				else
+				{
+					auto data = std::make_shared<std::vector<u8> >();
+					saverr = m_save.write_data(*data);
+					if (saverr == STATERR_NONE)
+						m_video->writer().enqueue([file, data]() {
+							if (save_manager::write_data_to_file(*file, *data) != STATERR_NONE)
+							{
+								osd_printf_error("Error writing save state (verify there is enough disk space)\n");
+								file->remove_on_close();
+							}
+						});
+				}
 
 				// handle the result
 				switch (saverr)
@@ -1317,9 +1465,10 @@ void running_machine::handle_saveload()
 					break;
 				}
 
-				// close and perhaps delete the file
+				// close and perhaps delete the file; write errors on a queued
+				// save are handled by the worker above
 				if (saverr != STATERR_NONE && m_saveload_schedule == saveload_schedule::SAVE)
-					file.remove_on_close();
+					file->remove_on_close();
 			}
 			else if (openflags == OPEN_FLAG_READ && filerr == osd_file::error::NOT_FOUND)
 				// attempt to load a non-existent savestate, report empty slot
@@ -1554,6 +1703,19 @@ void running_machine::nvram_load()
 		else
 			nvram.nvram_reset();
 	}
+
+	// remember each device's content hash so devices that never change
+	// can skip their write at the next flush
+	for (device_nvram_interface &nvram : nvram_interface_iterator(root_device()))
+	{
+		emu_file ramfile(OPEN_FLAG_READ | OPEN_FLAG_WRITE);
+		if (ramfile.open_ram_dynamic() == osd_file::error::NONE)
+		{
+			nvram.nvram_save(ramfile);
+			util::core_file &ramcore = ramfile;
+			nvram.set_nvram_hash(util::crc32_creator::simple(ramcore.buffer(), u32(ramcore.size())));
+		}
+	}
 }
 
 
@@ -1576,16 +1738,54 @@ void running_machine::nvram_save()
 
 	for (device_nvram_interface &nvram : nvram_interface_iterator(root_device()))
 	{
-		emu_file file(options().nvram_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		if (file.open(nvram_filename(nvram.device())) == osd_file::error::NONE)
+		// serialize the device into RAM and hash it; devices whose content
+		// has not changed since the last load or save skip the disk write
+		emu_file ramfile(OPEN_FLAG_READ | OPEN_FLAG_WRITE);
+		if (ramfile.open_ram_dynamic() == osd_file::error::NONE)
 		{
-			nvram.nvram_save(file);
-			file.close();
+			nvram.nvram_save(ramfile);
+			util::core_file &ramcore = ramfile;
+			u32 const length = u32(ramcore.size());
+			void const *const data = ramcore.buffer();
+			util::crc32_t const hash = util::crc32_creator::simple(data, length);
+			if (nvram.nvram_hash_valid() && hash == nvram.nvram_hash())
+				continue;
+
+			emu_file file(options().nvram_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			if (file.open(nvram_filename(nvram.device())) == osd_file::error::NONE)
+			{
+				if (length != 0)
+					file.write(data, length);
+				file.close();
+				nvram.set_nvram_hash(hash);
+			}
+		}
+		else
+		{
+			// out of memory: fall back to writing the device out directly
+			emu_file file(options().nvram_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			if (file.open(nvram_filename(nvram.device())) == osd_file::error::NONE)
+			{
+				nvram.nvram_save(file);
+				file.close();
+			}
 		}
 	}
 }
 
 
+/*-------------------------------------------------
+    nvram_flush - periodic timer callback that
+    writes back NVRAM devices whose content has
+    changed
+-------------------------------------------------*/
+
+void running_machine::nvram_flush(void *ptr, s32 param)
+{
+	nvram_save();
+}
+
+
 //**************************************************************************
 //  OUTPUT
 //**************************************************************************
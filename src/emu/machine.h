@@ -304,6 +304,7 @@ private:
 	void set_saveload_filename(std::string &&filename);
 	void handle_saveload();
 	void soft_reset(void *ptr = nullptr, s32 param = 0);
+	void nvram_flush(void *ptr = nullptr, s32 param = 0);
 	void nvram_load();
 	void nvram_save();
 	void popup_clear() const;
@@ -347,6 +348,7 @@ private:
 	bool                    m_hard_reset_pending;   // is a hard reset pending?
 	bool                    m_exit_pending;         // is an exit pending?
 	emu_timer *             m_soft_reset_timer;     // timer used to schedule a soft reset
+	emu_timer *             m_nvram_flush_timer;    // timer used for periodic NVRAM write-back
 
 	// misc state
 	u32                     m_rand_seed;            // current random number seed
@@ -425,6 +427,17 @@ public:
 
   // Is this save/load a rollback?
   bool isRollback;
+
+  // rollback snapshot ring and statistics; lives on the machine because
+  // delta states hold pointers into this machine's save registrations
+  std::vector<std::unique_ptr<delta_state>> m_rollback_states;
+  attotime m_rollback_next_snapshot;
+  osd_ticks_t m_rollback_snapshot_ticks;
+  osd_ticks_t m_rollback_resim_ticks;
+  int m_rollback_snapshot_count;
+  int m_rollback_count;
+  int m_rollback_missed_count;
+  long long m_rollback_delta_bytes;
 };
 
 
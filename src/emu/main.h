@@ -16,8 +16,10 @@
 #ifndef MAME_EMU_MAIN_H
 #define MAME_EMU_MAIN_H
 
+#include <memory>
 #include <thread>
 #include <time.h>
+#include <vector>
 
 //**************************************************************************
 //    CONSTANTS
@@ -88,6 +90,12 @@ public:
 
 	virtual void update_machine() { }
 
+	// per-process cache of immutable ROM payloads, shared across the
+	// sessions a single host process runs; the frontend manager decides
+	// whether and how much to retain
+	virtual std::shared_ptr<std::vector<u8>> romdata_cache_find(const std::string &key) { return nullptr; }
+	virtual void romdata_cache_store(const std::string &key, std::shared_ptr<std::vector<u8>> data) { }
+
 	http_manager *http() { return m_http.get(); }
 	void start_http_server();
 
@@ -362,9 +362,12 @@ bool Client::connect(unsigned short selfPort,const char *hostname,unsigned short
       initialSyncBuffer.resize(initialSyncBuffer.size()+GetPacketSize(p));
       memcpy(&initialSyncBuffer[curPos],GetPacketData(p),GetPacketSize(p));
 
-      int totalSize;
-      memcpy(&totalSize,(&initialSyncBuffer[sizeof(int)]),sizeof(int));
-      initialSyncPercentComplete = initialSyncBuffer.size()*1000/totalSize;
+      if(initialSyncBuffer.size() >= 2*sizeof(int))
+      {
+        int totalSize;
+        memcpy(&totalSize,(&initialSyncBuffer[sizeof(int)]),sizeof(int));
+        initialSyncPercentComplete = initialSyncBuffer.size()*1000/totalSize;
+      }
     }
     break;
     case ID_INITIAL_SYNC_COMPLETE:
@@ -373,7 +376,9 @@ bool Client::connect(unsigned short selfPort,const char *hostname,unsigned short
       int curPos = (int)initialSyncBuffer.size();
       initialSyncBuffer.resize(initialSyncBuffer.size()+GetPacketSize(p));
       memcpy(&initialSyncBuffer[curPos],GetPacketData(p),GetPacketSize(p));
-      loadInitialData(&initialSyncBuffer[0],(int)initialSyncBuffer.size(),machine);
+      // Skip the two-int progress header in front of the lzma stream
+      loadInitialData(&initialSyncBuffer[2*sizeof(int)],
+                      int(initialSyncBuffer.size()-2*sizeof(int)),machine);
       initComplete=true;
     }
     break;
@@ -391,7 +396,7 @@ bool Client::connect(unsigned short selfPort,const char *hostname,unsigned short
           largestPacketTime = packetTime;
         }
       }
-      string s = doInflate(GetPacketData(p), GetPacketSize(p));
+      const string &s = doInflate(GetPacketData(p), GetPacketSize(p));
       PeerInputDataList inputDataList;
       inputDataList.ParseFromString(s);
       receiveInputs(&inputDataList);
@@ -477,7 +482,7 @@ void Client::loadInitialData(unsigned char *data,int size,running_machine *machi
 }
 
 void Client::createInitialBlocks(running_machine *machine) {
-  unsigned char checksum = 0;
+  unsigned int checksum = 0;
 
   machine->save().dispatch_presave();
 
@@ -507,10 +512,10 @@ void Client::createInitialBlocks(running_machine *machine) {
         unsigned char xorValue = initial_sync.initial_block(blockIndex)[a];
         //cout << int(blocks[blockIndex]->data[a] ^ xorValue) << '\n';
         staleBlocks[blockIndex]->data[a] = blocks[blockIndex]->data[a] ^ xorValue;
-        checksum = checksum ^ staleBlocks[blockIndex]->data[a];
       }
+      checksum = blockHash(staleBlocks[blockIndex]->data, staleBlocks[blockIndex]->size);
       if(checksum != initial_sync.checksum(blockIndex)) {
-        cout << "CHECKSUM ERROR: " << int(checksum) << " != " << int(initial_sync.checksum(blockIndex)) << " " << blocks[blockIndex]->name << " (index: " << blockIndex << ") " << endl;
+        cout << "CHECKSUM ERROR: " << checksum << " != " << initial_sync.checksum(blockIndex) << " " << blocks[blockIndex]->name << " (index: " << blockIndex << ") " << endl;
         exit(1);
       }
     }
@@ -537,6 +542,16 @@ void Client::updateSyncCheck()
     }
   }
   cout << "SYNC CHECK CHECKSUM: " << int(checksum) << endl;
+
+  // Record this sync point's page digests in the bisection ring; the
+  // server records the same digests for the same generation
+  std::vector<std::vector<unsigned int> > pages(syncCheckBlocks.size());
+  for(int blockIndex=0; blockIndex<int(syncCheckBlocks.size()); blockIndex++)
+  {
+    computePageHashes(syncCheckBlocks[blockIndex]->data,
+                      syncCheckBlocks[blockIndex]->size, pages[blockIndex]);
+  }
+  recordChecksumRing(syncGeneration, syncSeconds, syncAttoseconds, pages);
 }
 
 
@@ -566,6 +581,8 @@ bool Client::sync(running_machine *machine)
 
 bool Client::update(running_machine *machine)
 {
+  TRACE_EVENT_SCOPE("nsm_client_update");
+  flushInputs();
   RakSleep(0);
   if(printWhenCheck)
   {
@@ -814,7 +831,7 @@ bool Client::update(running_machine *machine)
           largestPacketTime = packetTime;
         }
       }
-      string s = doInflate(GetPacketData(p), GetPacketSize(p));
+      const string &s = doInflate(GetPacketData(p), GetPacketSize(p));
       PeerInputDataList inputDataList;
       inputDataList.ParseFromString(s);
       receiveInputs(&inputDataList);
@@ -864,7 +881,6 @@ bool Client::resync(unsigned char *data,int size,running_machine *machine)
   {
     const nsm::SyncBlock& syncBlock = syncProto.block(i);
     int blockIndex = syncBlock.index();
-    unsigned char *syncBlockData = (unsigned char*)(&syncBlock.data()[0]);
 
     if(blockIndex >= int(blocks.size()) || blockIndex<0)
     {
@@ -873,6 +889,16 @@ bool Client::resync(unsigned char *data,int size,running_machine *machine)
     }
 
     MemoryBlock &block = *(blocks[blockIndex]);
+
+    // Expand the run-length-encoded payload back into a flat xor delta
+    vector<unsigned char> deltaBuffer(block.size);
+    if(!xorDeltaDecode((const unsigned char*)(syncBlock.data().data()),
+                       int(syncBlock.data().length()), &deltaBuffer[0], block.size))
+    {
+      cout << "GOT A CORRUPT SYNC BLOCK FOR INDEX: " << blockIndex << endl;
+      break;
+    }
+    unsigned char *syncBlockData = &deltaBuffer[0];
     MemoryBlock &syncCheckBlock = *(syncCheckBlocks[blockIndex]);
     MemoryBlock &staleBlock = *(staleBlocks[blockIndex]);
 
@@ -924,8 +950,13 @@ bool Client::resync(unsigned char *data,int size,running_machine *machine)
   }
 
   printf("CLIENT IS DIRTY (%d bad blocks, %f%% of total)\n",badByteCount,float(badByteCount)*100.0f/totalByteCount);
+  netStats.resyncCount.fetch_add(1, std::memory_order_relaxed);
   machine->ui().popup_time(3, "You are out of sync with the server, resyncing...");
 
+  // Hand the server our sync-point digest history so it can report the
+  // first divergent frame/block/offset instead of a manual state diff
+  sendChecksumRing();
+
   machine->save().dispatch_presave();
 
   revert(machine);
@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 
+#include "coretmpl.h"
+
 #include "ChronoMap.hpp"
 
 #include "RakNet/RakPeerInterface.h"
@@ -177,11 +179,12 @@ Common::Common(string _username, int _unmeasuredNoise) :
     username = username.substr(0,16);
   }
 
-  /* allocate deflate state */
+  /* allocate deflate state; input packets are tiny per-frame protobufs
+     compressed on the emulation thread, so favor speed over ratio */
   outputStream.zalloc = Z_NULL;
   outputStream.zfree = Z_NULL;
   outputStream.opaque = Z_NULL;
-  int retval = deflateInit(&outputStream,9);
+  int retval = deflateInit(&outputStream,Z_BEST_SPEED);
   if(retval != Z_OK)
   {
     cout << "ERROR INITIALIZING ZLIB\n";
@@ -232,7 +235,7 @@ RakNet::SystemAddress Common::ConnectBlocking(const char *defaultAddress, unsign
       }
       else if(packetID == ID_INPUTS)
       {
-        string s = doInflate(GetPacketData(packet), GetPacketSize(packet));
+        const string &s = doInflate(GetPacketData(packet), GetPacketSize(packet));
         PeerInputDataList inputDataList;
         inputDataList.ParseFromString(s);
         receiveInputs(&inputDataList);
@@ -247,9 +250,13 @@ RakNet::SystemAddress Common::ConnectBlocking(const char *defaultAddress, unsign
   }
 }
 
-std::string Common::doInflate(const unsigned char *inputString, int length) {
+const std::string& Common::doInflate(const unsigned char *inputString, int length) {
+  netStats.inputBytesReceived.fetch_add(length, std::memory_order_relaxed);
   int chunkSize = 128*1024;
-  vector<char> v(chunkSize, '\0');
+  if(int(inflateScratch.size()) < chunkSize) {
+    inflateScratch.resize(chunkSize, '\0');
+  }
+  vector<char> &v = inflateScratch;
   int writeIndex=0;
   inflateReset(&inputStream);
   inputStream.avail_out = chunkSize;
@@ -275,8 +282,8 @@ std::string Common::doInflate(const unsigned char *inputString, int length) {
       }
     }
   }
-  string s(&(v[0]), writeIndex);
-  return s;
+  inflateResult.assign(&(v[0]), writeIndex);
+  return inflateResult;
 }
 
 extern std::unordered_map<int, wga::ChronoMap<int,InputState>> playerInputData;
@@ -307,53 +314,333 @@ void Common::setSecondsBetweenSync(int _secondsBetweenSync)
   secondsBetweenSync = _secondsBetweenSync;
 }
 
+static void appendLength(string* out, unsigned int v)
+{
+  out->push_back((char)(v & 0xff));
+  out->push_back((char)((v >> 8) & 0xff));
+  out->push_back((char)((v >> 16) & 0xff));
+  out->push_back((char)((v >> 24) & 0xff));
+}
+
+static unsigned int readLength(const unsigned char* in)
+{
+  return (unsigned int)(in[0]) | ((unsigned int)(in[1]) << 8) |
+    ((unsigned int)(in[2]) << 16) | ((unsigned int)(in[3]) << 24);
+}
+
+void Common::xorDeltaEncode(const unsigned char* data, const unsigned char* stale, int size, string* out)
+{
+  out->clear();
+  out->push_back((char)1);  // format 1: zero-run RLE over the xor delta
+
+  int pos = 0;
+  while (pos < size)
+  {
+    // fast-forward over unchanged bytes, a word at a time
+    int runStart = pos;
+    pos += (int)util::first_difference(data + pos, stale + pos, size - pos);
+    unsigned int zeroRun = pos - runStart;
+    if (pos >= size)
+      break;  // trailing unchanged bytes are implicit
+
+    // extend the literal run until 16 unchanged bytes in a row show up;
+    // shorter unchanged stretches are cheaper kept as literal zeros than
+    // paid for with another token
+    int litStart = pos;
+    int litEnd = pos + 1;
+    int equalRun = 0;
+    for (int scan = pos + 1; scan < size && equalRun < 16; scan++)
+    {
+      if (data[scan] == stale[scan])
+        equalRun++;
+      else
+      {
+        equalRun = 0;
+        litEnd = scan + 1;
+      }
+    }
+
+    appendLength(out, zeroRun);
+    appendLength(out, litEnd - litStart);
+    for (int a = litStart; a < litEnd; a++)
+      out->push_back((char)(data[a] ^ stale[a]));
+    pos = litEnd;
+  }
+
+  // raw escape when the delta is noise and RLE would grow it
+  if (int(out->length()) >= size + 1)
+  {
+    out->clear();
+    out->reserve(size + 1);
+    out->push_back((char)0);  // format 0: flat xor delta
+    for (int a = 0; a < size; a++)
+      out->push_back((char)(data[a] ^ stale[a]));
+  }
+}
+
+bool Common::xorDeltaDecode(const unsigned char* in, int inSize, unsigned char* delta, int size)
+{
+  if (inSize < 1)
+    return false;
+
+  if (in[0] == 0)
+  {
+    if (inSize - 1 != size)
+      return false;
+    memcpy(delta, in + 1, size);
+    return true;
+  }
+
+  memset(delta, 0, size);
+  int ip = 1;
+  unsigned int op = 0;
+  while (ip < inSize)
+  {
+    if (ip + 8 > inSize)
+      return false;
+    unsigned int zeroRun = readLength(in + ip);
+    unsigned int litLen = readLength(in + ip + 4);
+    ip += 8;
+    if (zeroRun > (unsigned int)(size)-op || litLen > (unsigned int)(size)-op - zeroRun ||
+        litLen > (unsigned int)(inSize - ip))
+      return false;
+    op += zeroRun;
+    memcpy(delta + op, in + ip, litLen);
+    op += litLen;
+    ip += litLen;
+  }
+  return true;
+}
+
+unsigned int Common::blockHash(const unsigned char* data, int size)
+{
+  unsigned int hash = 2166136261u;
+  for(int a=0; a<size; a++)
+  {
+    hash = (hash ^ data[a]) * 16777619u;
+  }
+  return hash;
+}
+
+static const int CHECKSUM_RING_PAGE_SIZE = 4096;
+static const int CHECKSUM_RING_CAPACITY = 64;
+
+void Common::computePageHashes(const unsigned char* data, int size, std::vector<unsigned int>& out)
+{
+  int numPages = (size + CHECKSUM_RING_PAGE_SIZE - 1) / CHECKSUM_RING_PAGE_SIZE;
+  out.resize(numPages);
+  for(int page=0; page<numPages; page++)
+  {
+    int pageOffset = page*CHECKSUM_RING_PAGE_SIZE;
+    int pageSize = min(CHECKSUM_RING_PAGE_SIZE, size - pageOffset);
+    out[page] = blockHash(data + pageOffset, pageSize);
+  }
+}
+
+void Common::recordChecksumRing(int gen, long long seconds, long long attoseconds,
+                                const std::vector<std::vector<unsigned int> >& pages)
+{
+  checksumRing.push_back(ChecksumRingEntry());
+  ChecksumRingEntry &entry = checksumRing.back();
+  entry.generation = gen;
+  entry.seconds = seconds;
+  entry.attoseconds = attoseconds;
+  entry.pageHashes = pages;
+  while(int(checksumRing.size()) > CHECKSUM_RING_CAPACITY)
+  {
+    checksumRing.pop_front();
+  }
+}
+
+void Common::sendChecksumRing()
+{
+  // Flat little-endian framing: entry count, then per entry the
+  // generation, machine time, and the page digest arrays per block
+  string payload;
+  payload.push_back((char)ID_CHECKSUM_RING);
+  unsigned int numEntries = checksumRing.size();
+  payload.append((const char*)&numEntries, sizeof(numEntries));
+  for(list<ChecksumRingEntry>::iterator it = checksumRing.begin();
+      it != checksumRing.end(); it++)
+  {
+    payload.append((const char*)&(it->generation), sizeof(int));
+    payload.append((const char*)&(it->seconds), sizeof(long long));
+    payload.append((const char*)&(it->attoseconds), sizeof(long long));
+    unsigned int numBlocks = it->pageHashes.size();
+    payload.append((const char*)&numBlocks, sizeof(numBlocks));
+    for(unsigned int b=0; b<numBlocks; b++)
+    {
+      unsigned int numPages = it->pageHashes[b].size();
+      payload.append((const char*)&numPages, sizeof(numPages));
+      if(numPages)
+        payload.append((const char*)&(it->pageHashes[b][0]), numPages*sizeof(unsigned int));
+    }
+  }
+
+  cout << "UPLOADING CHECKSUM RING FOR DESYNC BISECTION (" << payload.length() << " bytes)" << endl;
+  rakInterface->Send(
+    payload.c_str(),
+    int(payload.length()),
+    MEDIUM_PRIORITY,
+    RELIABLE_ORDERED,
+    ORDERING_CHANNEL_SYNC,
+    RakNet::UNASSIGNED_SYSTEM_ADDRESS,
+    true
+    );
+  netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(payload.length(), std::memory_order_relaxed);
+}
+
+void Common::compareChecksumRing(const unsigned char* data, int size)
+{
+  // Parse the peer's uploaded ring
+  const unsigned char* p = data;
+  const unsigned char* end = data + size;
+  auto fits = [&p, end] (size_t bytes) { return p + bytes <= end; };
+
+  if(!fits(sizeof(unsigned int)))
+    return;
+  unsigned int numEntries;
+  memcpy(&numEntries, p, sizeof(numEntries)); p += sizeof(numEntries);
+
+  std::map<int, ChecksumRingEntry> peerEntries;
+  for(unsigned int e=0; e<numEntries; e++)
+  {
+    ChecksumRingEntry entry;
+    if(!fits(sizeof(int) + 2*sizeof(long long) + sizeof(unsigned int)))
+      return;
+    memcpy(&entry.generation, p, sizeof(int)); p += sizeof(int);
+    memcpy(&entry.seconds, p, sizeof(long long)); p += sizeof(long long);
+    memcpy(&entry.attoseconds, p, sizeof(long long)); p += sizeof(long long);
+    unsigned int numBlocks;
+    memcpy(&numBlocks, p, sizeof(numBlocks)); p += sizeof(numBlocks);
+    entry.pageHashes.resize(numBlocks);
+    for(unsigned int b=0; b<numBlocks; b++)
+    {
+      if(!fits(sizeof(unsigned int)))
+        return;
+      unsigned int numPages;
+      memcpy(&numPages, p, sizeof(numPages)); p += sizeof(numPages);
+      if(!fits(numPages*sizeof(unsigned int)))
+        return;
+      entry.pageHashes[b].resize(numPages);
+      if(numPages)
+        memcpy(&(entry.pageHashes[b][0]), p, numPages*sizeof(unsigned int));
+      p += numPages*sizeof(unsigned int);
+    }
+    peerEntries[entry.generation] = entry;
+  }
+
+  // Walk our ring oldest-first and report the first generation where any
+  // page digest disagrees with the peer's record of the same generation
+  for(list<ChecksumRingEntry>::iterator it = checksumRing.begin();
+      it != checksumRing.end(); it++)
+  {
+    std::map<int, ChecksumRingEntry>::iterator peerIt = peerEntries.find(it->generation);
+    if(peerIt == peerEntries.end())
+      continue;
+    const ChecksumRingEntry &peer = peerIt->second;
+    for(int b=0; b<int(it->pageHashes.size()) && b<int(peer.pageHashes.size()); b++)
+    {
+      for(int page=0; page<int(it->pageHashes[b].size()) && page<int(peer.pageHashes[b].size()); page++)
+      {
+        if(it->pageHashes[b][page] != peer.pageHashes[b][page])
+        {
+          const char* blockName = (b < int(blocks.size())) ? blocks[b]->name.c_str() : "?";
+          cout << "DESYNC BISECTION: first divergence at generation " << it->generation
+               << " time " << it->seconds << "." << it->attoseconds
+               << " block " << b << " (" << blockName << ")"
+               << " offset " << (page*CHECKSUM_RING_PAGE_SIZE)
+               << " (page " << page << ")" << endl;
+          return;
+        }
+      }
+    }
+  }
+  cout << "DESYNC BISECTION: no divergence inside the recorded window ("
+       << checksumRing.size() << " local sync points)" << endl;
+}
+
 time_t lastSecondChecked=0;
-double predictedPingMean=100.0;
-double predictedPingVariance=10.0;
-int numPingSamples=0;
+// Two minutes of once-a-second ping samples per peer, so the delay can
+// follow each connection's own jitter instead of a global running mean
+static std::map<RakNet::RakNetGUID, std::deque<int> > pingHistory;
+static const int PING_WINDOW = 120;
+int announcedDelayTarget=-1;
+
+static int pingPercentile(const std::deque<int> &history, int percentile)
+{
+  std::vector<int> sorted(history.begin(), history.end());
+  int index = (int(sorted.size())-1)*percentile/100;
+  std::nth_element(sorted.begin(), sorted.begin()+index, sorted.end());
+  return sorted[index];
+}
 
 int Common::getLargestPing(int currentSecond)
 {
   time_t curSec = time(NULL);
   if (curSec > lastSecondChecked) {
     lastSecondChecked = curSec;
-    int lastPing=-1;
+    std::set<RakNet::RakNetGUID> connectedGuids;
     for(int a=0; a<rakInterface->NumberOfConnections(); a++)
     {
-      lastPing = max(rakInterface->GetLastPing(rakInterface->GetSystemAddressFromIndex(a)),lastPing);
-      //printf("PING: %d\n",rakInterface->GetAveragePing(rakInterface->GetSystemAddressFromIndex(a)));
+      RakNet::SystemAddress sa = rakInterface->GetSystemAddressFromIndex(a);
+      int lastPing = rakInterface->GetLastPing(sa);
+      RakNet::RakNetGUID saGuid = rakInterface->GetGuidFromSystemAddress(sa);
+      connectedGuids.insert(saGuid);
+      if (lastPing < 0) {
+        continue;
+      }
+      std::deque<int> &history = pingHistory[saGuid];
+      history.push_back(lastPing);
+      while (int(history.size()) > PING_WINDOW) {
+        history.pop_front();
+      }
     }
-    if (lastPing == -1) {
-      // No connections, don't update stats
-      return unmeasuredNoise*2;
+    // Drop history for peers that are gone so they can't pin the delay
+    for (std::map<RakNet::RakNetGUID, std::deque<int> >::iterator it = pingHistory.begin();
+         it != pingHistory.end();
+         ) {
+      if (connectedGuids.find(it->first) == connectedGuids.end()) {
+        pingHistory.erase(it++);
+      } else {
+        it++;
+      }
     }
-    if (numPingSamples==0) {
-      predictedPingMean = lastPing;
+  }
+
+  // The delay has to cover the slowest peer: use its 95th percentile
+  // ping so jitter spikes don't starve the input merge
+  int largestTarget = -1;
+  for (std::map<RakNet::RakNetGUID, std::deque<int> >::iterator it = pingHistory.begin();
+       it != pingHistory.end();
+       it++) {
+    const std::deque<int> &history = it->second;
+    if (history.empty()) {
+      continue;
+    }
+    int target;
+    if (int(history.size()) < 30) {
+      // Too few samples for a stable percentile; be pessimistic
+      target = *std::max_element(history.begin(), history.end()) + 100;
     } else {
-      const int PRIOR_SAMPLE_ESTIMATE = 60;
-      double oldMean = predictedPingMean;
-      predictedPingMean = ((predictedPingMean * (PRIOR_SAMPLE_ESTIMATE - 1)) + lastPing) / PRIOR_SAMPLE_ESTIMATE;
-      predictedPingVariance = (predictedPingVariance*(PRIOR_SAMPLE_ESTIMATE-1) + ((lastPing - oldMean)*(lastPing - predictedPingMean))) / PRIOR_SAMPLE_ESTIMATE;
+      target = pingPercentile(history, 95);
     }
-    numPingSamples++;
-    cout << "UPDATED LATENCY PREDICTOR: " << predictedPingMean << " + " << predictedPingVariance << endl;
+    largestTarget = max(largestTarget, target + unmeasuredNoise*2);
   }
-  if (numPingSamples<60) {
-    // Guess what the variance will be, add for unmeasured noise
-    return int(predictedPingMean + unmeasuredNoise*2 + 100);
-  } else {
-    // Use the computed variance, add for unmeasured noise
-    return int(predictedPingMean + unmeasuredNoise*2 + sqrt(predictedPingVariance)*2);
+  if (largestTarget == -1) {
+    // No connections, don't update stats
+    return unmeasuredNoise*2;
   }
 
-/*
-  int largestPing=1;
-  for(int a=0; a<rakInterface->NumberOfConnections(); a++)
-  {
-    largestPing = max(rakInterface->GetAveragePing(rakInterface->GetSystemAddressFromIndex(a)),largestPing);
+  // Hysteresis: only re-announce when the target drifts more than 25%,
+  // since every change perturbs the input lead time
+  if (announcedDelayTarget < 0 ||
+      largestTarget > announcedDelayTarget + max(4, announcedDelayTarget/4) ||
+      largestTarget < announcedDelayTarget - max(4, announcedDelayTarget/4)) {
+    announcedDelayTarget = largestTarget;
+    cout << "UPDATED LATENCY TARGET: " << announcedDelayTarget << endl;
   }
-  return largestPing;
-*/
+  return announcedDelayTarget;
 }
 
 bool Common::hasPeerWithID(int peerID)
@@ -399,7 +686,17 @@ string Common::getStatisticsString()
   for(int a=0; a<rakInterface->NumberOfConnections(); a++)
   {
     char message[4096];
-    rss=rakInterface->GetStatistics(rakInterface->GetSystemAddressFromIndex(a));
+    RakNet::SystemAddress sa = rakInterface->GetSystemAddressFromIndex(a);
+    rss=rakInterface->GetStatistics(sa);
+    // One-way latency estimate for this peer from its own ping history
+    int oneWayLatency = 0;
+    std::map<RakNet::RakNetGUID, std::deque<int> >::iterator historyIt =
+      pingHistory.find(rakInterface->GetGuidFromSystemAddress(sa));
+    if (historyIt != pingHistory.end() && !historyIt->second.empty()) {
+      oneWayLatency = pingPercentile(historyIt->second, 50)/2;
+    } else {
+      oneWayLatency = max(0, rakInterface->GetLastPing(sa))/2;
+    }
     sprintf(
       message,
       "Sent: %d\n"
@@ -409,10 +706,49 @@ string Common::getStatisticsString()
       (int)rss->valueOverLastSecond[RakNet::ACTUAL_BYTES_SENT],
       (int)rss->valueOverLastSecond[RakNet::ACTUAL_BYTES_RECEIVED],
       rss->packetlossLastSecond,
-      int((predictedPingMean + sqrt(predictedPingVariance)*2)/2)
+      oneWayLatency
       );
     retval += string(message) + string("\n");
   }
+
+  // Session-wide counters so a glance at the overlay answers "is sync
+  // cost creeping up" without attaching a profiler
+  long long syncCount = netStats.syncCount.load(std::memory_order_relaxed);
+  long long syncRaw = netStats.syncBytesRaw.load(std::memory_order_relaxed);
+  long long syncCompressed = netStats.syncBytesCompressed.load(std::memory_order_relaxed);
+  if (syncCount > 0) {
+    char message[4096];
+    sprintf(
+      message,
+      "Syncs: %d (last %dms)\n"
+      "Sync ratio: %.1fx\n"
+      "Resyncs: %d\n",
+      int(syncCount),
+      int(netStats.lastSyncDurationMs.load(std::memory_order_relaxed)),
+      syncCompressed ? double(syncRaw)/double(syncCompressed) : 0.0,
+      int(netStats.resyncCount.load(std::memory_order_relaxed))
+      );
+    retval += string(message);
+  }
+  return retval;
+}
+
+std::map<std::string, long long> Common::getNetStats()
+{
+  std::map<std::string, long long> retval;
+  retval["input_bytes_sent"] = netStats.inputBytesSent.load(std::memory_order_relaxed);
+  retval["input_bytes_received"] = netStats.inputBytesReceived.load(std::memory_order_relaxed);
+  retval["sync_bytes_raw"] = netStats.syncBytesRaw.load(std::memory_order_relaxed);
+  retval["sync_bytes_compressed"] = netStats.syncBytesCompressed.load(std::memory_order_relaxed);
+  retval["sync_count"] = netStats.syncCount.load(std::memory_order_relaxed);
+  retval["last_sync_duration_ms"] = netStats.lastSyncDurationMs.load(std::memory_order_relaxed);
+  retval["total_sync_duration_ms"] = netStats.totalSyncDurationMs.load(std::memory_order_relaxed);
+  retval["initial_sync_bytes_sent"] = netStats.initialSyncBytesSent.load(std::memory_order_relaxed);
+  retval["resync_count"] = netStats.resyncCount.load(std::memory_order_relaxed);
+  retval["channel_inputs_bytes_sent"] = netStats.channelBytesSent[ORDERING_CHANNEL_INPUTS].load(std::memory_order_relaxed);
+  retval["channel_base_delay_bytes_sent"] = netStats.channelBytesSent[ORDERING_CHANNEL_BASE_DELAY].load(std::memory_order_relaxed);
+  retval["channel_sync_bytes_sent"] = netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].load(std::memory_order_relaxed);
+  retval["channel_const_data_bytes_sent"] = netStats.channelBytesSent[ORDERING_CHANNEL_CONST_DATA].load(std::memory_order_relaxed);
   return retval;
 }
 
@@ -681,7 +1017,8 @@ void Common::updateForces(const vector<pair<unsigned char *,int> > &ramBlocks) {
 
 void Common::sendInputs(const nsm::Attotime &inputTime, PeerInputData::PeerInputType inputType, const InputState &inputState)
 {
-  PeerInputData peerInputData;
+  PeerInputData &peerInputData = scratchInputData;
+  peerInputData.Clear();
   peerInputData.set_counter(globalInputCounter);
   peerInputData.set_inputtype(inputType);
   peerInputData.set_generation(generation);
@@ -689,14 +1026,15 @@ void Common::sendInputs(const nsm::Attotime &inputTime, PeerInputData::PeerInput
   inputDataTime->set_seconds(inputTime.seconds());
   inputDataTime->set_attoseconds(inputTime.attoseconds());
   InputState *inputStateDest = peerInputData.mutable_inputstate();
-  inputStateDest->MergeFrom(inputState);
+  inputStateDest->CopyFrom(inputState);
 
   sendInputs(peerInputData);
 }
 
 void Common::sendInputs(const nsm::Attotime &inputTime, PeerInputData::PeerInputType inputType, const string &inputString)
 {
-  PeerInputData peerInputData;
+  PeerInputData &peerInputData = scratchInputData;
+  peerInputData.Clear();
   peerInputData.set_counter(globalInputCounter);
   peerInputData.set_inputtype(inputType);
   peerInputData.set_generation(generation);
@@ -718,30 +1056,61 @@ void Common::sendInputs(const PeerInputData& peerInputData) {
   }
   //cout << "INPUT STRING: " << inputString << endl;
 
-  PeerInputDataList peerInputDataList;
+  //cout << "SENDING INPUT WITH GC " << globalInputCounter << endl;
+
+  // Queue for the per-tick coalesced broadcast; flushInputs() sends one
+  // aggregated datagram per update instead of one Send per input
+  if(!pendingInputs.input_data_size())
+    pendingInputs.set_peer_id(selfPeerID);
+  pendingInputs.add_input_data()->CopyFrom(peerInputData);
+
+  // "Send" the input to yourself right away so local processing never
+  // waits on the flush
+  PeerInputDataList &peerInputDataList = scratchInputDataList;
+  peerInputDataList.Clear();
   peerInputDataList.set_peer_id(selfPeerID);
   peerInputDataList.add_input_data()->CopyFrom(peerInputData);
+  receiveInputs(&peerInputDataList);
 
-  //cout << "SENDING INPUT WITH GC " << globalInputCounter << endl;
+  // Increment the global input counter
+  globalInputCounter++;
+}
+
+void Common::flushInputs() {
+  if(!pendingInputs.input_data_size())
+    return;
 
-  // Broadcast the input and the last EXTRA_INPUTS_TO_PACK to everyone else
+  // Tack the last EXTRA_INPUTS_TO_PACK older inputs onto the datagram for
+  // loss resilience; everything from this tick is already in the list, so
+  // only pack inputs that predate it
   int inputsAdded = 0;
   const int EXTRA_INPUTS_TO_PACK = 2;
+  int firstPendingCounter = int(pendingInputs.input_data(0).counter());
   for(list<PeerInputData>::reverse_iterator it = peerData[selfPeerID].availableInputs.rbegin();
       it !=  peerData[selfPeerID].availableInputs.rend() && inputsAdded < EXTRA_INPUTS_TO_PACK; it++) {
-    peerInputDataList.add_input_data()->CopyFrom(*it);
+    if(int(it->counter()) >= firstPendingCounter)
+      continue;
+    pendingInputs.add_input_data()->CopyFrom(*it);
     inputsAdded++;
   }
   for(std::list<PeerInputData>::reverse_iterator it = peerData[selfPeerID].oldInputs.rbegin();
       it != peerData[selfPeerID].oldInputs.rend() && inputsAdded < EXTRA_INPUTS_TO_PACK; it++) {
-    peerInputDataList.add_input_data()->CopyFrom(*it);
+    if(int(it->counter()) >= firstPendingCounter)
+      continue;
+    pendingInputs.add_input_data()->CopyFrom(*it);
     inputsAdded++;
   }
 
-  string sNoHeader;
-  peerInputDataList.AppendToString(&sNoHeader);
+  string &sNoHeader = inputSerializeBuffer;
+  sNoHeader.clear();
+  pendingInputs.AppendToString(&sNoHeader);
 
-  string sCompress(sNoHeader.length()*2 + 128, 0);
+  // Compress straight into the reused send buffer; RakNet copies on Send
+  string &sCompress = inputSendBuffer;
+  size_t sendBufferSize = 2 + sizeof(RakNet::Time) + zlibGetMaxCompressedSize(sNoHeader.length());
+  if(sCompress.length() < sendBufferSize) {
+    sCompress.resize(sendBufferSize, 0);
+  }
   sCompress[0] = ID_MAMEHUB_TIMESTAMP;
   RakNet::BitStream timeBS( (unsigned char*)&(sCompress[1]), sizeof(RakNet::Time), false);
   timeBS.SetWriteOffset(0);
@@ -767,6 +1136,8 @@ void Common::sendInputs(const PeerInputData& peerInputData) {
     }
   }
   int bytesUsed = sCompress.length() - outputStream.avail_out;
+  netStats.inputBytesSent.fetch_add(bytesUsed, std::memory_order_relaxed);
+  netStats.channelBytesSent[ORDERING_CHANNEL_INPUTS].fetch_add(bytesUsed, std::memory_order_relaxed);
 
   //cout << "SENDING INPUT PACKET OF SIZE: " << sNoHeader.length() << " (compresses to " << bytesUsed << ") AT TIME " << t << endl;
 
@@ -780,11 +1151,7 @@ void Common::sendInputs(const PeerInputData& peerInputData) {
     true
     );
 
-  // "Send" the inputs to yourself
-  receiveInputs(&peerInputDataList);
-
-  // Increment the global input counter
-  globalInputCounter++;
+  pendingInputs.Clear();
 }
 
 attotime protoToAttotime(const Attotime &at) {
@@ -14,6 +14,7 @@
 #include "RakNet/GetTime.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <iostream>
@@ -74,9 +75,42 @@ enum CustomPacketType
     ID_SEND_PEER_ID,
     ID_CLIENT_INFO,
     ID_MAMEHUB_TIMESTAMP,
+    ID_CHECKSUM_RING,
     ID_END
   };
 
+// Session-wide netplay counters, updated lock-free with relaxed atomics
+// from the emulation thread and the sync workers.  Snapshotted on demand
+// for the stats overlay and the Lua interface so netplay performance can
+// be regression-tested release to release.
+// One ring slot of desync forensics: the per-4K-page digests of every
+// block at a given sync generation.  Both peers record these at the
+// sync point; on desync the client uploads its ring and the server
+// names the first divergent generation, block, and page offset.
+struct ChecksumRingEntry
+{
+  int generation;
+  long long seconds;
+  long long attoseconds;
+  std::vector<std::vector<unsigned int> > pageHashes;
+};
+
+struct NetStatsCounters
+{
+  std::atomic<long long> inputBytesSent{0};
+  std::atomic<long long> inputBytesReceived{0};
+  std::atomic<long long> syncBytesRaw{0};
+  std::atomic<long long> syncBytesCompressed{0};
+  std::atomic<long long> syncCount{0};
+  std::atomic<long long> lastSyncDurationMs{0};
+  std::atomic<long long> totalSyncDurationMs{0};
+  std::atomic<long long> initialSyncBytesSent{0};
+  std::atomic<long long> resyncCount{0};
+  // Bytes handed to RakNet per ordering channel, so a sync transfer
+  // crowding out the input lane shows up directly in the session stats
+  std::atomic<long long> channelBytesSent[ORDERING_CHANNEL_END] = {};
+};
+
 class Common : public CommonInterface
 {
  protected:
@@ -90,6 +124,21 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
   z_stream inputStream;
   z_stream outputStream;
 
+  // Reused hot-path messages and buffers: the bundled protobuf predates
+  // arena allocation, so capacity retained across Clear() stands in for
+  // per-connection arenas on the input path
+  nsm::PeerInputData scratchInputData;
+  nsm::PeerInputDataList scratchInputDataList;
+  std::string inputSerializeBuffer;
+  std::string inputSendBuffer;
+  std::vector<char> inflateScratch;
+  std::string inflateResult;
+
+  // Inputs generated since the last update, coalesced into one datagram
+  // per tick by flushInputs(); the PeerInputDataList framing already
+  // carries any number of messages per packet
+  nsm::PeerInputDataList pendingInputs;
+
   int selfPeerID;
   int generation;
   int unmeasuredNoise;
@@ -102,6 +151,11 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
 
   std::vector<std::pair<BlockValueLocation,int> > forcedLocations;
 
+  // Bounded history of sync-point page digests for desync bisection
+  std::list<ChecksumRingEntry> checksumRing;
+
+  NetStatsCounters netStats;
+
  public:
 
   Common(std::string _username, int _unmeasuredNoise);
@@ -121,6 +175,31 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
 
   void setSecondsBetweenSync(int _secondsBetweenSync);
 
+  // XOR-delta sync payload codec: the delta between a block and its stale
+  // snapshot is mostly zero, so it is stored as alternating zero-run /
+  // literal-run tokens before LZMA ever sees it.  A leading format byte
+  // keeps a raw escape for the rare delta that RLE would expand.
+  static void xorDeltaEncode(const unsigned char* data, const unsigned char* stale, int size, std::string* out);
+  static bool xorDeltaDecode(const unsigned char* in, int inSize, unsigned char* delta, int size);
+
+  // 32-bit FNV-1a digest used for block and page verification; the old
+  // one-byte xor checksum let too many divergences cancel out.
+  static unsigned int blockHash(const unsigned char* data, int size);
+
+  // Per-4K-page digests of one block, the unit stored in the checksum ring
+  static void computePageHashes(const unsigned char* data, int size, std::vector<unsigned int>& out);
+
+  // Record a sync point in the bisection ring (capped history)
+  void recordChecksumRing(int gen, long long seconds, long long attoseconds,
+                          const std::vector<std::vector<unsigned int> >& pages);
+
+  // Client side: upload the ring to the server after a detected desync
+  void sendChecksumRing();
+
+  // Server side: line up a peer's uploaded ring against ours and report
+  // the first divergent generation, block, and page offset
+  void compareChecksumRing(const unsigned char* data, int size);
+
   virtual std::vector<std::shared_ptr<MemoryBlock> > createMemoryBlock(const std::string& name, unsigned char* ptr,int size) = 0;
 
   virtual bool update(running_machine *machine) = 0;
@@ -148,6 +227,8 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
 
   std::string getStatisticsString();
 
+  std::map<std::string, long long> getNetStats();
+
   void getPeerIDs(std::vector<int> &retval);
 
   int getNumPeers();
@@ -183,6 +264,10 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
 
   void receiveInputs(const nsm::PeerInputDataList *inputDataList);
 
+  // Broadcasts everything queued by sendInputs() since the last flush as
+  // a single compressed datagram; called once per update tick
+  void flushInputs();
+
   std::pair<int,nsm::Attotime> getOldestPeerInputTime();
 
   int getPlayer() { return player; }
@@ -196,7 +281,7 @@ std::vector<std::shared_ptr<MemoryBlock> > blocks,staleBlocks;
  protected:
   void sendInputs(const nsm::PeerInputData &peerInputData);
 
-  std::string doInflate(const unsigned char *inputString, int length);
+  const std::string& doInflate(const unsigned char *inputString, int length);
 
   int player;
 };
@@ -180,6 +180,10 @@ class CommonInterface {
 
   virtual std::string getStatisticsString() = 0;
 
+  // Session counters (bytes, sync sizes/durations, resync counts) keyed
+  // by name, for the Lua interface and automated netplay regression runs
+  virtual std::map<std::string, long long> getNetStats() = 0;
+
   virtual void getPeerIDs(std::vector<int> &retval) = 0;
 
   virtual int getNumPeers() = 0;
@@ -10,6 +10,7 @@
 #include "RakNet/RakSleep.h"
 
 #include <assert.h>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
@@ -77,6 +78,7 @@ Server::Server(string username,int _port,int _unmeasuredNoise, bool _rollback)
   cout << "ROLLBACK " << (rollback?"ENABLED":"DISABLED") << endl;
 
   syncReady = false;
+  initialSyncReady = false;
   rakInterface = RakNet::RakPeerInterface::GetInstance();
 
   syncCount=0;
@@ -95,6 +97,11 @@ void Server::shutdown()
     syncThread.reset();
   }
 
+  if (initialSyncThread) {
+    initialSyncThread->join();
+    initialSyncThread.reset();
+  }
+
   // Be nice and let the server know we quit.
   rakInterface->Shutdown(300);
 
@@ -215,6 +222,7 @@ void Server::acceptPeer(RakNet::RakNetGUID guidToAccept,running_machine *machine
     RakNet::UNASSIGNED_SYSTEM_ADDRESS,
     true
     );
+  netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(int(tmpbuf-buf), std::memory_order_relaxed);
 
   //Perform initial sync with player
   initialSync(guidToAccept,machine);
@@ -354,12 +362,88 @@ extern bool waitingForClientCatchup;
 attotime oldInputTime;
 extern int nvram_size(running_machine &machine);
 
+// Serializes and compresses the captured initial snapshot off the
+// emulation thread, then chunks it into the packet queue.  The stream
+// starts with two ints (reserved, total stream size) so the client can
+// report download progress.
+class InitialSyncProcessor
+{
+public:
+  nsm::InitialSync* initial_sync;
+  std::string* stream;
+  std::list<std::pair<unsigned char *,int> >* packetQueue;
+  bool* readyPtr;
+  NetStatsCounters* stats;
+
+  InitialSyncProcessor(nsm::InitialSync* _initial_sync,
+                       std::string* _stream,
+                       std::list<std::pair<unsigned char *,int> >* _packetQueue,
+                       bool* _readyPtr,
+                       NetStatsCounters* _stats) :
+    initial_sync(_initial_sync),
+    stream(_stream),
+    packetQueue(_packetQueue),
+    readyPtr(_readyPtr),
+    stats(_stats) {
+    *readyPtr = false;
+  }
+
+  void operator()() {
+    stream->clear();
+    stream->append(2*sizeof(int), 0);
+    {
+      StringOutputStream sos(stream);
+      {
+        LzmaOutputStream los(&sos);
+        los.ChangeEncodingOptions(4);
+        initial_sync->SerializeToZeroCopyStream(&los);
+        los.Flush();
+      }
+    }
+
+    int totalSize = (int)stream->length();
+    memcpy(&((*stream)[sizeof(int)]), &totalSize, sizeof(int));
+    cout << "INITIAL SYNC STREAM SIZE: " << totalSize << endl;
+    stats->initialSyncBytesSent.fetch_add(totalSize, std::memory_order_relaxed);
+
+    const int INITIAL_SYNC_PACKET_SIZE = 64*1024;
+    int offset = 0;
+    while(offset < totalSize)
+    {
+      int chunkSize = min(INITIAL_SYNC_PACKET_SIZE, totalSize-offset);
+      packetQueue->push_back(make_pair((unsigned char*)&((*stream)[offset]), chunkSize));
+      offset += chunkSize;
+    }
+
+    *readyPtr = true;
+  }
+};
+
 void Server::initialSync(const RakNet::RakNetGUID &guid,running_machine *machine)
 {
+  // The sync thread rewrites staleBlocks; make sure it has landed before
+  // snapshotting them for a new client
+  if (syncThread) {
+    syncThread->join();
+    syncThread.reset();
+  }
+
+  // Flush any initial sync still streaming to an earlier client; its
+  // packets point into the stream buffer this capture is about to reuse
+  if (initialSyncThread) {
+    initialSyncThread->join();
+    initialSyncThread.reset();
+    while(initialSyncPacketQueue.size())
+    {
+      popInitialSyncQueue();
+    }
+  }
+
   cout << "INITIAL SYNC WITH GUID: " << guid.ToString() << " AT TIME " << staleTime.seconds() << "." << staleTime.attoseconds() << endl;
-  unsigned char checksum = 0;
+  unsigned int checksum = 0;
 
-  nsm::InitialSync initial_sync;
+  nsm::InitialSync &initial_sync = initialSyncProto;
+  initial_sync.Clear();
   initial_sync.set_generation(staleGeneration);
   nsm::Attotime* global_time = initial_sync.mutable_global_time();
   global_time->set_seconds(staleTime.seconds());
@@ -379,16 +463,18 @@ void Server::initialSync(const RakNet::RakNetGUID &guid,running_machine *machine
 
       for(int a=0; a<staleBlocks[blockIndex]->size; a++)
       {
-        checksum = checksum ^ staleBlocks[blockIndex]->data[a];
         //cout << int(staleBlocks[blockIndex]->data[a]) << '\n';
         unsigned char value = initialBlocks[blockIndex]->data[a] ^ staleBlocks[blockIndex]->data[a];
         deltaBlock.push_back(value);
       }
-      //cout << int(checksum) << endl;
+      // A per-block digest lets the client name the diverging block
+      // instead of just knowing that something upstream disagreed
+      checksum = blockHash(staleBlocks[blockIndex]->data, staleBlocks[blockIndex]->size);
+      //cout << checksum << endl;
       initial_sync.add_initial_block(&deltaBlock[0], deltaBlock.size());
       initial_sync.add_checksum(checksum);
     }
-    cout << "CHECKSUM: " << int(checksum) << endl;
+    cout << "CHECKSUM: " << checksum << endl;
   }
 
   waitingForClientCatchup=true;
@@ -441,63 +527,17 @@ void Server::initialSync(const RakNet::RakNetGUID &guid,running_machine *machine
     }
   }
 
-  string s;
-  {
-    StringOutputStream sos(&s);
-    {
-      LzmaOutputStream los(&sos);
-      los.ChangeEncodingOptions(4);
-      initial_sync.SerializeToZeroCopyStream(&los);
-      los.Flush();
-    }
-  }
-
-  int sizeRemaining = s.length()+sizeof(int)+sizeof(int);
-  int packetSize = max(256,min(1024,sizeRemaining/100));
-  int offset = 0;
-
   oldInputTime = attotime(0,0);
 
-  while(sizeRemaining>packetSize)
-  {
-    RakNet::BitStream bitStreamPart(packetSize+32);
-    unsigned char header = ID_INITIAL_SYNC_PARTIAL;
-    bitStreamPart.WriteBits((const unsigned char*)&header,8*sizeof(unsigned char));
-    bitStreamPart.WriteBits((const unsigned char*)(s.c_str()+offset),8*packetSize);
-    sizeRemaining -= packetSize;
-    offset += packetSize;
-    rakInterface->Send(
-      &bitStreamPart,
-      IMMEDIATE_PRIORITY,
-      RELIABLE_ORDERED,
-      ORDERING_CHANNEL_SYNC,
-      guid,
-      false
-      );
-    emulator_info::draw_user_interface(*machine);
-    machine->osd().update(false);
-    RakSleep(0);
-  }
-  {
-    RakNet::BitStream bitStreamPart(packetSize+32);
-    unsigned char header = ID_INITIAL_SYNC_COMPLETE;
-    bitStreamPart.WriteBits((const unsigned char*)&header,8*sizeof(unsigned char));
-    bitStreamPart.WriteBits((const unsigned char*)(s.c_str()+offset),8*sizeRemaining);
-    rakInterface->Send(
-      &bitStreamPart,
-      IMMEDIATE_PRIORITY,
-      RELIABLE_ORDERED,
-      ORDERING_CHANNEL_SYNC,
-      guid,
-      false
-      );
-    emulator_info::draw_user_interface(*machine);
-    machine->osd().update(false);
-    RakSleep(0);
-  }
+  // Compress and chunk on a worker; update() drains the queue to the
+  // client while the host keeps emulating
+  initialSyncGuid = guid;
+  InitialSyncProcessor initialSyncProcessor(&initialSyncProto, &initialSyncStream,
+                                            &initialSyncPacketQueue, &initialSyncReady,
+                                            &netStats);
+  initialSyncThread = std::shared_ptr<std::thread>(new std::thread(std::move(initialSyncProcessor)));
 
-  cout << "FINISHED SENDING BLOCKS TO CLIENT\n";
-  cout << "SERVER: Done with initial snapshot\n";
+  cout << "SERVER: Streaming initial snapshot in the background\n";
   cout << "OUT OF CRITICAL AREA\n";
   cout.flush();
 }
@@ -518,7 +558,7 @@ void Server::processPotentialCandidates(running_machine *machine) {
     return;
   }
 
-  if(syncCount<1 || syncPacketQueue.size())
+  if(syncCount<1 || syncPacketQueue.size() || initialSyncThread || initialSyncPacketQueue.size())
   {
     cout << "IN THE MIDDLE OF A SYNC, HAVE TO DELAY ACCEPTING CLIENT\n";
     return;
@@ -551,6 +591,7 @@ void Server::processPotentialCandidates(running_machine *machine) {
           guid,
           false
           );
+        netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(2+(2*sizeof(int))+username.length()+1, std::memory_order_relaxed);
       }
       if(acceptedPeers.size()>=maxPeerID-1)
       {
@@ -570,6 +611,7 @@ void Server::processPotentialCandidates(running_machine *machine) {
           buf[0] = ID_ADVERTISE_SYSTEM;
           strcpy(buf+1,systemAddress.ToString(true));
           rakInterface->Send(buf,1+strlen(systemAddress.ToString(true))+1,IMMEDIATE_PRIORITY,RELIABLE_ORDERED,ORDERING_CHANNEL_SYNC,acceptedGuid,false);
+          netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(1+strlen(systemAddress.ToString(true))+1, std::memory_order_relaxed);
         }
         printf("Asking other peers to accept\n");
       }
@@ -584,6 +626,11 @@ void Server::processPotentialCandidates(running_machine *machine) {
 
 bool Server::update(running_machine *machine)
 {
+  TRACE_EVENT_SCOPE("nsm_server_update");
+  flushInputs();
+  popSyncQueue();
+  popInitialSyncQueue();
+
   processPotentialCandidates(machine);
   //cout << "SERVER TIME: " << RakNet::GetTimeMS()/1000.0f/60.0f << endl;
   //printf("Updating server\n");
@@ -680,12 +727,19 @@ bool Server::update(running_machine *machine)
 
     case ID_INPUTS:
     {
-      string s = doInflate(GetPacketData(p), GetPacketSize(p));
+      const string &s = doInflate(GetPacketData(p), GetPacketSize(p));
       PeerInputDataList inputDataList;
       inputDataList.ParseFromString(s);
       receiveInputs(&inputDataList);
       break;
     }
+
+    case ID_CHECKSUM_RING:
+      // A desynced client uploaded its sync-point digests; line them up
+      // against ours and log the first divergent frame/block/offset
+      compareChecksumRing(p->data+1, p->length-1);
+      break;
+
     default:
       printf("UNEXPECTED PACKET ID: %d\n",int(packetIdentifier));
       break;
@@ -696,6 +750,17 @@ bool Server::update(running_machine *machine)
   return true;
 }
 
+// Pages whose leaf hash moved since the last sync, captured on the
+// emulation thread and encoded on the sync thread
+static const int SYNC_PAGE_SIZE = 4096;
+
+struct CapturedPage
+{
+  int blockIndex;
+  int offset;
+  std::vector<unsigned char> data;
+};
+
 class SyncProcessor
 {
 public:
@@ -703,25 +768,70 @@ public:
   std::list<std::pair<unsigned char *,int> >* syncPacketQueue;
   int syncTransferSeconds;
   bool* syncReadyPtr;
+  std::vector<std::shared_ptr<MemoryBlock> >* staleBlocks;
+  std::vector<CapturedPage> capturedPages;
   string compressedSync;
+  NetStatsCounters* stats;
 
   SyncProcessor(nsm::Sync* _sync,
                 std::list<std::pair<unsigned char *,int> >* _syncPacketQueue,
                 int _syncTransferSeconds,
-                bool* _syncReadyPtr) :
+                bool* _syncReadyPtr,
+                std::vector<std::shared_ptr<MemoryBlock> >* _staleBlocks,
+                std::vector<CapturedPage>&& _capturedPages,
+                NetStatsCounters* _stats) :
     sync(_sync),
     syncPacketQueue(_syncPacketQueue),
     syncTransferSeconds(_syncTransferSeconds),
-    syncReadyPtr(_syncReadyPtr) {
+    syncReadyPtr(_syncReadyPtr),
+    staleBlocks(_staleBlocks),
+    capturedPages(std::move(_capturedPages)),
+    stats(_stats) {
     *syncReadyPtr = false;
   }
 
   void operator()() {
+    std::chrono::time_point<std::chrono::steady_clock> encodeStart =
+      std::chrono::steady_clock::now();
+    long long rawBytes = 0;
+    // Encode the captured pages against their stale snapshots here, off
+    // the emulation thread: its sync pause is bounded by the page
+    // capture, not the codec
+    sync->clear_block();
+    for(int i=0; i<int(capturedPages.size()); )
+    {
+      int blockIndex = capturedPages[i].blockIndex;
+      MemoryBlock &staleBlock = *((*staleBlocks)[blockIndex]);
+
+      // Rebuild the full block view; a clean leaf hash means the page
+      // still matches the stale snapshot
+      std::vector<unsigned char> blockView(staleBlock.data, staleBlock.data + staleBlock.size);
+      for(; i<int(capturedPages.size()) && capturedPages[i].blockIndex==blockIndex; i++)
+      {
+        CapturedPage &page = capturedPages[i];
+        memcpy(&blockView[page.offset], &(page.data[0]), page.data.size());
+      }
+
+      nsm::SyncBlock* syncBlock = sync->add_block();
+      syncBlock->set_index(blockIndex);
+      Common::xorDeltaEncode(&blockView[0], staleBlock.data, staleBlock.size,
+                             syncBlock->mutable_data());
+      rawBytes += staleBlock.size;
+
+      // Land the dirty pages into the stale snapshot
+      memcpy(staleBlock.data, &blockView[0], staleBlock.size);
+    }
+    capturedPages.clear();
+
     {
       StringOutputStream sos(&compressedSync);
       {
         LzmaOutputStream los(&sos);
-        los.ChangeEncodingOptions(4);
+        // Fast profile: hash-chain match finder, short fast bytes, 1MB
+        // dictionary.  The delta payload is run-length encoded already,
+        // so the aggressive default settings buy almost nothing while
+        // costing several times the encode speed.
+        los.ChangeEncodingOptions(2, 1u << 20, 0, 2, 2, /*algo*/ 0, /*fb*/ 32, /*btMode*/ 0);
         sync->SerializeToZeroCopyStream(&los);
         los.Flush();
       }
@@ -730,6 +840,14 @@ public:
     unsigned char* compressedBuffer = (unsigned char*)&compressedSync[0];
     int compressedSize = (int)compressedSync.length();
     printf("SYNC SIZE: %d\n",compressedSize);
+
+    long long encodeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - encodeStart).count();
+    stats->syncBytesRaw.fetch_add(rawBytes, std::memory_order_relaxed);
+    stats->syncBytesCompressed.fetch_add(compressedSize, std::memory_order_relaxed);
+    stats->syncCount.fetch_add(1, std::memory_order_relaxed);
+    stats->lastSyncDurationMs.store(encodeMs, std::memory_order_relaxed);
+    stats->totalSyncDurationMs.fetch_add(encodeMs, std::memory_order_relaxed);
     if(compressedSize > 16*1024*1024) { // If bigger than 16MB, don't even bother.
       ((Server*)netServer)->syncOverride = true;
       return;
@@ -818,6 +936,13 @@ public:
 
 bool Server::sync(running_machine *machine)
 {
+  // Don't start a periodic sync while an initial snapshot is still
+  // streaming: its stale base has to reach the new client first
+  if (initialSyncThread || initialSyncPacketQueue.size()) {
+    cout << "DELAYING SYNC: INITIAL SYNC STILL STREAMING\n";
+    return true;
+  }
+
   // Finish any old sync thread
   if (syncThread) {
     syncThread->join();
@@ -853,6 +978,11 @@ bool Server::sync(running_machine *machine)
   unsigned char xorChecksum=0;
   unsigned char staleChecksum=0;
   unsigned char allStaleChecksum=0;
+  std::vector<CapturedPage> capturedPages;
+  if(int(pageHashes.size()) != int(blocks.size()))
+  {
+    pageHashes.resize(blocks.size());
+  }
   for(int blockIndex=0; blockIndex<int(blocks.size()); blockIndex++)
   {
     MemoryBlock &block = *(blocks[blockIndex]);
@@ -864,9 +994,26 @@ bool Server::sync(running_machine *machine)
       cout << "BLOCK SIZE MISMATCH: " << blockIndex << ": " << block.size << " " << staleBlock.size << " " << initialBlock.size << endl;;
     }
 
+    // Recompute the leaf hashes; a block is dirty when any 4K page digest
+    // moved, and only those pages need to be captured
+    int numPages = (block.size + SYNC_PAGE_SIZE - 1) / SYNC_PAGE_SIZE;
+    if(int(pageHashes[blockIndex].size()) != numPages)
+    {
+      pageHashes[blockIndex].resize(numPages, 0);
+    }
     bool dirty=false;
-    if(syncCount==0 || memcmp(block.data, staleBlock.data, block.size)) {
-      dirty = true;
+    std::vector<int> dirtyPages;
+    for(int page=0; page<numPages; page++)
+    {
+      int pageOffset = page*SYNC_PAGE_SIZE;
+      int pageSize = min(SYNC_PAGE_SIZE, block.size - pageOffset);
+      unsigned int leafHash = blockHash(block.data + pageOffset, pageSize);
+      if(syncCount==0 || leafHash != pageHashes[blockIndex][page])
+      {
+        dirty = true;
+        dirtyPages.push_back(page);
+        pageHashes[blockIndex][page] = leafHash;
+      }
     }
     if(dirty)
     {
@@ -889,26 +1036,47 @@ bool Server::sync(running_machine *machine)
 
     if(dirty)
     {
-      bytesSynched += block.size;
-      nsm::SyncBlock* syncBlock = syncProto.add_block();
-      syncBlock->set_index(blockIndex);
-      string* s = syncBlock->mutable_data();
-      for(int a=0;a<block.size;a++)
+      if(syncCount==0)
       {
-        s->append(1, block.data[a] ^ staleBlock.data[a]);
+        // The first sync is never sent, so just seed the stale snapshot
+        memcpy(staleBlock.data,block.data,block.size);
+        bytesSynched += block.size;
+      }
+      else
+      {
+        // Capture only the pages whose leaf hash moved; the delta encode
+        // against the stale snapshot and the stale update happen on the
+        // sync thread
+        for(int a=0; a<int(dirtyPages.size()); a++)
+        {
+          int pageOffset = dirtyPages[a]*SYNC_PAGE_SIZE;
+          int pageSize = min(SYNC_PAGE_SIZE, block.size - pageOffset);
+          capturedPages.push_back(CapturedPage());
+          CapturedPage &captured = capturedPages.back();
+          captured.blockIndex = blockIndex;
+          captured.offset = pageOffset;
+          captured.data.assign(block.data + pageOffset,
+                               block.data + pageOffset + pageSize);
+          bytesSynched += pageSize;
+        }
       }
-
-      // Put the current block into stale blocks
-      memcpy(staleBlock.data,block.data,block.size);
     }
     //cout << "BLOCK " << blockIndex << ": ";
+    // the stale block will equal the live block once the sync thread
+    // lands the capture, so fold the live data in for dirty blocks
+    const unsigned char *staleData = dirty ? block.data : staleBlock.data;
     for(int a=0; a<block.size; a++)
     {
-      allStaleChecksum = allStaleChecksum ^ staleBlock.data[a];
+      allStaleChecksum = allStaleChecksum ^ staleData[a];
     }
     //cout << int(allStaleChecksum) << endl;
   }
 
+  // Snapshot this sync point's page digests for desync bisection; the
+  // leaf hashes are current for every page after the loop above
+  recordChecksumRing(generation, machine->machine_time().seconds(),
+                     machine->machine_time().attoseconds(), pageHashes);
+
     printf("BLOCK CHECKSUM: %d\n",int(blockChecksum));
     printf("XOR CHECKSUM: %d\n",int(xorChecksum));
     printf("STALE CHECKSUM (dirty): %d\n",int(staleChecksum));
@@ -916,8 +1084,10 @@ bool Server::sync(running_machine *machine)
   if(syncCount>0) // The first sync is not sent to clients
   {
     SyncProcessor syncProcessor(&syncProto, &syncPacketQueue,
-                                syncTransferSeconds, &syncReady);
-    syncThread = std::shared_ptr<std::thread>(new std::thread(syncProcessor));
+                                syncTransferSeconds, &syncReady,
+                                &staleBlocks, std::move(capturedPages),
+                                &netStats);
+    syncThread = std::shared_ptr<std::thread>(new std::thread(std::move(syncProcessor)));
 
 
   }
@@ -975,16 +1145,59 @@ void Server::popSyncQueue()
     syncPacketQueue.pop_front();
     cout << "PACKET HEADER: " << int(syncPacket.first[0]) << " SIZE " << syncPacket.second << endl;
 
-    // TODO: Found memory corruption when waiting to send, either
-    // change all of these to immediate or find the corruption.
+    // MEDIUM priority keeps the bulk sync stream strictly underneath the
+    // input lane: RakNet drains higher-priority datagrams first, so a
+    // multi-megabyte sync never delays input delivery.  The packet data
+    // lives in syncBuffer, which stays pinned until the whole queue has
+    // drained, so sending below IMMEDIATE is safe here.
     rakInterface->Send(
       (const char*)syncPacket.first,
       syncPacket.second,
-      IMMEDIATE_PRIORITY,
+      MEDIUM_PRIORITY,
       RELIABLE_ORDERED,
       ORDERING_CHANNEL_SYNC,
       RakNet::UNASSIGNED_SYSTEM_ADDRESS,
       true
       );
+    netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(syncPacket.second, std::memory_order_relaxed);
+  }
+}
+
+void Server::popInitialSyncQueue()
+{
+  if(!initialSyncReady)
+    return;
+
+  if(initialSyncPacketQueue.size())
+  {
+    pair<unsigned char *,int> chunk = initialSyncPacketQueue.front();
+    initialSyncPacketQueue.pop_front();
+
+    unsigned char header = initialSyncPacketQueue.empty() ?
+      ID_INITIAL_SYNC_COMPLETE : ID_INITIAL_SYNC_PARTIAL;
+    RakNet::BitStream bitStreamPart(chunk.second+32);
+    bitStreamPart.WriteBits((const unsigned char*)&header,8*sizeof(unsigned char));
+    bitStreamPart.WriteBits(chunk.first,8*chunk.second);
+    // Initial snapshot chunks ride the same below-inputs lane as the
+    // periodic sync; the stream buffer is pinned until the queue drains
+    rakInterface->Send(
+      &bitStreamPart,
+      MEDIUM_PRIORITY,
+      RELIABLE_ORDERED,
+      ORDERING_CHANNEL_SYNC,
+      initialSyncGuid,
+      false
+      );
+    netStats.channelBytesSent[ORDERING_CHANNEL_SYNC].fetch_add(1+chunk.second, std::memory_order_relaxed);
+
+    if(initialSyncPacketQueue.empty())
+    {
+      cout << "FINISHED SENDING BLOCKS TO CLIENT\n";
+      if(initialSyncThread)
+      {
+        initialSyncThread->join();
+        initialSyncThread.reset();
+      }
+    }
   }
 }
@@ -54,6 +54,20 @@ class Server : public Common
   bool syncReady;
   nsm::Sync syncProto;
 
+  // Per-block leaf hashes over 4K pages; a block is dirty when any leaf
+  // moved, and only the dirty pages are captured for the sync thread
+  std::vector<std::vector<unsigned int> > pageHashes;
+
+  // Initial sync streaming: the snapshot is captured on the emulation
+  // thread but compressed and chunked on a worker, then drained to the
+  // joining client a packet at a time
+  std::shared_ptr<std::thread> initialSyncThread;
+  bool initialSyncReady;
+  nsm::InitialSync initialSyncProto;
+  RakNet::RakNetGUID initialSyncGuid;
+  std::string initialSyncStream;
+  std::list<std::pair<unsigned char *,int> > initialSyncPacketQueue;
+
  public:
   Server(std::string _username,int _port, int _unmeasuredNoise, bool _rollback);
 
@@ -79,6 +93,8 @@ class Server : public Common
 
   virtual void popSyncQueue();
 
+  void popInitialSyncQueue();
+
   virtual void setSyncTransferTime(int _syncTransferSeconds)
   {
     syncTransferSeconds = _syncTransferSeconds;
@@ -29,16 +29,40 @@ output_manager::output_item::output_item(
 	, m_name(std::move(name))
 	, m_id(id)
 	, m_value(value)
+	, m_delivered(value)
+	, m_pending(false)
 	, m_notifylist()
 {
 }
 
 
+void output_manager::output_item::set(s32 value)
+{
+	if (m_value == value)
+		return;
+
+	// in deferred mode just record the value; the change is delivered in
+	// one batch at end of frame
+	if (m_manager.m_deferring)
+	{
+		m_value = value;
+		if (!m_pending)
+		{
+			m_pending = true;
+			m_manager.m_pending_items.push_back(this);
+		}
+	}
+	else
+		notify(value);
+}
+
+
 void output_manager::output_item::notify(s32 value)
 {
 	if (OUTPUT_VERBOSE)
 		m_manager.machine().logerror("Output %s = %d (was %d)\n", m_name, value, m_value);
 	m_value = value;
+	m_delivered = value;
 
 	// call the local notifiers first
 	for (auto const &notify : m_notifylist)
@@ -73,11 +97,15 @@ void output_manager::item_proxy::resolve(device_t &device, std::string const &na
 
 output_manager::output_manager(running_machine &machine)
 	: m_machine(machine),
+		m_deferring(false),
 		m_uniqueid(12345)
 {
 	/* add pause callback */
 	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&output_manager::pause, this));
 	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&output_manager::resume, this));
+
+	/* deliver batched output changes once per frame */
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&output_manager::deliver_deferred, this));
 }
 
 /*-------------------------------------------------
@@ -129,6 +157,40 @@ void output_manager::resume()
 }
 
 
+/*-------------------------------------------------
+    set_deferred_delivery - enable or disable
+    batched end-of-frame notification delivery
+-------------------------------------------------*/
+
+void output_manager::set_deferred_delivery(bool defer)
+{
+	// flush whatever is still queued when switching back to immediate mode
+	if (!defer)
+		deliver_deferred();
+	m_deferring = defer;
+}
+
+
+/*-------------------------------------------------
+    deliver_deferred - deliver one notification
+    per output changed since the last delivery
+-------------------------------------------------*/
+
+void output_manager::deliver_deferred()
+{
+	std::vector<output_item *> pending;
+	pending.swap(m_pending_items);
+	for (output_item *item : pending)
+	{
+		item->clear_pending();
+
+		// intermediate toggles collapse; only a net change is delivered
+		if (item->delivered() != item->get())
+			item->notify(item->get());
+	}
+}
+
+
 /*-------------------------------------------------
     output_set_value - set the value of an output
 -------------------------------------------------*/
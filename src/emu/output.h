@@ -64,8 +64,10 @@ private:
 		std::string const &name() const { return m_name; }
 		u32 id() const { return m_id; }
 		s32 get() const { return m_value; }
-		void set(s32 value) { if (m_value != value) { notify(value); } }
+		s32 delivered() const { return m_delivered; }
+		void set(s32 value);
 		void notify(s32 value);
+		void clear_pending() { m_pending = false; }
 
 		void set_notifier(output_notifier_func callback, void *param) { m_notifylist.emplace_back(callback, param); }
 
@@ -74,6 +76,8 @@ private:
 		std::string const   m_name;         // string name of the item
 		u32 const           m_id;           // unique ID for this item
 		s32                 m_value;        // current value
+		s32                 m_delivered;    // last value delivered to notifiers
+		bool                m_pending;      // queued for deferred delivery?
 		notify_vector       m_notifylist;   // list of notifier callbacks
 	};
 
@@ -182,6 +186,15 @@ public:
 	void pause();
 	void resume();
 
+	// batched delivery: while enabled, value changes are recorded
+	// immediately but notifiers run once per changed output at end of
+	// frame, with intermediate toggles collapsed to the net change.
+	// meant for bridges that subscribe to every output on output-heavy
+	// drivers; disabling flushes anything still pending
+	void set_deferred_delivery(bool defer);
+	bool deferring_delivery() const { return m_deferring; }
+	void deliver_deferred();
+
 private:
 	// set an indexed value for an output (concatenates basename + index)
 	void set_indexed_value(const char *basename, int index, int value);
@@ -194,6 +207,8 @@ private:
 	running_machine &m_machine;                  // reference to our machine
 	std::unordered_map<std::string, output_item> m_itemtable;
 	notify_vector m_global_notifylist;
+	std::vector<output_item *> m_pending_items;  // items awaiting deferred delivery
+	bool m_deferring;                            // batch notifications until end of frame?
 	u32 m_uniqueid;
 };
 
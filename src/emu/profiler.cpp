@@ -24,6 +24,8 @@
 #include "emu.h"
 #include "profiler.h"
 
+#include <chrono>
+
 
 
 //**************************************************************************
@@ -37,6 +39,42 @@ struct profile_string
 };
 
 
+//**************************************************************************
+//  PROFILE TYPE NAMES
+//**************************************************************************
+
+static const profile_string s_names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
+
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -77,6 +115,10 @@ dummy_profiler_state::dummy_profiler_state()
 //-------------------------------------------------
 
 real_profiler_state::real_profiler_state()
+	: m_current_scope(PROFILER_TOTAL)
+	, m_sampling(false)
+	, m_sample_count(0)
+	, m_sample_consumed(0)
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
@@ -84,6 +126,16 @@ real_profiler_state::real_profiler_state()
 }
 
 
+//-------------------------------------------------
+//  ~real_profiler_state - destructor
+//-------------------------------------------------
+
+real_profiler_state::~real_profiler_state()
+{
+	stop_sampling();
+}
+
+
 
 //-------------------------------------------------
 //  reset - initializes state
@@ -101,9 +153,14 @@ void real_profiler_state::reset(bool enabled)
 		// set up dummy entry
 		m_filoptr->start = 0;
 		m_filoptr->type = PROFILER_TOTAL;
+
+		// spin up the sampler alongside the instrumented counters
+		start_sampling();
 	}
 	else
 	{
+		stop_sampling();
+
 		// magic value to indicate disabled
 		m_filoptr = nullptr;
 	}
@@ -141,37 +198,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	u64 computed = 0;
 	profile_type curtype;
@@ -213,19 +239,324 @@ void real_profiler_state::update_text(running_machine &machine)
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
 				util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
 			else
-				for (auto & name : names)
-					if (name.type == curtype)
-					{
-						stream << name.string;
-						break;
-					}
+				stream << type_string(curtype);
 
 			// followed by a carriage return
 			stream << '\n';
 		}
 	}
 
+	// fold in what the sampler saw since the last update
+	if (sampling())
+	{
+		u32 const latest = m_sample_count.load(std::memory_order_acquire);
+		u32 first = m_sample_consumed;
+		if (latest - first > MAX_SAMPLES)
+			first = latest - MAX_SAMPLES;
+		if (latest != first)
+		{
+			u32 histogram[PROFILER_TOTAL + 1] = { 0 };
+			for (u32 index = first; index != latest; index++)
+				histogram[m_samples[index % MAX_SAMPLES]]++;
+
+			stream << "\nSampled @" << SAMPLE_RATE << "Hz:\n";
+			u32 const window = latest - first;
+			for (curtype = PROFILER_DEVICE_FIRST; curtype <= PROFILER_TOTAL; ++curtype)
+				if (histogram[curtype] != 0)
+				{
+					util::stream_format(stream, "%02d%% ", (int)((u64(histogram[curtype]) * 100 + window / 2) / window));
+					if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
+						util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
+					else
+						stream << type_string(curtype);
+					stream << '\n';
+				}
+		}
+		m_sample_consumed = latest;
+	}
+
 	// reset data set to 0
 	memset(m_data, 0, sizeof(m_data));
 	m_text = stream.str();
 }
+
+
+
+//-------------------------------------------------
+//  type_string - return the display name for a
+//  non-device profile type
+//-------------------------------------------------
+
+const char *real_profiler_state::type_string(profile_type type)
+{
+	for (auto &name : s_names)
+		if (name.type == type)
+			return name.string;
+	return "Outside Timeslice";
+}
+
+
+
+//**************************************************************************
+//  SAMPLING
+//**************************************************************************
+
+//-------------------------------------------------
+//  start_sampling - launch the sampler thread;
+//  the emulation thread only ever pays one
+//  relaxed store per scope transition
+//-------------------------------------------------
+
+void real_profiler_state::start_sampling()
+{
+	if (sampling())
+		return;
+
+	if (!m_samples)
+		m_samples = std::make_unique<s32[]>(MAX_SAMPLES);
+	m_sample_count.store(0, std::memory_order_relaxed);
+	m_sample_consumed = 0;
+	m_sampling.store(true, std::memory_order_release);
+	m_sampler = std::make_unique<std::thread>(&real_profiler_state::sampler_thread, this);
+}
+
+
+//-------------------------------------------------
+//  stop_sampling - shut down the sampler thread;
+//  captured samples remain available for dumping
+//-------------------------------------------------
+
+void real_profiler_state::stop_sampling()
+{
+	if (!sampling())
+		return;
+
+	m_sampling.store(false, std::memory_order_release);
+	m_sampler->join();
+	m_sampler.reset();
+}
+
+
+//-------------------------------------------------
+//  sampler_thread - periodically record the
+//  emulation thread's innermost profiler scope
+//  into the single-producer ring
+//-------------------------------------------------
+
+void real_profiler_state::sampler_thread()
+{
+	std::chrono::nanoseconds const period(1000000000 / SAMPLE_RATE);
+	auto next = std::chrono::steady_clock::now() + period;
+	while (m_sampling.load(std::memory_order_acquire))
+	{
+		// write the slot first, then publish the new count
+		u32 const count = m_sample_count.load(std::memory_order_relaxed);
+		m_samples[count % MAX_SAMPLES] = m_current_scope.load(std::memory_order_relaxed);
+		m_sample_count.store(count + 1, std::memory_order_release);
+
+		std::this_thread::sleep_until(next);
+		next += period;
+	}
+}
+
+
+//-------------------------------------------------
+//  dump_samples - write the captured sample
+//  timeline to a file for offline analysis
+//-------------------------------------------------
+
+bool real_profiler_state::dump_samples(const char *filename)
+{
+	u32 const latest = m_sample_count.load(std::memory_order_acquire);
+	u32 const first = (latest > MAX_SAMPLES) ? (latest - MAX_SAMPLES) : 0;
+	if (latest == first)
+		return false;
+
+	FILE *file = fopen(filename, "w");
+	if (file == nullptr)
+		return false;
+
+	// one line per sample, oldest first; device scopes dump as an index
+	// that matches the machine's device iteration order
+	fprintf(file, "# %u samples @ %dHz, first sample index %u\n", latest - first, SAMPLE_RATE, first);
+	for (u32 index = first; index != latest; index++)
+	{
+		s32 const type = m_samples[index % MAX_SAMPLES];
+		if (type >= PROFILER_DEVICE_FIRST && type <= PROFILER_DEVICE_MAX)
+			fprintf(file, "device %d\n", type - PROFILER_DEVICE_FIRST);
+		else
+			fprintf(file, "%s\n", type_string(profile_type(type)));
+	}
+	fclose(file);
+	return true;
+}
+
+
+
+//**************************************************************************
+//  TRACE EVENT RECORDING
+//**************************************************************************
+
+#ifdef MAME_TRACE_EVENTS
+
+trace_recorder g_tracer;
+
+
+//-------------------------------------------------
+//  trace_recorder - constructor; honors the
+//  MAME_TRACE_FILE environment variable so traces
+//  can be captured without code changes
+//-------------------------------------------------
+
+trace_recorder::trace_recorder()
+	: m_enabled(false)
+	, m_exiting(false)
+	, m_file(nullptr)
+{
+	const char *filename = getenv("MAME_TRACE_FILE");
+	if (filename != nullptr && filename[0] != 0)
+		start(filename);
+}
+
+
+//-------------------------------------------------
+//  ~trace_recorder - destructor
+//-------------------------------------------------
+
+trace_recorder::~trace_recorder()
+{
+	stop();
+}
+
+
+//-------------------------------------------------
+//  start - open the output file and launch the
+//  background writer
+//-------------------------------------------------
+
+void trace_recorder::start(const char *filename)
+{
+	if (enabled())
+		return;
+
+	m_file = fopen(filename, "w");
+	if (m_file == nullptr)
+		return;
+	fputs("[\n", m_file);
+
+	m_exiting = false;
+	m_buffer.reserve(MAX_BUFFERED_EVENTS);
+	m_writer = std::make_unique<std::thread>(&trace_recorder::writer_thread, this);
+	m_enabled.store(true, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  stop - flush pending events and close the file
+//-------------------------------------------------
+
+void trace_recorder::stop()
+{
+	if (!enabled())
+		return;
+
+	m_enabled.store(false, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_exiting = true;
+	}
+	m_wake.notify_one();
+	m_writer->join();
+	m_writer.reset();
+
+	// terminate the JSON array; chrome://tracing accepts the dummy entry
+	fputs("{}]\n", m_file);
+	fclose(m_file);
+	m_file = nullptr;
+}
+
+
+//-------------------------------------------------
+//  record - buffer one complete event; events
+//  beyond the buffer cap are dropped so a stalled
+//  writer cannot grow memory or block emulation
+//-------------------------------------------------
+
+void trace_recorder::record(const char *name, osd_ticks_t start, osd_ticks_t end)
+{
+	if (!enabled())
+		return;
+
+	bool wake = false;
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		if (m_buffer.size() < MAX_BUFFERED_EVENTS)
+		{
+			m_buffer.push_back(event{ name, start, end - start });
+			wake = (m_buffer.size() >= MAX_BUFFERED_EVENTS / 2);
+		}
+	}
+	if (wake)
+		m_wake.notify_one();
+}
+
+
+//-------------------------------------------------
+//  writer_thread - drain buffered events to the
+//  file off the emulation thread
+//-------------------------------------------------
+
+void trace_recorder::writer_thread()
+{
+	std::vector<event> pending;
+	pending.reserve(MAX_BUFFERED_EVENTS);
+
+	std::unique_lock<std::mutex> guard(m_lock);
+	while (true)
+	{
+		m_wake.wait_for(guard, std::chrono::milliseconds(100));
+		bool const exiting = m_exiting;
+		m_buffer.swap(pending);
+
+		guard.unlock();
+		write_events(pending);
+		pending.clear();
+		guard.lock();
+
+		if (exiting)
+			return;
+	}
+}
+
+
+//-------------------------------------------------
+//  write_events - emit events as chrome://tracing
+//  complete ("X") events with microsecond stamps
+//-------------------------------------------------
+
+void trace_recorder::write_events(std::vector<event> &events)
+{
+	if (events.empty())
+		return;
+
+	osd_ticks_t const tps = osd_ticks_per_second();
+	for (auto &ev : events)
+	{
+		u64 ts, dur;
+		if (tps >= 1000000)
+		{
+			ts = ev.start / (tps / 1000000);
+			dur = ev.duration / (tps / 1000000);
+		}
+		else
+		{
+			ts = ev.start * 1000000 / tps;
+			dur = ev.duration * 1000000 / tps;
+		}
+		fprintf(m_file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%llu},\n",
+				ev.name, (unsigned long long)ts, (unsigned long long)dur);
+	}
+	fflush(m_file);
+}
+
+#endif // MAME_TRACE_EVENTS
@@ -26,6 +26,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -84,6 +91,7 @@ class real_profiler_state
 public:
 	// construction/destruction
 	real_profiler_state();
+	~real_profiler_state();
 
 	// getters
 	bool enabled() const
@@ -105,9 +113,17 @@ public:
 	void start(profile_type type) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// sampling mode
+	bool sampling() const { return m_sampling.load(std::memory_order_relaxed); }
+	bool dump_samples(const char *filename);
+
 private:
 	void reset(bool enabled);
 	void update_text(running_machine &machine);
+	void start_sampling();
+	void stop_sampling();
+	void sampler_thread();
+	static const char *type_string(profile_type type);
 
 	//-------------------------------------------------
 	//  real_start - mark the beginning of a
@@ -131,6 +147,9 @@ private:
 		// fill in this entry
 		m_filoptr->type = type;
 		m_filoptr->start = curticks;
+
+		// publish the innermost scope for the sampler thread
+		m_current_scope.store(type, std::memory_order_relaxed);
 	}
 
 	//-------------------------------------------------
@@ -153,6 +172,9 @@ private:
 
 		// reset previous entry start time
 		m_filoptr->start = curticks;
+
+		// publish the scope we fell back to for the sampler thread
+		m_current_scope.store(m_filoptr->type, std::memory_order_relaxed);
 	}
 
 	// an entry in the FILO
@@ -168,6 +190,19 @@ private:
 	attotime            m_text_time;                // profiler text last update
 	filo_entry          m_filo[32];                 // array of FILO entries
 	osd_ticks_t         m_data[PROFILER_TOTAL + 1]; // array of data
+
+	// sampling state; the emulation thread publishes its innermost scope
+	// with a single relaxed store and the sampler thread records it into a
+	// single-producer ring, so neither side ever takes a lock
+	static constexpr int SAMPLE_RATE = 4000;        // samples per second
+	static constexpr u32 MAX_SAMPLES = 1 << 20;     // ring size; oldest samples are overwritten
+
+	std::atomic<s32>    m_current_scope;            // innermost active profile_type
+	std::atomic<bool>   m_sampling;                 // true while the sampler thread runs
+	std::atomic<u32>    m_sample_count;             // total samples taken (monotonic)
+	u32                 m_sample_consumed;          // samples already folded into the display
+	std::unique_ptr<s32[]> m_samples;               // sample ring, allocated on first use
+	std::unique_ptr<std::thread> m_sampler;         // sampler thread
 };
 
 
@@ -209,4 +244,93 @@ typedef dummy_profiler_state profiler_state;
 extern profiler_state g_profiler;
 
 
+
+//**************************************************************************
+//  TRACE EVENT RECORDING
+//**************************************************************************
+
+// Chrome trace (chrome://tracing / Perfetto) event export. Hook points are
+// wrapped in TRACE_EVENT_SCOPE, which compiles to nothing unless the build
+// defines MAME_TRACE_EVENTS; when compiled in, recording starts if the
+// MAME_TRACE_FILE environment variable names an output file.
+
+#ifdef MAME_TRACE_EVENTS
+
+class trace_recorder
+{
+public:
+	// construction/destruction
+	trace_recorder();
+	~trace_recorder();
+
+	// getters
+	bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+	// start/stop
+	void start(const char *filename);
+	void stop();
+
+	// record one complete event; start/end are get_profile_ticks() values
+	void record(const char *name, osd_ticks_t start, osd_ticks_t end);
+
+	// RAII helper emitting one complete event for the enclosing scope
+	class scope
+	{
+	public:
+		scope(trace_recorder &recorder, const char *name)
+			: m_recorder(recorder)
+			, m_name(name)
+			, m_start(recorder.enabled() ? get_profile_ticks() : 0)
+		{
+		}
+
+		~scope()
+		{
+			if (m_start != 0)
+				m_recorder.record(m_name, m_start, get_profile_ticks());
+		}
+
+	private:
+		trace_recorder &    m_recorder;
+		const char *        m_name;
+		osd_ticks_t         m_start;
+	};
+
+private:
+	// a buffered event; names must be string literals
+	struct event
+	{
+		const char *    name;
+		osd_ticks_t     start;
+		osd_ticks_t     duration;
+	};
+
+	// internal helpers
+	void writer_thread();
+	void write_events(std::vector<event> &events);
+
+	// internal state
+	std::atomic<bool>   m_enabled;                  // accepting events?
+	bool                m_exiting;                  // writer shutdown requested (under m_lock)
+	FILE *              m_file;                     // output file, owned by the writer
+	std::vector<event>  m_buffer;                   // events awaiting the writer (under m_lock)
+	std::mutex          m_lock;                     // protects m_buffer/m_exiting
+	std::condition_variable m_wake;                 // kicks the writer
+	std::unique_ptr<std::thread> m_writer;          // background writer thread
+
+	// constants
+	static constexpr size_t MAX_BUFFERED_EVENTS = 65536;    // events are dropped beyond this
+};
+
+extern trace_recorder g_tracer;
+
+#define TRACE_EVENT_SCOPE(name) trace_recorder::scope _trace_scope(g_tracer, name)
+
+#else
+
+#define TRACE_EVENT_SCOPE(name)
+
+#endif
+
+
 #endif  /* MAME_EMU_PROFILER_H */
@@ -49,6 +49,8 @@
 
 #include <zlib.h>
 
+#include <thread>
+
 #include <algorithm>
 #include <functional>
 
@@ -59,6 +61,7 @@
 //**************************************************************************
 
 #define INTERNAL_FLAG_CHAR      0x00000001
+#define INTERNAL_FLAG_QUAD_UV   0x00000002
 
 enum
 {
@@ -92,6 +95,17 @@ struct render_target::object_transform
 	bool                no_center;          // center the container?
 };
 
+// a primitive_work entry describes one layout item awaiting primitive
+// generation; entries are kept in draw order
+struct render_target::primitive_work
+{
+	render_container *  container;          // container to process, or nullptr for an element
+	layout_element *    element;            // element to process when container is nullptr
+	int                 state;              // element state
+	object_transform    xform;              // transform for this item
+	int                 blendmode;          // blend mode for this item
+};
+
 
 
 //**************************************************************************
@@ -330,6 +344,7 @@ render_texture::render_texture()
 		m_curseq(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
+	m_dirty.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
 }
 
@@ -382,6 +397,7 @@ void render_texture::release()
 	m_manager->invalidate_all(m_bitmap);
 	m_bitmap = nullptr;
 	m_sbounds.set(0, -1, 0, -1);
+	m_dirty.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
 }
@@ -392,6 +408,18 @@ void render_texture::release()
 //-------------------------------------------------
 
 void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format)
+{
+	// without explicit information, assume the whole source changed
+	set_bitmap(bitmap, sbounds, format, sbounds);
+}
+
+
+//-------------------------------------------------
+//  set_bitmap - set a new source bitmap, noting
+//  the region that changed since the last call
+//-------------------------------------------------
+
+void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle &dirty)
 {
 	assert(bitmap.cliprect().contains(sbounds));
 
@@ -406,6 +434,8 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	// set the new bitmap/palette
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
+	m_dirty = dirty;
+	m_dirty &= sbounds;
 	m_format = format;
 
 	// invalidate all scaled versions
@@ -465,6 +495,20 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.rowpixels = m_bitmap->rowpixels();
 		texinfo.width = swidth;
 		texinfo.height = sheight;
+
+		// carry along the changed region, rebased to the texture; fall back
+		// to the full height if we have no usable information
+		if (!m_dirty.empty())
+		{
+			texinfo.dirty_top = m_dirty.top() - m_sbounds.top();
+			texinfo.dirty_bottom = m_dirty.bottom() - m_sbounds.top();
+		}
+		else
+		{
+			texinfo.dirty_top = 0;
+			texinfo.dirty_bottom = sheight - 1;
+		}
+
 		// palette will be set later
 		texinfo.seqid = ++m_curseq;
 	}
@@ -519,6 +563,11 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.rowpixels = scaled->bitmap->rowpixels();
 		texinfo.width = dwidth;
 		texinfo.height = dheight;
+
+		// the scaler regenerates the whole bitmap
+		texinfo.dirty_top = 0;
+		texinfo.dirty_bottom = dheight - 1;
+
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
 	}
@@ -530,7 +579,7 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 //  palette for a texture
 //-------------------------------------------------
 
-const rgb_t *render_texture::get_adjusted_palette(render_container &container)
+const rgb_t *render_texture::get_adjusted_palette(render_container &container, u32 &out_length)
 {
 	// override the palette with our adjusted palette
 	switch (m_format)
@@ -541,6 +590,7 @@ const rgb_t *render_texture::get_adjusted_palette(render_container &container)
 			assert(m_bitmap->palette() != nullptr);
 
 			// return our adjusted palette
+			out_length = m_bitmap->palette()->max_index();
 			return container.bcg_lookup_table(m_format, m_bitmap->palette());
 
 		case TEXFORMAT_RGB32:
@@ -548,6 +598,7 @@ const rgb_t *render_texture::get_adjusted_palette(render_container &container)
 		case TEXFORMAT_YUY16:
 
 			// if no adjustment necessary, return nullptr
+			out_length = 0;
 			if (!container.has_brightness_contrast_gamma_changes())
 				return nullptr;
 			return container.bcg_lookup_table(m_format);
@@ -556,6 +607,7 @@ const rgb_t *render_texture::get_adjusted_palette(render_container &container)
 			assert(false);
 	}
 
+	out_length = 0;
 	return nullptr;
 }
 
@@ -670,17 +722,51 @@ void render_container::add_quad(float x0, float y0, float x1, float y1, rgb_t ar
 
 void render_container::add_char(float x0, float y0, float height, float aspect, rgb_t argb, render_font &font, u16 ch)
 {
-	// compute the bounds of the character cell and get the texture
+	// compute the bounds of the character cell and get the texture; glyphs
+	// normally come back as a cell of the shared atlas so consecutive
+	// characters all reference one texture
 	render_bounds bounds;
 	bounds.x0 = x0;
 	bounds.y0 = y0;
-	render_texture *texture = font.get_char_texture_and_bounds(height, aspect, ch, bounds);
+	render_quad_texuv texcoords;
+	bool atlased = false;
+	render_texture *texture = font.get_char_texture_bounds_and_texcoords(height, aspect, ch, bounds, texcoords, atlased);
 
 	// add it like a quad
 	item &newitem = add_generic(CONTAINER_ITEM_QUAD, bounds.x0, bounds.y0, bounds.x1, bounds.y1, argb);
 	newitem.m_texture = texture;
 	newitem.m_flags = PRIMFLAG_TEXORIENT(ROT0) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA) | PRIMFLAG_PACKABLE;
 	newitem.m_internal = INTERNAL_FLAG_CHAR;
+	if (atlased)
+	{
+		newitem.m_texcoords = texcoords;
+		newitem.m_internal |= INTERNAL_FLAG_QUAD_UV;
+	}
+}
+
+
+//-------------------------------------------------
+//  add_string - add a whole UTF-8 string to this
+//  container as a batch of character quads
+//-------------------------------------------------
+
+void render_container::add_string(float x0, float y0, float height, float aspect, rgb_t argb, render_font &font, const char *utf8str)
+{
+	// walk the string, emitting each glyph and advancing by its width
+	float curx = x0;
+	const char *ptr = utf8str;
+	size_t remaining = strlen(utf8str);
+	while (remaining > 0)
+	{
+		char32_t ch;
+		int const used = uchar_from_utf8(&ch, ptr, remaining);
+		if (used <= 0)
+			break;
+		add_char(curx, y0, height, aspect, argb, font, ch);
+		curx += font.char_width(height, aspect, ch);
+		ptr += used;
+		remaining -= used;
+	}
 }
 
 
@@ -1380,6 +1466,10 @@ render_primitive_list &render_target::get_primitives()
 
 	// iterate over layers back-to-front, but only if we're running
 	if (m_manager.machine().phase() >= machine_phase::RESET)
+	{
+		// collect the work in draw order before generating anything
+		std::vector<primitive_work> work;
+		bool source_repeated = false;
 		for (item_layer layernum = ITEM_LAYER_FIRST; layernum < ITEM_LAYER_MAX; ++layernum)
 		{
 			int blendmode;
@@ -1395,27 +1485,84 @@ render_primitive_list &render_target::get_primitives()
 					normalize_bounds(bounds);
 
 					// apply the transform to the item
-					object_transform item_xform;
-					item_xform.xoffs = root_xform.xoffs + bounds.x0 * root_xform.xscale;
-					item_xform.yoffs = root_xform.yoffs + bounds.y0 * root_xform.yscale;
-					item_xform.xscale = (bounds.x1 - bounds.x0) * root_xform.xscale;
-					item_xform.yscale = (bounds.y1 - bounds.y0) * root_xform.yscale;
-					item_xform.color.r = curitem.color().r * root_xform.color.r;
-					item_xform.color.g = curitem.color().g * root_xform.color.g;
-					item_xform.color.b = curitem.color().b * root_xform.color.b;
-					item_xform.color.a = curitem.color().a * root_xform.color.a;
-					item_xform.orientation = orientation_add(curitem.orientation(), root_xform.orientation);
-					item_xform.no_center = false;
+					primitive_work workitem;
+					workitem.xform.xoffs = root_xform.xoffs + bounds.x0 * root_xform.xscale;
+					workitem.xform.yoffs = root_xform.yoffs + bounds.y0 * root_xform.yscale;
+					workitem.xform.xscale = (bounds.x1 - bounds.x0) * root_xform.xscale;
+					workitem.xform.yscale = (bounds.y1 - bounds.y0) * root_xform.yscale;
+					workitem.xform.color.r = curitem.color().r * root_xform.color.r;
+					workitem.xform.color.g = curitem.color().g * root_xform.color.g;
+					workitem.xform.color.b = curitem.color().b * root_xform.color.b;
+					workitem.xform.color.a = curitem.color().a * root_xform.color.a;
+					workitem.xform.orientation = orientation_add(curitem.orientation(), root_xform.orientation);
+					workitem.xform.no_center = false;
+					workitem.blendmode = blendmode;
 
 					// if there is no associated element, it must be a screen element
 					if (curitem.screen() != nullptr)
-						add_container_primitives(list, root_xform, item_xform, curitem.screen()->container(), blendmode);
+					{
+						workitem.container = &curitem.screen()->container();
+						workitem.element = nullptr;
+						workitem.state = 0;
+					}
 					else
-						add_element_primitives(list, item_xform, *curitem.element(), curitem.state(), blendmode);
+					{
+						workitem.container = nullptr;
+						workitem.element = curitem.element();
+						workitem.state = curitem.state();
+					}
+
+					// a container or element shown more than once (cocktail
+					// views, repeated LED/digit elements) shares its texture
+					// cache, so such views must be generated serially
+					for (const primitive_work &previous : work)
+						if ((workitem.container != nullptr && previous.container == workitem.container) ||
+							(workitem.element != nullptr && previous.element == workitem.element))
+							source_repeated = true;
+					work.push_back(workitem);
 				}
 			}
 		}
 
+		// split the work into contiguous chunks across threads when there is
+		// enough to go around; each chunk generates into its own scratch
+		// list and the chunks are spliced back in draw order, so the result
+		// is identical to serial generation
+		size_t numchunks = std::min(work.size(), size_t(NUM_SCRATCH_LISTS + 1));
+		numchunks = std::min(numchunks, size_t(std::thread::hardware_concurrency()));
+		if (source_repeated || numchunks <= 1)
+		{
+			generate_primitives(list, root_xform, work, 0, work.size());
+		}
+		else
+		{
+			size_t const stride = (work.size() + numchunks - 1) / numchunks;
+			std::vector<std::thread> workers;
+			for (size_t chunk = 1; chunk < numchunks; chunk++)
+			{
+				render_primitive_list &scratch = m_scratchlist[chunk - 1];
+				scratch.release_all();
+				size_t const first = std::min(chunk * stride, work.size());
+				size_t const last = std::min(first + stride, work.size());
+				workers.emplace_back([this, &scratch, &root_xform, &work, first, last] { generate_primitives(scratch, root_xform, work, first, last); });
+			}
+
+			// this thread takes the first chunk itself
+			generate_primitives(list, root_xform, work, 0, std::min(stride, work.size()));
+
+			// splice each chunk's primitives and references back in order
+			for (size_t chunk = 1; chunk < numchunks; chunk++)
+			{
+				workers[chunk - 1].join();
+				render_primitive_list &scratch = m_scratchlist[chunk - 1];
+				list.m_primlist.append_list(scratch.m_primlist);
+				for (render_primitive_list::reference *ref = scratch.m_reflist.first(); ref != nullptr; ref = ref->next())
+					list.add_reference(ref->m_refptr);
+				scratch.release_all();
+			}
+		}
+	}
+
 	// if we are not in the running stage, draw an outer box
 	else
 	{
@@ -1480,6 +1627,24 @@ render_primitive_list &render_target::get_primitives()
 }
 
 
+//-------------------------------------------------
+//  generate_primitives - generate primitives for
+//  a contiguous range of collected work items
+//-------------------------------------------------
+
+void render_target::generate_primitives(render_primitive_list &list, const object_transform &root_xform, const std::vector<primitive_work> &work, size_t first, size_t last)
+{
+	for (size_t index = first; index < last; index++)
+	{
+		const primitive_work &workitem = work[index];
+		if (workitem.container != nullptr)
+			add_container_primitives(list, root_xform, workitem.xform, *workitem.container, workitem.blendmode);
+		else
+			add_element_primitives(list, workitem.xform, *workitem.element, workitem.state, workitem.blendmode);
+	}
+}
+
+
 //-------------------------------------------------
 //  map_point_container - attempts to map a point
 //  on the specified render_target to the
@@ -2077,8 +2242,58 @@ bool render_target::load_layout_file(const char *dirname, const char *filename)
 	if (filerr != osd_file::error::NONE)
 		return false;
 
-	// read the file
-	util::xml::file::ptr rootnode(util::xml::file::read(layoutfile, nullptr));
+	// layouts (especially generated artwork) can be large, so parsed trees
+	// are cached in a compiled binary form keyed by the XML CRC and size
+	u32 layout_crc = 0;
+	bool const have_crc = layoutfile.hashes(util::hash_collection::HASH_TYPES_CRC).crc(layout_crc);
+	u64 const layout_size = layoutfile.size();
+	std::string cachename(fname);
+	for (char &ch : cachename)
+		if ((ch == '/') || (ch == '\\') || (ch == ':'))
+			ch = '_';
+	cachename.append(".blc");
+
+	// try to load a matching compiled layout
+	util::xml::file::ptr rootnode;
+	if (have_crc)
+	{
+		emu_file cachefile(m_manager.machine().options().cfg_directory(), OPEN_FLAG_READ);
+		if (cachefile.open(cachename.c_str()) == osd_file::error::NONE)
+		{
+			std::vector<u8> data(std::size_t(cachefile.size()));
+			if ((data.size() > 16) && (cachefile.read(&data[0], u32(data.size())) == data.size()))
+			{
+				// the header carries magic, version, CRC and size of the XML source
+				u32 const *const header = reinterpret_cast<u32 const *>(&data[0]);
+				if ((header[0] == 0x434c5942) && (header[1] == 1) && (header[2] == layout_crc) && (header[3] == u32(layout_size)))
+					rootnode = util::xml::file::deserialize_binary(&data[16], data.size() - 16);
+			}
+			cachefile.close();
+		}
+	}
+
+	// otherwise read and parse the XML, then write the compiled form back
+	if (!rootnode)
+	{
+		rootnode = util::xml::file::read(layoutfile, nullptr);
+		if (rootnode && have_crc)
+		{
+			std::vector<u8> data(16);
+			u32 *const header = reinterpret_cast<u32 *>(&data[0]);
+			header[0] = 0x434c5942;     // 'BYLC'
+			header[1] = 1;              // format version
+			header[2] = layout_crc;
+			header[3] = u32(layout_size);
+			rootnode->serialize_binary(data);
+
+			emu_file cachefile(m_manager.machine().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			if (cachefile.open(cachename.c_str()) == osd_file::error::NONE)
+			{
+				cachefile.write(&data[0], u32(data.size()));
+				cachefile.close();
+			}
+		}
+	}
 
 	// if we didn't get a properly-formatted XML file, record a warning and exit
 	if (!load_layout_file(m_manager.machine().root_device(), dirname, *rootnode))
@@ -2264,13 +2479,38 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					width = std::min(width, m_maxtexwidth);
 					height = std::min(height, m_maxtexheight);
 
-					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
+					// atlas sub-rectangle quads sample the texture at its
+					// native size; everything else scales to the quad size
+					if (curitem.internal() & INTERNAL_FLAG_QUAD_UV)
+						curitem.texture()->get_scaled(curitem.texture()->source_width(), curitem.texture()->source_height(), prim->texture, list, curitem.flags());
+					else
+						curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
 
 					// set the palette
-					prim->texture.palette = curitem.texture()->get_adjusted_palette(container);
+					prim->texture.palette = curitem.texture()->get_adjusted_palette(container, prim->texture.palette_length);
 
-					// determine UV coordinates
-					prim->texcoords = oriented_texcoords[finalorient];
+					// determine UV coordinates; custom sub-rectangle
+					// coordinates are remapped through the orientation
+					// pattern (its entries are all 0 or 1)
+					if (curitem.internal() & INTERNAL_FLAG_QUAD_UV)
+					{
+						render_quad_texuv const &sub = curitem.texcoords();
+						render_quad_texuv const &pattern = oriented_texcoords[finalorient];
+						auto const remap =
+								[&sub] (render_texuv const &uv)
+								{
+									render_texuv result;
+									result.u = sub.tl.u + uv.u * (sub.br.u - sub.tl.u);
+									result.v = sub.tl.v + uv.v * (sub.br.v - sub.tl.v);
+									return result;
+								};
+						prim->texcoords.tl = remap(pattern.tl);
+						prim->texcoords.tr = remap(pattern.tr);
+						prim->texcoords.bl = remap(pattern.bl);
+						prim->texcoords.br = remap(pattern.br);
+					}
+					else
+						prim->texcoords = oriented_texcoords[finalorient];
 
 					// apply clipping
 					clipped = render_clip_quad(&prim->bounds, &cliprect, &prim->texcoords);
@@ -218,6 +218,9 @@ struct render_texinfo
 	u64                 unique_id;          // unique identifier to pass to osd
 	u64                 old_id;             // previously allocated id, if applicable
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
+	u32                 palette_length;     // number of entries in the palette, or 0 if not applicable
+	s32                 dirty_top;          // first row changed since the previous seqid (texture-relative)
+	s32                 dirty_bottom;       // last changed row (inclusive); spans the full height when unknown
 };
 
 
@@ -406,8 +409,8 @@ private:
 	simple_list<render_primitive> m_primlist;               // list of primitives
 	simple_list<reference> m_reflist;                       // list of references
 
-	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
-	fixed_allocator<reference> m_reference_allocator;       // allocator for references
+	arena_allocator<render_primitive> m_primitive_allocator;// arena allocator for primitives
+	arena_allocator<reference> m_reference_allocator;       // arena allocator for references
 
 	std::recursive_mutex     m_lock;                             // lock to protect list accesses
 };
@@ -438,9 +441,12 @@ public:
 	// getters
 	int format() const { return m_format; }
 	render_manager *manager() const { return m_manager; }
+	int source_width() const { return m_sbounds.width(); }
+	int source_height() const { return m_sbounds.height(); }
 
 	// configure the texture bitmap
 	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format);
+	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle &dirty);
 
 	// set a unique identifier
 	void set_id(u64 id) { m_old_id = m_id; m_id = id; }
@@ -451,7 +457,7 @@ public:
 private:
 	// internal helpers
 	void get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, u32 flags = 0);
-	const rgb_t *get_adjusted_palette(render_container &container);
+	const rgb_t *get_adjusted_palette(render_container &container, u32 &out_length);
 
 	static const int MAX_TEXTURE_SCALES = 16;
 
@@ -467,6 +473,7 @@ private:
 	render_texture *    m_next;                     // next texture (for free list)
 	bitmap_t *          m_bitmap;                   // pointer to the original bitmap
 	rectangle           m_sbounds;                  // source bounds within the bitmap
+	rectangle           m_dirty;                    // region changed since the previous set_bitmap
 	texture_format      m_format;                   // format of the texture data
 	u64                 m_id;                       // unique id to pass to osd
 	u64                 m_old_id;                   // previous id, if applicable
@@ -535,6 +542,7 @@ public:
 	void add_line(float x0, float y0, float x1, float y1, float width, rgb_t argb, u32 flags);
 	void add_quad(float x0, float y0, float x1, float y1, rgb_t argb, render_texture *texture, u32 flags);
 	void add_char(float x0, float y0, float height, float aspect, rgb_t argb, render_font &font, u16 ch);
+	void add_string(float x0, float y0, float height, float aspect, rgb_t argb, render_font &font, const char *utf8str);
 	void add_point(float x0, float y0, float diameter, rgb_t argb, u32 flags) { add_line(x0, y0, x0, y0, diameter, argb, flags); }
 	void add_rect(float x0, float y0, float x1, float y1, rgb_t argb, u32 flags) { add_quad(x0, y0, x1, y1, argb, nullptr, flags); }
 
@@ -563,6 +571,7 @@ private:
 		u32 internal() const { return m_internal; }
 		float width() const { return m_width; }
 		render_texture *texture() const { return m_texture; }
+		const render_quad_texuv &texcoords() const { return m_texcoords; }
 
 	private:
 		// internal state
@@ -574,6 +583,7 @@ private:
 		u32                 m_internal;         // internal flags
 		float               m_width;            // width of the line (lines only)
 		render_texture *    m_texture;          // pointer to the source texture (quads only)
+		render_quad_texuv   m_texcoords;        // texture coordinates (atlas sub-rectangle quads only)
 	};
 
 	// generic screen overlay scaler
@@ -1048,6 +1058,7 @@ public:
 private:
 	// private classes declared in render.cpp
 	struct object_transform;
+	struct primitive_work;
 
 	// internal helpers
 	enum constructor_impl_t { CONSTRUCTOR_IMPL };
@@ -1061,6 +1072,7 @@ private:
 	bool load_layout_file(device_t &device, const char *dirname, util::xml::data_node const &rootnode);
 	void add_container_primitives(render_primitive_list &list, const object_transform &root_xform, const object_transform &xform, render_container &container, int blendmode);
 	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode);
+	void generate_primitives(render_primitive_list &list, const object_transform &root_xform, const std::vector<primitive_work> &work, size_t first, size_t last);
 	bool map_point_internal(s32 target_x, s32 target_y, render_container *container, float &mapped_x, float &mapped_y, ioport_port *&mapped_input_port, ioport_value &mapped_input_mask);
 
 	// config callbacks
@@ -1079,6 +1091,7 @@ private:
 
 	// constants
 	static constexpr int NUM_PRIMLISTS = 3;
+	static constexpr int NUM_SCRATCH_LISTS = 3;
 	static constexpr int MAX_CLEAR_EXTENTS = 1000;
 
 	// internal state
@@ -1088,6 +1101,7 @@ private:
 	std::list<layout_file>  m_filelist;                 // list of layout files
 	u32                     m_flags;                    // creation flags
 	render_primitive_list   m_primlist[NUM_PRIMLISTS];  // list of primitives
+	render_primitive_list   m_scratchlist[NUM_SCRATCH_LISTS]; // per-worker output for parallel generation
 	int                     m_listindex;                // index of next primlist to use
 	s32                     m_width;                    // width in pixels
 	s32                     m_height;                   // height in pixels
@@ -14,11 +14,19 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 
 template<typename _PixelType, int _SrcShiftR, int _SrcShiftG, int _SrcShiftB, int _DstShiftR, int _DstShiftG, int _DstShiftB, bool _NoDestRead = false, bool _BilinearFilter = false>
 class software_renderer
 {
 private:
+	// internal constants
+	static constexpr s32 WORK_BAND_MIN_HEIGHT = 64;
+	static constexpr s32 ROTATED_STRIP_WIDTH = 64;
+
 	// internal structs
 	struct quad_setup_data
 	{
@@ -28,6 +36,18 @@ private:
 		s32 endx, endy;
 	};
 
+	// description of one horizontal band of the destination for threaded rendering
+	struct work_band
+	{
+		std::vector<const render_primitive *> prims;    // primitives overlapping this band
+		void *dstdata;
+		u32 width;
+		u32 height;
+		u32 pitch;
+		s32 bandy0;
+		s32 bandy1;
+	};
+
 	// internal helpers
 	static inline bool is_opaque(float alpha) { return (alpha >= (_NoDestRead ? 0.5f : 1.0f)); }
 	static inline bool is_transparent(float alpha) { return (alpha < (_NoDestRead ? 0.5f : 0.0001f)); }
@@ -315,6 +335,31 @@ private:
 	}
 
 
+	//-------------------------------------------------
+	//  compute_u_table - precompute the source column
+	//  index of every destination pixel on a scanline;
+	//  only valid when u does not vary with y, so the
+	//  same table serves every row of the quad
+	//-------------------------------------------------
+
+	static inline bool compute_u_table(const quad_setup_data &setup, std::vector<s32> &utable)
+	{
+		// only worthwhile for axis-aligned nearest-neighbour quads,
+		// where rows advance v alone and each row samples the same columns
+		if (_BilinearFilter || setup.dudy != 0 || setup.dvdx != 0)
+			return false;
+
+		utable.resize(setup.endx - setup.startx);
+		s32 curu = setup.startu;
+		for (s32 &entry : utable)
+		{
+			entry = curu >> 16;
+			curu += setup.dudx;
+		}
+		return true;
+	}
+
+
 	//-------------------------------------------------
 	//  draw_aa_pixel - draw an antialiased pixel
 	//-------------------------------------------------
@@ -334,10 +379,11 @@ private:
 
 
 	//-------------------------------------------------
-	//  draw_line - draw a line or point
+	//  draw_line - draw a line or point, limited
+	//  to the scanlines in [clipy0, clipy1)
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 clipy0, s32 clipy1, u32 pitch)
 	{
 		// internal tables
 		static u32 s_cosine_table[2049];
@@ -382,7 +428,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= clipy0 && dy < clipy1)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -390,11 +436,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= clipy0 && dy < clipy1)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= clipy0 && dy < clipy1)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -414,7 +460,7 @@ private:
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= clipy0 && y1 < clipy1)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -457,7 +503,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= clipy0 && y1 < clipy1)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -473,7 +519,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= clipy0 && y1 < clipy1)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -495,10 +541,11 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw a solid rectangle, limited
+	//  to the scanlines in [clipy0, clipy1)
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 clipy0, s32 clipy1, u32 pitch)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -515,10 +562,10 @@ private:
 		if (startx >= width) startx = width;
 		if (endx < 0) endx = 0;
 		if (endx >= width) endx = width;
-		if (starty < 0) starty = 0;
-		if (starty >= height) starty = height;
-		if (endy < 0) endy = 0;
-		if (endy >= height) endy = height;
+		if (starty < clipy0) starty = clipy0;
+		if (starty > clipy1) starty = clipy1;
+		if (endy < clipy0) endy = clipy0;
+		if (endy > clipy1) endy = clipy1;
 
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
@@ -615,20 +662,40 @@ private:
 		// fast case: no coloring, no alpha
 		if (prim.color.r >= 1.0f && prim.color.g >= 1.0f && prim.color.b >= 1.0f && is_opaque(prim.color.a))
 		{
-			// loop over rows
-			for (s32 y = setup.starty; y < setup.endy; y++)
+			// axis-aligned case: gather each row through a precomputed
+			// column table, advancing only v per scanline
+			std::vector<s32> utable;
+			if (compute_u_table(setup, utable))
 			{
-				_PixelType *dest = dstdata + y * pitch + setup.startx;
-				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
-				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
+				const rgb_t *palbase = prim.texture.palette;
+				for (s32 y = setup.starty; y < setup.endy; y++)
+				{
+					_PixelType *dest = dstdata + y * pitch + setup.startx;
+					s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
+					const u16 *srcrow = reinterpret_cast<const u16 *>(prim.texture.base) + (curv >> 16) * prim.texture.rowpixels;
+					for (s32 uoff : utable)
+						*dest++ = source32_to_dest(palbase[srcrow[uoff]]);
+				}
+			}
 
-				// loop over cols
-				for (s32 x = setup.startx; x < endx; x++)
+			// general case: step 16.16 u/v per pixel
+			else
+			{
+				// loop over rows
+				for (s32 y = setup.starty; y < setup.endy; y++)
 				{
-					u32 pix = get_texel_palette16(prim.texture, curu, curv);
-					*dest++ = source32_to_dest(pix);
-					curu += dudx;
-					curv += dvdx;
+					_PixelType *dest = dstdata + y * pitch + setup.startx;
+					s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
+					s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
+
+					// loop over cols
+					for (s32 x = setup.startx; x < endx; x++)
+					{
+						u32 pix = get_texel_palette16(prim.texture, curu, curv);
+						*dest++ = source32_to_dest(pix);
+						curu += dudx;
+						curv += dvdx;
+					}
 				}
 			}
 		}
@@ -1104,6 +1171,22 @@ private:
 		// fast case: no coloring, no alpha
 		if (prim.color.r >= 1.0f && prim.color.g >= 1.0f && prim.color.b >= 1.0f && is_opaque(prim.color.a))
 		{
+			// axis-aligned no-lookup case: gather each row through a
+			// precomputed column table, advancing only v per scanline
+			std::vector<s32> utable;
+			if (palbase == nullptr && compute_u_table(setup, utable))
+			{
+				for (s32 y = setup.starty; y < setup.endy; y++)
+				{
+					_PixelType *dest = dstdata + y * pitch + setup.startx;
+					s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
+					const u32 *srcrow = reinterpret_cast<const u32 *>(prim.texture.base) + (curv >> 16) * prim.texture.rowpixels;
+					for (s32 uoff : utable)
+						*dest++ = source32_to_dest(srcrow[uoff]);
+				}
+				return;
+			}
+
 			// loop over rows
 			for (s32 y = setup.starty; y < setup.endy; y++)
 			{
@@ -1825,7 +1908,7 @@ private:
 	//  drawing routine
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 clipy0, s32 clipy1)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1872,6 +1955,48 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// clip to the scanline band, advancing U/V to compensate
+		if (setup.starty < clipy0)
+		{
+			setup.startu += (clipy0 - setup.starty) * setup.dudy;
+			setup.startv += (clipy0 - setup.starty) * setup.dvdy;
+			setup.starty = clipy0;
+		}
+		if (setup.endy > clipy1)
+			setup.endy = clipy1;
+		if (setup.starty >= setup.endy)
+			return;
+
+		// rotated quads (vertical games) sample the source texture down
+		// columns, so a full destination row touches one cache line per
+		// texel; strip-mine the quad into narrow column bands so each
+		// band's source window stays resident across destination rows
+		if (setup.dudx == 0 && setup.dvdy == 0 && setup.dvdx != 0 && (setup.endx - setup.startx) > ROTATED_STRIP_WIDTH)
+		{
+			quad_setup_data strip = setup;
+			for (s32 stripx = setup.startx; stripx < setup.endx; stripx += ROTATED_STRIP_WIDTH)
+			{
+				strip.startx = stripx;
+				strip.endx = std::min(stripx + ROTATED_STRIP_WIDTH, setup.endx);
+				strip.startu = setup.startu + (stripx - setup.startx) * setup.dudx;
+				strip.startv = setup.startv + (stripx - setup.startx) * setup.dvdx;
+				dispatch_textured_quad(prim, dstdata, pitch, strip);
+			}
+			return;
+		}
+
+		dispatch_textured_quad(prim, dstdata, pitch, setup);
+	}
+
+
+	//-------------------------------------------------
+	//  dispatch_textured_quad - dispatch a quad with
+	//  completed setup to a texture-mode-specific
+	//  drawing routine
+	//-------------------------------------------------
+
+	static void dispatch_textured_quad(const render_primitive &prim, _PixelType *dstdata, u32 pitch, quad_setup_data &setup)
+	{
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1930,6 +2055,46 @@ private:
 	//  PRIMARY ENTRY POINT
 	//**************************************************************************
 
+	//-------------------------------------------------
+	//  draw_primitive - draw a single primitive,
+	//  clipped to the scanlines in [clipy0, clipy1)
+	//-------------------------------------------------
+
+	static void draw_primitive(const render_primitive &prim, void *dstdata, u32 width, u32 height, u32 pitch, s32 clipy0, s32 clipy1)
+	{
+		switch (prim.type)
+		{
+			case render_primitive::LINE:
+				draw_line(prim, reinterpret_cast<_PixelType *>(dstdata), width, clipy0, clipy1, pitch);
+				break;
+
+			case render_primitive::QUAD:
+				if (!prim.texture.base)
+					draw_rect(prim, reinterpret_cast<_PixelType *>(dstdata), width, clipy0, clipy1, pitch);
+				else
+					setup_and_draw_textured_quad(prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch, clipy0, clipy1);
+				break;
+
+			default:
+				throw emu_fatalerror("Unexpected render_primitive type");
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  draw_band_callback - work item callback to
+	//  render one band's primitive list
+	//-------------------------------------------------
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		work_band &band = *reinterpret_cast<work_band *>(param);
+		for (const render_primitive *prim : band.prims)
+			draw_primitive(*prim, band.dstdata, band.width, band.height, band.pitch, band.bandy0, band.bandy1);
+		return nullptr;
+	}
+
+
 	//-------------------------------------------------
 	//  draw_primitives - draw a series of primitives
 	//  using a software rasterizer
@@ -1938,23 +2103,61 @@ private:
 public:
 	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
 	{
-		// loop over the list and render each element
+		// determine how many bands are worthwhile; stay single-threaded on
+		// small targets and single-CPU hosts
+		s32 numbands = s32(height) / WORK_BAND_MIN_HEIGHT;
+		const s32 numprocs = s32(std::thread::hardware_concurrency());
+		if (numbands > numprocs)
+			numbands = numprocs;
+		if (numbands > WORK_MAX_THREADS)
+			numbands = WORK_MAX_THREADS;
+		if (numbands <= 1)
+		{
+			for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
+				draw_primitive(*prim, dstdata, width, height, pitch, 0, height);
+			return;
+		}
+
+		// lazily create the shared work queue
+		static osd_work_queue *const s_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+		// partition the destination into horizontal bands
+		const s32 bandheight = (s32(height) + numbands - 1) / numbands;
+		std::vector<work_band> bands(numbands);
+		for (s32 bandnum = 0; bandnum < numbands; bandnum++)
+		{
+			work_band &band = bands[bandnum];
+			band.dstdata = dstdata;
+			band.width = width;
+			band.height = height;
+			band.pitch = pitch;
+			band.bandy0 = bandnum * bandheight;
+			band.bandy1 = std::min(band.bandy0 + bandheight, s32(height));
+		}
+
+		// build a clipped primitive list for each band
 		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
-			switch (prim->type)
+		{
+			// compute the vertical extent; line bounds may run in either
+			// direction, and line pixels spill up to half a beam width
+			float miny = std::min(prim->bounds.y0, prim->bounds.y1);
+			float maxy = std::max(prim->bounds.y0, prim->bounds.y1);
+			if (prim->type == render_primitive::LINE)
 			{
-				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					break;
-
-				case render_primitive::QUAD:
-					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					break;
-
-				default:
-					throw emu_fatalerror("Unexpected render_primitive type");
+				const float extent = 0.5f * prim->width + 1.0f;
+				miny -= extent;
+				maxy += extent;
 			}
+
+			// hand the primitive to every band it overlaps
+			const s32 firstband = std::max(s32(miny) / bandheight, 0);
+			const s32 lastband = std::min(s32(maxy) / bandheight, numbands - 1);
+			for (s32 bandnum = firstband; bandnum <= lastband; bandnum++)
+				bands[bandnum].prims.push_back(prim);
+		}
+
+		// dispatch the bands and wait for completion
+		osd_work_item_queue_multiple(s_queue, draw_band_callback, numbands, &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(s_queue, osd_ticks_per_second());
 	}
 };
@@ -563,6 +563,10 @@ render_font::render_font(render_manager &manager, const char *filename)
 	, m_osdfont()
 	, m_height_cmd(0)
 	, m_yoffs_cmd(0)
+	, m_atlas_texture(nullptr)
+	, m_atlas_x(0)
+	, m_atlas_y(0)
+	, m_atlas_rowheight(0)
 {
 	memset(m_glyphs, 0, sizeof(m_glyphs));
 	memset(m_glyphs_cmd, 0, sizeof(m_glyphs_cmd));
@@ -632,6 +636,9 @@ render_font::~render_font()
 			}
 			delete[] elem;
 		}
+
+	// free the glyph atlas
+	m_manager.texture_free(m_atlas_texture);
 }
 
 
@@ -804,6 +811,101 @@ render_texture *render_font::get_char_texture_and_bounds(float height, float asp
 }
 
 
+//-------------------------------------------------
+//  atlas_insert - shelf-pack an expanded glyph
+//  bitmap into the shared atlas texture
+//-------------------------------------------------
+
+bool render_font::atlas_insert(glyph &gl)
+{
+	// glyphs that could never fit are rejected outright
+	int const needwidth = gl.bitmap.width() + ATLAS_PAD;
+	int const needheight = gl.bitmap.height() + ATLAS_PAD;
+	if ((needwidth > ATLAS_WIDTH) || (needheight > ATLAS_HEIGHT))
+		return false;
+
+	// allocate the atlas lazily on first insertion
+	if (!m_atlas_bitmap.valid())
+	{
+		m_atlas_bitmap.allocate(ATLAS_WIDTH, ATLAS_HEIGHT);
+		m_atlas_bitmap.fill(rgb_t(0x00, 0xff, 0xff, 0xff));
+		m_atlas_texture = m_manager.texture_alloc(render_texture::hq_scale);
+	}
+
+	// start a new shelf if this glyph doesn't fit on the current one
+	if (m_atlas_x + needwidth > ATLAS_WIDTH)
+	{
+		m_atlas_x = 0;
+		m_atlas_y += m_atlas_rowheight;
+		m_atlas_rowheight = 0;
+	}
+	if (m_atlas_y + needheight > ATLAS_HEIGHT)
+		return false;
+
+	// copy the glyph pixels into place
+	for (int y = 0; y < gl.bitmap.height(); y++)
+	{
+		u32 const *src = &gl.bitmap.pix32(y);
+		u32 *dst = &m_atlas_bitmap.pix32(m_atlas_y + y, m_atlas_x);
+		memcpy(dst, src, gl.bitmap.width() * sizeof(u32));
+	}
+
+	// record the UV rectangle and advance the packing cursor
+	gl.atlas_u0 = float(m_atlas_x) / float(ATLAS_WIDTH);
+	gl.atlas_v0 = float(m_atlas_y) / float(ATLAS_HEIGHT);
+	gl.atlas_u1 = float(m_atlas_x + gl.bitmap.width()) / float(ATLAS_WIDTH);
+	gl.atlas_v1 = float(m_atlas_y + gl.bitmap.height()) / float(ATLAS_HEIGHT);
+	m_atlas_x += needwidth;
+	m_atlas_rowheight = (std::max)(m_atlas_rowheight, needheight);
+
+	// re-set the bitmap so cached texture data is invalidated
+	m_atlas_texture->set_bitmap(m_atlas_bitmap, m_atlas_bitmap.cliprect(), TEXFORMAT_ARGB32);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  get_char_texture_bounds_and_texcoords - like
+//  get_char_texture_and_bounds, but prefers the
+//  shared glyph atlas; when the glyph is atlased
+//  the returned texture is the atlas page and
+//  texcoords selects the glyph's cell
+//-------------------------------------------------
+
+render_texture *render_font::get_char_texture_bounds_and_texcoords(float height, float aspect, char32_t chnum, render_bounds &bounds, render_quad_texuv &texcoords, bool &atlased)
+{
+	glyph &gl = get_char(chnum);
+
+	// on entry, assume x0,y0 are the top,left coordinate of the cell and add
+	// the character bounding box to that position
+	float scale = m_scale * height;
+	bounds.x0 += float(gl.xoffs) * scale * aspect;
+
+	// compute x1,y1 from there based on the bitmap size
+	bounds.x1 = bounds.x0 + float(gl.bmwidth) * scale * aspect;
+	bounds.y1 = bounds.y0 + float(m_height) * scale;
+
+	// try to place the glyph in the atlas on first use
+	if ((gl.atlas_state == 0) && (gl.texture != nullptr) && gl.bitmap.valid())
+		gl.atlas_state = atlas_insert(gl) ? 1 : 2;
+
+	// hand back the atlas cell if the glyph lives there
+	if (gl.atlas_state == 1)
+	{
+		texcoords.tl.u = gl.atlas_u0;   texcoords.tl.v = gl.atlas_v0;
+		texcoords.tr.u = gl.atlas_u1;   texcoords.tr.v = gl.atlas_v0;
+		texcoords.bl.u = gl.atlas_u0;   texcoords.bl.v = gl.atlas_v1;
+		texcoords.br.u = gl.atlas_u1;   texcoords.br.v = gl.atlas_v1;
+		atlased = true;
+		return m_atlas_texture;
+	}
+
+	// otherwise fall back to the per-glyph texture
+	atlased = false;
+	return gl.texture;
+}
+
+
 //-------------------------------------------------
 //  get_scaled_bitmap_and_bounds - return a
 //  scaled bitmap and bounding rect for a char
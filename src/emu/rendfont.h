@@ -41,6 +41,7 @@ public:
 
 	// texture/bitmap queries
 	render_texture *get_char_texture_and_bounds(float height, float aspect, char32_t ch, render_bounds &bounds);
+	render_texture *get_char_texture_bounds_and_texcoords(float height, float aspect, char32_t ch, render_bounds &bounds, render_quad_texuv &texcoords, bool &atlased);
 	void get_scaled_bitmap_and_bounds(bitmap_argb32 &dest, float height, float aspect, char32_t chnum, rectangle &bounds);
 
 private:
@@ -56,6 +57,8 @@ private:
 			, texture(nullptr)
 			, bitmap()
 			, color()
+			, atlas_state(0)
+			, atlas_u0(0), atlas_v0(0), atlas_u1(0), atlas_v1(0)
 		{
 		}
 
@@ -67,6 +70,10 @@ private:
 		bitmap_argb32       bitmap;             // pointer to the bitmap containing the raw data
 
 		rgb_t               color;
+
+		s8                  atlas_state;        // 0 = not tried, 1 = in the atlas, 2 = did not fit
+		float               atlas_u0, atlas_v0; // UV rectangle within the shared glyph atlas
+		float               atlas_u1, atlas_v1;
 	};
 
 	// internal format
@@ -81,6 +88,7 @@ private:
 	// helpers
 	glyph &get_char(char32_t chnum);
 	void char_expand(char32_t chnum, glyph &ch);
+	bool atlas_insert(glyph &gl);
 	bool load_cached_bdf(const char *filename);
 	bool load_bdf();
 	bool load_cached(emu_file &file, u64 length, u32 hash);
@@ -105,8 +113,19 @@ private:
 	EQUIVALENT_ARRAY(m_glyphs, glyph *) m_glyphs_cmd; // array of glyph subtables
 	std::vector<char>   m_rawdata_cmd;      // pointer to the raw data for the font
 
+	// glyph atlas; expanded glyphs are shelf-packed into a single shared
+	// texture so whole strings can be drawn without switching textures
+	bitmap_argb32       m_atlas_bitmap;     // backing store for the atlas
+	render_texture *    m_atlas_texture;    // the shared atlas texture
+	int                 m_atlas_x;          // current packing position
+	int                 m_atlas_y;          // top of the current shelf
+	int                 m_atlas_rowheight;  // height of the current shelf
+
 	// constants
 	static const u64 CACHED_BDF_HASH_SIZE   = 1024;
+	static const int ATLAS_WIDTH            = 1024;
+	static const int ATLAS_HEIGHT           = 1024;
+	static const int ATLAS_PAD              = 1;
 };
 
 void convert_command_glyph(std::string &s);
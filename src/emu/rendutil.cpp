@@ -11,6 +11,7 @@
 #include "emu.h"
 #include "render.h"
 #include "rendutil.h"
+#include "video/rgbutil.h"
 #include "png.h"
 
 #include "jpeglib.h"
@@ -77,62 +78,99 @@ static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth,
 	b = color.b * color.a * 256.0f;
 	a = color.a * 256.0f;
 
+	/* the box filter is separable, and the horizontal weights are the same
+	   for every source row; compute them once up front instead of redoing
+	   the chunk math for every output pixel */
+	std::vector<u32> xfirst(dwidth);
+	std::vector<u32> xcount(dwidth);
+	std::vector<u32> xweight;
+	xweight.reserve(dwidth * 2);
+	for (x = 0; x < dwidth; x++)
+	{
+		u32 startx = x * dx;
+		u32 xremaining = dx;
+		u32 count = 0;
+		xfirst[x] = startx >> 12;
+		for (u32 curx = startx; xremaining; )
+		{
+			u32 xchunk = 0x1000 - (curx & 0xfff);
+			if (xchunk > xremaining)
+				xchunk = xremaining;
+			xremaining -= xchunk;
+			xweight.push_back(xchunk);
+			count++;
+			curx += xchunk;
+		}
+		xcount[x] = count;
+	}
+
+	/* stream the resample: horizontally reduce each contributing source row
+	   once into hrow, then accumulate rows with their y weights; because a
+	   boundary source row is shared between adjacent output rows, remember
+	   the last reduced row rather than reducing it twice; the sums are
+	   bit-identical to the direct two-dimensional accumulation */
+	std::vector<u64> hrow(dwidth * 4);
+	std::vector<u64> acc(dwidth * 4);
+	s64 cached_row = -1;
+
 	/* loop over the target vertically */
 	for (y = 0; y < dheight; y++)
 	{
 		u32 starty = y * dy;
+		u32 yremaining = dy;
 
-		/* loop over the target horizontally */
-		for (x = 0; x < dwidth; x++)
-		{
-			u64 sumr = 0, sumg = 0, sumb = 0, suma = 0;
-			u32 startx = x * dx;
-			u32 xchunk, ychunk;
-			u32 curx, cury;
-
-			u32 yremaining = dy;
+		std::fill(acc.begin(), acc.end(), 0);
 
-			/* accumulate all source pixels that contribute to this pixel */
-			for (cury = starty; yremaining; cury += ychunk)
+		/* accumulate all source rows that contribute to this output row */
+		for (u32 cury = starty; yremaining; )
+		{
+			/* determine the Y contribution, clamping to the amount remaining */
+			u32 ychunk = 0x1000 - (cury & 0xfff);
+			if (ychunk > yremaining)
+				ychunk = yremaining;
+			yremaining -= ychunk;
+
+			/* horizontally reduce the source row if it isn't the cached one */
+			u32 srcrow = cury >> 12;
+			if (s64(srcrow) != cached_row)
 			{
-				u32 xremaining = dx;
-
-				/* determine the Y contribution, clamping to the amount remaining */
-				ychunk = 0x1000 - (cury & 0xfff);
-				if (ychunk > yremaining)
-					ychunk = yremaining;
-				yremaining -= ychunk;
-
-				/* loop over all source pixels in the X direction */
-				for (curx = startx; xremaining; curx += xchunk)
+				const u32 *src = source + srcrow * srowpixels;
+				const u32 *weight = &xweight[0];
+				for (x = 0; x < dwidth; x++)
 				{
-					u32 factor;
-
-					/* determine the X contribution, clamping to the amount remaining */
-					xchunk = 0x1000 - (curx & 0xfff);
-					if (xchunk > xremaining)
-						xchunk = xremaining;
-					xremaining -= xchunk;
-
-					/* total contribution = x * y */
-					factor = xchunk * ychunk;
-
-					/* fetch the source pixel */
-					rgb_t pix = source[(cury >> 12) * srowpixels + (curx >> 12)];
-
-					/* accumulate the RGBA values */
-					sumr += factor * pix.r();
-					sumg += factor * pix.g();
-					sumb += factor * pix.b();
-					suma += factor * pix.a();
+					u64 sumr = 0, sumg = 0, sumb = 0, suma = 0;
+					const u32 *pix = src + xfirst[x];
+					for (u32 chunk = 0; chunk < xcount[x]; chunk++)
+					{
+						rgb_t pixel = *pix++;
+						u32 factor = *weight++;
+						sumr += factor * pixel.r();
+						sumg += factor * pixel.g();
+						sumb += factor * pixel.b();
+						suma += factor * pixel.a();
+					}
+					hrow[x * 4 + 0] = suma;
+					hrow[x * 4 + 1] = sumr;
+					hrow[x * 4 + 2] = sumg;
+					hrow[x * 4 + 3] = sumb;
 				}
+				cached_row = srcrow;
 			}
 
-			/* apply scaling */
-			suma = (suma / sumscale) * a / 256;
-			sumr = (sumr / sumscale) * r / 256;
-			sumg = (sumg / sumscale) * g / 256;
-			sumb = (sumb / sumscale) * b / 256;
+			/* fold the reduced row into the accumulator with its y weight */
+			for (u32 index = 0; index < dwidth * 4; index++)
+				acc[index] += hrow[index] * ychunk;
+
+			cury += ychunk;
+		}
+
+		/* scale and store the output row */
+		for (x = 0; x < dwidth; x++)
+		{
+			u64 suma = (acc[x * 4 + 0] / sumscale) * a / 256;
+			u64 sumr = (acc[x * 4 + 1] / sumscale) * r / 256;
+			u64 sumg = (acc[x * 4 + 2] / sumscale) * g / 256;
+			u64 sumb = (acc[x * 4 + 3] / sumscale) * b / 256;
 
 			/* if we're translucent, add in the destination pixel contribution */
 			if (a < 256)
@@ -168,6 +206,9 @@ static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth,
 	b = color.b * color.a * 256.0f;
 	a = color.a * 256.0f;
 
+	/* with no color adjustment the filtered pixel can be stored directly */
+	bool const identity = (r == 256 && g == 256 && b == 256 && a == 256);
+
 	/* loop over the target vertically */
 	for (y = 0; y < dheight; y++)
 	{
@@ -181,7 +222,6 @@ static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth,
 			u32 sumr, sumg, sumb, suma;
 			u32 nextx, nexty;
 			u32 curx, cury;
-			u32 factor;
 
 			/* adjust start to the center; note that this math will tend to produce */
 			/* negative results on the first pixel, which is why we clamp below */
@@ -207,39 +247,22 @@ static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth,
 			curx &= 0xfff;
 			cury &= 0xfff;
 
-			/* contributions from pixel 0 (top,left) */
-			factor = (0x1000 - curx) * (0x1000 - cury);
-			sumr = factor * pix0.r();
-			sumg = factor * pix0.g();
-			sumb = factor * pix0.b();
-			suma = factor * pix0.a();
-
-			/* contributions from pixel 1 (top,right) */
-			factor = curx * (0x1000 - cury);
-			sumr += factor * pix1.r();
-			sumg += factor * pix1.g();
-			sumb += factor * pix1.b();
-			suma += factor * pix1.a();
-
-			/* contributions from pixel 2 (bottom,left) */
-			factor = (0x1000 - curx) * cury;
-			sumr += factor * pix2.r();
-			sumg += factor * pix2.g();
-			sumb += factor * pix2.b();
-			suma += factor * pix2.a();
-
-			/* contributions from pixel 3 (bottom,right) */
-			factor = curx * cury;
-			sumr += factor * pix3.r();
-			sumg += factor * pix3.g();
-			sumb += factor * pix3.b();
-			suma += factor * pix3.a();
+			/* blend all four channels at once; rgbaint_t maps to SSE2/NEON/
+			   AltiVec where available and plain C elsewhere */
+			rgb_t filtered = rgbaint_t::bilinear_filter(pix0, pix1, pix2, pix3, curx >> 4, cury >> 4);
+
+			/* with an identity color there is nothing left to apply */
+			if (identity)
+			{
+				dest[y * drowpixels + x] = filtered;
+				continue;
+			}
 
 			/* apply scaling */
-			suma = (suma >> 24) * a / 256;
-			sumr = (sumr >> 24) * r / 256;
-			sumg = (sumg >> 24) * g / 256;
-			sumb = (sumb >> 24) * b / 256;
+			suma = filtered.a() * a / 256;
+			sumr = filtered.r() * r / 256;
+			sumg = filtered.g() * g / 256;
+			sumb = filtered.b() * b / 256;
 
 			/* if we're translucent, add in the destination pixel contribution */
 			if (a < 256)
@@ -15,6 +15,13 @@
 #include "softlist_dev.h"
 #include "ui/uimain.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 #define LOG_LOAD 0
 #define LOG(...) do { if (LOG_LOAD) debugload(__VA_ARGS__); } while(0)
@@ -344,6 +351,9 @@ void rom_load_manager::fill_random(u8 *base, u32 length)
 
 void rom_load_manager::handle_missing_file(const rom_entry *romp, std::string tried_file_names, chd_error chderr)
 {
+	/* verification workers may be appending to the error state too */
+	std::lock_guard<std::mutex> lock(m_verify_mutex);
+
 	if(tried_file_names.length() != 0)
 		tried_file_names = " (tried in " + tried_file_names + ")";
 
@@ -401,14 +411,17 @@ void rom_load_manager::dump_wrong_and_correct_checksums(const util::hash_collect
     and hash signatures of a file
 -------------------------------------------------*/
 
-void rom_load_manager::verify_length_and_hash(const char *name, u32 explength, const util::hash_collection &hashes)
+void rom_load_manager::verify_length_and_hash(emu_file &file, const char *name, u32 explength, const util::hash_collection &hashes)
 {
-	/* we've already complained if there is no file */
-	if (m_file == nullptr)
-		return;
+	/* hash the file data up front, outside the lock */
+	u32 actlength = file.size();
+	util::hash_collection &acthashes = file.hashes(hashes.hash_types().c_str());
+
+	/* serialize updates to the shared error state; this can run on a
+	   verification worker concurrently with the main loading thread */
+	std::lock_guard<std::mutex> lock(m_verify_mutex);
 
 	/* verify length */
-	u32 actlength = m_file->size();
 	if (explength != actlength)
 	{
 		m_errorstring.append(string_format("%s WRONG LENGTH (expected: %08x found: %08x)\n", name, explength, actlength));
@@ -416,7 +429,6 @@ void rom_load_manager::verify_length_and_hash(const char *name, u32 explength, c
 	}
 
 	/* If there is no good dump known, write it */
-	util::hash_collection &acthashes = m_file->hashes(hashes.hash_types().c_str());
 	if (hashes.flag(util::hash_collection::FLAG_NO_DUMP))
 	{
 		m_errorstring.append(string_format("%s NO GOOD DUMP KNOWN\n", name));
@@ -428,7 +440,7 @@ void rom_load_manager::verify_length_and_hash(const char *name, u32 explength, c
 		/* otherwise, it's just bad */
 		util::hash_collection &all_acthashes = acthashes.hash_types() == util::hash_collection::HASH_TYPES_ALL
 			? acthashes
-			: m_file->hashes(util::hash_collection::HASH_TYPES_ALL);
+			: file.hashes(util::hash_collection::HASH_TYPES_ALL);
 		m_errorstring.append(string_format("%s WRONG CHECKSUMS:\n", name));
 		dump_wrong_and_correct_checksums(hashes, all_acthashes);
 		m_warnings++;
@@ -442,6 +454,38 @@ void rom_load_manager::verify_length_and_hash(const char *name, u32 explength, c
 }
 
 
+/*-------------------------------------------------
+    queue_verify - hand a finished ROM file to
+    the verification queue so hashing overlaps
+    with reading the next file
+-------------------------------------------------*/
+
+void rom_load_manager::queue_verify(std::unique_ptr<emu_file> file, std::string name, u32 explength, const util::hash_collection &hashes)
+{
+	auto *item = new verify_item;
+	item->loader = this;
+	item->file = std::move(file);
+	item->name = std::move(name);
+	item->explength = explength;
+	item->hashes = hashes;
+	osd_work_item_queue(m_verify_queue, verify_rom_hashes_static, item, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+/*-------------------------------------------------
+    verify_rom_hashes_static - verification work
+    item callback
+-------------------------------------------------*/
+
+void *rom_load_manager::verify_rom_hashes_static(void *param, int threadid)
+{
+	auto *item = reinterpret_cast<verify_item *>(param);
+	item->loader->verify_length_and_hash(*item->file, item->name.c_str(), item->explength, item->hashes);
+	delete item;
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     display_loading_rom_message - display
     messages about ROM loading to the user
@@ -468,6 +512,9 @@ void rom_load_manager::display_loading_rom_message(const char *name, bool from_l
 
 void rom_load_manager::display_rom_load_results(bool from_list)
 {
+	/* wait for any outstanding hash verification before reporting */
+	osd_work_queue_wait(m_verify_queue, osd_ticks_per_second() * 30);
+
 	/* final status display */
 	display_loading_rom_message(nullptr, from_list);
 
@@ -548,6 +595,30 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 	u32 crc = 0;
 	bool has_crc = util::hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
+	/* consult the per-process payload cache before touching the disk; only
+	   hash-identified dumps are keyed, so identical content matches no
+	   matter which set it was first loaded from */
+	std::string cachekey;
+	if (has_crc && machine().options().romdata_cache() > 0)
+		cachekey = string_format("%s|%s|%u", ROM_GETNAME(romp), ROM_GETHASHDATA(romp), romsize);
+
+	if (!cachekey.empty())
+	{
+		auto cached = machine().manager().romdata_cache_find(cachekey);
+		if (cached != nullptr)
+		{
+			auto ramfile = std::make_unique<emu_file>(machine().options().media_path(), OPEN_FLAG_READ);
+			if (ramfile->open_ram(&(*cached)[0], cached->size()) == osd_file::error::NONE)
+			{
+				m_file = std::move(ramfile);
+				m_cache_holds.push_back(std::move(cached));
+				m_romsloaded++;
+				m_romsloadedsize += romsize;
+				return true;
+			}
+		}
+	}
+
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
 	m_file = nullptr;
@@ -639,6 +710,19 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		}
 	}
 
+	/* retain the payload so later sessions in this process skip the disk */
+	if (filerr == osd_file::error::NONE && m_file != nullptr && !cachekey.empty())
+	{
+		u64 const length = m_file->size();
+		if (length > 0 && length <= 0xffffffff)
+		{
+			auto data = std::make_shared<std::vector<u8>>(size_t(length));
+			if (m_file->read(&(*data)[0], u32(length)) == u32(length))
+				machine().manager().romdata_cache_store(cachekey, std::move(data));
+			m_file->seek(0, SEEK_SET);
+		}
+	}
+
 	/* update counters */
 	m_romsloaded++;
 	m_romsloadedsize += romsize;
@@ -894,6 +978,10 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 				handle_missing_file(romp, tried_file_names, CHDERR_NONE);
 
 			/* loop until we run out of reloads */
+			std::string verify_name;
+			u32 verify_explength = 0;
+			util::hash_collection verify_hashes;
+			bool verify_pending = false;
 			do
 			{
 				/* loop until we run out of continues/ignores */
@@ -916,12 +1004,13 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 				}
 				while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp));
 
-				/* if this was the first use of this file, verify the length and CRC */
+				/* if this was the first use of this file, remember what to verify */
 				if (baserom)
 				{
-					LOG("Verifying length (%X) and checksums\n", explength);
-					verify_length_and_hash(ROM_GETNAME(baserom), explength, util::hash_collection(ROM_GETHASHDATA(baserom)));
-					LOG("Verify finished\n");
+					verify_name = ROM_GETNAME(baserom);
+					verify_explength = explength;
+					verify_hashes = util::hash_collection(ROM_GETHASHDATA(baserom));
+					verify_pending = true;
 				}
 
 				/* reseek to the start and clear the baserom so we don't reverify */
@@ -932,10 +1021,16 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 			}
 			while (ROMENTRY_ISRELOAD(romp));
 
-			/* close the file */
+			/* close the file, handing it to the verification queue so the
+			   hashing overlaps with reading the next file */
 			if (m_file != nullptr)
 			{
 				LOG("Closing ROM file\n");
+				if (verify_pending)
+				{
+					LOG("Queueing length (%X) and checksum verification\n", verify_explength);
+					queue_verify(std::move(m_file), std::move(verify_name), verify_explength, verify_hashes);
+				}
 				m_file = nullptr;
 			}
 		}
@@ -1205,17 +1300,21 @@ void rom_load_manager::process_disk_entries(const char *regiontag, const rom_ent
 			util::hash_collection acthashes;
 			acthashes.add_sha1(chd->orig_chd().sha1());
 
-			/* verify the hash */
-			if (hashes != acthashes)
+			/* verify the hash; ROM verification workers may still be
+			   appending to the error state */
 			{
-				m_errorstring.append(string_format("%s WRONG CHECKSUMS:\n", filename));
-				dump_wrong_and_correct_checksums(hashes, acthashes);
-				m_warnings++;
-			}
-			else if (hashes.flag(util::hash_collection::FLAG_BAD_DUMP))
-			{
-				m_errorstring.append(string_format("%s CHD NEEDS REDUMP\n", filename));
-				m_knownbad++;
+				std::lock_guard<std::mutex> lock(m_verify_mutex);
+				if (hashes != acthashes)
+				{
+					m_errorstring.append(string_format("%s WRONG CHECKSUMS:\n", filename));
+					dump_wrong_and_correct_checksums(hashes, acthashes);
+					m_warnings++;
+				}
+				else if (hashes.flag(util::hash_collection::FLAG_BAD_DUMP))
+				{
+					m_errorstring.append(string_format("%s CHD NEEDS REDUMP\n", filename));
+					m_knownbad++;
+				}
 			}
 
 			/* if not read-only, make the diff file */
@@ -1225,6 +1324,7 @@ void rom_load_manager::process_disk_entries(const char *regiontag, const rom_ent
 				err = open_disk_diff(machine().options(), romp, chd->orig_chd(), chd->diff_chd());
 				if (err != CHDERR_NONE)
 				{
+					std::lock_guard<std::mutex> lock(m_verify_mutex);
 					m_errorstring.append(string_format("%s DIFF CHD ERROR: %s\n", filename, chd_file::error_string(err)));
 					m_errors++;
 					chd = nullptr;
@@ -1397,6 +1497,155 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 }
 
 
+/***************************************************************************
+    SHARED REGION SUPPORT
+***************************************************************************/
+
+#ifdef __linux__
+
+/* segments live in /dev/shm as a 4K header page followed by the region
+   data; the ready flag is written last so a half-copied segment from a
+   concurrently starting instance is never attached */
+#define SHARED_REGION_MAGIC     0x4d524730      /* 'MRG0' */
+#define SHARED_REGION_HEADER    4096
+
+struct shared_region_header
+{
+	u32 magic;
+	u32 length;
+	u32 ready;
+};
+
+static std::string shared_region_path(const std::string &key)
+{
+	return std::string("/dev/shm/mame-region-").append(key);
+}
+
+#endif // __linux__
+
+
+/*-------------------------------------------------
+    region_share_key - compute a stable key for a
+    region from its declared contents; identical
+    keys imply byte-identical post-load regions
+-------------------------------------------------*/
+
+std::string rom_load_manager::region_share_key(device_t &device, const rom_entry *region)
+{
+	util::sha1_creator sha1;
+
+	auto append_string = [&sha1] (const char *str) { sha1.append(str, u32(strlen(str)) + 1); };
+	auto append_u32 = [&sha1] (u32 value) { sha1.append(&value, sizeof(value)); };
+
+	/* the key covers everything that affects the loaded bytes: the device,
+	   the region layout, every ROM's declared hashes, and the selected
+	   BIOS; it is computable without touching the ROM files themselves */
+	append_string(device.shortname());
+	append_string(ROMREGION_GETTAG(region));
+	append_u32(ROMREGION_GETLENGTH(region));
+	append_u32(ROMREGION_GETFLAGS(region));
+	append_u32(device.system_bios());
+	for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+	{
+		append_string(ROM_GETNAME(rom));
+		append_string(ROM_GETHASHDATA(rom));
+		append_u32(ROM_GETOFFSET(rom));
+		append_u32(ROM_GETLENGTH(rom));
+		append_u32(ROM_GETFLAGS(rom));
+	}
+	return sha1.finish().as_string();
+}
+
+
+/*-------------------------------------------------
+    attach_shared_region - back a region with a
+    segment published by an earlier instance,
+    skipping loading entirely; returns false if
+    no valid segment exists
+-------------------------------------------------*/
+
+bool rom_load_manager::attach_shared_region(const std::string &key, memory_region &region)
+{
+#ifdef __linux__
+	const int fd = open(shared_region_path(key).c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || u64(st.st_size) != u64(SHARED_REGION_HEADER) + region.bytes())
+	{
+		close(fd);
+		return false;
+	}
+
+	/* map privately so in-place patching and decryption stay local to
+	   this instance; pages nobody writes remain physically shared */
+	const size_t mapsize = size_t(st.st_size);
+	void *const map = mmap(nullptr, mapsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return false;
+
+	const shared_region_header *header = reinterpret_cast<const shared_region_header *>(map);
+	if (header->magic != SHARED_REGION_MAGIC || header->length != region.bytes() || __atomic_load_n(&header->ready, __ATOMIC_ACQUIRE) == 0)
+	{
+		munmap(map, mapsize);
+		return false;
+	}
+
+	region.adopt_storage(reinterpret_cast<u8 *>(map) + SHARED_REGION_HEADER, [map, mapsize] () { munmap(map, mapsize); });
+	LOG("Attached region %s to shared segment %s\n", region.name(), key.c_str());
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+/*-------------------------------------------------
+    publish_shared_region - publish a freshly
+    loaded, post-processed region for other
+    instances to attach
+-------------------------------------------------*/
+
+void rom_load_manager::publish_shared_region(const std::string &key, memory_region &region)
+{
+#ifdef __linux__
+	/* O_EXCL means exactly one instance publishes each segment; losing
+	   the race (or an unusable /dev/shm) is not an error */
+	const std::string path = shared_region_path(key);
+	const int fd = open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (fd < 0)
+		return;
+
+	const size_t mapsize = size_t(SHARED_REGION_HEADER) + region.bytes();
+	if (ftruncate(fd, off_t(mapsize)) != 0)
+	{
+		close(fd);
+		unlink(path.c_str());
+		return;
+	}
+
+	void *const map = mmap(nullptr, mapsize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		unlink(path.c_str());
+		return;
+	}
+
+	memcpy(reinterpret_cast<u8 *>(map) + SHARED_REGION_HEADER, region.base(), region.bytes());
+
+	shared_region_header *header = reinterpret_cast<shared_region_header *>(map);
+	header->magic = SHARED_REGION_MAGIC;
+	header->length = region.bytes();
+	__atomic_store_n(&header->ready, 1, __ATOMIC_RELEASE);
+	munmap(map, mapsize);
+	LOG("Published region %s as shared segment %s\n", region.name(), key.c_str());
+#endif
+}
+
+
 /*-------------------------------------------------
     process_region_list - process a region list
 -------------------------------------------------*/
@@ -1429,6 +1678,14 @@ void rom_load_manager::process_region_list()
 				m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness);
 				LOG("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base());
 
+				/* an identical region published by a concurrent instance
+				   can be mapped directly, skipping loading altogether */
+				if (machine().options().share_regions() && attach_shared_region(region_share_key(device, region), *m_region))
+				{
+					m_shared_regions.insert(regiontag);
+					continue;
+				}
+
 				/* clear the region if it's requested */
 				if (ROMREGION_ISERASE(region))
 					memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
@@ -1450,14 +1707,31 @@ void rom_load_manager::process_region_list()
 				process_disk_entries(regiontag.c_str(), region, region + 1, nullptr);
 		}
 
-	/* now go back and post-process all the regions */
+	/* now go back and post-process all the regions; attached regions were
+	   published post-processed, so they are skipped */
 	for (device_t &device : deviter)
 		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
 		{
 			regiontag = rom_region_name(device, region);
-			region_post_process(regiontag.c_str(), ROMREGION_ISINVERTED(region));
+			if (m_shared_regions.find(regiontag) == m_shared_regions.end())
+				region_post_process(regiontag.c_str(), ROMREGION_ISINVERTED(region));
 		}
 
+	/* publish freshly loaded regions for other instances to attach */
+	if (machine().options().share_regions())
+		for (device_t &device : deviter)
+			for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+			{
+				if (!ROMREGION_ISROMDATA(region))
+					continue;
+				regiontag = rom_region_name(device, region);
+				if (m_shared_regions.find(regiontag) != m_shared_regions.end())
+					continue;
+				memory_region *const memregion = machine().root_device().memregion(regiontag.c_str());
+				if (memregion != nullptr && memregion->bytes() != 0)
+					publish_shared_region(region_share_key(device, region), *memregion);
+			}
+
 	/* and finally register all per-game parameters */
 	for (device_t &device : deviter)
 		for (const rom_entry *param = rom_first_parameter(device); param != nullptr; param = rom_next_parameter(param))
@@ -1475,6 +1749,7 @@ void rom_load_manager::process_region_list()
 
 rom_load_manager::rom_load_manager(running_machine &machine)
 	: m_machine(machine)
+	, m_verify_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
 {
 	// figure out which BIOS we are using
 	std::map<std::string, std::string> card_bios;
@@ -1523,6 +1798,18 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 }
 
 
+/*-------------------------------------------------
+    ~rom_load_manager - tear down the hash
+    verification queue
+-------------------------------------------------*/
+
+rom_load_manager::~rom_load_manager()
+{
+	osd_work_queue_wait(m_verify_queue, osd_ticks_per_second() * 30);
+	osd_work_queue_free(m_verify_queue);
+}
+
+
 // -------------------------------------------------
 // rom_build_entries - builds a rom_entry vector
 // from a tiny_rom_entry array
@@ -14,6 +14,8 @@
 
 #include "chd.h"
 
+#include <mutex>
+#include <set>
 #include <type_traits>
 
 
@@ -398,6 +400,7 @@ class rom_load_manager
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
+	~rom_load_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -426,7 +429,9 @@ private:
 	void fill_random(u8 *base, u32 length);
 	void handle_missing_file(const rom_entry *romp, std::string tried_file_names, chd_error chderr);
 	void dump_wrong_and_correct_checksums(const util::hash_collection &hashes, const util::hash_collection &acthashes);
-	void verify_length_and_hash(const char *name, u32 explength, const util::hash_collection &hashes);
+	void verify_length_and_hash(emu_file &file, const char *name, u32 explength, const util::hash_collection &hashes);
+	void queue_verify(std::unique_ptr<emu_file> file, std::string name, u32 explength, const util::hash_collection &hashes);
+	static void *verify_rom_hashes_static(void *param, int threadid);
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
@@ -439,6 +444,9 @@ private:
 	chd_error open_disk_diff(emu_options &options, const rom_entry *romp, chd_file &source, chd_file &diff_chd);
 	void process_disk_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag);
 	void normalize_flags_for_device(const char *rgntag, u8 &width, endianness_t &endian);
+	std::string region_share_key(device_t &device, const rom_entry *region);
+	bool attach_shared_region(const std::string &key, memory_region &region);
+	void publish_shared_region(const std::string &key, memory_region &region);
 	void process_region_list();
 
 
@@ -455,12 +463,26 @@ private:
 	u32                 m_romstotalsize;      // total size of ROMs to read
 
 	std::unique_ptr<emu_file>  m_file;               /* current file */
+	std::vector<std::shared_ptr<std::vector<u8>>> m_cache_holds; /* keeps cached payloads alive while files reference them */
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
 	memory_region *     m_region;             // info about current region
+	std::set<std::string> m_shared_regions;   // regions attached from shared memory
 
 	std::string         m_errorstring;        // error string
 	std::string         m_softwarningstring;  // software warning string
+
+	// background hash verification
+	struct verify_item
+	{
+		rom_load_manager *  loader;           // pointer back to the manager
+		std::unique_ptr<emu_file> file;       // file to verify, owned by the item
+		std::string         name;             // ROM name for messages
+		u32                 explength;        // expected length
+		util::hash_collection hashes;         // expected hashes
+	};
+	osd_work_queue *    m_verify_queue;       // work queue for hash verification
+	std::mutex          m_verify_mutex;       // guards the error/warning state
 };
 
 
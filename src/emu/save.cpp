@@ -29,6 +29,11 @@
 #include "emuopts.h"
 #include "coreutil.h"
 
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -67,8 +72,11 @@ save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_reg_allowed(true)
 	, m_illegal_regs(0)
+	, m_incremental_generation(0)
+	, m_flat_size(0)
 {
 	m_rewind = std::make_unique<rewinder>(*this);
+	m_autosave = std::make_unique<background_autosaver>(*this);
 }
 
 
@@ -93,12 +101,82 @@ void save_manager::allow_registration(bool allowed)
 
 		dump_registry();
 
+		// the entry list is final and sorted, so the flat layout can be
+		// computed once here
+		compute_layout();
+
 		// everything is registered by now, evaluate the savestate size
 		m_rewind->clamp_capacity();
 	}
 }
 
 
+//-------------------------------------------------
+//  compute_layout - assign every entry its
+//  offset in the flat binary layout
+//-------------------------------------------------
+
+void save_manager::compute_layout()
+{
+	size_t totalsize = 0;
+	for (auto &entry : m_entry_list)
+	{
+		entry->m_offset = u32(totalsize);
+		totalsize += entry->m_typesize * entry->m_typecount;
+	}
+	m_flat_size = totalsize;
+}
+
+
+//-------------------------------------------------
+//  save_binary - capture the machine state into
+//  a caller-provided flat buffer as a straight
+//  sequence of memcpys
+//-------------------------------------------------
+
+save_error save_manager::save_binary(void *buf, size_t size)
+{
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	if (size < m_flat_size)
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	u8 *dest = (u8 *)buf;
+	for (auto &entry : m_entry_list)
+		memcpy(dest + entry->m_offset, entry->m_data, entry->m_typesize * entry->m_typecount);
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  load_binary - restore the machine state from
+//  a buffer written by save_binary
+//-------------------------------------------------
+
+save_error save_manager::load_binary(const void *buf, size_t size)
+{
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	if (size < m_flat_size)
+		return STATERR_READ_ERROR;
+
+	const u8 *src = (const u8 *)buf;
+	for (auto &entry : m_entry_list)
+		memcpy(entry->m_data, src + entry->m_offset, entry->m_typesize * entry->m_typecount);
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  indexed_item - return an item with the given
 //  index
@@ -188,8 +266,42 @@ void save_manager::save_memory(device_t *device, const char *module, const char
 
 	// insert us into the list
 	m_entry_list.emplace_back(std::make_unique<state_entry>(val, totalname.c_str(), device, module, tag ? tag : "", index, valsize, valcount));
+}
+
+
+//-------------------------------------------------
+//  create_network_blocks - hand the registered
+//  save items to the network layer as its sync
+//  block list
+//-------------------------------------------------
+
+void save_manager::create_network_blocks()
+{
+	if (!netCommon)
+		return;
 
-	if(netCommon) netCommon->createMemoryBlock(totalname, (unsigned char*)val,valsize*valcount);
+	// the entry list precisely enumerates mutable state, in the same
+	// order on every peer, so deriving the sync set from it keeps ROM
+	// shadows and other unregistered scratch out of the hash/compress/
+	// transfer path; physically contiguous entries are merged so runs of
+	// scalar registrations don't each become their own sync block
+	for (int i = 0; i < int(m_entry_list.size()); )
+	{
+		state_entry &first = *m_entry_list[i];
+		u8 *base = (u8 *)first.m_data;
+		u32 size = first.m_typesize * first.m_typecount;
+		int j = i + 1;
+		while (j < int(m_entry_list.size()))
+		{
+			state_entry &next = *m_entry_list[j];
+			if ((u8 *)next.m_data != base + size)
+				break;
+			size += next.m_typesize * next.m_typecount;
+			j++;
+		}
+		netCommon->createMemoryBlock(first.m_name, base, size);
+		i = j;
+	}
 }
 
 
@@ -329,6 +441,62 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_data - serialize the header and machine
+//  state into a buffer; the buffer can then be
+//  compressed and written off-thread by
+//  write_data_to_file
+//-------------------------------------------------
+
+save_error save_manager::write_data(std::vector<u8> &data)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// make sure the flat layout is up to date
+	if (m_flat_size == 0)
+		compute_layout();
+
+	// generate the header
+	data.resize(HEADER_SIZE + m_flat_size);
+	u8 *header = &data[0];
+	memcpy(&header[0], STATE_MAGIC_NUM, 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	u32 sig = signature();
+	*(u32 *)&header[0x1c] = little_endianize_int32(sig);
+
+	// then capture all the data
+	return save_binary(&data[HEADER_SIZE], m_flat_size);
+}
+
+
+//-------------------------------------------------
+//  write_data_to_file - write a buffer produced
+//  by write_data; produces the same bytes as
+//  write_file, so read_file can load the result.
+//  Static so it can run on a worker thread with
+//  no access to manager state.
+//-------------------------------------------------
+
+save_error save_manager::write_data_to_file(emu_file &file, const std::vector<u8> &data)
+{
+	// write the header and turn on compression for the rest of the file
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	if (file.write(&data[0], HEADER_SIZE) != HEADER_SIZE)
+		return STATERR_WRITE_ERROR;
+	file.compress(FCOMPRESS_MEDIUM);
+
+	u32 remaining = data.size() - HEADER_SIZE;
+	if (file.write(&data[HEADER_SIZE], remaining) != remaining)
+		return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -563,6 +731,325 @@ save_error ram_state::load()
 }
 
 
+//-------------------------------------------------
+//  capture_incremental_base - flatten every
+//  registered item into the base buffer that
+//  delta states diff against
+//-------------------------------------------------
+
+void save_manager::capture_incremental_base()
+{
+	// the flat layout doubles as the base layout
+	if (m_flat_size == 0)
+		compute_layout();
+
+	for (auto &entry : m_entry_list)
+		entry->m_dirty_generation = 0;
+
+	m_incremental_base.resize(m_flat_size);
+	save_binary(&m_incremental_base[0], m_flat_size);
+
+	m_incremental_generation = 0;
+}
+
+
+//-------------------------------------------------
+//  delta_state - constructor
+//-------------------------------------------------
+
+delta_state::delta_state(save_manager &save)
+	: m_save(save)
+	, m_data()
+	, m_length(0)
+	, m_valid(false)
+	, m_time(m_save.machine().time())
+{
+	m_data.clear();
+	m_data.rdbuf()->clear();
+	m_data.seekp(0);
+	m_data.seekg(0);
+}
+
+
+//-------------------------------------------------
+//  save - record the items that differ from the
+//  incremental base
+//-------------------------------------------------
+
+save_error delta_state::save()
+{
+	// initialize
+	m_valid = false;
+	m_data.seekp(0);
+
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// a delta without a base is meaningless
+	if (!m_save.has_incremental_base())
+		return STATERR_NOT_FOUND;
+
+	// call the pre-save functions
+	m_save.dispatch_presave();
+
+	const u32 generation = ++m_save.m_incremental_generation;
+	for (u32 index = 0; index < u32(m_save.m_entry_list.size()); index++)
+	{
+		state_entry &entry = *m_save.m_entry_list[index];
+		u32 totalsize = entry.m_typesize * entry.m_typecount;
+
+		// an item that went dirty in an earlier delta almost always keeps
+		// changing, so skip the comparison and just record it; an item
+		// that happens to revert to its base value costs a few spare
+		// bytes, never correctness
+		if (entry.m_dirty_generation == 0)
+		{
+			if (util::block_equal(&m_save.m_incremental_base[entry.m_offset], entry.m_data, totalsize))
+				continue;
+			entry.m_dirty_generation = generation;
+		}
+
+		m_data.write((char *)&index, sizeof(index));
+		m_data.write((char *)entry.m_data, totalsize);
+
+		// check for any errors
+		if (!m_data)
+			return STATERR_WRITE_ERROR;
+	}
+
+	// final confirmation
+	m_length = size_t(m_data.tellp());
+	m_valid = true;
+	m_time = m_save.machine().time();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  load - restore the machine state by replaying
+//  the base and then the recorded items
+//-------------------------------------------------
+
+save_error delta_state::load()
+{
+	// initialize
+	m_data.seekg(0);
+
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	if (!m_valid || !m_save.has_incremental_base())
+		return STATERR_NOT_FOUND;
+
+	// anything not in the delta is at its base value
+	for (auto &entry : m_save.m_entry_list)
+		memcpy(entry->m_data, &m_save.m_incremental_base[entry->m_offset], entry->m_typesize * entry->m_typecount);
+
+	// replay the recorded items
+	while (size_t(m_data.tellg()) < m_length)
+	{
+		u32 index;
+		m_data.read((char *)&index, sizeof(index));
+		if (!m_data || index >= u32(m_save.m_entry_list.size()))
+			return STATERR_READ_ERROR;
+
+		state_entry &entry = *m_save.m_entry_list[index];
+		m_data.read((char *)entry.m_data, entry.m_typesize * entry.m_typecount);
+		if (!m_data)
+			return STATERR_READ_ERROR;
+	}
+
+	// call the post-load functions
+	m_save.dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  fork_state - constructor
+//-------------------------------------------------
+
+fork_state::fork_state(save_manager &save)
+	: m_save(save)
+	, m_control_fd(-1)
+	, m_data_fd(-1)
+	, m_pid(-1)
+	, m_valid(false)
+	, m_time(m_save.machine().time())
+{
+}
+
+
+//-------------------------------------------------
+//  ~fork_state - destructor
+//-------------------------------------------------
+
+fork_state::~fork_state()
+{
+	discard();
+}
+
+
+//-------------------------------------------------
+//  discard - release the frozen child and its
+//  pipes
+//-------------------------------------------------
+
+void fork_state::discard()
+{
+#ifdef __linux__
+	if (m_pid > 0)
+	{
+		// closing the control pipe is the quit signal
+		close(m_control_fd);
+		close(m_data_fd);
+		m_control_fd = m_data_fd = -1;
+
+		int status;
+		waitpid(m_pid, &status, 0);
+		m_pid = -1;
+	}
+#endif
+	m_valid = false;
+}
+
+
+//-------------------------------------------------
+//  save - freeze a copy-on-write image of the
+//  process; cost is a page table copy, not a
+//  state copy
+//-------------------------------------------------
+
+save_error fork_state::save()
+{
+#ifdef __linux__
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// only one image per fork_state
+	discard();
+
+	// the child's memory image must already be coherent, so the pre-save
+	// callbacks run before the fork; the child itself only copies memory
+	m_save.dispatch_presave();
+
+	int control[2];
+	int data[2];
+	if (pipe(control) != 0)
+		return STATERR_WRITE_ERROR;
+	if (pipe(data) != 0)
+	{
+		close(control[0]);
+		close(control[1]);
+		return STATERR_WRITE_ERROR;
+	}
+
+	const int pid = int(fork());
+	if (pid < 0)
+	{
+		close(control[0]);
+		close(control[1]);
+		close(data[0]);
+		close(data[1]);
+		return STATERR_WRITE_ERROR;
+	}
+
+	if (pid == 0)
+	{
+		// frozen child: the other threads did not survive the fork, so
+		// nothing here may allocate or take locks; each wakeup streams the
+		// (unchanged, copy-on-write) entries down the data pipe
+		close(control[1]);
+		close(data[0]);
+
+		char cmd;
+		while (read(control[0], &cmd, 1) == 1)
+			for (auto &entry : m_save.m_entry_list)
+			{
+				const u8 *src = (const u8 *)entry->m_data;
+				size_t remaining = entry->m_typesize * entry->m_typecount;
+				while (remaining > 0)
+				{
+					const ssize_t written = write(data[1], src, remaining);
+					if (written <= 0)
+						_exit(1);
+					src += written;
+					remaining -= size_t(written);
+				}
+			}
+		_exit(0);
+	}
+
+	// parent: keep our ends and note the child
+	close(control[0]);
+	close(data[1]);
+	m_control_fd = control[1];
+	m_data_fd = data[0];
+	m_pid = pid;
+	m_time = m_save.machine().time();
+	m_valid = true;
+
+	return STATERR_NONE;
+#else
+	return STATERR_DISABLED;
+#endif
+}
+
+
+//-------------------------------------------------
+//  load - wake the frozen child and stream its
+//  image back into the registered entries
+//-------------------------------------------------
+
+save_error fork_state::load()
+{
+#ifdef __linux__
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	if (!m_valid || m_pid <= 0)
+		return STATERR_NOT_FOUND;
+
+	if (write(m_control_fd, "w", 1) != 1)
+	{
+		discard();
+		return STATERR_READ_ERROR;
+	}
+
+	// the child walks the entry list in this same order
+	for (auto &entry : m_save.m_entry_list)
+	{
+		u8 *dest = (u8 *)entry->m_data;
+		size_t remaining = entry->m_typesize * entry->m_typecount;
+		while (remaining > 0)
+		{
+			const ssize_t got = read(m_data_fd, dest, remaining);
+			if (got <= 0)
+			{
+				discard();
+				return STATERR_READ_ERROR;
+			}
+			dest += got;
+			remaining -= size_t(got);
+		}
+	}
+
+	// call the post-load functions
+	m_save.dispatch_postload();
+
+	return STATERR_NONE;
+#else
+	return STATERR_DISABLED;
+#endif
+}
+
+
 //-------------------------------------------------
 //  rewinder - constuctor
 //-------------------------------------------------
@@ -644,10 +1131,14 @@ bool rewinder::capture()
 		return false;
 	}
 
+	// deltas need a base to diff against; capture it on first use
+	if (!m_save.has_incremental_base())
+		m_save.capture_incremental_base();
+
 	if (current_index_is_last())
 	{
 		// we need to create a new state
-		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save);
+		std::unique_ptr<delta_state> state = std::make_unique<delta_state>(m_save);
 		const save_error error = state->save();
 
 		// validate the state
@@ -667,7 +1158,7 @@ bool rewinder::capture()
 		invalidate();
 
 		// update the existing state
-		ram_state *state = m_state_list.at(m_current_index).get();
+		delta_state *state = m_state_list.at(m_current_index).get();
 		const save_error error = state->save();
 
 		// validate the state
@@ -722,7 +1213,7 @@ bool rewinder::step()
 		m_current_index = m_first_invalid_index;
 
 	// step back and obtain the state pointer
-	ram_state *state = m_state_list.at(--m_current_index).get();
+	delta_state *state = m_state_list.at(--m_current_index).get();
 
 	// try to load and report the result
 	const save_error error = state->load();
@@ -746,26 +1237,32 @@ bool rewinder::check_size()
 	if (!m_enabled)
 		return false;
 
-	// state sizes in bytes
-	const size_t singlesize = ram_state::get_size(m_save);
-	size_t totalsize = m_state_list.size() * singlesize;
+	// deltas vary in size, so account by the bytes actually held, plus
+	// the shared base capture
+	size_t totalsize = m_save.binary_size();
+	for (auto &state : m_state_list)
+		totalsize += state->size();
+
+	// estimate the next capture at the size of the newest delta
+	const size_t singlesize = m_state_list.empty() ? 0 : m_state_list.back()->size();
 
 	// convert our limit from megabytes
 	const size_t capsize = m_capacity * 1024 * 1024;
 
-	// safety check that shouldn't be allowed to trigger
-	if (totalsize > capsize)
+	// deltas are self-contained against the shared base, so dropping the
+	// oldest never invalidates newer ones
+	while (totalsize > capsize && m_state_list.size() > 1)
 	{
-		// states to remove
-		const u32 count = (totalsize - capsize) / singlesize;
+		totalsize -= m_state_list.front()->size();
+		m_state_list.erase(m_state_list.begin());
 
-		// drop everything that's beyond capacity
-		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+		// keep the indices pointing at the same states
+		if (m_current_index > REWIND_INDEX_FIRST)
+			m_current_index--;
+		if (m_first_invalid_index > REWIND_INDEX_NONE)
+			m_first_invalid_index--;
 	}
 
-	// update before new check
-	totalsize = m_state_list.size() * singlesize;
-
 	// check if capacity will be hit by the newly captured state
 	if (totalsize + singlesize >= capsize)
 	{
@@ -775,7 +1272,7 @@ bool rewinder::check_size()
 			return false;
 
 		// we can now get the first state and invalidate it
-		std::unique_ptr<ram_state> first(std::move(m_state_list.front()));
+		std::unique_ptr<delta_state> first(std::move(m_state_list.front()));
 		first->m_valid = false;
 
 		// move it to the end for future use
@@ -872,6 +1369,182 @@ void rewinder::report_error(save_error error, rewind_operation operation)
 }
 
 
+
+
+//**************************************************************************
+//  CONTINUOUS BACKGROUND AUTOSAVE
+//**************************************************************************
+
+//-------------------------------------------------
+//  background_autosaver - constructor
+//-------------------------------------------------
+
+background_autosaver::background_autosaver(save_manager &save)
+	: m_save(save)
+	, m_timer(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  ~background_autosaver - destructor
+//-------------------------------------------------
+
+background_autosaver::~background_autosaver()
+{
+	// queued merge jobs capture this object; drain them before it goes
+	// away (the video manager outlives the save manager)
+	if (m_timer != nullptr)
+		m_save.machine().video().writer().flush();
+}
+
+
+//-------------------------------------------------
+//  start - begin the rolling one-second captures
+//-------------------------------------------------
+
+void background_autosaver::start()
+{
+	if (m_timer == nullptr)
+		m_timer = m_save.machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(background_autosaver::timer_tick), this));
+	m_timer->adjust(attotime::from_seconds(1), 0, attotime::from_seconds(1));
+}
+
+
+//-------------------------------------------------
+//  timer_tick - periodic capture callback
+//-------------------------------------------------
+
+void background_autosaver::timer_tick(void *ptr, int param)
+{
+	capture();
+}
+
+
+//-------------------------------------------------
+//  capture - record this second's changes on the
+//  emulation thread and hand them to the writer
+//-------------------------------------------------
+
+void background_autosaver::capture()
+{
+	// anonymous timers in flight: skip this tick and retry next second
+	if (!m_save.machine().scheduler().can_save())
+		return;
+
+	// first capture: lay down the incremental base, the flat image and the
+	// entry layout; the payload is seeded from the base rather than the
+	// current state, because the base may predate us (rollback or the
+	// rewinder may have captured it), and the delta skip test below diffs
+	// against the base -- the image and the test must agree on their
+	// reference point or entries that revert to their base value would
+	// leave stale bytes in the image forever.  The scan below then brings
+	// every entry that currently differs into the image as a delta.
+	if (m_image.empty())
+	{
+		if (!m_save.has_incremental_base())
+			m_save.capture_incremental_base();
+		if (m_save.write_data(m_image) != STATERR_NONE)
+		{
+			m_image.clear();
+			m_timer->adjust(attotime::never);
+			return;
+		}
+		assert(m_image.size() == HEADER_SIZE + m_save.m_incremental_base.size());
+		memcpy(&m_image[HEADER_SIZE], &m_save.m_incremental_base[0], m_save.m_incremental_base.size());
+		m_layout.reserve(m_save.m_entry_list.size());
+		for (auto &entry : m_save.m_entry_list)
+			m_layout.emplace_back(entry->m_offset, entry->m_typesize * entry->m_typecount);
+	}
+
+	// record the entries that changed against the base, exactly like an
+	// incremental save state
+	m_save.dispatch_presave();
+	auto records = std::make_shared<std::vector<u8> >();
+	const u32 generation = ++m_save.m_incremental_generation;
+	for (u32 index = 0; index < u32(m_save.m_entry_list.size()); index++)
+	{
+		state_entry &entry = *m_save.m_entry_list[index];
+		const u32 totalsize = entry.m_typesize * entry.m_typecount;
+
+		// once dirty, an entry stays in every delta; see delta_state::save
+		if (entry.m_dirty_generation == 0)
+		{
+			if (util::block_equal(&m_save.m_incremental_base[entry.m_offset], entry.m_data, totalsize))
+				continue;
+			entry.m_dirty_generation = generation;
+		}
+
+		const u8 *bytes = reinterpret_cast<const u8 *>(entry.m_data);
+		const u8 *idx = reinterpret_cast<const u8 *>(&index);
+		records->insert(records->end(), idx, idx + sizeof(index));
+		records->insert(records->end(), bytes, bytes + totalsize);
+	}
+	enqueue_write(std::move(records));
+}
+
+
+//-------------------------------------------------
+//  enqueue_write - merge the records into the
+//  retained image and rewrite the file, all on
+//  the background writer
+//-------------------------------------------------
+
+void background_autosaver::enqueue_write(std::shared_ptr<std::vector<u8> > records)
+{
+	m_save.machine().video().writer().enqueue([this, records]() {
+		// merge the delta records into the retained image
+		if (records)
+		{
+			size_t pos = 0;
+			while (pos + sizeof(u32) <= records->size())
+			{
+				u32 index;
+				memcpy(&index, &(*records)[pos], sizeof(index));
+				pos += sizeof(index);
+				if (index >= m_layout.size() || pos + m_layout[index].second > records->size())
+					return; // malformed; drop the update rather than corrupt the image
+				memcpy(&m_image[HEADER_SIZE + m_layout[index].first], &(*records)[pos], m_layout[index].second);
+				pos += m_layout[index].second;
+			}
+		}
+		write_image();
+	});
+}
+
+
+//-------------------------------------------------
+//  write_image - rewrite the autosave file from
+//  the retained image, swapping it in atomically
+//-------------------------------------------------
+
+void background_autosaver::write_image()
+{
+	// serialize beside the final file so the swap is a rename
+	const char *searchpath = nullptr;
+	std::string filename = m_save.machine().compose_saveload_filename("auto", &searchpath);
+	emu_file file((searchpath != nullptr) ? searchpath : "", OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename + ".tmp") != osd_file::error::NONE)
+		return;
+	std::string tmppath = file.fullpath();
+	if (save_manager::write_data_to_file(file, m_image) != STATERR_NONE)
+	{
+		file.remove_on_close();
+		return;
+	}
+	file.close();
+
+	// atomically replace the previous autosave
+	std::string finalpath = tmppath.substr(0, tmppath.length() - 4);
+	if (std::rename(tmppath.c_str(), finalpath.c_str()) != 0)
+	{
+		// on filesystems that refuse to clobber, drop the old file first
+		std::remove(finalpath.c_str());
+		std::rename(tmppath.c_str(), finalpath.c_str());
+	}
+}
+
+
 //-------------------------------------------------
 //  state_entry - constructor
 //-------------------------------------------------
@@ -886,6 +1559,7 @@ state_entry::state_entry(void *data, const char *name, device_t *device, const c
 	, m_typesize(size)
 	, m_typecount(count)
 	, m_offset(0)
+	, m_dirty_generation(0)
 {
 }
 
@@ -81,10 +81,15 @@ public:
 	u8              m_typesize;             // size of the raw data type
 	u32             m_typecount;            // number of items
 	u32             m_offset;               // offset within the final structure
+	u32             m_dirty_generation;     // last incremental generation this item differed from the base
 };
 
 class ram_state;
+class delta_state;
+class fork_state;
 class rewinder;
+class background_autosaver;
+class emu_timer;
 
 class save_manager
 {
@@ -116,7 +121,10 @@ class save_manager
 	template<typename ItemType> struct type_checker<ItemType*> { static const bool is_atom = false; static const bool is_pointer = true; };
 
 	friend class ram_state;
+	friend class delta_state;
+	friend class fork_state;
 	friend class rewinder;
+	friend class background_autosaver;
 
 public:
 	// construction/destruction
@@ -125,6 +133,7 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	rewinder *rewind() { return m_rewind.get(); }
+	background_autosaver *autosave() { return m_autosave.get(); }
 	int registration_count() const { return m_entry_list.size(); }
 	bool registration_allowed() const { return m_reg_allowed; }
 
@@ -143,6 +152,19 @@ public:
 	// generic memory registration
 	void save_memory(device_t *device, const char *module, const char *tag, u32 index, const char *name, void *val, u32 valsize, u32 valcount = 1);
 
+	// derive the netplay sync block list from the registered entries
+	void create_network_blocks();
+
+	// incremental (delta) state support
+	void capture_incremental_base();
+	bool has_incremental_base() const { return !m_incremental_base.empty(); }
+
+	// zero-copy flat capture into a caller-provided buffer; the layout is
+	// computed once when registration closes
+	size_t binary_size() const { return m_flat_size; }
+	save_error save_binary(void *buf, size_t size);
+	save_error load_binary(const void *buf, size_t size);
+
 	// templatized wrapper for general objects and arrays
 	template<typename ItemType>
 	void save_item(device_t *device, const char *module, const char *tag, int index, ItemType &value, const char *valname)
@@ -183,9 +205,15 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// split-phase variant of write_file: serialize on the emulation
+	// thread, compress and write on a worker
+	save_error write_data(std::vector<u8> &data);
+	static save_error write_data_to_file(emu_file &file, const std::vector<u8> &data);
+
 private:
 	// internal helpers
 	u32 signature() const;
+	void compute_layout();
 	void dump_registry() const;
 	static save_error validate_header(const u8 *header, const char *gamename, u32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
@@ -202,6 +230,7 @@ private:
 	// internal state
 	running_machine &         m_machine;              // reference to our machine
 	std::unique_ptr<rewinder> m_rewind;               // rewinder
+	std::unique_ptr<background_autosaver> m_autosave;   // continuous background autosave
 	bool                      m_reg_allowed;          // are registrations allowed?
 	s32                       m_illegal_regs;         // number of illegal registrations
 
@@ -209,6 +238,10 @@ private:
 	std::vector<std::unique_ptr<ram_state>>      m_ramstate_list;    // list of ram states
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
+
+	std::vector<u8>           m_incremental_base;     // flat copy of every entry, base for delta states
+	u32                       m_incremental_generation; // bumped per delta save, tags dirty entries
+	size_t                    m_flat_size;            // total size of the flat binary layout
 };
 
 class ram_state
@@ -226,6 +259,50 @@ public:
 	save_error load();
 };
 
+// incremental snapshot: records only the items that changed relative to
+// the base captured by save_manager::capture_incremental_base(), so a
+// per-frame save touches kilobytes instead of the whole save set
+class delta_state
+{
+	save_manager &     m_save;                        // reference to save_manager
+	util::vectorstream m_data;                        // delta records (entry index + payload)
+	size_t             m_length;                      // bytes of the stream written by the last save
+
+public:
+	bool               m_valid;                       // can we load this state?
+	attotime           m_time;                        // machine timestamp
+
+	delta_state(save_manager &save);
+	save_error save();
+	save_error load();
+	size_t size() const { return m_length; }
+};
+
+// OS-assisted snapshot: fork() freezes a copy-on-write image of the whole
+// process, so capture cost is a page table copy regardless of how much
+// state is registered; the frozen child streams the flat state back on
+// demand at load time and stays alive until discarded, so one capture can
+// be restored any number of times. Linux only; save() fails cleanly
+// elsewhere.
+class fork_state
+{
+	save_manager &     m_save;                        // reference to save_manager
+	int                m_control_fd;                  // write end: wakes the frozen child
+	int                m_data_fd;                     // read end: serialized state from the child
+	int                m_pid;                         // frozen child process, or -1
+
+	void discard();
+
+public:
+	bool               m_valid;                       // can we load this state?
+	attotime           m_time;                        // machine timestamp
+
+	fork_state(save_manager &save);
+	~fork_state();
+	save_error save();
+	save_error load();
+};
+
 class rewinder
 {
 	save_manager & m_save;                            // reference to save_manager
@@ -235,7 +312,7 @@ class rewinder
 	s32            m_first_invalid_index;             // all states before this one are guarateed to be valid
 	bool           m_first_time_warning;              // keep track of warnings we report
 	bool           m_first_time_note;                 // keep track of notes
-	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
+	std::vector<std::unique_ptr<delta_state>> m_state_list; // rewinder's own delta states
 
 	// load/save management
 	enum class rewind_operation
@@ -263,6 +340,30 @@ public:
 	bool step();
 };
 
+// continuous background autosave: once a second the emulation thread
+// records just the entries that changed (kilobytes, via the incremental
+// dirty tracking); the background writer merges them into a retained flat
+// image, rewrites the autosave file and swaps it in with an atomic
+// rename, so power-loss recovery never costs frame time and never sees a
+// half-written file
+class background_autosaver
+{
+	save_manager & m_save;                            // reference to save_manager
+	emu_timer *    m_timer;                           // one-second capture timer, nullptr until started
+	std::vector<u8> m_image;                          // header + flat state; updated by writer jobs once captured
+	std::vector<std::pair<u32, u32> > m_layout;       // entry index -> (flat offset, bytes)
+
+	void enqueue_write(std::shared_ptr<std::vector<u8> > records);
+	void write_image();
+
+public:
+	background_autosaver(save_manager &save);
+	~background_autosaver();
+	void start();
+	void timer_tick(void *ptr, int param);
+	void capture();
+};
+
 
 // template specializations to enumerate the fundamental atomic types you are allowed to save
 ALLOW_SAVE_TYPE_AND_ARRAY(char)
@@ -10,6 +10,9 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "emuopts.h"
+
+#include <set>
 
 //**************************************************************************
 //  DEBUGGING
@@ -34,6 +37,10 @@ enum
 	TRIGGER_SUSPENDTIME = -4000
 };
 
+// worker threads record the device they are executing here so that time()
+// resolves against the right local time off the main thread
+static thread_local device_execute_interface *s_worker_device = nullptr;
+
 
 
 //**************************************************************************
@@ -48,6 +55,10 @@ emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
 		m_prev(nullptr),
+		m_heap_child(nullptr),
+		m_heap_sibling(nullptr),
+		m_heap_prev(nullptr),
+		m_heap_seq(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -81,12 +92,17 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_child = nullptr;
+	m_heap_sibling = nullptr;
+	m_heap_prev = nullptr;
+	m_heap_seq = 0;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
 	m_enabled = false;
 	m_temporary = temporary;
 	m_period = attotime::never;
+	m_tolerance = attotime::zero;
 	m_start = machine.time();
 	m_expire = attotime::never;
 	m_device = nullptr;
@@ -113,12 +129,17 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_child = nullptr;
+	m_heap_sibling = nullptr;
+	m_heap_prev = nullptr;
+	m_heap_seq = 0;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
 	m_enabled = false;
 	m_temporary = temporary;
 	m_period = attotime::never;
+	m_tolerance = attotime::zero;
 	m_start = machine().time();
 	m_expire = attotime::never;
 	m_device = &device;
@@ -155,6 +176,16 @@ bool emu_timer::enable(bool enable)
 {
 	// reschedule only if the state has changed
 	bool old = m_enabled;
+
+	// worker threads hand the state change back to the main thread
+	device_scheduler &scheduler = machine().scheduler();
+	if (UNEXPECTED(scheduler.executing_on_worker()))
+	{
+		if (old != enable)
+			scheduler.defer_from_worker([this, enable] { this->enable(enable); });
+		return old;
+	}
+
 	if (old != enable)
 	{
 		// set the enable flag
@@ -176,8 +207,17 @@ bool emu_timer::enable(bool enable)
 
 void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period)
 {
-	// if this is the callback timer, mark it modified
+	// worker threads may not touch the timer heap; replay the adjust on the
+	// main thread when the quantum ends
 	device_scheduler &scheduler = machine().scheduler();
+	if (UNEXPECTED(scheduler.executing_on_worker()))
+	{
+		attotime p = period;
+		scheduler.defer_from_worker([this, start_delay, param, p] { adjust(start_delay, param, p); });
+		return;
+	}
+
+	// if this is the callback timer, mark it modified
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
@@ -193,13 +233,14 @@ void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period)
 	m_start = scheduler.time();
 	m_expire = m_start + start_delay;
 	m_period = period;
+	apply_tolerance();
 
 	// remove and re-insert the timer in its new order
 	scheduler.timer_list_remove(*this);
 	scheduler.timer_list_insert(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the earliest timer, abort the current timeslice and resync
+	if (this == scheduler.m_timer_heap)
 		scheduler.abort_timeslice();
 }
 
@@ -272,6 +313,25 @@ void emu_timer::register_save()
 }
 
 
+//-------------------------------------------------
+//  apply_tolerance - round the expiry time up
+//  onto the grid declared by the tolerance, so
+//  that timers sharing a tolerance fire on shared
+//  ticks instead of fragmenting the timeline
+//-------------------------------------------------
+
+inline void emu_timer::apply_tolerance()
+{
+	const attoseconds_t tol = m_tolerance.attoseconds();
+	if (tol != 0 && !m_expire.is_never())
+	{
+		const attoseconds_t rem = m_expire.attoseconds() % tol;
+		if (rem != 0)
+			m_expire += attotime(0, tol - rem);
+	}
+}
+
+
 //-------------------------------------------------
 //  schedule_next_period - schedule the next
 //  period
@@ -282,6 +342,7 @@ inline void emu_timer::schedule_next_period()
 	// advance by one period
 	m_start = m_expire;
 	m_expire += m_period;
+	apply_tolerance();
 
 	// remove and re-insert us
 	device_scheduler &scheduler = machine().scheduler();
@@ -323,6 +384,18 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_heap(nullptr),
+	m_timer_seq(0),
+	m_adaptive_enabled(machine.options().adaptive_quantum()),
+	m_cross_events(0),
+	m_adaptive_factor(1),
+	m_adaptive_next_check(attotime::zero),
+	m_quantum_relax(1),
+	m_parallel_enabled(machine.options().parallel_schedule()),
+	m_parallel_analyzed(false),
+	m_parallel_queue(nullptr),
+	m_parallel_target(attotime::zero),
+	m_main_thread(std::this_thread::get_id()),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
@@ -333,6 +406,10 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
 	m_timer_list->adjust(attotime::never);
 
+	// if parallel timeslices were requested, create a work queue for them
+	if (m_parallel_enabled)
+		m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
 	machine.save().register_presave(save_prepost_delegate(FUNC(device_scheduler::presave), this));
@@ -346,6 +423,10 @@ device_scheduler::device_scheduler(running_machine &machine) :
 
 device_scheduler::~device_scheduler()
 {
+	// tear down the work queue before anything it might reference
+	if (m_parallel_queue != nullptr)
+		osd_work_queue_free(m_parallel_queue);
+
 	// remove all timers
 	while (m_timer_list != nullptr)
 		m_timer_allocator.reclaim(m_timer_list->release());
@@ -358,6 +439,11 @@ device_scheduler::~device_scheduler()
 
 attotime device_scheduler::time() const
 {
+	// on a worker thread, always report the executing device's local time;
+	// the callback timer and m_executing_device belong to the main thread
+	if (UNEXPECTED(s_worker_device != nullptr))
+		return s_worker_device->local_time();
+
 	// if we're currently in a callback, use the timer's expiration time as a base
 	if (m_callback_timer != nullptr)
 		return m_callback_timer_expire_time;
@@ -403,6 +489,7 @@ inline void device_scheduler::apply_suspend_changes()
 		exec->m_suspend = exec->m_nextsuspend;
 		exec->m_nextsuspend &= ~SUSPEND_REASON_TIMESLICE;
 		exec->m_eatcycles = exec->m_nexteatcycles;
+		exec->update_run_state();
 	}
 
 	// recompute the execute list if any CPUs changed their suspension state
@@ -420,25 +507,43 @@ inline void device_scheduler::apply_suspend_changes()
 
 void device_scheduler::timeslice()
 {
+	TRACE_EVENT_SCOPE("scheduler_timeslice");
+
 	bool call_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
 
 	// build the execution list if we don't have one yet
 	if (UNEXPECTED(m_execute_list == nullptr))
 		rebuild_execute_list();
 
+	// address maps are final by the time we first get here; classify devices once
+	if (UNEXPECTED(m_parallel_enabled && !m_parallel_analyzed))
+		compute_parallel_groups();
+
 	// if the current quantum has expired, find a new one
 	while (m_basetime >= m_quantum_list.first()->m_expire)
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
+	// periodically re-evaluate the adaptive widening factor
+	if (UNEXPECTED(m_adaptive_enabled && m_basetime >= m_adaptive_next_check))
+	{
+		adaptive_update();
+		m_adaptive_next_check = m_basetime + attotime::from_hz(60);
+	}
+
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap->sched_expire())
 	{
-		// by default, assume our target is the end of the next quantum
-		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
+		// by default, assume our target is the end of the next quantum,
+		// widened if the CPUs have not been talking to each other
+		attoseconds_t quantum = m_quantum_list.first()->m_actual;
+		u32 const widen = std::max(m_adaptive_factor, m_quantum_relax);
+		if (UNEXPECTED(widen > 1))
+			quantum = std::min<attoseconds_t>(quantum * widen, ATTOSECONDS_PER_SECOND / 60);
+		attotime target(m_basetime + attotime(0, quantum));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap->sched_expire() < target)
+			target = m_timer_heap->sched_expire();
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -447,91 +552,322 @@ void device_scheduler::timeslice()
 		if (m_suspend_changes_pending)
 			apply_suspend_changes();
 
+		// hand the parallel-safe devices off to the worker threads; the
+		// debugger requires strictly serial execution
+		bool parallel = m_parallel_enabled && !call_debugger && !m_parallel_list.empty();
+		if (parallel)
+		{
+			m_parallel_target = target;
+			for (device_execute_interface *exec : m_parallel_list)
+				osd_work_item_queue(m_parallel_queue, &device_scheduler::timeslice_worker, exec, WORK_ITEM_FLAG_AUTO_RELEASE);
+		}
+
 		// loop over all CPUs
 		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+			// skip devices that were handed to the workers above
+			if (parallel && exec->m_parallel_safe)
+				continue;
+
+			execute_one(*exec, target, call_debugger, false);
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec->m_localtime < target)
+			{
+				target = std::max(exec->m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
+			}
+		}
+		m_executing_device = nullptr;
+
+		// join the workers at the quantum boundary and pull the target back
+		// to the slowest device
+		if (parallel)
+		{
+			osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second());
+			for (device_execute_interface *exec : m_parallel_list)
+				if (exec->m_localtime < target)
+					target = std::max(exec->m_localtime, m_basetime);
+
+			// replay any scheduler services the workers raised mid-slice
+			drain_deferred_ops();
+		}
+
+		// update the base time
+		m_basetime = target;
+	}
+
+	// execute timers
+	execute_timers();
+}
+
+
+//-------------------------------------------------
+//  execute_one - run a single device up to the
+//  target time; called from the main loop and
+//  from the worker threads
+//-------------------------------------------------
+
+void device_scheduler::execute_one(device_execute_interface &exec_ref, const attotime &target, bool call_debugger, bool from_worker)
+{
+	device_execute_interface *exec = &exec_ref;
+
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check);
+	// the compacted run state folds the suspend tests into a single load
+	u32 const runstate = exec->m_run_state.load(std::memory_order_relaxed);
+	if (EXPECTED(runstate != device_execute_interface::RUN_SKIP && target.seconds() >= exec->m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec->m_localtime).as_attoseconds());
+
+		if (exec->m_attoseconds_per_cycle == 0)
+		{
+			exec->m_localtime = target;
+		}
+		// if we have enough for at least 1 cycle, do the math
+		else if (delta >= exec->m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
+			LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (runstate == device_execute_interface::RUN_NORMAL)
+			{
+				// the profiler's context stack is main-thread-only
+				if (!from_worker)
+					g_profiler.start(exec->m_profiler);
+				osd_ticks_t hoststart = get_profile_ticks();
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec->m_cycles_stolen = 0;
+				if (!from_worker)
+					m_executing_device = exec;
+				else
+					s_worker_device = exec;
+				*exec->m_icountptr = exec->m_cycles_running;
+				if (!call_debugger)
+					exec->run();
+				else
+				{
+					exec->debugger_start_cpu_hook(target);
+					exec->run();
+					exec->debugger_stop_cpu_hook();
+				}
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec->m_icountptr);
+				ran -= *exec->m_icountptr;
+				assert(ran >= exec->m_cycles_stolen);
+				ran -= exec->m_cycles_stolen;
+
+				// charge the host time to this device; each device runs on
+				// exactly one thread at a time, so this never races
+				exec->m_host_ticks += get_profile_ticks() - hoststart;
+				if (!from_worker)
+					g_profiler.stop();
+				else
+					s_worker_device = nullptr;
+			}
+
+			// account for these cycles
+			exec->m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime;
+			if (ran < exec->m_cycles_per_second)
+				deltatime = attotime(0, exec->m_attoseconds_per_cycle * ran);
+			else
+			{
+				u32 remainder;
+				s32 secs = divu_64x32_rem(ran, exec->m_cycles_per_second, &remainder);
+				deltatime = attotime(secs, u64(remainder) * exec->m_attoseconds_per_cycle);
+			}
+			assert(deltatime >= attotime::zero);
+			exec->m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, s32(exec->m_totalcycles), exec->m_localtime.as_string(PRECISION)));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  timeslice_worker - osd_work_queue callback
+//  that runs one parallel-safe device up to the
+//  shared target time
+//-------------------------------------------------
+
+void *device_scheduler::timeslice_worker(void *param, int threadid)
+{
+	device_execute_interface &exec = *reinterpret_cast<device_execute_interface *>(param);
+	device_scheduler &scheduler = exec.device().machine().scheduler();
+	scheduler.execute_one(exec, scheduler.m_parallel_target, false, true);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  defer_from_worker - queue an operation raised
+//  on a worker thread for replay on the main
+//  thread at the quantum boundary
+//-------------------------------------------------
+
+void device_scheduler::defer_from_worker(std::function<void ()> &&op)
+{
+	std::lock_guard<std::mutex> lock(m_deferred_mutex);
+	m_deferred_ops.push_back(std::move(op));
+}
+
+
+//-------------------------------------------------
+//  drain_deferred_ops - replay the operations the
+//  workers handed back; called on the main thread
+//  after the workers have been joined
+//-------------------------------------------------
+
+void device_scheduler::drain_deferred_ops()
+{
+	std::vector<std::function<void ()> > ops;
+	{
+		std::lock_guard<std::mutex> lock(m_deferred_mutex);
+		ops.swap(m_deferred_ops);
+	}
+	for (auto &op : ops)
+		op();
+}
+
+
+//-------------------------------------------------
+//  compute_parallel_groups - analyze the address
+//  maps of all executing devices and collect the
+//  ones whose memory footprints are provably
+//  disjoint from everybody else's
+//-------------------------------------------------
+
+void device_scheduler::compute_parallel_groups()
+{
+	m_parallel_analyzed = true;
+	m_parallel_list.clear();
+
+	// returns true if the given full tag names the device or one of its children
+	auto within_subtree = [] (const std::string &target, device_t &device)
+	{
+		const char *tag = device.tag();
+		const size_t taglen = strlen(tag);
+		if (target.compare(0, taglen, tag) != 0)
+			return false;
+		return target.length() == taglen || target[taglen] == ':';
+	};
+
+	// collect the shared resources each executing device can touch; anything
+	// we cannot account for pins its device to the main thread
+	std::vector<device_execute_interface *> execs;
+	std::vector<std::set<std::string>> footprints;
+	std::vector<bool> analyzable;
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+	{
+		std::set<std::string> footprint;
+		bool safe = true;
+
+		device_memory_interface *memory;
+		if (!exec.device().interface(memory))
+			safe = false;
+		else
+			for (int spacenum = 0; safe && spacenum < memory->max_space_count(); spacenum++)
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
+				if (!memory->has_space(spacenum))
+					continue;
+				address_space &space = memory->space(spacenum);
 
-				if (exec->m_attoseconds_per_cycle == 0)
+				// handlers installed at run time are invisible to this
+				// analysis, so any space that has seen one is off limits
+				if (space.runtime_modified())
 				{
-					exec->m_localtime = target;
+					safe = false;
+					break;
 				}
-				// if we have enough for at least 1 cycle, do the math
-				else if (delta >= exec->m_attoseconds_per_cycle)
+
+				address_map *map = space.map();
+				if (map == nullptr)
 				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
+					safe = false;
+					break;
+				}
+				for (address_map_entry &entry : map->m_entrylist)
+				{
+					// plain ROM/RAM is private unless explicitly shared
+					if (entry.m_share != nullptr)
+						footprint.insert("share:" + entry.m_devbase.subtag(entry.m_share));
 
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
+					for (const map_handler_data *data : { &entry.m_read, &entry.m_write })
+						switch (data->m_type)
 						{
-							exec->debugger_start_cpu_hook(target);
-							exec->run();
-							exec->debugger_stop_cpu_hook();
+						// self-contained or read-only accesses
+						case AMH_NONE:
+						case AMH_RAM:
+						case AMH_ROM:
+						case AMH_NOP:
+						case AMH_UNMAP:
+						case AMH_PORT:
+							break;
+
+						// banks can be shared between CPUs
+						case AMH_BANK:
+							footprint.insert("bank:" + entry.m_devbase.subtag(data->m_tag));
+							break;
+
+						// handlers reaching devices outside our own subtree are shared
+						default:
+							if (data->m_tag != nullptr)
+							{
+								std::string target = entry.m_devbase.subtag(data->m_tag);
+								if (!within_subtree(target, exec.device()))
+									footprint.insert("dev:" + target);
+							}
+							else
+								safe = false;   // no way to tell what this handler touches
+							break;
 						}
+				}
+			}
 
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime;
-					if (ran < exec->m_cycles_per_second)
-						deltatime = attotime(0, exec->m_attoseconds_per_cycle * ran);
-					else
-					{
-						u32 remainder;
-						s32 secs = divu_64x32_rem(ran, exec->m_cycles_per_second, &remainder);
-						deltatime = attotime(secs, u64(remainder) * exec->m_attoseconds_per_cycle);
-					}
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, s32(exec->m_totalcycles), exec->m_localtime.as_string(PRECISION)));
+		execs.push_back(&exec);
+		footprints.push_back(std::move(footprint));
+		analyzable.push_back(safe);
+	}
 
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
+	// a device is parallel-safe if it was fully analyzable and none of its
+	// shared resources are visible to any other executing device
+	for (size_t i = 0; i < execs.size(); i++)
+	{
+		bool safe = analyzable[i];
+		for (size_t j = 0; safe && j < execs.size(); j++)
+			if (i != j)
+				for (const std::string &resource : footprints[i])
+					if (footprints[j].find(resource) != footprints[j].end())
 					{
-						target = std::max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
+						safe = false;
+						break;
 					}
-				}
-			}
-		}
-		m_executing_device = nullptr;
+		execs[i]->m_parallel_safe = safe;
+		if (safe)
+			m_parallel_list.push_back(execs[i]);
+	}
 
-		// update the base time
-		m_basetime = target;
+	// a single safe device gains nothing from a worker thread
+	if (m_parallel_list.size() < 2)
+	{
+		for (device_execute_interface *exec : m_parallel_list)
+			exec->m_parallel_safe = false;
+		m_parallel_list.clear();
 	}
 
-	// execute timers
-	execute_timers();
+	machine().logerror("Parallel scheduling: %d of %d executing devices proven independent\n", int(m_parallel_list.size()), int(execs.size()));
 }
 
 
@@ -542,6 +878,11 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
+	// m_executing_device belongs to the main thread, and workers stop at the
+	// quantum boundary anyway, where deferred operations are drained
+	if (UNEXPECTED(executing_on_worker()))
+		return;
+
 	if (m_executing_device != nullptr)
 		m_executing_device->abort_timeslice();
 }
@@ -553,10 +894,22 @@ void device_scheduler::abort_timeslice()
 
 void device_scheduler::trigger(int trigid, const attotime &after)
 {
+	// triggers poke every executing device; replay from the main thread
+	if (UNEXPECTED(executing_on_worker()))
+	{
+		attotime a = after;
+		defer_from_worker([this, trigid, a] { trigger(trigid, a); });
+		return;
+	}
+
 	// ensure we have a list of executing devices
 	if (m_execute_list == nullptr)
 		rebuild_execute_list();
 
+	// triggers raised while a device is executing are cross-CPU traffic
+	if (m_executing_device != nullptr)
+		note_cross_device_communication();
+
 	// if we have a non-zero time, schedule a timer
 	if (after != attotime::zero)
 		timer_set(after, timer_expired_delegate(FUNC(device_scheduler::timed_trigger), this), trigid);
@@ -575,13 +928,57 @@ void device_scheduler::trigger(int trigid, const attotime &after)
 
 void device_scheduler::boost_interleave(const attotime &timeslice_time, const attotime &boost_duration)
 {
+	// the quantum list belongs to the main thread
+	if (UNEXPECTED(executing_on_worker()))
+	{
+		attotime ts = timeslice_time;
+		attotime bd = boost_duration;
+		defer_from_worker([this, ts, bd] { boost_interleave(ts, bd); });
+		return;
+	}
+
 	// ignore timeslices > 1 second
 	if (timeslice_time.seconds() > 0)
 		return;
+
+	// a driver asking for tighter interleave is the strongest possible
+	// signal that the CPUs are communicating
+	note_cross_device_communication();
+
 	add_scheduling_quantum(timeslice_time, boost_duration);
 }
 
 
+//-------------------------------------------------
+//  note_cross_device_communication - record one
+//  observed cross-CPU communication and collapse
+//  any quantum widening immediately
+//-------------------------------------------------
+
+void device_scheduler::note_cross_device_communication()
+{
+	if (!m_adaptive_enabled)
+		return;
+	m_cross_events++;
+	m_adaptive_factor = 1;
+}
+
+
+//-------------------------------------------------
+//  adaptive_update - re-evaluate the quantum
+//  widening factor based on the traffic seen
+//  since the last check
+//-------------------------------------------------
+
+void device_scheduler::adaptive_update()
+{
+	// after a quiet interval, widen; a couple of stray events are tolerated
+	if (m_cross_events <= 2 && m_adaptive_factor < 16)
+		m_adaptive_factor *= 2;
+	m_cross_events = 0;
+}
+
+
 //-------------------------------------------------
 //  timer_alloc - allocate a global non-device
 //  timer and return a pointer
@@ -589,6 +986,8 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
+	// allocation cannot be deferred because the caller needs the pointer
+	assert(!executing_on_worker());
 	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
 }
 
@@ -601,6 +1000,14 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
+	// the timer allocator and the heap belong to the main thread
+	if (UNEXPECTED(executing_on_worker()))
+	{
+		attotime d = duration;
+		defer_from_worker([this, d, callback, param, ptr] { timer_set(d, callback, param, ptr); });
+		return;
+	}
+
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
@@ -612,6 +1019,8 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
+	// allocation cannot be deferred because the caller needs the pointer
+	assert(!executing_on_worker());
 	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
 }
 
@@ -624,6 +1033,15 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
+	// the timer allocator and the heap belong to the main thread
+	if (UNEXPECTED(executing_on_worker()))
+	{
+		attotime d = duration;
+		device_t *dev = &device;
+		defer_from_worker([this, d, dev, id, param, ptr] { timer_set(d, *dev, id, param, ptr); });
+		return;
+	}
+
 	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
 }
 
@@ -815,56 +1233,33 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_list_insert - add a timer to the
+//  enumeration list and the expiration heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+	// prepend to the enumeration list; it carries no ordering
+	timer.m_prev = nullptr;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != nullptr)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// and add to the heap, which does all the sorting
+	heap_insert(timer);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  enumeration list and the expiration heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
+	// remove it from the enumeration list
 	if (timer.m_prev != nullptr)
 		timer.m_prev->m_next = timer.m_next;
 	else
@@ -873,23 +1268,119 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != nullptr)
 		timer.m_next->m_prev = timer.m_prev;
 
+	// and from the heap
+	heap_remove(timer);
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  heap_merge - merge two pairing heap roots,
+//  returning the one with the earlier expiration
+//-------------------------------------------------
+
+emu_timer *device_scheduler::heap_merge(emu_timer *a, emu_timer *b)
+{
+	// make a the winner; equal expirations fall back to the insertion
+	// sequence so same-instant timers fire FIFO, as the old sorted list
+	// guaranteed and drivers rely on
+	const attotime &a_expire = a->sched_expire();
+	const attotime &b_expire = b->sched_expire();
+	if (a_expire > b_expire || (a_expire == b_expire && a->m_heap_seq > b->m_heap_seq))
+		std::swap(a, b);
+
+	// attach b as a's first child
+	b->m_heap_sibling = a->m_heap_child;
+	if (a->m_heap_child != nullptr)
+		a->m_heap_child->m_heap_prev = b;
+	b->m_heap_prev = a;
+	a->m_heap_child = b;
+	return a;
+}
+
+
+//-------------------------------------------------
+//  heap_merge_pairs - collapse a chain of
+//  siblings into a single heap via the standard
+//  two-pass pairing
+//-------------------------------------------------
+
+emu_timer *device_scheduler::heap_merge_pairs(emu_timer *first)
+{
+	if (first == nullptr)
+		return nullptr;
+
+	emu_timer *second = first->m_heap_sibling;
+	first->m_heap_prev = first->m_heap_sibling = nullptr;
+	if (second == nullptr)
+		return first;
+
+	emu_timer *rest = second->m_heap_sibling;
+	second->m_heap_prev = second->m_heap_sibling = nullptr;
+
+	emu_timer *merged = heap_merge(first, second);
+	emu_timer *remainder = heap_merge_pairs(rest);
+	return (remainder != nullptr) ? heap_merge(merged, remainder) : merged;
+}
+
+
+//-------------------------------------------------
+//  heap_insert - O(1) insertion of a detached
+//  timer into the pairing heap
+//-------------------------------------------------
+
+void device_scheduler::heap_insert(emu_timer &timer)
+{
+	timer.m_heap_child = timer.m_heap_sibling = timer.m_heap_prev = nullptr;
+	timer.m_heap_seq = m_timer_seq++;
+	m_timer_heap = (m_timer_heap != nullptr) ? heap_merge(m_timer_heap, &timer) : &timer;
+}
+
+
+//-------------------------------------------------
+//  heap_remove - remove an arbitrary timer from
+//  the pairing heap
+//-------------------------------------------------
+
+void device_scheduler::heap_remove(emu_timer &timer)
+{
+	if (&timer == m_timer_heap)
+	{
+		// removing the root promotes the merged children
+		m_timer_heap = heap_merge_pairs(timer.m_heap_child);
+	}
+	else
+	{
+		// detach from the sibling chain; m_heap_prev is the parent when we're its first child
+		if (timer.m_heap_prev->m_heap_child == &timer)
+			timer.m_heap_prev->m_heap_child = timer.m_heap_sibling;
+		else
+			timer.m_heap_prev->m_heap_sibling = timer.m_heap_sibling;
+		if (timer.m_heap_sibling != nullptr)
+			timer.m_heap_sibling->m_heap_prev = timer.m_heap_prev;
+
+		// fold our children back into the heap
+		emu_timer *children = heap_merge_pairs(timer.m_heap_child);
+		if (children != nullptr)
+			m_timer_heap = heap_merge(m_timer_heap, children);
+	}
+	timer.m_heap_child = timer.m_heap_sibling = timer.m_heap_prev = nullptr;
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_heap->sched_expire().as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap->sched_expire() <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap;
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -17,6 +17,10 @@
 #ifndef MAME_EMU_SCHEDULE_H
 #define MAME_EMU_SCHEDULE_H
 
+#include <functional>
+#include <mutex>
+#include <thread>
+
 
 //**************************************************************************
 //  MACROS
@@ -50,6 +54,7 @@ class emu_timer
 	friend class device_scheduler;
 	friend class simple_list<emu_timer>;
 	friend class fixed_allocator<emu_timer>;
+	friend class arena_allocator<emu_timer>;
 	friend class resource_pool_object<emu_timer>;
 
 	// construction/destruction
@@ -74,6 +79,13 @@ public:
 	void set_param(int param) { m_param = param; }
 	void set_ptr(void *ptr) { m_ptr = ptr; }
 
+	// coalescing: a nonzero tolerance declares that this timer may fire up
+	// to that much late; expiry times get rounded onto the tolerance grid,
+	// so independent timers sharing a tolerance fire on shared ticks
+	// instead of each forcing its own tiny timeslice
+	attotime tolerance() const { return m_tolerance; }
+	void set_tolerance(const attotime &tolerance) { m_tolerance = tolerance; }
+
 	// control
 	void reset(const attotime &duration = attotime::never) { adjust(duration, m_param, m_period); }
 	void adjust(attotime start_delay, s32 param = 0, const attotime &periodicity = attotime::never);
@@ -88,18 +100,27 @@ private:
 	// internal helpers
 	void register_save();
 	void schedule_next_period();
+	void apply_tolerance();
 	void dump() const;
 
+	// the key the scheduler sorts on; disabled timers sort to the end
+	const attotime &sched_expire() const { return m_enabled ? m_expire : attotime::never; }
+
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the enumeration list
+	emu_timer *         m_prev;         // previous timer in the enumeration list
+	emu_timer *         m_heap_child;   // first child in the pairing heap
+	emu_timer *         m_heap_sibling; // next sibling in the pairing heap
+	emu_timer *         m_heap_prev;    // previous sibling, or parent if first child
+	u64                 m_heap_seq;     // insertion sequence; equal expirations fire FIFO
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
 	bool                m_enabled;      // is the timer enabled?
 	bool                m_temporary;    // is the timer temporary?
 	attotime            m_period;       // the repeat frequency of the timer
+	attotime            m_tolerance;    // how late this timer may fire (zero = exact)
 	attotime            m_start;        // time when the timer was started
 	attotime            m_expire;       // time when the timer will expire
 	device_t *          m_device;       // for device timers, a pointer to the device
@@ -128,10 +149,15 @@ public:
 
 	// execution
 	void timeslice();
+	bool parallel_enabled() const { return m_parallel_enabled; }
+	void invalidate_parallel_groups() { m_parallel_analyzed = false; }
 	void abort_timeslice();
 	void trigger(int trigid, const attotime &after = attotime::zero);
 	void boost_interleave(const attotime &timeslice_time, const attotime &boost_duration);
 	void suspend_resume_changed() { m_suspend_changes_pending = true; }
+	void note_cross_device_communication();
+	void set_quantum_relax(u32 factor) { m_quantum_relax = factor; }
+	u32 quantum_relax() const { return m_quantum_relax; }
 
 	// timers, specified by callback/name
 	emu_timer *timer_alloc(timer_expired_delegate callback, void *ptr = nullptr);
@@ -159,12 +185,31 @@ private:
 	void rebuild_execute_list();
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	void adaptive_update();
+
+	// parallel execution helpers
+	void compute_parallel_groups();
+	void execute_one(device_execute_interface &exec, const attotime &target, bool call_debugger, bool from_worker);
+	static void *timeslice_worker(void *param, int threadid);
+
+	// worker threads may not touch the timer heap, the allocators or other
+	// devices; operations they raise are queued and replayed on the main
+	// thread when the workers are joined at the quantum boundary
+	bool executing_on_worker() const { return m_parallel_queue != nullptr && std::this_thread::get_id() != m_main_thread; }
+	void defer_from_worker(std::function<void ()> &&op);
+	void drain_deferred_ops();
 
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
 	void execute_timers();
 
+	// pairing heap helpers
+	static emu_timer *heap_merge(emu_timer *a, emu_timer *b);
+	static emu_timer *heap_merge_pairs(emu_timer *first);
+	void heap_insert(emu_timer &timer);
+	void heap_remove(emu_timer &timer);
+
 	// internal state
 	running_machine &           m_machine;                  // reference to our machine
 	device_execute_interface *  m_executing_device;         // pointer to currently executing device
@@ -172,8 +217,27 @@ private:
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
 	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
-	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
+	emu_timer *                 m_timer_list;               // head of the (unsorted) enumeration list
+	emu_timer *                 m_timer_heap;               // root of the pairing heap; earliest expiration
+	arena_allocator<emu_timer>  m_timer_allocator;          // cache-line-packed allocator for timers
+	u64                         m_timer_seq;                // next heap insertion sequence number
+
+	// adaptive interleave state
+	bool                        m_adaptive_enabled;         // true if adaptive quanta were requested
+	u32                         m_cross_events;             // cross-CPU communications seen this interval
+	u32                         m_adaptive_factor;          // current quantum widening multiplier
+	attotime                    m_adaptive_next_check;      // when to next re-evaluate the factor
+	u32                         m_quantum_relax;            // externally requested quantum widening multiplier
+
+	// parallel execution state
+	bool                        m_parallel_enabled;         // true if parallel timeslices were requested
+	bool                        m_parallel_analyzed;        // true once the address maps have been analyzed
+	osd_work_queue *            m_parallel_queue;           // work queue for parallel-safe devices
+	attotime                    m_parallel_target;          // target time shared with the worker items
+	std::vector<device_execute_interface *> m_parallel_list; // devices proven safe to run off the main thread
+	std::thread::id             m_main_thread;              // the thread that owns the scheduler state
+	std::mutex                  m_deferred_mutex;           // protects the deferred operation list
+	std::vector<std::function<void ()> > m_deferred_ops;    // operations raised on workers, replayed at the join
 
 	// other internal states
 	emu_timer *                 m_callback_timer;           // pointer to the current callback timer
@@ -16,6 +16,7 @@
 #include <nanosvg/src/nanosvg.h>
 #include <nanosvg/src/nanosvgrast.h>
 #include <set>
+#include <thread>
 
 //**************************************************************************
 //  DEBUGGING
@@ -571,6 +572,7 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_changed(true)
 	, m_last_partial_scan(0)
 	, m_partial_scan_hpos(0)
+	, m_update_visible(true)
 	, m_color(rgb_t(0xff, 0xff, 0xff, 0xff))
 	, m_brightness(0xff)
 	, m_frame_period(DEFAULT_FRAME_PERIOD.as_attoseconds())
@@ -589,6 +591,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	m_unique_id = m_id_counter;
 	m_id_counter++;
 	memset(m_texture, 0, sizeof(m_texture));
+	m_texdirty[0].set(0, -1, 0, -1);
+	m_texdirty[1].set(0, -1, 0, -1);
 }
 
 
@@ -1056,22 +1060,14 @@ bool screen_device::update_partial(int scanline)
 
 	LOG_PARTIAL_UPDATES(("Partial: update_partial(%s, %d): ", tag(), scanline));
 
-	// these two checks only apply if we're allowed to skip frames
-	if (!(m_video_attributes & VIDEO_ALWAYS_UPDATE))
-	{
-		// if skipping this frame, bail
-		if (machine().video().skip_this_frame())
-		{
-			LOG_PARTIAL_UPDATES(("skipped due to frameskipping\n"));
-			return false;
-		}
+	// will anybody see what we render?
+	m_update_visible = !machine().video().skip_this_frame() && machine().render().is_live(*this);
 
-		// skip if this screen is not visible anywhere
-		if (!machine().render().is_live(*this))
-		{
-			LOG_PARTIAL_UPDATES(("skipped because screen not live\n"));
-			return false;
-		}
+	// invisible frames only proceed if the driver needs its side effects
+	if (!m_update_visible && !(m_video_attributes & VIDEO_ALWAYS_UPDATE))
+	{
+		LOG_PARTIAL_UPDATES(("skipped because frame is invisible\n"));
+		return false;
 	}
 
 	// skip if we already rendered this line
@@ -1101,12 +1097,17 @@ bool screen_device::update_partial(int scanline)
 	u32 flags;
 	if (m_type != SCREEN_TYPE_SVG)
 	{
-		screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
-		switch (curbitmap.format())
+		if (m_video_attributes & VIDEO_UPDATE_PARALLEL)
+			flags = update_parallel(clip);
+		else
 		{
-			default:
-			case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
-			case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+			screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
+			switch (curbitmap.format())
+			{
+				default:
+				case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
+				case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+			}
 		}
 	}
 	else
@@ -1120,6 +1121,16 @@ bool screen_device::update_partial(int scanline)
 	// if we modified the bitmap, we have to commit
 	m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
 
+	// accumulate the changed region for the eventual texture upload
+	if (~flags & UPDATE_HAS_NOT_CHANGED)
+	{
+		rectangle &dirty = m_texdirty[m_curbitmap];
+		if (dirty.empty())
+			dirty = clip;
+		else
+			dirty |= clip;
+	}
+
 	// remember where we left off
 	m_last_partial_scan = scanline + 1;
 	return true;
@@ -1127,30 +1138,105 @@ bool screen_device::update_partial(int scanline)
 
 
 //-------------------------------------------------
-//  update_now - perform an update from the last
-//  beam position up to the current beam position
+//  update_parallel - split the cliprect into
+//  horizontal bands and run the screen_update
+//  callback for each on the worker pool; only
+//  used when the driver has declared its callback
+//  scanline-independent (VIDEO_UPDATE_PARALLEL)
 //-------------------------------------------------
 
-void screen_device::update_now()
+struct screen_update_band
+{
+	screen_device * screen;     // screen being updated
+	rectangle       band;       // scanline range covered by this item
+	u32             flags;      // result returned by the callback
+};
+
+void *screen_device::update_band_callback(void *param, int threadid)
 {
-	// these two checks only apply if we're allowed to skip frames
-	if (!(m_video_attributes & VIDEO_ALWAYS_UPDATE))
+	screen_update_band &band = *reinterpret_cast<screen_update_band *>(param);
+	screen_device &screen = *band.screen;
+	screen_bitmap &curbitmap = screen.m_bitmap[screen.m_curbitmap];
+	switch (curbitmap.format())
 	{
-		// if skipping this frame, bail
-		if (machine().video().skip_this_frame())
-		{
-			LOG_PARTIAL_UPDATES(("skipped due to frameskipping\n"));
-			return;
-		}
+		default:
+		case BITMAP_FORMAT_IND16:   band.flags = screen.m_screen_update_ind16(screen, curbitmap.as_ind16(), band.band);   break;
+		case BITMAP_FORMAT_RGB32:   band.flags = screen.m_screen_update_rgb32(screen, curbitmap.as_rgb32(), band.band);   break;
+	}
+	return nullptr;
+}
 
-		// skip if this screen is not visible anywhere
-		if (!machine().render().is_live(*this))
+u32 screen_device::update_parallel(const rectangle &clip)
+{
+	// minimum scanlines per band; smaller clips aren't worth the dispatch
+	constexpr int MIN_BAND_HEIGHT = 16;
+
+	// determine how many bands are worthwhile; stay single-threaded for
+	// small clips and single-CPU hosts
+	int numbands = clip.height() / MIN_BAND_HEIGHT;
+	const int numprocs = int(std::thread::hardware_concurrency());
+	if (numbands > numprocs)
+		numbands = numprocs;
+	if (numbands > WORK_MAX_THREADS)
+		numbands = WORK_MAX_THREADS;
+
+	screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
+	if (numbands <= 1)
+	{
+		switch (curbitmap.format())
 		{
-			LOG_PARTIAL_UPDATES(("skipped because screen not live\n"));
-			return;
+			default:
+			case BITMAP_FORMAT_IND16:   return m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);
+			case BITMAP_FORMAT_RGB32:   return m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);
 		}
 	}
 
+	// lazily create the shared work queue
+	static osd_work_queue *const s_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// partition the cliprect into horizontal bands
+	const int bandheight = (clip.height() + numbands - 1) / numbands;
+	screen_update_band bands[WORK_MAX_THREADS];
+	for (int bandnum = 0; bandnum < numbands; bandnum++)
+	{
+		screen_update_band &band = bands[bandnum];
+		band.screen = this;
+		band.band = clip;
+		band.band.sety(
+				clip.top() + bandnum * bandheight,
+				(std::min)(clip.top() + (bandnum + 1) * bandheight - 1, clip.bottom()));
+		band.flags = 0;
+	}
+
+	// dispatch the bands and wait for completion
+	osd_work_item_queue_multiple(s_queue, &screen_device::update_band_callback, numbands, &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(s_queue, osd_ticks_per_second());
+
+	// UPDATE_HAS_NOT_CHANGED only survives if every band reported it
+	u32 flags = UPDATE_HAS_NOT_CHANGED;
+	for (int bandnum = 0; bandnum < numbands; bandnum++)
+		flags &= bands[bandnum].flags;
+	return flags;
+}
+
+
+//-------------------------------------------------
+//  update_now - perform an update from the last
+//  beam position up to the current beam position
+//-------------------------------------------------
+
+void screen_device::update_now()
+{
+	// will anybody see what we render?
+	m_update_visible = !machine().video().skip_this_frame() && machine().render().is_live(*this);
+
+	// invisible frames only proceed if the driver needs its side effects
+	if (!m_update_visible && !(m_video_attributes & VIDEO_ALWAYS_UPDATE))
+	{
+		LOG_PARTIAL_UPDATES(("skipped because frame is invisible\n"));
+		return;
+	}
+
 	int current_vpos = vpos();
 	int current_hpos = hpos();
 	rectangle clip = m_visarea;
@@ -1191,6 +1277,13 @@ void screen_device::update_now()
 					case BITMAP_FORMAT_RGB32: m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
 				}
 
+				// accumulate the changed region for the eventual texture upload
+				rectangle &dirty = m_texdirty[m_curbitmap];
+				if (dirty.empty())
+					dirty = clip;
+				else
+					dirty |= clip;
+
 				m_partial_updates_this_frame++;
 				g_profiler.stop();
 				m_partial_scan_hpos = 0;
@@ -1234,6 +1327,16 @@ void screen_device::update_now()
 		// if we modified the bitmap, we have to commit
 		m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
 
+		// accumulate the changed region for the eventual texture upload
+		if (~flags & UPDATE_HAS_NOT_CHANGED)
+		{
+			rectangle &dirty = m_texdirty[m_curbitmap];
+			if (dirty.empty())
+				dirty = clip;
+			else
+				dirty |= clip;
+		}
+
 		// remember where we left off
 		m_partial_scan_hpos = current_hpos;
 		m_last_partial_scan = current_vpos;
@@ -1259,6 +1362,93 @@ void screen_device::reset_partial_updates()
 	m_partial_scan_hpos = 0;
 	m_partial_updates_this_frame = 0;
 	m_scanline0_timer->adjust(time_until_pos(0));
+
+	// collapse the scanline journals, carrying the final value of the
+	// previous frame over as the starting value of the new one
+	for (auto &journal : m_journal)
+		if (!journal.empty())
+		{
+			journal.front() = journal_entry{ 0, journal.back().value };
+			journal.resize(1);
+		}
+}
+
+
+//-------------------------------------------------
+//  journal_write - record a register value for
+//  the current beam position in the scanline
+//  journal
+//-------------------------------------------------
+
+void screen_device::journal_write(int index, u32 value)
+{
+	assert(index >= 0 && index < JOURNAL_CHANNELS);
+	auto &journal = m_journal[index];
+	s32 scanline = vpos();
+
+	if (!journal.empty())
+	{
+		// drop no-change writes
+		if (journal.back().value == value)
+			return;
+
+		// coalesce multiple writes on the same scanline, and drop the entry
+		// entirely if it reverted to the previous value
+		if (journal.back().scanline == scanline)
+		{
+			if (journal.size() >= 2 && journal[journal.size() - 2].value == value)
+				journal.pop_back();
+			else
+				journal.back().value = value;
+			return;
+		}
+	}
+	journal.emplace_back(journal_entry{ scanline, value });
+}
+
+
+//-------------------------------------------------
+//  journal_read - return the journaled value in
+//  effect on the given scanline
+//-------------------------------------------------
+
+u32 screen_device::journal_read(int index, int scanline) const
+{
+	assert(index >= 0 && index < JOURNAL_CHANNELS);
+	auto &journal = m_journal[index];
+	for (auto it = journal.rbegin(); it != journal.rend(); ++it)
+		if (it->scanline <= scanline)
+			return it->value;
+
+	// nothing recorded at or before the scanline; the earliest known value
+	// is the best answer we have
+	return journal.empty() ? 0 : journal.front().value;
+}
+
+
+//-------------------------------------------------
+//  journal_span_end - return the last scanline
+//  (inclusive) on which no journaled channel
+//  changes after the given one; index -1 checks
+//  all channels
+//-------------------------------------------------
+
+int screen_device::journal_span_end(int index, int scanline) const
+{
+	assert(index < JOURNAL_CHANNELS);
+	int end = m_visarea.bottom();
+	for (int ch = 0; ch < JOURNAL_CHANNELS; ch++)
+	{
+		if (index >= 0 && ch != index)
+			continue;
+		for (auto &entry : m_journal[ch])
+			if (entry.scanline > scanline)
+			{
+				end = std::min(end, entry.scanline - 1);
+				break;
+			}
+	}
+	return end;
 }
 
 
@@ -1459,7 +1649,11 @@ bool screen_device::update_quads()
 			// if we're not skipping the frame and if the screen actually changed, then update the texture
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
-				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+				// hand the accumulated changed region to the texture so the
+				// OSD can restrict its upload, then start accumulating anew
+				rectangle &dirty = m_texdirty[m_curbitmap];
+				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat(), dirty.empty() ? m_visarea : dirty);
+				dirty.set(0, -1, 0, -1);
 				m_curtexture = m_curbitmap;
 				m_curbitmap = 1 - m_curbitmap;
 			}
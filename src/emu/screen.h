@@ -58,12 +58,20 @@ constexpr u32 UPDATE_HAS_NOT_CHANGED = 0x0001;   // the video has not changed
  indicates VIDEO_UPDATE will add container bits itself
 
  @def VIDEO_ALWAYS_UPDATE
- force VIDEO_UPDATE to be called even for skipped frames.
+ force VIDEO_UPDATE to be called even for skipped frames; the callback
+ can check screen.update_is_visible() and limit itself to the
+ state-affecting side effects when the frame will not be seen.
  @todo in case you need this one for model updating, then you're doing it wrong (read: hack)
 
  @def VIDEO_UPDATE_SCANLINE
  calls VIDEO_UPDATE for every visible scanline, even for skipped frames
 
+ @def VIDEO_UPDATE_PARALLEL
+ declares the screen_update callback to be scanline-independent, allowing
+ the core to split the cliprect into bands updated on worker threads;
+ only valid if the callback draws each scanline of the cliprect without
+ reading other scanlines or mutating shared state
+
  @}
  */
 
@@ -73,6 +81,7 @@ constexpr u32 VIDEO_UPDATE_AFTER_VBLANK     = 0x0004;
 constexpr u32 VIDEO_SELF_RENDER             = 0x0008;
 constexpr u32 VIDEO_ALWAYS_UPDATE           = 0x0080;
 constexpr u32 VIDEO_UPDATE_SCANLINE         = 0x0100;
+constexpr u32 VIDEO_UPDATE_PARALLEL         = 0x0200;
 
 
 //**************************************************************************
@@ -296,6 +305,23 @@ public:
 	void update_now();
 	void reset_partial_updates();
 
+	// scanline effect journal: raster drivers can record per-scanline register
+	// deltas (scroll values, palette banks, ...) here from their scanline
+	// timers instead of forcing a partial update per split, then replay the
+	// values span by span from a single frame-end composition pass; values
+	// carry over from frame to frame, so only actual changes need recording
+	static constexpr int JOURNAL_CHANNELS = 8;
+	void journal_write(int index, u32 value);
+	u32 journal_read(int index, int scanline) const;
+	int journal_span_end(int index, int scanline) const;
+	bool journal_changed(int index) const { assert(index >= 0 && index < JOURNAL_CHANNELS); return m_journal[index].size() > 1; }
+
+	// true when the frame currently being updated will actually be seen;
+	// screens with VIDEO_ALWAYS_UPDATE still get their update calls during
+	// skipped frames so state-affecting side effects are honored, and the
+	// callback can consult this to skip pure composition work
+	bool update_is_visible() const { return m_update_visible; }
+
 	// additional helpers
 	void register_vblank_callback(vblank_state_delegate vblank_callback);
 	void register_screen_bitmap(bitmap_t &bitmap);
@@ -332,6 +358,8 @@ private:
 
 	// internal helpers
 	void set_container(render_container &container) { m_container = &container; }
+	u32 update_parallel(const rectangle &clip);
+	static void *update_band_callback(void *param, int threadid);
 	void realloc_screen_bitmaps();
 	void vblank_begin();
 	void vblank_end();
@@ -370,9 +398,20 @@ private:
 	bitmap_ind64        m_burnin;                   // burn-in bitmap
 	u8                  m_curbitmap;                // current bitmap index
 	u8                  m_curtexture;               // current texture index
+	rectangle           m_texdirty[2];              // accumulated changed region for each bitmap
 	bool                m_changed;                  // has this bitmap changed?
 	s32                 m_last_partial_scan;        // scanline of last partial update
 	s32                 m_partial_scan_hpos;        // horizontal pixel last rendered on this partial scanline
+	bool                m_update_visible;           // will the frame being updated actually be seen?
+
+	// scanline journal
+	struct journal_entry
+	{
+		s32             scanline;                   // first scanline the value applies to
+		u32             value;                      // recorded value
+	};
+	std::vector<journal_entry> m_journal[JOURNAL_CHANNELS]; // per-channel recorded deltas
+
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
 	u32                 m_unique_id;                // unique id for this screen_device
 	rgb_t               m_color;                    // render color
@@ -11,10 +11,12 @@
 #include "emu.h"
 #include "softlist.h"
 
+#include "emuopts.h"
 #include "hash.h"
 
 #include "expat.h"
 
+#include <cstring>
 #include <regex>
 
 
@@ -827,6 +829,246 @@ void softlist_parser::parse_soft_end(const char *tagname)
 }
 
 
+//**************************************************************************
+//  SOFTLIST CACHE
+//**************************************************************************
+
+namespace {
+
+// cache file identification; bump the version whenever the record layout or
+// the in-memory software list model changes
+constexpr u8 CACHE_MAGIC[4] = { 'B', 'S', 'L', 'C' };
+constexpr u32 CACHE_VERSION = 1;
+
+// helper to serialize cache records into a flat buffer (host byte order --
+// the cache is private to the machine that wrote it)
+class cache_writer
+{
+public:
+	void put_u32(u32 value) { put_bytes(&value, sizeof(value)); }
+	void put_u64(u64 value) { put_bytes(&value, sizeof(value)); }
+
+	void put_string(const std::string &value)
+	{
+		put_u32(u32(value.length()));
+		put_bytes(value.data(), value.length());
+	}
+
+	void put_features(const std::list<feature_list_item> &features)
+	{
+		put_u32(u32(features.size()));
+		for (const feature_list_item &item : features)
+		{
+			put_string(item.name());
+			put_string(item.value());
+		}
+	}
+
+	void put_bytes(const void *data, size_t length)
+	{
+		const u8 *bytes = reinterpret_cast<const u8 *>(data);
+		m_data.insert(m_data.end(), bytes, bytes + length);
+	}
+
+	const std::vector<u8> &data() const { return m_data; }
+
+private:
+	std::vector<u8> m_data;
+};
+
+// bounds-checked reader over a loaded cache buffer; any truncation sets the
+// failure flag and subsequent reads return defaults
+class cache_reader
+{
+public:
+	cache_reader(const u8 *data, size_t size) : m_data(data), m_size(size), m_offset(0), m_ok(true) { }
+
+	u32 get_u32() { u32 value = 0; get_bytes(&value, sizeof(value)); return value; }
+	u64 get_u64() { u64 value = 0; get_bytes(&value, sizeof(value)); return value; }
+
+	std::string get_string()
+	{
+		u32 const length = get_u32();
+		if (!m_ok || length > m_size - m_offset)
+		{
+			m_ok = false;
+			return std::string();
+		}
+		std::string value(reinterpret_cast<const char *>(m_data + m_offset), length);
+		m_offset += length;
+		return value;
+	}
+
+	void get_features(std::list<feature_list_item> &features)
+	{
+		u32 const count = get_u32();
+		for (u32 index = 0; m_ok && index < count; index++)
+		{
+			std::string name = get_string();
+			std::string value = get_string();
+			if (m_ok)
+				features.emplace_back(std::move(name), std::move(value));
+		}
+	}
+
+	void get_bytes(void *data, size_t length)
+	{
+		if (!m_ok || length > m_size - m_offset)
+		{
+			m_ok = false;
+			return;
+		}
+		memcpy(data, m_data + m_offset, length);
+		m_offset += length;
+	}
+
+	bool ok() const { return m_ok; }
+
+private:
+	const u8 *  m_data;
+	size_t      m_size;
+	size_t      m_offset;
+	bool        m_ok;
+};
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  load - populate a software list from a cache
+//  file if one matching the XML key exists
+//-------------------------------------------------
+
+bool softlist_cache::load(emu_options &options, const std::string &list_name, u32 xml_crc, u64 xml_size, std::string &description, std::list<software_info> &infolist)
+{
+	// attempt to open the cache file
+	emu_file file(options.cfg_directory(), OPEN_FLAG_READ);
+	if (file.open(list_name.c_str(), ".bsl") != osd_file::error::NONE)
+		return false;
+
+	// slurp the whole file; anything shorter than a header is garbage
+	std::vector<u8> data(size_t(file.size()));
+	bool const read_ok = (data.size() > sizeof(CACHE_MAGIC)) && (file.read(&data[0], u32(data.size())) == data.size());
+	file.close();
+	if (!read_ok)
+		return false;
+
+	// validate the header against the current XML file
+	cache_reader reader(&data[0], data.size());
+	u8 magic[sizeof(CACHE_MAGIC)];
+	reader.get_bytes(magic, sizeof(magic));
+	if (memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+		return false;
+	if (reader.get_u32() != CACHE_VERSION || reader.get_u32() != xml_crc || reader.get_u64() != xml_size)
+		return false;
+
+	// read the list description and each software item
+	description = reader.get_string();
+	u32 const infocount = reader.get_u32();
+	for (u32 infonum = 0; reader.ok() && infonum < infocount; infonum++)
+	{
+		std::string shortname = reader.get_string();
+		std::string parentname = reader.get_string();
+		infolist.emplace_back(std::move(shortname), std::move(parentname), "");
+		software_info &swinfo = infolist.back();
+		swinfo.m_supported = reader.get_u32();
+		swinfo.m_longname = reader.get_string();
+		swinfo.m_year = reader.get_string();
+		swinfo.m_publisher = reader.get_string();
+		reader.get_features(swinfo.m_other_info);
+		reader.get_features(swinfo.m_shared_info);
+
+		// then each part of the item
+		u32 const partcount = reader.get_u32();
+		for (u32 partnum = 0; reader.ok() && partnum < partcount; partnum++)
+		{
+			std::string partname = reader.get_string();
+			std::string partinterface = reader.get_string();
+			swinfo.m_partdata.emplace_back(swinfo, std::move(partname), std::move(partinterface));
+			software_part &part = swinfo.m_partdata.back();
+			reader.get_features(part.m_featurelist);
+
+			// and finally the ROM entries of the part
+			u32 const romcount = reader.get_u32();
+			if (reader.ok())
+				part.m_romdata.reserve(romcount);
+			for (u32 romnum = 0; reader.ok() && romnum < romcount; romnum++)
+			{
+				std::string romname = reader.get_string();
+				std::string hashdata = reader.get_string();
+				u32 const offset = reader.get_u32();
+				u32 const length = reader.get_u32();
+				u32 const flags = reader.get_u32();
+				if (reader.ok())
+					part.m_romdata.emplace_back(std::move(romname), std::move(hashdata), offset, length, flags);
+			}
+		}
+	}
+
+	// a truncated or corrupt cache falls back to a fresh XML parse
+	if (!reader.ok())
+	{
+		description.clear();
+		infolist.clear();
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - write a cache file for a freshly-
+//  parsed software list
+//-------------------------------------------------
+
+void softlist_cache::save(emu_options &options, const std::string &list_name, u32 xml_crc, u64 xml_size, const std::string &description, const std::list<software_info> &infolist)
+{
+	// serialize the header and the full list contents
+	cache_writer writer;
+	writer.put_bytes(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	writer.put_u32(CACHE_VERSION);
+	writer.put_u32(xml_crc);
+	writer.put_u64(xml_size);
+	writer.put_string(description);
+	writer.put_u32(u32(infolist.size()));
+	for (const software_info &swinfo : infolist)
+	{
+		writer.put_string(swinfo.shortname());
+		writer.put_string(swinfo.parentname());
+		writer.put_u32(swinfo.supported());
+		writer.put_string(swinfo.longname());
+		writer.put_string(swinfo.year());
+		writer.put_string(swinfo.publisher());
+		writer.put_features(swinfo.other_info());
+		writer.put_features(swinfo.shared_info());
+		writer.put_u32(u32(swinfo.parts().size()));
+		for (const software_part &part : swinfo.parts())
+		{
+			writer.put_string(part.name());
+			writer.put_string(part.interface());
+			writer.put_features(part.featurelist());
+			writer.put_u32(u32(part.romdata().size()));
+			for (const rom_entry &rom : part.romdata())
+			{
+				writer.put_string(rom.name());
+				writer.put_string(rom.hashdata());
+				writer.put_u32(rom.get_offset());
+				writer.put_u32(rom.get_length());
+				writer.put_u32(rom.get_flags());
+			}
+		}
+	}
+
+	// write it out; failure here just means the next run parses the XML again
+	emu_file file(options.cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(list_name.c_str(), ".bsl") == osd_file::error::NONE)
+	{
+		file.write(&writer.data()[0], u32(writer.data().size()));
+		file.close();
+	}
+}
+
+
 //-------------------------------------------------
 //  software_name_parse - helper that splits a
 //  software identifier (software_list:software:part)
@@ -34,6 +34,10 @@
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// forward declarations
+class emu_options;
+
+
 // ======================> feature_list_item
 
 // an item in a list of name/value pairs
@@ -67,6 +71,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -105,6 +110,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -207,6 +213,23 @@ private:
 };
 
 
+// ======================> softlist_cache
+
+// binary cached form of a parsed software list; avoids re-running the XML
+// parser for lists whose source file has not changed
+class softlist_cache
+{
+public:
+	// attempt to populate description/infolist from a cache file previously
+	// written for this list; returns false (leaving the outputs empty) if no
+	// cache exists or it does not match the given XML CRC/size key
+	static bool load(emu_options &options, const std::string &list_name, u32 xml_crc, u64 xml_size, std::string &description, std::list<software_info> &infolist);
+
+	// write a cache file for a freshly-parsed list, keyed by the XML CRC/size
+	static void save(emu_options &options, const std::string &list_name, u32 xml_crc, u64 xml_size, const std::string &description, const std::list<software_info> &infolist);
+};
+
+
 // ----- Helpers -----
 
 // parses a software identifier (e.g. - 'apple2e:agentusa:flop1') into its constituent parts (returns false if cannot parse)
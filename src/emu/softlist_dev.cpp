@@ -286,11 +286,23 @@ void software_list_device::parse()
 	osd_file::error filerr = m_file.open(m_list_name.c_str(), ".xml");
 	if (filerr == osd_file::error::NONE)
 	{
-		// parse if no error
-		std::ostringstream errs;
-		softlist_parser parser(m_file, m_file.filename(), m_description, m_infolist, errs);
+		// the binary cache is keyed by the XML file's CRC and size, so an
+		// updated list automatically invalidates its stale cache
+		u32 xml_crc = 0;
+		bool const have_crc = m_file.hashes(util::hash_collection::HASH_TYPES_CRC).crc(xml_crc);
+		u64 const xml_size = m_file.size();
+		if (!have_crc || !softlist_cache::load(mconfig().options(), m_list_name, xml_crc, xml_size, m_description, m_infolist))
+		{
+			// parse if no usable cache
+			std::ostringstream errs;
+			softlist_parser parser(m_file, m_file.filename(), m_description, m_infolist, errs);
+			m_errors = errs.str();
+
+			// write a fresh cache for next time if the parse was clean
+			if (have_crc && m_errors.empty())
+				softlist_cache::save(mconfig().options(), m_list_name, xml_crc, xml_size, m_description, m_infolist);
+		}
 		m_file.close();
-		m_errors = errs.str();
 	}
 	else
 		m_errors = string_format("Error opening file: %s\n", filename());
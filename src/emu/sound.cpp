@@ -17,6 +17,10 @@
 
 #include "NSM_CommonInterface.h"
 
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
 //**************************************************************************
 //  DEBUGGING
 //**************************************************************************
@@ -27,6 +31,95 @@
 
 
 
+//**************************************************************************
+//  RESAMPLE KERNELS
+//**************************************************************************
+
+//-------------------------------------------------
+//  fill_sample_block - write a constant sample
+//  value to a block of output samples; the
+//  undersampled resample path produces runs of
+//  identical point samples between input
+//  boundaries, which this stores 4 at a time
+//-------------------------------------------------
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+
+static inline void fill_sample_block(stream_sample_t *dest, u32 count, stream_sample_t value)
+{
+	__m128i value4 = _mm_set1_epi32(value);
+	for ( ; count >= 4; count -= 4, dest += 4)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), value4);
+	while (count-- != 0)
+		*dest++ = value;
+}
+
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+
+static inline void fill_sample_block(stream_sample_t *dest, u32 count, stream_sample_t value)
+{
+	int32x4_t value4 = vdupq_n_s32(value);
+	for ( ; count >= 4; count -= 4, dest += 4)
+		vst1q_s32(dest, value4);
+	while (count-- != 0)
+		*dest++ = value;
+}
+
+#else
+
+static inline void fill_sample_block(stream_sample_t *dest, u32 count, stream_sample_t value)
+{
+	while (count-- != 0)
+		*dest++ = value;
+}
+
+#endif
+
+
+//-------------------------------------------------
+//  polyphase_kernel - build (once) the shared
+//  table of windowed-sinc interpolation kernels,
+//  one POLYPHASE_TAPS-tap filter per fractional
+//  phase; the table only depends on the phase
+//  resolution, not on the rate pair, so all
+//  undersampled inputs share it
+//-------------------------------------------------
+
+const s32 *sound_stream::polyphase_kernel()
+{
+	// built inside the static initializer so concurrent stream updates
+	// (-parallel_sound) can never observe a partially-filled table
+	static const std::vector<s32> table = []
+	{
+		std::vector<s32> result(POLYPHASE_PHASES * POLYPHASE_TAPS);
+		const double cutoff = 0.9;
+		for (u32 phase = 0; phase < POLYPHASE_PHASES; phase++)
+		{
+			// compute a Blackman-windowed sinc centered between the middle taps
+			double coeff[POLYPHASE_TAPS];
+			double sum = 0.0;
+			for (int tap = 0; tap < POLYPHASE_TAPS; tap++)
+			{
+				double x = tap - (POLYPHASE_TAPS / 2 - 1) - double(phase) / POLYPHASE_PHASES;
+				double sinc = (x == 0.0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+				double window = 0.42 + 0.5 * cos(M_PI * x / (POLYPHASE_TAPS / 2)) + 0.08 * cos(2.0 * M_PI * x / (POLYPHASE_TAPS / 2));
+				coeff[tap] = cutoff * sinc * window;
+				sum += coeff[tap];
+			}
+
+			// normalize each phase to unity gain so DC passes without ripple
+			for (int tap = 0; tap < POLYPHASE_TAPS; tap++)
+				result[phase * POLYPHASE_TAPS + tap] = s32((coeff[tap] / sum) * (1 << POLYPHASE_COEFF_BITS) + ((coeff[tap] >= 0) ? 0.5 : -0.5));
+		}
+		return result;
+	}();
+	return &table[0];
+}
+
+
+
 //**************************************************************************
 //  CONSTANTS
 //**************************************************************************
@@ -252,6 +345,9 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	if (input.m_source != nullptr)
 		input.m_source->m_dependents++;
 
+	// the stream graph changed shape
+	m_device.machine().sound().m_stream_levels_dirty = true;
+
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
 }
@@ -519,9 +615,25 @@ void sound_stream::recompute_sample_rate_data()
 
 			// if the input stream's sample rate is lower, we will use linear interpolation
 			// this requires an extra sample from the source
+			input.m_polyphase = false;
 			if (input.m_source->m_stream->m_sample_rate < m_sample_rate)
+			{
 				latency += new_attosecs_per_sample;
 
+				// the polyphase kernel convolves POLYPHASE_TAPS source samples, so it
+				// needs that much history ahead of the read point; only enable it when
+				// the extra latency still fits comfortably within one update period
+				if (m_device.machine().options().polyphase_resample())
+				{
+					attoseconds_t poly_latency = latency + (POLYPHASE_TAPS - 2) * new_attosecs_per_sample;
+					if (poly_latency < update_attoseconds / 2)
+					{
+						latency = poly_latency;
+						input.m_polyphase = true;
+					}
+				}
+			}
+
 			// if our sample rates match exactly, we don't need any latency
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
@@ -719,11 +831,39 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 	// if we have equal sample rates, we just need to copy
 	if (step == FRAC_ONE)
 	{
+		// unity gain reduces to a straight copy
+		if (gain == 0x100)
+			memcpy(dest, source, numsamples * sizeof(*dest));
+		else
+			while (numsamples--)
+			{
+				// compute the sample
+				s64 sample = *source++;
+				*dest++ = (sample * gain) >> 8;
+			}
+	}
+
+	// input is undersampled and the polyphase kernel is enabled: convolve the
+	// precomputed filter for the current fractional phase over the source
+	else if (step < FRAC_ONE && input.m_polyphase)
+	{
+		const s32 *kernel = polyphase_kernel();
 		while (numsamples--)
 		{
+			// the top bits of the fraction select the kernel phase
+			const s32 *coeff = &kernel[(basefrac >> (FRAC_BITS - POLYPHASE_PHASE_BITS)) * POLYPHASE_TAPS];
+
 			// compute the sample
-			s64 sample = *source++;
+			s64 sample = 0;
+			for (int tap = 0; tap < POLYPHASE_TAPS; tap++)
+				sample += s64(source[tap]) * coeff[tap];
+			sample >>= POLYPHASE_COEFF_BITS;
 			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
 		}
 	}
 
@@ -732,25 +872,32 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 	{
 		while (numsamples != 0)
 		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+			// every output sample before the next input boundary repeats
+			// the same point sample, so write them as one constant block
+			u32 run = (FRAC_ONE - 1 - basefrac) / step;
+			if (run > numsamples)
+				run = numsamples;
+			if (run != 0)
 			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
+				fill_sample_block(dest, run, stream_sample_t((s64(source[0]) * gain) >> 8));
+				dest += run;
+				basefrac += run * step;
+				numsamples -= run;
 			}
 
 			// if we're done, we're done
-			if (s32(numsamples--) < 0)
+			if (numsamples == 0)
 				break;
 
 			// compute starting and ending fractional positions
+			u32 nextfrac = basefrac + step;
 			int startfrac = basefrac >> (FRAC_BITS - 12);
 			int endfrac = nextfrac >> (FRAC_BITS - 12);
 
 			// blend between the two samples accordingly
 			s64 sample = (s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000)) / (endfrac - startfrac);
 			*dest++ = (sample * gain) >> 8;
+			numsamples--;
 
 			// advance
 			basefrac = nextfrac & FRAC_MASK;
@@ -805,6 +952,7 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 sound_stream::stream_input::stream_input()
 	: m_source(nullptr),
 		m_latency_attoseconds(0),
+		m_polyphase(false),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -849,8 +997,21 @@ sound_manager::sound_manager(running_machine &machine)
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
-		m_last_update(attotime::zero)
+		m_last_update(attotime::zero),
+		m_stream_queue(nullptr),
+		m_output_queue(nullptr),
+		m_stream_levels_dirty(true)
 {
+	// if parallel stream updates were requested, create a work queue for them
+	if (machine.options().parallel_sound())
+		m_stream_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// if asynchronous output was requested, create a single-threaded IO queue
+	// for it; items are processed in order, so chunks reach the OSD in the
+	// order they were mixed
+	if (machine.options().async_sound_output() && !m_nosound_mode)
+		m_output_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
 	const char *avifile = machine.options().avi_write();
@@ -890,6 +1051,13 @@ sound_manager::sound_manager(running_machine &machine)
 
 sound_manager::~sound_manager()
 {
+	if (m_stream_queue != nullptr)
+		osd_work_queue_free(m_stream_queue);
+	if (m_output_queue != nullptr)
+	{
+		osd_work_queue_wait(m_output_queue, osd_ticks_per_second());
+		osd_work_queue_free(m_output_queue);
+	}
 }
 
 
@@ -926,6 +1094,7 @@ void sound_manager::stop_recording()
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
 	m_stream_list.push_back(std::make_unique<sound_stream>(device, inputs, outputs, sample_rate, callback));
+	m_stream_levels_dirty = true;
 	return m_stream_list.back().get();
 }
 
@@ -1085,12 +1254,103 @@ void sound_manager::config_save(config_type cfg_type, util::xml::data_node *pare
 extern bool catchingUp;
 extern bool SKIP_OSD;
 
+//-------------------------------------------------
+//  compute_stream_levels - group the streams by
+//  their depth in the dependency graph; streams
+//  within one level have no edges between them
+//-------------------------------------------------
+
+void sound_manager::compute_stream_levels()
+{
+	m_stream_levels_dirty = false;
+	m_stream_levels.clear();
+
+	// depth of a stream is one more than the deepest stream feeding it;
+	// a stream revisited during its own computation (a feedback loop)
+	// contributes its in-progress depth of zero
+	std::unordered_map<sound_stream *, int> depths;
+	std::function<int (sound_stream *)> depth_of = [&] (sound_stream *stream) -> int
+	{
+		auto found = depths.find(stream);
+		if (found != depths.end())
+			return found->second;
+		depths.emplace(stream, 0);
+
+		int result = 0;
+		for (auto &input : stream->m_input)
+			if (input.m_source != nullptr)
+				result = std::max(result, depth_of(input.m_source->m_stream) + 1);
+		depths[stream] = result;
+		return result;
+	};
+
+	for (auto &stream : m_stream_list)
+	{
+		int level = depth_of(stream.get());
+		if (level >= int(m_stream_levels.size()))
+			m_stream_levels.resize(level + 1);
+		m_stream_levels[level].push_back(stream.get());
+	}
+}
+
+
+//-------------------------------------------------
+//  stream_update_worker - osd_work_queue callback
+//  that brings one stream up to the current time
+//-------------------------------------------------
+
+void *sound_manager::stream_update_worker(void *param, int threadid)
+{
+	reinterpret_cast<sound_stream *>(param)->update();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  output_worker - osd_work_queue callback to
+//  submit one mixed chunk to the OSD
+//-------------------------------------------------
+
+void *sound_manager::output_worker(void *param, int threadid)
+{
+	std::unique_ptr<output_chunk> chunk(reinterpret_cast<output_chunk *>(param));
+	chunk->sound->machine().osd().update_audio_stream(&chunk->samples[0], chunk->samples.size() / 2);
+	return nullptr;
+}
+
+
 void sound_manager::update(void *ptr, int param)
 {
 	VPRINTF(("sound_update\n"));
 
+	// attribute allocations during the mix to the sound subsystem
+	memtrack::tag_scope alloc_scope(memtrack::TAG_SOUND);
+
+	TRACE_EVENT_SCOPE("sound_update");
+
 	g_profiler.start(PROFILER_SOUND);
 
+	// if parallel updates are enabled, bring the stream graph up to date
+	// level by level on the worker threads; the join between levels makes
+	// every input's data complete before its consumers run, and the
+	// speakers' serial pull below then finds everything current
+	if (m_stream_queue != nullptr)
+	{
+		if (m_stream_levels_dirty)
+			compute_stream_levels();
+		for (auto &level : m_stream_levels)
+		{
+			if (level.size() == 1)
+				level.front()->update();
+			else
+			{
+				for (sound_stream *stream : level)
+					osd_work_item_queue(m_stream_queue, &sound_manager::stream_update_worker, stream, WORK_ITEM_FLAG_AUTO_RELEASE);
+				osd_work_queue_wait(m_stream_queue, osd_ticks_per_second());
+			}
+		}
+	}
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	for (speaker_device &speaker : speaker_device_iterator(machine().root_device()))
@@ -1127,7 +1387,22 @@ void sound_manager::update(void *ptr, int param)
 	if (finalmix_offset > 0)
 	{
 		if (!m_nosound_mode && !catchingUp && !SKIP_OSD)
-			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
+		{
+			// when asynchronous output is enabled, hand the chunk to the
+			// dedicated thread; update_audio_stream can block on OSD buffer
+			// space, and this keeps that wait off the emulation thread while
+			// queued audio keeps draining through stalls such as netplay syncs
+			if (m_output_queue != nullptr)
+			{
+				output_chunk *chunk = new output_chunk;
+				chunk->sound = this;
+				chunk->timestamp = machine().time();
+				chunk->samples.assign(finalmix, finalmix + finalmix_offset);
+				osd_work_item_queue(m_output_queue, &sound_manager::output_worker, chunk, WORK_ITEM_FLAG_AUTO_RELEASE);
+			}
+			else
+				machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
+		}
 		machine().osd().add_audio_to_recording(finalmix, finalmix_offset / 2);
 		machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
 		if (m_wavfile != nullptr)
@@ -80,6 +80,7 @@ class sound_stream
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		bool                m_polyphase;            // true if this input resamples through the polyphase kernel
 		s16               m_gain;                 // gain to apply to this input
 		s16               m_user_gain;            // user-controlled gain to apply to this input
 	};
@@ -89,6 +90,10 @@ class sound_stream
 	static constexpr u32 FRAC_BITS              = 22;
 	static constexpr u32 FRAC_ONE               = 1 << FRAC_BITS;
 	static constexpr u32 FRAC_MASK              = FRAC_ONE - 1;
+	static constexpr u32 POLYPHASE_PHASE_BITS   = 6;
+	static constexpr u32 POLYPHASE_PHASES       = 1 << POLYPHASE_PHASE_BITS;
+	static constexpr int POLYPHASE_TAPS         = 8;
+	static constexpr int POLYPHASE_COEFF_BITS   = 14;
 
 public:
 	// construction/destruction
@@ -127,6 +132,7 @@ private:
 
 	// internal helpers
 	void recompute_sample_rate_data();
+	static const s32 *polyphase_kernel();
 	void allocate_resample_buffers();
 	void allocate_output_buffers();
 	void postload();
@@ -225,6 +231,19 @@ private:
 
 	void update(void *ptr = nullptr, s32 param = 0);
 
+	// parallel stream update helpers
+	void compute_stream_levels();
+	static void *stream_update_worker(void *param, int threadid);
+
+	// asynchronous audio output
+	struct output_chunk
+	{
+		sound_manager *     sound;      // owning manager
+		attotime            timestamp;  // machine time the chunk was mixed at
+		std::vector<s16>    samples;    // interleaved stereo samples
+	};
+	static void *output_worker(void *param, int threadid);
+
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
 	emu_timer *         m_update_timer;         // timer to drive periodic updates
@@ -244,6 +263,12 @@ private:
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
+
+	// parallel stream updates
+	osd_work_queue *    m_stream_queue;         // worker queue, or nullptr when disabled
+	osd_work_queue *    m_output_queue;         // dedicated output thread, or nullptr when disabled
+	bool                m_stream_levels_dirty;  // topology changed since last level pass
+	std::vector<std::vector<sound_stream *>> m_stream_levels; // streams grouped by graph depth
 };
 
 
@@ -105,10 +105,11 @@ inline bool tilemap_t::gfx_elements_changed()
 //  bitmap, setting priority only
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_opaque_null(int count, u8 *pri, u32 pcode)
 {
 	// skip entirely if not changing priority
-	if (pcode == 0xff00)
+	if (!HavePriority)
 		return;
 
 	// update priority across the scanline
@@ -122,10 +123,11 @@ inline void tilemap_t::scanline_draw_opaque_null(int count, u8 *pri, u32 pcode)
 //  bitmap using a mask, setting priority only
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
 {
 	// skip entirely if not changing priority
-	if (pcode == 0xff00)
+	if (!HavePriority)
 		return;
 
 	// update priority across the scanline, checking the mask
@@ -141,6 +143,7 @@ inline void tilemap_t::scanline_draw_masked_null(const u8 *maskptr, int mask, in
 //  indexed bitmap
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode)
 {
 	// special case for no palette offset
@@ -151,7 +154,7 @@ inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source,
 		memcpy(dest, source, count * 2);
 
 		// skip the rest if not changing priority
-		if (pcode == 0xff00)
+		if (!HavePriority)
 			return;
 
 		// update priority across the scanline
@@ -160,7 +163,7 @@ inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source,
 	}
 
 	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
+	else if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 		{
@@ -183,12 +186,13 @@ inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source,
 //  indexed bitmap using a mask
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
 {
 	int pal = pcode >> 16;
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 			if ((maskptr[i] & mask) == value)
@@ -214,12 +218,13 @@ inline void tilemap_t::scanline_draw_masked_ind16(u16 *dest, const u16 *source,
 //  RGB bitmap
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 		{
@@ -242,12 +247,13 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(u32 *dest, const u16 *source,
 //  RGB bitmap using a mask
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 			if ((maskptr[i] & mask) == value)
@@ -272,12 +278,13 @@ inline void tilemap_t::scanline_draw_masked_rgb32(u32 *dest, const u16 *source,
 //  32bpp RGB bitmap with alpha blending
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 		{
@@ -301,12 +308,13 @@ inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *so
 //  blending
 //-------------------------------------------------
 
+template<bool HavePriority>
 inline void tilemap_t::scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (HavePriority)
 	{
 		for (int i = 0; i < count; i++)
 			if ((maskptr[i] & mask) == value)
@@ -372,6 +380,7 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, device_gfx_interface &decod
 	m_attributes = 0;
 	m_all_tiles_dirty = true;
 	m_all_tiles_clean = false;
+	m_dirty_list_overflow = false;
 	m_palette_offset = 0;
 	m_gfx_used = 0;
 	memset(m_gfx_dirtyseq, 0, sizeof(m_gfx_dirtyseq));
@@ -449,9 +458,15 @@ void tilemap_t::mark_tile_dirty(tilemap_memory_index memindex)
 	{
 		// there may be no logical index for a given memory index
 		logical_index logindex = m_memory_to_logical[memindex];
-		if (logindex != INVALID_LOGICAL_INDEX)
+		if (logindex != INVALID_LOGICAL_INDEX && m_tileflags[logindex] != TILE_FLAG_DIRTY)
 		{
+			// remember the dirty tile in the change list and per-row flags
 			m_tileflags[logindex] = TILE_FLAG_DIRTY;
+			m_row_dirty[logindex / m_cols] = 1;
+			if (m_dirty_list.size() < MAX_DIRTY_LIST)
+				m_dirty_list.push_back(logindex);
+			else
+				m_dirty_list_overflow = true;
 			m_all_tiles_clean = false;
 		}
 	}
@@ -647,6 +662,9 @@ void tilemap_t::mappings_create()
 	m_memory_to_logical.resize(max_memory_index);
 	m_logical_to_memory.resize(max_logical_index);
 	m_tileflags.resize(max_logical_index);
+	m_tileuniform.resize(max_logical_index);
+	m_row_dirty.resize(m_rows);
+	m_dirty_list.reserve(MAX_DIRTY_LIST);
 
 	// update the mappings
 	mappings_update();
@@ -699,6 +717,9 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	if (m_all_tiles_dirty || gfx_elements_changed())
 	{
 		memset(&m_tileflags[0], TILE_FLAG_DIRTY, m_tileflags.size());
+		memset(&m_row_dirty[0], 1, m_row_dirty.size());
+		m_dirty_list.clear();
+		m_dirty_list_overflow = true;
 		m_all_tiles_dirty = false;
 		m_gfx_used = 0;
 	}
@@ -723,14 +744,32 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
-	// iterate over rows and columns
-	logical_index logindex = 0;
-	for (u32 row = 0; row < m_rows; row++)
-		for (u32 col = 0; col < m_cols; col++, logindex++)
+	// if the change list did not overflow, only visit the listed tiles; entries
+	// already updated lazily by the draw path fail the dirty check and are skipped
+	if (!m_dirty_list_overflow)
+	{
+		for (logical_index logindex : m_dirty_list)
 			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
-				tile_update(logindex, col, row);
+				tile_update(logindex, logindex % m_cols, logindex / m_cols);
+	}
+
+	// otherwise fall back to scanning, but only rows containing dirty tiles
+	else
+	{
+		for (u32 row = 0; row < m_rows; row++)
+			if (m_row_dirty[row])
+			{
+				logical_index logindex = row * m_cols;
+				for (u32 col = 0; col < m_cols; col++, logindex++)
+					if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+						tile_update(logindex, col, row);
+			}
+	}
 
-	// mark it all clean
+	// reset the dirty tracking and mark it all clean
+	memset(&m_row_dirty[0], 0, m_row_dirty.size());
+	m_dirty_list.clear();
+	m_dirty_list_overflow = false;
 	m_all_tiles_clean = true;
 
 g_profiler.stop();
@@ -762,6 +801,10 @@ g_profiler.start(PROFILER_TILEMAP_UPDATE);
 	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && m_tileinfo.mask_data != nullptr)
 		m_tileflags[logindex] = tile_apply_bitmask(m_tileinfo.mask_data, x0, y0, m_tileinfo.category, flags);
 
+	// keep the row-contiguous copy of the first flagsmap pixel in sync so the
+	// draw loop can compute transparency runs without touching the flagsmap
+	m_tileuniform[logindex] = m_flagsmap.pix8(y0, x0);
+
 	// track which gfx have been used for this tilemap
 	if (m_tileinfo.gfxnum != 0xff && (m_gfx_used & (1 << m_tileinfo.gfxnum)) == 0)
 	{
@@ -1103,13 +1146,43 @@ void tilemap_t::draw_roz(screen_device &screen, bitmap_rgb32 &dest, const rectan
 
 
 //-------------------------------------------------
-//  draw_instance - draw a single instance of the
-//  tilemap to the internal pixmap at the given
-//  xpos,ypos
+//  draw_instance - resolve the per-draw constants
+//  once and hand off to a branch-free
+//  specialization of the draw loop
 //-------------------------------------------------
 
 template<class _BitmapClass>
 void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos)
+{
+	// priority and alpha are fixed for the whole draw call, so pick the
+	// specialization here instead of testing them per scanline
+	const bool havepriority = (blit.tilemap_priority_code & 0xffff) != 0xff00;
+	const bool havealpha = blit.alpha < 0xff;
+	if (havepriority)
+	{
+		if (havealpha)
+			draw_instance_core<_BitmapClass, true, true>(screen, dest, blit, xpos, ypos);
+		else
+			draw_instance_core<_BitmapClass, true, false>(screen, dest, blit, xpos, ypos);
+	}
+	else
+	{
+		if (havealpha)
+			draw_instance_core<_BitmapClass, false, true>(screen, dest, blit, xpos, ypos);
+		else
+			draw_instance_core<_BitmapClass, false, false>(screen, dest, blit, xpos, ypos);
+	}
+}
+
+
+//-------------------------------------------------
+//  draw_instance_core - draw a single instance of
+//  the tilemap to the internal pixmap at the given
+//  xpos,ypos
+//-------------------------------------------------
+
+template<class _BitmapClass, bool HavePriority, bool HaveAlpha>
+void tilemap_t::draw_instance_core(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos)
 {
 	// clip destination coordinates to the tilemap
 	// note that x2/y2 are exclusive, not inclusive
@@ -1158,6 +1231,11 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 		int row = y / m_tileheight;
 		int x_start = x1;
 
+		// the per-tile attribute arrays are row-contiguous, so the run
+		// computation below streams two flat byte arrays
+		const u8 *rowflags = &m_tileflags[row * m_cols];
+		const u8 *rowuniform = &m_tileuniform[row * m_cols];
+
 		// iterate across the applicable tilemap columns
 		trans_t prev_trans = WHOLLY_TRANSPARENT;
 		trans_t cur_trans;
@@ -1172,19 +1250,17 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 			// for other columns we look up the transparency information
 			else
 			{
-				logical_index logindex = row * m_cols + column;
-
 				// if the current tile is dirty, fix it
-				if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
-					tile_update(logindex, column, row);
+				if (rowflags[column] == TILE_FLAG_DIRTY)
+					tile_update(row * m_cols + column, column, row);
 
 				// if the current summary data is non-zero, we must draw masked
-				if ((m_tileflags[logindex] & blit.mask) != 0)
+				if ((rowflags[column] & blit.mask) != 0)
 					cur_trans = MASKED;
 
 				// otherwise, our transparency state is constant across the tile; fetch it
 				else
-					cur_trans = ((mask_baseaddr[column * m_tilewidth] & blit.mask) == blit.value) ? WHOLLY_OPAQUE : WHOLLY_TRANSPARENT;
+					cur_trans = ((rowuniform[column] & blit.mask) == blit.value) ? WHOLLY_OPAQUE : WHOLLY_TRANSPARENT;
 			}
 
 			// if the transparency state is the same as last time, don't render yet
@@ -1210,13 +1286,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline_draw_opaque_null<HavePriority>(x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_opaque_ind16(reinterpret_cast<u16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
-						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_opaque_rgb32(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							scanline_draw_opaque_ind16<HavePriority>(reinterpret_cast<u16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
+						else if (sizeof(*dest0) == 4 && !HaveAlpha)
+							scanline_draw_opaque_rgb32<HavePriority>(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_opaque_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							scanline_draw_opaque_rgb32_alpha<HavePriority>(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1231,13 +1307,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline_draw_masked_null<HavePriority>(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_masked_ind16(reinterpret_cast<u16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
-						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_masked_rgb32(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							scanline_draw_masked_ind16<HavePriority>(reinterpret_cast<u16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+						else if (sizeof(*dest0) == 4 && !HaveAlpha)
+							scanline_draw_masked_rgb32<HavePriority>(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_masked_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							scanline_draw_masked_rgb32_alpha<HavePriority>(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1596,6 +1672,19 @@ void tilemap_manager::mark_all_dirty()
 }
 
 
+//-------------------------------------------------
+//  pretouch_all - decode every tile of every
+//  tilemap up front, so the first drawn frames
+//  pay no decode cost
+//-------------------------------------------------
+
+void tilemap_manager::pretouch_all()
+{
+	for (tilemap_t &tmap : m_tilemap_list)
+		tmap.pixmap();
+}
+
+
 
 //**************************************************************************
 //  TILEMAP DEVICE
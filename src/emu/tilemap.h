@@ -482,6 +482,9 @@ class tilemap_t
 	// invalid logical index
 	static const logical_index INVALID_LOGICAL_INDEX = (logical_index)~0;
 
+	// maximum number of entries in the dirty tile list before falling back to row scanning
+	static const u32 MAX_DIRTY_LIST = 1024;
+
 	// maximum index in each array
 	static const pen_t MAX_PEN_TO_FLAGS = 256;
 
@@ -591,14 +594,16 @@ private:
 	bool gfx_elements_changed();
 
 	// inline scanline rasterizers
-	void scanline_draw_opaque_null(int count, u8 *pri, u32 pcode);
-	void scanline_draw_masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode);
-	void scanline_draw_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode);
-	void scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
-	void scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
+	// HavePriority is resolved once per draw call by the draw_instance
+	// dispatcher, so the priority test never runs inside the scanline loops
+	template<bool HavePriority> void scanline_draw_opaque_null(int count, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode);
+	template<bool HavePriority> void scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
+	template<bool HavePriority> void scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
 
 	// internal helpers
 	void postload();
@@ -615,6 +620,7 @@ private:
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
+	template<class _BitmapClass, bool HavePriority, bool HaveAlpha> void draw_instance_core(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
 
 	// managers and devices
@@ -646,6 +652,9 @@ private:
 	u8                          m_attributes;           // global attributes (flipx/y)
 	bool                        m_all_tiles_dirty;      // true if all tiles are dirty
 	bool                        m_all_tiles_clean;      // true if all tiles are clean
+	std::vector<u8>             m_row_dirty;            // nonzero for each row containing dirty tiles
+	std::vector<logical_index>  m_dirty_list;           // list of individually dirtied tiles
+	bool                        m_dirty_list_overflow;  // true if the dirty list overflowed
 	u32                         m_palette_offset;       // palette offset
 	u32                         m_gfx_used;             // bitmask of gfx items used
 	u32                         m_gfx_dirtyseq[MAX_GFX_ELEMENTS]; // dirtyseq values from last check
@@ -666,6 +675,7 @@ private:
 	// transparency mapping
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	std::vector<u8>             m_tileflags;            // per-tile flags
+	std::vector<u8>             m_tileuniform;          // per-tile first-pixel flags, stored row-contiguous for the draw loop
 	u8                          m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
 };
 
@@ -695,6 +705,7 @@ public:
 
 	// global operations on all tilemaps
 	void mark_all_dirty();
+	void pretouch_all();
 	void set_flip_all(u32 attributes);
 
 private:
@@ -16,10 +16,26 @@
 #include "video/rgbutil.h"
 
 #include <ctype.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 #include <typeinfo>
 
 
+//**************************************************************************
+//  STATIC VARIABLES
+//**************************************************************************
+
+// checker handling validation on the current thread; messages captured by
+// the checker pushed onto the osd_output stack are routed here so worker
+// threads attribute errors to the right driver
+static thread_local validity_checker *s_thread_checker = nullptr;
+
+// serializes insertion into the shared duplicate-detection maps
+static std::mutex s_dupes_mutex;
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -138,6 +154,8 @@ validity_checker::validity_checker(emu_options &options)
 	, m_current_device(nullptr)
 	, m_current_ioport(nullptr)
 	, m_validate_all(false)
+	, m_parent(nullptr)
+	, m_output_sink(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -148,6 +166,21 @@ validity_checker::validity_checker(emu_options &options)
 	}
 }
 
+
+//-------------------------------------------------
+//  validity_checker - constructor for a worker
+//  checker sharing duplicate detection with a
+//  top-level parent
+//-------------------------------------------------
+
+validity_checker::validity_checker(emu_options &options, validity_checker &parent)
+	: validity_checker(options)
+{
+	m_parent = &parent;
+	m_print_verbose = parent.m_print_verbose;
+	m_validate_all = parent.m_validate_all;
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
@@ -217,16 +250,59 @@ bool validity_checker::check_all_matching(const char *string)
 		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
 	}
 
-	// then iterate over all drivers and check them
+	// collect the set of matching drivers first
 	m_drivlist.reset();
-	bool validated_any = false;
+	std::vector<int> indices;
 	while (m_drivlist.next())
-	{
 		if (m_drivlist.matches(string, m_drivlist.driver().name))
-		{
-			validate_one(m_drivlist.driver());
-			validated_any = true;
-		}
+			indices.push_back(m_drivlist.current());
+	bool const validated_any = !indices.empty();
+
+	// per-driver validation units are independent, so spread them across a
+	// thread pool; each worker gets a private checker for scratch state and
+	// its summaries are captured and replayed in driver order
+	std::size_t const threadcount = (std::min<std::size_t>)((std::max)(std::thread::hardware_concurrency(), 1U), indices.size());
+	if (threadcount > 1)
+	{
+		std::vector<std::string> summaries(indices.size());
+		std::atomic<std::size_t> nextjob(0);
+		std::atomic<int> errors(0), warnings(0);
+		auto const worker =
+				[this, &indices, &summaries, &nextjob, &errors, &warnings] ()
+				{
+					validity_checker child(m_drivlist.options(), *this);
+					s_thread_checker = &child;
+					while (true)
+					{
+						std::size_t const job = nextjob++;
+						if (job >= indices.size())
+							break;
+						child.m_output_sink = &summaries[job];
+						child.validate_one(driver_list::driver(indices[job]));
+					}
+					s_thread_checker = nullptr;
+					errors += child.m_errors;
+					warnings += child.m_warnings;
+				};
+		std::vector<std::thread> threads;
+		threads.reserve(threadcount - 1);
+		for (std::size_t threadnum = 1; threadnum < threadcount; threadnum++)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread &thread : threads)
+			thread.join();
+
+		// fold the worker tallies in and emit the summaries in driver order
+		m_errors += errors;
+		m_warnings += warnings;
+		for (std::string const &summary : summaries)
+			if (!summary.empty())
+				output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", summary.c_str());
+	}
+	else
+	{
+		for (int index : indices)
+			validate_one(driver_list::driver(index));
 	}
 
 	// validate devices
@@ -1402,18 +1478,25 @@ void validity_checker::validate_rgb()
 
 void validity_checker::validate_driver()
 {
-	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
+	// duplicate detection spans the whole run, so worker checkers share the
+	// top-level checker's maps under a lock
 	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
-		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
-	}
+		validity_checker &shared = (m_parent != nullptr) ? *m_parent : *this;
+		std::lock_guard<std::mutex> lock(s_dupes_mutex);
 
-	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->type.fullname(), m_current_driver)).second)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->type.fullname())->second;
-		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
+		// check for duplicate names
+		if (!shared.m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
+		{
+			const game_driver *match = shared.m_names_map.find(m_current_driver->name)->second;
+			osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
+		}
+
+		// check for duplicate descriptions
+		if (!shared.m_descriptions_map.insert(std::make_pair(m_current_driver->type.fullname(), m_current_driver)).second)
+		{
+			const game_driver *match = shared.m_descriptions_map.find(m_current_driver->type.fullname())->second;
+			osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
+		}
 	}
 
 	// determine if we are a clone
@@ -2172,43 +2255,46 @@ void validity_checker::build_output_prefix(std::string &str)
 
 void validity_checker::output_callback(osd_output_channel channel, const char *msg, va_list args)
 {
+	// messages raised on a worker thread belong to that thread's checker
+	validity_checker &target = (s_thread_checker != nullptr) ? *s_thread_checker : *this;
+
 	std::string output;
 	switch (channel)
 	{
 	case OSD_OUTPUT_CHANNEL_ERROR:
 		// count the error
-		m_errors++;
+		target.m_errors++;
 
 		// output the source(driver) device 'tag'
-		build_output_prefix(output);
+		target.build_output_prefix(output);
 
 		// generate the string
 		strcatvprintf(output, msg, args);
-		m_error_text.append(output);
+		target.m_error_text.append(output);
 		break;
 
 	case OSD_OUTPUT_CHANNEL_WARNING:
 		// count the error
-		m_warnings++;
+		target.m_warnings++;
 
 		// output the source(driver) device 'tag'
-		build_output_prefix(output);
+		target.build_output_prefix(output);
 
 		// generate the string and output to the original target
 		strcatvprintf(output, msg, args);
-		m_warning_text.append(output);
+		target.m_warning_text.append(output);
 		break;
 
 	case OSD_OUTPUT_CHANNEL_VERBOSE:
 		// if we're not verbose, skip it
-		if (!m_print_verbose) break;
+		if (!target.m_print_verbose) break;
 
 		// output the source(driver) device 'tag'
-		build_output_prefix(output);
+		target.build_output_prefix(output);
 
 		// generate the string and output to the original target
 		strcatvprintf(output, msg, args);
-		m_verbose_text.append(output);
+		target.m_verbose_text.append(output);
 		break;
 
 	default:
@@ -2227,9 +2313,13 @@ void validity_checker::output_via_delegate(osd_output_channel channel, const cha
 {
 	va_list argptr;
 
-	// call through to the delegate with the proper parameters
+	// call through to the delegate with the proper parameters, or capture
+	// into the summary sink when validating on a worker thread
 	va_start(argptr, format);
-	chain_output(channel, format, argptr);
+	if (m_output_sink != nullptr)
+		strcatvprintf(*m_output_sink, format, argptr);
+	else
+		chain_output(channel, format, argptr);
 	va_end(argptr);
 }
 
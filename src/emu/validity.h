@@ -59,6 +59,9 @@ private:
 	typedef std::unordered_map<std::string,const game_driver *> game_driver_map;
 	typedef std::unordered_map<std::string,uintptr_t> int_map;
 
+	// construction of worker checkers for parallel driver validation
+	validity_checker(emu_options &options, validity_checker &parent);
+
 	// internal helpers
 	const char *ioport_string_from_index(u32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
@@ -120,6 +123,10 @@ private:
 	int_map                 m_region_map;
 	std::unordered_set<std::string>   m_already_checked;
 	bool                    m_validate_all;
+
+	// parallel validation state
+	validity_checker *      m_parent;           // top-level checker when running as a worker
+	std::string *           m_output_sink;      // capture buffer for ordered summary replay
 };
 
 #endif // MAME_EMU_VALIDITY_H
@@ -58,6 +58,98 @@ const bool video_manager::s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS] =
 
 
 
+//**************************************************************************
+//  ASYNC WRITER
+//**************************************************************************
+
+//-------------------------------------------------
+//  async_writer - constructor
+//-------------------------------------------------
+
+async_writer::async_writer()
+	: m_exiting(false)
+	, m_running(0)
+{
+	m_thread = std::thread([this]() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			while (!m_exiting && m_jobs.empty())
+				m_worker_wake.wait(lock);
+			if (m_exiting && m_jobs.empty())
+				return;
+
+			std::function<void()> job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			m_running++;
+			lock.unlock();
+			job();
+			lock.lock();
+			m_running--;
+			m_producer_wake.notify_all();
+		}
+	});
+}
+
+
+//-------------------------------------------------
+//  ~async_writer - drain the queue and stop the
+//  worker
+//-------------------------------------------------
+
+async_writer::~async_writer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exiting = true;
+	}
+	m_worker_wake.notify_all();
+	m_thread.join();
+}
+
+
+//-------------------------------------------------
+//  enqueue - hand a job to the worker, blocking
+//  only when the queue is full
+//-------------------------------------------------
+
+void async_writer::enqueue(std::function<void()> &&job)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (int(m_jobs.size()) >= MAX_QUEUED_JOBS)
+		m_producer_wake.wait(lock);
+	m_jobs.push_back(std::move(job));
+	m_worker_wake.notify_all();
+}
+
+
+//-------------------------------------------------
+//  flush - wait for every queued job to finish
+//-------------------------------------------------
+
+void async_writer::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_jobs.empty() || m_running > 0)
+		m_producer_wake.wait(lock);
+}
+
+
+//-------------------------------------------------
+//  clone_snap_bitmap - copy a snapshot bitmap so
+//  the worker can outlive the original
+//-------------------------------------------------
+
+static std::shared_ptr<bitmap_rgb32> clone_snap_bitmap(bitmap_rgb32 &src)
+{
+	std::shared_ptr<bitmap_rgb32> copy = std::make_shared<bitmap_rgb32>(src.width(), src.height());
+	for (int y = 0; y < src.height(); y++)
+		memcpy(&copy->pix32(y), &src.pix32(y), src.width() * 4);
+	return copy;
+}
+
+
+
 //**************************************************************************
 //  VIDEO MANAGER
 //**************************************************************************
@@ -93,6 +185,7 @@ video_manager::video_manager(running_machine &machine)
 	, m_throttle_rate(1.0f)
 	, m_fastforward(false)
 	, m_seconds_to_run(machine.options().seconds_to_run())
+	, m_frames_to_run(machine.options().frames_to_run())
 	, m_auto_frameskip(machine.options().auto_frameskip())
 	, m_speed(original_speed_setting())
 	, m_empty_skip_count(0)
@@ -101,6 +194,17 @@ video_manager::video_manager(running_machine &machine)
 	, m_frameskip_adjust(0)
 	, m_skipping_this_frame(false)
 	, m_average_oversleep(0)
+	, m_governor_enabled(machine.options().governor())
+	, m_governor_stage(0)
+	, m_governor_adjust(0)
+	, m_frames_run(0)
+	, m_bench_last_ticks(0)
+	, m_pacing_enabled(machine.options().frame_pacing())
+	, m_latency_probe(machine.options().latency_probe())
+	, m_latency_marker(false)
+	, m_latency_edge_time(0)
+	, m_pacing_count(0)
+	, m_pacing_present_avg(0)
 	, m_snap_target(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
@@ -111,6 +215,10 @@ video_manager::video_manager(running_machine &machine)
 	, m_timecode_start(attotime::zero)
 	, m_timecode_total(attotime::zero)
 {
+	memset(m_bench_histogram, 0, sizeof(m_bench_histogram));
+	memset(m_pacing_ring, 0, sizeof(m_pacing_ring));
+	memset(m_latency_histogram, 0, sizeof(m_latency_histogram));
+
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&video_manager::exit, this));
 	machine.save().register_postload(save_prepost_delegate(FUNC(video_manager::postload), this));
@@ -236,6 +344,11 @@ extern bool catchingUp;
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// attribute allocations during composition to the render subsystem
+	memtrack::tag_scope alloc_scope(memtrack::TAG_RENDER);
+
+	TRACE_EVENT_SCOPE("video_frame_update");
+
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
@@ -260,16 +373,41 @@ void video_manager::frame_update(bool from_debugger)
 	// draw the user interface
 	emulator_info::draw_user_interface(machine());
 
+	// overlay the latency probe's corner marker after the UI has rendered,
+	// so a camera pointed at the screen sees input edges as marker flips
+	if (m_latency_probe)
+		machine().render().ui_container().add_rect(0.0f, 0.0f, 0.04f, 0.04f,
+				m_latency_marker ? rgb_t(0xff, 0xff, 0xff, 0xff) : rgb_t(0xff, 0x00, 0x00, 0x00),
+				PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+
 	// if we're throttling, synchronize before rendering
+	osd_ticks_t const pacing_emulate_done = m_pacing_enabled ? osd_ticks() : 0;
 	attotime current_time = machine().time();
 	if (!from_debugger && !skipped_it && effective_throttle())
 		update_throttle(current_time);
+	osd_ticks_t const pacing_throttle_done = m_pacing_enabled ? osd_ticks() : 0;
 
 	// ask the OSD to update
 	g_profiler.start(PROFILER_BLIT);
 	machine().osd().update(!from_debugger && skipped_it);
 	g_profiler.stop();
 
+	// log the presentation timestamp for pacing analysis
+	if (m_pacing_enabled && !from_debugger && !skipped_it)
+		pacing_record(pacing_emulate_done, pacing_throttle_done, osd_ticks());
+
+	// the first presented frame after an input edge carries the flipped
+	// marker; credit the whole interval to that edge
+	if (m_latency_probe && m_latency_edge_time != 0 && !from_debugger && !skipped_it)
+	{
+		u64 const delta_us = (osd_ticks() - m_latency_edge_time) * 1000000 / osd_ticks_per_second();
+		int bucket = 0;
+		while (bucket < ARRAY_LENGTH(m_latency_histogram) - 1 && delta_us >= (u64(1) << bucket))
+			bucket++;
+		m_latency_histogram[bucket]++;
+		m_latency_edge_time = 0;
+	}
+
 	emulator_info::periodic_check();
 
 	// perform tasks for this frame
@@ -280,10 +418,23 @@ void video_manager::frame_update(bool from_debugger)
 	if (!netCommon && !from_debugger)
 		update_frameskip();
 
+	// netplay pins the frameskip/update cadence for determinism, but the
+	// governor can still shed sync-safe fidelity such as artwork
+	else if (!from_debugger && m_governor_enabled)
+	{
+		m_frameskip_counter = (m_frameskip_counter + 1) % FRAMESKIP_LEVELS;
+		if (m_frameskip_counter == 0 && effective_throttle() && m_speed_percent != 0.0)
+			update_governor();
+	}
+
 	// update speed computations
 	if (!from_debugger && !skipped_it)
 		recompute_speed(current_time);
 
+	// count frames for fixed-length benchmark runs
+	if (!from_debugger && m_frames_to_run != 0 && phase == machine_phase::RUNNING)
+		bench_frame_update();
+
 	// call the end-of-frame callback
 	if (phase == machine_phase::RUNNING)
 	{
@@ -334,10 +485,37 @@ std::string video_manager::speed_text()
 	if (partials > 1)
 		util::stream_format(str, "\n%d partial updates", partials);
 
+	// append pacing percentiles when telemetry is on
+	if (m_pacing_enabled)
+	{
+		std::string pacing = pacing_text();
+		if (!pacing.empty())
+			str << '\n' << pacing;
+	}
+
 	return str.str();
 }
 
 
+//-------------------------------------------------
+//  governor_text - describe the governor's
+//  current degradation stage
+//-------------------------------------------------
+
+std::string video_manager::governor_text() const
+{
+	static const char *const stage_names[GOVERNOR_STAGE_MAX + 1] =
+	{
+		"full fidelity",
+		"auto frameskip",
+		"quantum x2",
+		"quantum x4",
+		"artwork shed"
+	};
+	return string_format("governor: %s", stage_names[m_governor_stage]);
+}
+
+
 //-------------------------------------------------
 //  save_snapshot - save a snapshot to the given
 //  file handle
@@ -367,6 +545,45 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  queue_snapshot_write - render a snapshot on
+//  the emulation thread, then hand the PNG
+//  compression and file write to the background
+//  writer
+//-------------------------------------------------
+
+void video_manager::queue_snapshot_write(screen_device *screen, std::shared_ptr<emu_file> file)
+{
+	// validate
+	assert(!m_snap_native || screen != nullptr);
+
+	// rendering has to happen here; the bitmap and palette are copied so
+	// the worker is immune to the next frame overwriting them
+	create_snapshot_bitmap(screen);
+	std::shared_ptr<bitmap_rgb32> bitmap = clone_snap_bitmap(m_snap_bitmap);
+
+	std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+	std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
+
+	std::shared_ptr<std::vector<rgb_t> > palette;
+	if (screen != nullptr && screen->has_palette())
+	{
+		const rgb_t *entries = screen->palette().palette()->entry_list_adjusted();
+		palette = std::make_shared<std::vector<rgb_t> >(entries, entries + screen->palette().entries());
+	}
+
+	m_writer.enqueue([file, bitmap, palette, text1, text2]() {
+		png_info pnginfo;
+		pnginfo.add_text("Software", text1.c_str());
+		pnginfo.add_text("System", text2.c_str());
+		png_error error = png_write_bitmap(*file, &pnginfo, *bitmap,
+				palette ? palette->size() : 0, palette ? &(*palette)[0] : nullptr);
+		if (error != PNGERR_NONE)
+			osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
+	});
+}
+
+
 int createSnapshot = 0;
 //-------------------------------------------------
 //  save_active_screen_snapshots - save a
@@ -387,20 +604,20 @@ void video_manager::save_active_screen_snapshots_real()
 		for (screen_device &screen : screen_device_iterator(machine().root_device()))
 			if (machine().render().is_live(screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				osd_file::error filerr = open_next(file, "png");
+				auto file = std::make_shared<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				osd_file::error filerr = open_next(*file, "png");
 				if (filerr == osd_file::error::NONE)
-					save_snapshot(&screen, file);
+					queue_snapshot_write(&screen, file);
 			}
 	}
 
 	// otherwise, just write a single snapshot
 	else
 	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = open_next(file, "png");
+		auto file = std::make_shared<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		osd_file::error filerr = open_next(*file, "png");
 		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
+			queue_snapshot_write(nullptr, file);
 	}
 }
 
@@ -641,10 +858,13 @@ void video_manager::end_recording_avi(uint32_t index)
 	avi_info_t &info = m_avis[index];
 	if (info.m_avi_file)
 	{
+		// wait for any queued writes against this file before closing it
+		m_writer.flush();
 		info.m_avi_file.reset();
 
 		// reset the state
 		info.m_avi_frame = 0;
+		info.m_failed = false;
 	}
 }
 
@@ -657,11 +877,14 @@ void video_manager::end_recording_mng(uint32_t index)
 	mng_info_t &info = m_mngs[index];
 	if (info.m_mng_file != nullptr)
 	{
+		// wait for any queued writes against this file before closing it
+		m_writer.flush();
 		mng_capture_stop(*info.m_mng_file);
 		info.m_mng_file.reset();
 
 		// reset the state
 		info.m_mng_frame = 0;
+		info.m_failed = false;
 	}
 }
 
@@ -691,14 +914,26 @@ void video_manager::add_sound_to_avi_recording(const s16 *sound, int numsamples,
 	// only record if we have a file
 	if (info.m_avi_file != nullptr)
 	{
+		// if a queued write failed, stop the recording
+		if (info.m_failed)
+		{
+			end_recording_avi(index);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_file::error avierr = info.m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
-		if (avierr == avi_file::error::NONE)
-			avierr = info.m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
-		if (avierr != avi_file::error::NONE)
-			end_recording_avi(index);
+		// copy the samples and queue the write
+		auto samples = std::make_shared<std::vector<s16> >(sound, sound + numsamples * 2);
+		avi_file *file = info.m_avi_file.get();
+		bool *failed = &info.m_failed;
+		m_writer.enqueue([file, samples, numsamples, failed]() {
+			avi_file::error avierr = file->append_sound_samples(0, samples->data() + 0, numsamples, 1);
+			if (avierr == avi_file::error::NONE)
+				avierr = file->append_sound_samples(1, samples->data() + 1, numsamples, 1);
+			if (avierr != avi_file::error::NONE)
+				*failed = true;
+		});
 
 		g_profiler.stop();
 	}
@@ -735,6 +970,56 @@ void video_manager::exit()
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
 	}
+
+	// report the input latency distribution if the probe was active
+	if (m_latency_probe)
+		latency_report();
+}
+
+
+//-------------------------------------------------
+//  latency_input_edge - note that a digital
+//  input changed; flips the corner marker and
+//  timestamps the edge for the probe
+//-------------------------------------------------
+
+void video_manager::latency_input_edge()
+{
+	m_latency_marker = !m_latency_marker;
+	if (m_latency_edge_time == 0)
+		m_latency_edge_time = osd_ticks();
+}
+
+
+//-------------------------------------------------
+//  latency_report - print the input-to-present
+//  latency distribution gathered by the probe
+//-------------------------------------------------
+
+void video_manager::latency_report()
+{
+	u64 total = 0;
+	for (u32 count : m_latency_histogram)
+		total += count;
+	if (total == 0)
+		return;
+
+	osd_printf_info("Input latency probe: %d edges (throttle %s, pacing %s)\n",
+			int(total), m_throttled ? "on" : "off", m_pacing_enabled ? "on" : "off");
+	for (int mark : { 50, 90, 99 })
+	{
+		u64 const target = (total * mark + 99) / 100;
+		u64 cumulative = 0;
+		for (int bucket = 0; bucket < ARRAY_LENGTH(m_latency_histogram); bucket++)
+		{
+			cumulative += m_latency_histogram[bucket];
+			if (cumulative >= target)
+			{
+				osd_printf_info("  p%d input-to-present < %llu us\n", mark, (unsigned long long)(u64(1) << bucket));
+				break;
+			}
+		}
+	}
 }
 
 
@@ -807,6 +1092,10 @@ inline bool video_manager::effective_autoframeskip() const
 	if (m_fastforward || machine().paused())
 		return false;
 
+	// the governor forces frameskip adaptation on while degraded
+	if (m_governor_enabled && m_governor_stage >= 1)
+		return true;
+
 	// otherwise, it's up to the user
 	return m_auto_frameskip;
 }
@@ -946,6 +1235,14 @@ void video_manager::update_throttle(attotime emutime)
           printed=true;
         }
         attotime tolerance(0,16*ATTOSECONDS_PER_MILLISECOND);
+        if (m_pacing_enabled) {
+          // release the frame only as early as the measured presentation
+          // cost requires; a vsync'd OSD then has less time to queue ahead
+          u64 presentMs =
+              pacing_present_latency() * 1000 / osd_ticks_per_second();
+          u64 leadMs = std::min<u64>(std::max<u64>(presentMs, 1), 16);
+          tolerance = attotime(0, leadMs * ATTOSECONDS_PER_MILLISECOND);
+        }
         if ((emutime - expectedEmulationTime) < tolerance) {
           //cout << "Returning " << ((emutime - expectedEmulationTime).attoseconds/ATTOSECONDS_PER_MILLISECOND) << endl;
           return;
@@ -1085,12 +1382,84 @@ void video_manager::update_frameskip()
 		}
 	}
 
+	// let the governor re-rank its degradations at the same cadence
+	if (m_governor_enabled && effective_throttle() && m_frameskip_counter == 0 && m_speed_percent != 0.0)
+		update_governor();
+
 	// increment the frameskip counter and determine if we will skip the next frame
 	m_frameskip_counter = (m_frameskip_counter + 1) % FRAMESKIP_LEVELS;
 	m_skipping_this_frame = s_skiptable[effective_frameskip()][m_frameskip_counter];
 }
 
 
+//-------------------------------------------------
+//  update_governor - compare achieved speed
+//  against the target and escalate or roll back
+//  degradation stages with hysteresis
+//-------------------------------------------------
+
+void video_manager::update_governor()
+{
+	// calibrate the "adjusted speed" based on the target
+	double adjusted_speed_percent = m_speed_percent / (double) m_throttle_rate;
+	double speed = m_speed * 0.001;
+
+	// behind target with the previous stage exhausted: lean towards
+	// escalation; comfortably on target: lean towards recovery
+	if (adjusted_speed_percent < 0.97 * speed &&
+			(m_governor_stage != 1 || netCommon || m_frameskip_level == MAX_FRAMESKIP))
+		m_governor_adjust--;
+	else if (adjusted_speed_percent >= 0.995 * speed)
+		m_governor_adjust++;
+	else
+		m_governor_adjust = 0;
+
+	// escalate after two consecutive misses; recover only after a long
+	// stretch on target so marginal drivers do not oscillate
+	if (m_governor_adjust <= -2 && m_governor_stage < GOVERNOR_STAGE_MAX)
+	{
+		m_governor_adjust = 0;
+		apply_governor_stage(m_governor_stage + 1);
+	}
+	else if (m_governor_adjust >= 15 && m_governor_stage > 0 &&
+			(m_governor_stage != 1 || netCommon || m_frameskip_level == 0))
+	{
+		m_governor_adjust = 0;
+		apply_governor_stage(m_governor_stage - 1);
+	}
+}
+
+
+//-------------------------------------------------
+//  apply_governor_stage - apply every knob for
+//  the given degradation stage; each stage is a
+//  superset of the ones below it
+//-------------------------------------------------
+
+void video_manager::apply_governor_stage(int stage)
+{
+	m_governor_stage = stage;
+
+	// stage 1 forces frameskip adaptation on, which
+	// effective_autoframeskip picks up directly; stages 2 and 3 widen
+	// the scheduler quantum, but never in netplay where diverging
+	// interleave would desync peers
+	if (!netCommon)
+		machine().scheduler().set_quantum_relax((stage >= 3) ? 4 : (stage >= 2) ? 2 : 1);
+
+	// stage 4 sheds artwork layers; below it the user settings return
+	bool artwork = (stage < GOVERNOR_STAGE_MAX);
+	for (render_target *target = machine().render().first_target(); target != nullptr; target = target->next())
+	{
+		target->set_backdrops_enabled(artwork && machine().options().use_backdrops());
+		target->set_overlays_enabled(artwork && machine().options().use_overlays());
+		target->set_bezels_enabled(artwork && machine().options().use_bezels());
+	}
+
+	osd_printf_verbose("Frame governor: %s\n", governor_text().c_str());
+}
+
+
 //-------------------------------------------------
 //  update_refresh_speed - update the m_speed
 //  based on the maximum refresh rate supported
@@ -1196,6 +1565,232 @@ void video_manager::recompute_speed(const attotime &emutime)
 }
 
 
+//-------------------------------------------------
+//  bench_frame_update - account one frame of a
+//  fixed-length benchmark run, and finish the run
+//  once exactly frames_to_run frames have passed
+//-------------------------------------------------
+
+void video_manager::bench_frame_update()
+{
+	// bucket the wall-clock gap since the previous counted frame
+	osd_ticks_t curticks = osd_ticks();
+	if (m_bench_last_ticks != 0)
+	{
+		u64 frame_us = (curticks - m_bench_last_ticks) * 1000000 / osd_ticks_per_second();
+		int bucket = 0;
+		while (bucket < ARRAY_LENGTH(m_bench_histogram) - 1 && frame_us >= (u64(1) << bucket))
+			bucket++;
+		m_bench_histogram[bucket]++;
+	}
+	m_bench_last_ticks = curticks;
+
+	// once the requested frame count is reached, dump stats and exit
+	if (++m_frames_run >= m_frames_to_run)
+	{
+		bench_write_json();
+		bench_append_report();
+		machine().schedule_exit();
+		m_frames_to_run = 0;    // don't fire again while the exit drains
+	}
+}
+
+
+//-------------------------------------------------
+//  bench_write_json - emit benchmark statistics
+//  as JSON for offline regression tracking
+//-------------------------------------------------
+
+void video_manager::bench_write_json()
+{
+	const char *filename = machine().options().bench_json();
+	if (filename == nullptr || filename[0] == 0)
+		return;
+
+	FILE *file = fopen(filename, "w");
+	if (file == nullptr)
+	{
+		osd_printf_error("Error opening benchmark output file '%s'\n", filename);
+		return;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"driver\": \"%s\",\n", machine().system().name);
+	fprintf(file, "\t\"frames\": %u,\n", m_frames_run);
+	fprintf(file, "\t\"emulated_seconds\": %f,\n", machine().time().as_double());
+	fprintf(file, "\t\"speed_percent\": %f,\n", 100.0 * m_speed_percent);
+
+	// frame wall times; each bucket counts frames that took less than
+	// "lt_us" microseconds (and at least half that)
+	fprintf(file, "\t\"frame_time_histogram\": [");
+	bool first = true;
+	for (int bucket = 0; bucket < ARRAY_LENGTH(m_bench_histogram); bucket++)
+		if (m_bench_histogram[bucket] != 0)
+		{
+			fprintf(file, "%s\n\t\t{ \"lt_us\": %llu, \"count\": %u }", first ? "" : ",",
+					(unsigned long long)(u64(1) << bucket), m_bench_histogram[bucket]);
+			first = false;
+		}
+	fprintf(file, "\n\t],\n");
+
+	// per-device share of executed cycles and of host time
+	u64 total_cycles = 0;
+	u64 total_host = 0;
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+	{
+		total_cycles += exec.total_cycles();
+		total_host += exec.host_ticks();
+	}
+	fprintf(file, "\t\"devices\": [");
+	first = true;
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+	{
+		u64 cycles = exec.total_cycles();
+		u64 host = exec.host_ticks();
+		fprintf(file, "%s\n\t\t{ \"tag\": \"%s\", \"cycles\": %llu, \"share_percent\": %f, \"host_ticks\": %llu, \"host_share_percent\": %f }", first ? "" : ",",
+				exec.device().tag(), (unsigned long long)cycles,
+				(total_cycles != 0) ? 100.0 * double(cycles) / double(total_cycles) : 0.0,
+				(unsigned long long)host,
+				(total_host != 0) ? 100.0 * double(host) / double(total_host) : 0.0);
+		first = false;
+	}
+	fprintf(file, "\n\t]\n");
+	fprintf(file, "}\n");
+	fclose(file);
+
+	osd_printf_info("Benchmark statistics written to '%s'\n", filename);
+}
+
+
+//-------------------------------------------------
+//  bench_append_report - append one CSV row of
+//  results for this run to the suite report
+//-------------------------------------------------
+
+void video_manager::bench_append_report()
+{
+	const char *filename = machine().options().bench_report();
+	if (filename == nullptr || filename[0] == 0)
+		return;
+
+	FILE *file = fopen(filename, "a");
+	if (file == nullptr)
+	{
+		osd_printf_error("Error opening benchmark report file '%s'\n", filename);
+		return;
+	}
+
+	// frame cost percentiles out of the power-of-two histogram; coarse, but
+	// monotone, which is what regression tracking needs
+	u32 total = 0;
+	for (u32 count : m_bench_histogram)
+		total += count;
+	u64 pct_us[3] = { 0, 0, 0 };
+	static const u32 marks[3] = { 50, 90, 99 };
+	for (int p = 0; p < 3 && total != 0; p++)
+	{
+		u32 target = (total * marks[p] + 99) / 100;
+		u32 cumulative = 0;
+		for (int bucket = 0; bucket < ARRAY_LENGTH(m_bench_histogram); bucket++)
+		{
+			cumulative += m_bench_histogram[bucket];
+			if (cumulative >= target)
+			{
+				pct_us[p] = u64(1) << bucket;
+				break;
+			}
+		}
+	}
+
+	// attribute the run to the device with the largest host time share
+	u64 total_host = 0;
+	u64 top_host = 0;
+	const char *top_tag = "-";
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+	{
+		u64 host = exec.host_ticks();
+		total_host += host;
+		if (host > top_host)
+		{
+			top_host = host;
+			top_tag = exec.device().tag();
+		}
+	}
+
+	fprintf(file, "%s,%u,%f,%f,%llu,%llu,%llu,%s,%f\n",
+			machine().system().name, m_frames_run, machine().time().as_double(),
+			100.0 * m_speed_percent,
+			(unsigned long long)pct_us[0], (unsigned long long)pct_us[1], (unsigned long long)pct_us[2],
+			top_tag,
+			(total_host != 0) ? 100.0 * double(top_host) / double(total_host) : 0.0);
+	fclose(file);
+}
+
+
+//-------------------------------------------------
+//  pacing_record - store one frame's pacing
+//  timestamps in the ring and track the average
+//  presentation cost
+//-------------------------------------------------
+
+void video_manager::pacing_record(osd_ticks_t emulate_done, osd_ticks_t throttle_done, osd_ticks_t present_done)
+{
+	pacing_record_t &rec = m_pacing_ring[m_pacing_count++ % PACING_FRAMES];
+	rec.emulate_done = emulate_done;
+	rec.throttle_done = throttle_done;
+	rec.present_done = present_done;
+
+	// 7/8 old + 1/8 new keeps the estimate responsive without jumping on
+	// a single slow blit
+	osd_ticks_t const present_cost = present_done - throttle_done;
+	if (m_pacing_present_avg == 0)
+		m_pacing_present_avg = present_cost;
+	else
+		m_pacing_present_avg = (m_pacing_present_avg * 7 + present_cost) / 8;
+}
+
+
+//-------------------------------------------------
+//  pacing_text - format presentation interval
+//  percentiles over the telemetry ring
+//-------------------------------------------------
+
+std::string video_manager::pacing_text()
+{
+	// need a reasonable window before percentiles mean anything
+	u32 const valid = (m_pacing_count < PACING_FRAMES) ? m_pacing_count : PACING_FRAMES;
+	if (valid < 16)
+		return std::string();
+
+	// gather presentation-to-presentation intervals, oldest first
+	std::vector<osd_ticks_t> intervals;
+	intervals.reserve(valid - 1);
+	u32 const first = m_pacing_count - valid;
+	for (u32 index = first + 1; index != m_pacing_count; index++)
+	{
+		pacing_record_t const &prev = m_pacing_ring[(index - 1) % PACING_FRAMES];
+		pacing_record_t const &cur = m_pacing_ring[index % PACING_FRAMES];
+		if (cur.present_done > prev.present_done)
+			intervals.push_back(cur.present_done - prev.present_done);
+	}
+	if (intervals.empty())
+		return std::string();
+	std::sort(intervals.begin(), intervals.end());
+
+	double const to_ms = 1000.0 / double(osd_ticks_per_second());
+	auto percentile = [&intervals, to_ms](int pct)
+	{
+		return to_ms * double(intervals[std::min<size_t>(intervals.size() * pct / 100, intervals.size() - 1)]);
+	};
+
+	std::ostringstream str;
+	util::stream_format(str, "pace %.1f/%.1f/%.1fms present %.1fms",
+			percentile(50), percentile(95), percentile(99),
+			to_ms * double(m_pacing_present_avg));
+	return str.str();
+}
+
+
 //-------------------------------------------------
 //  create_snapshot_bitmap - creates a
 //  bitmap containing the screenshot for the
@@ -1409,21 +2004,37 @@ void video_manager::record_frame()
 		{
 			avi_info_t &avi_info = m_avis[index];
 
-			// loop until we hit the right time
-			while (avi_info.m_avi_next_frame_time <= curtime)
+			// if a queued write failed, stop the recording
+			if (avi_info.m_failed)
 			{
-				// write the next frame
-				avi_file::error avierr = avi_info.m_avi_file->append_video_frame(m_snap_bitmap);
-				if (avierr != avi_file::error::NONE)
+				end_recording_avi(index);
+			}
+			else if (avi_info.m_avi_next_frame_time <= curtime)
+			{
+				// count the frames due and advance time; the compression
+				// and write happen on the background writer
+				int frames = 0;
+				while (avi_info.m_avi_next_frame_time <= curtime)
 				{
-					g_profiler.stop(); // FIXME: double exit if this happens?
-					end_recording_avi(index);
-					break;
+					avi_info.m_avi_next_frame_time += avi_info.m_avi_frame_period;
+					avi_info.m_avi_frame++;
+					frames++;
 				}
 
-				// advance time
-				avi_info.m_avi_next_frame_time += avi_info.m_avi_frame_period;
-				avi_info.m_avi_frame++;
+				std::shared_ptr<bitmap_rgb32> bitmap = clone_snap_bitmap(m_snap_bitmap);
+				avi_file *file = avi_info.m_avi_file.get();
+				bool *failed = &avi_info.m_failed;
+				m_writer.enqueue([file, bitmap, frames, failed]() {
+					for (int frame = 0; frame < frames; frame++)
+					{
+						avi_file::error avierr = file->append_video_frame(*bitmap);
+						if (avierr != avi_file::error::NONE)
+						{
+							*failed = true;
+							break;
+						}
+					}
+				});
 			}
 		}
 
@@ -1432,34 +2043,58 @@ void video_manager::record_frame()
 		{
 			mng_info_t &mng_info = m_mngs[index];
 
-			// loop until we hit the right time
-			while (mng_info.m_mng_next_frame_time <= curtime)
+			// if a queued write failed, stop the recording
+			if (mng_info.m_failed)
+			{
+				end_recording_mng(index);
+			}
+			else if (mng_info.m_mng_next_frame_time <= curtime)
 			{
-				// set up the text fields in the movie info
-				png_info pnginfo;
-				if (mng_info.m_mng_frame == 0)
+				// set up the text fields for the first frame
+				bool firstframe = (mng_info.m_mng_frame == 0);
+				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
+
+				// count the frames due and advance time
+				int frames = 0;
+				while (mng_info.m_mng_next_frame_time <= curtime)
 				{
-					std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
-					std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
-					pnginfo.add_text("Software", text1.c_str());
-					pnginfo.add_text("System", text2.c_str());
+					mng_info.m_mng_next_frame_time += mng_info.m_mng_frame_period;
+					mng_info.m_mng_frame++;
+					frames++;
 				}
 
-				// write the next frame
+				// copy the bitmap and palette for the background writer
+				std::shared_ptr<bitmap_rgb32> bitmap = clone_snap_bitmap(m_snap_bitmap);
 				screen_device *screen = iter.current();
-				const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-				int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-				png_error error = mng_capture_frame(*mng_info.m_mng_file, pnginfo, m_snap_bitmap, entries, palette);
-				if (error != PNGERR_NONE)
+				std::shared_ptr<std::vector<rgb_t> > palette;
+				if (screen != nullptr && screen->has_palette())
 				{
-					g_profiler.stop(); // FIXME: double exit if this happens?
-					end_recording_mng(index);
-					break;
+					const rgb_t *entries = screen->palette().palette()->entry_list_adjusted();
+					palette = std::make_shared<std::vector<rgb_t> >(entries, entries + screen->palette().entries());
 				}
 
-				// advance time
-				mng_info.m_mng_next_frame_time += mng_info.m_mng_frame_period;
-				mng_info.m_mng_frame++;
+				emu_file *file = mng_info.m_mng_file.get();
+				bool *failed = &mng_info.m_failed;
+				m_writer.enqueue([file, bitmap, palette, frames, firstframe, text1, text2, failed]() {
+					for (int frame = 0; frame < frames; frame++)
+					{
+						png_info pnginfo;
+						if (firstframe && frame == 0)
+						{
+							pnginfo.add_text("Software", text1.c_str());
+							pnginfo.add_text("System", text2.c_str());
+						}
+
+						png_error error = mng_capture_frame(*file, pnginfo, *bitmap,
+								palette ? palette->size() : 0, palette ? &(*palette)[0] : nullptr);
+						if (error != PNGERR_NONE)
+						{
+							*failed = true;
+							break;
+						}
+					}
+				});
 			}
 		}
 
@@ -19,6 +19,13 @@
 
 #include "aviio.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -35,6 +42,38 @@ constexpr int MAX_FRAMESKIP = FRAMESKIP_LEVELS - 2;
 //**************************************************************************
 
 class WebMEncoder;
+
+// ======================> async_writer
+
+// Single background worker with a bounded job queue that takes
+// compression and file writes for snapshots, movie recording, and state
+// saves off the emulation thread.  A single worker keeps jobs touching
+// the same file in submission order.
+class async_writer
+{
+public:
+	async_writer();
+	~async_writer();
+
+	// queue a job; blocks only when the queue is full, so a slow disk
+	// applies backpressure instead of growing memory without bound
+	void enqueue(std::function<void()> &&job);
+
+	// wait until every queued job has completed
+	void flush();
+
+private:
+	static const int MAX_QUEUED_JOBS = 64;
+
+	std::deque<std::function<void()> > m_jobs;
+	std::mutex m_mutex;
+	std::condition_variable m_worker_wake;
+	std::condition_variable m_producer_wake;
+	bool m_exiting;
+	int m_running;
+	std::thread m_thread;
+};
+
 // ======================> video_manager
 
 class video_manager
@@ -59,9 +98,14 @@ public:
 	int speed_factor() const { return m_speed; }
 	int frameskip() const { return m_auto_frameskip ? -1 : m_frameskip_level; }
 	bool throttled() const { return m_throttled; }
+
+	// input latency probe
+	bool latency_probe_enabled() const { return m_latency_probe; }
+	void latency_input_edge();
 	float throttle_rate() const { return m_throttle_rate; }
 	bool fastforward() const { return m_fastforward; }
 	bool is_recording() const;
+	async_writer &writer() { return m_writer; }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -84,6 +128,11 @@ public:
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
 
+	// frame-budget governor
+	bool governor_enabled() const { return m_governor_enabled; }
+	int governor_stage() const { return m_governor_stage; }
+	std::string governor_text() const;
+
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
 	void save_active_screen_snapshots();
@@ -131,11 +180,25 @@ private:
 	void update_throttle(attotime emutime);
 	osd_ticks_t throttle_until_ticks(osd_ticks_t target_ticks);
 	void update_frameskip();
+	void update_governor();
+	void apply_governor_stage(int stage);
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
 
+	// benchmark helpers
+	void bench_frame_update();
+	void bench_write_json();
+	void bench_append_report();
+
+	// frame pacing helpers
+	void pacing_record(osd_ticks_t emulate_done, osd_ticks_t throttle_done, osd_ticks_t present_done);
+	void latency_report();
+	osd_ticks_t pacing_present_latency() const { return m_pacing_present_avg; }
+	std::string pacing_text();
+
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
+	void queue_snapshot_write(screen_device *screen, std::shared_ptr<emu_file> file);
 	void record_frame();
 
 	// internal state
@@ -167,6 +230,7 @@ private:
 	float               m_throttle_rate;            // target rate for throttling
 	bool                m_fastforward;              // flag: true if we're currently fast-forwarding
 	u32                 m_seconds_to_run;           // number of seconds to run before quitting
+	u32                 m_frames_to_run;            // number of frames to run before quitting (0 = disabled)
 	bool                m_auto_frameskip;           // flag: true if we're automatically frameskipping
 	u32                 m_speed;                    // overall speed (*1000)
 
@@ -178,6 +242,37 @@ private:
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// frame-budget governor
+	static constexpr int GOVERNOR_STAGE_MAX = 4;    // artwork shedding is the last resort
+	bool                m_governor_enabled;         // flag: true if ranked degradations are allowed
+	int                 m_governor_stage;           // current degradation stage (0 = full fidelity)
+	s32                 m_governor_adjust;          // hysteresis accumulator (negative = escalate)
+
+	// benchmark statistics (only maintained when frames_to_run is set)
+	u32                 m_frames_run;               // frames counted so far
+	osd_ticks_t         m_bench_last_ticks;         // real time at the previous counted frame
+	u32                 m_bench_histogram[32];      // frame wall times, power-of-two microsecond buckets
+
+	// frame pacing telemetry (only maintained when -frame_pacing is on)
+	struct pacing_record_t
+	{
+		osd_ticks_t     emulate_done;               // emulation finished for the frame
+		osd_ticks_t     throttle_done;              // throttle released the frame
+		osd_ticks_t     present_done;               // OSD update (presentation) returned
+	};
+	static constexpr u32 PACING_FRAMES = 128;       // ring size for percentile computation
+
+	bool                m_pacing_enabled;           // record pacing telemetry?
+	u32                 m_pacing_count;             // frames recorded (monotonic)
+	pacing_record_t     m_pacing_ring[PACING_FRAMES]; // most recent frame timestamps
+
+	// input latency probe state
+	bool                m_latency_probe;            // latency probe enabled?
+	bool                m_latency_marker;           // current corner marker state
+	osd_ticks_t         m_latency_edge_time;        // earliest unpresented input edge (0 = none)
+	u32                 m_latency_histogram[32];    // input-to-present times, power-of-two microsecond buckets
+	osd_ticks_t         m_pacing_present_avg;       // EMA of presentation cost in ticks
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
@@ -192,12 +287,14 @@ private:
 		mng_info_t()
 			: m_mng_frame_period(attotime::zero)
 			, m_mng_next_frame_time(attotime::zero)
-			, m_mng_frame(0) { }
+			, m_mng_frame(0)
+			, m_failed(false) { }
 
 		std::unique_ptr<emu_file> m_mng_file;              // handle to the open movie file
 		attotime            m_mng_frame_period;         // period of a single movie frame
 		attotime            m_mng_next_frame_time;      // time of next frame
 		u32                 m_mng_frame;                // current movie frame number
+		bool                m_failed;                   // set by the write worker on error
 	};
 	std::vector<mng_info_t> m_mngs;
 
@@ -209,12 +306,14 @@ private:
 			: m_avi_file(nullptr)
 			, m_avi_frame_period(attotime::zero)
 			, m_avi_next_frame_time(attotime::zero)
-			, m_avi_frame(0) { }
+			, m_avi_frame(0)
+			, m_failed(false) { }
 
 		avi_file::ptr       m_avi_file;                 // handle to the open movie file
 		attotime            m_avi_frame_period;         // period of a single movie frame
 		attotime            m_avi_next_frame_time;      // time of next frame
 		u32                 m_avi_frame;                // current movie frame number
+		bool                m_failed;                   // set by the write worker on error
 	};
 	std::vector<avi_info_t> m_avis;
 
@@ -222,6 +321,9 @@ private:
 	// movie recording - dummy
 	bool                m_dummy_recording;          // indicates if snapshot should be created of every frame
 
+	// background compression/IO pipeline shared with state saves
+	async_writer        m_writer;
+
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
 	static const int PAUSED_REFRESH_RATE = 30;
 
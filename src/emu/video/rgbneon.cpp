@@ -0,0 +1,47 @@
+// license:BSD-3-Clause
+// copyright-holders:Vas Crabb, Ryan Holtz
+/***************************************************************************
+
+    rgbneon.cpp
+
+    ARM NEON optimised RGB utilities.
+
+***************************************************************************/
+
+#if defined(__ARM_NEON) && !((!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)) && !defined(__ALTIVEC__)
+
+#include "emu.h"
+#include "rgbneon.h"
+
+/***************************************************************************
+    HIGHER LEVEL OPERATIONS
+***************************************************************************/
+
+void rgbaint_t::blend(const rgbaint_t& other, u8 factor)
+{
+	const s32 scale1 = s32(factor);
+	const s32 scale2 = 256 - scale1;
+
+	rgbaint_t scaled_other(other);
+	scaled_other.mul_imm(scale2);
+
+	mul_imm(scale1);
+	add(scaled_other);
+	sra_imm(8);
+}
+
+void rgbaint_t::scale_and_clamp(const rgbaint_t& scale)
+{
+	mul(scale);
+	sra_imm(8);
+	clamp_to_uint8();
+}
+
+void rgbaint_t::scale_imm_and_clamp(const s32 scale)
+{
+	mul_imm(scale);
+	sra_imm(8);
+	clamp_to_uint8();
+}
+
+#endif // defined(__ARM_NEON)
@@ -16,6 +16,8 @@
 #if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
 
 #include "rgbsse.h"
+#elif defined(__ARM_NEON)
+#include "rgbneon.h"
 #elif defined(__ALTIVEC__)
 #include "rgbvmx.h"
 #else
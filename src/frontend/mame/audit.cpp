@@ -17,6 +17,198 @@
 #include "sound/samples.h"
 #include "softlist_dev.h"
 
+#include <cinttypes>
+#include <mutex>
+#include <unordered_map>
+
+
+//**************************************************************************
+//  PERSISTENT HASH CACHE
+//**************************************************************************
+
+namespace {
+
+// cache of verified hashes persisted across runs so repeat audits don't
+// re-hash unchanged files; keyed by the full path of the audited file plus
+// the member name, and validated against the size and modification time of
+// the physical file (the archive itself for archive members)
+class audit_hash_cache
+{
+public:
+	static audit_hash_cache &instance()
+	{
+		static audit_hash_cache s_instance;
+		return s_instance;
+	}
+
+	// make a cache key from the path of an opened file and the item name
+	static std::string make_key(const char *fullpath, const char *name)
+	{
+		return util::string_format("%s|%s", fullpath, name);
+	}
+
+	bool lookup(emu_options &options, const std::string &key, const char *validation, util::hash_collection &hashes)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		load(options);
+
+		auto const iter = m_entries.find(key);
+		if (iter == m_entries.end())
+			return false;
+
+		// the cached hashes must cover every type being validated
+		for (const char *type = validation; *type != 0; type++)
+			if (iter->second.types.find(*type) == std::string::npos)
+				return false;
+
+		// toss the entry if the physical file has been touched
+		std::uint64_t size;
+		std::int64_t mtime;
+		if (!stat_physical(key, size, mtime) || (size != iter->second.size) || (mtime != iter->second.mtime))
+		{
+			m_entries.erase(iter);
+			m_dirty = true;
+			return false;
+		}
+
+		return hashes.from_internal_string(iter->second.hashes.c_str());
+	}
+
+	void add(emu_options &options, const std::string &key, const util::hash_collection &hashes)
+	{
+		std::string const types(hashes.hash_types());
+		if (types.empty())
+			return;
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		// if we can't stat the physical file we can't invalidate, so don't cache
+		std::uint64_t size;
+		std::int64_t mtime;
+		if (!stat_physical(key, size, mtime))
+			return;
+
+		load(options);
+		entry &newentry = m_entries[key];
+		newentry.size = size;
+		newentry.mtime = mtime;
+		newentry.types = types;
+		newentry.hashes = hashes.internal_string();
+		m_dirty = true;
+
+		// checkpoint periodically so a long library scan survives interruption
+		if (++m_unsaved >= 5000)
+			save_locked(options);
+	}
+
+	void save(emu_options &options)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		save_locked(options);
+	}
+
+private:
+	struct entry
+	{
+		std::uint64_t   size;       // size of the physical file when hashed
+		std::int64_t    mtime;      // modification time of the physical file when hashed
+		std::string     types;      // hash types present (see hash_collection)
+		std::string     hashes;     // internal string representation of the hashes
+	};
+
+	static constexpr char CACHE_FILENAME[] = "audit.cache";
+
+	audit_hash_cache() : m_loaded(false), m_dirty(false), m_unsaved(0) { }
+
+	// stat the physical file behind a cache key, trying archive extensions
+	// the way emu_file does; results are memoized for the process lifetime
+	bool stat_physical(const std::string &key, std::uint64_t &size, std::int64_t &mtime)
+	{
+		std::string const path(key, 0, key.rfind('|'));
+
+		auto const memo = m_statcache.find(path);
+		if (memo != m_statcache.end())
+		{
+			size = memo->second.first;
+			mtime = memo->second.second;
+			return true;
+		}
+
+		auto stat = osd_stat(path);
+		if (!stat) stat = osd_stat(path + ".zip");
+		if (!stat) stat = osd_stat(path + ".7z");
+		if (!stat)
+			return false;
+
+		size = stat->size;
+		mtime = std::int64_t(std::chrono::system_clock::to_time_t(stat->last_modified));
+		m_statcache.emplace(path, std::make_pair(size, mtime));
+		return true;
+	}
+
+	// load the cache file the first time through (call with the lock held)
+	void load(emu_options &options)
+	{
+		if (m_loaded)
+			return;
+		m_loaded = true;
+
+		emu_file file(options.cfg_directory(), OPEN_FLAG_READ);
+		if (file.open(CACHE_FILENAME) != osd_file::error::NONE)
+			return;
+
+		char line[1024];
+		while (file.gets(line, ARRAY_LENGTH(line)) != nullptr)
+		{
+			entry newentry;
+			char types[16];
+			char hashstring[256];
+			int keypos = 0;
+			if (sscanf(line, "%" SCNu64 " %" SCNd64 " %15s %255s %n", &newentry.size, &newentry.mtime, types, hashstring, &keypos) != 4 || keypos == 0)
+				continue;
+
+			// the key runs to the end of the line
+			std::string key(&line[keypos]);
+			while (!key.empty() && ((key.back() == '\n') || (key.back() == '\r')))
+				key.pop_back();
+			if (key.empty())
+				continue;
+
+			newentry.types = types;
+			newentry.hashes = hashstring;
+			m_entries.emplace(std::move(key), std::move(newentry));
+		}
+		osd_printf_verbose("audit: loaded %d cached hashes from %s\n", int(m_entries.size()), CACHE_FILENAME);
+	}
+
+	// write the cache back out if anything changed (call with the lock held)
+	void save_locked(emu_options &options)
+	{
+		if (!m_dirty)
+			return;
+
+		emu_file file(options.cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(CACHE_FILENAME) != osd_file::error::NONE)
+			return;
+
+		for (auto const &pair : m_entries)
+			file.printf("%" PRIu64 " %" PRId64 " %s %s %s\n", pair.second.size, pair.second.mtime, pair.second.types.c_str(), pair.second.hashes.c_str(), pair.first.c_str());
+		m_dirty = false;
+		m_unsaved = 0;
+	}
+
+	std::mutex                                      m_mutex;
+	std::unordered_map<std::string, entry>          m_entries;
+	std::unordered_map<std::string, std::pair<std::uint64_t, std::int64_t> > m_statcache;
+	bool                                            m_loaded;
+	bool                                            m_dirty;
+	int                                             m_unsaved;
+};
+
+constexpr char audit_hash_cache::CACHE_FILENAME[];
+
+} // anonymous namespace
+
 
 //**************************************************************************
 //  CORE FUNCTIONS
@@ -34,6 +226,17 @@ media_auditor::media_auditor(const driver_enumerator &enumerator)
 }
 
 
+//-------------------------------------------------
+//  ~media_auditor - destructor
+//-------------------------------------------------
+
+media_auditor::~media_auditor()
+{
+	// push any newly-computed hashes out to the persistent cache
+	audit_hash_cache::instance().save(m_enumerator.options());
+}
+
+
 //-------------------------------------------------
 //  audit_media - audit the media described by the
 //  currently-enumerated driver
@@ -404,7 +607,20 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const rom_entry *rom)
 		// if it worked, get the actual length and hashes, then stop
 		if (filerr == osd_file::error::NONE)
 		{
-			record.set_actual(file.hashes(m_validation), file.size());
+			// consult the persistent cache before hashing the file
+			audit_hash_cache &cache = audit_hash_cache::instance();
+			std::string const cachekey(audit_hash_cache::make_key(file.fullpath(), record.name()));
+			util::hash_collection cached;
+			if (cache.lookup(m_enumerator.options(), cachekey, m_validation, cached))
+			{
+				record.set_actual(std::move(cached), file.size());
+			}
+			else
+			{
+				util::hash_collection const &hashes = file.hashes(m_validation);
+				record.set_actual(hashes, file.size());
+				cache.add(m_enumerator.options(), cachekey, hashes);
+			}
 			break;
 		}
 	}
@@ -151,6 +151,7 @@ public:
 
 	// construction/destruction
 	media_auditor(const driver_enumerator &enumerator);
+	~media_auditor();
 
 	// getters
 	const record_list &records() const { return m_record_list; }
@@ -23,17 +23,57 @@
 #include "softlist_dev.h"
 #include "speaker.h"
 
-#include "xmlfile.h"
+#include "vecstream.h"
 
 #include <ctype.h>
+#include <atomic>
 #include <cstring>
 #include <map>
+#include <mutex>
+#include <thread>
 
 
 #define XML_ROOT    "mame"
 #define XML_TOP     "machine"
 
 
+//**************************************************************************
+//  ANONYMOUS NAMESPACE PROTOTYPES
+//**************************************************************************
+
+namespace {
+
+//-------------------------------------------------
+//  normalize_string - escape a string for XML;
+//  unlike util::xml::normalize_string this has no
+//  shared static buffer, so machine XML can be
+//  built on several threads at once
+//-------------------------------------------------
+
+std::string normalize_string(const char *string)
+{
+	std::string result;
+	if (string != nullptr)
+	{
+		result.reserve(strlen(string));
+		for ( ; *string; ++string)
+		{
+			switch (*string)
+			{
+			case '\"': result.append("&quot;"); break;
+			case '&':  result.append("&amp;"); break;
+			case '<':  result.append("&lt;"); break;
+			case '>':  result.append("&gt;"); break;
+			default:   result.append(1, *string);
+			}
+		}
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -218,9 +258,9 @@ info_xml_creator::info_xml_creator(emu_options const &options, bool dtd)
 //  for all known games
 //-------------------------------------------------
 
-void info_xml_creator::output(FILE *out, std::vector<std::string> const &patterns)
+void info_xml_creator::output(std::ostream &out, std::vector<std::string> const &patterns)
 {
-	m_output = out;
+	m_output = &out;
 
 	std::unique_ptr<device_type_set> devfilter(patterns.empty() ? nullptr : new device_type_set);
 
@@ -252,18 +292,13 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 		return result;
 	};
 
-	// iterate through the drivers, outputting one at a time
-	bool first = true;
+	// determine which drivers need to be emitted
+	std::vector<int> indices;
 	while (drivlist.next())
 	{
 		if (included(drivlist.driver().name))
 		{
-			if (first)
-			{
-				output_header();
-				first = false;
-			}
-			output_one(drivlist, devfilter.get());
+			indices.push_back(drivlist.current());
 
 			// stop looking if we found everything specified
 			if (!patterns.empty() && exact_matches == patterns.size())
@@ -271,6 +306,72 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 		}
 	}
 
+	bool first = true;
+	if (!indices.empty())
+	{
+		output_header();
+		first = false;
+
+		// instantiate machine configurations and build the XML on a pool of
+		// worker threads, each with its own enumerator and scratch buffer,
+		// then stitch the results back together in driver order
+		std::vector<std::string> results(indices.size());
+		std::atomic<std::size_t> nextjob(0);
+		std::mutex devmutex;
+		std::exception_ptr exception;
+		auto const worker =
+				[this, &indices, &results, &nextjob, &devmutex, &exception, devfilter = devfilter.get()] ()
+				{
+					try
+					{
+						driver_enumerator enumerator(m_lookup_options);
+						info_xml_creator creator(m_lookup_options, false);
+						device_type_set localdevs;
+						util::ovectorstream buffer;
+						buffer.reserve(65536);
+						while (1)
+						{
+							std::size_t const job = nextjob++;
+							if (job >= indices.size())
+								break;
+							buffer.clear();
+							buffer.seekp(0);
+							creator.m_output = &buffer;
+							enumerator.set_current(indices[job]);
+							creator.output_one(enumerator, devfilter ? &localdevs : nullptr);
+							buffer.put('\0');
+							results[job].assign(&buffer.vec()[0]);
+						}
+						if (devfilter && !localdevs.empty())
+						{
+							std::lock_guard<std::mutex> guard(devmutex);
+							devfilter->insert(localdevs.begin(), localdevs.end());
+						}
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> guard(devmutex);
+						if (!exception)
+							exception = std::current_exception();
+					}
+				};
+
+		std::size_t const threadcount((std::min<std::size_t>)((std::max)(std::thread::hardware_concurrency(), 1U), indices.size()));
+		std::vector<std::thread> threads;
+		threads.reserve(threadcount - 1);
+		for (std::size_t threadnum = 1; threadnum < threadcount; threadnum++)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread &thread : threads)
+			thread.join();
+		if (exception)
+			std::rethrow_exception(exception);
+
+		// write the per-driver XML out in order
+		for (std::string const &result : results)
+			*m_output << result;
+	}
+
 	// iterate through the device types if not everything matches a driver
 	if (!patterns.empty() && exact_matches != patterns.size())
 	{
@@ -316,9 +417,9 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 //  for a subset of games
 //-------------------------------------------------
 
-void info_xml_creator::output(FILE *out, driver_enumerator &drivlist, bool nodevices)
+void info_xml_creator::output(std::ostream &out, driver_enumerator &drivlist, bool nodevices)
 {
-	m_output = out;
+	m_output = &out;
 
 	device_type_set devfilter;
 
@@ -346,16 +447,16 @@ void info_xml_creator::output_header()
 	if (m_dtd)
 	{
 		// output the DTD
-		fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+		util::stream_format(*m_output, "<?xml version=\"1.0\"?>\n");
 		std::string dtd(s_dtd_string);
 		strreplace(dtd, "__XML_ROOT__", XML_ROOT);
 		strreplace(dtd, "__XML_TOP__", XML_TOP);
 
-		fprintf(m_output, "%s\n\n", dtd.c_str());
+		util::stream_format(*m_output, "%s\n\n", dtd.c_str());
 	}
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	util::stream_format(*m_output, "<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 			"yes"
 #else
@@ -363,7 +464,7 @@ void info_xml_creator::output_header()
 #endif
 			"\" mameconfig=\"%d\">\n",
 			XML_ROOT,
-			util::xml::normalize_string(emulator_info::get_build_version()),
+			normalize_string(emulator_info::get_build_version()),
 			CONFIG_VERSION);
 }
 
@@ -375,7 +476,7 @@ void info_xml_creator::output_header()
 void info_xml_creator::output_footer()
 {
 	// close the top level tag
-	fprintf(m_output, "</%s>\n", XML_ROOT);
+	util::stream_format(*m_output, "</%s>\n", XML_ROOT);
 }
 
 
@@ -435,43 +536,43 @@ void info_xml_creator::output_one(driver_enumerator &drivlist, device_type_set *
 	}
 
 	// print the header and the machine name
-	fprintf(m_output, "\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(driver.name));
+	util::stream_format(*m_output, "\t<%s name=\"%s\"", XML_TOP, normalize_string(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.type.source(), '/');
 	if (!start)
 		start = strrchr(driver.type.source(), '\\');
 	start = start ? (start + 1) : driver.type.source();
-	fprintf(m_output, " sourcefile=\"%s\"", util::xml::normalize_string(start));
+	util::stream_format(*m_output, " sourcefile=\"%s\"", normalize_string(start));
 
 	// append bios and runnable flags
 	if (driver.flags & machine_flags::IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		util::stream_format(*m_output, " isbios=\"yes\"");
 	if (driver.flags & machine_flags::MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		util::stream_format(*m_output, " ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = drivlist.find(driver.parent);
 	if (clone_of != -1 && !(drivlist.driver(clone_of).flags & machine_flags::IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", util::xml::normalize_string(drivlist.driver(clone_of).name));
+		util::stream_format(*m_output, " cloneof=\"%s\"", normalize_string(drivlist.driver(clone_of).name));
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", util::xml::normalize_string(drivlist.driver(clone_of).name));
+		util::stream_format(*m_output, " romof=\"%s\"", normalize_string(drivlist.driver(clone_of).name));
 
 	// display sample information and close the game tag
 	output_sampleof(config->root_device());
-	fprintf(m_output, ">\n");
+	util::stream_format(*m_output, ">\n");
 
 	// output game description
 	if (driver.type.fullname() != nullptr)
-		fprintf(m_output, "\t\t<description>%s</description>\n", util::xml::normalize_string(driver.type.fullname()));
+		util::stream_format(*m_output, "\t\t<description>%s</description>\n", normalize_string(driver.type.fullname()));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != nullptr && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", util::xml::normalize_string(driver.year));
+		util::stream_format(*m_output, "\t\t<year>%s</year>\n", normalize_string(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != nullptr)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", util::xml::normalize_string(driver.manufacturer));
+		util::stream_format(*m_output, "\t\t<manufacturer>%s</manufacturer>\n", normalize_string(driver.manufacturer));
 
 	// now print various additional information
 	output_bios(config->root_device());
@@ -494,7 +595,7 @@ void info_xml_creator::output_one(driver_enumerator &drivlist, device_type_set *
 	output_ramoptions(config->root_device());
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	util::stream_format(*m_output, "\t</%s>\n", XML_TOP);
 }
 
 
@@ -533,12 +634,12 @@ void info_xml_creator::output_one_device(machine_config &config, device_t &devic
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(device.shortname()));
+	util::stream_format(*m_output, "\t<%s name=\"%s\"", XML_TOP, normalize_string(device.shortname()));
 	std::string src(device.source());
 	strreplace(src,"../", "");
-	fprintf(m_output, " sourcefile=\"%s\" isdevice=\"yes\" runnable=\"no\"", util::xml::normalize_string(src.c_str()));
+	util::stream_format(*m_output, " sourcefile=\"%s\" isdevice=\"yes\" runnable=\"no\"", normalize_string(src.c_str()));
 	output_sampleof(device);
-	fprintf(m_output, ">\n\t\t<description>%s</description>\n", util::xml::normalize_string(device.name()));
+	util::stream_format(*m_output, ">\n\t\t<description>%s</description>\n", normalize_string(device.name()));
 
 	output_bios(device);
 	output_rom(nullptr, device);
@@ -559,7 +660,7 @@ void info_xml_creator::output_one_device(machine_config &config, device_t &devic
 	output_features(device.type(), overall_unemulated, overall_imperfect);
 	output_images(device, devtag);
 	output_slots(config, device, devtag, nullptr);
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	util::stream_format(*m_output, "\t</%s>\n", XML_TOP);
 }
 
 
@@ -614,7 +715,7 @@ void info_xml_creator::output_device_refs(device_t &root)
 {
 	for (device_t &device : device_iterator(root))
 		if (&device != &root)
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", util::xml::normalize_string(device.shortname()));
+			util::stream_format(*m_output, "\t\t<device_ref name=\"%s\"/>\n", normalize_string(device.shortname()));
 }
 
 
@@ -631,7 +732,7 @@ void info_xml_creator::output_sampleof(device_t &device)
 		samples_iterator sampiter(samples);
 		if (sampiter.altbasename() != nullptr)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", util::xml::normalize_string(sampiter.altbasename()));
+			util::stream_format(*m_output, " sampleof=\"%s\"", normalize_string(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -658,12 +759,12 @@ void info_xml_creator::output_bios(device_t const &device)
 	for (romload::system_bios const &bios : romload::entries(device.rom_region()).get_system_bioses())
 	{
 		// output extracted name and descriptions
-		fprintf(m_output, "\t\t<biosset");
-		fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(bios.get_name()));
-		fprintf(m_output, " description=\"%s\"", util::xml::normalize_string(bios.get_description()));
+		util::stream_format(*m_output, "\t\t<biosset");
+		util::stream_format(*m_output, " name=\"%s\"", normalize_string(bios.get_name()));
+		util::stream_format(*m_output, " description=\"%s\"", normalize_string(bios.get_description()));
 		if (defaultname && !std::strcmp(defaultname, bios.get_name()))
-			fprintf(m_output, " default=\"yes\"");
-		fprintf(m_output, "/>\n");
+			util::stream_format(*m_output, " default=\"yes\"");
+		util::stream_format(*m_output, "/>\n");
 	}
 }
 
@@ -756,44 +857,44 @@ void info_xml_creator::output_rom(driver_enumerator *drivlist, device_t &device)
 			char const *const merge_name((do_merge_name && !hashes.flag(util::hash_collection::FLAG_NO_DUMP)) ? get_merge_name(*drivlist, hashes) : nullptr);
 
 			// opening tag
-			fprintf(m_output, is_disk ? "\t\t<disk" : "\t\t<rom");
+			util::stream_format(*m_output, is_disk ? "\t\t<disk" : "\t\t<rom");
 
 			// add name, merge, bios, and size tags */
 			char const *const name(rom->name);
 			if (name && name[0])
-				fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(name));
+				util::stream_format(*m_output, " name=\"%s\"", normalize_string(name));
 			if (merge_name)
-				fprintf(m_output, " merge=\"%s\"", util::xml::normalize_string(merge_name));
+				util::stream_format(*m_output, " merge=\"%s\"", normalize_string(merge_name));
 			if (bios_name)
-				fprintf(m_output, " bios=\"%s\"", util::xml::normalize_string(bios_name));
+				util::stream_format(*m_output, " bios=\"%s\"", normalize_string(bios_name));
 			if (!is_disk)
-				fprintf(m_output, " size=\"%u\"", rom_file_size(rom));
+				util::stream_format(*m_output, " size=\"%u\"", rom_file_size(rom));
 
 			// dump checksum information only if there is a known dump
 			if (!hashes.flag(util::hash_collection::FLAG_NO_DUMP))
-				fprintf(m_output, " %s", hashes.attribute_string().c_str()); // iterate over hash function types and print m_output their values
+				util::stream_format(*m_output, " %s", hashes.attribute_string().c_str()); // iterate over hash function types and print m_output their values
 			else
-				fprintf(m_output, " status=\"nodump\"");
+				util::stream_format(*m_output, " status=\"nodump\"");
 
 			// append a region name
-			fprintf(m_output, " region=\"%s\"", region->name);
+			util::stream_format(*m_output, " region=\"%s\"", region->name);
 
 			if (!is_disk)
 			{
 				// for non-disk entries, print offset
-				fprintf(m_output, " offset=\"%x\"", ROM_GETOFFSET(rom));
+				util::stream_format(*m_output, " offset=\"%x\"", ROM_GETOFFSET(rom));
 			}
 			else
 			{
 				// for disk entries, add the disk index
-				fprintf(m_output, " index=\"%x\" writable=\"%s\"", DISK_GETINDEX(rom), DISK_ISREADONLY(rom) ? "no" : "yes");
+				util::stream_format(*m_output, " index=\"%x\" writable=\"%s\"", DISK_GETINDEX(rom), DISK_ISREADONLY(rom) ? "no" : "yes");
 			}
 
 			// add optional flag
 			if (ROM_ISOPTIONAL(rom))
-				fprintf(m_output, " optional=\"yes\"");
+				util::stream_format(*m_output, " optional=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			util::stream_format(*m_output, "/>\n");
 		}
 		bios_scanned = true;
 	}
@@ -819,7 +920,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", util::xml::normalize_string(samplename));
+			util::stream_format(*m_output, "\t\t<sample name=\"%s\"/>\n", normalize_string(samplename));
 		}
 	}
 }
@@ -840,12 +941,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(exec.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(exec.device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec.device().clock());
-			fprintf(m_output, "/>\n");
+			util::stream_format(*m_output, "\t\t<chip");
+			util::stream_format(*m_output, " type=\"cpu\"");
+			util::stream_format(*m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
+			util::stream_format(*m_output, " name=\"%s\"", normalize_string(exec.device().name()));
+			util::stream_format(*m_output, " clock=\"%d\"", exec.device().clock());
+			util::stream_format(*m_output, "/>\n");
 		}
 	}
 
@@ -857,13 +958,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(sound.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(sound.device().name()));
+			util::stream_format(*m_output, "\t\t<chip");
+			util::stream_format(*m_output, " type=\"audio\"");
+			util::stream_format(*m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
+			util::stream_format(*m_output, " name=\"%s\"", normalize_string(sound.device().name()));
 			if (sound.device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound.device().clock());
-			fprintf(m_output, "/>\n");
+				util::stream_format(*m_output, " clock=\"%d\"", sound.device().clock());
+			util::stream_format(*m_output, "/>\n");
 		}
 	}
 }
@@ -884,43 +985,43 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			std::string newtag(screendev.tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<display tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
+			util::stream_format(*m_output, "\t\t<display tag=\"%s\"", normalize_string(newtag.c_str()));
 
 			switch (screendev.screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				case SCREEN_TYPE_SVG:       fprintf(m_output, " type=\"svg\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    util::stream_format(*m_output, " type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    util::stream_format(*m_output, " type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       util::stream_format(*m_output, " type=\"lcd\"");     break;
+				case SCREEN_TYPE_SVG:       util::stream_format(*m_output, " type=\"svg\"");     break;
+				default:                    util::stream_format(*m_output, " type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (screendev.orientation())
 			{
 			case ORIENTATION_FLIP_X:
-				fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+				util::stream_format(*m_output, " rotate=\"0\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+				util::stream_format(*m_output, " rotate=\"180\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"180\"");
+				util::stream_format(*m_output, " rotate=\"180\"");
 				break;
 			case ORIENTATION_SWAP_XY:
-				fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+				util::stream_format(*m_output, " rotate=\"90\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-				fprintf(m_output, " rotate=\"90\"");
+				util::stream_format(*m_output, " rotate=\"90\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"270\"");
+				util::stream_format(*m_output, " rotate=\"270\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+				util::stream_format(*m_output, " rotate=\"270\" flipx=\"yes\"");
 				break;
 			default:
-				fprintf(m_output, " rotate=\"0\"");
+				util::stream_format(*m_output, " rotate=\"0\"");
 				break;
 			}
 
@@ -928,12 +1029,12 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			if (screendev.screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev.visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				util::stream_format(*m_output, " width=\"%d\"", visarea.width());
+				util::stream_format(*m_output, " height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
+			util::stream_format(*m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -941,15 +1042,15 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			{
 				int pixclock = screendev.width() * screendev.height() * ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev.width());
-				fprintf(m_output, " hbend=\"%d\"", screendev.visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev.visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev.height());
-				fprintf(m_output, " vbend=\"%d\"", screendev.visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev.visible_area().max_y+1);
+				util::stream_format(*m_output, " pixclock=\"%d\"", pixclock);
+				util::stream_format(*m_output, " htotal=\"%d\"", screendev.width());
+				util::stream_format(*m_output, " hbend=\"%d\"", screendev.visible_area().min_x);
+				util::stream_format(*m_output, " hbstart=\"%d\"", screendev.visible_area().max_x+1);
+				util::stream_format(*m_output, " vtotal=\"%d\"", screendev.height());
+				util::stream_format(*m_output, " vbend=\"%d\"", screendev.visible_area().min_y);
+				util::stream_format(*m_output, " vbstart=\"%d\"", screendev.visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			util::stream_format(*m_output, " />\n");
 		}
 	}
 }
@@ -970,7 +1071,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == nullptr)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	util::stream_format(*m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -982,7 +1083,7 @@ void info_xml_creator::output_sound(device_t &device)
 void info_xml_creator::output_ioport_condition(const ioport_condition &condition, unsigned indent)
 {
 	for (unsigned i = 0; indent > i; ++i)
-		fprintf(m_output, "\t");
+		util::stream_format(*m_output, "\t");
 
 	char const *rel(nullptr);
 	switch (condition.condition())
@@ -996,7 +1097,7 @@ void info_xml_creator::output_ioport_condition(const ioport_condition &condition
 	case ioport_condition::NOTLESSTHAN:     rel = "ge"; break;
 	}
 
-	fprintf(m_output,"<condition tag=\"%s\" mask=\"%u\" relation=\"%s\" value=\"%u\"/>\n", util::xml::normalize_string(condition.tag()), condition.mask(), rel, condition.value());
+	util::stream_format(*m_output,"<condition tag=\"%s\" mask=\"%u\" relation=\"%s\" value=\"%u\"/>\n", normalize_string(condition.tag()), condition.mask(), rel, condition.value());
 }
 
 //-------------------------------------------------
@@ -1398,15 +1499,15 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 
 	// Output the input info
 	// First basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	util::stream_format(*m_output, "\t\t<input");
+	util::stream_format(*m_output, " players=\"%d\"", nplayer);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		util::stream_format(*m_output, " coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		util::stream_format(*m_output, " service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		util::stream_format(*m_output, " tilt=\"yes\"");
+	util::stream_format(*m_output, ">\n");
 
 	// Then controller specific ones
 	for (auto & elem : control_info)
@@ -1415,25 +1516,25 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 			//printf("type %s - player %d - buttons %d\n", elem.type, elem.player, elem.nbuttons);
 			if (elem.analog)
 			{
-				fprintf(m_output, "\t\t\t<control type=\"%s\"", util::xml::normalize_string(elem.type));
+				util::stream_format(*m_output, "\t\t\t<control type=\"%s\"", normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					util::stream_format(*m_output, " player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
+					util::stream_format(*m_output, " buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						util::stream_format(*m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				if (elem.min != 0 || elem.max != 0)
-					fprintf(m_output, " minimum=\"%d\" maximum=\"%d\"", elem.min, elem.max);
+					util::stream_format(*m_output, " minimum=\"%d\" maximum=\"%d\"", elem.min, elem.max);
 				if (elem.sensitivity != 0)
-					fprintf(m_output, " sensitivity=\"%d\"", elem.sensitivity);
+					util::stream_format(*m_output, " sensitivity=\"%d\"", elem.sensitivity);
 				if (elem.keydelta != 0)
-					fprintf(m_output, " keydelta=\"%d\"", elem.keydelta);
+					util::stream_format(*m_output, " keydelta=\"%d\"", elem.keydelta);
 				if (elem.reverse)
-					fprintf(m_output, " reverse=\"yes\"");
+					util::stream_format(*m_output, " reverse=\"yes\"");
 
-				fprintf(m_output, "/>\n");
+				util::stream_format(*m_output, "/>\n");
 			}
 			else
 			{
@@ -1441,14 +1542,14 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 				if (elem.helper[0] == 0 && elem.helper[1] != 0) { elem.helper[0] = elem.helper[1]; elem.helper[1] = 0; }
 				if (elem.helper[1] == 0 && elem.helper[2] != 0) { elem.helper[1] = elem.helper[2]; elem.helper[2] = 0; }
 				const char *joys = (elem.helper[2] != 0) ? "triple" : (elem.helper[1] != 0) ? "double" : "";
-				fprintf(m_output, "\t\t\t<control type=\"%s%s\"", joys, util::xml::normalize_string(elem.type));
+				util::stream_format(*m_output, "\t\t\t<control type=\"%s%s\"", joys, normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					util::stream_format(*m_output, " player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
+					util::stream_format(*m_output, " buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						util::stream_format(*m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				for (int lp = 0; lp < 3 && elem.helper[lp] != 0; lp++)
 				{
@@ -1483,13 +1584,13 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 							ways = "strange2";
 							break;
 					}
-					fprintf(m_output, " ways%s=\"%s\"", plural, ways);
+					util::stream_format(*m_output, " ways%s=\"%s\"", plural, ways);
 				}
-				fprintf(m_output, "/>\n");
+				util::stream_format(*m_output, "/>\n");
 			}
 		}
 
-	fprintf(m_output, "\t\t</input>\n");
+	util::stream_format(*m_output, "\t\t</input>\n");
 }
 
 
@@ -1509,41 +1610,41 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 				// output the switch name information
-				std::string const normalized_field_name(util::xml::normalize_string(field.name()));
-				std::string const normalized_newtag(util::xml::normalize_string(newtag.c_str()));
-				fprintf(m_output, "\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field.mask());
+				std::string const normalized_field_name(normalize_string(field.name()));
+				std::string const normalized_newtag(normalize_string(newtag.c_str()));
+				util::stream_format(*m_output, "\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field.mask());
 				if (!field.condition().none())
 					output_ioport_condition(field.condition(), 3);
 
 				// loop over locations
 				for (ioport_diplocation const &diploc : field.diplocations())
 				{
-					fprintf(m_output, "\t\t\t<%s name=\"%s\" number=\"%u\"", loctag, util::xml::normalize_string(diploc.name()), diploc.number());
+					util::stream_format(*m_output, "\t\t\t<%s name=\"%s\" number=\"%u\"", loctag, normalize_string(diploc.name()), diploc.number());
 					if (diploc.inverted())
-						fprintf(m_output, " inverted=\"yes\"");
-					fprintf(m_output, "/>\n");
+						util::stream_format(*m_output, " inverted=\"yes\"");
+					util::stream_format(*m_output, "/>\n");
 				}
 
 				// loop over settings
 				for (ioport_setting const &setting : field.settings())
 				{
-					fprintf(m_output, "\t\t\t<%s name=\"%s\" value=\"%u\"", innertag, util::xml::normalize_string(setting.name()), setting.value());
+					util::stream_format(*m_output, "\t\t\t<%s name=\"%s\" value=\"%u\"", innertag, normalize_string(setting.name()), setting.value());
 					if (setting.value() == field.defvalue())
-						fprintf(m_output, " default=\"yes\"");
+						util::stream_format(*m_output, " default=\"yes\"");
 					if (setting.condition().none())
 					{
-						fprintf(m_output, "/>\n");
+						util::stream_format(*m_output, "/>\n");
 					}
 					else
 					{
-						fprintf(m_output, ">\n");
+						util::stream_format(*m_output, ">\n");
 						output_ioport_condition(setting.condition(), 4);
-						fprintf(m_output, "\t\t\t</%s>\n", innertag);
+						util::stream_format(*m_output, "\t\t\t</%s>\n", innertag);
 					}
 				}
 
 				// terminate the switch entry
-				fprintf(m_output, "\t\t</%s>\n", outertag);
+				util::stream_format(*m_output, "\t\t</%s>\n", outertag);
 			}
 }
 
@@ -1556,13 +1657,13 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (auto &port : portlist)
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n", util::xml::normalize_string(port.second->tag()));
+		util::stream_format(*m_output,"\t\t<port tag=\"%s\">\n", normalize_string(port.second->tag()));
 		for (ioport_field const &field : port.second->fields())
 		{
 			if (field.is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n", field.mask());
+				util::stream_format(*m_output,"\t\t\t<analog mask=\"%u\"/>\n", field.mask());
 		}
-		fprintf(m_output,"\t\t</port>\n");
+		util::stream_format(*m_output,"\t\t</port>\n");
 	}
 
 }
@@ -1579,7 +1680,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 		for (ioport_field const &field : port.second->fields())
 			if (field.type() == IPT_ADJUSTER)
 			{
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", util::xml::normalize_string(field.name()), field.defvalue());
+				util::stream_format(*m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", normalize_string(field.name()), field.defvalue());
 			}
 }
 
@@ -1590,7 +1691,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver(game_driver const &driver, device_t::feature_type unemulated, device_t::feature_type imperfect)
 {
-	fprintf(m_output, "\t\t<driver");
+	util::stream_format(*m_output, "\t\t<driver");
 
 	/*
 	The status entry is an hint for frontend authors to select working
@@ -1607,26 +1708,26 @@ void info_xml_creator::output_driver(game_driver const &driver, device_t::featur
 	bool const imperfect_preliminary((unemulated | imperfect) & device_t::feature::PROTECTION);
 
 	if (machine_preliminary || unemulated_preliminary || imperfect_preliminary)
-		fprintf(m_output, " status=\"preliminary\"");
+		util::stream_format(*m_output, " status=\"preliminary\"");
 	else if (imperfect)
-		fprintf(m_output, " status=\"imperfect\"");
+		util::stream_format(*m_output, " status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		util::stream_format(*m_output, " status=\"good\"");
 
 	if (flags & machine_flags::NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		util::stream_format(*m_output, " emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		util::stream_format(*m_output, " emulation=\"good\"");
 
 	if (flags & machine_flags::NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		util::stream_format(*m_output, " cocktail=\"preliminary\"");
 
 	if (flags & machine_flags::SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		util::stream_format(*m_output, " savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		util::stream_format(*m_output, " savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	util::stream_format(*m_output, "/>\n");
 }
 
 
@@ -1658,21 +1759,21 @@ void info_xml_creator::output_features(device_type type, device_t::feature_type
 	{
 		if (flags & feature.first)
 		{
-			fprintf(m_output, "\t\t<feature type=\"%s\"", feature.second);
+			util::stream_format(*m_output, "\t\t<feature type=\"%s\"", feature.second);
 			if (type.unemulated_features() & feature.first)
 			{
-				fprintf(m_output, " status=\"unemulated\"");
+				util::stream_format(*m_output, " status=\"unemulated\"");
 			}
 			else
 			{
 				if (type.imperfect_features() & feature.first)
-					fprintf(m_output, " status=\"imperfect\"");
+					util::stream_format(*m_output, " status=\"imperfect\"");
 				if (unemulated & feature.first)
-					fprintf(m_output, " overall=\"unemulated\"");
+					util::stream_format(*m_output, " overall=\"unemulated\"");
 				else if ((~type.imperfect_features() & imperfect) & feature.first)
-					fprintf(m_output, " overall=\"imperfect\"");
+					util::stream_format(*m_output, " overall=\"imperfect\"");
 			}
-			fprintf(m_output, "/>\n");
+			util::stream_format(*m_output, "/>\n");
 		}
 	}
 }
@@ -1694,46 +1795,46 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", util::xml::normalize_string(imagedev.image_type_name()));
+			util::stream_format(*m_output, "\t\t<device type=\"%s\"", normalize_string(imagedev.image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev.device().tag())
-				fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
+				util::stream_format(*m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
 
 			// is this device available as media switch?
 			if (!loadable)
-				fprintf(m_output, " fixed_image=\"1\"");
+				util::stream_format(*m_output, " fixed_image=\"1\"");
 
 			// is this device mandatory?
 			if (imagedev.must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				util::stream_format(*m_output, " mandatory=\"1\"");
 
 			if (imagedev.image_interface() && imagedev.image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", util::xml::normalize_string(imagedev.image_interface()));
+				util::stream_format(*m_output, " interface=\"%s\"", normalize_string(imagedev.image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			util::stream_format(*m_output, ">\n");
 
 			if (loadable)
 			{
 				const char *name = imagedev.instance_name().c_str();
 				const char *shortname = imagedev.brief_instance_name().c_str();
 
-				fprintf(m_output, "\t\t\t<instance");
-				fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(name));
-				fprintf(m_output, " briefname=\"%s\"", util::xml::normalize_string(shortname));
-				fprintf(m_output, "/>\n");
+				util::stream_format(*m_output, "\t\t\t<instance");
+				util::stream_format(*m_output, " name=\"%s\"", normalize_string(name));
+				util::stream_format(*m_output, " briefname=\"%s\"", normalize_string(shortname));
+				util::stream_format(*m_output, "/>\n");
 
 				std::string extensions(imagedev.file_extensions());
 
 				char *ext = strtok((char *)extensions.c_str(), ",");
 				while (ext != nullptr)
 				{
-					fprintf(m_output, "\t\t\t<extension name=\"%s\"/>\n", util::xml::normalize_string(ext));
+					util::stream_format(*m_output, "\t\t\t<extension name=\"%s\"/>\n", normalize_string(ext));
 					ext = strtok(nullptr, ",");
 				}
 			}
-			fprintf(m_output, "\t\t</device>\n");
+			util::stream_format(*m_output, "\t\t</device>\n");
 		}
 	}
 }
@@ -1758,7 +1859,7 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 
 			// print m_output device type
 			if (listed)
-				fprintf(m_output, "\t\t<slot name=\"%s\">\n", util::xml::normalize_string(newtag.c_str()));
+				util::stream_format(*m_output, "\t\t<slot name=\"%s\">\n", normalize_string(newtag.c_str()));
 
 			for (auto &option : slot.option_list())
 			{
@@ -1773,11 +1874,11 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 
 					if (listed && option.second->selectable())
 					{
-						fprintf(m_output, "\t\t\t<slotoption name=\"%s\"", util::xml::normalize_string(option.second->name()));
-						fprintf(m_output, " devname=\"%s\"", util::xml::normalize_string(dev->shortname()));
+						util::stream_format(*m_output, "\t\t\t<slotoption name=\"%s\"", normalize_string(option.second->name()));
+						util::stream_format(*m_output, " devname=\"%s\"", normalize_string(dev->shortname()));
 						if (slot.default_option() != nullptr && strcmp(slot.default_option(), option.second->name())==0)
-							fprintf(m_output, " default=\"yes\"");
-						fprintf(m_output, "/>\n");
+							util::stream_format(*m_output, " default=\"yes\"");
+						util::stream_format(*m_output, "/>\n");
 					}
 
 					config.device_remove("_dummy");
@@ -1785,7 +1886,7 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 			}
 
 			if (listed)
-				fprintf(m_output, "\t\t</slot>\n");
+				util::stream_format(*m_output, "\t\t</slot>\n");
 		}
 	}
 }
@@ -1800,10 +1901,10 @@ void info_xml_creator::output_software_list(device_t &root)
 {
 	for (const software_list_device &swlist : software_list_device_iterator(root))
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" status=\"%s\"", util::xml::normalize_string(swlist.list_name().c_str()), (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		util::stream_format(*m_output, "\t\t<softwarelist name=\"%s\" status=\"%s\"", normalize_string(swlist.list_name().c_str()), (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist.filter())
-			fprintf(m_output, " filter=\"%s\"", util::xml::normalize_string(swlist.filter()));
-		fprintf(m_output, "/>\n");
+			util::stream_format(*m_output, " filter=\"%s\"", normalize_string(swlist.filter()));
+		util::stream_format(*m_output, "/>\n");
 	}
 }
 
@@ -1828,15 +1929,15 @@ void info_xml_creator::output_ramoptions(device_t &root)
 				{
 					assert(!havedefault);
 					havedefault = true;
-					fprintf(m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
+					util::stream_format(*m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", normalize_string(option.first.c_str()), option.second);
 				}
 				else
 				{
-					fprintf(m_output, "\t\t<ramoption name=\"%s\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
+					util::stream_format(*m_output, "\t\t<ramoption name=\"%s\">%u</ramoption>\n", normalize_string(option.first.c_str()), option.second);
 				}
 			}
 			if (!havedefault)
-				fprintf(m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", ram.default_size_string(), defsize);
+				util::stream_format(*m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", ram.default_size_string(), defsize);
 			break;
 		}
 	}
@@ -15,6 +15,7 @@
 
 #include "emuopts.h"
 
+#include <iosfwd>
 #include <type_traits>
 #include <unordered_set>
 #include <vector>
@@ -35,8 +36,8 @@ public:
 	info_xml_creator(emu_options const &options, bool dtd = true);
 
 	// output
-	void output(FILE *out, std::vector<std::string> const &patterns);
-	void output(FILE *out, driver_enumerator &drivlist, bool nodevices);
+	void output(std::ostream &out, std::vector<std::string> const &patterns);
+	void output(std::ostream &out, driver_enumerator &drivlist, bool nodevices);
 
 private:
 	typedef std::unordered_set<std::add_pointer_t<device_type> > device_type_set;
@@ -72,7 +73,7 @@ private:
 	const char *get_merge_name(driver_enumerator &drivlist, util::hash_collection const &romhashes);
 
 	// internal state
-	FILE *          m_output; // FIXME: this is not reentrancy-safe
+	std::ostream *  m_output; // pointer so worker threads can redirect per-instance
 	emu_options     m_lookup_options;
 
 	static const char s_dtd_string[];
@@ -25,6 +25,8 @@
 #include "uiinput.h"
 #include "pluginopts.h"
 
+#include "NSM_CommonInterface.h"
+
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wshift-count-overflow"
 #endif
@@ -307,6 +309,37 @@ void lua_engine::addr_space::mem_write(offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  mem_read_range - read a block of memory with a
+//  single crossing of the C++/Lua boundary
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:read_range(0xC000, 0x100)
+//-------------------------------------------------
+
+std::string lua_engine::addr_space::mem_read_range(offs_t address, offs_t length)
+{
+	// clamp so a scripting mistake can't allocate unbounded memory
+	if (length > 1024 * 1024)
+		length = 1024 * 1024;
+
+	std::string data;
+	data.resize(length);
+	for (offs_t i = 0; i < length; i++)
+		data[i] = space.read_byte(address + i);
+	return data;
+}
+
+//-------------------------------------------------
+//  mem_write_range - write a Lua string to memory
+//  in a single boundary crossing
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:write_range(0xC000, data)
+//-------------------------------------------------
+
+void lua_engine::addr_space::mem_write_range(offs_t address, const std::string &data)
+{
+	for (offs_t i = 0; i < data.size(); i++)
+		space.write_byte(address + i, data[i]);
+}
+
 //-------------------------------------------------
 //  log_mem_read - templated logical memory readers for <sign>,<size>
 //  -> manager:machine().devices[":maincpu"].spaces["program"]:read_log_i8(0xC000)
@@ -635,19 +668,18 @@ bool lua_engine::menu_callback(const std::string &menu, int index, const std::st
 
 bool lua_engine::execute_function(const char *id)
 {
-	sol::object functable = sol().registry()[id];
-	if(functable.is<sol::table>())
+	// per-frame events hit this several times a frame, so call through the
+	// cached callback list instead of rescanning the registry table
+	auto cached = m_function_cache.find(id);
+	if(cached != m_function_cache.end())
 	{
-		for(auto &func : functable.as<sol::table>())
+		for(auto &func : cached->second)
 		{
-			if(func.second.is<sol::protected_function>())
+			auto ret = func();
+			if(!ret.valid())
 			{
-				auto ret = (func.second.as<sol::protected_function>())();
-				if(!ret.valid())
-				{
-					sol::error err = ret;
-					osd_printf_error("[LUA ERROR] in execute_function: %s\n", err.what());
-				}
+				sol::error err = ret;
+				osd_printf_error("[LUA ERROR] in execute_function: %s\n", err.what());
 			}
 		}
 		return true;
@@ -657,15 +689,44 @@ bool lua_engine::execute_function(const char *id)
 
 void lua_engine::register_function(sol::function func, const char *id)
 {
+	// keep the registry table for scripts that introspect it, but the
+	// engine itself dispatches through m_function_cache
 	sol::object functable = sol().registry()[id];
 	if(functable.is<sol::table>())
 		functable.as<sol::table>().add(func);
 	else
 		sol().registry().create_named(id, 1, func);
+	m_function_cache[id].emplace_back(func);
+}
+
+//-------------------------------------------------
+//  cache_table - return the registry table used to
+//  cache expensive-to-build lookup tables
+//-------------------------------------------------
+
+sol::table lua_engine::cache_table()
+{
+	sol::object cache = sol().registry()["lua_cache"];
+	if(cache.is<sol::table>())
+		return cache.as<sol::table>();
+	sol::table table = sol().create_table();
+	sol().registry()["lua_cache"] = table;
+	return table;
+}
+
+//-------------------------------------------------
+//  invalidate_cache - drop all cached tables; the
+//  device tree they reference is about to change
+//-------------------------------------------------
+
+void lua_engine::invalidate_cache()
+{
+	sol().registry()["lua_cache"] = sol::nil;
 }
 
 void lua_engine::on_machine_prestart()
 {
+	invalidate_cache();
 	execute_function("LUA_ON_PRESTART");
 }
 
@@ -677,6 +738,7 @@ void lua_engine::on_machine_start()
 void lua_engine::on_machine_stop()
 {
 	execute_function("LUA_ON_STOP");
+	invalidate_cache();
 }
 
 void lua_engine::on_machine_pause()
@@ -813,6 +875,15 @@ void lua_engine::initialize()
 		});
 	emu["lang_translate"] = &lang_translate;
 	emu["pid"] = &osd_getpid;
+	emu["netplay_stats"] = [this]() {
+			sol::table table = sol().create_table();
+			if(netCommon)
+			{
+				for(auto &entry : netCommon->getNetStats())
+					table[entry.first] = entry.second;
+			}
+			return table;
+		};
 
 /*
  * emu.file([opt] searchpath, flags) - flags can be as in osdcore "OPEN_FLAG_*" or lua style with 'rwc' with addtional c for create *and truncate* (be careful)
@@ -1174,6 +1245,12 @@ void lua_engine::initialize()
 				},
 			"paused", sol::property(&running_machine::paused),
 			"devices", sol::property([this](running_machine &m) {
+					// the device tree is fixed while the machine runs, so walk it
+					// once and cache the result until the next reset/stop
+					sol::table cache = cache_table();
+					sol::object cached = cache["devices"];
+					if(cached.is<sol::table>())
+						return cached.as<sol::table>();
 					std::function<void(device_t &, sol::table)> tree;
 					sol::table table = sol().create_table();
 					tree = [&tree](device_t &root, sol::table table) {
@@ -1187,6 +1264,7 @@ void lua_engine::initialize()
 						}
 					};
 					tree(m.root_device(), table);
+					cache["devices"] = table;
 					return table;
 				}),
 			"screens", sol::property([this](running_machine &r) {
@@ -1352,7 +1430,26 @@ void lua_engine::initialize()
 						return sol::make_object(sol(), sol::nil);
 					return sol::make_object(sol(), dev.debug());
 				},
+			"total_cycles", sol::property([this](device_t &dev) -> sol::object {
+					device_execute_interface *exec = dynamic_cast<device_execute_interface *>(&dev);
+					if(!exec)
+						return sol::make_object(sol(), sol::nil);
+					return sol::make_object(sol(), exec->total_cycles());
+				}),
+			"host_ticks", sol::property([this](device_t &dev) -> sol::object {
+					device_execute_interface *exec = dynamic_cast<device_execute_interface *>(&dev);
+					if(!exec)
+						return sol::make_object(sol(), sol::nil);
+					return sol::make_object(sol(), exec->host_ticks());
+				}),
 			"spaces", sol::property([this](device_t &dev) {
+					// cache per device tag so scripts hitting a space every
+					// frame reuse the same userdata handles
+					std::string const key = std::string("spaces") + dev.tag();
+					sol::table cache = cache_table();
+					sol::object cached = cache[key];
+					if(cached.is<sol::table>())
+						return cached.as<sol::table>();
 					device_memory_interface *memdev = dynamic_cast<device_memory_interface *>(&dev);
 					sol::table sp_table = sol().create_table();
 					if(!memdev)
@@ -1362,6 +1459,7 @@ void lua_engine::initialize()
 						if(memdev->has_space(sp))
 							sp_table[memdev->space(sp).name()] = addr_space(memdev->space(sp), *memdev);
 					}
+					cache[key] = sp_table;
 					return sp_table;
 				}),
 			"state", sol::property([this](device_t &dev) {
@@ -1413,6 +1511,8 @@ void lua_engine::initialize()
 			"write_u32", &addr_space::mem_write<uint32_t>,
 			"write_i64", &addr_space::mem_write<int64_t>,
 			"write_u64", &addr_space::mem_write<uint64_t>,
+			"read_range", &addr_space::mem_read_range,
+			"write_range", &addr_space::mem_write_range,
 			"read_log_i8", &addr_space::log_mem_read<int8_t>,
 			"read_log_u8", &addr_space::log_mem_read<uint8_t>,
 			"read_log_i16", &addr_space::log_mem_read<int16_t>,
@@ -2019,6 +2119,8 @@ bool lua_engine::frame_hook()
 
 void lua_engine::close()
 {
+	// cached references must not outlive the lua state
+	m_function_cache.clear();
 	m_sol_state.reset();
 	if (m_lua_state)
 	{
@@ -115,6 +115,10 @@ private:
 
 	std::vector<std::string> m_menu;
 
+	// registered callbacks by event id, mirroring the registry tables so
+	// per-frame events don't rescan the registry
+	std::map<std::string, std::vector<sol::protected_function>> m_function_cache;
+
 	running_machine &machine() const { return *m_machine; }
 
 	void on_machine_prestart();
@@ -129,11 +133,18 @@ private:
 	bool execute_function(const char *id);
 	sol::object call_plugin(const std::string &name, sol::object in);
 
+	// registry-backed cache for tables that are expensive to rebuild per
+	// access (device tree, per-device address space tables)
+	sol::table cache_table();
+	void invalidate_cache();
+
 	struct addr_space {
 		addr_space(address_space &space, device_memory_interface &dev) :
 			space(space), dev(dev) {}
 		template<typename T> T mem_read(offs_t address);
 		template<typename T> void mem_write(offs_t address, T val);
+		std::string mem_read_range(offs_t address, offs_t length);
+		void mem_write_range(offs_t address, const std::string &data);
 		template<typename T> T log_mem_read(offs_t address);
 		template<typename T> void log_mem_write(offs_t address, T val);
 		template<typename T> T direct_mem_read(offs_t address);
@@ -12,6 +12,7 @@
 
 #include "emu.h"
 #include "mame.h"
+#include "drivenum.h"
 #include "emuopts.h"
 #include "mameopts.h"
 #include "pluginopts.h"
@@ -27,6 +28,9 @@
 #include "ui/inifile.h"
 #include "xmlfile.h"
 
+#include <algorithm>
+#include <fstream>
+
 //**************************************************************************
 //  MACHINE MANAGER
 //**************************************************************************
@@ -57,6 +61,7 @@ mame_machine_manager::mame_machine_manager(emu_options &options,osd_interface &o
 		m_lua(global_alloc(lua_engine)),
 		m_new_driver_pending(nullptr),
 		m_firstrun(true),
+		m_romdata_cache_bytes(0),
 		m_autoboot_timer(nullptr)
 {
 }
@@ -181,6 +186,52 @@ void mame_machine_manager::start_luaengine()
 	}
 }
 
+/*-------------------------------------------------
+    bench_rank_report - sort the accumulated CSV
+    benchmark report rows by 99th percentile
+    frame cost, leaving the header in place
+-------------------------------------------------*/
+
+static void bench_rank_report(const char *filename)
+{
+	if (filename == nullptr || filename[0] == 0)
+		return;
+
+	std::ifstream in(filename);
+	if (!in)
+		return;
+	std::string header;
+	if (!std::getline(in, header))
+		return;
+	std::vector<std::string> rows;
+	std::string line;
+	while (std::getline(in, line))
+		if (!line.empty())
+			rows.push_back(line);
+	in.close();
+
+	// p99_us is the seventh column
+	auto p99 = [] (const std::string &row) -> unsigned long long
+	{
+		std::string::size_type pos = 0;
+		for (int comma = 0; comma < 6; comma++)
+		{
+			pos = row.find(',', pos);
+			if (pos == std::string::npos)
+				return 0;
+			pos++;
+		}
+		return strtoull(row.c_str() + pos, nullptr, 10);
+	};
+	std::stable_sort(rows.begin(), rows.end(), [&p99] (const std::string &a, const std::string &b) { return p99(a) > p99(b); });
+
+	std::ofstream out(filename, std::ios::trunc);
+	out << header << '\n';
+	for (auto &row : rows)
+		out << row << '\n';
+}
+
+
 /*-------------------------------------------------
     execute - run the core emulation
 -------------------------------------------------*/
@@ -195,6 +246,39 @@ int mame_machine_manager::execute()
 	bool exit_pending = false;
 	int error = EMU_ERR_NONE;
 
+	// if a benchmark suite was requested, load the driver list and start
+	// with its first entry
+	std::vector<std::string> bench_suite;
+	std::size_t bench_suite_index = 0;
+	if (m_options.bench_suite() != nullptr && m_options.bench_suite()[0] != 0)
+	{
+		std::ifstream suite_file(m_options.bench_suite());
+		std::string line;
+		while (std::getline(suite_file, line))
+		{
+			// trim trailing whitespace, skip blank lines and comments
+			while (!line.empty() && (line.back() == '\r' || line.back() == '\n' || line.back() == ' ' || line.back() == '\t'))
+				line.pop_back();
+			if (line.empty() || line[0] == '#')
+				continue;
+			bench_suite.push_back(line);
+		}
+		if (bench_suite.empty())
+			osd_printf_error("Benchmark suite file '%s' contains no drivers\n", m_options.bench_suite());
+		else
+		{
+			m_options.set_system_name(bench_suite[0].c_str());
+
+			// start the report with a header row
+			const char *report = m_options.bench_report();
+			if (report != nullptr && report[0] != 0)
+			{
+				std::ofstream out(report, std::ios::trunc);
+				out << "driver,frames,emulated_seconds,speed_percent,p50_us,p90_us,p99_us,top_device,top_device_host_share\n";
+			}
+		}
+	}
+
 	while (error == EMU_ERR_NONE && !exit_pending)
 	{
 		m_new_driver_pending = nullptr;
@@ -217,13 +301,21 @@ int mame_machine_manager::execute()
 			mame_options::parse_standard_inis(m_options, errors);
 		}
 
-		// otherwise, perform validity checks before anything else
+		// otherwise, perform validity checks before anything else; a system
+		// validated earlier in this process (e.g. a resync restart of the
+		// same machine) re-runs its shared-source configuration for nothing,
+		// so remember what has already passed
 		bool is_empty = (system == &GAME_NAME(___empty));
-		if (!is_empty)
+		if (!is_empty && (m_validated_systems.find(system) == m_validated_systems.end()))
 		{
 			validity_checker valid(m_options);
 			valid.set_verbose(false);
 			valid.check_shared_source(*system);
+
+			// everything from this source file was just validated with it
+			for (std::size_t index = 0; index < driver_list::total(); index++)
+				if (strcmp(system->type.source(), driver_list::driver(index).type.source()) == 0)
+					m_validated_systems.insert(&driver_list::driver(index));
 		}
 
 		// create the machine configuration
@@ -258,7 +350,22 @@ int mame_machine_manager::execute()
 		deleteGlobalServer();
 
 		// check the state of the machine
-		if (m_new_driver_pending)
+		if (!bench_suite.empty() && m_new_driver_pending == nullptr)
+		{
+			// benchmark suite mode: advance to the next listed driver, and
+			// rank the report once the list is exhausted
+			if (++bench_suite_index < bench_suite.size())
+			{
+				m_options.set_system_name(bench_suite[bench_suite_index].c_str());
+				m_firstrun = true;
+			}
+			else
+			{
+				bench_rank_report(m_options.bench_report());
+				exit_pending = true;
+			}
+		}
+		else if (m_new_driver_pending)
 		{
 			// set up new system name and adjust device options accordingly
 			m_options.set_system_name(m_new_driver_pending->name);
@@ -270,7 +377,7 @@ int mame_machine_manager::execute()
 				m_options.set_system_name("");
 		}
 
-		if (machine.exit_pending() && (!started_empty || is_empty))
+		if (bench_suite.empty() && machine.exit_pending() && (!started_empty || is_empty))
 			exit_pending = true;
 
 		// machine will go away when we exit scope
@@ -337,6 +444,43 @@ void mame_machine_manager::load_cheatfiles(running_machine& machine)
 	m_cheat = std::make_unique<cheat_manager>(machine);
 }
 
+
+//-------------------------------------------------
+//  romdata_cache_find - look up a ROM payload
+//  retained from an earlier session
+//-------------------------------------------------
+
+std::shared_ptr<std::vector<u8>> mame_machine_manager::romdata_cache_find(const std::string &key)
+{
+	if (options().romdata_cache() <= 0)
+		return nullptr;
+
+	auto iter = m_romdata_cache.find(key);
+	return (iter != m_romdata_cache.end()) ? iter->second : nullptr;
+}
+
+
+//-------------------------------------------------
+//  romdata_cache_store - retain a ROM payload for
+//  the following sessions this process hosts
+//-------------------------------------------------
+
+void mame_machine_manager::romdata_cache_store(const std::string &key, std::shared_ptr<std::vector<u8>> data)
+{
+	size_t const limit = size_t(options().romdata_cache()) * 1024 * 1024;
+	if (limit == 0 || data == nullptr)
+		return;
+
+	// entries are never evicted while a session may still reference
+	// them, so once the budget is spent later payloads stay uncached
+	if (m_romdata_cache_bytes + data->size() > limit)
+		return;
+
+	auto inserted = m_romdata_cache.emplace(key, std::move(data));
+	if (inserted.second)
+		m_romdata_cache_bytes += inserted.first->second->size();
+}
+
 const char * emulator_info::get_bare_build_version() { return bare_build_version; }
 const char * emulator_info::get_build_version() { return build_version; }
 
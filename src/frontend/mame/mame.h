@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 class plugin_options;
 class osd_interface;
 
@@ -56,6 +59,9 @@ public:
 
 	virtual void ui_initialize(running_machine& machine) override;
 
+	virtual std::shared_ptr<std::vector<u8>> romdata_cache_find(const std::string &key) override;
+	virtual void romdata_cache_store(const std::string &key, std::shared_ptr<std::vector<u8>> data) override;
+
 	/* execute as configured by the OPTION_SYSTEMNAME option on the specified options */
 	int execute();
 	void start_luaengine();
@@ -70,6 +76,12 @@ private:
 
 	const game_driver *     m_new_driver_pending;   // pointer to the next pending driver
 	bool                    m_firstrun;
+	std::unordered_set<const game_driver *> m_validated_systems; // systems already validated this process
+
+	// immutable ROM payloads retained across the sessions this process
+	// hosts, keyed by name and hash; bounded by the romdata_cache option
+	std::unordered_map<std::string, std::shared_ptr<std::vector<u8>>> m_romdata_cache;
+	size_t                  m_romdata_cache_bytes;
 
 	static mame_machine_manager* m_manager;
 	emu_timer               *m_autoboot_timer;      // autoboot timer
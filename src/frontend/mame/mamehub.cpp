@@ -22,6 +22,21 @@ extern bool waitingForClientCatchup;
 
 mamehub_manager::mamehub_manager() {}
 
+// Returns true when ui() could draw anything this frame; used to decide
+// whether the UI container can be retained unchanged between frames.
+bool mamehub_manager::ui_active(mame_ui_manager& ui_manager) {
+  if (waitingForClientCatchup) {
+    return true;
+  }
+  if (netCommon || netClient) {
+    return true;
+  }
+  if (ui_manager.machine().options().client()) {
+    return true;
+  }
+  return false;
+}
+
 void mamehub_manager::ui(mame_ui_manager& ui_manager,
                          render_container& container) {
   if (waitingForClientCatchup && !netCommon->isRollback()) {
@@ -19,6 +19,7 @@ public:
 	~mamehub_manager();
 
   void ui(mame_ui_manager& ui_manager, render_container &container);
+  bool ui_active(mame_ui_manager& ui_manager);
   bool handleChat(running_machine& machine, ui_event& event);
 private:
   static mamehub_manager* m_manager;
@@ -14,7 +14,35 @@
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
 
+#include <chrono>
 #include <fstream>
+#include <mutex>
+
+
+namespace {
+
+// one remembered plugin definition
+struct cached_plugin
+{
+	std::string name;
+	std::string description;
+	bool start;
+};
+
+// results of scanning one plugin directory, validated by mtime
+struct directory_snapshot
+{
+	std::chrono::system_clock::time_point dir_mtime;
+	std::chrono::system_clock::time_point json_mtime;   // plugin.json here, or epoch if none
+	std::vector<cached_plugin> plugins;                 // definitions parsed from this directory
+	std::vector<std::string> subdirs;                   // subdirectories to recurse into
+};
+
+// process-wide cache so repeated launches do not re-glob unchanged trees
+std::mutex s_snapshot_mutex;
+std::map<std::string, directory_snapshot> s_snapshot_cache;
+
+} // anonymous namespace
 
 
 //**************************************************************************
@@ -40,11 +68,43 @@ plugin_options::plugin_options()
 
 void plugin_options::parse_json(std::string path)
 {
-	// first try to open as a directory
+	// first stat the directory so the cached snapshot can be validated
 	osd_subst_env(path, path);
-	osd::directory::ptr directory = osd::directory::open(path);
-	if (directory)
+	std::unique_ptr<osd::directory::entry> dirstat = osd_stat(path);
+	if (!dirstat || dirstat->type != osd::directory::entry::entry_type::DIR)
+		return;
+
+	// look for a snapshot of this directory from an earlier launch
+	directory_snapshot snapshot;
+	bool have_snapshot = false;
+	{
+		std::lock_guard<std::mutex> lock(s_snapshot_mutex);
+		auto it = s_snapshot_cache.find(path);
+		if (it != s_snapshot_cache.end() && it->second.dir_mtime == dirstat->last_modified)
+		{
+			snapshot = it->second;
+			have_snapshot = true;
+		}
+	}
+
+	// editing plugin.json does not touch the directory mtime, so check it separately
+	if (have_snapshot && snapshot.json_mtime != std::chrono::system_clock::time_point())
 	{
+		std::unique_ptr<osd::directory::entry> jsonstat = osd_stat(path + PATH_SEPARATOR "plugin.json");
+		if (!jsonstat || jsonstat->last_modified != snapshot.json_mtime)
+			have_snapshot = false;
+	}
+
+	// no usable snapshot: glob the directory and rebuild one
+	if (!have_snapshot)
+	{
+		snapshot = directory_snapshot();
+		snapshot.dir_mtime = dirstat->last_modified;
+
+		osd::directory::ptr directory = osd::directory::open(path);
+		if (!directory)
+			return;
+
 		// iterate over all files in the directory
 		for (const osd::directory::entry *entry = directory->read(); entry != nullptr; entry = directory->read())
 		{
@@ -53,6 +113,8 @@ void plugin_options::parse_json(std::string path)
 				std::string name = entry->name;
 				if (name == "plugin.json")
 				{
+					snapshot.json_mtime = entry->last_modified;
+
 					std::string curfile = std::string(path).append(PATH_SEPARATOR).append(entry->name);
 					std::ifstream ifs(curfile);
 					rapidjson::IStreamWrapper isw(ifs);
@@ -76,10 +138,7 @@ void plugin_options::parse_json(std::string path)
 							start = true;
 
 						if (type=="plugin")
-						{
-							auto const it = m_descriptions.emplace(m_descriptions.end(), std::move(description));
-							add_entry({ std::move(plugin_name) }, it->c_str(), option_type::BOOLEAN, start ? "1" : "0");
-						}
+							snapshot.plugins.push_back(cached_plugin{ std::move(plugin_name), std::move(description), start });
 					}
 
 				}
@@ -88,10 +147,21 @@ void plugin_options::parse_json(std::string path)
 			{
 				std::string name = entry->name;
 				if (!(name == "." || name == ".."))
-				{
-					parse_json(path + PATH_SEPARATOR + name);
-				}
+					snapshot.subdirs.push_back(std::move(name));
 			}
 		}
+
+		// remember the snapshot for the next launch
+		std::lock_guard<std::mutex> lock(s_snapshot_mutex);
+		s_snapshot_cache[path] = snapshot;
+	}
+
+	// apply the plugin definitions and recurse into subdirectories
+	for (const cached_plugin &plugin : snapshot.plugins)
+	{
+		auto const it = m_descriptions.emplace(m_descriptions.end(), plugin.description);
+		add_entry({ plugin.name }, it->c_str(), option_type::BOOLEAN, plugin.start ? "1" : "0");
 	}
+	for (const std::string &subdir : snapshot.subdirs)
+		parse_json(path + PATH_SEPARATOR + subdir);
 }
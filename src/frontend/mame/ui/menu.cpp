@@ -235,6 +235,7 @@ menu::menu(mame_ui_manager &mui, render_container &container)
 	, m_pool(nullptr)
 	, m_customtop(0.0f)
 	, m_custombottom(0.0f)
+	, m_dirty(true)
 	, m_resetpos(0)
 	, m_resetref(nullptr)
 	, m_mouse_hit(false)
@@ -274,6 +275,7 @@ menu::~menu()
 void menu::reset(reset_options options)
 {
 	// based on the reset option, set the reset info
+	m_dirty = true;
 	m_resetpos = 0;
 	m_resetref = nullptr;
 	if (options == reset_options::REMEMBER_POSITION)
@@ -333,6 +335,24 @@ void menu::set_special_main_menu(bool special)
 }
 
 
+//-------------------------------------------------
+//  stack_can_retain_frame - would the topmost
+//  menu emit the same primitives as last frame?
+//-------------------------------------------------
+
+bool menu::stack_can_retain_frame(running_machine &machine)
+{
+	global_state_ptr const state(get_global_state(machine));
+	menu *const topmost = state ? state->topmost_menu<menu>() : nullptr;
+	if (topmost == nullptr || topmost->m_dirty)
+		return false;
+
+	// menus with custom_render content may animate without touching the
+	// item list, so never retain their frames
+	return (topmost->m_customtop == 0.0f) && (topmost->m_custombottom == 0.0f);
+}
+
+
 //-------------------------------------------------
 //  item_append - append a new item to the
 //  end of the menu
@@ -400,6 +420,8 @@ void menu::item_append(std::string &&text, std::string &&subtext, uint32_t flags
 	// update the selection if we need to
 	if (m_resetpos == index || (m_resetref != nullptr && m_resetref == ref))
 		selected = index;
+
+	m_dirty = true;
 	if (m_resetpos == (item.size() - 1))
 		selected = item.size() - 1;
 }
@@ -445,11 +467,21 @@ const menu::event *menu::process(uint32_t flags, float x0, float y0)
 	// first make sure our selection is valid
 	validate_selection(1);
 
-	// draw the menu
-	if (item.size() > 1 && (item[0].flags & FLAG_MULTILINE) != 0)
-		draw_text_box();
-	else
-		draw(flags);
+	// draw the menu; when the UI manager retained the previous frame, the
+	// container still holds our primitives and re-emitting them is skipped
+	if (!ui().ui_frame_retained())
+	{
+		if (item.size() > 1 && (item[0].flags & FLAG_MULTILINE) != 0)
+			draw_text_box();
+		else
+			draw(flags);
+		m_dirty = false;
+	}
+
+	// remember the state that determines what a redraw would emit
+	int const prev_selected = selected;
+	int const prev_hover = hover;
+	int const prev_top_line = top_line;
 
 	// process input
 	if (!(flags & PROCESS_NOKEYS) && !(flags & PROCESS_NOINPUT))
@@ -462,9 +494,15 @@ const menu::event *menu::process(uint32_t flags, float x0, float y0)
 			handle_keys(flags, m_event.iptkey);
 	}
 
+	// any change to the visible state means the next frame must redraw
+	if (selected != prev_selected || hover != prev_hover || top_line != prev_top_line)
+		m_dirty = true;
+
 	// update the selected item in the event
 	if ((m_event.iptkey != IPT_INVALID) && selection_valid())
 	{
+		// the caller may act on the event and change what we display
+		m_dirty = true;
 		m_event.itemref = get_selection_ref();
 		m_event.type = item[selected].type;
 		return &m_event;
@@ -84,6 +84,9 @@ public:
 	// test if one of the menus in the stack requires hide disable
 	static bool stack_has_special_main_menu(running_machine &machine) { return get_global_state(machine)->stack_has_special_main_menu(); }
 
+	// test if the topmost menu would emit the same primitives as last frame
+	static bool stack_can_retain_frame(running_machine &machine);
+
 	// master handler
 	static uint32_t ui_handler(render_container &container, mame_ui_manager &mui);
 
@@ -378,6 +381,8 @@ private:
 	float                   m_customtop;        // amount of extra height to add at the top
 	float                   m_custombottom;     // amount of extra height to add at the bottom
 
+	bool                    m_dirty;            // content changed since the last draw?
+
 	int                     m_resetpos;         // reset position
 	void                    *m_resetref;        // reset reference
 
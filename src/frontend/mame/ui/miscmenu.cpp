@@ -25,6 +25,8 @@
 #include "ui/inifile.h"
 #include "ui/submenu.h"
 
+#include <fstream>
+
 namespace ui {
 /***************************************************************************
     MENU HANDLERS
@@ -585,10 +587,9 @@ void menu_export::handle()
 				emu_file file(ui().options().ui_path(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 				if (file.open(filename.c_str(), ".xml") == osd_file::error::NONE)
 				{
-					FILE *pfile;
 					std::string fullpath(file.fullpath());
 					file.close();
-					pfile = fopen(fullpath.c_str(), "w");
+					std::ofstream pfile(fullpath.c_str(), std::ios::out | std::ios::trunc);
 
 					// create the XML and save to file
 					driver_enumerator drvlist(machine().options());
@@ -598,7 +599,7 @@ void menu_export::handle()
 
 					info_xml_creator creator(machine().options());
 					creator.output(pfile, drvlist, (uintptr_t(menu_event->itemref) == 1) ? false : true);
-					fclose(pfile);
+					pfile.close();
 					machine().popmessage(_("%s.xml saved under ui folder."), filename.c_str());
 				}
 			}
@@ -186,7 +186,9 @@ mame_ui_manager::mame_ui_manager(running_machine &machine)
 	, m_popup_text_end(0)
 	, m_mouse_bitmap(32, 32)
 	, m_mouse_arrow_texture(nullptr)
-	, m_mouse_show(false) {}
+	, m_mouse_show(false)
+	, m_ui_retained(false)
+	, m_ui_frame_signature(0) {}
 
 mame_ui_manager::~mame_ui_manager()
 {
@@ -394,51 +396,100 @@ void mame_ui_manager::set_startup_text(const char *text, bool force)
 
 void mame_ui_manager::update_and_render(render_container &container)
 {
-	// always start clean
-	container.empty();
+	// when a menu is up and its content has not changed, the container still
+	// holds last frame's primitives and rebuilding them can be skipped; fold
+	// everything outside the menu system that influences what we draw into a
+	// signature so any change forces a rebuild
+	bool retain = false;
+	if (machine().phase() >= machine_phase::RESET
+			&& m_handler_callback_type == ui_callback_type::MENU
+			&& !machine().options().cheat()
+			&& !mamehub_manager::instance()->ui_active(*this)
+			&& !show_fps_counter()
+			&& m_popup_text_end == 0)
+	{
+		int32_t mouse_sig_x = -1, mouse_sig_y = -1;
+		bool mouse_sig_button = false;
+		render_target *mouse_sig_target = machine().ui_input().find_mouse(&mouse_sig_x, &mouse_sig_y, &mouse_sig_button);
 
-	// if we're paused, dim the whole screen
-	if (machine().phase() >= machine_phase::RESET && (single_step() || machine().paused()))
+		uint64_t signature = 0xcbf29ce484222325U;
+		auto const fold = [&signature] (uint64_t value)
+		{
+			for (unsigned byte = 0; byte < 8; byte++)
+			{
+				signature = (signature ^ (value & 0xff)) * 0x100000001b3U;
+				value >>= 8;
+			}
+		};
+		fold(uint64_t(machine().paused())
+				| (uint64_t(single_step()) << 1)
+				| (uint64_t(m_mouse_show) << 2)
+				| (uint64_t(mouse_sig_button) << 3));
+		fold(uint64_t(uintptr_t(mouse_sig_target)));
+		fold(uint64_t(uint32_t(mouse_sig_x)) | (uint64_t(uint32_t(mouse_sig_y)) << 32));
+
+		if (signature == m_ui_frame_signature && ui::menu::stack_can_retain_frame(machine()))
+			retain = true;
+		m_ui_frame_signature = signature;
+	}
+	else
 	{
-		int alpha = (1.0f - machine().options().pause_brightness()) * 255.0f;
-		if (ui::menu::stack_has_special_main_menu(machine()))
-			alpha = 255;
-		if (alpha > 255)
-			alpha = 255;
-		if (alpha >= 0)
-			container.add_rect(0.0f, 0.0f, 1.0f, 1.0f, rgb_t(alpha,0x00,0x00,0x00), PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+		m_ui_frame_signature = 0;
 	}
+	m_ui_retained = retain;
+
+	if (!retain)
+	{
+		// always start clean
+		container.empty();
 
-	// render any cheat stuff at the bottom
-	if (machine().phase() >= machine_phase::RESET)
-		mame_machine_manager::instance()->cheat().render_text(*this, container);
+		// if we're paused, dim the whole screen
+		if (machine().phase() >= machine_phase::RESET && (single_step() || machine().paused()))
+		{
+			int alpha = (1.0f - machine().options().pause_brightness()) * 255.0f;
+			if (ui::menu::stack_has_special_main_menu(machine()))
+				alpha = 255;
+			if (alpha > 255)
+				alpha = 255;
+			if (alpha >= 0)
+				container.add_rect(0.0f, 0.0f, 1.0f, 1.0f, rgb_t(alpha,0x00,0x00,0x00), PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+		}
 
-	// MAMEHub Rendering
-	mamehub_manager::instance()->ui(*this, container);
+		// render any cheat stuff at the bottom
+		if (machine().phase() >= machine_phase::RESET)
+			mame_machine_manager::instance()->cheat().render_text(*this, container);
 
-	// call the current UI handler
-	m_handler_param = m_handler_callback(container);
+		// MAMEHub Rendering
+		mamehub_manager::instance()->ui(*this, container);
+	}
 
-	// display any popup messages
-	if (osd_ticks() < m_popup_text_end)
-		draw_text_box(container, messagebox_poptext.c_str(), ui::text_layout::CENTER, 0.5f, 0.9f, messagebox_backcolor);
-	else
-		m_popup_text_end = 0;
+	// call the current UI handler; menus still need to see input even when
+	// the frame is retained
+	m_handler_param = m_handler_callback(container);
 
-	// display the internal mouse cursor
-	if (m_mouse_show || (is_menu_active() && machine().options().ui_mouse()))
+	if (!retain)
 	{
-		int32_t mouse_target_x, mouse_target_y;
-		bool mouse_button;
-		render_target *mouse_target = machine().ui_input().find_mouse(&mouse_target_x, &mouse_target_y, &mouse_button);
+		// display any popup messages
+		if (osd_ticks() < m_popup_text_end)
+			draw_text_box(container, messagebox_poptext.c_str(), ui::text_layout::CENTER, 0.5f, 0.9f, messagebox_backcolor);
+		else
+			m_popup_text_end = 0;
 
-		if (mouse_target != nullptr)
+		// display the internal mouse cursor
+		if (m_mouse_show || (is_menu_active() && machine().options().ui_mouse()))
 		{
-			float mouse_y=-1,mouse_x=-1;
-			if (mouse_target->map_point_container(mouse_target_x, mouse_target_y, container, mouse_x, mouse_y))
+			int32_t mouse_target_x, mouse_target_y;
+			bool mouse_button;
+			render_target *mouse_target = machine().ui_input().find_mouse(&mouse_target_x, &mouse_target_y, &mouse_button);
+
+			if (mouse_target != nullptr)
 			{
-				const float cursor_size = 0.6 * get_line_height();
-				container.add_quad(mouse_x, mouse_y, mouse_x + cursor_size * container.manager().ui_aspect(&container), mouse_y + cursor_size, UI_TEXT_COLOR, m_mouse_arrow_texture, PRIMFLAG_ANTIALIAS(1) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+				float mouse_y=-1,mouse_x=-1;
+				if (mouse_target->map_point_container(mouse_target_x, mouse_target_y, container, mouse_x, mouse_y))
+				{
+					const float cursor_size = 0.6 * get_line_height();
+					container.add_quad(mouse_x, mouse_y, mouse_x + cursor_size * container.manager().ui_aspect(&container), mouse_y + cursor_size, UI_TEXT_COLOR, m_mouse_arrow_texture, PRIMFLAG_ANTIALIAS(1) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+				}
 			}
 		}
 	}
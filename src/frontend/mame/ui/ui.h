@@ -162,6 +162,7 @@ public:
 	bool single_step() const { return m_single_step; }
 	ui_options &options() { return m_ui_options; }
 	ui::machine_info &machine_info() const { assert(m_machine_info); return *m_machine_info; }
+	bool ui_frame_retained() const { return m_ui_retained; }
 
 	// setters
 	void set_single_step(bool single_step) { m_single_step = single_step; }
@@ -247,6 +248,8 @@ private:
 	render_texture *        m_mouse_arrow_texture;
 	bool                    m_mouse_show;
 	ui_options              m_ui_options;
+	bool                    m_ui_retained;
+	uint64_t                m_ui_frame_signature;
 
 	std::unique_ptr<ui::machine_info> m_machine_info;
 
@@ -89,6 +89,7 @@ static floppy_image_legacy *floppy_init(void *fp, const struct io_procs *procs,
 	floppy->io.file = fp;
 	floppy->io.procs = procs;
 	floppy->io.filler = 0xFF;
+	io_generic_cache(&floppy->io);
 	floppy->flags = (uint8_t) flags;
 	return floppy;
 }
@@ -292,6 +293,8 @@ static void floppy_close_internal(floppy_image_legacy *floppy, bool close_file)
 			floppy->floppy_option->destruct(floppy, floppy->floppy_option);
 		if (close_file)
 			io_generic_close(&floppy->io);
+		else
+			io_generic_uncache(&floppy->io);
 		if (floppy->loaded_track_data)
 			free(floppy->loaded_track_data);
 		pool_free_lib(floppy->tags);
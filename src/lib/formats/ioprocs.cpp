@@ -117,6 +117,181 @@ const struct io_procs corefile_ioprocs_noclose =
 
 
 
+/*********************************************************************
+    cached ioprocs - LRU block cache over another ioprocs
+
+    Filesystem and floppy modules issue lots of small reads and repeat
+    the size query on every access; over stdio or corefile each of
+    those is a seek round trip.  The cache keeps the hot blocks and
+    the file size in memory so batch work over large images only
+    touches the blocks it actually needs.
+*********************************************************************/
+
+#define CACHE_BLOCK_SIZE    4096
+#define CACHE_BLOCK_COUNT   64
+
+struct io_cached_block
+{
+	uint64_t blocknum;      /* file offset / CACHE_BLOCK_SIZE */
+	uint64_t last_used;     /* LRU stamp; 0 means empty */
+	uint32_t valid;         /* number of valid bytes in data */
+	uint8_t data[CACHE_BLOCK_SIZE];
+};
+
+struct io_cached_file
+{
+	const struct io_procs *procs;   /* underlying ioprocs */
+	void *file;                     /* underlying file */
+	uint64_t size;                  /* cached file size */
+	uint64_t position;              /* emulated file position */
+	uint64_t stamp;                 /* LRU clock */
+	struct io_cached_block blocks[CACHE_BLOCK_COUNT];
+};
+
+static void cached_closeproc(void *file)
+{
+	struct io_cached_file *cache = (struct io_cached_file *) file;
+	if (cache->procs->closeproc)
+		cache->procs->closeproc(cache->file);
+	free(cache);
+}
+
+static int cached_seekproc(void *file, int64_t offset, int whence)
+{
+	struct io_cached_file *cache = (struct io_cached_file *) file;
+	switch(whence)
+	{
+		case SEEK_CUR:
+			offset += cache->position;
+			break;
+		case SEEK_END:
+			offset += cache->size;
+			break;
+	}
+	cache->position = (offset < 0) ? 0 : (uint64_t) offset;
+	return 0;
+}
+
+static struct io_cached_block *cached_fill_block(struct io_cached_file *cache, uint64_t blocknum)
+{
+	struct io_cached_block *block = nullptr;
+	int i;
+
+	/* hit? */
+	for (i = 0; i < CACHE_BLOCK_COUNT; i++)
+		if (cache->blocks[i].last_used && cache->blocks[i].blocknum == blocknum)
+		{
+			cache->blocks[i].last_used = ++cache->stamp;
+			return &cache->blocks[i];
+		}
+
+	/* miss; evict the least recently used block */
+	for (i = 0; i < CACHE_BLOCK_COUNT; i++)
+		if (!block || cache->blocks[i].last_used < block->last_used)
+			block = &cache->blocks[i];
+
+	cache->procs->seekproc(cache->file, blocknum * CACHE_BLOCK_SIZE, SEEK_SET);
+	block->blocknum = blocknum;
+	block->valid = cache->procs->readproc(cache->file, block->data, CACHE_BLOCK_SIZE);
+	block->last_used = ++cache->stamp;
+	return block;
+}
+
+static size_t cached_readproc(void *file, void *buffer, size_t length)
+{
+	struct io_cached_file *cache = (struct io_cached_file *) file;
+	size_t result = 0;
+
+	while (length > 0)
+	{
+		struct io_cached_block *block = cached_fill_block(cache, cache->position / CACHE_BLOCK_SIZE);
+		uint32_t offset = (uint32_t) (cache->position % CACHE_BLOCK_SIZE);
+		if (offset >= block->valid)
+			break;
+		uint32_t chunk = block->valid - offset;
+		if (chunk > length)
+			chunk = (uint32_t) length;
+		memcpy((uint8_t *) buffer + result, block->data + offset, chunk);
+		cache->position += chunk;
+		result += chunk;
+		length -= chunk;
+	}
+	return result;
+}
+
+static size_t cached_writeproc(void *file, const void *buffer, size_t length)
+{
+	struct io_cached_file *cache = (struct io_cached_file *) file;
+	uint64_t first_block = cache->position / CACHE_BLOCK_SIZE;
+	uint64_t last_block = (cache->position + length) / CACHE_BLOCK_SIZE;
+	size_t result;
+	int i;
+
+	/* write through */
+	cache->procs->seekproc(cache->file, cache->position, SEEK_SET);
+	result = cache->procs->writeproc(cache->file, buffer, length);
+
+	/* invalidate every block the write overlapped */
+	for (i = 0; i < CACHE_BLOCK_COUNT; i++)
+		if (cache->blocks[i].last_used && cache->blocks[i].blocknum >= first_block && cache->blocks[i].blocknum <= last_block)
+			cache->blocks[i].last_used = 0;
+
+	cache->position += result;
+	if (cache->position > cache->size)
+		cache->size = cache->position;
+	return result;
+}
+
+static uint64_t cached_filesizeproc(void *file)
+{
+	struct io_cached_file *cache = (struct io_cached_file *) file;
+	return cache->size;
+}
+
+static const struct io_procs cached_ioprocs =
+{
+	cached_closeproc,
+	cached_seekproc,
+	cached_readproc,
+	cached_writeproc,
+	cached_filesizeproc
+};
+
+void io_generic_cache(struct io_generic *genio)
+{
+	struct io_cached_file *cache;
+
+	if (genio->procs == &cached_ioprocs)
+		return;
+
+	cache = (struct io_cached_file *) malloc(sizeof(*cache));
+	if (!cache)
+		return;
+
+	memset(cache, 0, sizeof(*cache));
+	cache->procs = genio->procs;
+	cache->file = genio->file;
+	cache->size = genio->procs->filesizeproc(genio->file);
+
+	genio->procs = &cached_ioprocs;
+	genio->file = cache;
+}
+
+void io_generic_uncache(struct io_generic *genio)
+{
+	struct io_cached_file *cache;
+
+	if (genio->procs != &cached_ioprocs)
+		return;
+
+	cache = (struct io_cached_file *) genio->file;
+	genio->procs = cache->procs;
+	genio->file = cache->file;
+	free(cache);
+}
+
+
+
 /*********************************************************************
     calls for accessing generic IO
 *********************************************************************/
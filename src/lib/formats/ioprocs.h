@@ -62,6 +62,15 @@ extern const struct io_procs corefile_ioprocs_noclose;
 
 
 void io_generic_close(struct io_generic *genio);
+
+/* wraps genio with an LRU block cache; reads are served from cached blocks
+   and the size query is answered from memory, writes go straight through
+   and invalidate what they overlap.  io_generic_close() tears the cache
+   down along with the underlying file; io_generic_uncache() removes only
+   the cache and puts the original procs/file back */
+void io_generic_cache(struct io_generic *genio);
+void io_generic_uncache(struct io_generic *genio);
+
 void io_generic_read(struct io_generic *genio, void *buffer, uint64_t offset, size_t length);
 void io_generic_write(struct io_generic *genio, const void *buffer, uint64_t offset, size_t length);
 void io_generic_write_filler(struct io_generic *genio, uint8_t filler, uint64_t offset, size_t length);
@@ -132,13 +132,32 @@ void matrix_solver_direct_t<m_N, storage_N>::LE_solve()
 			const auto &nzrd = m_terms[i]->m_nzrd;
 			const auto &nzbd = m_terms[i]->m_nzbd;
 
-			for (std::size_t j : nzbd)
+			/* m_nzrd is sorted; when the non-zeros right of the diagonal
+			 * form one contiguous run - the common case on the dense
+			 * matrices this solver is selected for - hand the update to
+			 * the vector primitive so the compiler can emit SIMD for it */
+			const std::size_t ne = nzrd.size();
+			if (ne > 0 && static_cast<std::size_t>(nzrd.back() - nzrd.front()) + 1 == ne)
 			{
-				nl_double *Aj = &A(j, 0);
-				const nl_double f1 = -f * Aj[i];
-				for (std::size_t k : nzrd)
-					Aj[k] += Ai[k] * f1;
-				//RHS(j) += RHS(i) * f1;
+				const std::size_t first = nzrd.front();
+				const nl_double * RESTRICT pi = &Ai[first];
+				for (std::size_t j : nzbd)
+				{
+					nl_double *Aj = &A(j, 0);
+					const nl_double f1 = -f * Aj[i];
+					vec_add_mult_scalar_p(ne, pi, f1, &Aj[first]);
+				}
+			}
+			else
+			{
+				for (std::size_t j : nzbd)
+				{
+					nl_double *Aj = &A(j, 0);
+					const nl_double f1 = -f * Aj[i];
+					for (std::size_t k : nzrd)
+						Aj[k] += Ai[k] * f1;
+					//RHS(j) += RHS(i) * f1;
+				}
 			}
 		}
 	}
@@ -1063,13 +1063,41 @@ avhuff_error avhuff_decoder::decode_video_lossless(int width, int height, const
 	for (uint32_t dy = 0; dy < height; dy++)
 	{
 		uint8_t *row = dest + dy * dstride;
-		for (uint32_t dx = 0; dx < width / 2; dx++)
+		for (uint32_t dx = 0; dx < width / 2; )
 		{
-			row[0 ^ dxor] = m_ycontext.decode_one(bitbuf);
-			row[1 ^ dxor] = m_cbcontext.decode_one(bitbuf);
-			row[2 ^ dxor] = m_ycontext.decode_one(bitbuf);
-			row[3 ^ dxor] = m_crcontext.decode_one(bitbuf);
-			row += 4;
+			// if all three contexts are mid-run, fill whole pixel pairs in bulk
+			// without touching the bitstream; this is exactly what repeated
+			// decode_one calls would produce, but auto-vectorizes nicely on
+			// the flat regions that dominate typical laserdisc frames
+			int pairs = std::min(m_ycontext.rle_pending() / 2, std::min(m_cbcontext.rle_pending(), m_crcontext.rle_pending()));
+			pairs = std::min<int>(pairs, width / 2 - dx);
+			if (pairs > 1)
+			{
+				uint8_t const yval = m_ycontext.rle_value();
+				uint8_t const cbval = m_cbcontext.rle_value();
+				uint8_t const crval = m_crcontext.rle_value();
+				for (int pair = 0; pair < pairs; pair++)
+				{
+					row[0 ^ dxor] = yval;
+					row[1 ^ dxor] = cbval;
+					row[2 ^ dxor] = yval;
+					row[3 ^ dxor] = crval;
+					row += 4;
+				}
+				m_ycontext.consume_rle(2 * pairs);
+				m_cbcontext.consume_rle(pairs);
+				m_crcontext.consume_rle(pairs);
+				dx += pairs;
+			}
+			else
+			{
+				row[0 ^ dxor] = m_ycontext.decode_one(bitbuf);
+				row[1 ^ dxor] = m_cbcontext.decode_one(bitbuf);
+				row[2 ^ dxor] = m_ycontext.decode_one(bitbuf);
+				row[3 ^ dxor] = m_crcontext.decode_one(bitbuf);
+				row += 4;
+				dx++;
+			}
 		}
 		m_ycontext.flush_rle();
 		m_cbcontext.flush_rle();
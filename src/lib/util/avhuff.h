@@ -169,6 +169,12 @@ private:
 		uint32_t decode_one(bitstream_in &bitbuf);
 		huffman_error import_tree_rle(bitstream_in &bitbuf) { return m_decoder.import_tree_rle(bitbuf); }
 
+		// bulk access to a pending run, letting callers fill several
+		// outputs without a decode_one call per byte
+		int rle_pending() const { return m_rlecount; }
+		uint8_t rle_value() const { return m_prevdata; }
+		void consume_rle(int count) { m_rlecount -= count; }
+
 	private:
 		// internal state
 		int                         m_rlecount;
@@ -11,11 +11,112 @@
 #include <assert.h>
 
 #include "bitmap.h"
+#include "coretmpl.h"
 
+#include <atomic>
 #include <new>
 
 
 
+//**************************************************************************
+//  BITMAP MEMORY POOL
+//**************************************************************************
+
+namespace {
+
+// allocations are rounded up to power-of-two buckets and recycled through
+// per-bucket lock-free stacks, so devices that allocate scratch bitmaps per
+// frame don't contend on the global allocator with the OSD threads; blocks
+// stay pooled until process exit
+constexpr int POOL_BUCKET_SHIFT = 12;   // smallest bucket: 4KB
+constexpr int POOL_BUCKET_COUNT = 12;   // largest bucket: 8MB
+
+struct pool_node
+{
+	pool_node *next;
+};
+
+std::atomic<pool_node *> s_pool_buckets[POOL_BUCKET_COUNT];
+
+
+//-------------------------------------------------
+//  pool_bucket_for - round a byte count up to its
+//  bucket capacity; returns -1 for oversized
+//  requests, which bypass the pool
+//-------------------------------------------------
+
+int pool_bucket_for(uint32_t &bytes)
+{
+	for (int bucket = 0; bucket < POOL_BUCKET_COUNT; bucket++)
+	{
+		uint32_t capacity = uint32_t(1) << (POOL_BUCKET_SHIFT + bucket);
+		if (bytes <= capacity)
+		{
+			bytes = capacity;
+			return bucket;
+		}
+	}
+	return -1;
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  pool_acquire - allocate a block, preferring a
+//  recycled one from the matching bucket
+//-------------------------------------------------
+
+uint8_t *bitmap_t::pool_acquire(uint32_t &bytes, int &bucket)
+{
+	bucket = pool_bucket_for(bytes);
+	if (bucket >= 0)
+	{
+		// grab the whole stack, keep the head and splice the rest back;
+		// taking the list in one exchange sidesteps the ABA problem a
+		// naive compare-and-swap pop would have
+		pool_node *list = s_pool_buckets[bucket].exchange(nullptr, std::memory_order_acquire);
+		if (list != nullptr)
+		{
+			pool_node *rest = list->next;
+			if (rest != nullptr)
+			{
+				pool_node *tail = rest;
+				while (tail->next != nullptr)
+					tail = tail->next;
+				pool_node *expected = s_pool_buckets[bucket].load(std::memory_order_relaxed);
+				do { tail->next = expected; } while (!s_pool_buckets[bucket].compare_exchange_weak(expected, rest, std::memory_order_release, std::memory_order_relaxed));
+			}
+			return reinterpret_cast<uint8_t *>(list);
+		}
+	}
+	return new uint8_t[bytes];
+}
+
+
+//-------------------------------------------------
+//  pool_release - return a block to its bucket
+//-------------------------------------------------
+
+void bitmap_t::pool_release(uint8_t *ptr, int bucket)
+{
+	if (ptr == nullptr)
+		return;
+
+	// oversized blocks were never pooled
+	if (bucket < 0)
+	{
+		delete[] ptr;
+		return;
+	}
+
+	pool_node *node = reinterpret_cast<pool_node *>(ptr);
+	pool_node *expected = s_pool_buckets[bucket].load(std::memory_order_relaxed);
+	do { node->next = expected; } while (!s_pool_buckets[bucket].compare_exchange_weak(expected, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+
 //**************************************************************************
 //  INLINE HELPERS
 //**************************************************************************
@@ -205,9 +306,13 @@ void bitmap_t::allocate(int width, int height, int xslop, int yslop)
 	m_height = height;
 	m_cliprect.set(0, width - 1, 0, height - 1);
 
-	// allocate memory for the bitmap itself
+	// allocate memory for the bitmap itself; the pool rounds m_allocbytes
+	// up to its bucket capacity, so same-geometry reallocation later is a
+	// pointer swap in resize()
 	m_allocbytes = m_rowpixels * (m_height + 2 * yslop) * m_bpp / 8;
-	m_alloc.reset(new uint8_t[m_allocbytes]);
+	int bucket;
+	uint8_t *block = pool_acquire(m_allocbytes, bucket);
+	m_alloc = std::unique_ptr<uint8_t [], pool_deleter>(block, pool_deleter(bucket));
 
 	// clear to 0 by default
 	memset(m_alloc.get(), 0, m_allocbytes);
@@ -404,18 +509,13 @@ void bitmap_t::fill(uint32_t color, const rectangle &cliprect)
 			}
 			else
 			{
-				// Fill the first line the hard way
-				uint16_t *destrow = &pixt<uint16_t>(fill.top());
-				for (int32_t x = fill.left(); x <= fill.right(); x++)
-					destrow[x] = uint16_t(color);
+				// Fill the first line with word-replicated stores
+				uint16_t *destrow0 = &pixt<uint16_t>(fill.top(), fill.left());
+				util::block_fill(destrow0, uint16_t(color), fill.width());
 
 				// For the other lines, just copy the first one
-				void *destrow0 = &pixt<uint16_t>(fill.top(), fill.left());
 				for (int32_t y = fill.top() + 1; y <= fill.bottom(); y++)
-				{
-					destrow = &pixt<uint16_t>(y, fill.left());
-					memcpy(destrow, destrow0, fill.width() * 2);
-				}
+					memcpy(&pixt<uint16_t>(y, fill.left()), destrow0, fill.width() * 2);
 			}
 			break;
 
@@ -428,18 +528,13 @@ void bitmap_t::fill(uint32_t color, const rectangle &cliprect)
 			}
 			else
 			{
-				// Fill the first line the hard way
-				uint32_t *destrow  = &pixt<uint32_t>(fill.top());
-				for (int32_t x = fill.left(); x <= fill.right(); x++)
-					destrow[x] = uint32_t(color);
+				// Fill the first line with word-replicated stores
+				uint32_t *destrow0 = &pixt<uint32_t>(fill.top(), fill.left());
+				util::block_fill(destrow0, uint32_t(color), fill.width());
 
 				// For the other lines, just copy the first one
-				uint32_t *destrow0 = &pixt<uint32_t>(fill.top(), fill.left());
 				for (int32_t y = fill.top() + 1; y <= fill.bottom(); y++)
-				{
-					destrow = &pixt<uint32_t>(y, fill.left());
-					memcpy(destrow, destrow0, fill.width() * 4);
-				}
+					memcpy(&pixt<uint32_t>(y, fill.left()), destrow0, fill.width() * 4);
 			}
 			break;
 
@@ -452,18 +547,13 @@ void bitmap_t::fill(uint32_t color, const rectangle &cliprect)
 			}
 			else
 			{
-				// Fill the first line the hard way
-				uint64_t *destrow  = &pixt<uint64_t>(fill.top());
-				for (int32_t x = fill.left(); x <= fill.right(); x++)
-					destrow[x] = uint64_t(color);
+				// Fill the first line
+				uint64_t *destrow0 = &pixt<uint64_t>(fill.top(), fill.left());
+				util::block_fill(destrow0, uint64_t(color), fill.width());
 
 				// For the other lines, just copy the first one
-				uint64_t *destrow0 = &pixt<uint64_t>(fill.top(), fill.left());
 				for (int32_t y = fill.top() + 1; y <= fill.bottom(); y++)
-				{
-					destrow = &pixt<uint64_t>(y, fill.left());
-					memcpy(destrow, destrow0, fill.width() * 8);
-				}
+					memcpy(&pixt<uint64_t>(y, fill.left()), destrow0, fill.width() * 8);
 			}
 			break;
 	}
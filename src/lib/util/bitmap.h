@@ -175,8 +175,21 @@ private:
 	int32_t compute_rowpixels(int width, int xslop);
 	void compute_base(int xslop, int yslop);
 
+	// size-bucketed lock-free pool backing per-frame allocations; freed
+	// blocks are recycled by bucket instead of hitting the global allocator
+	static uint8_t *pool_acquire(uint32_t &bytes, int &bucket);
+	static void pool_release(uint8_t *ptr, int bucket);
+
+	struct pool_deleter
+	{
+		pool_deleter() : bucket(-1) { }
+		pool_deleter(int b) : bucket(b) { }
+		void operator()(uint8_t *ptr) const { pool_release(ptr, bucket); }
+		int bucket;                             // source bucket, or -1 for plain new[]
+	};
+
 	// internal state
-	std::unique_ptr<uint8_t []> m_alloc;        // pointer to allocated pixel memory
+	std::unique_ptr<uint8_t [], pool_deleter> m_alloc; // pointer to allocated pixel memory
 	uint32_t                    m_allocbytes;   // size of our allocation
 	void *                      m_base;         // pointer to pixel (0,0) (adjusted for padding)
 	int32_t                     m_rowpixels;    // pixels per row (including padding)
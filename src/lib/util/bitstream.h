@@ -39,7 +39,7 @@ public:
 
 private:
 	// internal state
-	uint32_t          m_buffer;       // current bit accumulator
+	uint64_t          m_buffer;       // current bit accumulator
 	int             m_bits;         // number of bits in the accumulator
 	const uint8_t *   m_read;         // read pointer
 	uint32_t          m_doffset;      // byte offset within the data
@@ -103,17 +103,36 @@ inline uint32_t bitstream_in::peek(int numbits)
 	// fetch data if we need more
 	if (numbits > m_bits)
 	{
-		while (m_bits <= 24)
+		// common case: at least eight bytes are in bounds, so top up the
+		// accumulator with a single unaligned load instead of a bounds-
+		// checked byte loop; only whole bytes are consumed so the flush
+		// and overflow accounting are unaffected
+		if (m_doffset + 8 <= m_dlength)
 		{
-			if (m_doffset < m_dlength)
-				m_buffer |= m_read[m_doffset] << (24 - m_bits);
-			m_doffset++;
-			m_bits += 8;
+			uint64_t chunk;
+			memcpy(&chunk, &m_read[m_doffset], sizeof(chunk));
+			int const added = (64 - m_bits) & ~7;
+			m_buffer |= (big_endianize_int64(chunk) & (~uint64_t(0) << (64 - added))) >> m_bits;
+			m_doffset += added >> 3;
+			m_bits += added;
+		}
+
+		// near the end of the buffer, fall back to the guarded byte loop,
+		// padding with zeroes past the end as before
+		else
+		{
+			while (m_bits <= 56)
+			{
+				if (m_doffset < m_dlength)
+					m_buffer |= uint64_t(m_read[m_doffset]) << (56 - m_bits);
+				m_doffset++;
+				m_bits += 8;
+			}
 		}
 	}
 
 	// return the data
-	return m_buffer >> (32 - numbits);
+	return m_buffer >> (64 - numbits);
 }
 
 
@@ -23,6 +23,15 @@
 #include <new>
 #include "eminline.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -189,7 +198,9 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// seek and read; the lock keeps the prefetch worker's seeks from
+	// interleaving with ours
+	std::lock_guard<std::mutex> lock(m_io_mutex);
 	m_file->seek(offset, SEEK_SET);
 	uint32_t count = m_file->read(dest, length);
 	if (count != length)
@@ -293,6 +304,13 @@ chd_file::chd_file()
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_prefetch_decompressor, 0, sizeof(m_prefetch_decompressor));
+	m_prefetch_exit = false;
+	m_filemap = nullptr;
+	m_filemap_size = 0;
+#ifdef _WIN32
+	m_filemap_handle = nullptr;
+#endif
 	close();
 }
 
@@ -761,6 +779,12 @@ chd_error chd_file::open(const char *filename, bool writeable, chd_file *parent)
 	// we now own this file
 	file.release();
 	m_owns_file = true;
+
+	// read-only uncompressed files can be served out of a memory mapping,
+	// skipping the seek/read syscalls per hunk; failure just means the
+	// normal path is used
+	if (!writeable && !compressed() && m_version == 5)
+		map_file(filename);
 	return err;
 }
 
@@ -801,6 +825,30 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// stop the prefetch worker before the file goes away
+	if (m_prefetch_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+			m_prefetch_exit = true;
+		}
+		m_prefetch_wake.notify_all();
+		m_prefetch_thread.join();
+		m_prefetch_thread = std::thread();
+	}
+	m_prefetch_exit = false;
+	m_prefetch_broken = false;
+	m_prefetch_queue.clear();
+	for (auto & elem : m_prefetch_decompressor)
+	{
+		delete elem;
+		elem = nullptr;
+	}
+	m_prefetch_compressed.clear();
+
+	// tear down any memory mapping
+	unmap_file();
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -844,6 +892,8 @@ void chd_file::close()
 	// reset caching
 	m_cache.clear();
 	m_cachehunk = ~0;
+	m_hunkcache.clear();
+	m_last_read_hunk = ~0;
 }
 
 /**
@@ -882,6 +932,21 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 		if (hunknum >= m_hunkcount)
 			throw CHDERR_HUNK_OUT_OF_RANGE;
 
+		// readahead only runs on read-only compressed files, where it pays
+		// off and where the worker can never race a write
+		if (compressed() && !m_allow_writes && buffer != nullptr)
+		{
+			// on sequential access, queue the next hunks for the worker
+			if (hunknum == m_last_read_hunk + 1)
+				for (uint32_t ahead = 1; ahead <= PREFETCH_DEPTH; ahead++)
+					schedule_prefetch(hunknum + ahead);
+			m_last_read_hunk = hunknum;
+
+			// a cache hit skips the decode entirely
+			if (hunk_cache_lookup(hunknum, buffer))
+				return CHDERR_NONE;
+		}
+
 		// get a pointer to the map entry
 		uint64_t blockoffs;
 		uint32_t blocklen;
@@ -939,7 +1004,14 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 				{
 					blockoffs = uint64_t(be_read(rawmap, 4)) * uint64_t(m_hunkbytes);
 					if (blockoffs != 0)
-						file_read(blockoffs, dest, m_hunkbytes);
+					{
+						// serve from the memory mapping when available
+						const uint8_t *mapped = hunk_ptr(hunknum);
+						if (mapped != nullptr)
+							memcpy(dest, mapped, m_hunkbytes);
+						else
+							file_read(blockoffs, dest, m_hunkbytes);
+					}
 					else if (m_parent_missing)
 						throw CHDERR_REQUIRES_PARENT;
 					else if (m_parent != nullptr)
@@ -995,6 +1067,390 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 	}
 }
 
+/**
+ * @fn  chd_error chd_file::read_hunk_async(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunk_async - queue a hunk for background decode so a
+ *            later read_hunk can overlap with other work
+ *          -------------------------------------------------.
+ *
+ * The hunk is decoded on the prefetch worker into the LRU cache; there
+ * is no completion callback. A subsequent read_hunk for the same hunk
+ * returns the cached data, or falls back to a synchronous decode if the
+ * worker has not gotten to it yet. On files where readahead is inactive
+ * (uncompressed or writeable) this is a no-op.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::read_hunk_async(uint32_t hunknum)
+{
+	// punt if no file
+	if (m_file == nullptr)
+		return CHDERR_NOT_OPEN;
+
+	// return an error if out of range
+	if (hunknum >= m_hunkcount)
+		return CHDERR_HUNK_OUT_OF_RANGE;
+
+	// only useful where readahead is active
+	if (compressed() && !m_allow_writes)
+		schedule_prefetch(hunknum);
+	return CHDERR_NONE;
+}
+
+/**
+ * @fn  const uint8_t *chd_file::hunk_ptr(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_ptr - return a zero-copy pointer to a hunk's data in
+ *            the file mapping, or nullptr when unavailable
+ *          -------------------------------------------------.
+ *
+ * Only read-only uncompressed v5 files opened by filename are mapped;
+ * hunks that live in the parent (or are unallocated) also return
+ * nullptr, so callers must be prepared to fall back to read_hunk.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  Pointer to m_hunkbytes of data, or nullptr.
+ */
+
+const uint8_t *chd_file::hunk_ptr(uint32_t hunknum)
+{
+	if (m_filemap == nullptr || hunknum >= m_hunkcount)
+		return nullptr;
+
+	// v5 uncompressed map entries only
+	const uint8_t *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+	uint64_t blockoffs = uint64_t(be_read(rawmap, 4)) * uint64_t(m_hunkbytes);
+	if (blockoffs == 0 || blockoffs + m_hunkbytes > m_filemap_size)
+		return nullptr;
+	return m_filemap + blockoffs;
+}
+
+/**
+ * @fn  void chd_file::map_file(const char *filename)
+ *
+ * @brief   -------------------------------------------------
+ *            map_file - map the file read-only into memory; on any
+ *            failure the mapping stays inactive and reads use the
+ *            normal file path
+ *          -------------------------------------------------.
+ *
+ * @param   filename    Filename of the file.
+ */
+
+void chd_file::map_file(const char *filename)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return;
+
+	void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (base == nullptr)
+	{
+		CloseHandle(mapping);
+		return;
+	}
+
+	m_filemap = reinterpret_cast<const uint8_t *>(base);
+	m_filemap_size = size.QuadPart;
+	m_filemap_handle = mapping;
+#else
+	int fd = ::open(filename, O_RDONLY);
+	if (fd == -1)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return;
+	}
+
+	void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (base == MAP_FAILED)
+		return;
+
+	m_filemap = reinterpret_cast<const uint8_t *>(base);
+	m_filemap_size = st.st_size;
+#endif
+}
+
+/**
+ * @fn  void chd_file::unmap_file()
+ *
+ * @brief   -------------------------------------------------
+ *            unmap_file - release the memory mapping, if any
+ *          -------------------------------------------------.
+ */
+
+void chd_file::unmap_file()
+{
+	if (m_filemap == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(const_cast<uint8_t *>(m_filemap));
+	CloseHandle(m_filemap_handle);
+	m_filemap_handle = nullptr;
+#else
+	munmap(const_cast<uint8_t *>(m_filemap), m_filemap_size);
+#endif
+	m_filemap = nullptr;
+	m_filemap_size = 0;
+}
+
+/**
+ * @fn  bool chd_file::hunk_cache_lookup(uint32_t hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_cache_lookup - copy a hunk out of the LRU cache,
+ *            returning false on a miss
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  The destination buffer.
+ *
+ * @return  true on a cache hit.
+ */
+
+bool chd_file::hunk_cache_lookup(uint32_t hunknum, void *buffer)
+{
+	std::lock_guard<std::mutex> lock(m_hunkcache_mutex);
+	for (auto it = m_hunkcache.begin(); it != m_hunkcache.end(); ++it)
+		if (it->first == hunknum)
+		{
+			memcpy(buffer, &it->second[0], m_hunkbytes);
+
+			// move to the front of the LRU order
+			if (it != m_hunkcache.begin())
+				m_hunkcache.splice(m_hunkcache.begin(), m_hunkcache, it);
+			return true;
+		}
+	return false;
+}
+
+/**
+ * @fn  void chd_file::hunk_cache_insert(uint32_t hunknum, std::vector<uint8_t> &&data)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_cache_insert - add a decoded hunk to the LRU cache,
+ *            evicting the oldest entry when full
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  data    The decoded hunk data; consumed.
+ */
+
+void chd_file::hunk_cache_insert(uint32_t hunknum, std::vector<uint8_t> &&data)
+{
+	std::lock_guard<std::mutex> lock(m_hunkcache_mutex);
+
+	// skip if another thread already cached it
+	for (auto &entry : m_hunkcache)
+		if (entry.first == hunknum)
+			return;
+
+	m_hunkcache.emplace_front(hunknum, std::move(data));
+	while (m_hunkcache.size() > HUNK_CACHE_ENTRIES)
+		m_hunkcache.pop_back();
+}
+
+/**
+ * @fn  void chd_file::schedule_prefetch(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            schedule_prefetch - hand a hunk to the decode worker,
+ *            starting the worker on first use
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ */
+
+void chd_file::schedule_prefetch(uint32_t hunknum)
+{
+	// nothing past the end, and nothing if the worker codecs failed
+	if (hunknum >= m_hunkcount || m_prefetch_broken)
+		return;
+
+	// start the worker lazily; it needs its own codec instances since
+	// chd_decompressor state is not shareable across threads
+	if (!m_prefetch_thread.joinable())
+	{
+		for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_compression); decompnum++)
+		{
+			m_prefetch_decompressor[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+			if (m_prefetch_decompressor[decompnum] == nullptr && m_compression[decompnum] != 0)
+			{
+				m_prefetch_broken = true;
+				return;
+			}
+		}
+		m_prefetch_compressed.resize(m_hunkbytes);
+		m_prefetch_thread = std::thread([this]() { prefetch_worker(); });
+	}
+
+	std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+	for (uint32_t queued : m_prefetch_queue)
+		if (queued == hunknum)
+			return;
+	m_prefetch_queue.push_back(hunknum);
+	m_prefetch_wake.notify_all();
+}
+
+/**
+ * @fn  void chd_file::prefetch_worker()
+ *
+ * @brief   -------------------------------------------------
+ *            prefetch_worker - decode queued hunks into the LRU cache
+ *          -------------------------------------------------.
+ */
+
+void chd_file::prefetch_worker()
+{
+	std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+	while (true)
+	{
+		while (!m_prefetch_exit && m_prefetch_queue.empty())
+			m_prefetch_wake.wait(lock);
+		if (m_prefetch_exit)
+			return;
+
+		uint32_t hunknum = m_prefetch_queue.front();
+		m_prefetch_queue.pop_front();
+		lock.unlock();
+
+		// skip hunks that arrived in the cache while queued
+		{
+			std::lock_guard<std::mutex> cachelock(m_hunkcache_mutex);
+			bool cached = false;
+			for (auto &entry : m_hunkcache)
+				if (entry.first == hunknum)
+				{
+					cached = true;
+					break;
+				}
+			if (cached)
+			{
+				lock.lock();
+				continue;
+			}
+		}
+
+		std::vector<uint8_t> data;
+		if (prefetch_decode(hunknum, data))
+			hunk_cache_insert(hunknum, std::move(data));
+
+		lock.lock();
+	}
+}
+
+/**
+ * @fn  bool chd_file::prefetch_decode(uint32_t hunknum, std::vector<uint8_t> &dest)
+ *
+ * @brief   -------------------------------------------------
+ *            prefetch_decode - worker-side decode of the simple map
+ *            entry types; self/parent references and errors are left
+ *            for the synchronous path
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  dest    Receives the decoded hunk.
+ *
+ * @return  true if the hunk was decoded.
+ */
+
+bool chd_file::prefetch_decode(uint32_t hunknum, std::vector<uint8_t> &dest)
+{
+	try
+	{
+		dest.resize(m_hunkbytes);
+		uint64_t blockoffs;
+		uint32_t blocklen;
+		util::crc32_t blockcrc;
+		uint8_t *rawmap;
+		switch (m_version)
+		{
+			// v3/v4 map entries
+			case 3:
+			case 4:
+				rawmap = &m_rawmap[16 * hunknum];
+				blockoffs = be_read(&rawmap[0], 8);
+				blockcrc = be_read(&rawmap[8], 4);
+				switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+				{
+					case V34_MAP_ENTRY_TYPE_COMPRESSED:
+						blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+						file_read(blockoffs, &m_prefetch_compressed[0], blocklen);
+						m_prefetch_decompressor[0]->decompress(&m_prefetch_compressed[0], blocklen, &dest[0], m_hunkbytes);
+						if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && util::crc32_creator::simple(&dest[0], m_hunkbytes) != blockcrc)
+							return false;
+						return true;
+
+					case V34_MAP_ENTRY_TYPE_UNCOMPRESSED:
+						file_read(blockoffs, &dest[0], m_hunkbytes);
+						if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && util::crc32_creator::simple(&dest[0], m_hunkbytes) != blockcrc)
+							return false;
+						return true;
+				}
+				return false;
+
+			// v5 map entries
+			case 5:
+				rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+				blocklen = be_read(&rawmap[1], 3);
+				blockoffs = be_read(&rawmap[4], 6);
+				blockcrc = be_read(&rawmap[10], 2);
+				switch (rawmap[0])
+				{
+					case COMPRESSION_TYPE_0:
+					case COMPRESSION_TYPE_1:
+					case COMPRESSION_TYPE_2:
+					case COMPRESSION_TYPE_3:
+						file_read(blockoffs, &m_prefetch_compressed[0], blocklen);
+						m_prefetch_decompressor[rawmap[0]]->decompress(&m_prefetch_compressed[0], blocklen, &dest[0], m_hunkbytes);
+						if (!m_prefetch_decompressor[rawmap[0]]->lossy() && util::crc16_creator::simple(&dest[0], m_hunkbytes) != blockcrc)
+							return false;
+						if (m_prefetch_decompressor[rawmap[0]]->lossy() && util::crc16_creator::simple(&m_prefetch_compressed[0], blocklen) != blockcrc)
+							return false;
+						return true;
+
+					case COMPRESSION_NONE:
+						file_read(blockoffs, &dest[0], m_hunkbytes);
+						if (util::crc16_creator::simple(&dest[0], m_hunkbytes) != blockcrc)
+							return false;
+						return true;
+				}
+				return false;
+		}
+		return false;
+	}
+	catch (chd_error &)
+	{
+		// errors surface on the synchronous path instead
+		return false;
+	}
+}
+
 /**
  * @fn  chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
  *
@@ -2758,6 +3214,10 @@ chd_file_compressor::chd_file_compressor()
 		m_read_queue_offset(0),
 		m_read_done_offset(0),
 		m_read_error(false),
+		m_read_chunk_hunks(WORK_BUFFER_HUNKS / 2),
+		m_read_depth(2),
+		m_hash_queue(nullptr),
+		m_hash_done_offset(0),
 		m_work_queue(nullptr),
 		m_write_hunk(0)
 {
@@ -2766,6 +3226,7 @@ chd_file_compressor::chd_file_compressor()
 
 	// allocate work queues
 	m_read_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	m_hash_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 	m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
 
@@ -2781,6 +3242,7 @@ chd_file_compressor::~chd_file_compressor()
 {
 	// free the work queues
 	osd_work_queue_free(m_read_queue);
+	osd_work_queue_free(m_hash_queue);
 	osd_work_queue_free(m_work_queue);
 
 	// delete allocated arrays
@@ -2788,6 +3250,30 @@ chd_file_compressor::~chd_file_compressor()
 		delete elem;
 }
 
+/**
+ * @fn  void chd_file_compressor::set_readahead(uint32_t chunk_hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_readahead - configure how finely source reads are staged
+ *          -------------------------------------------------.
+ *
+ * @param   chunk_hunks Hunks per queued read; rounded down to a power of
+ *                      two so chunks never straddle the ring buffer.
+ */
+
+void chd_file_compressor::set_readahead(uint32_t chunk_hunks)
+{
+	// clamp and round down to a power of two
+	chunk_hunks = std::max(chunk_hunks, uint32_t(1));
+	chunk_hunks = std::min(chunk_hunks, uint32_t(WORK_BUFFER_HUNKS / 2));
+	while (chunk_hunks & (chunk_hunks - 1))
+		chunk_hunks &= chunk_hunks - 1;
+
+	// keep enough reads in flight to cover the whole work buffer
+	m_read_chunk_hunks = chunk_hunks;
+	m_read_depth = WORK_BUFFER_HUNKS / chunk_hunks;
+}
+
 /**
  * @fn  void chd_file_compressor::compress_begin()
  *
@@ -2812,6 +3298,7 @@ void chd_file_compressor::compress_begin()
 	m_read_queue_offset = 0;
 	m_read_done_offset = 0;
 	m_read_error = false;
+	m_hash_done_offset = 0;
 
 	// reset work item state
 	m_work_buffer.resize(hunk_bytes() * (WORK_BUFFER_HUNKS + 1));
@@ -2857,11 +3344,13 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 		return CHDERR_READ_ERROR;
 
 	// if done reading, queue some more
-	while (m_read_queue_offset < m_logicalbytes && osd_work_queue_items(m_read_queue) < 2)
+	const uint64_t work_buffer_bytes = uint64_t(WORK_BUFFER_HUNKS) * hunk_bytes();
+	const uint64_t chunk_bytes = uint64_t(m_read_chunk_hunks) * hunk_bytes();
+	while (m_read_queue_offset < m_logicalbytes && osd_work_queue_items(m_read_queue) < m_read_depth)
 	{
-		// see if we have enough free work items to read the next half of a buffer
+		// see if we have enough free work items to read the next chunk of the buffer
 		uint32_t startitem = m_read_queue_offset / hunk_bytes();
-		uint32_t enditem = startitem + WORK_BUFFER_HUNKS / 2;
+		uint32_t enditem = startitem + m_read_chunk_hunks;
 		uint32_t curitem;
 		for (curitem = startitem; curitem < enditem; curitem++)
 			if (m_work_item[curitem % WORK_BUFFER_HUNKS].m_status != WS_READY)
@@ -2876,11 +3365,16 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 		if (m_walking_parent && m_work_item[curitem % WORK_BUFFER_HUNKS].m_status != WS_READY)
 			break;
 
+		// don't overwrite data the running SHA-1 hasn't consumed yet
+		if (!m_walking_parent && compressed() && m_read_queue_offset + chunk_bytes > work_buffer_bytes &&
+			m_hash_done_offset < m_read_queue_offset + chunk_bytes - work_buffer_bytes)
+			break;
+
 		// queue the next read
 		for (curitem = startitem; curitem < enditem; curitem++)
 			m_work_item[curitem % WORK_BUFFER_HUNKS].m_status = WS_READING;
 		osd_work_item_queue(m_read_queue, async_read_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
-		m_read_queue_offset += WORK_BUFFER_HUNKS * hunk_bytes() / 2;
+		m_read_queue_offset += chunk_bytes;
 	}
 
 	// flush out any finished items
@@ -2960,6 +3454,7 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 			{
 				m_walking_parent = false;
 				m_read_queue_offset = m_read_done_offset = 0;
+				m_hash_done_offset = 0;
 				m_write_hunk = 0;
 				for (auto & elem : m_work_item)
 					elem.m_status = WS_READY;
@@ -2971,6 +3466,7 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 				osd_work_queue_wait(m_read_queue, 30 * osd_ticks_per_second());
 				if (!compressed())
 					return CHDERR_NONE;
+				osd_work_queue_wait(m_hash_queue, 30 * osd_ticks_per_second());
 				set_raw_sha1(m_compsha1.finish());
 				return compress_v5_map();
 			}
@@ -3119,7 +3615,7 @@ void chd_file_compressor::async_read()
 
 	// determine parameters for the read
 	uint32_t work_buffer_bytes = WORK_BUFFER_HUNKS * hunk_bytes();
-	uint32_t numbytes = work_buffer_bytes / 2;
+	uint32_t numbytes = m_read_chunk_hunks * hunk_bytes();
 	if (m_read_done_offset + numbytes > logical_bytes())
 		numbytes = logical_bytes() - m_read_done_offset;
 
@@ -3128,7 +3624,6 @@ void chd_file_compressor::async_read()
 	{
 		// do the read
 		uint8_t *dest = &m_work_buffer[0] + (m_read_done_offset % work_buffer_bytes);
-		assert(dest == &m_work_buffer[0] || dest == &m_work_buffer[work_buffer_bytes/2]);
 		uint64_t end_offset = m_read_done_offset + numbytes;
 
 		// if walking the parent, read in hunks from the parent CHD
@@ -3157,11 +3652,11 @@ void chd_file_compressor::async_read()
 			item.m_osd = osd_work_item_queue(m_work_queue, m_walking_parent ? async_walk_parent_static : async_compress_hunk_static, &item, 0);
 		}
 
-		// continue the running SHA-1
+		// hand the chunk to the hash thread to continue the running SHA-1
 		if (!m_walking_parent)
 		{
 			if (compressed())
-				m_compsha1.append(dest, numbytes);
+				osd_work_item_queue(m_hash_queue, async_hash_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
 			m_total_in += numbytes;
 		}
 
@@ -3180,6 +3675,46 @@ void chd_file_compressor::async_read()
 	}
 }
 
+/**
+ * @fn  void *chd_file_compressor::async_hash_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_hash - continue the running SHA-1 off the read thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the parameter.
+ * @param   threadid        The threadid.
+ *
+ * @return  null if it fails, else a void*.
+ */
+
+void *chd_file_compressor::async_hash_static(void *param, int threadid)
+{
+	reinterpret_cast<chd_file_compressor *>(param)->async_hash();
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file_compressor::async_hash()
+ *
+ * @brief   Asynchronous hash. One item is queued per completed read, and
+ *          the queue is single-threaded, so consuming chunks in read
+ *          order needs no further coordination.
+ */
+
+void chd_file_compressor::async_hash()
+{
+	uint64_t offset = m_hash_done_offset;
+	uint32_t numbytes = m_read_chunk_hunks * hunk_bytes();
+	if (offset + numbytes > logical_bytes())
+		numbytes = logical_bytes() - offset;
+
+	m_compsha1.append(&m_work_buffer[offset % (uint64_t(WORK_BUFFER_HUNKS) * hunk_bytes())], numbytes);
+
+	// publishing the new offset releases the buffer space for rereading
+	m_hash_done_offset = offset + numbytes;
+}
+
 
 
 //**************************************************************************
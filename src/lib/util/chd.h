@@ -22,6 +22,12 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 /***************************************************************************
 
@@ -308,6 +314,7 @@ public:
 
 	// getters
 	bool opened() const { return (m_file != nullptr); }
+	bool writeable() const { return m_allow_writes; }
 	uint32_t version() const { return m_version; }
 	uint64_t logical_bytes() const { return m_logicalbytes; }
 	uint32_t hunk_bytes() const { return m_hunkbytes; }
@@ -341,6 +348,8 @@ public:
 
 	// read/write
 	chd_error read_hunk(uint32_t hunknum, void *buffer);
+	chd_error read_hunk_async(uint32_t hunknum);
+	const uint8_t *hunk_ptr(uint32_t hunknum);
 	chd_error write_hunk(uint32_t hunknum, const void *buffer);
 	chd_error read_units(uint64_t unitnum, void *buffer, uint32_t count = 1);
 	chd_error write_units(uint64_t unitnum, const void *buffer, uint32_t count = 1);
@@ -396,6 +405,13 @@ private:
 	void hunk_copy_from_self(uint32_t hunknum, uint32_t otherhunk);
 	void hunk_copy_from_parent(uint32_t hunknum, uint64_t parentunit);
 	bool metadata_find(chd_metadata_tag metatag, int32_t metaindex, metadata_entry &metaentry, bool resume = false);
+	void map_file(const char *filename);
+	void unmap_file();
+	bool hunk_cache_lookup(uint32_t hunknum, void *buffer);
+	void hunk_cache_insert(uint32_t hunknum, std::vector<uint8_t> &&data);
+	void schedule_prefetch(uint32_t hunknum);
+	void prefetch_worker();
+	bool prefetch_decode(uint32_t hunknum, std::vector<uint8_t> &dest);
 	void metadata_set_previous_next(uint64_t prevoffset, uint64_t nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
@@ -437,6 +453,31 @@ private:
 	// caching
 	std::vector<uint8_t>          m_cache;            // single-hunk cache for partial reads/writes
 	uint32_t                  m_cachehunk;        // which hunk is in the cache?
+
+	// asynchronous readahead; only active for read-only compressed files,
+	// so the write paths never race the worker
+	static const uint32_t HUNK_CACHE_ENTRIES = 16;  // decompressed hunks kept in the LRU cache
+	static const uint32_t PREFETCH_DEPTH = 4;       // hunks decoded ahead on sequential access
+	std::mutex              m_io_mutex;         // serializes file access with the prefetcher
+	std::mutex              m_hunkcache_mutex;  // guards the LRU cache
+	std::list<std::pair<uint32_t, std::vector<uint8_t> > > m_hunkcache;  // LRU cache, front = most recent
+	uint32_t                m_last_read_hunk;   // last hunk read, for sequential detection
+	std::thread             m_prefetch_thread;  // lazily-started decode worker
+	std::mutex              m_prefetch_mutex;   // guards the prefetch queue
+	std::condition_variable m_prefetch_wake;    // wakes the worker
+	std::deque<uint32_t>    m_prefetch_queue;   // hunks queued for decode
+	bool                    m_prefetch_exit;    // tells the worker to stop
+	bool                    m_prefetch_broken;  // worker codecs unavailable; prefetch disabled
+	chd_decompressor *      m_prefetch_decompressor[4];  // worker-private codecs
+	std::vector<uint8_t>    m_prefetch_compressed;       // worker-private compressed buffer
+
+	// memory-mapped read path; active only for read-only uncompressed v5
+	// files opened by filename
+	const uint8_t *         m_filemap;          // base of the mapping, or nullptr
+	uint64_t                m_filemap_size;     // size of the mapping
+#ifdef _WIN32
+	void *                  m_filemap_handle;   // Win32 file mapping handle
+#endif
 };
 
 
@@ -454,6 +495,11 @@ public:
 	void compress_begin();
 	chd_error compress_continue(double &progress, double &ratio);
 
+	// readahead tuning: each source read covers this many hunks, and enough
+	// reads stay in flight to cover the whole work buffer; smaller chunks
+	// keep the compressor threads fed from slow (spinning-disk) sources
+	void set_readahead(uint32_t chunk_hunks);
+
 protected:
 	// required override: read more data
 	virtual uint32_t read_data(void *dest, uint64_t offset, uint32_t length) = 0;
@@ -551,6 +597,8 @@ private:
 	void async_compress_hunk(work_item &item, int threadid);
 	static void *async_read_static(void *param, int threadid);
 	void async_read();
+	static void *async_hash_static(void *param, int threadid);
+	void async_hash();
 
 	// current compression status
 	bool                    m_walking_parent;   // are we building the parent map?
@@ -567,6 +615,13 @@ private:
 	uint64_t                  m_read_queue_offset;// next offset to enqueue
 	uint64_t                  m_read_done_offset; // next offset that will complete
 	bool                    m_read_error;       // error during reading?
+	uint32_t                  m_read_chunk_hunks; // hunks per queued read
+	uint32_t                  m_read_depth;       // maximum reads in flight
+
+	// running SHA-1 thread; the raw hash runs on its own single-threaded
+	// queue so it overlaps both reading and compression
+	osd_work_queue *        m_hash_queue;       // work queue for the running SHA-1
+	std::atomic<uint64_t>     m_hash_done_offset; // next offset to be hashed
 
 	// work item thread
 	static const int WORK_BUFFER_HUNKS = 256;
@@ -17,6 +17,7 @@
 
 #include <stdlib.h>
 
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <new>
@@ -26,15 +27,107 @@
 
 
 
+//**************************************************************************
+//  ALLOCATION TRACKING
+//**************************************************************************
+
+// optional per-subsystem attribution of the global_alloc family; disabled
+// (and nearly free) unless enabled() is switched on, typically from an
+// emu_options flag.  Subsystems mark their frame paths with a tag_scope and
+// the report shows which tag is allocating at what rate, so frame-loop
+// allocators can be found and moved onto pooled storage.
+
+namespace memtrack
+{
+
+enum tag_t
+{
+	TAG_OTHER = 0,
+	TAG_RENDER,
+	TAG_SOUND,
+	TAG_DEBUGGER,
+	TAG_NET,
+	TAG_COUNT
+};
+
+struct tag_stats
+{
+	std::atomic<unsigned long long> count;
+	std::atomic<unsigned long long> bytes;
+};
+
+inline bool &enabled()
+{
+	static bool s_enabled = false;
+	return s_enabled;
+}
+
+inline tag_stats &stats(int tag)
+{
+	static tag_stats s_stats[TAG_COUNT];
+	return s_stats[tag];
+}
+
+inline int &current_tag()
+{
+	static thread_local int s_tag = TAG_OTHER;
+	return s_tag;
+}
+
+inline const char *tag_name(int tag)
+{
+	static const char *const s_names[TAG_COUNT] = { "other", "render", "sound", "debugger", "net" };
+	return s_names[tag];
+}
+
+inline void track(std::size_t size)
+{
+	if (enabled())
+	{
+		tag_stats &s = stats(current_tag());
+		s.count.fetch_add(1, std::memory_order_relaxed);
+		s.bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+}
+
+template<typename T>
+inline T *track_ptr(T *ptr)
+{
+	track(sizeof(T));
+	return ptr;
+}
+
+template<typename T>
+inline T *track_array(T *ptr, std::size_t num)
+{
+	track(sizeof(T) * num);
+	return ptr;
+}
+
+// RAII marker attributing allocations on the current thread to a tag
+class tag_scope
+{
+public:
+	tag_scope(int tag) : m_prev(current_tag()) { current_tag() = tag; }
+	~tag_scope() { current_tag() = m_prev; }
+
+private:
+	int m_prev;
+};
+
+} // namespace memtrack
+
+
+
 //**************************************************************************
 //  MACROS
 //**************************************************************************
 
 // global allocation helpers -- use these instead of new and delete
-#define global_alloc(Type)                          new Type
-#define global_alloc_nothrow(Type)                  new (std::nothrow) Type
-#define global_alloc_array(Type, Num)               new Type[Num]
-#define global_alloc_array_nothrow(Type, Num)       new (std::nothrow) Type[Num]
+#define global_alloc(Type)                          memtrack::track_ptr(new Type)
+#define global_alloc_nothrow(Type)                  memtrack::track_ptr(new (std::nothrow) Type)
+#define global_alloc_array(Type, Num)               memtrack::track_array(new Type[Num], Num)
+#define global_alloc_array_nothrow(Type, Num)       memtrack::track_array(new (std::nothrow) Type[Num], Num)
 #define global_free(Ptr)                            do { delete Ptr; } while (0)
 #define global_free_array(Ptr)                      do { delete[] Ptr; } while (0)
 
@@ -45,6 +138,7 @@ inline T* global_alloc_clear(Params &&... args)
 {
 	void *const ptr = ::operator new(sizeof(T)); // allocate memory
 	std::memset(ptr, 0, sizeof(T));
+	memtrack::track(sizeof(T));
 	return new(ptr) T(std::forward<Params>(args)...);
 }
 
@@ -54,6 +148,7 @@ inline T* global_alloc_array_clear(std::size_t num)
 	auto const size = sizeof(T) * num;
 	void *const ptr = new unsigned char[size]; // allocate memory
 	std::memset(ptr, 0, size);
+	memtrack::track(size);
 	return new(ptr) T[num]();
 }
 
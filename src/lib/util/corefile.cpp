@@ -292,6 +292,40 @@ private:
 };
 
 
+class core_dynamic_file : public core_text_file
+{
+public:
+	core_dynamic_file(std::uint32_t openflags)
+		: core_text_file(openflags)
+		, m_offset(0)
+	{
+	}
+
+	virtual osd_file::error compress(int level) override { return osd_file::error::INVALID_ACCESS; }
+
+	virtual int seek(std::int64_t offset, int whence) override;
+	virtual std::uint64_t tell() const override { return m_offset; }
+	virtual bool eof() const override { return m_offset >= m_storage.size(); }
+	virtual std::uint64_t size() const override { return m_storage.size(); }
+
+	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
+	virtual void const *buffer() override { return m_storage.empty() ? nullptr : &m_storage[0]; }
+
+	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override;
+	virtual osd_file::error truncate(std::uint64_t offset) override
+	{
+		m_storage.resize(std::size_t(offset), 0);
+		m_offset = (std::min<std::uint64_t>)(m_offset, offset);
+		return osd_file::error::NONE;
+	}
+	virtual osd_file::error flush() override { clear_putback(); return osd_file::error::NONE; }
+
+private:
+	std::vector<std::uint8_t>   m_storage;  // growable file data
+	std::uint64_t               m_offset;   // current file offset
+};
+
+
 class core_osd_file : public core_in_memory_file
 {
 public:
@@ -301,6 +335,9 @@ public:
 		, m_zdata()
 		, m_bufferbase(0)
 		, m_bufferbytes(0)
+		, m_gatherbase(0)
+		, m_gatherbytes(0)
+		, m_async_inflight(false)
 	{
 	}
 	~core_osd_file() override;
@@ -322,15 +359,24 @@ protected:
 
 private:
 	static constexpr std::size_t FILE_BUFFER_SIZE = 512;
+	static constexpr std::size_t GATHER_BUFFER_SIZE = 65536;
 
 	osd_file::error osd_or_zlib_read(void *buffer, std::uint64_t offset, std::uint32_t length, std::uint32_t &actual);
 	osd_file::error osd_or_zlib_write(void const *buffer, std::uint64_t offset, std::uint32_t length, std::uint32_t &actual);
 
+	osd_file::error flush_gather(bool allow_async);
+	void drain_async() { if (m_async_inflight) { osd_file_async_wait(); m_async_inflight = false; } }
+	static void gather_write_complete(void *param, osd_file::error filerr, std::uint32_t actual);
+
 	osd_file::ptr   m_file;                     // OSD file handle
 	zlib_data::ptr  m_zdata;                    // compression data
 	std::uint64_t   m_bufferbase;               // base offset of internal buffer
 	std::uint32_t   m_bufferbytes;              // bytes currently loaded into buffer
 	std::uint8_t    m_buffer[FILE_BUFFER_SIZE]; // buffer data
+	std::unique_ptr<std::uint8_t []> m_gather;  // gather-write buffer, allocated on first use
+	std::uint64_t   m_gatherbase;               // file offset of the first gathered byte
+	std::uint32_t   m_gatherbytes;              // bytes currently gathered
+	bool            m_async_inflight;           // asynchronous gather writes not yet drained
 };
 
 
@@ -724,6 +770,74 @@ std::size_t core_in_memory_file::safe_buffer_copy(
 
 
 
+/***************************************************************************
+    core_dynamic_file
+***************************************************************************/
+
+/*-------------------------------------------------
+    seek - seek within a growable RAM-based file
+-------------------------------------------------*/
+
+int core_dynamic_file::seek(std::int64_t offset, int whence)
+{
+	// flush any buffered char
+	clear_putback();
+
+	// switch off the relative location
+	switch (whence)
+	{
+	case SEEK_SET:
+		m_offset = offset;
+		break;
+
+	case SEEK_CUR:
+		m_offset += offset;
+		break;
+
+	case SEEK_END:
+		m_offset = m_storage.size() + offset;
+		break;
+	}
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    read - read from a growable RAM-based file
+-------------------------------------------------*/
+
+std::uint32_t core_dynamic_file::read(void *buffer, std::uint32_t length)
+{
+	clear_putback();
+
+	if (m_storage.empty() || (m_offset >= m_storage.size()))
+		return 0;
+
+	auto const bytes_read = (std::min<std::uint64_t>)(length, m_storage.size() - m_offset);
+	std::memcpy(buffer, &m_storage[std::size_t(m_offset)], std::size_t(bytes_read));
+	m_offset += bytes_read;
+	return std::uint32_t(bytes_read);
+}
+
+
+/*-------------------------------------------------
+    write - write to a growable RAM-based file,
+    extending it as necessary
+-------------------------------------------------*/
+
+std::uint32_t core_dynamic_file::write(void const *buffer, std::uint32_t length)
+{
+	clear_putback();
+
+	if (m_storage.size() < (m_offset + length))
+		m_storage.resize(std::size_t(m_offset + length), 0);
+	std::memcpy(&m_storage[std::size_t(m_offset)], buffer, length);
+	m_offset += length;
+	return length;
+}
+
+
+
 /***************************************************************************
     core_osd_file
 ***************************************************************************/
@@ -734,9 +848,11 @@ std::size_t core_in_memory_file::safe_buffer_copy(
 
 core_osd_file::~core_osd_file()
 {
-	// close files and free memory
+	// land any gathered writes, then close files and free memory
+	flush_gather(false);
 	if (m_zdata)
 		core_osd_file::compress(FCOMPRESS_NONE);
+	drain_async();
 }
 
 
@@ -754,6 +870,9 @@ osd_file::error core_osd_file::compress(int level)
 	if (read_access() && write_access())
 		return osd_file::error::INVALID_ACCESS;
 
+	// gathered writes must land before the compression state changes
+	flush_gather(false);
+
 	// if we have been compressing, flush and free the data
 	if (m_zdata && (level == FCOMPRESS_NONE))
 	{
@@ -835,6 +954,10 @@ std::uint32_t core_osd_file::read(void *buffer, std::uint32_t length)
 	// flush any buffered char
 	clear_putback();
 
+	// pending gather writes must land before we can read them back
+	flush_gather(false);
+	drain_async();
+
 	std::uint32_t bytes_read = 0;
 
 	// if we're within the buffer, consume that first
@@ -880,6 +1003,10 @@ void const *core_osd_file::buffer()
 	// if we already have data, just return it
 	if (!is_loaded() && length())
 	{
+		// pending gather writes must land before we slurp the file
+		flush_gather(false);
+		drain_async();
+
 		// allocate some memory
 		void *buf = allocate();
 		if (!buf) return nullptr;
@@ -915,16 +1042,84 @@ std::uint32_t core_osd_file::write(void const *buffer, std::uint32_t length)
 	// invalidate any buffered data
 	m_bufferbytes = 0;
 
-	// do the write
+	// large blocks bypass the gather buffer and go straight out
+	if (length >= GATHER_BUFFER_SIZE)
+	{
+		flush_gather(true);
+		std::uint32_t bytes_written = 0;
+		osd_or_zlib_write(buffer, offset(), length, bytes_written);
+		add_offset(bytes_written);
+		return bytes_written;
+	}
+
+	// a write that does not extend the gathered run flushes it first
+	if ((m_gatherbytes != 0) && (offset() != (m_gatherbase + m_gatherbytes)))
+		flush_gather(true);
+
+	// append to the gather buffer, submitting each block as it fills
 	std::uint32_t bytes_written = 0;
-	osd_or_zlib_write(buffer, offset(), length, bytes_written);
+	while (bytes_written < length)
+	{
+		if (!m_gather)
+			m_gather.reset(new (std::nothrow) std::uint8_t [GATHER_BUFFER_SIZE]);
+		if (!m_gather)
+			break;
+		if (m_gatherbytes == 0)
+			m_gatherbase = offset();
+		auto const copied = safe_buffer_copy(buffer, bytes_written, length, &m_gather[0], m_gatherbytes, GATHER_BUFFER_SIZE);
+		m_gatherbytes += copied;
+		bytes_written += copied;
+		add_offset(copied);
+		if ((m_gatherbytes == GATHER_BUFFER_SIZE) && (flush_gather(true) != osd_file::error::NONE))
+			break;
+	}
 
-	// return the number of bytes written
-	add_offset(bytes_written);
+	// return the number of bytes gathered
 	return bytes_written;
 }
 
 
+/*-------------------------------------------------
+    flush_gather - submit the gathered write run
+    as a single transfer; full blocks on plain
+    files go through the shared asynchronous I/O
+    queue, everything else lands synchronously
+-------------------------------------------------*/
+
+osd_file::error core_osd_file::flush_gather(bool allow_async)
+{
+	if (m_gatherbytes == 0)
+		return osd_file::error::NONE;
+
+	// compressed streams must feed zlib in order on this thread
+	std::uint32_t const bytes = m_gatherbytes;
+	m_gatherbytes = 0;
+	if (!allow_async || m_zdata)
+	{
+		std::uint32_t actual = 0;
+		return osd_or_zlib_write(&m_gather[0], m_gatherbase, bytes, actual);
+	}
+
+	// hand the filled buffer to the shared I/O queue; the completion
+	// callback owns it, and we allocate a fresh one on demand
+	std::uint8_t *const block = m_gather.release();
+	osd_file_write_async(*m_file, block, m_gatherbase, bytes, &core_osd_file::gather_write_complete, block);
+	m_async_inflight = true;
+	return osd_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    gather_write_complete - free a gather block
+    once its asynchronous write has landed
+-------------------------------------------------*/
+
+void core_osd_file::gather_write_complete(void *param, osd_file::error filerr, std::uint32_t actual)
+{
+	delete [] reinterpret_cast<std::uint8_t *>(param);
+}
+
+
 /*-------------------------------------------------
     truncate - truncate a file
 -------------------------------------------------*/
@@ -934,6 +1129,10 @@ osd_file::error core_osd_file::truncate(std::uint64_t offset)
 	if (is_loaded())
 		return core_in_memory_file::truncate(offset);
 
+	// land any gathered writes before changing the length
+	flush_gather(false);
+	drain_async();
+
 	// truncate file
 	auto const err = m_file->truncate(offset);
 	if (err != osd_file::error::NONE)
@@ -960,6 +1159,10 @@ osd_file::error core_osd_file::flush()
 	// invalidate any buffered data
 	m_bufferbytes = 0;
 
+	// land any gathered writes before flushing the backend
+	flush_gather(false);
+	drain_async();
+
 	return m_file->flush();
 }
 
@@ -1158,6 +1361,26 @@ osd_file::error core_file::open_ram_copy(void const *data, std::size_t length, s
 }
 
 
+/*-------------------------------------------------
+    open_ram_dynamic - open a growable RAM-based
+    "file" that supports writing and return an
+    error code
+-------------------------------------------------*/
+
+osd_file::error core_file::open_ram_dynamic(std::uint32_t openflags, ptr &file)
+{
+	try
+	{
+		file.reset(new core_dynamic_file(openflags));
+		return osd_file::error::NONE;
+	}
+	catch (...)
+	{
+		return osd_file::error::OUT_OF_MEMORY;
+	}
+}
+
+
 /*-------------------------------------------------
     open_proxy - open a proxy to an existing file
     object and return an error code
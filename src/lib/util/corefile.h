@@ -56,6 +56,9 @@ public:
 	// open a RAM-based "file" using the given data and length (read-only), copying the data
 	static osd_file::error open_ram_copy(const void *data, std::size_t length, std::uint32_t openflags, ptr &file);
 
+	// open a growable RAM-based "file" that supports writing
+	static osd_file::error open_ram_dynamic(std::uint32_t openflags, ptr &file);
+
 	// open a proxy "file" that forwards requests to another file object
 	static osd_file::error open_proxy(core_file &file, ptr &proxy);
 
@@ -19,6 +19,7 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -368,6 +369,76 @@ private:
 };
 
 
+// ======================> arena_allocator
+
+// arena_allocator behaves like fixed_allocator, but carves items out of
+// cache-line-aligned chunks so heavily-recycled objects stay packed in
+// memory instead of scattering across the heap
+template<class _ItemType, int _ItemsPerChunk = 64>
+class arena_allocator
+{
+	// we don't support deep copying
+	arena_allocator(const arena_allocator &);
+	arena_allocator &operator=(const arena_allocator &);
+
+	// round each item up to a cache line multiple so items never straddle lines
+	static constexpr std::size_t CACHE_LINE = 64;
+	static constexpr std::size_t ITEM_STRIDE = (sizeof(_ItemType) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+public:
+	// construction/destruction
+	arena_allocator()
+		: m_chunk_used(_ItemsPerChunk) { }
+
+	~arena_allocator()
+	{
+		// every slot ever handed out is still a live object; detach the free
+		// list so it doesn't try to delete arena-interior pointers, then run
+		// the destructors chunk by chunk
+		while (m_freelist.detach_head() != nullptr) { }
+		for (std::size_t chunknum = 0; chunknum < m_bases.size(); chunknum++)
+		{
+			int used = (chunknum == m_bases.size() - 1) ? m_chunk_used : _ItemsPerChunk;
+			for (int index = 0; index < used; index++)
+				reinterpret_cast<_ItemType *>(m_bases[chunknum] + index * ITEM_STRIDE)->~_ItemType();
+		}
+	}
+
+	// allocate a new item, either by recycling an old one, or by carving one from the arena
+	_ItemType *alloc()
+	{
+		_ItemType *result = m_freelist.detach_head();
+		if (result == nullptr)
+		{
+			// start a new chunk when the current one is exhausted
+			if (m_chunk_used == _ItemsPerChunk)
+			{
+				m_chunks.push_back(std::unique_ptr<char []>(new char[ITEM_STRIDE * _ItemsPerChunk + CACHE_LINE - 1]));
+				char *base = m_chunks.back().get();
+				m_bases.push_back(base + (CACHE_LINE - std::uintptr_t(base) % CACHE_LINE) % CACHE_LINE);
+				m_chunk_used = 0;
+			}
+			result = new(m_bases.back() + m_chunk_used++ * ITEM_STRIDE) _ItemType;
+		}
+		return result;
+	}
+
+	// reclaim an item by adding it to the free list
+	void reclaim(_ItemType *item) { if (item != nullptr) m_freelist.append(*item); }
+	void reclaim(_ItemType &item) { m_freelist.append(item); }
+
+	// reclaim all items from a list
+	void reclaim_all(simple_list<_ItemType> &_list) { m_freelist.append_list(_list); }
+
+private:
+	// internal state
+	simple_list<_ItemType>  m_freelist;     // list of free objects
+	std::vector<std::unique_ptr<char []>> m_chunks; // raw chunk storage
+	std::vector<char *>     m_bases;        // cache-line-aligned base of each chunk
+	int                     m_chunk_used;   // slots used in the most recent chunk
+};
+
+
 // ======================> contiguous_sequence_wrapper
 
 namespace util {
@@ -1010,6 +1081,67 @@ inline void reduce_fraction(M &num, N &den)
 	}
 }
 
+
+// ======================> block memory primitives
+
+// word-at-a-time helpers for hot block operations (save state comparison,
+// netplay delta scans, bitmap fills); loads and stores go through memcpy
+// so unaligned buffers are safe on every target, and the straight-line
+// word loops are the form compilers auto-vectorize
+
+// return the offset of the first byte at which a and b differ, or size if
+// the buffers are equal; unlike memcmp this reports where the mismatch
+// is, which is what delta encoders and desync localization need
+inline std::size_t first_difference(const void *a, const void *b, std::size_t size) noexcept
+{
+	const u8 *pa = reinterpret_cast<const u8 *>(a);
+	const u8 *pb = reinterpret_cast<const u8 *>(b);
+	std::size_t pos = 0;
+
+	// stride through the matching prefix a word at a time
+	while (pos + sizeof(u64) <= size)
+	{
+		u64 wa, wb;
+		std::memcpy(&wa, pa + pos, sizeof(wa));
+		std::memcpy(&wb, pb + pos, sizeof(wb));
+		if (wa != wb)
+			break;
+		pos += sizeof(u64);
+	}
+
+	// resolve the mismatching byte within the final word or the tail
+	while (pos < size && pa[pos] == pb[pos])
+		pos++;
+	return pos;
+}
+
+// true if the two buffers hold the same size bytes
+inline bool block_equal(const void *a, const void *b, std::size_t size) noexcept
+{
+	return first_difference(a, b, size) == size;
+}
+
+// fill count elements with value, replicating it across 64-bit words so
+// sub-word fills store eight bytes per iteration
+template <typename T>
+inline void block_fill(T *dest, T value, std::size_t count) noexcept
+{
+	static_assert(std::is_integral<T>::value && (sizeof(u64) % sizeof(T)) == 0, "block_fill requires an 8/16/32/64-bit element type");
+
+	u64 word = std::make_unsigned_t<T>(value);
+	for (unsigned bits = 8 * sizeof(T); bits < 8 * sizeof(u64); bits <<= 1)
+		word |= word << bits;
+
+	while (count >= sizeof(u64) / sizeof(T))
+	{
+		std::memcpy(dest, &word, sizeof(word));
+		dest += sizeof(u64) / sizeof(T);
+		count -= sizeof(u64) / sizeof(T);
+	}
+	while (count-- != 0)
+		*dest++ = value;
+}
+
 }; // namespace util
 
 #endif // MAME_UTIL_CORETMPL_H
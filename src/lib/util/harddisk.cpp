@@ -13,20 +13,99 @@
 #include "harddisk.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* number of hunks kept in the write-back cache */
+#define HARD_DISK_CACHE_HUNKS   8
 
 
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/* one hunk's worth of sectors, held for write coalescing */
+struct hard_disk_cached_hunk
+{
+	uint32_t            hunknum;            /* hunk number */
+	bool                dirty;              /* has unflushed sector writes? */
+	std::vector<uint8_t> data;              /* hunk contents */
+};
+
 struct hard_disk_file
 {
 	chd_file *          chd;                /* CHD file */
 	hard_disk_info      info;               /* hard disk info */
+	uint32_t            hunksectors;        /* sectors per hunk, or 0 if caching is off */
+	std::vector<hard_disk_cached_hunk> cache; /* write-back cache, front = most recent */
 };
 
 
 
+/***************************************************************************
+    INTERNAL HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    flush_hunk - write a dirty cached hunk back
+    to the CHD
+-------------------------------------------------*/
+
+static uint32_t flush_hunk(hard_disk_file *file, hard_disk_cached_hunk &hunk)
+{
+	if (!hunk.dirty)
+		return 1;
+	if (file->chd->write_hunk(hunk.hunknum, &hunk.data[0]) != CHDERR_NONE)
+		return 0;
+	hunk.dirty = false;
+	return 1;
+}
+
+
+/*-------------------------------------------------
+    get_cached_hunk - find or load the cache
+    entry for a hunk, evicting the oldest entry
+    (flushing it if dirty) when the cache is full
+-------------------------------------------------*/
+
+static hard_disk_cached_hunk *get_cached_hunk(hard_disk_file *file, uint32_t hunknum)
+{
+	/* look for an existing entry, moving a hit to the front */
+	for (auto it = file->cache.begin(); it != file->cache.end(); ++it)
+		if (it->hunknum == hunknum)
+		{
+			if (it != file->cache.begin())
+				std::rotate(file->cache.begin(), it, it + 1);
+			return &file->cache.front();
+		}
+
+	/* evict the oldest entry if full */
+	if (file->cache.size() >= HARD_DISK_CACHE_HUNKS)
+	{
+		if (!flush_hunk(file, file->cache.back()))
+			return nullptr;
+		file->cache.pop_back();
+	}
+
+	/* load the hunk into a fresh entry at the front */
+	hard_disk_cached_hunk hunk;
+	hunk.hunknum = hunknum;
+	hunk.dirty = false;
+	hunk.data.resize(file->chd->hunk_bytes());
+	if (file->chd->read_hunk(hunknum, &hunk.data[0]) != CHDERR_NONE)
+		return nullptr;
+	file->cache.insert(file->cache.begin(), std::move(hunk));
+	return &file->cache.front();
+}
+
+
+
 /***************************************************************************
     CORE IMPLEMENTATION
 ***************************************************************************/
@@ -57,7 +136,7 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 		return nullptr;
 
 	/* allocate memory for the hard disk file */
-	file = (hard_disk_file *)malloc(sizeof(hard_disk_file));
+	file = new (std::nothrow) hard_disk_file;
 	if (file == nullptr)
 		return nullptr;
 
@@ -67,6 +146,13 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 	file->info.heads = heads;
 	file->info.sectors = sectors;
 	file->info.sectorbytes = sectorbytes;
+
+	/* write coalescing requires a writeable CHD whose hunks are a whole
+	   number of sectors; read-only disks keep the direct path so writes
+	   fail immediately as before */
+	file->hunksectors = 0;
+	if (chd->writeable() && sectorbytes != 0 && chd->hunk_bytes() % sectorbytes == 0)
+		file->hunksectors = chd->hunk_bytes() / sectorbytes;
 	return file;
 }
 
@@ -77,7 +163,9 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 
 void hard_disk_close(hard_disk_file *file)
 {
-	free(file);
+	/* push out any coalesced writes before the handle goes away */
+	hard_disk_flush(file);
+	delete file;
 }
 
 
@@ -132,6 +220,15 @@ hard_disk_info *hard_disk_get_info(hard_disk_file *file)
 
 uint32_t hard_disk_read(hard_disk_file *file, uint32_t lbasector, void *buffer)
 {
+	/* serve from the write-back cache so pending writes are visible */
+	if (file->hunksectors != 0)
+		for (auto &hunk : file->cache)
+			if (hunk.hunknum == lbasector / file->hunksectors)
+			{
+				memcpy(buffer, &hunk.data[(lbasector % file->hunksectors) * file->info.sectorbytes], file->info.sectorbytes);
+				return 1;
+			}
+
 	chd_error err = file->chd->read_units(lbasector, buffer);
 	return (err == CHDERR_NONE);
 }
@@ -156,6 +253,43 @@ uint32_t hard_disk_read(hard_disk_file *file, uint32_t lbasector, void *buffer)
 
 uint32_t hard_disk_write(hard_disk_file *file, uint32_t lbasector, const void *buffer)
 {
+	/* coalesce bursts of sector writes into whole-hunk writebacks, so a
+	   run of writes costs one read-modify-write instead of one per sector */
+	if (file->hunksectors != 0)
+	{
+		hard_disk_cached_hunk *hunk = get_cached_hunk(file, lbasector / file->hunksectors);
+		if (hunk == nullptr)
+			return 0;
+		memcpy(&hunk->data[(lbasector % file->hunksectors) * file->info.sectorbytes], buffer, file->info.sectorbytes);
+		hunk->dirty = true;
+		return 1;
+	}
+
 	chd_error err = file->chd->write_units(lbasector, buffer);
 	return (err == CHDERR_NONE);
 }
+
+
+/*-------------------------------------------------
+    hard_disk_flush - write all dirty cached
+    hunks back to the CHD
+-------------------------------------------------*/
+
+/**
+ * @fn  uint32_t hard_disk_flush(hard_disk_file *file)
+ *
+ * @brief   Hard disk flush.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ *
+ * @return  An uint32_t.
+ */
+
+uint32_t hard_disk_flush(hard_disk_file *file)
+{
+	uint32_t result = 1;
+	for (auto &hunk : file->cache)
+		if (!flush_hunk(file, hunk))
+			result = 0;
+	return result;
+}
@@ -389,6 +389,7 @@ const char *core_options::simple_entry::maximum() const
 //-------------------------------------------------
 
 core_options::core_options()
+	: m_generation(1)
 {
 }
 
@@ -421,6 +422,7 @@ void core_options::add_entry(entry::shared_ptr &&entry, const char *after_header
 
 	// and add the entry to the vector
 	m_entries.emplace_back(std::move(entry));
+	m_generation++;
 }
 
 
@@ -562,6 +564,7 @@ void core_options::set_default_value(const char *name, const char *defvalue)
 {
 	// update the data and default data
 	get_entry(name)->set_default_value(defvalue);
+	m_generation++;
 }
 
 
@@ -786,6 +789,7 @@ void core_options::copy_from(const core_options &that)
 			}
 		}
 	}
+	m_generation++;
 }
 
 
@@ -917,6 +921,7 @@ void core_options::set_value(const std::string &name, const std::string &value,
 void core_options::set_value(const std::string &name, std::string &&value, int priority)
 {
 	get_entry(name)->set_value(std::move(value), priority);
+	m_generation++;
 }
 
 void core_options::set_value(const std::string &name, int value, int priority)
@@ -950,6 +955,7 @@ void core_options::remove_entry(core_options::entry &delentry)
 
 	// finally erase it
 	m_entries.erase(iter);
+	m_generation++;
 }
 
 
@@ -964,6 +970,7 @@ void core_options::do_set_value(entry &curentry, std::string &&data, int priorit
 	try
 	{
 		curentry.set_value(std::move(data), priority);
+		m_generation++;
 	}
 	catch (options_warning_exception &ex)
 	{
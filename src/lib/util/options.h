@@ -116,6 +116,9 @@ public:
 		const std::vector<std::string> &names() const { return m_names; }
 		const std::string &name() const { return m_names[0]; }
 		virtual const char *value() const;
+		bool bool_value() const { return int_value() != 0; }
+		int int_value() const { const char *data = value(); return data ? atoi(data) : 0; }
+		float float_value() const { const char *data = value(); return data ? atof(data) : 0.0f; }
 		int priority() const { return m_priority;  }
 		void set_priority(int priority) { m_priority = priority; }
 		option_type type() const { return m_type; }
@@ -161,6 +164,12 @@ public:
 	bool exists(const std::string &name) const { return get_entry(name) != nullptr; }
 	bool header_exists(const char *description) const;
 
+	// generation counter, bumped whenever an entry is added, removed or
+	// assigned a new value; frequent readers can resolve an entry handle
+	// once with get_entry, cache derived values, and re-read only when
+	// the generation changes instead of doing string lookups per access
+	uint32_t generation() const { return m_generation; }
+
 	// configuration
 	void add_entry(entry::shared_ptr &&entry, const char *after_header = nullptr);
 	void add_entry(const options_entry &entry, bool override_existing = false);
@@ -247,6 +256,7 @@ private:
 	// internal state
 	std::vector<entry::shared_ptr>                      m_entries;              // cannonical list of entries
 	std::unordered_map<std::string, entry::weak_ptr>    m_entrymap;             // map for fast lookup
+	uint32_t                                            m_generation;           // bumped on every mutation
 	std::string                                         m_command;              // command found
 	std::vector<std::string>                            m_command_arguments;    // command arguments
 	static const char *const                            s_option_unadorned[];   // array of unadorned option "names"
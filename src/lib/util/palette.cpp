@@ -100,6 +100,33 @@ void palette_client::dirty_state::mark_dirty(uint32_t index)
 }
 
 
+//-------------------------------------------------
+//  mark_dirty_range - mark a contiguous range of
+//  entries dirty, setting whole dwords at a time
+//-------------------------------------------------
+
+void palette_client::dirty_state::mark_dirty_range(uint32_t start, uint32_t end)
+{
+	uint32_t firstword = start / 32;
+	uint32_t lastword = end / 32;
+	uint32_t firstmask = ~uint32_t(0) << (start % 32);
+	uint32_t lastmask = ~uint32_t(0) >> (31 - (end % 32));
+
+	if (firstword == lastword)
+		m_dirty[firstword] |= firstmask & lastmask;
+	else
+	{
+		m_dirty[firstword] |= firstmask;
+		for (uint32_t word = firstword + 1; word < lastword; word++)
+			m_dirty[word] = ~uint32_t(0);
+		m_dirty[lastword] |= lastmask;
+	}
+
+	m_mindirty = std::min(m_mindirty, start);
+	m_maxdirty = std::max(m_maxdirty, end);
+}
+
+
 //-------------------------------------------------
 //  reset - clear the dirty array to mark all
 //  entries as clean
@@ -289,8 +316,7 @@ void palette_t::set_brightness(float brightness)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_colors(groupnum, 0, m_numcolors);
 }
 
 
@@ -308,8 +334,7 @@ void palette_t::set_contrast(float contrast)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_colors(groupnum, 0, m_numcolors);
 }
 
 
@@ -336,8 +361,7 @@ void palette_t::set_gamma(float gamma)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_colors(groupnum, 0, m_numcolors);
 }
 
 
@@ -471,8 +495,7 @@ void palette_t::group_set_brightness(uint32_t group, float brightness)
 	m_group_bright[group] = brightness;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_adjusted_colors(group, 0, m_numcolors);
 }
 
 
@@ -493,8 +516,7 @@ void palette_t::group_set_contrast(uint32_t group, float contrast)
 	m_group_contrast[group] = contrast;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_adjusted_colors(group, 0, m_numcolors);
 }
 
 
@@ -570,3 +592,71 @@ void palette_t::update_adjusted_color(uint32_t group, uint32_t index)
 	for (palette_client *client = m_client_list; client != nullptr; client = client->next())
 		client->mark_dirty(finalindex);
 }
+
+
+//-------------------------------------------------
+//  update_adjusted_colors - batch-recompute a
+//  contiguous run of adjusted colors for a group
+//-------------------------------------------------
+
+void palette_t::update_adjusted_colors(uint32_t group, uint32_t start, uint32_t count)
+{
+	const float brightness = m_group_bright[group] + m_brightness;
+	const float groupcontrast = m_group_contrast[group] * m_contrast;
+
+	// fold brightness, contrast and gamma into a single per-channel byte
+	// map; as long as consecutive entries share the same contrast (the
+	// common case is all of them) each entry reduces to three table
+	// lookups instead of three float multiply/add/clamp rounds
+	uint8_t channel_map[256];
+	float map_contrast = 0.0f;
+	bool map_valid = false;
+
+	// track runs of changed entries so clients are told about coalesced
+	// ranges rather than one entry at a time
+	uint32_t runstart = 0, runend = 0;
+	bool runopen = false;
+
+	for (uint32_t index = start; index < start + count; index++)
+	{
+		const float contrast = groupcontrast * m_entry_contrast[index];
+		if (!map_valid || contrast != map_contrast)
+		{
+			for (int value = 0; value < 256; value++)
+				channel_map[value] = rgb_t::clamp(float(m_gamma_map[value]) * contrast + brightness);
+			map_contrast = contrast;
+			map_valid = true;
+		}
+
+		const rgb_t entry = m_entry_color[index];
+		const rgb_t adjusted(entry.a(), channel_map[entry.r()], channel_map[entry.g()], channel_map[entry.b()]);
+
+		// if not different, close out any pending run
+		const uint32_t finalindex = group * m_numcolors + index;
+		if (m_adjusted_color[finalindex] == adjusted)
+		{
+			if (runopen)
+			{
+				for (palette_client *client = m_client_list; client != nullptr; client = client->next())
+					client->mark_dirty_range(runstart, runend);
+				runopen = false;
+			}
+			continue;
+		}
+
+		// otherwise, modify the adjusted color array and extend the run
+		m_adjusted_color[finalindex] = adjusted;
+		m_adjusted_rgb15[finalindex] = adjusted.as_rgb15();
+		if (!runopen)
+		{
+			runstart = finalindex;
+			runopen = true;
+		}
+		runend = finalindex;
+	}
+
+	// flush the final run
+	if (runopen)
+		for (palette_client *client = m_client_list; client != nullptr; client = client->next())
+			client->mark_dirty_range(runstart, runend);
+}
@@ -106,6 +106,7 @@ public:
 
 	// dirty marking
 	void mark_dirty(uint32_t index) { m_live->mark_dirty(index); }
+	void mark_dirty_range(uint32_t start, uint32_t end) { m_live->mark_dirty_range(start, end); }
 
 private:
 	// internal object to track dirty states
@@ -119,6 +120,7 @@ private:
 		const uint32_t *dirty_list(uint32_t &mindirty, uint32_t &maxdirty);
 		void resize(uint32_t colors);
 		void mark_dirty(uint32_t index);
+		void mark_dirty_range(uint32_t start, uint32_t end);
 		void reset();
 
 	private:
@@ -196,6 +198,7 @@ private:
 	// internal helpers
 	rgb_t adjust_palette_entry(rgb_t entry, float brightness, float contrast, const uint8_t *gamma_map);
 	void update_adjusted_color(uint32_t group, uint32_t index);
+	void update_adjusted_colors(uint32_t group, uint32_t start, uint32_t count);
 
 	// internal state
 	uint32_t          m_refcount;                   // reference count on the palette
@@ -24,19 +24,61 @@
 
 #include "path_to_regex.hpp"
 
+#include <mutex>
+
 namespace path2regex {
 
 const std::regex PATH_REGEXP =
   std::regex{"((\\\\.)|(([\\/.])?(?:(?:\\:(\\w+)(?:\\(((?:\\\\.|[^\\\\()])+)\\))?|\\(((?:\\\\.|[^\\\\()])+)\\))([+*?])?|(\\*))))"};
 
+namespace {
+
+// Compiled patterns are cached process-wide: callers hand the same route
+// strings back in repeatedly and std::regex construction dominates the
+// cost of each registration
+struct CacheEntry {
+  std::regex regex;
+  Keys keys;
+};
+
+std::mutex cache_mutex;
+std::map<std::string, CacheEntry> regex_cache;
+
+std::string cache_key(const std::string& path, const Options& options) {
+  std::string key = path;
+  for (const auto& option : options) {
+	key.push_back('\n');
+	key.append(option.first);
+	key.push_back(option.second ? '1' : '0');
+  }
+  return key;
+}
+
+} //< anonymous namespace
+
 std::regex path_to_regex(const std::string& path, Keys& keys, const Options& options) {
+  std::string key = cache_key(path, options);
+  {
+	std::lock_guard<std::mutex> lock{cache_mutex};
+	auto it = regex_cache.find(key);
+	if (it != regex_cache.end()) {
+	  keys = it->second.keys;
+	  return it->second.regex;
+	}
+  }
+
   Tokens all_tokens = parse(path);
   tokens_to_keys(all_tokens, keys); // fill keys with relevant tokens
-  return tokens_to_regex(all_tokens, options);
+  std::regex reg = tokens_to_regex(all_tokens, options);
+
+  std::lock_guard<std::mutex> lock{cache_mutex};
+  regex_cache.emplace(std::move(key), CacheEntry{reg, keys});
+  return reg;
 }
 
 std::regex path_to_regex(const std::string& path,  const Options& options) {
-  return tokens_to_regex(parse(path), options);
+  Keys ignored_keys;
+  return path_to_regex(path, ignored_keys, options);
 }
 
 // Parse a string for the raw tokens
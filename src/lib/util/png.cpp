@@ -20,6 +20,8 @@
 #include <cstring>
 #include <cmath>
 #include <new>
+#include <thread>
+#include <vector>
 
 #include <math.h>
 #include <stdlib.h>
@@ -910,6 +912,147 @@ static png_error write_chunk(util::core_file &fp, const uint8_t *data, uint32_t
 }
 
 
+/*-------------------------------------------------
+    deflate_slice_task - raw-deflate one slice of
+    a buffer on behalf of the parallel compressor
+-------------------------------------------------*/
+
+/* buffers above this size are sliced across worker threads */
+static constexpr uint32_t PARALLEL_DEFLATE_MIN = 256 * 1024;
+static constexpr unsigned MAX_DEFLATE_SLICES = 4;
+
+struct deflate_slice
+{
+	std::vector<uint8_t>    output;     /* compressed slice data */
+	uint32_t                insize = 0; /* uncompressed slice length */
+	uint32_t                adler = 0;  /* Adler-32 of the uncompressed slice */
+	bool                    failed = false;
+};
+
+static void deflate_slice_task(const uint8_t *data, uint32_t length, bool last, deflate_slice &slice)
+{
+	z_stream stream;
+	int zerr;
+
+	/* raw deflate - the caller reassembles the zlib wrapper around the slices */
+	memset(&stream, 0, sizeof(stream));
+	zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	if (zerr != Z_OK)
+	{
+		slice.failed = true;
+		return;
+	}
+
+	/* deflateBound is a worst case, so a single call always consumes everything */
+	try { slice.output.resize(deflateBound(&stream, length) + 16); }
+	catch (std::bad_alloc const &)
+	{
+		deflateEnd(&stream);
+		slice.failed = true;
+		return;
+	}
+	stream.next_in = const_cast<Bytef *>(data);
+	stream.avail_in = length;
+	stream.next_out = &slice.output[0];
+	stream.avail_out = slice.output.size();
+
+	/* a full flush ends intermediate slices on a byte boundary so their
+	   outputs can simply be concatenated; only the last slice is finished */
+	zerr = deflate(&stream, last ? Z_FINISH : Z_FULL_FLUSH);
+	if ((last && zerr != Z_STREAM_END) || (!last && (zerr != Z_OK || stream.avail_in != 0)))
+	{
+		deflateEnd(&stream);
+		slice.failed = true;
+		return;
+	}
+	slice.output.resize(stream.total_out);
+	slice.insize = length;
+	slice.adler = adler32(adler32(0, Z_NULL, 0), data, length);
+	deflateEnd(&stream);
+}
+
+
+/*-------------------------------------------------
+    write_deflated_chunk_parallel - write an
+    in-memory chunk to the given file, deflating
+    independent slices on worker threads
+-------------------------------------------------*/
+
+static png_error write_deflated_chunk_parallel(util::core_file &fp, const uint8_t *data, uint32_t type, uint32_t length, unsigned numslices)
+{
+	uint8_t tempbuff[8];
+	uint32_t crc;
+
+	/* compress each slice on its own thread; this thread takes the last one */
+	std::vector<deflate_slice> slices(numslices);
+	{
+		std::vector<std::thread> workers;
+		uint32_t const stride = (length + numslices - 1) / numslices;
+		for (unsigned slicenum = 0; slicenum < numslices; slicenum++)
+		{
+			uint32_t const start = slicenum * stride;
+			uint32_t const count = std::min(stride, length - start);
+			if (slicenum != numslices - 1)
+				workers.emplace_back([&slices, slicenum, data, start, count] { deflate_slice_task(data + start, count, false, slices[slicenum]); });
+			else
+				deflate_slice_task(data + start, count, true, slices[slicenum]);
+		}
+		for (std::thread &worker : workers)
+			worker.join();
+	}
+
+	/* total the compressed length and combine the checksums up front, so
+	   the chunk length never needs backpatching */
+	uint32_t zlength = 2 + 4;   /* zlib header + Adler-32 trailer */
+	uint32_t adler = adler32(0, Z_NULL, 0);
+	for (deflate_slice &slice : slices)
+	{
+		if (slice.failed)
+			return PNGERR_COMPRESS_ERROR;
+		zlength += slice.output.size();
+		adler = adler32_combine(adler, slice.adler, slice.insize);
+	}
+
+	/* stuff the length/type into the buffer */
+	put_32bit(tempbuff + 0, zlength);
+	put_32bit(tempbuff + 4, type);
+	crc = crc32(0, tempbuff + 4, 4);
+
+	/* write that data */
+	if (fp.write(tempbuff, 8) != 8)
+		return PNGERR_FILE_ERROR;
+
+	/* write the zlib header the serial compressor would have produced */
+	tempbuff[0] = 0x78;     /* deflate, 32k window */
+	tempbuff[1] = 0x01;     /* no preset dictionary; (0x7801 % 31) == 0 */
+	if (fp.write(tempbuff, 2) != 2)
+		return PNGERR_FILE_ERROR;
+	crc = crc32(crc, tempbuff, 2);
+
+	/* append each compressed slice */
+	for (deflate_slice &slice : slices)
+	{
+		uint32_t const bytes = slice.output.size();
+		if (fp.write(&slice.output[0], bytes) != bytes)
+			return PNGERR_FILE_ERROR;
+		crc = crc32(crc, &slice.output[0], bytes);
+	}
+
+	/* append the Adler-32 of the uncompressed data */
+	put_32bit(tempbuff, adler);
+	if (fp.write(tempbuff, 4) != 4)
+		return PNGERR_FILE_ERROR;
+	crc = crc32(crc, tempbuff, 4);
+
+	/* write the CRC */
+	put_32bit(tempbuff, crc);
+	if (fp.write(tempbuff, 4) != 4)
+		return PNGERR_FILE_ERROR;
+
+	return PNGERR_NONE;
+}
+
+
 /*-------------------------------------------------
     write_deflated_chunk - write an in-memory
     chunk to the given file by deflating it
@@ -917,6 +1060,14 @@ static png_error write_chunk(util::core_file &fp, const uint8_t *data, uint32_t
 
 static png_error write_deflated_chunk(util::core_file &fp, uint8_t *data, uint32_t type, uint32_t length)
 {
+	/* hand large buffers to the parallel compressor when multiple cores are available */
+	if (length >= PARALLEL_DEFLATE_MIN)
+	{
+		unsigned const numslices = std::min(std::thread::hardware_concurrency(), MAX_DEFLATE_SLICES);
+		if (numslices > 1)
+			return write_deflated_chunk_parallel(fp, data, type, length, numslices);
+	}
+
 	uint64_t lengthpos = fp.tell();
 	uint8_t tempbuff[8192];
 	uint32_t zlength = 0;
@@ -1134,6 +1285,30 @@ static png_error convert_bitmap_to_image_rgb(png_info &pnginfo, const bitmap_t &
 }
 
 
+/*-------------------------------------------------
+    filter_image_sub - apply the PNG "Sub" filter
+    to each row of an RGB/ARGB image in place
+-------------------------------------------------*/
+
+static void filter_image_sub(png_info &pnginfo)
+{
+	int const bpp = (pnginfo.color_type == 6) ? 4 : 3;
+	int const rowbytes = pnginfo.width * bpp;
+	int x, y;
+
+	for (y = 0; y < pnginfo.height; y++)
+	{
+		uint8_t *row = &pnginfo.image[y * (rowbytes + 1)];
+
+		/* replace each sample with its delta from the previous pixel,
+		   working back to front so the predecessors stay unmodified */
+		row[0] = 1;
+		for (x = rowbytes; x > bpp; x--)
+			row[x] -= row[x - bpp];
+	}
+}
+
+
 /*-------------------------------------------------
     write_png_stream - stream a series of PNG
     chunks to the given file
@@ -1152,7 +1327,10 @@ static png_error write_png_stream(util::core_file &fp, png_info &pnginfo, const
 	if (error != PNGERR_NONE)
 		return error;
 
-	// if we wanted to get clever and do filtering, we would do it here
+	// Sub-filter RGB/ARGB images; the delta rows deflate much better on the
+	// flat-shaded output typical of emulated screens, and the pass is cheap
+	if (pnginfo.color_type == 2 || pnginfo.color_type == 6)
+		filter_image_sub(pnginfo);
 
 	// write the IHDR chunk
 	put_32bit(tempbuff + 0, pnginfo.width);
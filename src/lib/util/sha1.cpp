@@ -31,6 +31,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* x86 SHA extensions - dispatched at runtime so generic builds still run
+   everywhere; everything else falls through to the portable code below */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SHA1_X86_SHA 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 static unsigned int READ_UINT32(const uint8_t* data)
 {
 	return ((uint32_t)data[0] << 24) |
@@ -267,6 +275,230 @@ sha1_transform(uint32_t *state, uint32_t *data)
 	state[4] += E;
 }
 
+#ifdef SHA1_X86_SHA
+
+/**
+ * @fn  static int have_x86_sha(void)
+ *
+ * @brief   Query whether the CPU implements the SHA extensions (cached).
+ *
+ * @return  Non-zero if the sha1_blocks_x86 path can be used.
+ */
+
+static int
+have_x86_sha(void)
+{
+	static int result = -1;
+	if (result < 0)
+	{
+		unsigned int eax, ebx, ecx, edx;
+		result = 0;
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+			(ecx & bit_SSSE3) && (ecx & bit_SSE4_1) &&
+			__get_cpuid_max(0, nullptr) >= 7)
+		{
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			if (ebx & (1 << 29))
+				result = 1;
+		}
+	}
+	return result;
+}
+
+/* Whole-block transform using the SHA1RNDS4/SHA1NEXTE/SHA1MSG instructions.
+   Processes a run of blocks in one call so the state stays in registers;
+   the message schedule is computed on the fly just like the portable code.
+   Note that unlike sha1_transform this reads big-endian data directly,
+   doing the byte swap with PSHUFB */
+
+__attribute__((target("sha,ssse3,sse4.1")))
+static void
+sha1_blocks_x86(uint32_t *digest, const uint8_t *data, unsigned blocks)
+{
+	const __m128i bswap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	__m128i abcd, e0, e1;
+	__m128i abcd_save, e_save;
+	__m128i msg0, msg1, msg2, msg3;
+
+	/* ABCD is kept reversed to match the instruction operand order */
+	abcd = _mm_loadu_si128((const __m128i *)digest);
+	abcd = _mm_shuffle_epi32(abcd, 0x1B);
+	e0 = _mm_set_epi32(digest[4], 0, 0, 0);
+
+	while (blocks--)
+	{
+		abcd_save = abcd;
+		e_save = e0;
+
+		/* Load and byte swap one block */
+		msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data +  0)), bswap);
+		msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), bswap);
+		msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), bswap);
+		msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), bswap);
+
+		/* Rounds 0-3 */
+		e0 = _mm_add_epi32(e0, msg0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		/* Rounds 4-7 */
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+		/* Rounds 8-11 */
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		/* Rounds 12-15 */
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		/* Rounds 16-19 */
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		/* Rounds 20-23 */
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		/* Rounds 24-27 */
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		/* Rounds 28-31 */
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		/* Rounds 32-35 */
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		/* Rounds 36-39 */
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		/* Rounds 40-43 */
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		/* Rounds 44-47 */
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		/* Rounds 48-51 */
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		/* Rounds 52-55 */
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		/* Rounds 56-59 */
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		/* Rounds 60-63 */
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		/* Rounds 64-67 */
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		/* Rounds 68-71 */
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		/* Rounds 72-75 */
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+		/* Rounds 76-79 */
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+		/* Add back the saved state */
+		e0 = _mm_sha1nexte_epu32(e0, e_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+
+		data += SHA1_DATA_SIZE;
+	}
+
+	/* Store the result */
+	abcd = _mm_shuffle_epi32(abcd, 0x1B);
+	_mm_storeu_si128((__m128i *)digest, abcd);
+	digest[4] = _mm_extract_epi32(e0, 3);
+}
+
+#endif /* SHA1_X86_SHA */
+
 /**
  * @fn  static void sha1_block(struct sha1_ctx *ctx, const uint8_t *block)
  *
@@ -286,6 +518,14 @@ sha1_block(struct sha1_ctx *ctx, const uint8_t *block)
 	if (!++ctx->count_low)
 	++ctx->count_high;
 
+#ifdef SHA1_X86_SHA
+	if (have_x86_sha())
+	{
+		sha1_blocks_x86(ctx->digest, block, 1);
+		return;
+	}
+#endif
+
 	/* Endian independent conversion */
 	for (i = 0; i<SHA1_DATA_LENGTH; i++, block += 4)
 	data[i] = READ_UINT32(block);
@@ -324,6 +564,20 @@ sha1_update(struct sha1_ctx *ctx,
 		length -= left;
 	}
 	}
+#ifdef SHA1_X86_SHA
+	/* Hand whole runs of blocks to the SHA instructions in one call so the
+	   state stays in registers between blocks */
+	if (length >= SHA1_DATA_SIZE && have_x86_sha())
+	{
+		unsigned blocks = length / SHA1_DATA_SIZE;
+		sha1_blocks_x86(ctx->digest, buffer, blocks);
+		ctx->count_low += blocks;
+		if (ctx->count_low < blocks)
+			++ctx->count_high;
+		buffer += blocks * SHA1_DATA_SIZE;
+		length -= blocks * SHA1_DATA_SIZE;
+	}
+#endif
 	while (length >= SHA1_DATA_SIZE)
 	{
 		sha1_block(ctx, buffer);
@@ -1649,6 +1649,44 @@ typename Stream::off_type stream_format(Stream &str, format_argument_pack<Base>
 			: (end - begin);
 }
 
+
+//**************************************************************************
+//  FIXED BUFFER STREAM SUPPORT
+//**************************************************************************
+
+// streambuf writing into a caller-supplied character array, silently
+// discarding output beyond its capacity in the manner of snprintf
+template <typename CharT, typename Traits = std::char_traits<CharT> >
+class basic_format_arraybuf : public std::basic_streambuf<CharT, Traits>
+{
+public:
+	typedef typename std::basic_streambuf<CharT, Traits>::int_type int_type;
+	typedef typename std::basic_streambuf<CharT, Traits>::pos_type pos_type;
+	typedef typename std::basic_streambuf<CharT, Traits>::off_type off_type;
+
+	basic_format_arraybuf(CharT *buffer, std::size_t length)
+	{
+		this->setp(buffer, buffer + length);
+	}
+
+	std::size_t written() const { return std::size_t(this->pptr() - this->pbase()); }
+
+protected:
+	virtual int_type overflow(int_type ch = Traits::eof()) override
+	{
+		// sink excess output so formatting isn't aborted on truncation
+		return Traits::not_eof(ch);
+	}
+
+	virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override
+	{
+		// allow tellp so %n conversions and return values still work
+		if ((std::ios_base::cur == dir) && (off_type(0) == off) && (which & std::ios_base::out))
+			return pos_type(off_type(this->pptr() - this->pbase()));
+		return pos_type(off_type(-1));
+	}
+};
+
 } // namespace detail
 
 
@@ -1737,6 +1775,35 @@ inline String string_format(std::locale const &locale, detail::format_argument_p
 };
 
 
+//**************************************************************************
+//  FORMAT TO FIXED BUFFER FUNCTIONS
+//**************************************************************************
+
+// format into a caller-supplied buffer, truncating if necessary; the
+// result is always NUL-terminated and the number of characters stored
+// (excluding the terminator) is returned - no allocation takes place,
+// making this suitable for per-frame and logging hot paths
+
+template <typename CharT, typename Format, typename... Params>
+inline std::size_t string_format_to(CharT *buffer, std::size_t length, Format &&fmt, Params &&... args)
+{
+	if (0U == length)
+		return 0U;
+	detail::basic_format_arraybuf<CharT> buf(buffer, length - 1);
+	std::basic_ostream<CharT> str(&buf);
+	stream_format(str, std::forward<Format>(fmt), std::forward<Params>(args)...);
+	std::size_t const result(buf.written());
+	buffer[result] = CharT('\0');
+	return result;
+}
+
+template <typename CharT, std::size_t N, typename Format, typename... Params>
+inline typename std::enable_if<!std::is_integral<typename std::decay<Format>::type>::value, std::size_t>::type string_format_to(CharT (&buffer)[N], Format &&fmt, Params &&... args)
+{
+	return string_format_to(static_cast<CharT *>(buffer), N, std::forward<Format>(fmt), std::forward<Params>(args)...);
+}
+
+
 //**************************************************************************
 //  CREATING ARGUMENT PACKS
 //**************************************************************************
@@ -115,6 +115,15 @@ public:
 			{
 				ptr result;
 				std::swap(s_cache[cachenum], result);
+
+				// if the file has been touched since we parsed it, our index is stale
+				auto const stat = osd_stat(filename);
+				if (!result->m_stat_valid || !stat || (stat->last_modified != result->m_stat_modified) || (stat->size != result->m_stat_size))
+				{
+					osd_printf_verbose("un7z: %s changed on disk, discarding cached index\n", filename.c_str());
+					return ptr();
+				}
+
 				osd_printf_verbose("un7z: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -128,6 +137,15 @@ public:
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
 		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
 	}
+	static void cache_trim()
+	{
+		// drop decoded solid blocks - they can run to hundreds of megabytes
+		// for merged sets - but keep the parsed indexes
+		std::lock_guard<std::mutex> guard(s_cache_mutex);
+		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+			if (s_cache[cachenum])
+				s_cache[cachenum]->release_block_buffer();
+	}
 
 	archive_file::error initialize();
 
@@ -171,12 +189,27 @@ private:
 	void make_utf8_name(int index);
 	void set_curr_modified();
 
+	void release_block_buffer()
+	{
+		if (m_out_buffer)
+		{
+			IAlloc_Free(&m_alloc_imp, m_out_buffer);
+			m_out_buffer = nullptr;
+			m_out_buffer_size = 0;
+			m_block_index = 0;
+		}
+	}
+
 	static constexpr std::size_t            CACHE_SIZE = 8;
 	static std::array<ptr, CACHE_SIZE>      s_cache;
 	static std::mutex                       s_cache_mutex;
 
 	const std::string                       m_filename;             // copy of _7Z filename (for caching)
 
+	std::chrono::system_clock::time_point   m_stat_modified;        // modification time when the index was parsed
+	std::uint64_t                           m_stat_size;            // file size when the index was parsed
+	bool                                    m_stat_valid;           // did we manage to stat the file?
+
 	int                                     m_curr_file_idx;        // current file index
 	bool                                    m_curr_is_dir;          // current file is directory
 	std::string                             m_curr_name;            // current file name
@@ -282,6 +315,9 @@ CFileInStream::CFileInStream()
 
 m7z_file_impl::m7z_file_impl(const std::string &filename)
 	: m_filename(filename)
+	, m_stat_modified()
+	, m_stat_size(0)
+	, m_stat_valid(false)
 	, m_curr_file_idx(-1)
 	, m_curr_is_dir(false)
 	, m_curr_name()
@@ -333,6 +369,15 @@ archive_file::error m7z_file_impl::initialize()
 		}
 	}
 
+	// remember when the file was last modified so cached indexes can be validated
+	auto const stat = osd_stat(m_filename);
+	if (stat)
+	{
+		m_stat_modified = stat->last_modified;
+		m_stat_size = stat->size;
+		m_stat_valid = true;
+	}
+
 	return archive_file::error::NONE;
 }
 
@@ -570,4 +615,16 @@ void m7z_file_cache_clear()
 	m7z_file_impl::cache_clear();
 }
 
+
+/*-------------------------------------------------
+    _7z_file_cache_trim - free decoded solid
+    block buffers held by cached _7Z files
+-------------------------------------------------*/
+
+void m7z_file_cache_trim()
+{
+	// This is a trampoline called from unzip.cpp to avoid the need to have the zip and 7zip code in one file
+	m7z_file_impl::cache_trim();
+}
+
 } // namespace util
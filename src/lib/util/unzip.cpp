@@ -47,16 +47,26 @@ public:
 		: m_filename(filename)
 		, m_file()
 		, m_length(0)
+		, m_stat_modified()
+		, m_stat_size(0)
+		, m_stat_valid(false)
 		, m_ecd()
 		, m_cd()
 		, m_cd_pos(0)
 		, m_header()
 		, m_curr_is_dir(false)
 		, m_buffer()
+		, m_inflater_ready(false)
 	{
 		std::fill(m_buffer.begin(), m_buffer.end(), 0);
 	}
 
+	~zip_file_impl()
+	{
+		if (m_inflater_ready)
+			inflateEnd(&m_inflater);
+	}
+
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
@@ -67,6 +77,15 @@ public:
 			{
 				ptr result;
 				std::swap(s_cache[cachenum], result);
+
+				// if the file has been touched since we parsed it, our central directory is stale
+				auto const stat = osd_stat(filename);
+				if (!result->m_stat_valid || !stat || (stat->last_modified != result->m_stat_modified) || (stat->size != result->m_stat_size))
+				{
+					osd_printf_verbose("unzip: %s changed on disk, discarding cached directory\n", filename.c_str());
+					return ptr();
+				}
+
 				osd_printf_verbose("unzip: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -136,6 +155,15 @@ public:
 		}
 		osd_printf_verbose("unzip: read %s central directory\n", m_filename.c_str());
 
+		// remember when the file was last modified so cached directories can be validated
+		auto const stat = osd_stat(m_filename);
+		if (stat)
+		{
+			m_stat_modified = stat->last_modified;
+			m_stat_size = stat->size;
+			m_stat_valid = true;
+		}
+
 		return archive_file::error::NONE;
 	}
 
@@ -273,6 +301,10 @@ private:
 	osd_file::ptr               m_file;                     // OSD file handle
 	std::uint64_t               m_length;                   // length of zip file
 
+	std::chrono::system_clock::time_point m_stat_modified;  // modification time when the directory was parsed
+	std::uint64_t               m_stat_size;                // file size when the directory was parsed
+	bool                        m_stat_valid;               // did we manage to stat the file?
+
 	ecd                         m_ecd;                      // end of central directory
 
 	std::vector<std::uint8_t>   m_cd;                       // central directory raw data
@@ -281,6 +313,9 @@ private:
 	bool                        m_curr_is_dir;              // current file is directory
 
 	std::array<std::uint8_t, DECOMPRESS_BUFSIZE> m_buffer;  // buffer for decompression
+
+	z_stream                    m_inflater;                 // reusable inflate state, kept warm between members
+	bool                        m_inflater_ready;           // has m_inflater been initialized?
 };
 
 
@@ -1139,17 +1174,23 @@ archive_file::error zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 	std::uint64_t input_remaining = m_header.compressed_length;
 	int zerr;
 
-	// reset the stream
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-	stream.avail_in = 0;
-	stream.next_out = reinterpret_cast<Bytef *>(buffer);
-	stream.avail_out = length;
-
-	// initialize the decompressor
-	zerr = inflateInit2(&stream, -MAX_WBITS);
+	// initialize the decompressor the first time through, and just reset it
+	// thereafter so extracting several members reuses the allocated state
+	z_stream &stream = m_inflater;
+	if (m_inflater_ready)
+	{
+		zerr = inflateReset2(&stream, -MAX_WBITS);
+	}
+	else
+	{
+		stream.zalloc = Z_NULL;
+		stream.zfree = Z_NULL;
+		stream.opaque = Z_NULL;
+		stream.avail_in = 0;
+		stream.next_in = Z_NULL;
+		zerr = inflateInit2(&stream, -MAX_WBITS);
+		m_inflater_ready = (zerr == Z_OK);
+	}
 	if (zerr != Z_OK)
 	{
 		osd_printf_error(
@@ -1158,6 +1199,11 @@ archive_file::error zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 		return archive_file::error::DECOMPRESS_ERROR;
 	}
 
+	// reset the stream
+	stream.avail_in = 0;
+	stream.next_out = reinterpret_cast<Bytef *>(buffer);
+	stream.avail_out = length;
+
 	// loop until we're done
 	while (1)
 	{
@@ -1173,7 +1219,6 @@ archive_file::error zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 			osd_printf_error(
 					"unzip: error reading compressed data for %s in %s (%d)\n",
 					m_header.file_name.c_str(), m_filename.c_str(), int(filerr));
-			inflateEnd(&stream);
 			return archive_file::error::FILE_ERROR;
 		}
 		offset += read_length;
@@ -1184,7 +1229,6 @@ archive_file::error zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 			osd_printf_error(
 					"unzip: unexpectedly reached end-of-file while reading compressed data for %s in %s\n",
 					m_header.file_name.c_str(), m_filename.c_str());
-			inflateEnd(&stream);
 			return archive_file::error::FILE_TRUNCATED;
 		}
 
@@ -1206,19 +1250,10 @@ archive_file::error zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 		else if (zerr != Z_OK)
 		{
 			osd_printf_error("unzip: error inflating %s from %s (%d)\n", m_header.file_name.c_str(), m_filename.c_str(), zerr);
-			inflateEnd(&stream);
 			return archive_file::error::DECOMPRESS_ERROR;
 		}
 	}
 
-	// finish decompression
-	zerr = inflateEnd(&stream);
-	if (zerr != Z_OK)
-	{
-		osd_printf_error("unzip: error finishing inflation of %s from %s (%d)\n", m_header.file_name.c_str(), m_filename.c_str(), zerr);
-		return archive_file::error::DECOMPRESS_ERROR;
-	}
-
 	// if anything looks funny, report an error
 	if ((stream.avail_out > 0) || (input_remaining > 0))
 	{
@@ -1427,6 +1462,7 @@ archive_file::error zip_file_impl::decompress_data_type_14(std::uint64_t offset,
 ***************************************************************************/
 
 void m7z_file_cache_clear();
+void m7z_file_cache_trim();
 
 
 
@@ -1480,6 +1516,19 @@ void archive_file::cache_clear()
 }
 
 
+/*-------------------------------------------------
+    zip_file_cache_trim - release large scratch
+    buffers held by cached archives while keeping
+    the parsed directories
+-------------------------------------------------*/
+
+void archive_file::cache_trim()
+{
+	// ZIP files hold no large decode state; only the 7z solid block buffers matter
+	m7z_file_cache_trim();
+}
+
+
 archive_file::~archive_file()
 {
 }
@@ -62,6 +62,9 @@ public:
 	// clear out all open files from the cache
 	static void cache_clear();
 
+	// release large scratch buffers held by cached archives, keeping the parsed directories
+	static void cache_trim();
+
 
 	/* ----- contained file access ----- */
 
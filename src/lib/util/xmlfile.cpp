@@ -51,6 +51,19 @@ struct parse_info
 };
 
 
+struct streaming_info
+{
+	XML_Parser                  parser;
+	parser::callbacks const *   cbs;
+	uint32_t                    flags;
+	unsigned                    depth;
+	std::vector<std::string>    values;     /* per-depth accumulated character data */
+	std::vector<std::string>    attrnames;  /* lowercased attribute names, reused */
+	std::vector<const char *>   attrptrs;   /* name/value pairs passed to the callback */
+	std::string                 namebuf;    /* lowercased element name, reused */
+};
+
+
 
 /***************************************************************************
     PROTOTYPES
@@ -61,6 +74,10 @@ static bool expat_setup_parser(parse_info &info, parse_options const *opts);
 static void expat_element_start(void *data, const XML_Char *name, const XML_Char **attributes);
 static void expat_data(void *data, const XML_Char *s, int len);
 static void expat_element_end(void *data, const XML_Char *name);
+static bool expat_setup_streaming_parser(streaming_info &info, parser::callbacks const &cbs, parse_options const *opts);
+static void expat_streaming_element_start(void *data, const XML_Char *name, const XML_Char **attributes);
+static void expat_streaming_data(void *data, const XML_Char *s, int len);
+static void expat_streaming_element_end(void *data, const XML_Char *name);
 
 
 
@@ -167,6 +184,85 @@ file::ptr file::string_read(const char *string, parse_options const *opts)
 }
 
 
+/*-------------------------------------------------
+    parser::read - parse an XML file, delivering
+    events instead of building a DOM
+-------------------------------------------------*/
+
+bool parser::read(util::core_file &file, callbacks const &cbs, parse_options const *opts)
+{
+	streaming_info info;
+	int done;
+
+	/* set up the parser */
+	if (!expat_setup_streaming_parser(info, cbs, opts))
+		return false;
+
+	/* loop through the file and parse it */
+	do
+	{
+		char tempbuf[TEMP_BUFFER_SIZE];
+
+		/* read as much as we can */
+		int bytes = file.read(tempbuf, sizeof(tempbuf));
+		done = file.eof();
+
+		/* parse the data */
+		if (XML_Parse(info.parser, tempbuf, bytes, done) == XML_STATUS_ERROR)
+		{
+			if (opts != nullptr && opts->error != nullptr)
+			{
+				opts->error->error_message = XML_ErrorString(XML_GetErrorCode(info.parser));
+				opts->error->error_line = XML_GetCurrentLineNumber(info.parser);
+				opts->error->error_column = XML_GetCurrentColumnNumber(info.parser);
+			}
+
+			XML_ParserFree(info.parser);
+			return false;
+		}
+	}
+	while (!done);
+
+	/* free the parser */
+	XML_ParserFree(info.parser);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    parser::string_read - parse an XML string,
+    delivering events instead of building a DOM
+-------------------------------------------------*/
+
+bool parser::string_read(const char *string, callbacks const &cbs, parse_options const *opts)
+{
+	streaming_info info;
+	int length = (int)strlen(string);
+
+	/* set up the parser */
+	if (!expat_setup_streaming_parser(info, cbs, opts))
+		return false;
+
+	/* parse the data */
+	if (XML_Parse(info.parser, string, length, 1) == XML_STATUS_ERROR)
+	{
+		if (opts != nullptr && opts->error != nullptr)
+		{
+			opts->error->error_message = XML_ErrorString(XML_GetErrorCode(info.parser));
+			opts->error->error_line = XML_GetCurrentLineNumber(info.parser);
+			opts->error->error_column = XML_GetCurrentColumnNumber(info.parser);
+		}
+
+		XML_ParserFree(info.parser);
+		return false;
+	}
+
+	/* free the parser */
+	XML_ParserFree(info.parser);
+	return true;
+}
+
+
 /*-------------------------------------------------
     file_write - write an XML tree to a file
 -------------------------------------------------*/
@@ -185,6 +281,137 @@ void file::write(util::core_file &file) const
 }
 
 
+/*-------------------------------------------------
+    binary serialization helpers
+-------------------------------------------------*/
+
+namespace {
+
+void binary_put_u32(std::vector<std::uint8_t> &buffer, std::uint32_t value)
+{
+	buffer.push_back(std::uint8_t(value >> 0));
+	buffer.push_back(std::uint8_t(value >> 8));
+	buffer.push_back(std::uint8_t(value >> 16));
+	buffer.push_back(std::uint8_t(value >> 24));
+}
+
+void binary_put_string(std::vector<std::uint8_t> &buffer, char const *value)
+{
+	std::size_t const length = value ? std::strlen(value) : 0;
+	binary_put_u32(buffer, std::uint32_t(length));
+	buffer.insert(buffer.end(), value, value + length);
+}
+
+bool binary_get_u32(std::uint8_t const *&data, std::size_t &remaining, std::uint32_t &value)
+{
+	if (remaining < 4)
+		return false;
+	value = (std::uint32_t(data[0]) << 0) | (std::uint32_t(data[1]) << 8) | (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+	data += 4;
+	remaining -= 4;
+	return true;
+}
+
+bool binary_get_string(std::uint8_t const *&data, std::size_t &remaining, std::string &value)
+{
+	std::uint32_t length;
+	if (!binary_get_u32(data, remaining, length) || (length > remaining))
+		return false;
+	value.assign(reinterpret_cast<char const *>(data), length);
+	data += length;
+	remaining -= length;
+	return true;
+}
+
+bool binary_read_node(data_node &parent, std::uint8_t const *&data, std::size_t &remaining)
+{
+	/* read the node name and value */
+	std::string name, value;
+	if (!binary_get_string(data, remaining, name) || !binary_get_string(data, remaining, value))
+		return false;
+	data_node *const node = parent.add_child(name.c_str(), value.empty() ? nullptr : value.c_str());
+	if (!node)
+		return false;
+
+	/* then the attributes */
+	std::uint32_t attrcount;
+	if (!binary_get_u32(data, remaining, attrcount))
+		return false;
+	for (std::uint32_t attrnum = 0; attrnum < attrcount; attrnum++)
+	{
+		std::string attrname, attrvalue;
+		if (!binary_get_string(data, remaining, attrname) || !binary_get_string(data, remaining, attrvalue))
+			return false;
+		node->add_attribute(attrname.c_str(), attrvalue.c_str());
+	}
+
+	/* and finally the children, recursively */
+	std::uint32_t childcount;
+	if (!binary_get_u32(data, remaining, childcount))
+		return false;
+	for (std::uint32_t childnum = 0; childnum < childcount; childnum++)
+		if (!binary_read_node(*node, data, remaining))
+			return false;
+	return true;
+}
+
+} // anonymous namespace
+
+
+/*-------------------------------------------------
+    serialize_binary - append this node and its
+    children to a compact binary representation
+-------------------------------------------------*/
+
+void data_node::serialize_binary(std::vector<std::uint8_t> &buffer) const
+{
+	/* write name, value and attributes */
+	binary_put_string(buffer, get_name());
+	binary_put_string(buffer, get_value());
+	binary_put_u32(buffer, std::uint32_t(m_attributes.size()));
+	for (attribute_node const &attr : m_attributes)
+	{
+		binary_put_string(buffer, attr.name.c_str());
+		binary_put_string(buffer, attr.value.c_str());
+	}
+
+	/* then the children, recursively */
+	binary_put_u32(buffer, std::uint32_t(count_children()));
+	for (data_node const *child = get_first_child(); child; child = child->get_next_sibling())
+		child->serialize_binary(buffer);
+}
+
+
+/*-------------------------------------------------
+    deserialize_binary - reconstruct a tree from
+    the compact binary representation
+-------------------------------------------------*/
+
+file::ptr file::deserialize_binary(const std::uint8_t *data, std::size_t size)
+{
+	file::ptr result = create();
+	if (!result)
+		return nullptr;
+
+	/* the root record has an empty name and no attributes of interest */
+	std::string name, value;
+	if (!binary_get_string(data, size, name) || !binary_get_string(data, size, value) || !name.empty())
+		return nullptr;
+	std::uint32_t attrcount;
+	if (!binary_get_u32(data, size, attrcount) || (attrcount != 0))
+		return nullptr;
+
+	/* read the children into the new root */
+	std::uint32_t childcount;
+	if (!binary_get_u32(data, size, childcount))
+		return nullptr;
+	for (std::uint32_t childnum = 0; childnum < childcount; childnum++)
+		if (!binary_read_node(*result, data, size))
+			return nullptr;
+	return result;
+}
+
+
 
 /***************************************************************************
     XML NODE MANAGEMENT
@@ -895,6 +1122,140 @@ static void expat_element_end(void *data, const XML_Char *name)
 
 
 
+/*-------------------------------------------------
+    expat_setup_streaming_parser - set up expat
+    for event-driven parsing
+-------------------------------------------------*/
+
+static bool expat_setup_streaming_parser(streaming_info &info, parser::callbacks const &cbs, parse_options const *opts)
+{
+	XML_Memory_Handling_Suite memcallbacks;
+
+	/* setup info structure */
+	info.cbs = &cbs;
+	info.flags = 0;
+	info.depth = 0;
+	if (opts != nullptr)
+	{
+		info.flags = opts->flags;
+		if (opts->error != nullptr)
+		{
+			opts->error->error_message = nullptr;
+			opts->error->error_line = 0;
+			opts->error->error_column = 0;
+		}
+	}
+
+	/* create the XML parser */
+	memcallbacks.malloc_fcn = expat_malloc;
+	memcallbacks.realloc_fcn = expat_realloc;
+	memcallbacks.free_fcn = expat_free;
+	info.parser = XML_ParserCreate_MM(nullptr, &memcallbacks, nullptr);
+	if (info.parser == nullptr)
+		return false;
+
+	/* configure the parser */
+	XML_SetElementHandler(info.parser, expat_streaming_element_start, expat_streaming_element_end);
+	XML_SetCharacterDataHandler(info.parser, expat_streaming_data);
+	XML_SetUserData(info.parser, &info);
+
+	/* optional parser initialization step */
+	if (opts != nullptr && opts->init_parser != nullptr)
+		(*opts->init_parser)(info.parser);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    expat_streaming_element_start - expat callback
+    for a new element in event-driven mode
+-------------------------------------------------*/
+
+static void expat_streaming_element_start(void *data, const XML_Char *name, const XML_Char **attributes)
+{
+	streaming_info *info = (streaming_info *) data;
+	int attr;
+
+	/* hand the element and its attributes to the callback; names are
+	   lowercased into reused buffers so steady-state parsing does not
+	   allocate */
+	if (info->cbs->element_start != nullptr)
+	{
+		info->namebuf.assign(name);
+		std::transform(info->namebuf.begin(), info->namebuf.end(), info->namebuf.begin(), [] (char ch) { return std::tolower(uint8_t(ch)); });
+
+		info->attrptrs.clear();
+		for (attr = 0; attributes[attr]; attr += 2)
+		{
+			if (info->attrnames.size() <= unsigned(attr / 2))
+				info->attrnames.emplace_back();
+			std::string &aname = info->attrnames[attr / 2];
+			aname.assign(attributes[attr]);
+			std::transform(aname.begin(), aname.end(), aname.begin(), [] (char ch) { return std::tolower(uint8_t(ch)); });
+			info->attrptrs.push_back(aname.c_str());
+			info->attrptrs.push_back(attributes[attr + 1]);
+		}
+		info->attrptrs.push_back(nullptr);
+
+		(*info->cbs->element_start)(info->cbs->param, info->namebuf.c_str(), &info->attrptrs[0]);
+	}
+
+	/* open a fresh character data accumulator for this element */
+	if (info->values.size() <= info->depth)
+		info->values.emplace_back();
+	info->values[info->depth].clear();
+	info->depth++;
+}
+
+
+/*-------------------------------------------------
+    expat_streaming_data - expat callback for
+    element data in event-driven mode
+-------------------------------------------------*/
+
+static void expat_streaming_data(void *data, const XML_Char *s, int len)
+{
+	streaming_info *info = (streaming_info *) data;
+	if (info->depth > 0)
+		info->values[info->depth - 1].append(s, len);
+}
+
+
+/*-------------------------------------------------
+    expat_streaming_element_end - expat callback
+    for the end of an element in event-driven mode
+-------------------------------------------------*/
+
+static void expat_streaming_element_end(void *data, const XML_Char *name)
+{
+	streaming_info *info = (streaming_info *) data;
+
+	info->depth--;
+	std::string &value = info->values[info->depth];
+
+	/* strip leading/trailing spaces from the value data */
+	if (!(info->flags & PARSE_FLAG_WHITESPACE_SIGNIFICANT))
+	{
+		std::string::size_type start = 0;
+		while ((value.size() != start) && std::isspace(uint8_t(value[start])))
+			++start;
+		std::string::size_type end = value.size();
+		while ((start != end) && std::isspace(uint8_t(value[end - 1])))
+			--end;
+		value.erase(end);
+		value.erase(0, start);
+	}
+
+	if (info->cbs->element_end != nullptr)
+	{
+		info->namebuf.assign(name);
+		std::transform(info->namebuf.begin(), info->namebuf.end(), info->namebuf.begin(), [] (char ch) { return std::tolower(uint8_t(ch)); });
+		(*info->cbs->element_end)(info->cbs->param, info->namebuf.c_str(), value.c_str());
+	}
+}
+
+
+
 /***************************************************************************
     NODE/ATTRIBUTE ADDITIONS
 ***************************************************************************/
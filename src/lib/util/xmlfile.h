@@ -16,9 +16,11 @@
 #include "osdcore.h"
 #include "corefile.h"
 
+#include <cstdint>
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 // forward type declarations
@@ -154,6 +156,9 @@ public:
 	// add an attribute even if an attribute with the same name already exists
 	void add_attribute(const char *name, const char *value);
 
+	// append this node and its children to a compact binary representation
+	void serialize_binary(std::vector<std::uint8_t> &buffer) const;
+
 
 
 	int                     line;           /* line number for this node's start */
@@ -204,6 +209,32 @@ private:
 };
 
 
+// event-driven parser for consumers that scan a document exactly once;
+// no DOM is built, so nothing is allocated per node or attribute
+class parser
+{
+public:
+	// parse event callbacks; either handler may be nullptr.  element and
+	// attribute names are normalized to lowercase as for data_node, and
+	// attributes are passed as alternating name/value pairs terminated by
+	// a null name.  element_end receives the element's accumulated
+	// character data, trimmed unless PARSE_FLAG_WHITESPACE_SIGNIFICANT
+	// is set
+	struct callbacks
+	{
+		void (*element_start)(void *param, const char *name, const char **attributes);
+		void (*element_end)(void *param, const char *name, const char *value);
+		void *param;
+	};
+
+	// parse an XML file, delivering events as elements are seen
+	static bool read(util::core_file &file, callbacks const &cbs, parse_options const *opts);
+
+	// parse an XML string, delivering events as elements are seen
+	static bool string_read(const char *string, callbacks const &cbs, parse_options const *opts);
+};
+
+
 // a node representing the root of a document
 class file : public data_node
 {
@@ -222,6 +253,10 @@ public:
 	// parse an XML string into its nodes
 	static ptr string_read(const char *string, parse_options const *opts);
 
+	// reconstruct a tree from the compact binary representation produced by
+	// serialize_binary; returns nullptr if the data is malformed
+	static ptr deserialize_binary(const std::uint8_t *data, std::size_t size);
+
 	// write an XML tree to a file
 	void write(util::core_file &file) const;
 
@@ -519,6 +519,22 @@ void k053247_device::zdrawgfxzoom32GP(
 	pal_base  = palette().pens() + m_gfx->colorbase() + (color % m_gfx->colors()) * granularity;
 	shd_base  = palette().shadow_table();
 
+	// the alpha level is fixed for the whole call, so fuse the source half of
+	// the blend into a per-pen table; the inner loops are then left with one
+	// multiply-add per packed channel pair instead of the full blend
+	uint32_t premul_rb[256], premul_g[256];
+	uint32_t inv_alpha = 0;
+	if (drawmode & 2)
+	{
+		inv_alpha = 256 - alpha;
+		for (eax = 1; eax < granularity && eax < 256; eax++)
+		{
+			const uint32_t s = pal_base[eax];
+			premul_rb[eax] = (s & 0x00ff00ff) * uint32_t(alpha);
+			premul_g[eax]  = (s & 0x0000ff00) * uint32_t(alpha);
+		}
+	}
+
 	dst_ptr   = &bitmap.pix32(0);
 	dst_pitch = bitmap.rowpixels();
 	dst_minx  = cliprect.min_x;
@@ -681,7 +697,11 @@ void k053247_device::zdrawgfxzoom32GP(
 							if (!eax || ozbuf_ptr[ecx] < z8) continue;
 							ozbuf_ptr[ecx] = z8;
 
-							dst_ptr[ecx] = alpha_blend_r32(pal_base[eax], dst_ptr[ecx], alpha);
+							{
+								const uint32_t d32 = dst_ptr[ecx];
+								dst_ptr[ecx] = (((premul_rb[eax] + (d32 & 0x00ff00ff) * inv_alpha) >> 8) & 0x00ff00ff)
+										| (((premul_g[eax] + (d32 & 0x0000ff00) * inv_alpha) >> 8) & 0x0000ff00);
+							}
 						}
 						while (++ecx);
 
@@ -707,7 +727,11 @@ void k053247_device::zdrawgfxzoom32GP(
 							if (!eax || eax >= shdpen || ozbuf_ptr[ecx] < z8) continue;
 							ozbuf_ptr[ecx] = z8;
 
-							dst_ptr[ecx] = alpha_blend_r32(pal_base[eax], dst_ptr[ecx], alpha);
+							{
+								const uint32_t d32 = dst_ptr[ecx];
+								dst_ptr[ecx] = (((premul_rb[eax] + (d32 & 0x00ff00ff) * inv_alpha) >> 8) & 0x00ff00ff)
+										| (((premul_g[eax] + (d32 & 0x0000ff00) * inv_alpha) >> 8) & 0x0000ff00);
+							}
 						}
 						while (++ecx);
 
@@ -830,7 +854,11 @@ void k053247_device::zdrawgfxzoom32GP(
 							if (!eax || ozbuf_ptr[ecx] < z8) continue;
 							ozbuf_ptr[ecx] = z8;
 
-							dst_ptr[ecx] = alpha_blend_r32(pal_base[eax], dst_ptr[ecx], alpha);
+							{
+								const uint32_t d32 = dst_ptr[ecx];
+								dst_ptr[ecx] = (((premul_rb[eax] + (d32 & 0x00ff00ff) * inv_alpha) >> 8) & 0x00ff00ff)
+										| (((premul_g[eax] + (d32 & 0x0000ff00) * inv_alpha) >> 8) & 0x0000ff00);
+							}
 						}
 						while (++ecx);
 
@@ -850,7 +878,11 @@ void k053247_device::zdrawgfxzoom32GP(
 							if (!eax || eax >= shdpen || ozbuf_ptr[ecx] < z8) continue;
 							ozbuf_ptr[ecx] = z8;
 
-							dst_ptr[ecx] = alpha_blend_r32(pal_base[eax], dst_ptr[ecx], alpha);
+							{
+								const uint32_t d32 = dst_ptr[ecx];
+								dst_ptr[ecx] = (((premul_rb[eax] + (d32 & 0x00ff00ff) * inv_alpha) >> 8) & 0x00ff00ff)
+										| (((premul_g[eax] + (d32 & 0x0000ff00) * inv_alpha) >> 8) & 0x0000ff00);
+							}
 						}
 						while (++ecx);
 
@@ -22,6 +22,9 @@ neosprite_base_device::neosprite_base_device(
 {
 }
 
+#define MAX_SPRITES_PER_SCREEN    (381)
+#define MAX_SPRITES_PER_LINE      (96)
+
 void neosprite_base_device::device_start()
 {
 	m_videoram = std::make_unique<uint16_t[]>(0x8000 + 0x800);
@@ -30,6 +33,13 @@ void neosprite_base_device::device_start()
 	/* clear allocated memory */
 	memset(m_videoram.get(), 0x00, (0x8000 + 0x800) * sizeof(uint16_t));
 
+	/* the parse cache holds one evaluated sprite list per scanline; a
+	   generation of 0 means "never evaluated", so start the counter at 1 */
+	m_parse_cache = std::make_unique<uint16_t[]>(NEOGEO_VTOTAL * (MAX_SPRITES_PER_LINE + 1));
+	m_parse_cache_gen = std::make_unique<uint32_t[]>(NEOGEO_VTOTAL);
+	memset(m_parse_cache_gen.get(), 0x00, NEOGEO_VTOTAL * sizeof(uint32_t));
+	m_sprite_parse_gen = 1;
+
 	create_sprite_line_timer();
 	create_auto_animation_timer();
 
@@ -58,6 +68,13 @@ void neosprite_base_device::device_start()
 	m_region_zoomy = memregion(":zoomy")->base();
 }
 
+
+void neosprite_base_device::device_post_load()
+{
+	/* the restored sprite RAM invalidates every cached sprite list */
+	m_sprite_parse_gen++;
+}
+
 void neosprite_base_device::device_reset()
 {
 	//m_sprite_gfx_address_mask = 0;
@@ -94,6 +111,11 @@ void neosprite_base_device::set_videoram_data(uint16_t data)
 {
 	m_videoram[m_vram_offset] = data;
 
+	/* writes to the y-control region change which sprites fall on which
+	   scanline, so they invalidate the parse cache */
+	if ((m_vram_offset & 0xfe00) == 0x8200)
+		m_sprite_parse_gen++;
+
 	/* auto increment/decrement the current offset - A15 is NOT affected */
 	set_videoram_offset((m_vram_offset & 0x8000) | ((m_vram_offset + m_vram_modulo) & 0x7fff));
 }
@@ -268,9 +290,6 @@ inline void neosprite_base_device::draw_fixed_layer_2pixels(uint32_t*&pixel_addr
  *
  *************************************/
 
-#define MAX_SPRITES_PER_SCREEN    (381)
-#define MAX_SPRITES_PER_LINE      (96)
-
 
 /* horizontal zoom table - verified on real hardware */
 static const int zoom_x_tables[][16] =
@@ -508,6 +527,15 @@ void neosprite_base_device::parse_sprites(int scanline)
 	else
 		sprite_list = &m_videoram_drawsource[0x8600];
 
+	/* if the y-control region has not been written since this scanline was
+	   last evaluated, reuse the cached list */
+	uint16_t *cached_list = &m_parse_cache[scanline * (MAX_SPRITES_PER_LINE + 1)];
+	if (m_parse_cache_gen[scanline] == m_sprite_parse_gen)
+	{
+		memcpy(sprite_list, cached_list, (MAX_SPRITES_PER_LINE + 1) * sizeof(sprite_list[0]));
+		return;
+	}
+
 	/* scan all sprites */
 	for (sprite_number = 0; sprite_number < MAX_SPRITES_PER_SCREEN; sprite_number++)
 	{
@@ -541,6 +569,10 @@ void neosprite_base_device::parse_sprites(int scanline)
 
 	/* fill the rest of the sprite list with 0, including one extra entry */
 	memset(sprite_list, 0, sizeof(sprite_list[0]) * (MAX_SPRITES_PER_LINE - active_sprite_count + 1));
+
+	/* remember the result for as long as the y-control region stays unwritten */
+	memcpy(cached_list, sprite_list - active_sprite_count, (MAX_SPRITES_PER_LINE + 1) * sizeof(sprite_list[0]));
+	m_parse_cache_gen[scanline] = m_sprite_parse_gen;
 }
 
 
@@ -813,6 +845,9 @@ void neosprite_midas_device::device_start()
 void neosprite_midas_device::buffer_vram()
 {
 	memcpy(m_videoram_buffer.get(), m_videoram.get(), (0x8000 + 0x800) * sizeof(uint16_t));
+
+	/* the draw source just changed wholesale, so cached sprite lists are stale */
+	m_sprite_parse_gen++;
 }
 
 inline void neosprite_midas_device::draw_fixed_layer_2pixels(uint32_t*&pixel_addr, int offset, uint8_t* gfx_base, const pen_t* char_pens)
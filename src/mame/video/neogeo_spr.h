@@ -54,6 +54,12 @@ public:
 	std::unique_ptr<uint16_t[]>     m_videoram;
 	uint16_t     *m_videoram_drawsource;
 
+	/* per-scanline sprite evaluation cache, keyed on the generation of the
+	   y-control region of sprite RAM */
+	std::unique_ptr<uint16_t[]>     m_parse_cache;
+	std::unique_ptr<uint32_t[]>     m_parse_cache_gen;
+	uint32_t     m_sprite_parse_gen;
+
 	uint16_t     m_vram_offset;
 	uint16_t     m_vram_read_buffer;
 	uint16_t     m_vram_modulo;
@@ -89,6 +95,7 @@ protected:
 
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 	uint32_t get_region_mask(uint8_t* rgn, uint32_t rgn_size);
 	uint8_t* m_region_sprites; uint32_t m_region_sprites_size;
 	uint8_t* m_region_fixed; uint32_t m_region_fixed_size;
@@ -15,6 +15,7 @@
 
 #include "inputdev.h"
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -190,6 +191,9 @@ enum
 #define KEY_MAIL            0xEC    /* Mail */
 #define KEY_MEDIASELECT     0xED    /* Media Select */
 
+typedef std::chrono::high_resolution_clock clock_type;
+typedef std::chrono::time_point<std::chrono::high_resolution_clock> timepoint_type;
+
 //============================================================
 //  device_info
 //============================================================
@@ -234,6 +238,9 @@ public:
 	// Poll and reset methods
 	virtual void poll() {};
 	virtual void reset() = 0;
+
+	// true when asynchronously queued events are waiting to be processed
+	virtual bool has_pending_events() const { return false; }
 };
 
 //============================================================
@@ -246,7 +253,16 @@ template <class TEvent>
 class event_based_device : public device_info
 {
 private:
-	std::queue<TEvent>   m_event_queue;
+	// an event plus the time it was queued by the OS event/message thread
+	struct queued_event
+	{
+		TEvent          event;
+		timepoint_type  time;
+	};
+
+	std::queue<queued_event> m_event_queue;
+	std::atomic<int>         m_pending_events;
+	timepoint_type           m_last_event_time;
 
 protected:
 	std::mutex           m_device_lock;
@@ -255,19 +271,34 @@ protected:
 
 public:
 	event_based_device(running_machine &machine, const char *name, const char *id, input_device_class deviceclass, input_module &module)
-		: device_info(machine, name, id, deviceclass, module)
+		: device_info(machine, name, id, deviceclass, module),
+		m_pending_events(0)
+	{
+	}
+
+	// timestamp of the most recently queued event
+	timepoint_type last_event_time() const { return m_last_event_time; }
+
+	bool has_pending_events() const override
 	{
+		// lock-free so state callbacks can cheaply decide whether to poll
+		return m_pending_events.load(std::memory_order_acquire) != 0;
 	}
 
 	void queue_events(const TEvent *events, int count)
 	{
+		auto const now = clock_type::now();
+
 		std::lock_guard<std::mutex> scope_lock(m_device_lock);
 		for (int i = 0; i < count; i++)
-			m_event_queue.push(events[i]);
+			m_event_queue.push(queued_event{ events[i], now });
+		m_last_event_time = now;
 
 		// If we've gone over the size, remove old events from the queue
 		while (m_event_queue.size() > DEFAULT_EVENT_QUEUE_SIZE)
 			m_event_queue.pop();
+
+		m_pending_events.store(int(m_event_queue.size()), std::memory_order_release);
 	}
 
 	void virtual poll() override
@@ -277,10 +308,12 @@ public:
 		// Process each event until the queue is empty
 		while (!m_event_queue.empty())
 		{
-			TEvent &next_event = m_event_queue.front();
-			process_event(next_event);
+			queued_event &next_event = m_event_queue.front();
+			process_event(next_event.event);
 			m_event_queue.pop();
 		}
+
+		m_pending_events.store(0, std::memory_order_release);
 	}
 };
 
@@ -304,6 +337,14 @@ public:
 			device->poll();
 	}
 
+	bool has_pending_events() const
+	{
+		for (auto &device: m_list)
+			if (device->has_pending_events())
+				return true;
+		return false;
+	}
+
 	void reset_devices()
 	{
 		for (auto &device: m_list)
@@ -418,9 +459,6 @@ public:
 
 class osd_options;
 
-typedef std::chrono::high_resolution_clock clock_type;
-typedef std::chrono::time_point<std::chrono::high_resolution_clock> timepoint_type;
-
 // 10 milliseconds polling interval
 #define MIN_POLLING_INTERVAL 10
 
@@ -463,8 +501,11 @@ public:
 
 	void poll_if_necessary(running_machine &machine) override
 	{
+		// poll immediately when asynchronously queued events are waiting so
+		// they don't sit in the queue for up to a full polling interval;
+		// otherwise rate-limit the (more expensive) device polls as before
 		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(m_clock.now() - m_last_poll);
-		if (elapsed.count() >= MIN_POLLING_INTERVAL)
+		if (elapsed.count() >= MIN_POLLING_INTERVAL || m_devicelist.has_pending_events())
 		{
 			poll(machine);
 		}
@@ -11,6 +11,7 @@
 
 #include "emu.h"
 #include "osdepend.h"
+#include "osdsync.h"
 #include "modules/lib/osdobj_common.h"
 
 const options_entry osd_options::s_option_entries[] =
@@ -47,6 +48,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD PERFORMANCE OPTIONS" },
 	{ OSDOPTION_NUMPROCESSORS ";np",          OSDOPTVAL_AUTO,   OPTION_STRING,    "number of processors; this overrides the number the system reports" },
 	{ OSDOPTION_BENCH,                        "0",              OPTION_INTEGER,   "benchmark for the given number of emulated seconds; implies -video none -sound none -nothrottle" },
+	{ OSDOPTION_THREADAFFINITY ";ta",         OSDOPTVAL_NONE,   OPTION_STRING,    "host CPU affinity for this instance's threads: none, compact (stay on one NUMA node), or a CPU list such as 0-3,8" },
 
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD VIDEO OPTIONS" },
 // OS X can be trusted to have working hardware OpenGL, so default to it on for the best user experience
@@ -56,6 +58,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ OSDOPTION_MAXIMIZE ";max",              "1",              OPTION_BOOLEAN,   "default to maximized windows; otherwise, windows will be minimized" },
 	{ OSDOPTION_WAITVSYNC ";vs",              "0",              OPTION_BOOLEAN,   "enable waiting for the start of VBLANK before flipping screens; reduces tearing effects" },
 	{ OSDOPTION_SYNCREFRESH ";srf",           "0",              OPTION_BOOLEAN,   "enable using the start of VBLANK for throttling instead of the game time" },
+	{ OSDOPTION_PIPELINE,                     "0",              OPTION_BOOLEAN,   "render frames on a worker thread, overlapping emulation and drawing at the cost of one frame of latency" },
 	{ OSD_MONITOR_PROVIDER,                   OSDOPTVAL_AUTO,   OPTION_STRING,    "monitor discovery method" },
 
 	// per-window options
@@ -402,6 +405,41 @@ void osd_common_t::output_callback(osd_output_channel channel, const char *msg,
 	}
 }
 
+//-------------------------------------------------
+//  parse_affinity_list - parse a CPU list such as
+//  "0-3,8" into a bitmask; returns 0 on error
+//-------------------------------------------------
+
+static uint64_t parse_affinity_list(const char *list)
+{
+	uint64_t mask = 0;
+	const char *str = list;
+	while (*str != 0)
+	{
+		char *end;
+		long first = strtol(str, &end, 10);
+		if (end == str || first < 0 || first > 63)
+			return 0;
+		long last = first;
+		if (*end == '-')
+		{
+			str = end + 1;
+			last = strtol(str, &end, 10);
+			if (end == str || last < first || last > 63)
+				return 0;
+		}
+		for (long cpu = first; cpu <= last; cpu++)
+			mask |= (uint64_t)1 << cpu;
+		if (*end == ',')
+			end++;
+		else if (*end != 0)
+			return 0;
+		str = end;
+	}
+	return mask;
+}
+
+
 //-------------------------------------------------
 //  init - initialize the OSD system.
 //-------------------------------------------------
@@ -449,6 +487,27 @@ void osd_common_t::init(running_machine &machine)
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&osd_common_t::osd_exit, this));
 
 
+	// apply the thread affinity policy before any worker threads spin up
+	const char *affinity = options.thread_affinity();
+	if (*affinity != 0 && strcmp(affinity, OSDOPTVAL_NONE) != 0)
+	{
+		uint64_t mask;
+		if (strcmp(affinity, "compact") == 0)
+		{
+			mask = osd_thread_affinity_compact_mask();
+			if (mask == 0)
+				osd_printf_warning("NUMA topology not available on this host; -thread_affinity compact ignored\n");
+		}
+		else
+		{
+			mask = parse_affinity_list(affinity);
+			if (mask == 0)
+				osd_printf_warning("Invalid value %s for -thread_affinity; expected none, compact or a CPU list\n", affinity);
+		}
+		if (mask != 0)
+			osd_thread_affinity_set_mask(mask);
+	}
+
 	/* now setup watchdog */
 	int watchdog_timeout = options.watchdog();
 
@@ -43,6 +43,7 @@
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
 #define OSDOPTION_BENCH                 "bench"
+#define OSDOPTION_THREADAFFINITY        "thread_affinity"
 
 #define OSDOPTION_VIDEO                 "video"
 #define OSDOPTION_NUMSCREENS            "numscreens"
@@ -50,6 +51,7 @@
 #define OSDOPTION_MAXIMIZE              "maximize"
 #define OSDOPTION_WAITVSYNC             "waitvsync"
 #define OSDOPTION_SYNCREFRESH           "syncrefresh"
+#define OSDOPTION_PIPELINE              "pipeline"
 
 #define OSDOPTION_SCREEN                "screen"
 #define OSDOPTION_ASPECT                "aspect"
@@ -112,6 +114,7 @@ public:
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
+	const char *thread_affinity() const { return value(OSDOPTION_THREADAFFINITY); }
 
 	// video options
 	const char *video() const { return value(OSDOPTION_VIDEO); }
@@ -120,6 +123,7 @@ public:
 	bool maximize() const { return bool_value(OSDOPTION_MAXIMIZE); }
 	bool wait_vsync() const { return bool_value(OSDOPTION_WAITVSYNC); }
 	bool sync_refresh() const { return bool_value(OSDOPTION_SYNCREFRESH); }
+	bool pipeline() const { return bool_value(OSDOPTION_PIPELINE); }
 
 	// per-window options
 	const char *screen() const { return value(OSDOPTION_SCREEN); }
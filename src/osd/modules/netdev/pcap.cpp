@@ -102,6 +102,7 @@ struct netdev_pcap_context {
 	int packetlens[32];
 	int head;
 	int tail;
+	bool tail_borrowed;
 };
 #endif
 
@@ -129,6 +130,10 @@ static void netdev_pcap_handler(u_char *user, const struct pcap_pkthdr *h, const
 
 	if(!ctx->p) return;
 
+	if(h->len > sizeof(ctx->packets[0])) {
+		printf("packet too large for ring slot, dropping packet\n");
+		return;
+	}
 	if(OSAtomicCompareAndSwapInt((ctx->head+1) & 0x1F, ctx->tail, &ctx->tail)) {
 		printf("buffer full, dropping packet\n");
 		return;
@@ -175,6 +180,7 @@ netdev_pcap::netdev_pcap(const char *name, class device_network_interface *ifdev
 #ifdef SDLMAME_MACOSX
 	m_ctx.head = 0;
 	m_ctx.tail = 0;
+	m_ctx.tail_borrowed = false;
 	m_ctx.p = m_p;
 	pthread_create(&m_thread, nullptr, netdev_pcap_blocker, &m_ctx);
 #endif
@@ -214,19 +220,24 @@ int netdev_pcap::send(uint8_t *buf, int len)
 int netdev_pcap::recv_dev(uint8_t **buf)
 {
 #ifdef SDLMAME_MACOSX
-	uint8_t pktbuf[2048];
-	int ret;
+	// release the slot lent out by the previous call; until then the ring's
+	// full-check keeps the capture thread from overwriting it
+	if(m_ctx.tail_borrowed) {
+		m_ctx.tail_borrowed = false;
+		OSAtomicCompareAndSwapInt(m_ctx.tail, (m_ctx.tail+1) & 0x1F, &m_ctx.tail);
+	}
 
 	// Empty
 	if(OSAtomicCompareAndSwapInt(m_ctx.head, m_ctx.tail, &m_ctx.tail)) {
 		return 0;
 	}
 
-	memcpy(pktbuf, m_ctx.packets[m_ctx.tail], m_ctx.packetlens[m_ctx.tail]);
-	ret = m_ctx.packetlens[m_ctx.tail];
-	OSAtomicCompareAndSwapInt(m_ctx.tail, (m_ctx.tail+1) & 0x1F, &m_ctx.tail);
-	*buf = pktbuf;
-	return ret;
+	// hand the ring slot to the caller as a borrowed buffer; it is only
+	// valid until the next recv_dev call, which is how the pcap_next_ex
+	// path behaves as well
+	*buf = m_ctx.packets[m_ctx.tail];
+	m_ctx.tail_borrowed = true;
+	return m_ctx.packetlens[m_ctx.tail];
 #else
 	struct pcap_pkthdr *header;
 	if(!m_p) return 0;
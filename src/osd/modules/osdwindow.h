@@ -259,6 +259,7 @@ struct osd_video_config
 	int                 mode;                       // output mode
 	int                 waitvsync;                  // spin until vsync
 	int                 syncrefresh;                // sync only to refresh rate
+	int                 pipeline;                   // render frames on a worker thread
 	int                 switchres;                  // switch resolutions
 
 	// d3d, accel, opengl
@@ -170,7 +170,9 @@ shaders::shaders() :
 	focus_effect(nullptr), phosphor_effect(nullptr), deconverge_effect(nullptr), color_effect(nullptr),
 	ntsc_effect(nullptr), bloom_effect(nullptr), downsample_effect(nullptr), vector_effect(nullptr),
 	curr_texture(nullptr), curr_render_target(nullptr), curr_poly(nullptr),
-	d3dx_create_effect_from_file_ptr(nullptr)
+	d3dx_create_effect_from_file_ptr(nullptr),
+	d3dx_create_effect_ptr(nullptr),
+	d3dx_create_effect_compiler_from_file_ptr(nullptr)
 {
 }
 
@@ -449,6 +451,11 @@ bool shaders::init(d3d_base *d3dintf, running_machine *machine, renderer_d3d9 *r
 		return false;
 	}
 
+	// optional entry points for the compiled-effect cache; if either is
+	// missing we simply compile from source on every run as before
+	d3dx_create_effect_ptr = d3dx9_dll->bind<d3dx_create_effect_fn>("D3DXCreateEffect");
+	d3dx_create_effect_compiler_from_file_ptr = d3dx9_dll->bind<d3dx_create_effect_compiler_from_file_fn>("D3DXCreateEffectCompilerFromFileW");
+
 	d3dintf->post_fx_available = true;
 
 	this->d3dintf = d3dintf;
@@ -2488,7 +2495,57 @@ effect::effect(shaders *shadersys, IDirect3DDevice9 *dev, const char *name, cons
 	sprintf(name_cstr, "%s\\%s", path, name);
 	auto effect_name = osd::text::to_tstring(name_cstr);
 
-	HRESULT hr = (*shadersys->d3dx_create_effect_from_file_ptr)(dev, effect_name.c_str(), nullptr, nullptr, 0, nullptr, &m_effect, &buffer_errors);
+	// if we can create effects from memory, try the compiled-effect cache
+	// first; entries are keyed on the source text so edits invalidate them
+	HRESULT hr = E_FAIL;
+	if (shadersys->d3dx_create_effect_ptr != nullptr && shadersys->d3dx_create_effect_compiler_from_file_ptr != nullptr)
+	{
+		util::core_file::ptr srcfile;
+		if (util::core_file::open(name_cstr, OPEN_FLAG_READ, srcfile) == osd_file::error::NONE && srcfile->size() != 0)
+		{
+			std::vector<uint8_t> source(size_t(srcfile->size()));
+			if (srcfile->read(&source[0], uint32_t(source.size())) == source.size())
+			{
+				char cache_cstr[1024];
+				sprintf(cache_cstr, "%s_%08x.fxc", name_cstr, uint32_t(util::crc32_creator::simple(&source[0], uint32_t(source.size()))));
+
+				// load a previously compiled binary if one matches
+				util::core_file::ptr cachefile;
+				if (util::core_file::open(cache_cstr, OPEN_FLAG_READ, cachefile) == osd_file::error::NONE && cachefile->size() != 0)
+				{
+					std::vector<uint8_t> binary(size_t(cachefile->size()));
+					if (cachefile->read(&binary[0], uint32_t(binary.size())) == binary.size())
+						hr = (*shadersys->d3dx_create_effect_ptr)(dev, &binary[0], UINT(binary.size()), nullptr, nullptr, 0, nullptr, &m_effect, &buffer_errors);
+				}
+
+				// otherwise compile once and persist the binary for next run
+				if (FAILED(hr))
+				{
+					LPD3DXEFFECTCOMPILER compiler = nullptr;
+					if (SUCCEEDED((*shadersys->d3dx_create_effect_compiler_from_file_ptr)(effect_name.c_str(), nullptr, nullptr, 0, &compiler, &buffer_errors)))
+					{
+						LPD3DXBUFFER binary = nullptr;
+						if (SUCCEEDED(compiler->CompileEffect(0, &binary, &buffer_errors)))
+						{
+							hr = (*shadersys->d3dx_create_effect_ptr)(dev, binary->GetBufferPointer(), binary->GetBufferSize(), nullptr, nullptr, 0, nullptr, &m_effect, &buffer_errors);
+							if (SUCCEEDED(hr))
+							{
+								util::core_file::ptr outfile;
+								if (util::core_file::open(cache_cstr, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, outfile) == osd_file::error::NONE)
+									outfile->write(binary->GetBufferPointer(), binary->GetBufferSize());
+							}
+							binary->Release();
+						}
+						compiler->Release();
+					}
+				}
+			}
+		}
+	}
+
+	// fall back to compiling straight from the source file
+	if (FAILED(hr))
+		hr = (*shadersys->d3dx_create_effect_from_file_ptr)(dev, effect_name.c_str(), nullptr, nullptr, 0, nullptr, &m_effect, &buffer_errors);
 	if (FAILED(hr))
 	{
 		if (buffer_errors != nullptr)
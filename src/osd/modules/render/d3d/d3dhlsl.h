@@ -20,6 +20,8 @@
 
 // Typedefs for dynamically loaded functions
 typedef HRESULT (WINAPI *d3dx_create_effect_from_file_fn)(LPDIRECT3DDEVICE9, LPCTSTR, const D3DXMACRO *, LPD3DXINCLUDE, DWORD, LPD3DXEFFECTPOOL, LPD3DXEFFECT *, LPD3DXBUFFER *);
+typedef HRESULT (WINAPI *d3dx_create_effect_fn)(LPDIRECT3DDEVICE9, LPCVOID, UINT, const D3DXMACRO *, LPD3DXINCLUDE, DWORD, LPD3DXEFFECTPOOL, LPD3DXEFFECT *, LPD3DXBUFFER *);
+typedef HRESULT (WINAPI *d3dx_create_effect_compiler_from_file_fn)(LPCTSTR, const D3DXMACRO *, LPD3DXINCLUDE, DWORD, LPD3DXEFFECTCOMPILER *, LPD3DXBUFFER *);
 
 struct slider_state;
 
@@ -406,6 +408,8 @@ private:
 
 	osd::dynamic_module::ptr d3dx9_dll;
 	d3dx_create_effect_from_file_fn d3dx_create_effect_from_file_ptr;
+	d3dx_create_effect_fn d3dx_create_effect_ptr;
+	d3dx_create_effect_compiler_from_file_fn d3dx_create_effect_compiler_from_file_ptr;
 };
 
 #endif
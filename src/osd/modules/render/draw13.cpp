@@ -690,6 +690,7 @@ texture_info::texture_info(renderer_sdl2 *renderer, const render_texinfo &texsou
 	m_texinfo = texsource;
 	m_texinfo.seqid = -1; // force set data
 	m_is_rotated = false;
+	m_uploaded = false;
 	m_setup = setup;
 	m_sdl_blendmode = map_blendmode(PRIMFLAG_GET_BLENDMODE(flags));
 	m_pitch = 0;
@@ -771,13 +772,31 @@ void texture_info::set_data(const render_texinfo &texsource, const uint32_t flag
 		{
 			m_pixels = texsource.base;
 			m_pitch = m_texinfo.rowpixels * m_copyinfo->blitter->m_dest_bpp;
+
+			// passthrough textures are neither rotated nor converted, so the
+			// upload can be restricted to the changed rows once the full
+			// texture has been uploaded at least once
+			if (m_uploaded &&
+				texsource.dirty_top >= 0 && texsource.dirty_top <= texsource.dirty_bottom &&
+				texsource.dirty_bottom < int32_t(texsource.height))
+			{
+				SDL_Rect rect;
+				rect.x = 0;
+				rect.y = texsource.dirty_top;
+				rect.w = texsource.width;
+				rect.h = texsource.dirty_bottom - texsource.dirty_top + 1;
+				SDL_UpdateTexture(m_texture_id, &rect, (const uint8_t *) m_pixels + rect.y * m_pitch, m_pitch);
+			}
+			else
+				SDL_UpdateTexture(m_texture_id, nullptr, m_pixels, m_pitch);
 		}
 		else
 		{
 			m_pitch = m_setup.rotwidth * m_copyinfo->blitter->m_dest_bpp;
 			m_copyinfo->blitter->texop(this, &texsource);
+			SDL_UpdateTexture(m_texture_id, nullptr, m_pixels, m_pitch);
 		}
-		SDL_UpdateTexture(m_texture_id, nullptr, m_pixels, m_pitch);
+		m_uploaded = true;
 	}
 	else
 	{
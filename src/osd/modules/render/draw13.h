@@ -98,6 +98,7 @@ private:
 
 	SDL_Texture *       m_texture_id;
 	bool                m_is_rotated;
+	bool                m_uploaded;           // full texture uploaded at least once?
 
 	int                 m_format;             // texture format
 	SDL_BlendMode       m_sdl_blendmode;
@@ -502,6 +502,76 @@ void renderer_bgfx::render_post_screen_quad(int view, render_primitive* prim, bg
 	m_screen_effect[blend]->submit(m_ortho_view->get_index());
 }
 
+//============================================================
+//  Batched screen-quad submission.  Consecutive screen quads
+//  are collected into a run and submitted from one transient
+//  vertex buffer, grouped by blend mode so bgfx encodes draws
+//  with the same program back to back.  Screens in a layout
+//  occupy disjoint regions, so reordering within a run never
+//  changes the image; the run is flushed before any other
+//  primitive is submitted to preserve layering.
+//============================================================
+
+void renderer_bgfx::queue_screen_quad(render_primitive *prim, int32_t screen)
+{
+	m_screen_quads.push_back({ prim, screen });
+}
+
+void renderer_bgfx::flush_screen_quads()
+{
+	if (m_screen_quads.empty())
+	{
+		return;
+	}
+
+	// group the run by blend mode to minimize program and state switches
+	std::stable_sort(m_screen_quads.begin(), m_screen_quads.end(), [](const screen_quad &a, const screen_quad &b)
+	{
+		return PRIMFLAG_GET_BLENDMODE(a.prim->flags) < PRIMFLAG_GET_BLENDMODE(b.prim->flags);
+	});
+
+	// one transient buffer holds every quad in the run
+	const uint32_t num_vertices = m_screen_quads.size() * 6;
+	if (num_vertices != bgfx::getAvailTransientVertexBuffer(num_vertices, ScreenVertex::ms_decl))
+	{
+		m_screen_quads.clear();
+		return;
+	}
+	bgfx::TransientVertexBuffer buffer;
+	bgfx::allocTransientVertexBuffer(&buffer, num_vertices, ScreenVertex::ms_decl);
+
+	uint32_t texture_flags = BGFX_TEXTURE_U_CLAMP | BGFX_TEXTURE_V_CLAMP;
+	if (video_config.filter == 0)
+	{
+		texture_flags |= BGFX_TEXTURE_MIN_POINT | BGFX_TEXTURE_MAG_POINT | BGFX_TEXTURE_MIP_POINT;
+	}
+
+	for (uint32_t quadnum = 0; quadnum < m_screen_quads.size(); quadnum++)
+	{
+		render_primitive* prim = m_screen_quads[quadnum].prim;
+		ScreenVertex* vertices = reinterpret_cast<ScreenVertex*>(buffer.data) + quadnum * 6;
+
+		float x[4] = { prim->bounds.x0, prim->bounds.x1, prim->bounds.x0, prim->bounds.x1 };
+		float y[4] = { prim->bounds.y0, prim->bounds.y0, prim->bounds.y1, prim->bounds.y1 };
+		float u[4] = { prim->texcoords.tl.u, prim->texcoords.tr.u, prim->texcoords.bl.u, prim->texcoords.br.u };
+		float v[4] = { prim->texcoords.tl.v, prim->texcoords.tr.v, prim->texcoords.bl.v, prim->texcoords.br.v };
+
+		vertex(&vertices[0], x[0], y[0], 0, 0xffffffff, u[0], v[0]);
+		vertex(&vertices[1], x[1], y[1], 0, 0xffffffff, u[1], v[1]);
+		vertex(&vertices[2], x[3], y[3], 0, 0xffffffff, u[3], v[3]);
+		vertex(&vertices[3], x[3], y[3], 0, 0xffffffff, u[3], v[3]);
+		vertex(&vertices[4], x[2], y[2], 0, 0xffffffff, u[2], v[2]);
+		vertex(&vertices[5], x[0], y[0], 0, 0xffffffff, u[0], v[0]);
+
+		uint32_t blend = PRIMFLAG_GET_BLENDMODE(prim->flags);
+		bgfx::setVertexBuffer(0, &buffer, quadnum * 6, 6);
+		bgfx::setTexture(0, m_screen_effect[blend]->uniform("s_tex")->handle(), m_targets->target(m_screen_quads[quadnum].screen, "output")->texture(), texture_flags);
+		m_screen_effect[blend]->submit(m_ortho_view->get_index());
+	}
+
+	m_screen_quads.clear();
+}
+
 void renderer_bgfx::render_avi_quad()
 {
 	m_avi_view->set_index(s_current_view);
@@ -853,6 +923,8 @@ int renderer_bgfx::draw(int update)
 
 		if (status != BUFFER_EMPTY && status != BUFFER_SCREEN)
 		{
+			// submit any queued screen quads first so layering is preserved
+			flush_screen_quads();
 			bgfx::setVertexBuffer(0,&buffer);
 			bgfx::setTexture(0, m_gui_effect[blend]->uniform("s_tex")->handle(), m_texture_cache->texture());
 			m_gui_effect[blend]->submit(m_ortho_view->get_index());
@@ -864,6 +936,9 @@ int renderer_bgfx::draw(int update)
 		}
 	}
 
+	// submit any screen quads left queued at the end of the list
+	flush_screen_quads();
+
 	win->m_primlist->release_lock();
 
 	// This dummy draw call is here to make sure that view 0 is cleared
@@ -1021,13 +1096,14 @@ renderer_bgfx::buffer_status renderer_bgfx::buffer_primitives(bool atlas_valid,
 							s_current_view++;
 #else
 							setup_ortho_view();
-							render_post_screen_quad(m_ortho_view->get_index(), *prim, buffer, screen);
+							queue_screen_quad(*prim, screen);
 #endif
 							return BUFFER_SCREEN;
 						}
 						else
 						{
 							setup_ortho_view();
+							flush_screen_quads();
 							render_textured_quad(*prim, buffer);
 							return BUFFER_EMPTY;
 						}
@@ -105,6 +105,15 @@ private:
 	void render_textured_quad(render_primitive* prim, bgfx::TransientVertexBuffer* buffer);
 	void render_post_screen_quad(int view, render_primitive* prim, bgfx::TransientVertexBuffer* buffer, int32_t screen);
 
+	// batched screen-quad submission
+	struct screen_quad
+	{
+		render_primitive *prim;     // primitive holding bounds/texcoords
+		int32_t screen;             // index of the source screen target
+	};
+	void queue_screen_quad(render_primitive *prim, int32_t screen);
+	void flush_screen_quads();
+
 	void put_packed_quad(render_primitive *prim, uint32_t hash, ScreenVertex* vertex);
 	void put_packed_line(render_primitive *prim, ScreenVertex* vertex);
 	void put_polygon(const float* coords, uint32_t num_coords, float r, uint32_t rgba, ScreenVertex* vertex);
@@ -137,6 +146,8 @@ private:
 	bgfx_effect *m_screen_effect[4];
 	std::vector<uint32_t> m_seen_views;
 
+	std::vector<screen_quad> m_screen_quads;
+
 	std::map<uint32_t, rectangle_packer::packed_rectangle> m_hash_to_entry;
 	std::vector<rectangle_packer::packable_rectangle> m_texinfo;
 	rectangle_packer m_packer;
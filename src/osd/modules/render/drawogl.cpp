@@ -94,6 +94,34 @@ typedef void (APIENTRYP PFNGLDELETERENDERBUFFERSEXTPROC) (GLsizei n, const GLuin
 #define GL_WRITE_ONLY                     0x88B9
 #endif
 
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT                  0x0002
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT             0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT               0x0080
+#endif
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#endif
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT        0x00000001
+#endif
+
+// GL_ARB_buffer_storage / GL_ARB_sync entry points for the persistent-mapped
+// PBO ring; typedef'd locally so pre-4.4 headers still compile
+typedef void (APIENTRYP OSD_PFNGLBUFFERSTORAGEPROC) (GLenum, GLsizeiptr, const GLvoid *, GLbitfield);
+typedef GLvoid* (APIENTRYP OSD_PFNGLMAPBUFFERRANGEPROC) (GLenum, GLintptr, GLsizeiptr, GLbitfield);
+typedef void* (APIENTRYP OSD_PFNGLFENCESYNCPROC) (GLenum, GLbitfield);
+typedef GLenum (APIENTRYP OSD_PFNGLCLIENTWAITSYNCPROC) (void *, GLbitfield, uint64_t);
+typedef void (APIENTRYP OSD_PFNGLDELETESYNCPROC) (void *);
+
 #ifndef GL_ARRAY_BUFFER_ARB
 #define GL_ARRAY_BUFFER_ARB               0x8892
 #endif
@@ -232,6 +260,54 @@ void renderer_ogl::set_blendmode(int blendmode)
 	}
 }
 
+//============================================================
+//  vector beam batching
+//
+//  Beam segments are accumulated into a client-side vertex /
+//  color array and drawn with a single glDrawArrays call per
+//  run of identical state, so a 10,000-segment vector frame
+//  issues a handful of draw calls instead of one per segment.
+//============================================================
+
+void renderer_ogl::vector_batch_add(const render_primitive &prim, float hofs, float vofs)
+{
+	// per-vertex color carries the beam intensity through the batch
+	int numverts = (m_vecPrimitive == GL_POINTS) ? 1 : 2;
+	for (int i = 0; i < numverts; i++)
+	{
+		m_vecColor.push_back(prim.color.r);
+		m_vecColor.push_back(prim.color.g);
+		m_vecColor.push_back(prim.color.b);
+		m_vecColor.push_back(prim.color.a);
+	}
+
+	m_vecVertex.push_back(prim.bounds.x0 + hofs);
+	m_vecVertex.push_back(prim.bounds.y0 + vofs);
+	if (numverts == 2)
+	{
+		m_vecVertex.push_back(prim.bounds.x1 + hofs);
+		m_vecVertex.push_back(prim.bounds.y1 + vofs);
+	}
+}
+
+void renderer_ogl::vector_batch_flush()
+{
+	if (m_vecPrimitive != GL_NO_PRIMITIVE && !m_vecVertex.empty())
+	{
+		// point the fixed-function arrays at the batch and draw it in one go
+		glVertexPointer(2, GL_FLOAT, 0, &m_vecVertex[0]);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(4, GL_FLOAT, 0, &m_vecColor[0]);
+		glDrawArrays(m_vecPrimitive, 0, m_vecVertex.size() / 2);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, m_texVerticex);
+	}
+
+	m_vecVertex.clear();
+	m_vecColor.clear();
+	m_vecPrimitive = GL_NO_PRIMITIVE;
+}
+
 //============================================================
 //  STATIC VARIABLES
 //============================================================
@@ -254,6 +330,13 @@ static PFNGLBUFFERSUBDATAPROC pfn_glBufferSubData   = nullptr;
 static PFNGLMAPBUFFERPROC     pfn_glMapBuffer       = nullptr;
 static PFNGLUNMAPBUFFERPROC   pfn_glUnmapBuffer     = nullptr;
 
+// persistent-mapped PBO ring
+static OSD_PFNGLBUFFERSTORAGEPROC  pfn_glBufferStorage  = nullptr;
+static OSD_PFNGLMAPBUFFERRANGEPROC pfn_glMapBufferRange = nullptr;
+static OSD_PFNGLFENCESYNCPROC      pfn_glFenceSync      = nullptr;
+static OSD_PFNGLCLIENTWAITSYNCPROC pfn_glClientWaitSync = nullptr;
+static OSD_PFNGLDELETESYNCPROC     pfn_glDeleteSync     = nullptr;
+
 // FBO
 static PFNGLISFRAMEBUFFEREXTPROC   pfn_glIsFramebuffer          = nullptr;
 static PFNGLBINDFRAMEBUFFEREXTPROC pfn_glBindFramebuffer        = nullptr;
@@ -264,6 +347,38 @@ static PFNGLFRAMEBUFFERTEXTURE2DEXTPROC pfn_glFramebufferTexture2D  = nullptr;
 
 static int glsl_shader_feature = GLSL_SHADER_FEAT_PLAIN;
 
+//============================================================
+//  GLSL palette lookup (idx16 textures)
+//============================================================
+
+// dimensions of the palette lookup texture; 64k entries cover everything
+// a 16 bit index can address
+#define IDX16_LUT_WIDTH  256
+#define IDX16_LUT_HEIGHT 256
+
+static const char idx16_vertex_shader_source[] =
+"void main()\n"
+"{\n"
+"   gl_Position = ftransform();\n"
+"   gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+"}\n";
+
+// indices are uploaded as GL_LUMINANCE_ALPHA: luminance carries the low
+// byte, alpha the high byte; the palette (brightness/contrast/gamma
+// already baked in by the core) lives in a 256x256 lookup texture
+static const char idx16_fragment_shader_source[] =
+"uniform sampler2D color_texture;\n"
+"uniform sampler2D colortable_texture;\n"
+"\n"
+"void main()\n"
+"{\n"
+"   vec4 la = texture2D(color_texture, gl_TexCoord[0].st);\n"
+"   float idx = floor(la.x * 255.0 + 0.5) + floor(la.a * 255.0 + 0.5) * 256.0;\n"
+"   vec2 lutcoord = vec2((mod(idx, 256.0) + 0.5) / 256.0,\n"
+"                        (floor(idx / 256.0) + 0.5) / 256.0);\n"
+"   gl_FragColor = vec4(texture2D(colortable_texture, lutcoord).rgb, 1.0);\n"
+"}\n";
+
 //============================================================
 //  Textures
 //============================================================
@@ -659,8 +774,18 @@ void renderer_ogl::destroy_all_textures()
 
 			if(m_usepbo && texture->pbo)
 			{
+				for (int slot = 0; slot < ogl_texture_info::PBO_RING_SLOTS; slot++)
+				{
+					if (texture->pbo_fence[slot] != nullptr)
+					{
+						pfn_glDeleteSync(texture->pbo_fence[slot]);
+						texture->pbo_fence[slot] = nullptr;
+					}
+				}
+				// deleting the buffer releases any persistent mapping with it
 				pfn_glDeleteBuffers( 1, (GLuint *)&(texture->pbo) );
 				texture->pbo=0;
+				texture->pbo_map=nullptr;
 			}
 
 			if( m_glsl_program_num > 1 )
@@ -678,6 +803,11 @@ void renderer_ogl::destroy_all_textures()
 			}
 
 			glDeleteTextures(1, (GLuint *)&texture->texture);
+			if ( texture->lut_texture )
+			{
+				glDeleteTextures(1, (GLuint *)&texture->lut_texture);
+				texture->lut_texture = 0;
+			}
 			if ( texture->data_own )
 			{
 				free(texture->data);
@@ -690,6 +820,11 @@ void renderer_ogl::destroy_all_textures()
 	}
 	if ( m_useglsl )
 	{
+		if ( m_glsl_program_idx16 )
+		{
+			pfn_glDeleteObjectARB(m_glsl_program_idx16);
+			m_glsl_program_idx16 = 0;
+		}
 		glsl_shader_free(m_glsl);
 		m_glsl = nullptr;
 	}
@@ -746,6 +881,14 @@ void renderer_ogl::loadGLExtensions()
 	{
 		pfn_glMapBuffer  = (PFNGLMAPBUFFERPROC) m_gl_context->getProcAddress("glMapBuffer");
 		pfn_glUnmapBuffer= (PFNGLUNMAPBUFFERPROC) m_gl_context->getProcAddress("glUnmapBuffer");
+
+		// GL 4.4 / ARB_buffer_storage entry points for persistent-mapped rings;
+		// these may legitimately come back null on older drivers
+		pfn_glBufferStorage  = (OSD_PFNGLBUFFERSTORAGEPROC) m_gl_context->getProcAddress("glBufferStorage");
+		pfn_glMapBufferRange = (OSD_PFNGLMAPBUFFERRANGEPROC) m_gl_context->getProcAddress("glMapBufferRange");
+		pfn_glFenceSync      = (OSD_PFNGLFENCESYNCPROC) m_gl_context->getProcAddress("glFenceSync");
+		pfn_glClientWaitSync = (OSD_PFNGLCLIENTWAITSYNCPROC) m_gl_context->getProcAddress("glClientWaitSync");
+		pfn_glDeleteSync     = (OSD_PFNGLDELETESYNCPROC) m_gl_context->getProcAddress("glDeleteSync");
 	}
 	// FBO:
 	if ( m_usefbo )
@@ -817,6 +960,10 @@ void renderer_ogl::loadGLExtensions()
 		}
 	}
 
+	// persistent-mapped rings need both ARB_buffer_storage and ARB_sync
+	m_usepersistentpbo = m_usepbo && pfn_glBufferStorage && pfn_glMapBufferRange &&
+			pfn_glFenceSync && pfn_glClientWaitSync && pfn_glDeleteSync;
+
 	if ( m_usefbo &&
 		( !pfn_glIsFramebuffer || !pfn_glBindFramebuffer || !pfn_glDeleteFramebuffers ||
 			!pfn_glGenFramebuffers || !pfn_glCheckFramebufferStatus || !pfn_glFramebufferTexture2D
@@ -874,6 +1021,15 @@ void renderer_ogl::loadGLExtensions()
 			osd_printf_warning("OpenGL: PBO not supported\n");
 		}
 
+		if ( m_usepersistentpbo )
+		{
+			osd_printf_verbose("OpenGL: persistent-mapped PBO ring supported\n");
+		}
+		else
+		{
+			osd_printf_verbose("OpenGL: persistent-mapped PBO ring not supported\n");
+		}
+
 		if ( m_usefbo )
 		{
 			osd_printf_verbose("OpenGL: FBO supported\n");
@@ -999,6 +1155,22 @@ void renderer_ogl::loadGLExtensions()
 			}
 		}
 
+		// build the palette lookup program used for idx16 textures
+		if ( m_glsl_program_idx16 == 0 )
+		{
+			GLhandleARB vertex_shader = 0;
+			GLhandleARB fragment_shader = 0;
+			if ( gl_compile_shader_sources(&m_glsl_program_idx16, &vertex_shader, &fragment_shader,
+					idx16_vertex_shader_source, idx16_fragment_shader_source) )
+			{
+				m_glsl_program_idx16 = 0;
+				if (_once)
+				{
+					osd_printf_warning("OpenGL: GLSL palette lookup shader failed - paletted textures converted on the CPU\n");
+				}
+			}
+		}
+
 	} else {
 		if (_once)
 		{
@@ -1179,35 +1351,20 @@ int renderer_ogl::draw(const int update)
 					curPrimitive=GL_LINES;
 				}
 
-				if(pendingPrimitive!=GL_NO_PRIMITIVE && pendingPrimitive!=curPrimitive)
-				{
-					glEnd();
-					pendingPrimitive=GL_NO_PRIMITIVE;
-				}
-
-						if ( pendingPrimitive==GL_NO_PRIMITIVE )
+				// flush the pending batch on a primitive kind or blend mode change
+				if (m_vecPrimitive != GL_NO_PRIMITIVE
+					&& (m_vecPrimitive != curPrimitive || PRIMFLAG_GET_BLENDMODE(prim.flags) != m_last_blendmode))
 				{
-							set_blendmode(PRIMFLAG_GET_BLENDMODE(prim.flags));
+					vector_batch_flush();
 				}
 
-				glColor4f(prim.color.r, prim.color.g, prim.color.b, prim.color.a);
-
-				if(pendingPrimitive!=curPrimitive)
+				if (m_vecPrimitive == GL_NO_PRIMITIVE)
 				{
-					glBegin(curPrimitive);
-					pendingPrimitive=curPrimitive;
+					set_blendmode(PRIMFLAG_GET_BLENDMODE(prim.flags));
+					m_vecPrimitive = curPrimitive;
 				}
 
-				// check if it's really a point
-				if (curPrimitive==GL_POINTS)
-				{
-					glVertex2f(prim.bounds.x0+hofs, prim.bounds.y0+vofs);
-				}
-				else
-				{
-					glVertex2f(prim.bounds.x0+hofs, prim.bounds.y0+vofs);
-					glVertex2f(prim.bounds.x1+hofs, prim.bounds.y1+vofs);
-				}
+				vector_batch_add(prim, hofs, vofs);
 				#else
 				{
 					const line_aa_step *step = line_aa_4step;
@@ -1299,6 +1456,8 @@ int renderer_ogl::draw(const int update)
 
 			case render_primitive::QUAD:
 
+				vector_batch_flush();
+
 				if(pendingPrimitive!=GL_NO_PRIMITIVE)
 				{
 					glEnd();
@@ -1369,6 +1528,8 @@ int renderer_ogl::draw(const int update)
 		}
 	}
 
+	vector_batch_flush();
+
 	if(pendingPrimitive!=GL_NO_PRIMITIVE)
 	{
 		glEnd();
@@ -1699,6 +1860,71 @@ int renderer_ogl::texture_shader_create(const render_texinfo *texsource, ogl_tex
 
 	GL_CHECK_ERROR_QUIET();
 
+	if ( texture->idx16 )
+	{
+		// single pass through the dedicated lookup program: indices on
+		// texture unit 0, the palette lookup texture on unit 1
+		pfn_glUseProgramObjectARB(m_glsl_program_idx16);
+
+		uniform_location = pfn_glGetUniformLocationARB(m_glsl_program_idx16, "color_texture");
+		pfn_glUniform1iARB(uniform_location, 0);
+		uniform_location = pfn_glGetUniformLocationARB(m_glsl_program_idx16, "colortable_texture");
+		pfn_glUniform1iARB(uniform_location, 1);
+		GL_CHECK_ERROR_NORMAL();
+
+		// scratch buffer large enough for either texture's initial contents
+		size_t dummy_size = IDX16_LUT_WIDTH * IDX16_LUT_HEIGHT * sizeof(uint32_t);
+		if ( dummy_size < texture->rawwidth_create * texture->rawheight_create * sizeof(uint16_t) )
+			dummy_size = texture->rawwidth_create * texture->rawheight_create * sizeof(uint16_t);
+		uint32_t *dummy = (uint32_t *) malloc(dummy_size);
+		memset(dummy, 0, dummy_size);
+
+		// GL_TEXTURE1: palette lookup texture
+		glGenTextures(1, (GLuint *)&texture->lut_texture);
+		pfn_glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, texture->lut_texture);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, IDX16_LUT_WIDTH);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, IDX16_LUT_WIDTH, IDX16_LUT_HEIGHT,
+				0,
+				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, dummy);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+		// GL_TEXTURE0: index texture; must be sampled unfiltered
+		glGenTextures(1, (GLuint *)&texture->texture);
+		pfn_glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture->texture);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth_create);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8_ALPHA8,
+				texture->rawwidth_create, texture->rawheight_create,
+				0,
+				GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, dummy);
+		glFinish(); // should not be necessary, .. but make sure we won't access the memory after free
+		free(dummy);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		// set wrapping mode appropriately
+		if (texture->flags & PRIMFLAG_TEXWRAP_MASK)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		}
+		else
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+		}
+
+		GL_CHECK_ERROR_NORMAL();
+
+		return 0;
+	}
+
 	if( m_glsl_program_num > 1 )
 	{
 		// multipass mode
@@ -1930,6 +2156,21 @@ ogl_texture_info *renderer_ogl::texture_create(const render_texinfo *texsource,
 	// compute the size
 	texture_compute_size_type(texsource, texture, flags);
 
+	// PALETTE16 textures under the single-pass plain GLSL filter need no
+	// CPU palette conversion: upload the raw indices and resolve them
+	// through a lookup texture in the fragment shader
+	if ( texture->type == TEXTURE_TYPE_SHADER &&
+			texture->format == SDL_TEXFORMAT_PALETTE16 &&
+			glsl_shader_feature == GLSL_SHADER_FEAT_PLAIN &&
+			m_glsl_program_num == 1 &&
+			m_glsl_program_idx16 != 0 &&
+			!texture->borderpix &&
+			texsource->palette_length > 0 )
+	{
+		texture->idx16 = 1;
+		texture->nocopy = 1;
+	}
+
 	texture->pbo=0;
 
 	if ( texture->type != TEXTURE_TYPE_SHADER && m_useglsl)
@@ -2003,10 +2244,37 @@ ogl_texture_info *renderer_ogl::texture_create(const render_texinfo *texsource,
 
 		pfn_glBindBuffer( GL_PIXEL_UNPACK_BUFFER_ARB, texture->pbo);
 
-		// set up the PBO dimension, ..
-		pfn_glBufferData(GL_PIXEL_UNPACK_BUFFER_ARB,
-							texture->rawwidth * texture->rawheight * sizeof(uint32_t),
-					nullptr, GL_STREAM_DRAW);
+		if ( m_usepersistentpbo )
+		{
+			// immutable storage holding a ring of slots, mapped once for the
+			// lifetime of the texture; fences keep the CPU out of slots the
+			// GPU is still reading, so uploads never block behind each other
+			texture->pbo_slot_size = texture->rawwidth * texture->rawheight * sizeof(uint32_t);
+			pfn_glBufferStorage(GL_PIXEL_UNPACK_BUFFER_ARB,
+					GLsizeiptr(texture->pbo_slot_size) * ogl_texture_info::PBO_RING_SLOTS, nullptr,
+					GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+			texture->pbo_map = (uint32_t *) pfn_glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB,
+					0, GLsizeiptr(texture->pbo_slot_size) * ogl_texture_info::PBO_RING_SLOTS,
+					GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+			if ( texture->pbo_map == nullptr )
+			{
+				// storage is immutable once allocated, so recreate the
+				// buffer before falling back to the classic path
+				texture->pbo_slot_size = 0;
+				pfn_glBindBuffer( GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+				pfn_glDeleteBuffers(1, (GLuint *)&texture->pbo);
+				pfn_glGenBuffers(1, (GLuint *)&texture->pbo);
+				pfn_glBindBuffer( GL_PIXEL_UNPACK_BUFFER_ARB, texture->pbo);
+			}
+		}
+
+		if ( texture->pbo_map == nullptr )
+		{
+			// set up the PBO dimension, ..
+			pfn_glBufferData(GL_PIXEL_UNPACK_BUFFER_ARB,
+								texture->rawwidth * texture->rawheight * sizeof(uint32_t),
+						nullptr, GL_STREAM_DRAW);
+		}
 	}
 
 	if ( !texture->nocopy && texture->type!=TEXTURE_TYPE_DYNAMIC )
@@ -2319,12 +2587,73 @@ static inline void copyline_yuy16_to_argb(uint32_t *dst, const uint16_t *src, in
 
 static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, uint32_t flags)
 {
+	// raw-index textures upload the changed index rows straight out of the
+	// render bitmap plus the palette lookup table; no CPU side conversion
+	if (texture->idx16)
+	{
+		int ydirty_min = 0;
+		int ydirty_max = texsource->height - 1;
+		if (texture->uploaded &&
+			texsource->dirty_top >= 0 && texsource->dirty_top <= texsource->dirty_bottom &&
+			texsource->dirty_bottom < texsource->height)
+		{
+			ydirty_min = texsource->dirty_top;
+			ydirty_max = texsource->dirty_bottom;
+		}
+
+		// refresh the palette lookup texture; entries past what a 16 bit
+		// index can address are unreachable and therefore skipped
+		int lut_entries = texsource->palette_length;
+		if (lut_entries > IDX16_LUT_WIDTH * IDX16_LUT_HEIGHT)
+			lut_entries = IDX16_LUT_WIDTH * IDX16_LUT_HEIGHT;
+
+		pfn_glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, texture->lut_texture);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, IDX16_LUT_WIDTH);
+		if (lut_entries >= IDX16_LUT_WIDTH)
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, IDX16_LUT_WIDTH, lut_entries / IDX16_LUT_WIDTH,
+					GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texsource->palette);
+		if (lut_entries % IDX16_LUT_WIDTH)
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, lut_entries / IDX16_LUT_WIDTH, lut_entries % IDX16_LUT_WIDTH, 1,
+					GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
+					(const uint32_t *)texsource->palette + (lut_entries / IDX16_LUT_WIDTH) * IDX16_LUT_WIDTH);
+
+		// upload the indices; a 16 bit pixel may leave odd-width rows
+		// unaligned, so drop the unpack alignment for the transfer
+		pfn_glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture->texture);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, texsource->rowpixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, ydirty_min, texsource->width, ydirty_max - ydirty_min + 1,
+				GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE,
+				(const uint16_t *)texsource->base + ydirty_min * texsource->rowpixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		texture->uploaded = 1;
+		return;
+	}
+
 	if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
 		assert(texture->pbo);
 		assert(!texture->nocopy);
 
-		texture->data = (uint32_t *) pfn_glMapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY);
+		if ( texture->pbo_map != nullptr )
+		{
+			// wait for any DMA still reading this ring slot before writing
+			void *&fence = texture->pbo_fence[texture->pbo_slot];
+			if (fence != nullptr)
+			{
+				pfn_glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, uint64_t(1000000000));
+				pfn_glDeleteSync(fence);
+				fence = nullptr;
+			}
+			texture->data = texture->pbo_map + texture->pbo_slot * (texture->pbo_slot_size / sizeof(uint32_t));
+		}
+		else
+		{
+			texture->data = (uint32_t *) pfn_glMapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY);
+		}
 	}
 
 	// note that nocopy and borderpix are mutually exclusive, IOW
@@ -2342,13 +2671,29 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 				(texsource->width * texture->xprescale + 2) * sizeof(uint32_t));
 	}
 
+	// determine the range of rows to copy and upload; restricting to the
+	// changed rows requires a plain copied texture without a border
+	int ydirty_min = 0;
+	int ydirty_max = texsource->height - 1;
+	if (texture->uploaded && !texture->borderpix && !texture->nocopy &&
+		texsource->dirty_top >= 0 && texsource->dirty_top <= texsource->dirty_bottom &&
+		texsource->dirty_bottom < texsource->height)
+	{
+		ydirty_min = texsource->dirty_top;
+		ydirty_max = texsource->dirty_bottom;
+	}
+	int upload_y = ydirty_min * texture->yprescale;
+	int upload_h = (ydirty_min == 0 && ydirty_max == texsource->height - 1)
+			? texture->rawheight
+			: (ydirty_max - ydirty_min + 1) * texture->yprescale;
+
 	// when necessary copy (and convert) the data
 	if (!texture->nocopy)
 	{
 		int y, y2;
 		uint8_t *dst;
 
-		for (y = 0; y < texsource->height; y++)
+		for (y = ydirty_min; y <= ydirty_max; y++)
 		{
 			for (y2 = 0; y2 < texture->yprescale; y2++)
 			{
@@ -2404,8 +2749,8 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		glTexSubImage2D(texture->texTarget, 0, 0, upload_y, texture->rawwidth, upload_h,
+				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data + upload_y * texture->rawwidth);
 	}
 	else if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
@@ -2413,12 +2758,25 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
-		// unmap the buffer from the CPU space so it can DMA
-		pfn_glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
+		if ( texture->pbo_map != nullptr )
+		{
+			// the mapping is coherent, so the DMA can start immediately;
+			// fence the slot and advance the ring
+			uintptr_t const slotbase = uintptr_t(texture->pbo_slot) * texture->pbo_slot_size;
+			glTexSubImage2D(texture->texTarget, 0, 0, upload_y, texture->rawwidth, upload_h,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, reinterpret_cast<GLvoid *>(slotbase + upload_y * texture->rawwidth * sizeof(uint32_t)));
+			texture->pbo_fence[texture->pbo_slot] = pfn_glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			texture->pbo_slot = (texture->pbo_slot + 1) % ogl_texture_info::PBO_RING_SLOTS;
+		}
+		else
+		{
+			// unmap the buffer from the CPU space so it can DMA
+			pfn_glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
 
-		// kick off the DMA
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-					GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+			// kick off the DMA
+			glTexSubImage2D(texture->texTarget, 0, 0, upload_y, texture->rawwidth, upload_h,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, reinterpret_cast<GLvoid *>(uintptr_t(upload_y * texture->rawwidth * sizeof(uint32_t))));
+		}
 	}
 	else
 	{
@@ -2431,9 +2789,12 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		glTexSubImage2D(texture->texTarget, 0, 0, upload_y, texture->rawwidth, upload_h,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data + upload_y * texture->rawwidth);
 	}
+
+	// from here on partial uploads may omit the unchanged rows
+	texture->uploaded = 1;
 }
 
 //============================================================
@@ -2666,7 +3027,8 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 	{
 		if ( texture->type == TEXTURE_TYPE_SHADER )
 		{
-			pfn_glUseProgramObjectARB(m_glsl_program[shaderIdx]); // back to our shader
+			// back to our shader
+			pfn_glUseProgramObjectARB(texture->idx16 ? m_glsl_program_idx16 : m_glsl_program[shaderIdx]);
 		}
 		else if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 		{
@@ -2684,7 +3046,9 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 	{
 		if ( texture->type == TEXTURE_TYPE_SHADER )
 		{
-			texture_shader_update(texture, prim->container, shaderIdx);
+			// idx16 textures get their adjustments via the palette lookup table
+			if ( !texture->idx16 )
+				texture_shader_update(texture, prim->container, shaderIdx);
 			if ( m_glsl_program_num>1 )
 			{
 				texture_mpass_flip(texture, shaderIdx);
@@ -2703,6 +3067,14 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 			}
 		}
 
+		if ( texture->idx16 )
+		{
+			// (re)bind the palette lookup texture; another idx16 texture
+			// may have claimed unit 1 in the meantime
+			pfn_glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, texture->lut_texture);
+			pfn_glActiveTexture(GL_TEXTURE0);
+		}
 		if (!texBound) {
 			glBindTexture(texture->texTarget, texture->texture);
 		}
@@ -30,6 +30,8 @@ typedef uint64_t HashT;
 
 #include "modules/opengl/gl_shader_mgr.h"
 
+#include <vector>
+
 //============================================================
 //  Textures
 //============================================================
@@ -42,7 +44,8 @@ public:
 	:   hash(0), flags(0), rawwidth(0), rawheight(0),
 		rawwidth_create(0), rawheight_create(0),
 		type(0), format(0), borderpix(0), xprescale(0), yprescale(0), nocopy(0),
-		texture(0), texTarget(0), texpow2(0), mpass_dest_idx(0), pbo(0), data(nullptr),
+		idx16(0), uploaded(0), texture(0), lut_texture(0), texTarget(0), texpow2(0), mpass_dest_idx(0), pbo(0),
+		pbo_slot(0), pbo_slot_size(0), pbo_map(nullptr), data(nullptr),
 		data_own(0), texCoordBufferName(0)
 	{
 		for (int i=0; i<2; i++)
@@ -53,6 +56,8 @@ public:
 			mpass_texture_scrn[i] = 0;
 			mpass_fbo_scrn[i] = 0;
 		}
+		for (int i=0; i<PBO_RING_SLOTS; i++)
+			pbo_fence[i] = nullptr;
 		for (int i=0; i<8; i++)
 			texCoord[i] = 0.0f;
 	}
@@ -69,8 +74,11 @@ public:
 	int                 xprescale;          // what is our X prescale factor?
 	int                 yprescale;          // what is our Y prescale factor?
 	int                 nocopy;             // must the texture date be copied?
+	int                 idx16;              // raw indices uploaded; palette lookup in the fragment shader
+	int                 uploaded;           // has the full texture been uploaded at least once?
 
 	uint32_t              texture;            // OpenGL texture "name"/ID
+	uint32_t              lut_texture;        // palette lookup texture (idx16 only)
 
 	GLenum              texTarget;          // OpenGL texture target
 	int                 texpow2;            // Is this texture pow2
@@ -83,7 +91,13 @@ public:
 	uint32_t              mpass_texture_scrn[2];  // Multipass OpenGL texture "name"/ID for the shader
 	uint32_t              mpass_fbo_scrn[2];      // framebuffer object for this texture, multipass
 
+	static const int    PBO_RING_SLOTS = 3;     // slots in the persistent-mapped upload ring
+
 	uint32_t              pbo;                    // pixel buffer object for this texture (DYNAMIC only!)
+	uint32_t              pbo_slot;               // next slot in the persistent-mapped ring
+	uint32_t              pbo_slot_size;          // bytes per ring slot (0 = classic map/unmap PBO)
+	uint32_t              *pbo_map;               // persistent mapping covering the whole ring
+	void                *pbo_fence[PBO_RING_SLOTS]; // per-slot fences guarding in-flight DMA
 	uint32_t              *data;                  // pixels for the texture
 	int                 data_own;               // do we own / allocated it ?
 	GLfloat             texCoord[8];
@@ -109,17 +123,20 @@ public:
 		, m_texpoweroftwo(0)
 		, m_usevbo(0)
 		, m_usepbo(0)
+		, m_usepersistentpbo(0)
 		, m_usefbo(0)
 		, m_useglsl(0)
 		, m_glsl(nullptr)
 		, m_glsl_program_num(0)
 		, m_glsl_program_mb2sc(0)
+		, m_glsl_program_idx16(0)
 		, m_usetexturerect(0)
 		, m_init_context(0)
 		, m_last_hofs(0.0f)
 		, m_last_vofs(0.0f)
 		, m_surf_w(0)
 		, m_surf_h(0)
+		, m_vecPrimitive(-1)    // GL_NO_PRIMITIVE
 	{
 		for (int i=0; i < HASH_SIZE + OVERFLOW_SIZE; i++)
 			m_texhash[i] = nullptr;
@@ -171,6 +188,8 @@ private:
 	void loadGLExtensions();
 	void initialize_gl();
 	void set_blendmode(int blendmode);
+	void vector_batch_add(const render_primitive &prim, float hofs, float vofs);
+	void vector_batch_flush();
 	HashT texture_compute_hash(const render_texinfo *texture, uint32_t flags);
 	void texture_compute_type_subroutine(const render_texinfo *texsource, ogl_texture_info *texture, uint32_t flags);
 	void texture_compute_size_subroutine(ogl_texture_info *texture, uint32_t flags,
@@ -203,6 +222,7 @@ private:
 	int             m_texpoweroftwo;          // must textures be power-of-2 sized?
 	int             m_usevbo;         // runtime check if VBO is available
 	int             m_usepbo;         // runtime check if PBO is available
+	int             m_usepersistentpbo; // runtime check if persistent-mapped PBO rings are available
 	int             m_usefbo;         // runtime check if FBO is available
 	int             m_useglsl;        // runtime check if GLSL is available
 
@@ -216,6 +236,7 @@ private:
 										// as input, otherwise the screen bitmap.
 										// All progs >= glsl_program_mb2sc using the screen bitmap
 										// as output, otherwise the mame bitmap.
+	GLhandleARB     m_glsl_program_idx16; // palette lookup program for idx16 textures, or 0
 	int             m_usetexturerect;     // use ARB_texture_rectangle for non-power-of-2, general use
 
 	int             m_init_context;       // initialize context before next draw
@@ -228,6 +249,11 @@ private:
 	int32_t           m_surf_h;
 	GLfloat         m_texVerticex[8];
 
+	// batched vector beam segments, drawn with a single call per run
+	std::vector<GLfloat> m_vecVertex;     // 2 floats per vertex
+	std::vector<GLfloat> m_vecColor;      // 4 floats per vertex
+	int             m_vecPrimitive;       // GL_LINES or GL_POINTS of the pending batch
+
 	static bool     s_shown_video_info;
 	static bool     s_dll_loaded;
 };
@@ -0,0 +1,140 @@
+// license:BSD-3-Clause
+// copyright-holders:intealls, R. Belmont
+/*
+ * audio_buffer.h
+ *
+ * Wait-free single-producer/single-consumer sample ring shared by the
+ * OSD sound modules.  One thread writes (the emulation thread, via
+ * update_audio_stream), one thread reads (the backend's audio callback).
+ * The read side only advances playpos and the write side only advances
+ * writepos, so neither side ever locks or spins on the other; samples
+ * that do not fit are dropped and accounted rather than waited for.
+ *
+ */
+
+#ifndef AUDIO_BUFFER_H_
+#define AUDIO_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Lock free SPSC ring buffer
+template <typename T>
+struct audio_buffer {
+	T*                    buf;
+	int                   size;
+	int                   reserve;
+	std::atomic<int>      playpos, writepos;
+
+	// sample-accurate running cursors; total_written - total_read is the
+	// amount of queued audio over the whole session
+	std::atomic<uint64_t> total_read, total_written;
+
+	// drop accounting: events and the exact number of samples lost
+	std::atomic<unsigned> underruns, overruns;
+	std::atomic<uint64_t> underrun_samples, overrun_samples;
+
+	audio_buffer(int size, int reserve) : size(size + reserve), reserve(reserve) {
+		playpos = writepos = 0;
+		total_read = total_written = 0;
+		underruns = overruns = 0;
+		underrun_samples = overrun_samples = 0;
+		buf = new T[this->size];
+	}
+
+	~audio_buffer() { delete[] buf; }
+
+	int count() const {
+		int diff = writepos.load(std::memory_order_acquire) - playpos.load(std::memory_order_acquire);
+		return diff < 0 ? size + diff : diff;
+	}
+
+	void increment_writepos(int n) {
+		total_written.fetch_add(n, std::memory_order_relaxed);
+		// release so the consumer sees the sample data before the new cursor
+		writepos.store((writepos.load(std::memory_order_relaxed) + n) % size, std::memory_order_release);
+	}
+
+	int write(const T* src, int n, int attenuation) {
+		int space = size - reserve - count();
+		if (n > space) {
+			overruns.fetch_add(1, std::memory_order_relaxed);
+			overrun_samples.fetch_add(n - space, std::memory_order_relaxed);
+			n = space;
+		}
+		int wp = writepos.load(std::memory_order_relaxed);
+
+		if (wp + n > size) {
+			att_memcpy(buf + wp, src, sizeof(T) * (size - wp), attenuation);
+			att_memcpy(buf, src + (size - wp), sizeof(T) * (n - (size - wp)), attenuation);
+		} else {
+			att_memcpy(buf + wp, src, sizeof(T) * n, attenuation);
+		}
+
+		increment_writepos(n);
+
+		return n;
+	}
+
+	void increment_playpos(int n) {
+		total_read.fetch_add(n, std::memory_order_relaxed);
+		// release so the producer sees the space only after we are done with it
+		playpos.store((playpos.load(std::memory_order_relaxed) + n) % size, std::memory_order_release);
+	}
+
+	int read(T* dst, int n) {
+		n = std::min<int>(n, count());
+		int pp = playpos.load(std::memory_order_relaxed);
+
+		if (pp + n > size) {
+			std::memcpy(dst, buf + pp, sizeof(T) * (size - pp));
+			std::memcpy(dst + (size - pp), buf, sizeof(T) * (n - (size - pp)));
+		} else {
+			std::memcpy(dst, buf + pp, sizeof(T) * n);
+		}
+
+		increment_playpos(n);
+
+		return n;
+	}
+
+	// read n samples, zero-filling and accounting any shortfall; this is
+	// what the audio callbacks should use so underruns are never silent
+	int read_padded(T* dst, int n) {
+		int got = read(dst, n);
+		if (got < n) {
+			std::memset(dst + got, 0, sizeof(T) * (n - got));
+			underruns.fetch_add(1, std::memory_order_relaxed);
+			underrun_samples.fetch_add(n - got, std::memory_order_relaxed);
+		}
+		return got;
+	}
+
+	int clear(int n) {
+		n = std::min<int>(n, size - reserve - count());
+		int wp = writepos.load(std::memory_order_relaxed);
+
+		if (wp + n > size) {
+			std::memset(buf + wp, 0, sizeof(T) * (size - wp));
+			std::memset(buf, 0, sizeof(T) * (n - (size - wp)));
+		} else {
+			std::memset(buf + wp, 0, sizeof(T) * n);
+		}
+
+		increment_writepos(n);
+
+		return n;
+	}
+
+	void att_memcpy(T* dest, const T* data, int n, int attenuation) {
+		int level = powf(10.0, attenuation / 20.0) * 32768;
+		n /= sizeof(T);
+		while (n--)
+			*dest++ = (*data++ * level) >> 15;
+	}
+};
+
+#endif /* AUDIO_BUFFER_H_ */
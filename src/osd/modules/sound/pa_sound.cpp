@@ -9,6 +9,7 @@
 *******************************************************************c********/
 
 #include "sound_module.h"
+#include "audio_buffer.h"
 #include "modules/osdmodule.h"
 
 #ifndef NO_USE_PORTAUDIO
@@ -52,87 +53,6 @@ public:
   }
 
 private:
-	// Lock free SPSC ring buffer
-	template <typename T>
-	struct audio_buffer {
-		T*               buf;
-		int              size;
-		int              reserve;
-		std::atomic<int> playpos, writepos;
-
-		audio_buffer(int size, int reserve) : size(size + reserve), reserve(reserve) {
-			playpos = writepos = 0;
-			buf = new T[this->size];
-		}
-
-		~audio_buffer() { delete[] buf; }
-
-		int count() {
-			int diff = writepos - playpos;
-			return diff < 0 ? size + diff : diff;
-		}
-
-		void increment_writepos(int n) {
-			writepos.store((writepos + n) % size);
-		}
-
-		int write(const T* src, int n, int attenuation) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				att_memcpy(buf + writepos, src, sizeof(T) * (size - writepos), attenuation);
-				att_memcpy(buf, src + (size - writepos), sizeof(T) * (n - (size - writepos)), attenuation);
-			} else {
-				att_memcpy(buf + writepos, src, sizeof(T) * n, attenuation);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void increment_playpos(int n) {
-			playpos.store((playpos + n) % size);
-		}
-
-		int read(T* dst, int n) {
-			n = std::min<int>(n, count());
-
-			if (playpos + n > size) {
-				std::memcpy(dst, buf + playpos, sizeof(T) * (size - playpos));
-				std::memcpy(dst + (size - playpos), buf, sizeof(T) * (n - (size - playpos)));
-			} else {
-				std::memcpy(dst, buf + playpos, sizeof(T) * n);
-			}
-
-			increment_playpos(n);
-
-			return n;
-		}
-
-		int clear(int n) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				std::memset(buf + writepos, 0, sizeof(T) * (size - writepos));
-				std::memset(buf, 0, sizeof(T) * (n - (size - writepos)));
-			} else {
-				std::memset(buf + writepos, 0, sizeof(T) * n);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void att_memcpy(T* dest, const T* data, int n, int attenuation) {
-			int level = powf(10.0, attenuation / 20.0) * 32768;
-			n /= sizeof(T);
-			while (n--)
-				*dest++ = (*data++ * level) >> 15;
-		}
-	};
-
 	enum
 	{
 		LATENCY_MIN = 1,
@@ -360,8 +280,7 @@ int sound_pa::callback(s16* output_buffer, size_t number_of_samples)
 	}
 	else
 	{
-		m_ab->read(output_buffer, buf_ct);
-		std::memset(output_buffer + buf_ct, 0, (number_of_samples - buf_ct) * sizeof(s16));
+		m_ab->read_padded(output_buffer, number_of_samples);
 
 		// if update_audio_stream has been called, note the underflow
 		if (m_osd_ticks)
@@ -434,10 +353,13 @@ void sound_pa::exit()
 
 	Pa_Terminate();
 
-	delete m_ab;
-
 	if (m_overflows || m_underflows)
 		osd_printf_verbose("Sound: overflows=%d underflows=%d\n", m_overflows, m_underflows);
+	if (m_ab->underrun_samples || m_ab->overrun_samples)
+		osd_printf_verbose("Sound: dropped samples: underrun=%llu overrun=%llu\n",
+			(unsigned long long)m_ab->underrun_samples, (unsigned long long)m_ab->overrun_samples);
+
+	delete m_ab;
 }
 
 #else
@@ -233,6 +233,61 @@ public:
 };
 
 
+/***************************************************************************
+    ASYNCHRONOUS FILE I/O INTERFACES
+***************************************************************************/
+
+/* completion callback for asynchronous file operations; invoked on an I/O
+   worker thread once the transfer finishes */
+typedef void (*osd_file_async_callback)(void *param, osd_file::error filerr, std::uint32_t actual);
+
+
+/*-----------------------------------------------------------------------------
+    osd_file_read_async: queue a read on the shared I/O submission queue
+
+    Parameters:
+
+        file - the file to read from; must stay open until the completion
+            callback has run
+
+        buffer - pointer to memory that will receive the data read; must
+            stay valid until the completion callback has run
+
+        offset - offset within the file to read from
+
+        length - number of bytes to read from the file
+
+        callback - invoked on an I/O worker thread with the result of the
+            operation
+
+        param - opaque value passed through to the callback
+
+    Notes:
+
+        All asynchronous operations share one I/O work queue, so submissions
+        from different subsystems overlap without each spawning threads.
+        Operations on a single file are offset-addressed and stateless, so
+        multiple transfers may be in flight against the same file.
+-----------------------------------------------------------------------------*/
+void osd_file_read_async(osd_file &file, void *buffer, std::uint64_t offset, std::uint32_t length, osd_file_async_callback callback, void *param);
+
+
+/*-----------------------------------------------------------------------------
+    osd_file_write_async: queue a write on the shared I/O submission queue
+
+    Parameters:
+
+        as osd_file_read_async, with buffer holding the data to write
+-----------------------------------------------------------------------------*/
+void osd_file_write_async(osd_file &file, const void *buffer, std::uint64_t offset, std::uint32_t length, osd_file_async_callback callback, void *param);
+
+
+/*-----------------------------------------------------------------------------
+    osd_file_async_wait: block until all queued asynchronous file
+    operations have completed and their callbacks have run
+-----------------------------------------------------------------------------*/
+void osd_file_async_wait();
+
 
 /*-----------------------------------------------------------------------------
     osd_getenv: return pointer to environment variable
@@ -490,7 +545,7 @@ void osd_sleep(osd_ticks_t duration);
 
 /* this is the maximum number of supported threads for a single work queue */
 /* threadid values are expected to range from 0..WORK_MAX_THREADS-1 */
-#define WORK_MAX_THREADS            16
+#define WORK_MAX_THREADS            64
 
 /* these flags can be set when creating a queue to give hints to the code about
    how to configure the queue */
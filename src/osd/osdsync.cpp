@@ -31,6 +31,10 @@
 #include <pthread.h>
 #endif
 
+#if defined(SDLMAME_LINUX)
+#include <sched.h>
+#endif
+
 //============================================================
 //  DEBUGGING
 //============================================================
@@ -244,6 +248,136 @@ int thread_adjust_priority(std::thread *thread, int adjust)
 	return true;
 }
 
+//============================================================
+//  THREAD AFFINITY REGISTRY
+//============================================================
+
+static std::mutex affinity_lock;
+static std::vector<std::thread *> affinity_registry;
+static uint64_t affinity_mask = 0;
+
+//============================================================
+//  affinity_apply_mask
+//============================================================
+
+static void affinity_apply_mask(std::thread::native_handle_type handle, uint64_t mask)
+{
+	if (mask == 0)
+		return;
+#if defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)
+	SetThreadAffinityMask((HANDLE)handle, (DWORD_PTR)mask);
+#elif defined(SDLMAME_LINUX)
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	for (int cpu = 0; cpu < 64; cpu++)
+		if (mask & ((uint64_t)1 << cpu))
+			CPU_SET(cpu, &cpuset);
+	pthread_setaffinity_np(handle, sizeof(cpuset), &cpuset);
+#endif
+}
+
+//============================================================
+//  osd_thread_register
+//============================================================
+
+void osd_thread_register(std::thread *handle)
+{
+	std::lock_guard<std::mutex> lock(affinity_lock);
+	affinity_registry.push_back(handle);
+	affinity_apply_mask(handle->native_handle(), affinity_mask);
+}
+
+//============================================================
+//  osd_thread_unregister
+//============================================================
+
+void osd_thread_unregister(std::thread *handle)
+{
+	std::lock_guard<std::mutex> lock(affinity_lock);
+	affinity_registry.erase(std::remove(affinity_registry.begin(), affinity_registry.end(), handle), affinity_registry.end());
+}
+
+//============================================================
+//  osd_thread_affinity_set_mask
+//============================================================
+
+void osd_thread_affinity_set_mask(uint64_t mask)
+{
+	std::lock_guard<std::mutex> lock(affinity_lock);
+	affinity_mask = mask;
+
+	// re-pin every registered thread
+	for (std::thread *handle : affinity_registry)
+		affinity_apply_mask(handle->native_handle(), mask);
+
+	// and the calling thread, so the emulation thread follows the policy too
+#if defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)
+	if (mask != 0)
+		SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)mask);
+#elif defined(SDLMAME_LINUX)
+	affinity_apply_mask(pthread_self(), mask);
+#endif
+}
+
+//============================================================
+//  osd_thread_affinity_get_mask
+//============================================================
+
+uint64_t osd_thread_affinity_get_mask()
+{
+	std::lock_guard<std::mutex> lock(affinity_lock);
+	return affinity_mask;
+}
+
+//============================================================
+//  osd_thread_affinity_compact_mask
+//============================================================
+
+uint64_t osd_thread_affinity_compact_mask()
+{
+#if defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)
+	PROCESSOR_NUMBER procnum;
+	USHORT node;
+	GROUP_AFFINITY nodemask;
+	GetCurrentProcessorNumberEx(&procnum);
+	if (!GetNumaProcessorNodeEx(&procnum, &node) || !GetNumaNodeProcessorMaskEx(node, &nodemask))
+		return 0;
+	return (uint64_t)nodemask.Mask;
+#elif defined(SDLMAME_LINUX)
+	// the package the current CPU belongs to, via sysfs topology; this keeps
+	// an instance's threads on one socket without requiring libnuma
+	int const curcpu = sched_getcpu();
+	if (curcpu < 0)
+		return 0;
+
+	auto read_package_id = [] (int cpu) -> int
+	{
+		char path[128];
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+		FILE *f = fopen(path, "r");
+		if (f == nullptr)
+			return -1;
+		int package = -1;
+		if (fscanf(f, "%d", &package) != 1)
+			package = -1;
+		fclose(f);
+		return package;
+	};
+
+	int const package = read_package_id(curcpu);
+	if (package < 0)
+		return 0;
+
+	uint64_t mask = 0;
+	for (int cpu = 0; cpu < 64; cpu++)
+		if (read_package_id(cpu) == package)
+			mask |= (uint64_t)1 << cpu;
+	return mask;
+#else
+	return 0;
+#endif
+}
+
 //============================================================
 //  osd_work_queue_alloc
 //============================================================
@@ -306,6 +440,9 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 		if (thread->handle == nullptr)
 			goto error;
 
+		// register it so the affinity policy applies to it
+		osd_thread_register(thread->handle);
+
 		// set its priority: I/O threads get high priority because they are assumed to be
 		// blocked most of the time; other threads just match the creator's priority
 		if (flags & WORK_QUEUE_FLAG_IO)
@@ -416,6 +553,7 @@ void osd_work_queue_free(osd_work_queue *queue)
 		// block on the thread going away, then close the handle
 		if (thread->handle != nullptr)
 		{
+			osd_thread_unregister(thread->handle);
 			thread->handle->join();
 			delete thread->handle;
 		}
@@ -484,44 +622,49 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	osd_work_item **item_tailptr = &itemlist;
 	int itemnum;
 
-	// loop over items, building up a local list of work
-	for (itemnum = 0; itemnum < numitems; itemnum++)
+	// grab as many recycled items as we can with a single lock acquisition
+	// instead of re-taking the lock once per item
+	int freecount = 0;
 	{
-		osd_work_item *item;
-
-		// first allocate a new work item; try the free list first
+		std::lock_guard<std::mutex> lock(queue->lock);
+		while (freecount < numitems)
 		{
-			std::lock_guard<std::mutex> lock(queue->lock);
+			osd_work_item *item;
 			do
 			{
 				item = (osd_work_item *)queue->free;
 			} while (item != nullptr && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
-		}
-
-		// if nothing, allocate something new
-		if (item == nullptr)
-		{
-			// allocate the item
-			item = new osd_work_item(*queue);
 			if (item == nullptr)
-				return nullptr;
-		}
-		else
-		{
+				break;
+
 			item->done = false; // needs to be set this way to prevent data race/usage of uninitialized memory on Linux
+			lastitem = item;
+			*item_tailptr = item;
+			item_tailptr = &item->next;
+			freecount++;
 		}
+	}
 
-		// fill in the basics
-		item->next = nullptr;
-		item->callback = callback;
-		item->param = parambase;
-		item->result = nullptr;
-		item->flags = flags;
+	// allocate anything else fresh, outside the lock
+	for (itemnum = freecount; itemnum < numitems; itemnum++)
+	{
+		osd_work_item *item = new osd_work_item(*queue);
+		if (item == nullptr)
+			return nullptr;
 
-		// advance to the next
 		lastitem = item;
 		*item_tailptr = item;
 		item_tailptr = &item->next;
+	}
+
+	// terminate the list and fill in the basics
+	*item_tailptr = nullptr;
+	for (osd_work_item *item = itemlist; item != nullptr; item = item->next)
+	{
+		item->callback = callback;
+		item->param = parambase;
+		item->result = nullptr;
+		item->flags = flags;
 		parambase = (uint8_t *)parambase + paramstep;
 	}
 
@@ -644,7 +787,10 @@ void osd_work_item_release(osd_work_item *item)
 static int effective_num_processors(void)
 {
   // JJG: To keep mamehub completely deterministic, force the # of processors to 1.
-  return 1;
+  // An explicit osd_num_processors request (chdman -np, OSDPROCESSORS) overrides
+  // the clamp; the emulator leaves it at 0 ('auto') unless the user asks.
+  if (osd_num_processors <= 0)
+    return 1;
 
 	int physprocs = osd_get_num_processors();
 
@@ -747,8 +893,14 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 
 		bool end_loop = false;
 
-		// use a critical section to synchronize the removal of items
+		// don't bother acquiring the lock if the list is visibly empty
+		if (queue->list.load() == nullptr)
+		{
+			end_loop = true;
+		}
+		else
 		{
+			// use a critical section to synchronize the removal of items
 			std::lock_guard<std::mutex> lock(queue->lock);
 
 			if (queue->list.load() == nullptr)
@@ -818,7 +970,100 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 
 bool queue_has_list_items(osd_work_queue *queue)
 {
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	// the list head is atomic and the answer is stale the moment the lock
+	// would be released anyway; callers re-check under the lock before
+	// actually popping, so a plain load is sufficient here
+	return (queue->list.load() != nullptr);
+}
+
+//============================================================
+//  ASYNCHRONOUS FILE I/O
+//============================================================
+
+struct async_file_request
+{
+	osd_file *              file;           // target file
+	void *                  buffer;         // source/destination buffer
+	uint64_t                offset;         // file offset
+	uint32_t                length;         // transfer length
+	bool                    write;          // true for a write, false for a read
+	osd_file_async_callback callback;       // completion callback
+	void *                  param;          // opaque callback parameter
+};
+
+//============================================================
+//  async_file_execute
+//============================================================
+
+static void *async_file_execute(void *param, int threadid)
+{
+	async_file_request *request = (async_file_request *)param;
+
+	uint32_t actual = 0;
+	osd_file::error filerr;
+	if (request->write)
+		filerr = request->file->write(request->buffer, request->offset, request->length, actual);
+	else
+		filerr = request->file->read(request->buffer, request->offset, request->length, actual);
+
+	request->callback(request->param, filerr, actual);
+	delete request;
+	return nullptr;
+}
+
+//============================================================
+//  async_file_queue
+//============================================================
+
+static osd_work_queue *async_file_queue()
+{
+	// one shared I/O submission queue for the whole process, created on
+	// first use and living until exit
+	static osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	return queue;
+}
+
+//============================================================
+//  async_file_submit
+//============================================================
+
+static void async_file_submit(osd_file &file, void *buffer, uint64_t offset, uint32_t length, bool write, osd_file_async_callback callback, void *param)
+{
+	async_file_request *request = new async_file_request;
+	request->file = &file;
+	request->buffer = buffer;
+	request->offset = offset;
+	request->length = length;
+	request->write = write;
+	request->callback = callback;
+	request->param = param;
+
+	osd_work_item_queue(async_file_queue(), async_file_execute, request, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+//============================================================
+//  osd_file_read_async
+//============================================================
+
+void osd_file_read_async(osd_file &file, void *buffer, uint64_t offset, uint32_t length, osd_file_async_callback callback, void *param)
+{
+	async_file_submit(file, buffer, offset, length, false, callback, param);
+}
+
+//============================================================
+//  osd_file_write_async
+//============================================================
+
+void osd_file_write_async(osd_file &file, const void *buffer, uint64_t offset, uint32_t length, osd_file_async_callback callback, void *param)
+{
+	async_file_submit(file, const_cast<void *>(buffer), offset, length, true, callback, param);
+}
+
+//============================================================
+//  osd_file_async_wait
+//============================================================
+
+void osd_file_async_wait()
+{
+	osd_work_queue_wait(async_file_queue(), osd_ticks_per_second() * (osd_ticks_t)10000);
 }
@@ -14,6 +14,7 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <thread>
 
 #include "osdcomm.h"
 
@@ -164,4 +165,53 @@ private:
 
 };
 
+/***************************************************************************
+    SYNCHRONIZATION INTERFACES - Thread affinity
+***************************************************************************/
+
+/*-----------------------------------------------------------------------------
+    osd_thread_register: add a thread to the affinity registry
+
+    Parameters:
+
+        handle - the thread to register; the current affinity mask (if any)
+                 is applied immediately, and the thread is re-pinned if the
+                 mask changes later. The caller must unregister the thread
+                 before destroying it.
+-----------------------------------------------------------------------------*/
+void osd_thread_register(std::thread *handle);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_unregister: remove a thread from the affinity registry
+-----------------------------------------------------------------------------*/
+void osd_thread_unregister(std::thread *handle);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_affinity_set_mask: set the host CPU affinity mask
+
+    Parameters:
+
+        mask - bitmask of host CPUs (bit n = CPU n) that registered threads
+               and the calling thread are allowed to run on; 0 removes any
+               pinning for threads registered afterwards.
+
+    Notes:
+
+        Applied to all currently registered threads and to the calling
+        thread. On hosts without affinity support this is a no-op.
+-----------------------------------------------------------------------------*/
+void osd_thread_affinity_set_mask(uint64_t mask);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_affinity_get_mask: return the current affinity mask (0 = none)
+-----------------------------------------------------------------------------*/
+uint64_t osd_thread_affinity_get_mask();
+
+/*-----------------------------------------------------------------------------
+    osd_thread_affinity_compact_mask: compute a mask covering the NUMA
+    node/package the calling thread is currently running on, or 0 if the
+    topology cannot be determined on this host.
+-----------------------------------------------------------------------------*/
+uint64_t osd_thread_affinity_compact_mask();
+
 #endif // MAME_OSD_OSDSYNC_H
@@ -295,7 +295,8 @@ void sdl_window_info::toggle_full_screen()
 
 	// reset UI to main menu
 	machine().ui().menu_reset();
-	// kill off the drawers
+	// kill off the drawers, making sure the worker is done with them first
+	wait_render_queue();
 	renderer_reset();
 	bool is_osx = false;
 #ifdef SDLMAME_MACOSX
@@ -444,6 +445,9 @@ error:
 
 void sdl_window_info::complete_destroy()
 {
+	// let the render worker finish any in-flight frame first
+	wait_render_queue();
+
 	// Release pointer grab and hide if needed
 	show_pointer();
 	release_pointer();
@@ -470,6 +474,13 @@ void sdl_window_info::destroy()
 	// free the textures etc
 	complete_destroy();
 
+	// shut down the render worker
+	if (m_render_queue != nullptr)
+	{
+		osd_work_queue_free(m_render_queue);
+		m_render_queue = nullptr;
+	}
+
 	// free the render target, after the textures!
 	machine().render().target_free(m_target);
 
@@ -620,6 +631,14 @@ void sdl_window_info::update()
 			if (m_primlist == nullptr)
 			{
 			}
+			// with pipelined rendering, hand the frame to the worker and
+			// return; it signals m_rendered_event once presented, so the
+			// wait above keeps us at most one frame ahead
+			else if (m_render_queue != nullptr)
+			{
+				osd_work_item_queue(m_render_queue, &sdl_window_info::draw_worker, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+				return;
+			}
 			// otherwise, render with our drawing system
 			else
 			{
@@ -825,8 +844,21 @@ int sdl_window_info::complete_create()
 	if (fullscreen() && video_config.switchres)
 		monitor()->update_resolution(temp.width(), temp.height());
 
-	// initialize the drawing backend
-	if (renderer().create())
+	// initialize the drawing backend; with pipelined rendering both the
+	// creation and every draw run on the worker thread so any GL context
+	// ends up owned by that thread
+	if (video_config.pipeline && m_render_queue == nullptr)
+		m_render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_render_queue != nullptr)
+	{
+		osd_work_item *item = osd_work_item_queue(m_render_queue, &sdl_window_info::create_worker, this, 0);
+		osd_work_item_wait(item, osd_ticks_per_second());
+		bool failed = (osd_work_item_result(item) != nullptr);
+		osd_work_item_release(item);
+		if (failed)
+			return 1;
+	}
+	else if (renderer().create())
 		return 1;
 
 	// Make sure we have a consistent state
@@ -884,6 +916,39 @@ void sdl_window_info::measure_fps(int update)
 	}
 }
 
+
+//============================================================
+//  pipelined rendering helpers
+//  (render worker thread)
+//============================================================
+
+void *sdl_window_info::create_worker(void *param, int threadid)
+{
+	auto *window = static_cast<sdl_window_info *>(param);
+	// a non-null result signals failure back to complete_create
+	return reinterpret_cast<void *>(uintptr_t(window->renderer().create()));
+}
+
+void *sdl_window_info::draw_worker(void *param, int threadid)
+{
+	auto *window = static_cast<sdl_window_info *>(param);
+	if (video_config.perftest)
+		window->measure_fps(1);
+	else
+		window->renderer().draw(1);
+
+	/* all done, ready for next */
+	window->m_rendered_event.set();
+	return nullptr;
+}
+
+void sdl_window_info::wait_render_queue()
+{
+	if (m_render_queue != nullptr)
+		osd_work_queue_wait(m_render_queue, osd_ticks_per_second());
+}
+
+
 int sdl_window_info::wnd_extra_width()
 {
 	return m_fullscreen ? 0 : WINDOW_DECORATION_WIDTH;
@@ -1137,6 +1202,7 @@ sdl_window_info::sdl_window_info(
 	, m_windowed_dim(0, 0)
 	, m_rendered_event(0, 1)
 	, m_target(nullptr)
+	, m_render_queue(nullptr)
 	, m_extra_flags(0)
 	, m_machine(a_machine)
 	, m_monitor(a_monitor)
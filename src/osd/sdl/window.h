@@ -85,6 +85,7 @@ private:
 	// rendering info
 	osd_event           m_rendered_event;
 	render_target *     m_target;
+	osd_work_queue *    m_render_queue;     // worker queue when pipelined rendering is enabled
 
 	// Original display_mode
 	SDL_DM_Wrapper      *m_original_mode;
@@ -106,6 +107,11 @@ private:
 	osd_dim pick_best_mode();
 	void set_fullscreen(int afullscreen) { m_fullscreen = afullscreen; }
 
+	// pipelined rendering helpers
+	static void *create_worker(void *param, int threadid);
+	static void *draw_worker(void *param, int threadid);
+	void wait_render_queue();
+
 	// Pointer to machine
 	running_machine &   m_machine;
 
@@ -104,6 +104,7 @@ const int MODE_GDI = 2;
 #define OPTION_VERBOSE "verbose"
 #define OPTION_FIX "fix"
 #define OPTION_NUMPROCESSORS "numprocessors"
+#define OPTION_READAHEAD "readahead"
 #define OPTION_SIZE "size"
 #define OPTION_TEMPLATE "template"
 
@@ -154,7 +155,7 @@ struct command_description
 	const char *name;
 	void (*handler)(parameters_t &);
 	const char *description;
-	const char *valid_options[16];
+	const char *valid_options[20];
 };
 
 
@@ -590,6 +591,7 @@ static const option_description s_options[] =
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
 	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_READAHEAD,             "ra",   true, " <hunks>: size of each source read, in hunks (power of 2 up to 128; smaller values keep the compressors fed from slow sources)" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -628,7 +630,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_HUNK_SIZE,
 			REQUIRED OPTION_UNIT_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_READAHEAD
 		}
 	},
 
@@ -649,7 +652,8 @@ static const command_description s_commands[] =
 			OPTION_CHS,
 			OPTION_SIZE,
 			OPTION_SECTOR_SIZE,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_READAHEAD
 		}
 	},
 
@@ -661,7 +665,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_READAHEAD
 		}
 	},
 
@@ -675,7 +680,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_FRAMES,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_READAHEAD
 		}
 	},
 
@@ -739,7 +745,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_READAHEAD
 		}
 	},
 
@@ -1188,6 +1195,23 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  parse_readahead - handle the readahead
+//  command
+//-------------------------------------------------
+
+static void parse_readahead(const parameters_t &params, chd_file_compressor &chd)
+{
+	auto readahead_str = params.find(OPTION_READAHEAD);
+	if (readahead_str == params.end())
+		return;
+
+	int hunks = atoi(readahead_str->second->c_str());
+	if (hunks > 0)
+		chd.set_readahead(hunks);
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1708,6 +1732,7 @@ static void do_create_raw(parameters_t &params)
 			chd->clone_all_metadata(output_parent);
 
 		// compress it generically
+		parse_readahead(params, *chd);
 		compress_common(*chd);
 	}
 	catch (...)
@@ -1916,6 +1941,7 @@ static void do_create_hd(parameters_t &params)
 		}
 
 		// compress it generically
+		parse_readahead(params, *chd);
 		if (input_file)
 			compress_common(*chd);
 	}
@@ -2007,6 +2033,7 @@ static void do_create_cd(parameters_t &params)
 			report_error(1, "Error adding CD metadata: %s", chd_file::error_string(err));
 
 		// compress it generically
+		parse_readahead(params, *chd);
 		compress_common(*chd);
 		delete chd;
 	}
@@ -2126,6 +2153,7 @@ static void do_create_ld(parameters_t &params)
 			report_error(1, "Error adding AV metadata: %s\n", chd_file::error_string(err));
 
 		// create the compressor and then run it generically
+		parse_readahead(params, *chd);
 		compress_common(*chd);
 
 		// write the final LD metadata
@@ -2270,6 +2298,7 @@ static void do_copy(parameters_t &params)
 		}
 
 		// compress it generically
+		parse_readahead(params, *chd);
 		compress_common(*chd);
 		delete chd;
 	}
@@ -183,12 +183,14 @@ static int identify(int argc, char *argv[])
 		io.file = f;
 		io.procs = &stdio_ioprocs_noclose;
 		io.filler = 0xff;
+		io_generic_cache(&io);
 
 		floppy_image_format_t *best_fif = find_format_by_identify(&io);
 		if (best_fif)
 			printf("%s : %s\n", argv[i], best_fif->description());
 		else
 			printf("%s : Unknown format\n", argv[i]);
+		io_generic_uncache(&io);
 		fclose(f);
 	}
 	return 0;
@@ -215,6 +217,7 @@ static int convert(int argc, char *argv[])
 	source_io.file = f;
 	source_io.procs = &stdio_ioprocs_noclose;
 	source_io.filler = 0xff;
+	io_generic_cache(&source_io);
 
 	if(!core_stricmp(argv[2], "auto")) {
 		source_format = find_format_by_identify(&source_io);
@@ -263,6 +266,7 @@ static int convert(int argc, char *argv[])
 		return 1;
 	}
 
+	io_generic_uncache(&source_io);
 	fclose((FILE *)source_io.file);
 	fclose((FILE *)dest_io.file);
 
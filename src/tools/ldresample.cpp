@@ -14,6 +14,7 @@
 #include <math.h>
 #include <new>
 #include <assert.h>
+#include <mutex>
 #include "bitmap.h"
 #include "chd.h"
 #include "avhuff.h"
@@ -67,39 +68,86 @@ class chd_resample_compressor : public chd_file_compressor
 {
 public:
 	// construction/destruction
-	chd_resample_compressor(chd_file &source, movie_info &info, int64_t ioffset, int64_t islope)
+	chd_resample_compressor(chd_file &source, const char *sourcename, movie_info &info, int64_t ioffset, int64_t islope)
 		: m_source(source),
+			m_sourcename(sourcename),
 			m_info(info),
 			m_ioffset(ioffset),
-			m_islope(islope) { }
+			m_islope(islope)
+	{
+		m_decode_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	}
+
+	virtual ~chd_resample_compressor()
+	{
+		osd_work_queue_free(m_decode_queue);
+	}
 
-	// read interface
+	// read interface; each field decodes and resamples independently, so
+	// the whole chunk is farmed out across the decode queue and written
+	// straight into its slot of the destination buffer
 	virtual uint32_t read_data(void *_dest, uint64_t offset, uint32_t length)
 	{
 		assert(offset % m_source.hunk_bytes() == 0);
 		assert(length % m_source.hunk_bytes() == 0);
 
 		uint32_t startfield = offset / m_source.hunk_bytes();
-		uint32_t endfield = startfield + length / m_source.hunk_bytes();
+		uint32_t numfields = length / m_source.hunk_bytes();
 		uint8_t *dest = reinterpret_cast<uint8_t *>(_dest);
 
-		for (uint32_t fieldnum = startfield; fieldnum < endfield; fieldnum++)
+		m_workitems.resize(numfields);
+		for (uint32_t fieldnum = 0; fieldnum < numfields; fieldnum++)
 		{
-			generate_one_frame(dest, m_source.hunk_bytes(), fieldnum);
-			dest += m_source.hunk_bytes();
+			field_work &work = m_workitems[fieldnum];
+			work.compressor = this;
+			work.dest = dest + fieldnum * m_source.hunk_bytes();
+			work.fieldnum = startfield + fieldnum;
+			osd_work_item_queue(m_decode_queue, decode_field_static, &work, WORK_ITEM_FLAG_AUTO_RELEASE);
 		}
+		osd_work_queue_wait(m_decode_queue, 3600 * osd_ticks_per_second());
 		return length;
 	}
 
 private:
+	// one queued decode
+	struct field_work
+	{
+		chd_resample_compressor *compressor;
+		uint8_t *       dest;
+		uint32_t        fieldnum;
+	};
+
+	// per-thread source handle and buffers; CHD decompression is not
+	// thread-safe on a shared handle
+	struct decode_context
+	{
+		chd_file        file;
+		movie_info      info;
+		bool            opened = false;
+		bool            failed = false;
+	};
+
 	// internal helpers
-	void generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum);
+	static void *decode_field_static(void *param, int threadid)
+	{
+		field_work *work = reinterpret_cast<field_work *>(param);
+		work->compressor->decode_field(*work, threadid);
+		return nullptr;
+	}
+
+	void decode_field(field_work &work, int threadid);
+	void generate_one_frame(chd_file &source, movie_info &info, uint8_t *dest, uint32_t datasize, uint32_t fieldnum);
 
 	// internal state
 	chd_file &                  m_source;
+	const char *                m_sourcename;
 	movie_info &                m_info;
 	int64_t                       m_ioffset;
 	int64_t                       m_islope;
+	osd_work_queue *            m_decode_queue;
+	std::vector<field_work>     m_workitems;
+	decode_context              m_context[WORK_MAX_THREADS];
+	std::mutex                  m_source_lock;
 };
 
 
@@ -404,37 +452,82 @@ static bool find_edge_near_field(chd_file &srcfile, uint32_t fieldnum, movie_inf
 }
 
 
+//-------------------------------------------------
+//  decode_field - generate one frame on a worker
+//  thread, using that thread's private source
+//  handle and buffers
+//-------------------------------------------------
+
+void chd_resample_compressor::decode_field(field_work &work, int threadid)
+{
+	assert(threadid < WORK_MAX_THREADS);
+	decode_context &context = m_context[threadid];
+
+	// open this thread's handle on first use
+	if (!context.opened)
+	{
+		context.opened = true;
+		if (context.file.open(m_sourcename) != CHDERR_NONE)
+			context.failed = true;
+		else
+		{
+			context.info.framerate = m_info.framerate;
+			context.info.iframerate = m_info.iframerate;
+			context.info.numfields = m_info.numfields;
+			context.info.width = m_info.width;
+			context.info.height = m_info.height;
+			context.info.samplerate = m_info.samplerate;
+			context.info.channels = m_info.channels;
+			context.info.interlaced = m_info.interlaced;
+			context.info.bitmap.resize(m_info.width, m_info.height);
+			context.info.lsound.resize(m_info.samplerate);
+			context.info.rsound.resize(m_info.samplerate);
+		}
+	}
+
+	// if the private handle couldn't be opened, fall back to serializing
+	// on the shared source
+	if (context.failed)
+	{
+		std::lock_guard<std::mutex> lock(m_source_lock);
+		generate_one_frame(m_source, m_info, work.dest, m_source.hunk_bytes(), work.fieldnum);
+	}
+	else
+		generate_one_frame(context.file, context.info, work.dest, m_source.hunk_bytes(), work.fieldnum);
+}
+
+
 //-------------------------------------------------
 //  generate_one_frame - generate a single
 //  resampled frame
 //-------------------------------------------------
 
-void chd_resample_compressor::generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum)
+void chd_resample_compressor::generate_one_frame(chd_file &source, movie_info &info, uint8_t *dest, uint32_t datasize, uint32_t fieldnum)
 {
 	// determine the first field needed to cover this range of samples
-	uint32_t srcbegin = field_to_sample_number(m_info, fieldnum);
+	uint32_t srcbegin = field_to_sample_number(info, fieldnum);
 	int64_t dstbegin = (int64_t(srcbegin) << 24) + m_ioffset + m_islope * fieldnum;
 	uint32_t dstbeginoffset;
 	int32_t dstbeginfield;
 	if (dstbegin >= 0)
-		dstbeginfield = sample_number_to_field(m_info, dstbegin >> 24, dstbeginoffset);
+		dstbeginfield = sample_number_to_field(info, dstbegin >> 24, dstbeginoffset);
 	else
 	{
-		dstbeginfield = -1 - sample_number_to_field(m_info, -dstbegin >> 24, dstbeginoffset);
-		dstbeginoffset = (field_to_sample_number(m_info, -dstbeginfield) - field_to_sample_number(m_info, -dstbeginfield - 1)) - dstbeginoffset;
+		dstbeginfield = -1 - sample_number_to_field(info, -dstbegin >> 24, dstbeginoffset);
+		dstbeginoffset = (field_to_sample_number(info, -dstbeginfield) - field_to_sample_number(info, -dstbeginfield - 1)) - dstbeginoffset;
 	}
 
 	// determine the last field needed to cover this range of samples
-	uint32_t srcend = field_to_sample_number(m_info, fieldnum + 1);
+	uint32_t srcend = field_to_sample_number(info, fieldnum + 1);
 	int64_t dstend = (int64_t(srcend) << 24) + m_ioffset + m_islope * (fieldnum + 1);
 	uint32_t dstendoffset;
 	int32_t dstendfield;
 	if (dstend >= 0)
-		dstendfield = sample_number_to_field(m_info, dstend >> 24, dstendoffset);
+		dstendfield = sample_number_to_field(info, dstend >> 24, dstendoffset);
 	else
 	{
-		dstendfield = -1 - -sample_number_to_field(m_info, -dstend >> 24, dstendoffset);
-		dstendoffset = (field_to_sample_number(m_info, -dstendfield) - field_to_sample_number(m_info, -dstendfield - 1)) - dstendoffset;
+		dstendfield = -1 - -sample_number_to_field(info, -dstend >> 24, dstendoffset);
+		dstendoffset = (field_to_sample_number(info, -dstendfield) - field_to_sample_number(info, -dstendfield - 1)) - dstendoffset;
 	}
 /*
 printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
@@ -447,14 +540,14 @@ printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
 	for (int32_t dstfield = dstbeginfield; dstfield <= dstendfield; dstfield++)
 	{
 		if (dstfield >= 0)
-			read_chd(m_source, dstfield, m_info, dstoffset);
+			read_chd(source, dstfield, info, dstoffset);
 		else
 		{
-			m_info.samples = field_to_sample_number(m_info, -dstfield) - field_to_sample_number(m_info, -dstfield - 1);
-			memset(&m_info.lsound[dstoffset], 0, m_info.samples * sizeof(m_info.lsound[0]));
-			memset(&m_info.rsound[dstoffset], 0, m_info.samples * sizeof(m_info.rsound[0]));
+			info.samples = field_to_sample_number(info, -dstfield) - field_to_sample_number(info, -dstfield - 1);
+			memset(&info.lsound[dstoffset], 0, info.samples * sizeof(info.lsound[0]));
+			memset(&info.rsound[dstoffset], 0, info.samples * sizeof(info.rsound[0]));
 		}
-		dstoffset += m_info.samples;
+		dstoffset += info.samples;
 	}
 
 	// resample the destination samples to the source
@@ -463,18 +556,18 @@ printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
 	int64_t dststep = (dstend - dstbegin) / int64_t(srcend - srcbegin);
 	for (uint32_t srcoffset = 0; srcoffset < srcend - srcbegin; srcoffset++)
 	{
-		m_info.lsound[srcoffset] = m_info.lsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
-		m_info.rsound[srcoffset] = m_info.rsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
+		info.lsound[srcoffset] = info.lsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
+		info.rsound[srcoffset] = info.rsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
 		dstpos += dststep;
 	}
 
 	// read the original frame, pointing the sound buffer past where we've calculated
-	read_chd(m_source, fieldnum, m_info, srcend - srcbegin);
+	read_chd(source, fieldnum, info, srcend - srcbegin);
 
 	// assemble the final frame
 	std::vector<uint8_t> buffer;
-	int16_t *sampledata[2] = { &m_info.lsound[0], &m_info.rsound[0] };
-	avhuff_encoder::assemble_data(buffer, m_info.bitmap, m_info.channels, m_info.samples, sampledata);
+	int16_t *sampledata[2] = { &info.lsound[0], &info.rsound[0] };
+	avhuff_encoder::assemble_data(buffer, info.bitmap, info.channels, info.samples, sampledata);
 	memcpy(dest, &buffer[0], std::min(buffer.size(), size_t(datasize)));
 	if (buffer.size() < datasize)
 		memset(&dest[buffer.size()], 0, datasize - buffer.size());
@@ -504,6 +597,15 @@ static int usage(void)
 
 int main(int argc, char *argv[])
 {
+	// the tools are not bound by the emulator's single-thread determinism
+	// clamp, so ask for one worker per processor
+	{
+		extern int osd_num_processors;
+		extern int osd_get_num_processors(void);
+		if (osd_num_processors == 0)
+			osd_num_processors = osd_get_num_processors();
+	}
+
 	// verify arguments
 	if (argc < 2)
 		return usage();
@@ -552,7 +654,7 @@ int main(int argc, char *argv[])
 	else
 	{
 		// open the destination file
-		chd_resample_compressor dstfile(srcfile, info, int64_t(offset * 65536.0 * 256.0), int64_t(slope * 65536.0 * 256.0));
+		chd_resample_compressor dstfile(srcfile, srcfilename, info, int64_t(offset * 65536.0 * 256.0), int64_t(slope * 65536.0 * 256.0));
 		err = create_chd(dstfile, dstfilename, srcfile, info);
 		if (!dstfile.opened())
 		{
@@ -15,6 +15,13 @@
 
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 
 #define MAX_FILES 1000
@@ -107,7 +114,8 @@ struct fileinfo
 {
 	char name[MAX_FILENAME_LEN+1];
 	int size;
-	unsigned char *buf; /* file is read in here */
+	unsigned char *buf; /* file is read (or mapped) in here */
+	int mapped;         /* buf is an mmap'd view, not a malloc'd copy */
 	int listed;
 };
 
@@ -390,9 +398,39 @@ static float filecompare(const fileinfo *file1,const fileinfo *file2,int mode1,i
 	{
 		if (mask1 == 0xff)
 		{
-			/* normal compare */
-			for (i = 0;i < size1;i++)
-				if (file1->buf[base1 + mult1 * i] == file2->buf[base2 + mult2 * i]) match++;
+			if (mult1 == 1 && mult2 == 1)
+			{
+				/* contiguous compare; memcmp catches the common identical
+				   case with whatever vectorization the library has, and
+				   mismatches fall back to counting a word at a time */
+				const unsigned char *buf1 = file1->buf + base1;
+				const unsigned char *buf2 = file2->buf + base2;
+				if (memcmp(buf1, buf2, size1) == 0)
+					match = size1;
+				else
+				{
+					for (i = 0; i + 8 <= size1; i += 8)
+					{
+						uint64_t word1, word2;
+						memcpy(&word1, buf1 + i, 8);
+						memcpy(&word2, buf2 + i, 8);
+						uint64_t diff = word1 ^ word2;
+						if (diff == 0)
+							match += 8;
+						else
+							for (int byte = 0; byte < 8; byte++)
+								if (((diff >> (8 * byte)) & 0xff) == 0) match++;
+					}
+					for ( ; i < size1; i++)
+						if (buf1[i] == buf2[i]) match++;
+				}
+			}
+			else
+			{
+				/* interleaved compare */
+				for (i = 0;i < size1;i++)
+					if (file1->buf[base1 + mult1 * i] == file2->buf[base2 + mult2 * i]) match++;
+			}
 		}
 		else
 		{
@@ -433,6 +471,26 @@ static void readfile(const char *path,fileinfo *file)
 	else fullname[0] = 0;
 	strcat(fullname,file->name);
 
+	file->mapped = 0;
+#ifdef __linux__
+	/* map the file instead of copying it; the compare loops then work
+	   straight out of the page cache */
+	{
+		int fd = ::open(fullname, O_RDONLY);
+		if (fd != -1)
+		{
+			void *map = mmap(nullptr, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (map != MAP_FAILED)
+			{
+				file->buf = (unsigned char *)map;
+				file->mapped = 1;
+				return;
+			}
+		}
+	}
+#endif
+
 	if ((file->buf = (unsigned char *)malloc(file->size)) == nullptr)
 	{
 		printf("%s: out of memory!\n",file->name);
@@ -457,6 +515,15 @@ static void readfile(const char *path,fileinfo *file)
 
 static void freefile(fileinfo *file)
 {
+#ifdef __linux__
+	if (file->mapped)
+	{
+		munmap(file->buf, file->size);
+		file->buf = nullptr;
+		file->mapped = 0;
+		return;
+	}
+#endif
 	free(file->buf);
 	file->buf = nullptr;
 }
@@ -471,6 +538,36 @@ static void printname(const fileinfo *file1,const fileinfo *file2,float score,in
 }
 
 
+/* pairwise scoring is embarrassingly parallel, so it is farmed out one
+   row (one file of the first set against everything it pairs with) per
+   work item; printing stays on the main thread afterwards so the output
+   order does not change */
+static int compare_found[2];
+static int compare_modes;
+static int compare_twodirs;
+
+static void *compare_row(void *param, int threadid)
+{
+	const int i = int(reinterpret_cast<uintptr_t>(param));
+
+	if (compare_twodirs)
+	{
+		for (int j = 0; j < compare_found[1]; j++)
+			for (int mode1 = 0; mode1 < compare_modes; mode1++)
+				for (int mode2 = 0; mode2 < compare_modes; mode2++)
+					matchscore[i][j][mode1][mode2] = filecompare(&files[0][i], &files[1][j], mode1, mode2);
+	}
+	else
+	{
+		for (int j = i + 1; j < compare_found[0]; j++)
+			for (int mode1 = 0; mode1 < compare_modes; mode1++)
+				for (int mode2 = 0; mode2 < compare_modes; mode2++)
+					matchscore[i][j][mode1][mode2] = filecompare(&files[0][i], &files[0][j], mode1, mode2);
+	}
+	return nullptr;
+}
+
+
 static int load_files(int i, int *found, const char *path)
 {
 	/* attempt to open as a directory first */
@@ -591,6 +688,15 @@ int CLIB_DECL main(int argc,char *argv[])
 		return 0;
 	}
 
+	/* the tools are not bound by the emulator's single-thread determinism
+	   clamp, so ask for one worker per processor */
+	{
+		extern int osd_num_processors;
+		extern int osd_get_num_processors(void);
+		if (osd_num_processors == 0)
+			osd_num_processors = osd_get_num_processors();
+	}
+
 	{
 		int found[2];
 		int i,j,mode1,mode2;
@@ -623,6 +729,19 @@ int CLIB_DECL main(int argc,char *argv[])
 			checkintegrity(&files[1][j],1);
 		}
 
+		/* score every pairing in parallel */
+		compare_found[0] = found[0];
+		compare_found[1] = found[1];
+		compare_modes = total_modes;
+		compare_twodirs = (argc >= 3);
+		{
+			osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+			for (i = 0;i < found[0];i++)
+				osd_work_item_queue(queue, compare_row, (void *)(uintptr_t)i, WORK_ITEM_FLAG_AUTO_RELEASE);
+			osd_work_queue_wait(queue, osd_ticks_per_second() * 3600);
+			osd_work_queue_free(queue);
+		}
+
 		if (argc < 3)
 		{
 			/* find duplicates in one dir */
@@ -634,7 +753,7 @@ int CLIB_DECL main(int argc,char *argv[])
 					{
 						for (mode2 = 0;mode2 < total_modes;mode2++)
 						{
-							if (filecompare(&files[0][i],&files[0][j],mode1,mode2) == 1.0f)
+							if (matchscore[i][j][mode1][mode2] == 1.0f)
 								printname(&files[0][i],&files[0][j],1.0,mode1,mode2);
 						}
 					}
@@ -643,22 +762,6 @@ int CLIB_DECL main(int argc,char *argv[])
 		}
 		else
 		{
-			/* compare two dirs */
-			for (i = 0;i < found[0];i++)
-			{
-				for (j = 0;j < found[1];j++)
-				{
-					fprintf(stderr,"%2d%%\r",100*(i*found[1]+j)/(found[0]*found[1]));
-					for (mode1 = 0;mode1 < total_modes;mode1++)
-					{
-						for (mode2 = 0;mode2 < total_modes;mode2++)
-						{
-							matchscore[i][j][mode1][mode2] = filecompare(&files[0][i],&files[1][j],mode1,mode2);
-						}
-					}
-				}
-			}
-			fprintf(stderr,"   \r");
 
 			do
 			{
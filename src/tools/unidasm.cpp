@@ -153,8 +153,12 @@ using util::BIT;
 #include "corefile.h"
 #include "corestr.h"
 #include "eminline.h"
+#include "osdcore.h"
 
 #include <algorithm>
+#include <fstream>
+#include <list>
+#include <sstream>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
@@ -284,6 +288,7 @@ struct dasm_table_entry
 struct options
 {
 	const char *            filename;
+	const char *            indexfile;
 	offs_t                  basepc;
 	uint8_t                 norawbytes;
 	uint8_t                 lower;
@@ -866,6 +871,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 	bool pending_mode = false;
 	bool pending_skip = false;
 	bool pending_count = false;
+	bool pending_index = false;
 
 	memset(opts, 0, sizeof(*opts));
 
@@ -875,7 +881,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 
 		// is it a switch?
 		if(curarg[0] == '-') {
-			if(pending_base || pending_arch || pending_mode || pending_skip || pending_count)
+			if(pending_base || pending_arch || pending_mode || pending_skip || pending_count || pending_index)
 				goto usage;
 
 			if(tolower((uint8_t)curarg[1]) == 'a')
@@ -894,6 +900,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 				pending_count = true;
 			else if(tolower((uint8_t)curarg[1]) == 'n')
 				opts->norawbytes = true;
+			else if(tolower((uint8_t)curarg[1]) == 'i')
+				pending_index = true;
 			else if(tolower((uint8_t)curarg[1]) == 'u')
 				opts->upper = true;
 			else
@@ -949,6 +957,12 @@ static int parse_options(int argc, char *argv[], options *opts)
 			pending_count = false;
 		}
 
+		// index file
+		else if(pending_index) {
+			opts->indexfile = curarg;
+			pending_index = false;
+		}
+
 		// filename
 		else if(opts->filename == nullptr)
 			opts->filename = curarg;
@@ -959,7 +973,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 	}
 
 	// if we have a dangling option, error
-	if(pending_base || pending_arch || pending_mode || pending_skip || pending_count)
+	if(pending_base || pending_arch || pending_mode || pending_skip || pending_count || pending_index)
 		goto usage;
 
 	// if no file or no architecture, fail
@@ -970,7 +984,12 @@ static int parse_options(int argc, char *argv[], options *opts)
 usage:
 	printf("Usage: %s <filename> -arch <architecture> [-basepc <pc>] \n", argv[0]);
 	printf("   [-mode <n>] [-norawbytes] [-flipped] [-upper] [-lower]\n");
-	printf("   [-skip <n>] [-count <n>]\n");
+	printf("   [-skip <n>] [-count <n>] [-index <file>]\n");
+	printf("or: %s -batch <listfile>\n", argv[0]);
+	printf("\n");
+	printf("-index writes a binary address-to-text-offset index beside the listing.\n");
+	printf("In batch mode each list file line is a full set of arguments; the\n");
+	printf("listings go to <filename>.dasm and the lines run in parallel.\n");
 	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
@@ -990,13 +1009,8 @@ usage:
 };
 
 
-int main(int argc, char *argv[])
+static int disassemble_one(const options &opts, std::ostream &out, std::vector<std::pair<offs_t, u64>> *index)
 {
-	// Parse options first
-	options opts;
-	if(parse_options(argc, argv, &opts))
-		return 1;
-
 	// Load the file
 	void *data;
 	uint32_t length;
@@ -1282,21 +1296,158 @@ int main(int argc, char *argv[])
 
 	if(opts.flipped) {
 		if(opts.norawbytes)
-			for(const auto &l : dasm_lines)
-				util::stream_format(std::cout, "%-*s ; %s\n", max_text, tf(l.dasm), tf(pc_to_string(l.pc)));
+			for(const auto &l : dasm_lines) {
+				if(index)
+					index->emplace_back(l.pc, u64(out.tellp()));
+				util::stream_format(out, "%-*s ; %s\n", max_text, tf(l.dasm), tf(pc_to_string(l.pc)));
+			}
 		else
-			for(const auto &l : dasm_lines)
-				util::stream_format(std::cout, "%-*s ; %s: %s\n", max_text, tf(l.dasm), tf(pc_to_string(l.pc)), tf(dump_raw_bytes(l.pc, l.size >> granularity_shift)));
+			for(const auto &l : dasm_lines) {
+				if(index)
+					index->emplace_back(l.pc, u64(out.tellp()));
+				util::stream_format(out, "%-*s ; %s: %s\n", max_text, tf(l.dasm), tf(pc_to_string(l.pc)), tf(dump_raw_bytes(l.pc, l.size >> granularity_shift)));
+			}
 	} else {
 		if(opts.norawbytes)
-			for(const auto &l : dasm_lines)
-				util::stream_format(std::cout, "%s: %s\n", tf(pc_to_string(l.pc)), tf(l.dasm));
+			for(const auto &l : dasm_lines) {
+				if(index)
+					index->emplace_back(l.pc, u64(out.tellp()));
+				util::stream_format(out, "%s: %s\n", tf(pc_to_string(l.pc)), tf(l.dasm));
+			}
 		else
-			for(const auto &l : dasm_lines)
-				util::stream_format(std::cout, "%s: %-*s  %s\n", tf(pc_to_string(l.pc)), max_len, tf(dump_raw_bytes(l.pc, l.size >> granularity_shift)), tf(l.dasm));
+			for(const auto &l : dasm_lines) {
+				if(index)
+					index->emplace_back(l.pc, u64(out.tellp()));
+				util::stream_format(out, "%s: %-*s  %s\n", tf(pc_to_string(l.pc)), max_len, tf(dump_raw_bytes(l.pc, l.size >> granularity_shift)), tf(l.dasm));
+			}
 	}
 
 	free(data);
 
 	return 0;
 }
+
+static bool write_index(const char *filename, const std::vector<std::pair<offs_t, u64>> &index)
+{
+	FILE *f = fopen(filename, "wb");
+	if(!f) {
+		fprintf(stderr, "Error opening index file '%s'\n", filename);
+		return false;
+	}
+	u32 magic = 0x55444958; // "UDIX"
+	u32 count = index.size();
+	bool ok = fwrite(&magic, sizeof(magic), 1, f) == 1 && fwrite(&count, sizeof(count), 1, f) == 1;
+	for(const auto &e : index) {
+		u64 rec[2] = { e.first, e.second };
+		ok = ok && fwrite(rec, sizeof(rec), 1, f) == 1;
+	}
+	fclose(f);
+	if(!ok)
+		fprintf(stderr, "Error writing index file '%s'\n", filename);
+	return ok;
+}
+
+struct batch_job
+{
+	std::vector<std::string> tokens;
+	options opts;
+	int result = 0;
+};
+
+static void *batch_job_run(void *param, int threadid)
+{
+	batch_job &job = *(batch_job *)param;
+	std::string outname = std::string(job.opts.filename) + ".dasm";
+	std::ofstream out(outname, std::ios::binary);
+	if(!out) {
+		fprintf(stderr, "Error opening output file '%s'\n", outname.c_str());
+		job.result = 1;
+		return nullptr;
+	}
+	std::vector<std::pair<offs_t, u64>> index;
+	job.result = disassemble_one(job.opts, out, job.opts.indexfile ? &index : nullptr);
+	if(!job.result && job.opts.indexfile && !write_index(job.opts.indexfile, index))
+		job.result = 1;
+	return nullptr;
+}
+
+static int run_batch(const char *progname, const char *listfile)
+{
+	std::ifstream list(listfile);
+	if(!list) {
+		fprintf(stderr, "Error opening list file '%s'\n", listfile);
+		return 1;
+	}
+
+	// parse each line as if it were a full command line
+	std::list<batch_job> jobs;
+	std::string line;
+	while(std::getline(list, line)) {
+		std::istringstream tokenizer(line);
+		std::vector<std::string> tokens;
+		tokens.emplace_back(progname);
+		std::string token;
+		while(tokenizer >> token)
+			tokens.emplace_back(std::move(token));
+		if(tokens.size() == 1)
+			continue;
+
+		// parse in place so the options keep pointing into the stored tokens
+		jobs.emplace_back();
+		batch_job &job = jobs.back();
+		job.tokens = std::move(tokens);
+		std::vector<char *> job_argv;
+		for(std::string &t : job.tokens)
+			job_argv.push_back(&t[0]);
+		if(parse_options(int(job_argv.size()), &job_argv[0], &job.opts))
+			return 1;
+	}
+	if(jobs.empty())
+		return 0;
+
+	// let the work queue use all the cores unless told otherwise
+	{
+		extern int osd_num_processors;
+		extern int osd_get_num_processors(void);
+		if (osd_num_processors == 0)
+			osd_num_processors = osd_get_num_processors();
+	}
+
+	// one work item per job; each disassembler instance is private to its job
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	for(batch_job &job : jobs)
+		osd_work_item_queue(queue, batch_job_run, &job, WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 3600);
+	osd_work_queue_free(queue);
+
+	int result = 0;
+	for(const batch_job &job : jobs)
+		if(job.result)
+			result = job.result;
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	// Batch mode runs a list of jobs in parallel
+	if(argc == 3 && !strcmp(argv[1], "-batch"))
+		return run_batch(argv[0], argv[2]);
+
+	// Parse options first
+	options opts;
+	if(parse_options(argc, argv, &opts))
+		return 1;
+
+	// An index needs a seekable stream, so collect the text before dumping it
+	if(opts.indexfile) {
+		std::ostringstream out;
+		std::vector<std::pair<offs_t, u64>> index;
+		int result = disassemble_one(opts, out, &index);
+		if(result)
+			return result;
+		std::cout << out.str();
+		return write_index(opts.indexfile, index) ? 0 : 1;
+	}
+
+	return disassemble_one(opts, std::cout, nullptr);
+}
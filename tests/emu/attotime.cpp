@@ -9,3 +9,35 @@ TEST_CASE("convert 1 sec to attotime", "[emu]")
    attotime value = attotime::from_seconds(1);
    REQUIRE(value.as_attoseconds() == 1000000000000000000);
 }
+
+TEST_CASE("addition carries into seconds", "[emu]")
+{
+   attotime value = attotime(1, ATTOSECONDS_PER_SECOND - 1) + attotime(0, 2);
+   REQUIRE(value.seconds() == 2);
+   REQUIRE(value.attoseconds() == 1);
+}
+
+TEST_CASE("subtraction borrows from seconds", "[emu]")
+{
+   attotime value = attotime(2, 1) - attotime(0, 2);
+   REQUIRE(value.seconds() == 1);
+   REQUIRE(value.attoseconds() == ATTOSECONDS_PER_SECOND - 1);
+}
+
+TEST_CASE("addition saturates to never", "[emu]")
+{
+   REQUIRE((attotime::never + attotime(0, 1)).is_never());
+   REQUIRE((attotime(0, 1) + attotime::never).is_never());
+   REQUIRE((attotime(ATTOTIME_MAX_SECONDS - 1, ATTOSECONDS_PER_SECOND - 1) + attotime(0, 1)).is_never());
+}
+
+TEST_CASE("never minus anything stays never", "[emu]")
+{
+   REQUIRE((attotime::never - attotime(100, 0)).is_never());
+}
+
+TEST_CASE("integral from_hz is exact", "[emu]")
+{
+   REQUIRE(attotime::from_hz(u32(60)).attoseconds() == ATTOSECONDS_PER_SECOND / 60);
+   REQUIRE(attotime::from_hz(u32(1)).seconds() == 1);
+}